@@ -0,0 +1,267 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_BENCH_BENCHMARKTOOLS_H
+#define LEMONADE_BENCH_BENCHMARKTOOLS_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Helpers shared by the benchmark executables in bench/
+ * */
+/*****************************************************************************/
+
+#include <sys/resource.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <LeMonADE/utility/R250.h>
+
+/*****************************************************************************/
+/**
+ * @class BenchmarkRecord
+ * @brief Ordered list of named values written as one JSON object
+ **/
+/*****************************************************************************/
+class BenchmarkRecord
+{
+public:
+  //! Adds a string value
+  void add(const std::string& key, const std::string& value){fields.push_back(std::make_pair(key,quote(value)));}
+  //! Adds a string value
+  void add(const std::string& key, const char* value){add(key,std::string(value));}
+  //! Adds a floating point value
+  void add(const std::string& key, double value)
+  {
+    std::stringstream stream;
+    stream.precision(9);
+    //JSON has no representation of inf and nan
+    if(value==value && value-value==0.0) stream<<value;
+    else stream<<"null";
+    fields.push_back(std::make_pair(key,stream.str()));
+  }
+  //! Adds an integer value
+  void add(const std::string& key, uint64_t value){addInteger(key,value);}
+  //! Adds an integer value
+  void add(const std::string& key, int64_t value){addInteger(key,value);}
+  //! Adds an integer value
+  void add(const std::string& key, int value){addInteger(key,value);}
+  //! Adds an integer value
+  void add(const std::string& key, uint32_t value){addInteger(key,value);}
+  //! Adds a boolean value
+  void add(const std::string& key, bool value){fields.push_back(std::make_pair(key,std::string(value?"true":"false")));}
+
+  //! Writes the record as JSON object
+  void write(std::ostream& stream, const std::string& indent) const
+  {
+    stream<<"{";
+    for(size_t n=0;n<fields.size();n++)
+      stream<<(n>0?",":"")<<"\n"<<indent<<"  "<<quote(fields[n].first)<<": "<<fields[n].second;
+    stream<<"\n"<<indent<<"}";
+  }
+
+  //! Quotes and escapes a string for JSON
+  static std::string quote(const std::string& text)
+  {
+    std::string result("\"");
+    for(size_t n=0;n<text.size();n++)
+    {
+      if(text[n]=='"' || text[n]=='\\') result+='\\';
+      if(text[n]=='\n') result+="\\n";
+      else result+=text[n];
+    }
+    return result+"\"";
+  }
+
+private:
+  template<class IntType> void addInteger(const std::string& key, IntType value)
+  {
+    std::stringstream stream;
+    stream<<value;
+    fields.push_back(std::make_pair(key,stream.str()));
+  }
+
+  std::vector<std::pair<std::string,std::string> > fields;
+};
+
+/*****************************************************************************/
+/**
+ * @struct SampleStatistics
+ * @brief Summary of repeated measurements of the same quantity
+ **/
+/*****************************************************************************/
+struct SampleStatistics
+{
+  SampleStatistics():count(0),min(0.0),max(0.0),mean(0.0),median(0.0),stddev(0.0){}
+
+  //! Calculates the summary of the samples
+  explicit SampleStatistics(std::vector<double> samples)
+  :count(samples.size()),min(0.0),max(0.0),mean(0.0),median(0.0),stddev(0.0)
+  {
+    if(samples.empty()) return;
+    std::sort(samples.begin(),samples.end());
+    min=samples.front();
+    max=samples.back();
+    size_t half=count/2;
+    median=(count%2==1)?samples[half]:0.5*(samples[half-1]+samples[half]);
+    for(size_t n=0;n<count;n++) mean+=samples[n];
+    mean/=double(count);
+    //sample standard deviation, zero for a single sample
+    if(count>1)
+    {
+      for(size_t n=0;n<count;n++) stddev+=(samples[n]-mean)*(samples[n]-mean);
+      stddev=std::sqrt(stddev/double(count-1));
+    }
+  }
+
+  //! Adds the summary to the record as prefix_min, prefix_median, ...
+  void addTo(BenchmarkRecord& record, const std::string& prefix) const
+  {
+    record.add(prefix+"_min",min);
+    record.add(prefix+"_median",median);
+    record.add(prefix+"_mean",mean);
+    record.add(prefix+"_stddev",stddev);
+    record.add(prefix+"_max",max);
+  }
+
+  size_t count;
+  double min;
+  double max;
+  double mean;
+  double median;
+  double stddev;
+};
+
+/**
+ * @brief Writes the header information and all results as one JSON document
+ *
+ * @param stream output stream
+ * @param header information about the run (suite, settings, compiler)
+ * @param results one record per benchmark
+ */
+inline void writeBenchmarkJson(std::ostream& stream, const BenchmarkRecord& header, const std::vector<BenchmarkRecord>& results)
+{
+  stream<<"{\n  \"run\": ";
+  header.write(stream,"  ");
+  stream<<",\n  \"results\": [";
+  for(size_t n=0;n<results.size();n++)
+  {
+    stream<<(n>0?",":"")<<"\n    ";
+    results[n].write(stream,"    ");
+  }
+  stream<<"\n  ]\n}"<<std::endl;
+}
+
+//! Header information common to all benchmark executables
+inline BenchmarkRecord benchmarkRunInfo(const std::string& suite)
+{
+  BenchmarkRecord info;
+  info.add("suite",suite);
+#ifdef __VERSION__
+  info.add("compiler",__VERSION__);
+#endif
+#ifdef NDEBUG
+  info.add("ndebug",true);
+#else
+  info.add("ndebug",false);
+#endif
+#ifdef __OPTIMIZE__
+  info.add("optimized",true);
+#else
+  info.add("optimized",false);
+#endif
+  return info;
+}
+
+//! Maximum resident set size of the process so far in kB
+inline uint64_t peakResidentSetSizeKb()
+{
+  rusage usage;
+  if(getrusage(RUSAGE_SELF,&usage)!=0) return 0;
+  return uint64_t(usage.ru_maxrss);
+}
+
+/**
+ * @brief Deterministic seeds for RandomNumberGenerators::seedAll()
+ *
+ * @details Benchmarks use reproducible random numbers, such that every run
+ * simulates the same systems.
+ *
+ * @param seed base seed
+ */
+inline std::vector<uint32_t> benchmarkSeeds(uint32_t seed)
+{
+  std::vector<uint32_t> seeds(R250_RANDOM_PREFETCH+2);
+  uint64_t state=seed*2862933555777941757ull+3037000493ull;
+  for(size_t n=0;n<seeds.size();n++)
+  {
+    state=state*6364136223846793005ull+1442695040888963407ull;
+    seeds[n]=uint32_t(state>>32);
+  }
+  return seeds;
+}
+
+/*****************************************************************************/
+/**
+ * @class SilenceStdout
+ * @brief Suppresses the output of std::cout for the lifetime of the object
+ *
+ * @details The updaters report their progress to std::cout, which would mix
+ * with the JSON output.
+ **/
+/*****************************************************************************/
+class SilenceStdout
+{
+public:
+  SilenceStdout():originalBuffer(std::cout.rdbuf(&nullBuffer)){}
+  ~SilenceStdout(){std::cout.rdbuf(originalBuffer);}
+
+private:
+  //! stream buffer discarding all characters
+  class NullBuffer: public std::streambuf
+  {
+  protected:
+    virtual int overflow(int c){return traits_type::not_eof(c);}
+    virtual std::streamsize xsputn(const char*, std::streamsize n){return n;}
+  };
+
+  SilenceStdout(const SilenceStdout&);
+  SilenceStdout& operator=(const SilenceStdout&);
+
+  NullBuffer nullBuffer;
+  std::streambuf* originalBuffer;
+};
+
+#endif /* LEMONADE_BENCH_BENCHMARKTOOLS_H */
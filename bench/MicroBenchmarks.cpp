@@ -0,0 +1,672 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Microbenchmarks of the primitives on the hot path (target LeMonADE-microbench)
+ *
+ * @details Every benchmark calls a single primitive (lattice access, bond
+ * vector check, random number, vector arithmetic, minimum image distance,
+ * neighbor list) in a tight loop over precomputed random arguments. After a number of warmup rounds the
+ * loop is timed repeatedly, and the minimum, median, mean, standard deviation
+ * and maximum of the time per call are reported as JSON. Run with --help for
+ * the options.
+ * */
+/*****************************************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/core/ConnectedDecorator.h>
+#include <LeMonADE/feature/FeatureLattice.h>
+#include <LeMonADE/feature/FeatureLatticePowerOfTwo.h>
+#include <LeMonADE/utility/DistanceCalculation.h>
+#include <LeMonADE/utility/FastBondset.h>
+#include <LeMonADE/utility/Lattice.h>
+#include <LeMonADE/utility/R250.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+#include <LeMonADE/utility/SlowBondset.h>
+#include <LeMonADE/utility/Timer.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+#include "BenchmarkTools.h"
+
+namespace
+{
+
+//! Settings of the benchmark run
+struct MicroBenchmarkOptions
+{
+  MicroBenchmarkOptions():calls(1u<<22),warmup(3),repetitions(15),seed(1){}
+
+  //! calls of the primitive per repetition
+  uint64_t calls;
+  //! untimed repetitions before the measurement
+  uint32_t warmup;
+  //! timed repetitions
+  uint32_t repetitions;
+  //! seed of the random arguments
+  uint32_t seed;
+  //! only benchmarks containing this text in their name are run
+  std::string filter;
+  //! JSON output file, stdout if empty
+  std::string output;
+};
+
+//! Number of precomputed arguments, power of two such that the index can be masked
+const size_t nArguments=4096;
+
+//! Results of the kernels are accumulated here, such that the compiler cannot drop the calls
+volatile uint64_t benchmarkSink=0;
+
+/**
+ * @brief Times the kernel and records the statistics of the time per call
+ *
+ * @details The kernel is a functor with uint64_t operator()(uint64_t calls),
+ * which calls the primitive \a calls times and returns a checksum of the
+ * results.
+ */
+template<class Kernel>
+BenchmarkRecord measure(const std::string& name, Kernel& kernel, const MicroBenchmarkOptions& options)
+{
+  for(uint32_t n=0;n<options.warmup;n++) benchmarkSink+=kernel(options.calls);
+
+  std::vector<double> nsPerCall;
+  for(uint32_t n=0;n<options.repetitions;n++)
+  {
+    Timer timer;
+    benchmarkSink+=kernel(options.calls);
+    nsPerCall.push_back(1.0e9*timer.elapsed()/double(options.calls));
+  }
+
+  SampleStatistics statistics(nsPerCall);
+  BenchmarkRecord result;
+  result.add("name",name);
+  result.add("calls_per_repetition",options.calls);
+  result.add("repetitions",options.repetitions);
+  statistics.addTo(result,"ns_per_call");
+  result.add("mcalls_per_second_median",statistics.median>0.0?1.0e3/statistics.median:0.0);
+
+  std::cerr<<std::fixed<<std::setprecision(3)<<statistics.median<<" ns/call (min "
+	   <<statistics.min<<", stddev "<<statistics.stddev<<")"<<std::endl;
+  return result;
+}
+
+//! Random generator for the arguments, independent of the static generators used in the benchmarks
+class ArgumentGenerator
+{
+public:
+  explicit ArgumentGenerator(uint32_t seed){rng.setState(&benchmarkSeeds(seed)[0]);}
+  //! Random integer in [min,max)
+  int32_t uniform(int32_t min, int32_t max){return min+int32_t(rng.r250_rand()%uint32_t(max-min));}
+  //! Random vector with components in [min,max)
+  VectorInt3 vector(int32_t min, int32_t max){return VectorInt3(uniform(min,max),uniform(min,max),uniform(min,max));}
+private:
+  R250 rng;
+};
+
+/*****************************************************************************/
+//lattice
+
+//! Box sizes for the lattice objects, which have no ingredients to synchronize with
+struct LatticeBox
+{
+  explicit LatticeBox(uint32_t box):box(box){}
+  uint32_t getBoxX() const {return box;}
+  uint32_t getBoxY() const {return box;}
+  uint32_t getBoxZ() const {return box;}
+  uint32_t box;
+};
+
+//! Allocates the lattice of the utility class Lattice (modulo folding)
+void setupLattice(Lattice<uint8_t>& lattice, uint32_t box)
+{
+  lattice.setupLattice(box,box,box);
+  lattice.clearLattice();
+}
+
+//! Allocates the lattice of the features FeatureLattice (modulo) and FeatureLatticePowerOfTwo (bit mask)
+template<class LatticeType>
+void setupLattice(LatticeType& lattice, uint32_t box)
+{
+  LatticeBox lb(box);
+  lattice.synchronize(lb);
+}
+
+//! Reads the lattice at random positions, which partly lie outside of the box
+template<class LatticeType>
+struct LatticeGetKernel
+{
+  LatticeGetKernel(const LatticeType& lattice, const std::vector<VectorInt3>& positions)
+  :lattice(lattice),positions(positions){}
+
+  uint64_t operator()(uint64_t calls) const
+  {
+    uint64_t sum=0;
+    for(uint64_t n=0;n<calls;n++) sum+=lattice.getLatticeEntry(positions[n&(nArguments-1)]);
+    return sum;
+  }
+
+  const LatticeType& lattice;
+  const std::vector<VectorInt3>& positions;
+};
+
+//! Moves entries on the lattice from random positions by random bond vectors
+template<class LatticeType>
+struct LatticeMoveKernel
+{
+  LatticeMoveKernel(LatticeType& lattice, const std::vector<VectorInt3>& positions, const std::vector<VectorInt3>& targets)
+  :lattice(lattice),positions(positions),targets(targets){}
+
+  uint64_t operator()(uint64_t calls)
+  {
+    for(uint64_t n=0;n<calls;n++)
+    {
+      size_t idx=n&(nArguments-1);
+      lattice.moveOnLattice(positions[idx],targets[idx]);
+    }
+    return lattice.getLatticeEntry(targets[0]);
+  }
+
+  LatticeType& lattice;
+  const std::vector<VectorInt3>& positions;
+  const std::vector<VectorInt3>& targets;
+};
+
+template<class LatticeType>
+BenchmarkRecord benchmarkLatticeGet(const std::string& name, uint32_t box, const MicroBenchmarkOptions& options)
+{
+  LatticeType lattice;
+  setupLattice(lattice,box);
+  ArgumentGenerator args(options.seed);
+  //half of the sites occupied
+  for(uint32_t n=0;n<box*box*box/2;n++)
+    lattice.setLatticeEntry(args.vector(0,box),uint8_t(1+n%255));
+
+  std::vector<VectorInt3> positions;
+  for(size_t n=0;n<nArguments;n++) positions.push_back(args.vector(-int32_t(box),2*int32_t(box)));
+
+  LatticeGetKernel<LatticeType> kernel(lattice,positions);
+  return measure(name,kernel,options);
+}
+
+template<class LatticeType>
+BenchmarkRecord benchmarkLatticeMove(const std::string& name, uint32_t box, const MicroBenchmarkOptions& options)
+{
+  LatticeType lattice;
+  setupLattice(lattice,box);
+  ArgumentGenerator args(options.seed);
+
+  std::vector<VectorInt3> positions,targets;
+  for(size_t n=0;n<nArguments;n++)
+  {
+    positions.push_back(args.vector(-int32_t(box),2*int32_t(box)));
+    targets.push_back(positions.back()+args.vector(-1,2));
+    lattice.setLatticeEntry(positions.back(),uint8_t(1+n%255));
+  }
+
+  LatticeMoveKernel<LatticeType> kernel(lattice,positions,targets);
+  return measure(name,kernel,options);
+}
+
+/*****************************************************************************/
+//bondset
+
+//! Checks random vectors with components in [-4,4], about 1/7 of them are valid bonds
+template<class BondsetType>
+struct BondsetKernel
+{
+  BondsetKernel(const BondsetType& bondset, const std::vector<VectorInt3>& bonds)
+  :bondset(bondset),bonds(bonds){}
+
+  uint64_t operator()(uint64_t calls) const
+  {
+    uint64_t valid=0;
+    for(uint64_t n=0;n<calls;n++) valid+=bondset.isValidStrongCheck(bonds[n&(nArguments-1)]);
+    return valid;
+  }
+
+  const BondsetType& bondset;
+  const std::vector<VectorInt3>& bonds;
+};
+
+template<class BondsetType>
+BenchmarkRecord benchmarkBondset(const std::string& name, uint32_t, const MicroBenchmarkOptions& options)
+{
+  //the classic bondset is defined in FastBondset only, copy it for SlowBondset
+  FastBondset classic;
+  classic.addBFMclassicBondset();
+  BondsetType bondset;
+  for(FastBondset::iterator it=classic.begin();it!=classic.end();++it)
+    bondset.addBond(it->second,it->first);
+  bondset.updateLookupTable();
+
+  ArgumentGenerator args(options.seed);
+  std::vector<VectorInt3> bonds;
+  for(size_t n=0;n<nArguments;n++) bonds.push_back(args.vector(-4,5));
+
+  BondsetKernel<BondsetType> kernel(bondset,bonds);
+  return measure(name,kernel,options);
+}
+
+/*****************************************************************************/
+//random numbers
+
+struct R250RandKernel
+{
+  uint64_t operator()(uint64_t calls)
+  {
+    uint64_t sum=0;
+    for(uint64_t n=0;n<calls;n++) sum+=rng.r250_rand();
+    return sum;
+  }
+  R250 rng;
+};
+
+struct R250UniformKernel
+{
+  uint64_t operator()(uint64_t calls)
+  {
+    double sum=0.0;
+    for(uint64_t n=0;n<calls;n++) sum+=rng.r250_uniform();
+    return uint64_t(sum);
+  }
+  R250 rng;
+};
+
+//! The static generator as used by the updaters and moves
+struct RandomNumberGeneratorsRandKernel
+{
+  uint64_t operator()(uint64_t calls)
+  {
+    uint64_t sum=0;
+    for(uint64_t n=0;n<calls;n++) sum+=rng.r250_rand32();
+    return sum;
+  }
+  RandomNumberGenerators rng;
+};
+
+//! The static generator as used by the updaters and moves
+struct RandomNumberGeneratorsDrandKernel
+{
+  uint64_t operator()(uint64_t calls)
+  {
+    double sum=0.0;
+    for(uint64_t n=0;n<calls;n++) sum+=rng.r250_drand();
+    return uint64_t(sum);
+  }
+  RandomNumberGenerators rng;
+};
+
+template<class Kernel>
+BenchmarkRecord benchmarkRng(const std::string& name, uint32_t, const MicroBenchmarkOptions& options)
+{
+  RandomNumberGenerators rng;
+  rng.seedAll(benchmarkSeeds(options.seed));
+  Kernel kernel;
+  return measure(name,kernel,options);
+}
+
+/*****************************************************************************/
+//vector arithmetic
+
+//! Sum of two integer vectors, e.g. position plus bond vector
+struct VectorAddKernel
+{
+  explicit VectorAddKernel(const std::vector<VectorInt3>& vectors):vectors(vectors){}
+  uint64_t operator()(uint64_t calls) const
+  {
+    VectorInt3 sum(0,0,0);
+    for(uint64_t n=0;n<calls;n++) sum=sum+vectors[n&(nArguments-1)];
+    return uint64_t(sum.getX()+sum.getY()+sum.getZ());
+  }
+  const std::vector<VectorInt3>& vectors;
+};
+
+//! Scalar product of consecutive integer vectors
+struct VectorDotKernel
+{
+  explicit VectorDotKernel(const std::vector<VectorInt3>& vectors):vectors(vectors){}
+  uint64_t operator()(uint64_t calls) const
+  {
+    int64_t sum=0;
+    for(uint64_t n=0;n<calls;n++) sum+=vectors[n&(nArguments-1)]*vectors[(n+1)&(nArguments-1)];
+    return uint64_t(sum);
+  }
+  const std::vector<VectorInt3>& vectors;
+};
+
+//! Length of floating point vectors (square root)
+struct VectorLengthKernel
+{
+  explicit VectorLengthKernel(const std::vector<VectorInt3>& vectors)
+  {
+    for(size_t n=0;n<vectors.size();n++) doubles.push_back(VectorDouble3(vectors[n]));
+  }
+  uint64_t operator()(uint64_t calls) const
+  {
+    double sum=0.0;
+    for(uint64_t n=0;n<calls;n++) sum+=doubles[n&(nArguments-1)].getLength();
+    return uint64_t(sum);
+  }
+  std::vector<VectorDouble3> doubles;
+};
+
+template<class Kernel>
+BenchmarkRecord benchmarkVector(const std::string& name, uint32_t, const MicroBenchmarkOptions& options)
+{
+  ArgumentGenerator args(options.seed);
+  std::vector<VectorInt3> vectors;
+  for(size_t n=0;n<nArguments;n++) vectors.push_back(args.vector(-64,64));
+  Kernel kernel(vectors);
+  return measure(name,kernel,options);
+}
+
+/*****************************************************************************/
+//minimum image distances
+
+//! Periodic cubic box for the distance calculations
+struct PeriodicBox
+{
+  explicit PeriodicBox(uint32_t box):box(box){}
+  uint32_t getBoxX() const {return box;}
+  uint32_t getBoxY() const {return box;}
+  uint32_t getBoxZ() const {return box;}
+  bool isPeriodicX() const {return true;}
+  bool isPeriodicY() const {return true;}
+  bool isPeriodicZ() const {return true;}
+  uint32_t box;
+};
+
+//! Squared distance of one pair per call with Lemonade::MinImageVector
+struct MinImageVectorKernel
+{
+  MinImageVectorKernel(const PeriodicBox& box, const std::vector<VectorInt3>& positions):box(box),positions(positions){}
+  uint64_t operator()(uint64_t calls) const
+  {
+    int64_t sum=0;
+    for(uint64_t n=0;n<calls;n++)
+    {
+      VectorInt3 d=Lemonade::MinImageVector(positions[n&(nArguments-1)],positions[(n+1)&(nArguments-1)],box);
+      sum+=d*d;
+    }
+    return uint64_t(sum);
+  }
+  PeriodicBox box;
+  const std::vector<VectorInt3>& positions;
+};
+
+//! Squared distances of nArguments pairs at once with Lemonade::MinImageSquaredDistances, one call per pair
+struct MinImageBatchKernel
+{
+  MinImageBatchKernel(const PeriodicBox& box, const std::vector<VectorInt3>& positions)
+  :box(box),distance2(nArguments)
+  {
+    first.assign(positions);
+    std::vector<VectorInt3> shifted(positions.begin()+1,positions.end());
+    shifted.push_back(positions[0]);
+    second.assign(shifted);
+  }
+  uint64_t operator()(uint64_t calls)
+  {
+    int64_t sum=0;
+    for(uint64_t n=0;n<calls;n+=nArguments)
+    {
+      size_t count=size_t(std::min<uint64_t>(nArguments,calls-n));
+      Lemonade::MinImageSquaredDistances(box,first.span(0,count),second.span(0,count),&distance2[0]);
+      sum+=distance2[n&(nArguments-1)]+distance2[count-1];
+    }
+    return uint64_t(sum);
+  }
+  Lemonade::MinImageBox box;
+  Lemonade::CoordinatesSoA first,second;
+  std::vector<int64_t> distance2;
+};
+
+template<class Kernel>
+BenchmarkRecord benchmarkMinImage(const std::string& name, uint32_t box, const MicroBenchmarkOptions& options)
+{
+  ArgumentGenerator args(options.seed);
+  std::vector<VectorInt3> positions;
+  for(size_t n=0;n<nArguments;n++) positions.push_back(args.vector(-2*int32_t(box),2*int32_t(box)));
+  PeriodicBox periodicBox(box);
+  Kernel kernel(periodicBox,positions);
+  return measure(name,kernel,options);
+}
+
+/*****************************************************************************/
+//neighbor lists
+
+typedef Connected<VectorInt3,7> ConnectedVertex;
+
+//! Connects every vertex to four random partners, starting from empty neighbor lists
+struct ConnectKernel
+{
+  ConnectKernel(const std::vector<uint32_t>& partners):partners(partners),vertices(nArguments){}
+  uint64_t operator()(uint64_t calls)
+  {
+    const ConnectedVertex empty;
+    uint64_t n=0;
+    while(n<calls)
+    {
+      size_t idx=(n/4)&(nArguments-1);
+      if(n%4==0) vertices[idx]=empty;
+      vertices[idx].connect(partners[n&(nArguments-1)]);
+      n++;
+    }
+    return vertices[0].getNumLinks();
+  }
+  const std::vector<uint32_t>& partners;
+  std::vector<ConnectedVertex> vertices;
+};
+
+//! Reads all neighbors of vertices with four neighbors each
+struct NeighborIdxKernel
+{
+  NeighborIdxKernel(const std::vector<uint32_t>& partners):vertices(nArguments)
+  {
+    for(size_t n=0;n<4*nArguments;n++) vertices[n/4].connect(partners[n&(nArguments-1)]);
+  }
+  uint64_t operator()(uint64_t calls) const
+  {
+    uint64_t sum=0;
+    for(uint64_t n=0;n<calls;n++) sum+=vertices[(n/4)&(nArguments-1)].getNeighborIdx(n%4);
+    return sum;
+  }
+  std::vector<ConnectedVertex> vertices;
+};
+
+template<class Kernel>
+BenchmarkRecord benchmarkConnected(const std::string& name, uint32_t, const MicroBenchmarkOptions& options)
+{
+  //partners of one vertex are consecutive entries, which have to be distinct
+  std::vector<uint32_t> partners;
+  for(size_t n=0;n<nArguments;n++) partners.push_back(uint32_t(n*7919%1000003));
+  Kernel kernel(partners);
+  return measure(name,kernel,options);
+}
+
+/*****************************************************************************/
+//benchmark registry
+
+typedef BenchmarkRecord (*BenchmarkFunction)(const std::string&, uint32_t, const MicroBenchmarkOptions&);
+
+//! One benchmark: a primitive of a given implementation, e.g. with a given box size
+struct MicroBenchmarkCase
+{
+  MicroBenchmarkCase(const std::string& name, BenchmarkFunction function, uint32_t box=0)
+  :name(name),function(function),box(box)
+  {
+    if(box>0)
+    {
+      std::stringstream stream;
+      stream<<name<<"/L"<<box;
+      this->name=stream.str();
+    }
+  }
+  std::string name;
+  BenchmarkFunction function;
+  uint32_t box;
+};
+
+std::vector<MicroBenchmarkCase> allBenchmarks()
+{
+  std::vector<MicroBenchmarkCase> cases;
+  //L64 fits into the cache, L256 does not
+  const uint32_t boxes[2]={64,256};
+  for(int n=0;n<2;n++)
+  {
+    cases.push_back(MicroBenchmarkCase("lattice/getLatticeEntry/Lattice",&benchmarkLatticeGet<Lattice<uint8_t> >,boxes[n]));
+    cases.push_back(MicroBenchmarkCase("lattice/getLatticeEntry/FeatureLattice",&benchmarkLatticeGet<FeatureLattice<uint8_t> >,boxes[n]));
+    cases.push_back(MicroBenchmarkCase("lattice/getLatticeEntry/FeatureLatticePowerOfTwo",&benchmarkLatticeGet<FeatureLatticePowerOfTwo<uint8_t> >,boxes[n]));
+  }
+  for(int n=0;n<2;n++)
+  {
+    cases.push_back(MicroBenchmarkCase("lattice/moveOnLattice/Lattice",&benchmarkLatticeMove<Lattice<uint8_t> >,boxes[n]));
+    cases.push_back(MicroBenchmarkCase("lattice/moveOnLattice/FeatureLattice",&benchmarkLatticeMove<FeatureLattice<uint8_t> >,boxes[n]));
+    cases.push_back(MicroBenchmarkCase("lattice/moveOnLattice/FeatureLatticePowerOfTwo",&benchmarkLatticeMove<FeatureLatticePowerOfTwo<uint8_t> >,boxes[n]));
+  }
+  cases.push_back(MicroBenchmarkCase("bondset/isValidStrongCheck/FastBondset",&benchmarkBondset<FastBondset>));
+  cases.push_back(MicroBenchmarkCase("bondset/isValidStrongCheck/SlowBondset",&benchmarkBondset<SlowBondset>));
+  cases.push_back(MicroBenchmarkCase("rng/R250::r250_rand",&benchmarkRng<R250RandKernel>));
+  cases.push_back(MicroBenchmarkCase("rng/R250::r250_uniform",&benchmarkRng<R250UniformKernel>));
+  cases.push_back(MicroBenchmarkCase("rng/RandomNumberGenerators::r250_rand32",&benchmarkRng<RandomNumberGeneratorsRandKernel>));
+  cases.push_back(MicroBenchmarkCase("rng/RandomNumberGenerators::r250_drand",&benchmarkRng<RandomNumberGeneratorsDrandKernel>));
+  cases.push_back(MicroBenchmarkCase("vector/VectorInt3::operator+",&benchmarkVector<VectorAddKernel>));
+  cases.push_back(MicroBenchmarkCase("vector/VectorInt3::operator*",&benchmarkVector<VectorDotKernel>));
+  cases.push_back(MicroBenchmarkCase("vector/VectorDouble3::getLength",&benchmarkVector<VectorLengthKernel>));
+  //power of two (bit mask) and arbitrary (remainder) box size
+  const uint32_t distanceBoxes[2]={64,60};
+  for(int n=0;n<2;n++)
+  {
+    cases.push_back(MicroBenchmarkCase("distance/MinImageVector",&benchmarkMinImage<MinImageVectorKernel>,distanceBoxes[n]));
+    cases.push_back(MicroBenchmarkCase("distance/MinImageSquaredDistances",&benchmarkMinImage<MinImageBatchKernel>,distanceBoxes[n]));
+  }
+  cases.push_back(MicroBenchmarkCase("connected/Connected::connect",&benchmarkConnected<ConnectKernel>));
+  cases.push_back(MicroBenchmarkCase("connected/Connected::getNeighborIdx",&benchmarkConnected<NeighborIdxKernel>));
+  return cases;
+}
+
+void printUsage(const std::vector<MicroBenchmarkCase>& cases)
+{
+  std::cerr<<"usage: LeMonADE-microbench [options]\n\n"
+	   <<"Times single primitives and reports the time per call as JSON.\n\n"
+	   <<"options:\n"
+	   <<"  --calls N        calls per repetition (default 4194304)\n"
+	   <<"  --warmup N       untimed repetitions (default 3)\n"
+	   <<"  --repetitions N  timed repetitions (default 15)\n"
+	   <<"  --seed N         seed of the random arguments (default 1)\n"
+	   <<"  --filter TEXT    only benchmarks whose name contains TEXT\n"
+	   <<"  --output FILE    write the JSON to FILE instead of stdout\n"
+	   <<"  --list           list the benchmarks\n\n"
+	   <<"benchmarks:\n";
+  for(size_t n=0;n<cases.size();n++)
+    std::cerr<<"  "<<cases[n].name<<"\n";
+}
+
+//! Value of the option at position n, throws if missing
+const char* optionValue(int argc, char* argv[], int& n)
+{
+  if(n+1>=argc)
+  {
+    std::stringstream errormessage;
+    errormessage<<"LeMonADE-microbench: option "<<argv[n]<<" needs a value";
+    throw std::runtime_error(errormessage.str());
+  }
+  return argv[++n];
+}
+
+}//end namespace
+
+int main(int argc, char* argv[])
+{
+  try{
+    std::vector<MicroBenchmarkCase> cases=allBenchmarks();
+    MicroBenchmarkOptions options;
+    for(int n=1;n<argc;n++)
+    {
+      std::string arg(argv[n]);
+      if(arg=="--calls") std::istringstream(optionValue(argc,argv,n))>>options.calls;
+      else if(arg=="--warmup") options.warmup=std::atoi(optionValue(argc,argv,n));
+      else if(arg=="--repetitions") options.repetitions=std::atoi(optionValue(argc,argv,n));
+      else if(arg=="--seed") options.seed=std::atoi(optionValue(argc,argv,n));
+      else if(arg=="--filter") options.filter=optionValue(argc,argv,n);
+      else if(arg=="--output") options.output=optionValue(argc,argv,n);
+      else if(arg=="--list"){
+	for(size_t i=0;i<cases.size();i++) std::cout<<cases[i].name<<"\n";
+	return 0;
+      }
+      else{
+	printUsage(cases);
+	return (arg=="--help" || arg=="-h")?0:1;
+      }
+    }
+    if(options.calls==0 || options.repetitions==0)
+      throw std::runtime_error("LeMonADE-microbench: --calls and --repetitions must be positive");
+
+    BenchmarkRecord runInfo=benchmarkRunInfo("LeMonADE-microbench");
+    runInfo.add("calls_per_repetition",options.calls);
+    runInfo.add("warmup_repetitions",options.warmup);
+    runInfo.add("repetitions",options.repetitions);
+    runInfo.add("seed",options.seed);
+
+    std::vector<BenchmarkRecord> results;
+    for(size_t n=0;n<cases.size();n++)
+    {
+      if(cases[n].name.find(options.filter)==std::string::npos) continue;
+      std::cerr<<std::left<<std::setw(60)<<cases[n].name<<std::right<<std::flush;
+      //setup routines of lattices and bondsets report to std::cout
+      SilenceStdout silence;
+      results.push_back(cases[n].function(cases[n].name,cases[n].box,options));
+    }
+
+    if(options.output.empty()) writeBenchmarkJson(std::cout,runInfo,results);
+    else
+    {
+      std::ofstream file(options.output.c_str());
+      if(!file.is_open())
+      {
+	std::stringstream errormessage;
+	errormessage<<"LeMonADE-microbench: cannot open output file "<<options.output;
+	throw std::runtime_error(errormessage.str());
+      }
+      writeBenchmarkJson(file,runInfo,results);
+    }
+  }
+  catch(std::exception& err){
+    std::cerr<<err.what()<<std::endl;
+    return 1;
+  }
+  return 0;
+}
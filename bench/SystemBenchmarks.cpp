@@ -0,0 +1,651 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief End-to-end benchmarks of complete simulations (target LeMonADE-bench)
+ *
+ * @details Representative systems are set up and simulated with the standard
+ * updaters for a fixed number of MCS after a warmup. For every system the
+ * attempted and accepted moves per second, the time per attempted move and
+ * the peak resident set size of the process are reported as JSON. The
+ * write_mcs benchmark instead writes frames of a system with WriteMcs and with
+ * its previous stringstream based implementation and reports the frames per
+ * second of both. Run with --help for the options.
+ * */
+/*****************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/core/ConfigureSystem.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/core/MoleculesWrite.h>
+#include <LeMonADE/feature/FeatureAttributes.h>
+#include <LeMonADE/feature/FeatureConnectionSc.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeBcc.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
+#include <LeMonADE/feature/FeatureLattice.h>
+#include <LeMonADE/feature/FeatureLatticePowerOfTwo.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
+#include <LeMonADE/feature/FeatureNNInteractionSc.h>
+#include <LeMonADE/updater/UpdaterAddLinearChains.h>
+#include <LeMonADE/updater/UpdaterSimpleConnection.h>
+#include <LeMonADE/updater/UpdaterSimpleSimulator.h>
+#include <LeMonADE/updater/moves/MoveAddMonomerBcc.h>
+#include <LeMonADE/updater/moves/MoveConnectSc.h>
+#include <LeMonADE/updater/moves/MoveLocalBcc.h>
+#include <LeMonADE/updater/moves/MoveLocalSc.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+#include <LeMonADE/utility/Timer.h>
+
+#include "BenchmarkTools.h"
+#include "StreamWriteMcs.h"
+
+namespace
+{
+
+//! Settings of the benchmark run
+struct BenchmarkOptions
+{
+  BenchmarkOptions():mcs(1000),warmup(100),seed(1),quick(false){}
+
+  //! MCS of the measurement
+  uint32_t mcs;
+  //! MCS simulated before the measurement
+  uint32_t warmup;
+  //! base seed of the random number generators
+  uint32_t seed;
+  //! small boxes only
+  bool quick;
+  //! only benchmarks containing this text in their name are run
+  std::string filter;
+  //! JSON output file, stdout if empty
+  std::string output;
+};
+
+//! Name of the lattice feature used in the benchmark names
+template<template<typename> class LatticeType> struct LatticeName;
+template<> struct LatticeName<FeatureLattice>{static const char* get(){return "FeatureLattice";}};
+template<> struct LatticeName<FeatureLatticePowerOfTwo>{static const char* get(){return "FeatureLatticePowerOfTwo";}};
+
+//! Sets up an empty periodic cubic box of size boxSize and synchronizes it
+template<class IngredientsType>
+void setupBox(IngredientsType& ingredients, int32_t boxSize, bool bcc=false)
+{
+  ingredients.setBoxX(boxSize);
+  ingredients.setBoxY(boxSize);
+  ingredients.setBoxZ(boxSize);
+  ingredients.setPeriodicX(true);
+  ingredients.setPeriodicY(true);
+  ingredients.setPeriodicZ(true);
+  if(bcc) ingredients.modifyBondset().addBccBFMclassicBondset();
+  else ingredients.modifyBondset().addBFMclassicBondset();
+  ingredients.synchronize();
+}
+
+//! Number of chains of length chainLength needed for volume fraction phi (8 sites per monomer)
+inline uint32_t chainsForVolumeFraction(int32_t boxSize, uint32_t chainLength, double phi)
+{
+  double sites=double(boxSize)*double(boxSize)*double(boxSize);
+  uint32_t nChains=uint32_t(phi*sites/(8.0*chainLength)+0.5);
+  return nChains>0?nChains:1;
+}
+
+//! Volume fraction occupied by the monomers (8 sites per monomer)
+template<class IngredientsType>
+double volumeFraction(const IngredientsType& ingredients)
+{
+  return 8.0*double(ingredients.getMolecules().size())
+    /(double(ingredients.getBoxX())*double(ingredients.getBoxY())*double(ingredients.getBoxZ()));
+}
+
+/**
+ * @brief Simulates the system and records the measured rates
+ *
+ * @details The updater is executed once for the warmup and once for the
+ * measurement. The rates are calculated from the work counters reported by
+ * the updater (see AbstractUpdater::addWorkCounters()).
+ */
+template<class IngredientsType, class UpdaterType>
+void measure(IngredientsType& ingredients, UpdaterType& warmup, UpdaterType& simulation,
+	     const BenchmarkOptions& options, double setupTime, BenchmarkRecord& result)
+{
+  if(options.warmup>0) warmup.execute();
+
+  Timer timer;
+  simulation.execute();
+  double seconds=timer.elapsed();
+
+  uint64_t attempted=simulation.getAttemptedMoves();
+  uint64_t accepted=simulation.getAcceptedMoves();
+
+  result.add("monomers",uint64_t(ingredients.getMolecules().size()));
+  result.add("volume_fraction",volumeFraction(ingredients));
+  result.add("setup_seconds",setupTime);
+  result.add("warmup_mcs",options.warmup);
+  result.add("mcs",simulation.getPerformedMcs());
+  result.add("seconds",seconds);
+  result.add("attempted_moves",attempted);
+  result.add("accepted_moves",accepted);
+  result.add("attempted_moves_per_second",double(attempted)/seconds);
+  result.add("accepted_moves_per_second",double(accepted)/seconds);
+  result.add("acceptance_ratio",attempted>0?double(accepted)/double(attempted):0.0);
+  result.add("ns_per_attempt",attempted>0?1.0e9*seconds/double(attempted):0.0);
+  result.add("peak_rss_kb",peakResidentSetSizeKb());
+}
+
+//! Common fields of all results
+BenchmarkRecord newResult(const std::string& name, const std::string& system, const std::string& lattice, int32_t boxSize)
+{
+  BenchmarkRecord result;
+  result.add("name",name);
+  result.add("system",system);
+  result.add("lattice",lattice);
+  result.add("box",boxSize);
+  return result;
+}
+
+/*****************************************************************************/
+//the benchmarked systems
+
+/**
+ * @brief Melt of linear chains (N=32) at volume fraction 0.5, moves MoveLocalSc
+ */
+template<template<typename> class LatticeType>
+BenchmarkRecord benchmarkMelt(const std::string& name, int32_t boxSize, const BenchmarkOptions& options)
+{
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO,FeatureAttributes<>,FeatureExcludedVolumeSc<LatticeType<bool> >) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> Ing;
+
+  const uint32_t chainLength=32;
+  Ing ingredients;
+  Timer setupTimer;
+  setupBox(ingredients,boxSize);
+  UpdaterAddLinearChains<Ing> chains(ingredients,chainsForVolumeFraction(boxSize,chainLength,0.5),chainLength);
+  chains.initialize();
+  double setupTime=setupTimer.elapsed();
+
+  BenchmarkRecord result=newResult(name,"melt",LatticeName<LatticeType>::get(),boxSize);
+  result.add("chain_length",chainLength);
+  UpdaterSimpleSimulator<Ing,MoveLocalSc> warmup(ingredients,options.warmup);
+  UpdaterSimpleSimulator<Ing,MoveLocalSc> simulation(ingredients,options.mcs);
+  measure(ingredients,warmup,simulation,options,setupTime,result);
+  return result;
+}
+
+/**
+ * @brief Dilute solution of linear chains (N=64) at volume fraction 0.02
+ */
+template<template<typename> class LatticeType>
+BenchmarkRecord benchmarkDilute(const std::string& name, int32_t boxSize, const BenchmarkOptions& options)
+{
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO,FeatureAttributes<>,FeatureExcludedVolumeSc<LatticeType<bool> >) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> Ing;
+
+  const uint32_t chainLength=64;
+  Ing ingredients;
+  Timer setupTimer;
+  setupBox(ingredients,boxSize);
+  UpdaterAddLinearChains<Ing> chains(ingredients,chainsForVolumeFraction(boxSize,chainLength,0.02),chainLength);
+  chains.initialize();
+  double setupTime=setupTimer.elapsed();
+
+  BenchmarkRecord result=newResult(name,"dilute",LatticeName<LatticeType>::get(),boxSize);
+  result.add("chain_length",chainLength);
+  UpdaterSimpleSimulator<Ing,MoveLocalSc> warmup(ingredients,options.warmup);
+  UpdaterSimpleSimulator<Ing,MoveLocalSc> simulation(ingredients,options.mcs);
+  measure(ingredients,warmup,simulation,options,setupTime,result);
+  return result;
+}
+
+/**
+ * @brief Symmetric blend of A and B chains (N=32) at volume fraction 0.5
+ * with nearest neighbor interaction epsilon_AB=0.2
+ */
+template<template<typename> class LatticeType>
+BenchmarkRecord benchmarkBlend(const std::string& name, int32_t boxSize, const BenchmarkOptions& options)
+{
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO,FeatureAttributes<>,FeatureNNInteractionSc<LatticeType>) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> Ing;
+
+  const uint32_t chainLength=32;
+  Ing ingredients;
+  Timer setupTimer;
+  ingredients.setNNInteraction(1,2,0.2);
+  setupBox(ingredients,boxSize);
+  uint32_t nChains=chainsForVolumeFraction(boxSize,chainLength,0.5);
+  UpdaterAddLinearChains<Ing> chainsA(ingredients,nChains/2,chainLength,1,1);
+  chainsA.initialize();
+  UpdaterAddLinearChains<Ing> chainsB(ingredients,nChains-nChains/2,chainLength,2,2);
+  chainsB.initialize();
+  double setupTime=setupTimer.elapsed();
+
+  BenchmarkRecord result=newResult(name,"nn_blend",LatticeName<LatticeType>::get(),boxSize);
+  result.add("chain_length",chainLength);
+  result.add("epsilon_ab",0.2);
+  UpdaterSimpleSimulator<Ing,MoveLocalSc> warmup(ingredients,options.warmup);
+  UpdaterSimpleSimulator<Ing,MoveLocalSc> simulation(ingredients,options.mcs);
+  measure(ingredients,warmup,simulation,options,setupTime,result);
+  return result;
+}
+
+/**
+ * @brief Network formation: chains (N=16) with reactive ends and tetrafunctional
+ * crosslinkers at volume fraction 0.5, simulated with UpdaterSimpleConnection
+ */
+template<template<typename> class LatticeType>
+BenchmarkRecord benchmarkNetwork(const std::string& name, int32_t boxSize, const BenchmarkOptions& options)
+{
+  typedef LOKI_TYPELIST_4(FeatureMoleculesIO,FeatureAttributes<>,FeatureExcludedVolumeSc<LatticeType<bool> >,FeatureConnectionSc) Features;
+  typedef ConfigureSystem<VectorInt3,Features,4> Config;
+  typedef Ingredients<Config> Ing;
+
+  const uint32_t chainLength=16;
+  Ing ingredients;
+  Timer setupTimer;
+  setupBox(ingredients,boxSize);
+  //stoichiometric: two chain ends per crosslink site
+  uint32_t nChains=chainsForVolumeFraction(boxSize,chainLength,0.5*chainLength/(chainLength+0.5));
+  UpdaterAddLinearChains<Ing> chains(ingredients,nChains,chainLength);
+  chains.initialize();
+  UpdaterAddLinearChains<Ing> crosslinkers(ingredients,nChains/2,1,3,3);
+  crosslinkers.initialize();
+  for(size_t n=0;n<ingredients.getMolecules().size();n++)
+  {
+    uint32_t nLinks=ingredients.getMolecules().getNumLinks(n);
+    if(nLinks>1) continue;
+    ingredients.modifyMolecules()[n].setReactive(true);
+    //chain ends get one additional bond, crosslinkers four
+    ingredients.modifyMolecules()[n].setNumMaxLinks(nLinks==1?2:4);
+  }
+  ingredients.synchronize();
+  double setupTime=setupTimer.elapsed();
+
+  BenchmarkRecord result=newResult(name,"network",LatticeName<LatticeType>::get(),boxSize);
+  result.add("chain_length",chainLength);
+  result.add("crosslinkers",nChains/2);
+  UpdaterSimpleConnection<Ing,MoveLocalSc,MoveConnectSc> warmup(ingredients,options.warmup);
+  UpdaterSimpleConnection<Ing,MoveLocalSc,MoveConnectSc> simulation(ingredients,options.mcs);
+  warmup.initialize();
+  measure(ingredients,warmup,simulation,options,setupTime,result);
+  result.add("conversion",warmup.getConversion());
+  return result;
+}
+
+/**
+ * @brief Melt of linear chains (N=32) on the bcc lattice, moves MoveLocalBcc
+ *
+ * @details UpdaterAddLinearChains only knows simple cubic moves, therefore the
+ * chains are grown here as random walks with MoveAddMonomerBcc. Trapped
+ * chain ends are freed by single MCS of the whole system.
+ */
+template<template<typename> class LatticeType>
+BenchmarkRecord benchmarkBcc(const std::string& name, int32_t boxSize, const BenchmarkOptions& options)
+{
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO,FeatureAttributes<>,FeatureExcludedVolumeBcc<LatticeType<bool> >) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> Ing;
+
+  const uint32_t chainLength=32;
+  //bonds within the even sub-lattice, (2,0,0) is avoided because the
+  //insertion rejects positions with two neighbors along the axes
+  const VectorInt3 bonds[20]={VectorInt3(2,2,2),VectorInt3(2,2,-2),VectorInt3(2,-2,2),VectorInt3(2,-2,-2),
+			      VectorInt3(-2,2,2),VectorInt3(-2,2,-2),VectorInt3(-2,-2,2),VectorInt3(-2,-2,-2),
+			      VectorInt3(2,2,0),VectorInt3(2,-2,0),VectorInt3(-2,2,0),VectorInt3(-2,-2,0),
+			      VectorInt3(2,0,2),VectorInt3(2,0,-2),VectorInt3(-2,0,2),VectorInt3(-2,0,-2),
+			      VectorInt3(0,2,2),VectorInt3(0,2,-2),VectorInt3(0,-2,2),VectorInt3(0,-2,-2)};
+  RandomNumberGenerators rng;
+  Ing ingredients;
+  Timer setupTimer;
+  setupBox(ingredients,boxSize,true);
+  uint32_t nChains=chainsForVolumeFraction(boxSize,chainLength,0.25);
+  MoveAddMonomerBcc<> addMove;
+  addMove.setTag(1);
+  //relaxes the system if a chain end is trapped
+  UpdaterSimpleSimulator<Ing,MoveLocalBcc> relaxation(ingredients,1);
+  for(uint32_t chain=0;chain<nChains;chain++)
+  {
+    for(uint32_t n=0;n<chainLength;n++)
+    {
+      bool added=false;
+      for(int attempt=0;attempt<100000 && !added;attempt++)
+      {
+	if(attempt>0 && attempt%100==0) relaxation.execute();
+	addMove.init(ingredients);
+	if(n==0)
+	  addMove.setPosition(2*int32_t(rng.r250_rand32()%(boxSize/2)),
+			      2*int32_t(rng.r250_rand32()%(boxSize/2)),
+			      2*int32_t(rng.r250_rand32()%(boxSize/2)));
+	else
+	  addMove.setPosition(ingredients.getMolecules()[ingredients.getMolecules().size()-1]+bonds[rng.r250_rand32()%20]);
+	if(addMove.check(ingredients))
+	{
+	  addMove.apply(ingredients);
+	  size_t last=ingredients.getMolecules().size()-1;
+	  if(n>0) ingredients.modifyMolecules().connect(last-1,last);
+	  added=true;
+	}
+      }
+      if(!added) throw std::runtime_error("benchmarkBcc: cannot place monomer, box too small");
+    }
+  }
+  ingredients.synchronize();
+  double setupTime=setupTimer.elapsed();
+
+  BenchmarkRecord result=newResult(name,"bcc_melt",LatticeName<LatticeType>::get(),boxSize);
+  result.add("chain_length",chainLength);
+  UpdaterSimpleSimulator<Ing,MoveLocalBcc> warmup(ingredients,options.warmup);
+  UpdaterSimpleSimulator<Ing,MoveLocalBcc> simulation(ingredients,options.mcs);
+  measure(ingredients,warmup,simulation,options,setupTime,result);
+  return result;
+}
+
+/*****************************************************************************/
+//output
+
+/**
+ * @class ChecksumBuffer
+ * @brief Stream buffer counting and hashing the written bytes instead of storing them
+ *
+ * @details Used as the target of the write benchmark, such that the formatting
+ * is measured without the file system, and the outputs of different writers
+ * can be compared.
+ **/
+class ChecksumBuffer: public std::streambuf
+{
+public:
+  ChecksumBuffer():bytes(0),hash(14695981039346656037ull){}
+
+  uint64_t getBytes() const {return bytes;}
+  uint64_t getHash() const {return hash;}
+
+protected:
+  virtual int overflow(int c)
+  {
+    if(c!=traits_type::eof()) add(char(c));
+    return traits_type::not_eof(c);
+  }
+
+  virtual std::streamsize xsputn(const char* s, std::streamsize n)
+  {
+    for(std::streamsize i=0;i<n;i++) add(s[i]);
+    return n;
+  }
+
+private:
+  //! FNV-1a hash of all bytes
+  void add(char c)
+  {
+    hash=(hash^uint64_t(uint8_t(c)))*1099511628211ull;
+    bytes++;
+  }
+
+  uint64_t bytes;
+  uint64_t hash;
+};
+
+/**
+ * @brief Times writing frames with the writer and records frames per second
+ *
+ * @details One frame is written before the measurement. The age is increased
+ * for every frame, as in a simulation.
+ *
+ * @return frames per second
+ */
+template<class IngredientsType, class WriterType>
+double measureWriter(IngredientsType& ingredients, uint32_t frames, const std::string& key,
+		   BenchmarkRecord& result, ChecksumBuffer& buffer)
+{
+  std::ostream stream(&buffer);
+  WriterType writer(ingredients);
+  ingredients.modifyMolecules().setAge(0);
+  writer.writeStream(stream);
+
+  Timer timer;
+  for(uint32_t n=0;n<frames;n++)
+  {
+    ingredients.modifyMolecules().setAge(ingredients.getMolecules().getAge()+100);
+    writer.writeStream(stream);
+  }
+  double seconds=timer.elapsed();
+
+  result.add(key+"_seconds",seconds);
+  result.add(key+"_frames_per_second",double(frames)/seconds);
+  return double(frames)/seconds;
+}
+
+/**
+ * @brief Writing !mcs frames of chains (N=32, volume fraction 0.25) and
+ * compressed solvent (volume fraction 0.25) with WriteMcs and StreamWriteMcs
+ *
+ * @details options.mcs/10 frames are written by each writer. The benchmark
+ * fails if the outputs differ.
+ */
+BenchmarkRecord benchmarkWriteMcs(const std::string& name, int32_t boxSize, const BenchmarkOptions& options)
+{
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO,FeatureAttributes<>,FeatureExcludedVolumeSc<FeatureLattice<bool> >) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> Ing;
+
+  const uint32_t chainLength=32;
+  Ing ingredients;
+  Timer setupTimer;
+  setupBox(ingredients,boxSize);
+  UpdaterAddLinearChains<Ing> chains(ingredients,chainsForVolumeFraction(boxSize,chainLength,0.25),chainLength);
+  chains.initialize();
+  size_t solventStart=ingredients.getMolecules().size();
+  UpdaterAddLinearChains<Ing> solvent(ingredients,chainsForVolumeFraction(boxSize,1,0.25),1);
+  solvent.initialize();
+  ingredients.setCompressedOutputIndices(solventStart,ingredients.getMolecules().size()-1);
+  double setupTime=setupTimer.elapsed();
+
+  uint32_t frames=std::max(options.mcs/10,1u);
+  BenchmarkRecord result;
+  result.add("name",name);
+  result.add("system","write_mcs");
+  result.add("box",boxSize);
+  result.add("monomers",uint64_t(ingredients.getMolecules().size()));
+  result.add("solvent",uint64_t(ingredients.getMolecules().size()-solventStart));
+  result.add("setup_seconds",setupTime);
+  result.add("frames",frames);
+
+  ChecksumBuffer streamOutput,bufferedOutput;
+  double streamRate=measureWriter<Ing,StreamWriteMcs<Ing> >(ingredients,frames,"stringstream",result,streamOutput);
+  double bufferedRate=measureWriter<Ing,WriteMcs<Ing> >(ingredients,frames,"buffered",result,bufferedOutput);
+  if(streamOutput.getBytes()!=bufferedOutput.getBytes() || streamOutput.getHash()!=bufferedOutput.getHash())
+    throw std::runtime_error("benchmarkWriteMcs: the outputs of WriteMcs and StreamWriteMcs differ");
+
+  result.add("bytes_per_frame",double(bufferedOutput.getBytes())/double(frames+1));
+  result.add("speedup",bufferedRate/streamRate);
+  result.add("peak_rss_kb",peakResidentSetSizeKb());
+  return result;
+}
+
+/*****************************************************************************/
+//benchmark registry
+
+typedef BenchmarkRecord (*BenchmarkFunction)(const std::string&, int32_t, const BenchmarkOptions&);
+
+//! One benchmark: a system with a given lattice type and box size
+struct BenchmarkCase
+{
+  BenchmarkCase(const std::string& system, const std::string& lattice, int32_t box, BenchmarkFunction function, bool quick)
+  :function(function),box(box),quick(quick)
+  {
+    std::stringstream stream;
+    stream<<system<<"/"<<lattice<<"/L"<<box;
+    name=stream.str();
+  }
+  std::string name;
+  BenchmarkFunction function;
+  int32_t box;
+  //! part of the quick set
+  bool quick;
+};
+
+//! All benchmarks, sorted by increasing memory within each system
+std::vector<BenchmarkCase> allBenchmarks()
+{
+  std::vector<BenchmarkCase> cases;
+  const int32_t boxes[3]={32,64,128};
+  for(int n=0;n<3;n++)
+  {
+    cases.push_back(BenchmarkCase("melt","FeatureLattice",boxes[n],&benchmarkMelt<FeatureLattice>,n<1));
+    cases.push_back(BenchmarkCase("melt","FeatureLatticePowerOfTwo",boxes[n],&benchmarkMelt<FeatureLatticePowerOfTwo>,n<1));
+  }
+  for(int n=1;n<3;n++)
+  {
+    cases.push_back(BenchmarkCase("dilute","FeatureLattice",2*boxes[n],&benchmarkDilute<FeatureLattice>,n<2));
+    cases.push_back(BenchmarkCase("dilute","FeatureLatticePowerOfTwo",2*boxes[n],&benchmarkDilute<FeatureLatticePowerOfTwo>,n<2));
+  }
+  for(int n=0;n<3;n++)
+  {
+    cases.push_back(BenchmarkCase("nn_blend","FeatureLattice",boxes[n],&benchmarkBlend<FeatureLattice>,n<1));
+    cases.push_back(BenchmarkCase("nn_blend","FeatureLatticePowerOfTwo",boxes[n],&benchmarkBlend<FeatureLatticePowerOfTwo>,n<1));
+  }
+  for(int n=0;n<3;n++)
+  {
+    cases.push_back(BenchmarkCase("network","FeatureLattice",boxes[n],&benchmarkNetwork<FeatureLattice>,n<1));
+    cases.push_back(BenchmarkCase("network","FeatureLatticePowerOfTwo",boxes[n],&benchmarkNetwork<FeatureLatticePowerOfTwo>,n<1));
+  }
+  for(int n=0;n<3;n++)
+  {
+    cases.push_back(BenchmarkCase("bcc_melt","FeatureLattice",boxes[n],&benchmarkBcc<FeatureLattice>,n<2));
+    cases.push_back(BenchmarkCase("bcc_melt","FeatureLatticePowerOfTwo",boxes[n],&benchmarkBcc<FeatureLatticePowerOfTwo>,n<2));
+  }
+  for(int n=1;n<3;n++)
+    cases.push_back(BenchmarkCase("write_mcs","WriteMcs",boxes[n],&benchmarkWriteMcs,n<2));
+  return cases;
+}
+
+void printUsage(const std::vector<BenchmarkCase>& cases)
+{
+  std::cerr<<"usage: LeMonADE-bench [options]\n\n"
+	   <<"Simulates representative systems and reports the performance as JSON.\n\n"
+	   <<"options:\n"
+	   <<"  --quick          only the small systems\n"
+	   <<"  --mcs N          MCS of the measurement (default 1000), write_mcs writes N/10 frames\n"
+	   <<"  --warmup N       MCS before the measurement (default 100)\n"
+	   <<"  --seed N         seed of the random number generators (default 1)\n"
+	   <<"  --filter TEXT    only benchmarks whose name contains TEXT\n"
+	   <<"  --output FILE    write the JSON to FILE instead of stdout\n"
+	   <<"  --list           list the benchmarks\n\n"
+	   <<"benchmarks:\n";
+  for(size_t n=0;n<cases.size();n++)
+    std::cerr<<"  "<<cases[n].name<<(cases[n].quick?" (quick)":"")<<"\n";
+}
+
+//! Value of the option at position n, throws if missing
+const char* optionValue(int argc, char* argv[], int& n)
+{
+  if(n+1>=argc)
+  {
+    std::stringstream errormessage;
+    errormessage<<"LeMonADE-bench: option "<<argv[n]<<" needs a value";
+    throw std::runtime_error(errormessage.str());
+  }
+  return argv[++n];
+}
+
+}//end namespace
+
+int main(int argc, char* argv[])
+{
+  try{
+    std::vector<BenchmarkCase> cases=allBenchmarks();
+    BenchmarkOptions options;
+    for(int n=1;n<argc;n++)
+    {
+      std::string arg(argv[n]);
+      if(arg=="--quick") options.quick=true;
+      else if(arg=="--mcs") options.mcs=std::atoi(optionValue(argc,argv,n));
+      else if(arg=="--warmup") options.warmup=std::atoi(optionValue(argc,argv,n));
+      else if(arg=="--seed") options.seed=std::atoi(optionValue(argc,argv,n));
+      else if(arg=="--filter") options.filter=optionValue(argc,argv,n);
+      else if(arg=="--output") options.output=optionValue(argc,argv,n);
+      else if(arg=="--list"){
+	for(size_t i=0;i<cases.size();i++) std::cout<<cases[i].name<<"\n";
+	return 0;
+      }
+      else{
+	printUsage(cases);
+	return (arg=="--help" || arg=="-h")?0:1;
+      }
+    }
+
+    BenchmarkRecord runInfo=benchmarkRunInfo("LeMonADE-bench");
+    runInfo.add("mcs",options.mcs);
+    runInfo.add("warmup_mcs",options.warmup);
+    runInfo.add("seed",options.seed);
+    runInfo.add("quick",options.quick);
+
+    std::vector<BenchmarkRecord> results;
+    for(size_t n=0;n<cases.size();n++)
+    {
+      if(options.quick && !cases[n].quick) continue;
+      if(cases[n].name.find(options.filter)==std::string::npos) continue;
+
+      std::cerr<<"running "<<cases[n].name<<"..."<<std::flush;
+      //identical random numbers for all lattice types of a system
+      RandomNumberGenerators rng;
+      rng.seedAll(benchmarkSeeds(options.seed));
+      SilenceStdout silence;
+      results.push_back(cases[n].function(cases[n].name,cases[n].box,options));
+      std::cerr<<"done"<<std::endl;
+    }
+
+    if(options.output.empty()) writeBenchmarkJson(std::cout,runInfo,results);
+    else
+    {
+      std::ofstream file(options.output.c_str());
+      if(!file.is_open())
+      {
+	std::stringstream errormessage;
+	errormessage<<"LeMonADE-bench: cannot open output file "<<options.output;
+	throw std::runtime_error(errormessage.str());
+      }
+      writeBenchmarkJson(file,runInfo,results);
+    }
+  }
+  catch(std::exception& err){
+    std::cerr<<err.what()<<std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -73,6 +73,40 @@ public:
    *
    **/
   virtual void cleanup() = 0;
+
+  /**
+   * @brief Declares whether execute() may run concurrently with other analyzers.
+   *
+   * @details Used by the TaskManager if parallel analyzers are enabled (see
+   * TaskManager::setAnalyzerThreads()). Return true only if execute() reads the
+   * system without modifying it and writes exclusively to data owned by this
+   * analyzer (e.g. its own output file), in particular without using std::cout
+   * or the random number generators. By default analyzers are not thread safe
+   * and are executed by the thread running the TaskManager.
+   *
+   * @return True if execute() may run in a worker thread
+   **/
+  virtual bool isThreadSafe() const {return false;}
+
+  /**
+   * @brief Declares whether execute() works on a snapshot taken by takeSnapshot().
+   *
+   * @details If true, the TaskManager calls takeSnapshot() right before every
+   * call of execute(). If the analyzer is also thread safe and parallel analyzers
+   * are enabled, execute() may overlap with the next cycle of updaters and
+   * therefore must only use the data copied in takeSnapshot().
+   *
+   * @return True if the analyzer needs a snapshot of the system
+   **/
+  virtual bool needsSnapshot() const {return false;}
+
+  /**
+   * @brief Copies all data needed by execute() from the system (see needsSnapshot()).
+   *
+   * @details Always called by the thread running the TaskManager while the
+   * system is not modified.
+   **/
+  virtual void takeSnapshot(){}
 };
 
 /**
@@ -0,0 +1,323 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_ANALYZER_MEAN_SQUARE_DISPLACEMENT_H
+#define LEMONADE_ANALYZER_MEAN_SQUARE_DISPLACEMENT_H
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <LeMonADE/analyzer/AbstractAnalyzer.h>
+#include <LeMonADE/utility/MonomerGroup.h>
+#include <LeMonADE/utility/MultiTauCorrelator.h>
+#include <LeMonADE/utility/ResultFormattingTools.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+/*************************************************************************
+ * definition of AnalyzerMeanSquareDisplacement class
+ * ***********************************************************************/
+
+/**
+ * @file
+ *
+ * @class AnalyzerMeanSquareDisplacement
+ *
+ * @brief On the fly calculation of the mean square displacements g1, g2 and g3
+ *
+ * @tparam IngredientsType Ingredients class storing all system information( e.g. monomers, bonds, etc).
+ *
+ * @details The analyzer evaluates the mean square displacements
+ * - g1: of the monomers,
+ * - g2: of the monomers relative to the center of mass of their group,
+ * - g3: of the centers of mass of the groups
+ *
+ * using a MultiTauCorrelator. Every call of execute() adds the current
+ * (unfolded) monomer positions as one frame, i.e. the time resolution is the
+ * period of the analyzer in the TaskManager. The lags are logarithmically
+ * spaced, such that memory and work per frame only grow with the logarithm of
+ * the simulated time. The memory needed is about
+ * 12 bytes * nMonomers * pointsPerLevel * nLevels.
+ * By default the groups are the molecules (connected monomers). Other groups
+ * can be set in initialize() of a derived class with setMonomerGroups().
+ * The results are written to the file in cleanup() in the format
+ * lag(mcs) g1 g2 g3 nPairs
+ * The analyzer takes a snapshot of the positions, so it can run in parallel
+ * to the updaters (see TaskManager::setAnalyzerThreads()).
+ */
+template < class IngredientsType > class AnalyzerMeanSquareDisplacement : public AbstractAnalyzer
+{
+public:
+	//! positions of all analyzed monomers at one time, ordered by group
+	struct Frame
+	{
+		std::vector<VectorInt3> positions;
+		std::vector<VectorDouble3> centers;
+	};
+
+	//! calculates g1, g2 and g3 of a pair of frames
+	struct DisplacementFunction
+	{
+		void operator()(const Frame& earlier, const Frame& later, std::vector<double>& result) const;
+		//! group index of every position in the frames
+		std::vector<uint32_t> groupIndex;
+	};
+
+	typedef MultiTauCorrelator<Frame,DisplacementFunction> correlator_type;
+
+private:
+	//! typedef for the underlying container holding the monomers
+	typedef typename IngredientsType::molecules_type molecules_type;
+	//! reference to the complete system
+	const IngredientsType& ingredients;
+	//! g1, g2 and g3 are calculated for the monomers in these groups
+	std::vector<MonomerGroup<molecules_type> > groups;
+	//! correlator for the frames
+	correlator_type correlator;
+	//! positions copied in takeSnapshot()
+	Frame snapshot;
+	//! age of the system in takeSnapshot()
+	uint64_t snapshotAge;
+	//! age of the first frame
+	uint64_t firstAge;
+	//! mcs between consecutive frames, 0 before the second frame
+	uint64_t sampleInterval;
+	//! name of the output file
+	std::string outputFile;
+
+protected:
+	//! Set the groups to be analyzed. This function is meant to be used in initialize() of derived classes.
+	void setMonomerGroups(std::vector<MonomerGroup<molecules_type> > groupVector){groups=groupVector;}
+
+public:
+	//! constructor
+	AnalyzerMeanSquareDisplacement(const IngredientsType& ing,
+				       std::string filename="MSD.dat",
+				       uint32_t pointsPerLevel=16,
+				       uint32_t blockingFactor=2,
+				       uint32_t maxLevels=32);
+
+	//! destructor. does nothing
+	virtual ~AnalyzerMeanSquareDisplacement(){}
+	//! Sets up the groups and the assignment of monomers to groups. Called by TaskManager::initialize()
+	virtual void initialize();
+	//! Adds the positions of the last snapshot to the correlator. Called by TaskManager::execute()
+	virtual bool execute();
+	//! Writes the results to file
+	virtual void cleanup();
+	//! execute() only works on the snapshot and data of this analyzer
+	virtual bool isThreadSafe() const {return true;}
+	//! the positions are copied before every call of execute()
+	virtual bool needsSnapshot() const {return true;}
+	//! Copies the positions of the analyzed monomers
+	virtual void takeSnapshot();
+
+	//! Returns the columns lag(mcs), g1, g2, g3, nPairs
+	std::vector<std::vector<double> > getResults() const;
+	//! Writes the current results to the output file
+	void writeResults() const;
+	//! Change the output file name
+	void setOutputFile(std::string filename){outputFile=filename;}
+	//! Access to the correlator, e.g. for the number of frames and levels
+	const correlator_type& getCorrelator() const {return correlator;}
+};
+
+/*************************************************************************
+ * implementation of memebers
+ * ***********************************************************************/
+
+/**
+ * @param ing reference to the object holding all information of the system
+ * @param filename output file name. defaults to "MSD.dat".
+ * @param pointsPerLevel frames per level of the correlator (lags per decade grow with it)
+ * @param blockingFactor ratio of the time resolution of consecutive levels
+ * @param maxLevels limits the largest lag to about pointsPerLevel*blockingFactor^(maxLevels-1) frames
+ * */
+template<class IngredientsType>
+AnalyzerMeanSquareDisplacement<IngredientsType>::AnalyzerMeanSquareDisplacement(
+	const IngredientsType& ing,
+	std::string filename,
+	uint32_t pointsPerLevel,
+	uint32_t blockingFactor,
+	uint32_t maxLevels)
+:ingredients(ing)
+,correlator(pointsPerLevel,blockingFactor,maxLevels)
+,snapshotAge(0)
+,firstAge(0)
+,sampleInterval(0)
+,outputFile(filename)
+{
+}
+
+/**
+ * @details If no groups were set, the molecules (sets of connected monomers)
+ * are used as groups.
+ * */
+template< class IngredientsType >
+void AnalyzerMeanSquareDisplacement<IngredientsType>::initialize()
+{
+	if(groups.size()==0)
+		ingredients.getMolecules().getConnectedComponents().fillGroups(groups,MonomerGroup<molecules_type>(ingredients.getMolecules()));
+
+	std::vector<uint32_t>& groupIndex=correlator.getPairFunction().groupIndex;
+	groupIndex.clear();
+	for(size_t n=0;n<groups.size();n++)
+		groupIndex.resize(groupIndex.size()+groups[n].size(),uint32_t(n));
+
+	correlator.clear();
+	sampleInterval=0;
+	snapshot.positions.resize(groupIndex.size());
+	snapshot.centers.resize(groups.size());
+}
+
+template< class IngredientsType >
+void AnalyzerMeanSquareDisplacement<IngredientsType>::takeSnapshot()
+{
+	size_t idx=0;
+	for(size_t n=0;n<groups.size();n++)
+		for(size_t m=0;m<groups[n].size();m++)
+			snapshot.positions[idx++]=groups[n][m];
+	snapshotAge=ingredients.getMolecules().getAge();
+}
+
+/**
+ * @details The centers of mass are calculated from the snapshot. The frames
+ * must be taken in regular intervals, otherwise the lags in units of frames
+ * cannot be converted to mcs.
+ *
+ * @throw std::runtime_error if the interval between frames changes
+ * */
+template< class IngredientsType >
+bool AnalyzerMeanSquareDisplacement<IngredientsType>::execute()
+{
+	const std::vector<uint32_t>& groupIndex=correlator.getPairFunction().groupIndex;
+	std::vector<size_t> groupSize(snapshot.centers.size(),0);
+	for(size_t n=0;n<snapshot.centers.size();n++)
+		snapshot.centers[n]=VectorDouble3(0.0,0.0,0.0);
+	for(size_t n=0;n<snapshot.positions.size();n++)
+	{
+		snapshot.centers[groupIndex[n]]+=VectorDouble3(snapshot.positions[n]);
+		groupSize[groupIndex[n]]++;
+	}
+	for(size_t n=0;n<snapshot.centers.size();n++)
+		if(groupSize[n]>0) snapshot.centers[n]/=double(groupSize[n]);
+
+	uint64_t nFrames=correlator.getNumberOfFrames();
+	if(nFrames==0) firstAge=snapshotAge;
+	else if(nFrames==1) sampleInterval=snapshotAge-firstAge;
+	if(nFrames>0 && (sampleInterval==0 || snapshotAge!=firstAge+nFrames*sampleInterval))
+	{
+		std::stringstream errormessage;
+		errormessage<<"AnalyzerMeanSquareDisplacement::execute(): frames must be equally spaced in time, "
+			    <<"found frame "<<nFrames<<" at mcs "<<snapshotAge<<" after first frame at mcs "<<firstAge;
+		throw std::runtime_error(errormessage.str());
+	}
+
+	correlator.add(snapshot);
+	return true;
+}
+
+template<class IngredientsType>
+void AnalyzerMeanSquareDisplacement<IngredientsType>::cleanup()
+{
+	std::cout<<"AnalyzerMeanSquareDisplacement::cleanup()...";
+	writeResults();
+	std::cout<<"done\n";
+}
+
+/**
+ * @return Columns lag(mcs) g1 g2 g3 nPairs, one row per lag evaluated so far
+ * */
+template<class IngredientsType>
+std::vector<std::vector<double> > AnalyzerMeanSquareDisplacement<IngredientsType>::getResults() const
+{
+	std::vector<uint64_t> lags,counts;
+	std::vector<std::vector<double> > averages;
+	correlator.getResults(lags,averages,counts);
+
+	std::vector<std::vector<double> > results(5);
+	for(size_t n=0;n<lags.size();n++)
+	{
+		results[0].push_back(double(lags[n]*sampleInterval));
+		for(size_t k=0;k<3;k++) results[k+1].push_back(averages[n][k]);
+		results[4].push_back(double(counts[n]));
+	}
+	return results;
+}
+
+/**
+ * @details The file is overwritten, such that it can be called repeatedly
+ * to inspect intermediate results.
+ * */
+template<class IngredientsType>
+void AnalyzerMeanSquareDisplacement<IngredientsType>::writeResults() const
+{
+	std::vector<std::vector<double> > results=getResults();
+
+	std::stringstream comment;
+	comment<<"Created by AnalyzerMeanSquareDisplacement\n";
+	comment<<"multi-tau correlator with "<<correlator.getPointsPerLevel()<<" points per level, blocking factor "
+	       <<correlator.getBlockingFactor()<<", "<<correlator.getNumberOfFrames()<<" frames every "<<sampleInterval<<" mcs\n";
+	comment<<"g1: monomers, g2: monomers relative to group center of mass, g3: group centers of mass ("<<groups.size()<<" groups)\n";
+	comment<<"format: lag(mcs)\t g1\t g2\t g3\t nPairs\n";
+
+	ResultFormattingTools::writeResultFile(outputFile,ingredients,results,comment.str());
+}
+
+/**
+ * @param earlier frame at time t
+ * @param later frame at time t+lag
+ * @param[out] result g1, g2 and g3
+ * */
+template<class IngredientsType>
+void AnalyzerMeanSquareDisplacement<IngredientsType>::DisplacementFunction::operator()(const Frame& earlier, const Frame& later, std::vector<double>& result) const
+{
+	result.assign(3,0.0);
+	size_t nPositions=later.positions.size();
+	size_t nCenters=later.centers.size();
+	if(nPositions==0) return;
+
+	for(size_t n=0;n<nPositions;n++)
+	{
+		VectorDouble3 displacement(later.positions[n]-earlier.positions[n]);
+		uint32_t group=groupIndex[n];
+		VectorDouble3 relative=displacement-(later.centers[group]-earlier.centers[group]);
+		result[0]+=displacement*displacement;
+		result[1]+=relative*relative;
+	}
+	for(size_t n=0;n<nCenters;n++)
+	{
+		VectorDouble3 displacement=later.centers[n]-earlier.centers[n];
+		result[2]+=displacement*displacement;
+	}
+	result[0]/=double(nPositions);
+	result[1]/=double(nPositions);
+	result[2]/=double(nCenters);
+}
+
+#endif
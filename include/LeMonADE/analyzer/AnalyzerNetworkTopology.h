@@ -0,0 +1,248 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_ANALYZER_NETWORKTOPOLOGY_H
+#define LEMONADE_ANALYZER_NETWORKTOPOLOGY_H
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/analyzer/MergeableAnalyzer.h>
+#include <LeMonADE/utility/NetworkTopology.h>
+#include <LeMonADE/utility/ResultFormattingTools.h>
+
+/*************************************************************************
+ * definition of AnalyzerNetworkTopology class
+ * ***********************************************************************/
+
+/**
+ * @file
+ *
+ * @class AnalyzerNetworkTopology
+ *
+ * @brief Analyzer for the elastically active part of a polymer network
+ *
+ * @tparam IngredientsType Ingredients class storing all system information( e.g. monomers, bonds, etc).
+ *
+ * @details In every timestep the bond graph of the system is analyzed with
+ * NetworkTopology: dangling parts are stripped, the strands are contracted to
+ * a graph of junctions, loops of first and second order are counted and the
+ * elastically active network is determined. The time series is saved to disk
+ * in the format
+ * mcs junctions strands danglingMonomers firstOrderLoops secondOrderLoops freeRings
+ * activeJunctions activeStrands activeMonomers cycleRank activeCycleRank
+ * The default output filename is NetworkTopology.dat and it can be changed by argument
+ * to the constructor or by using the setter function provided.
+ * The results of the last timestep are available with getTopology().
+ * The analyzer is a MergeableAnalyzer, i.e. it can also be used with the
+ * MapReduceAnalysisDriver, which evaluates parts of a trajectory in parallel.
+ */
+template < class IngredientsType > class AnalyzerNetworkTopology : public MergeableAnalyzer<IngredientsType>
+{
+private:
+	//! number of columns in the time series without mcs
+	enum {nColumns=11};
+	//! reference to the complete system
+	const IngredientsType& ingredients;
+	//! topology of the last timestep
+	NetworkTopology topology;
+	//! time series of the columns listed in the class description
+	std::vector< std::vector<double> > timeSeries;
+	//! vector of mcs times for writing the time series
+	std::vector<double> MCSTimes;
+	//! max length of internal buffer, before saving to disk
+	uint32_t bufferSize;
+	//! name of output file
+	std::string outputFile;
+	//! flag used in dumping time series output
+	bool isFirstFileDump;
+	//! save the current values in timeSeries to disk
+	void dumpTimeSeries();
+public:
+
+	//! constructor
+	AnalyzerNetworkTopology(const IngredientsType& ing,
+			  std::string filename="NetworkTopology.dat");
+
+	//! destructor. does nothing
+	virtual ~AnalyzerNetworkTopology(){}
+	//! Nothing to initialize
+	virtual void initialize(){}
+	//! Analyzes the network of the current timestep. Called by TaskManager::execute()
+	virtual bool execute();
+	//! Writes the remaining time series to file
+	virtual void cleanup();
+	//! execute() only reads the system and writes to its own output file
+	virtual bool isThreadSafe() const {return true;}
+	//! Creates a partial analyzer working on ing
+	virtual MergeableAnalyzer<IngredientsType>* clone(const IngredientsType& ing) const;
+	//! Appends the time series of a partial analyzer
+	virtual void merge(MergeableAnalyzer<IngredientsType>& partial);
+	//! Set the number of values, after which the time series is saved to disk
+	void setBufferSize(uint32_t size){bufferSize=size;}
+	//! Change the output file name
+	void setOutputFile(std::string filename){outputFile=filename;isFirstFileDump=true;}
+	//! Topology of the last analyzed timestep
+	const NetworkTopology& getTopology() const {return topology;}
+};
+
+/*************************************************************************
+ * implementation of memebers
+ * ***********************************************************************/
+
+/**
+ * @param ing reference to the object holding all information of the system
+ * @param filename output file name. defaults to "NetworkTopology.dat".
+ * */
+template<class IngredientsType>
+AnalyzerNetworkTopology<IngredientsType>::AnalyzerNetworkTopology(
+	const IngredientsType& ing,
+	std::string filename)
+:ingredients(ing)
+,timeSeries(nColumns,std::vector<double>(0))
+,bufferSize(100)
+,outputFile(filename)
+,isFirstFileDump(true)
+{
+}
+
+/**
+ * @details Analyzes the bond graph, saves the results in the time series,
+ * and saves the time series to disk in regular intervals.
+ * */
+template< class IngredientsType >
+bool AnalyzerNetworkTopology<IngredientsType>::execute()
+{
+	topology.compute(ingredients.getMolecules());
+
+	timeSeries[0].push_back(double(topology.getNumberOfJunctions()));
+	timeSeries[1].push_back(double(topology.getNumberOfStrands()));
+	timeSeries[2].push_back(double(topology.getNumberOfDanglingMonomers()));
+	timeSeries[3].push_back(double(topology.getNumberOfFirstOrderLoops()));
+	timeSeries[4].push_back(double(topology.getNumberOfSecondOrderLoops()));
+	timeSeries[5].push_back(double(topology.getNumberOfFreeRings()));
+	timeSeries[6].push_back(double(topology.getNumberOfActiveJunctions()));
+	timeSeries[7].push_back(double(topology.getNumberOfActiveStrands()));
+	timeSeries[8].push_back(double(topology.getNumberOfActiveMonomers()));
+	timeSeries[9].push_back(double(topology.getCycleRank()));
+	timeSeries[10].push_back(double(topology.getActiveCycleRank()));
+	MCSTimes.push_back(ingredients.getMolecules().getAge());
+	//save to disk in regular intervals
+	if(MCSTimes.size()>=bufferSize)
+		dumpTimeSeries();
+
+	return true;
+}
+
+template<class IngredientsType>
+void AnalyzerNetworkTopology<IngredientsType>::cleanup()
+{
+	std::cout<<"AnalyzerNetworkTopology::cleanup()...";
+	//write the remaining data from the time series
+	dumpTimeSeries();
+	std::cout<<"done\n";
+}
+
+/**
+ * @details The partial analyzer only collects the time series and
+ * never writes to disk itself.
+ *
+ * @param ing The system the partial analyzer works on
+ * @return Pointer to a new AnalyzerNetworkTopology
+ * */
+template<class IngredientsType>
+MergeableAnalyzer<IngredientsType>* AnalyzerNetworkTopology<IngredientsType>::clone(const IngredientsType& ing) const
+{
+	AnalyzerNetworkTopology<IngredientsType>* partial=new AnalyzerNetworkTopology<IngredientsType>(ing,outputFile);
+	partial->setBufferSize(std::numeric_limits<uint32_t>::max());
+	return partial;
+}
+
+/**
+ * @details The time series of partial is appended to the time series of this
+ * analyzer, which is saved to disk in the same intervals as if the frames
+ * were evaluated by this analyzer.
+ *
+ * @param partial Analyzer created by clone()
+ * */
+template<class IngredientsType>
+void AnalyzerNetworkTopology<IngredientsType>::merge(MergeableAnalyzer<IngredientsType>& partial)
+{
+	AnalyzerNetworkTopology<IngredientsType>& other=dynamic_cast<AnalyzerNetworkTopology<IngredientsType>&>(partial);
+
+	for(size_t n=0;n<other.MCSTimes.size();n++)
+	{
+		for(size_t i=0;i<nColumns;i++)
+			timeSeries[i].push_back(other.timeSeries[i][n]);
+		MCSTimes.push_back(other.MCSTimes[n]);
+
+		if(MCSTimes.size()>=bufferSize)
+			dumpTimeSeries();
+	}
+	topology=other.topology;
+}
+
+/**
+ * @details Saves the current content of the time series to the output file.
+ * */
+template<class IngredientsType>
+void AnalyzerNetworkTopology<IngredientsType>::dumpTimeSeries()
+{
+	std::vector<std::vector<double> > resultsTimeseries=timeSeries;
+	resultsTimeseries.insert(resultsTimeseries.begin(),MCSTimes);
+
+	//if it is written for the first time, include comment in the output file
+	if(isFirstFileDump){
+		std::stringstream commentTimeSeries;
+		commentTimeSeries<<"Created by AnalyzerNetworkTopology\n";
+		commentTimeSeries<<"file contains time series of the network topology, see NetworkTopology for the definitions\n";
+		commentTimeSeries<<"format: mcs\t junctions\t strands\t danglingMonomers\t firstOrderLoops\t secondOrderLoops\t freeRings\t "
+		                 <<"activeJunctions\t activeStrands\t activeMonomers\t cycleRank\t activeCycleRank\n";
+
+		ResultFormattingTools::writeResultFile(
+			outputFile,
+			ingredients,
+			resultsTimeseries,
+			commentTimeSeries.str()
+		);
+
+		isFirstFileDump=false;
+	}
+	//otherwise just append the new data
+	else{
+		ResultFormattingTools::appendToResultFile(outputFile,
+							  resultsTimeseries);
+	}
+	//set all time series vectors back to zero size
+	MCSTimes.resize(0);
+	timeSeries.resize(0);
+	timeSeries.resize(nColumns,std::vector<double>(0));
+}
+
+#endif /* LEMONADE_ANALYZER_NETWORKTOPOLOGY_H */
@@ -0,0 +1,425 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_ANALYZER_RADIAL_DISTRIBUTION_H
+#define LEMONADE_ANALYZER_RADIAL_DISTRIBUTION_H
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/analyzer/AbstractAnalyzer.h>
+#include <LeMonADE/utility/CellList.h>
+#include <LeMonADE/utility/ResultFormattingTools.h>
+#include <LeMonADE/utility/Threads.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+/*************************************************************************
+ * definition of AnalyzerRadialDistribution class
+ * ***********************************************************************/
+
+/**
+ * @file
+ *
+ * @class AnalyzerRadialDistribution
+ *
+ * @brief Radial distribution function g(r) and monomer contacts using a cell list
+ *
+ * @tparam IngredientsType Ingredients class storing all system information( e.g. monomers, bonds, etc).
+ *
+ * @details All pairs of monomers closer than rMax are found with a CellList
+ * over the box, using the periodicity of FeatureBox. The time per frame is
+ * proportional to the number of monomers, the memory linear in the number
+ * of monomers and cells. The pairs are counted in bins of the distance,
+ * separately for pairs within the same molecule (intra) and in different
+ * molecules (inter). g(r) is normalized with the number of lattice vectors
+ * in each bin, i.e. it is exactly one for an ideal gas on the lattice, and
+ * g(r)=g_intra(r)+g_inter(r).
+ * Additionally, pairs closer than the contact radius are counted as contacts,
+ * where bonded pairs are not counted as intra-molecular contacts.
+ * The molecules and bonds are determined in initialize(), i.e. the
+ * connectivity must not change during the analysis.
+ * The cells are distributed on the given number of threads.
+ * In cleanup() g(r) is written in the format
+ * r g(r) g_intra(r) g_inter(r)
+ * and the time series of the contacts per monomer in the format
+ * mcs intra_contacts inter_contacts
+ * The analyzer takes a snapshot of the positions, so it can run in parallel
+ * to the updaters (see TaskManager::setAnalyzerThreads()).
+ */
+template < class IngredientsType > class AnalyzerRadialDistribution : public AbstractAnalyzer
+{
+public:
+	/**
+	 * @brief Counts pairs found by the cell list, one object per thread
+	 */
+	struct PairCounter
+	{
+		PairCounter():moleculeId(0),bondOffset(0),bondPartner(0),binWidth(1.0),contact2(0),intraContacts(0),interContacts(0){}
+		void operator()(uint32_t i, uint32_t j, const VectorInt3& distance);
+
+		const std::vector<uint32_t>* moleculeId;
+		const std::vector<uint32_t>* bondOffset;
+		const std::vector<uint32_t>* bondPartner;
+		double binWidth;
+		//! squared distances up to contact2 are contacts
+		int64_t contact2;
+		std::vector<uint64_t> intra;
+		std::vector<uint64_t> inter;
+		uint64_t intraContacts;
+		uint64_t interContacts;
+	};
+
+private:
+	//! processes a range of cells in a separate thread
+	class Worker: public Thread
+	{
+	public:
+		Worker(const CellList& cells, size_t begin, size_t end, PairCounter& counter)
+		:cells(cells),begin(begin),end(end),counter(counter){}
+	protected:
+		virtual void run(){cells.forEachPair(begin,end,counter);}
+	private:
+		const CellList& cells;
+		size_t begin;
+		size_t end;
+		PairCounter& counter;
+	};
+
+	//! typedef for the underlying container holding the monomers
+	typedef typename IngredientsType::molecules_type molecules_type;
+	//! reference to the complete system
+	const IngredientsType& ingredients;
+	//! output file for g(r)
+	std::string outputFile;
+	//! output file for the contacts
+	std::string contactFile;
+	//! g(r) is calculated for r<rMax
+	double rMax;
+	//! width of the bins in r
+	double binWidth;
+	//! pairs closer than this are contacts
+	double contactRadius;
+	//! threads used for the pair search
+	unsigned int nThreads;
+	//! cell list of the snapshot
+	CellList cells;
+	//! positions copied in takeSnapshot()
+	std::vector<VectorInt3> snapshot;
+	//! age of the system in takeSnapshot()
+	uint64_t snapshotAge;
+	//! molecule of every monomer
+	std::vector<uint32_t> moleculeId;
+	//! bond partners of monomer n are bondPartner[bondOffset[n]...bondOffset[n+1]-1]
+	std::vector<uint32_t> bondOffset;
+	std::vector<uint32_t> bondPartner;
+	//! accumulated pair counts per bin
+	std::vector<uint64_t> intraPairs;
+	std::vector<uint64_t> interPairs;
+	//! number of lattice vectors per bin, the normalization of g(r)
+	std::vector<double> latticeVectors;
+	//! number of evaluated frames
+	uint64_t nFrames;
+	//! time series of the contacts per monomer
+	std::vector<std::vector<double> > contactTimeSeries;
+
+public:
+	//! constructor
+	AnalyzerRadialDistribution(const IngredientsType& ing,
+				   std::string filename="RadialDistribution.dat",
+				   std::string contactFilename="Contacts.dat",
+				   double maxDistance=10.0,
+				   double width=0.5,
+				   double contactDistance=2.5,
+				   unsigned int threads=1);
+
+	//! destructor. does nothing
+	virtual ~AnalyzerRadialDistribution(){}
+	//! Sets up the cells, the molecules and the normalization. Called by TaskManager::initialize()
+	virtual void initialize();
+	//! Counts the pairs of the last snapshot. Called by TaskManager::execute()
+	virtual bool execute();
+	//! Writes the results to file
+	virtual void cleanup();
+	//! execute() only works on the snapshot and data of this analyzer
+	virtual bool isThreadSafe() const {return true;}
+	//! the positions are copied before every call of execute()
+	virtual bool needsSnapshot() const {return true;}
+	//! Copies the positions
+	virtual void takeSnapshot();
+
+	//! Returns the columns r, g(r), g_intra(r), g_inter(r)
+	std::vector<std::vector<double> > getResults() const;
+	//! Returns the columns mcs, intra contacts per monomer, inter contacts per monomer
+	const std::vector<std::vector<double> >& getContacts() const {return contactTimeSeries;}
+	//! Writes the current results to the output files
+	void writeResults() const;
+	//! Change the output file names
+	void setOutputFiles(std::string filename, std::string contactFilename){outputFile=filename;contactFile=contactFilename;}
+};
+
+/*************************************************************************
+ * implementation of memebers
+ * ***********************************************************************/
+
+/**
+ * @param ing reference to the object holding all information of the system
+ * @param filename output file for g(r). defaults to "RadialDistribution.dat".
+ * @param contactFilename output file for the contacts. defaults to "Contacts.dat".
+ * @param maxDistance g(r) is calculated for r<maxDistance, at most half the periodic box size
+ * @param width bin width in r
+ * @param contactDistance pairs with r<contactDistance are contacts. The default
+ * includes the distances 2, sqrt(5) and sqrt(6) of neighboring monomers in the bond fluctuation model.
+ * @param threads threads used for the pair search, 0 means one per processor
+ * */
+template<class IngredientsType>
+AnalyzerRadialDistribution<IngredientsType>::AnalyzerRadialDistribution(
+	const IngredientsType& ing,
+	std::string filename,
+	std::string contactFilename,
+	double maxDistance,
+	double width,
+	double contactDistance,
+	unsigned int threads)
+:ingredients(ing)
+,outputFile(filename)
+,contactFile(contactFilename)
+,rMax(maxDistance)
+,binWidth(width)
+,contactRadius(contactDistance)
+,nThreads(threads==0?Thread::hardwareConcurrency():threads)
+,snapshotAge(0)
+,nFrames(0)
+,contactTimeSeries(3)
+{
+}
+
+/**
+ * @throw std::runtime_error if the distances are inconsistent with the box
+ * */
+template< class IngredientsType >
+void AnalyzerRadialDistribution<IngredientsType>::initialize()
+{
+	if(!(binWidth>0.0) || !(rMax>0.0))
+		throw std::runtime_error("AnalyzerRadialDistribution::initialize(): rMax and the bin width must be positive");
+
+	const uint32_t box[3]={uint32_t(ingredients.getBoxX()),uint32_t(ingredients.getBoxY()),uint32_t(ingredients.getBoxZ())};
+	const bool periodic[3]={ingredients.isPeriodicX(),ingredients.isPeriodicY(),ingredients.isPeriodicZ()};
+	cells.setup(box,periodic,std::max(rMax,contactRadius));
+
+	//molecules and bonds
+	const molecules_type& molecules=ingredients.getMolecules();
+	moleculeId=molecules.getConnectedComponents().getComponentIds();
+
+	bondOffset.assign(1,0);
+	bondPartner.clear();
+	for(size_t n=0;n<molecules.size();n++)
+	{
+		for(size_t k=0;k<molecules.getNumLinks(n);k++)
+			bondPartner.push_back(molecules.getNeighborIdx(n,k));
+		bondOffset.push_back(uint32_t(bondPartner.size()));
+	}
+
+	//number of lattice vectors per bin
+	size_t nBins=size_t(std::ceil(rMax/binWidth));
+	latticeVectors.assign(nBins,0.0);
+	int32_t range=int32_t(std::ceil(rMax));
+	for(int32_t x=-range;x<=range;x++)
+		for(int32_t y=-range;y<=range;y++)
+			for(int32_t z=-range;z<=range;z++)
+			{
+				double r=std::sqrt(double(x*x+y*y+z*z));
+				if(r==0.0 || r>=rMax) continue;
+				latticeVectors[std::min(size_t(r/binWidth),nBins-1)]+=1.0;
+			}
+
+	intraPairs.assign(nBins,0);
+	interPairs.assign(nBins,0);
+	nFrames=0;
+	contactTimeSeries.assign(3,std::vector<double>());
+	snapshot.resize(molecules.size());
+}
+
+template< class IngredientsType >
+void AnalyzerRadialDistribution<IngredientsType>::takeSnapshot()
+{
+	const molecules_type& molecules=ingredients.getMolecules();
+	snapshot.resize(molecules.size());
+	for(size_t n=0;n<molecules.size();n++) snapshot[n]=molecules[n];
+	snapshotAge=molecules.getAge();
+}
+
+/**
+ * @throw std::runtime_error if the number of monomers changed since initialize()
+ * */
+template< class IngredientsType >
+bool AnalyzerRadialDistribution<IngredientsType>::execute()
+{
+	if(snapshot.size()!=moleculeId.size())
+		throw std::runtime_error("AnalyzerRadialDistribution::execute(): number of monomers changed since initialize()");
+
+	cells.build(snapshot);
+
+	size_t nWorkers=std::max<size_t>(1,std::min<size_t>(nThreads,cells.getNumberOfCells()));
+	std::vector<PairCounter> counters(nWorkers);
+	for(size_t n=0;n<nWorkers;n++)
+	{
+		counters[n].moleculeId=&moleculeId;
+		counters[n].bondOffset=&bondOffset;
+		counters[n].bondPartner=&bondPartner;
+		counters[n].binWidth=binWidth;
+		//integer squared distances below contactRadius^2
+		counters[n].contact2=int64_t(std::ceil(contactRadius*contactRadius))-1;
+		counters[n].intra.assign(intraPairs.size(),0);
+		counters[n].inter.assign(interPairs.size(),0);
+	}
+
+	size_t nCells=cells.getNumberOfCells();
+	if(nWorkers==1) cells.forEachPair(counters[0]);
+	else
+	{
+		std::vector<Worker*> workers;
+		for(size_t n=0;n<nWorkers;n++)
+		{
+			workers.push_back(new Worker(cells,nCells*n/nWorkers,nCells*(n+1)/nWorkers,counters[n]));
+			workers.back()->start();
+		}
+		for(size_t n=0;n<nWorkers;n++)
+		{
+			workers[n]->join();
+			delete workers[n];
+		}
+	}
+
+	uint64_t intraContacts=0, interContacts=0;
+	for(size_t n=0;n<nWorkers;n++)
+	{
+		for(size_t bin=0;bin<intraPairs.size();bin++)
+		{
+			intraPairs[bin]+=counters[n].intra[bin];
+			interPairs[bin]+=counters[n].inter[bin];
+		}
+		intraContacts+=counters[n].intraContacts;
+		interContacts+=counters[n].interContacts;
+	}
+	nFrames++;
+
+	//every contact belongs to two monomers
+	double perMonomer=snapshot.empty()?0.0:2.0/double(snapshot.size());
+	contactTimeSeries[0].push_back(double(snapshotAge));
+	contactTimeSeries[1].push_back(perMonomer*double(intraContacts));
+	contactTimeSeries[2].push_back(perMonomer*double(interContacts));
+	return true;
+}
+
+template<class IngredientsType>
+void AnalyzerRadialDistribution<IngredientsType>::cleanup()
+{
+	std::cout<<"AnalyzerRadialDistribution::cleanup()...";
+	writeResults();
+	std::cout<<"done\n";
+}
+
+/**
+ * @details The number of pairs in a bin is divided by the number expected for
+ * randomly distributed monomers, N(N-1)/2 * nLatticeVectors(bin) / V.
+ * @return Columns r (bin center), g(r), g_intra(r), g_inter(r)
+ * */
+template<class IngredientsType>
+std::vector<std::vector<double> > AnalyzerRadialDistribution<IngredientsType>::getResults() const
+{
+	std::vector<std::vector<double> > results(4);
+	double nMonomers=double(moleculeId.size());
+	double volume=double(ingredients.getBoxX())*double(ingredients.getBoxY())*double(ingredients.getBoxZ());
+	double idealPairs=0.5*nMonomers*(nMonomers-1.0)/volume*double(nFrames);
+
+	for(size_t bin=0;bin<latticeVectors.size();bin++)
+	{
+		if(latticeVectors[bin]==0.0) continue;
+		double norm=(idealPairs>0.0)?1.0/(idealPairs*latticeVectors[bin]):0.0;
+		results[0].push_back((double(bin)+0.5)*binWidth);
+		results[1].push_back(norm*double(intraPairs[bin]+interPairs[bin]));
+		results[2].push_back(norm*double(intraPairs[bin]));
+		results[3].push_back(norm*double(interPairs[bin]));
+	}
+	return results;
+}
+
+template<class IngredientsType>
+void AnalyzerRadialDistribution<IngredientsType>::writeResults() const
+{
+	std::vector<std::vector<double> > results=getResults();
+	std::stringstream comment;
+	comment<<"Created by AnalyzerRadialDistribution\n";
+	comment<<"rMax "<<rMax<<", bin width "<<binWidth<<", "<<nFrames<<" frames\n";
+	comment<<"normalized with the number of lattice vectors per bin, g=g_intra+g_inter\n";
+	comment<<"format: r\t g\t g_intra\t g_inter\n";
+	ResultFormattingTools::writeResultFile(outputFile,ingredients,results,comment.str());
+
+	if(contactTimeSeries[0].empty()) return;
+	std::vector<std::vector<double> > contacts=contactTimeSeries;
+	std::stringstream contactComment;
+	contactComment<<"Created by AnalyzerRadialDistribution\n";
+	contactComment<<"contacts per monomer with distance < "<<contactRadius<<", bonded pairs are not counted\n";
+	contactComment<<"format: mcs\t intra\t inter\n";
+	ResultFormattingTools::writeResultFile(contactFile,ingredients,contacts,contactComment.str());
+}
+
+/**
+ * @param i first monomer
+ * @param j second monomer
+ * @param distance minimum image vector from i to j
+ * */
+template<class IngredientsType>
+void AnalyzerRadialDistribution<IngredientsType>::PairCounter::operator()(uint32_t i, uint32_t j, const VectorInt3& distance)
+{
+	int64_t r2=int64_t(distance[0])*distance[0]+int64_t(distance[1])*distance[1]+int64_t(distance[2])*distance[2];
+	size_t bin=size_t(std::sqrt(double(r2))/binWidth);
+	bool sameMolecule=((*moleculeId)[i]==(*moleculeId)[j]);
+
+	if(bin<intra.size())
+	{
+		if(sameMolecule) intra[bin]++;
+		else inter[bin]++;
+	}
+
+	if(r2>contact2) return;
+	if(!sameMolecule)
+	{
+		interContacts++;
+		return;
+	}
+	for(uint32_t k=(*bondOffset)[i];k<(*bondOffset)[i+1];k++)
+		if((*bondPartner)[k]==j) return;
+	intraContacts++;
+}
+
+#endif
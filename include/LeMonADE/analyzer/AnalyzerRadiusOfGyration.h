@@ -29,9 +29,10 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #define LEMONADE_ANALYZER_RADIUS_OF_GYRATION_H
 
 #include <string>
+#include <limits>
 
 #include <LeMonADE/utility/Vector3D.h>
-#include <LeMonADE/analyzer/AbstractAnalyzer.h>
+#include <LeMonADE/analyzer/MergeableAnalyzer.h>
 #include <LeMonADE/utility/ResultFormattingTools.h>
 #include <LeMonADE/utility/MonomerGroup.h>
 
@@ -60,8 +61,10 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  * If a more sophisticated grouping of monomers into groups is required, one can
  * also write a new analyzer, inheriting from AnalyzerRadiusOfGyration, and
  * overwriting the initialize function.
+ * The analyzer is a MergeableAnalyzer, i.e. it can also be used with the
+ * MapReduceAnalysisDriver, which evaluates parts of a trajectory in parallel.
  */
-template < class IngredientsType > class AnalyzerRadiusOfGyration : public AbstractAnalyzer
+template < class IngredientsType > class AnalyzerRadiusOfGyration : public MergeableAnalyzer<IngredientsType>
 {
 
 private:
@@ -102,6 +105,12 @@ public:
 	virtual bool execute();
 	//! Writes the final results to file
 	virtual void cleanup();
+	//! execute() only reads the system and writes to its own output file
+	virtual bool isThreadSafe() const {return true;}
+	//! Creates a partial analyzer for the groups of this analyzer working on ing
+	virtual MergeableAnalyzer<IngredientsType>* clone(const IngredientsType& ing) const;
+	//! Appends the time series of a partial analyzer
+	virtual void merge(MergeableAnalyzer<IngredientsType>& partial);
 	//! Set the number of values, after which the time series is saved to disk
 	void setBufferSize(uint32_t size){bufferSize=size;}
 	//! Change the output file name
@@ -186,6 +195,55 @@ void AnalyzerRadiusOfGyration<IngredientsType>::cleanup()
 	std::cout<<"done\n";
 }
 
+/**
+ * @details The groups are copied with the same monomer indices, but refer to
+ * the molecules of ing. The partial analyzer only collects the time series and
+ * never writes to disk itself.
+ *
+ * @param ing The system the partial analyzer works on
+ * @return Pointer to a new AnalyzerRadiusOfGyration
+ * */
+template<class IngredientsType>
+MergeableAnalyzer<IngredientsType>* AnalyzerRadiusOfGyration<IngredientsType>::clone(const IngredientsType& ing) const
+{
+	AnalyzerRadiusOfGyration<IngredientsType>* partial=new AnalyzerRadiusOfGyration<IngredientsType>(ing,outputFile);
+	partial->setBufferSize(std::numeric_limits<uint32_t>::max());
+
+	std::vector<MonomerGroup<molecules_type> > partialGroups;
+	for(size_t n=0;n<groups.size();n++)
+	{
+		partialGroups.push_back(MonomerGroup<molecules_type>(ing.getMolecules()));
+		for(size_t m=0;m<groups[n].size();m++)
+			partialGroups.back().push_back(groups[n].trueIndex(m));
+	}
+	partial->setMonomerGroups(partialGroups);
+
+	return partial;
+}
+
+/**
+ * @details The time series of partial is appended to the time series of this
+ * analyzer, which is saved to disk in the same intervals as if the frames
+ * were evaluated by this analyzer.
+ *
+ * @param partial Analyzer created by clone()
+ * */
+template<class IngredientsType>
+void AnalyzerRadiusOfGyration<IngredientsType>::merge(MergeableAnalyzer<IngredientsType>& partial)
+{
+	AnalyzerRadiusOfGyration<IngredientsType>& other=dynamic_cast<AnalyzerRadiusOfGyration<IngredientsType>&>(partial);
+
+	for(size_t n=0;n<other.MCSTimes.size();n++)
+	{
+		for(size_t i=0;i<4;i++)
+			Rg2TimeSeries[i].push_back(other.Rg2TimeSeries[i][n]);
+		MCSTimes.push_back(other.MCSTimes[n]);
+
+		if(MCSTimes.size()>=bufferSize)
+			dumpTimeSeries();
+	}
+}
+
 /**
  * @details Saves the current content of Rg2TimeSeries to the file
  * Rg2TimeSeries.dat. The output format is:
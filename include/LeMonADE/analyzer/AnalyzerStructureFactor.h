@@ -0,0 +1,360 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_ANALYZER_STRUCTURE_FACTOR_H
+#define LEMONADE_ANALYZER_STRUCTURE_FACTOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/analyzer/AbstractAnalyzer.h>
+#include <LeMonADE/utility/FastFourierTransform.h>
+#include <LeMonADE/utility/ResultFormattingTools.h>
+
+/*************************************************************************
+ * definition of AnalyzerStructureFactor class
+ * ***********************************************************************/
+
+/**
+ * @file
+ *
+ * @class AnalyzerStructureFactor
+ *
+ * @brief Static structure factor S(q) from the Fourier transform of the density on a grid
+ *
+ * @tparam IngredientsType Ingredients class storing all system information. Requires FeatureAttributes.
+ *
+ * @details The monomers are counted on a grid with the size of the box
+ * (divided by the grid spacing), separately for every attribute tag. The
+ * densities are transformed with a RealFourierTransform3D and
+ * S_ab(q) = Re( rho_a(q) rho_b(q)^* ) / N
+ * is averaged over spherical shells of width binWidth in q and over all
+ * calls of execute(). N is the number of analyzed monomers, such that the
+ * total structure factor S(q) = |rho(q)|^2 / N is the sum of the partial
+ * structure factors over all ordered tag pairs. The work is proportional to
+ * the number of grid points (times log) instead of monomers times wave vectors.
+ * By default all tags found in initialize() are analyzed, a subset can be
+ * chosen with setTags(). Monomers with other tags are ignored.
+ * The results are written to the file in cleanup() in the format
+ * q S(q) S_aa(q) S_ab(q) ... nModes
+ * The analyzer takes a snapshot of the densities, so it can run in parallel
+ * to the updaters (see TaskManager::setAnalyzerThreads()).
+ */
+template < class IngredientsType > class AnalyzerStructureFactor : public AbstractAnalyzer
+{
+public:
+	typedef RealFourierTransform3D::complex_type complex_type;
+
+private:
+	//! reference to the complete system
+	const IngredientsType& ingredients;
+	//! name of the output file
+	std::string outputFile;
+	//! threads used by the Fourier transform
+	unsigned int nThreads;
+	//! box size divided by number of grid points
+	uint32_t gridSpacing;
+	//! width of the q-bins, 0 means 2 pi divided by the largest box size
+	double binWidth;
+	//! analyzed attribute tags
+	std::vector<int32_t> tags;
+	//! position of the tag in tags
+	std::map<int32_t,size_t> tagIndex;
+	//! transform of the density grids
+	RealFourierTransform3D transform;
+	//! densities per tag, filled in takeSnapshot()
+	std::vector<std::vector<double> > densities;
+	//! number of monomers counted in takeSnapshot()
+	uint64_t nCounted;
+	//! transforms of the densities per tag
+	std::vector<std::vector<complex_type> > transforms;
+	//! bin of every mode of the transform, nBins for q=0
+	std::vector<uint32_t> modeBin;
+	//! number of modes per bin (counting q and -q)
+	std::vector<double> modeCount;
+	//! sum of |q| per bin
+	std::vector<double> modeQ;
+	//! summed S(q) per bin: [0] total, [1...] pairs of tags
+	std::vector<std::vector<double> > sums;
+	//! number of evaluated snapshots
+	uint64_t nFrames;
+	//! grid size
+	size_t nx, ny, nz;
+
+public:
+	//! constructor
+	AnalyzerStructureFactor(const IngredientsType& ing,
+				std::string filename="StructureFactor.dat",
+				unsigned int threads=1,
+				uint32_t spacing=1);
+
+	//! destructor. does nothing
+	virtual ~AnalyzerStructureFactor(){}
+	//! Sets up grid, transform and bins. Called by TaskManager::initialize()
+	virtual void initialize();
+	//! Transforms the densities of the last snapshot and adds S(q). Called by TaskManager::execute()
+	virtual bool execute();
+	//! Writes the results to file
+	virtual void cleanup();
+	//! execute() only works on the snapshot and data of this analyzer
+	virtual bool isThreadSafe() const {return true;}
+	//! the densities are calculated before every call of execute()
+	virtual bool needsSnapshot() const {return true;}
+	//! Counts the monomers on the density grids
+	virtual void takeSnapshot();
+
+	//! Returns the columns q, S(q), the partial S_ab(q) for a<=b and the number of modes per bin
+	std::vector<std::vector<double> > getResults() const;
+	//! Writes the current results to the output file
+	void writeResults() const;
+
+	//! Analyze only monomers with these attribute tags. Must be called before initialize().
+	void setTags(const std::vector<int32_t>& attributeTags){tags=attributeTags;}
+	//! The analyzed attribute tags
+	const std::vector<int32_t>& getTags() const {return tags;}
+	//! Width of the bins in q, must be called before initialize()
+	void setBinWidth(double width){binWidth=width;}
+	//! Change the output file name
+	void setOutputFile(std::string filename){outputFile=filename;}
+};
+
+/*************************************************************************
+ * implementation of memebers
+ * ***********************************************************************/
+
+/**
+ * @param ing reference to the object holding all information of the system
+ * @param filename output file name. defaults to "StructureFactor.dat".
+ * @param threads threads used by the Fourier transform, 0 means one per processor
+ * @param spacing lattice sites per grid point, must divide the box sizes. Limits q to pi/spacing.
+ * */
+template<class IngredientsType>
+AnalyzerStructureFactor<IngredientsType>::AnalyzerStructureFactor(
+	const IngredientsType& ing,
+	std::string filename,
+	unsigned int threads,
+	uint32_t spacing)
+:ingredients(ing)
+,outputFile(filename)
+,nThreads(threads)
+,gridSpacing(spacing)
+,binWidth(0.0)
+,nCounted(0)
+,nFrames(0)
+,nx(0),ny(0),nz(0)
+{
+}
+
+/**
+ * @throw std::runtime_error if the box is not divisible by the grid spacing
+ * */
+template< class IngredientsType >
+void AnalyzerStructureFactor<IngredientsType>::initialize()
+{
+	const uint32_t box[3]={uint32_t(ingredients.getBoxX()),uint32_t(ingredients.getBoxY()),uint32_t(ingredients.getBoxZ())};
+	for(size_t d=0;d<3;d++)
+	{
+		if(gridSpacing==0 || box[d]==0 || box[d]%gridSpacing!=0)
+		{
+			std::stringstream errormessage;
+			errormessage<<"AnalyzerStructureFactor::initialize(): box "<<box[0]<<"x"<<box[1]<<"x"<<box[2]
+				    <<" is not divisible by the grid spacing "<<gridSpacing;
+			throw std::runtime_error(errormessage.str());
+		}
+	}
+	nx=box[0]/gridSpacing;
+	ny=box[1]/gridSpacing;
+	nz=box[2]/gridSpacing;
+	transform.setup(nx,ny,nz,nThreads);
+
+	//by default all tags present in the system
+	if(tags.empty())
+	{
+		for(size_t n=0;n<ingredients.getMolecules().size();n++)
+			tags.push_back(int32_t(ingredients.getMolecules()[n].getAttributeTag()));
+		std::sort(tags.begin(),tags.end());
+		tags.erase(std::unique(tags.begin(),tags.end()),tags.end());
+	}
+	tagIndex.clear();
+	for(size_t n=0;n<tags.size();n++) tagIndex[tags[n]]=n;
+
+	const size_t hx=transform.getComplexSizeX();
+	densities.assign(tags.size(),std::vector<double>(nx*ny*nz,0.0));
+	transforms.assign(tags.size(),std::vector<complex_type>(hx*ny*nz));
+
+	//bins of the modes, the wave vectors are q_d = 2 pi m_d / box_d
+	const double twoPi=2.0*3.14159265358979323846;
+	if(binWidth<=0.0) binWidth=twoPi/double(std::max(box[0],std::max(box[1],box[2])));
+	double qMax=0.5*twoPi/double(gridSpacing)*std::sqrt(3.0);
+	uint32_t nBins=uint32_t(qMax/binWidth)+1;
+
+	modeBin.resize(hx*ny*nz);
+	modeCount.assign(nBins,0.0);
+	modeQ.assign(nBins,0.0);
+	for(size_t z=0;z<nz;z++)
+	{
+		double qz=twoPi*double((z<=nz/2)?int64_t(z):int64_t(z)-int64_t(nz))/double(box[2]);
+		for(size_t y=0;y<ny;y++)
+		{
+			double qy=twoPi*double((y<=ny/2)?int64_t(y):int64_t(y)-int64_t(ny))/double(box[1]);
+			for(size_t x=0;x<hx;x++)
+			{
+				double qx=twoPi*double(x)/double(box[0]);
+				double q=std::sqrt(qx*qx+qy*qy+qz*qz);
+				size_t mode=x+hx*(y+ny*z);
+				if(x==0 && y==0 && z==0)
+				{
+					modeBin[mode]=nBins;
+					continue;
+				}
+				uint32_t bin=std::min(uint32_t(q/binWidth),nBins-1);
+				modeBin[mode]=bin;
+				//the modes kx>0 stand for kx and -kx, except for the Nyquist mode of even nx
+				double weight=(x==0 || (nx%2==0 && x==nx/2))?1.0:2.0;
+				modeCount[bin]+=weight;
+				modeQ[bin]+=weight*q;
+			}
+		}
+	}
+
+	sums.assign(1+tags.size()*(tags.size()+1)/2,std::vector<double>(nBins,0.0));
+	nFrames=0;
+}
+
+template< class IngredientsType >
+void AnalyzerStructureFactor<IngredientsType>::takeSnapshot()
+{
+	for(size_t t=0;t<densities.size();t++)
+		std::fill(densities[t].begin(),densities[t].end(),0.0);
+
+	const int64_t box[3]={ingredients.getBoxX(),ingredients.getBoxY(),ingredients.getBoxZ()};
+	nCounted=0;
+	for(size_t n=0;n<ingredients.getMolecules().size();n++)
+	{
+		std::map<int32_t,size_t>::const_iterator it=tagIndex.find(int32_t(ingredients.getMolecules()[n].getAttributeTag()));
+		if(it==tagIndex.end()) continue;
+
+		size_t cell[3];
+		for(size_t d=0;d<3;d++)
+		{
+			int64_t folded=((int64_t(ingredients.getMolecules()[n][d])%box[d])+box[d])%box[d];
+			cell[d]=size_t(folded/int64_t(gridSpacing));
+		}
+		densities[it->second][cell[0]+nx*(cell[1]+ny*cell[2])]+=1.0;
+		nCounted++;
+	}
+}
+
+template< class IngredientsType >
+bool AnalyzerStructureFactor<IngredientsType>::execute()
+{
+	if(nCounted==0) return true;
+
+	for(size_t t=0;t<tags.size();t++)
+		transform.forward(&densities[t][0],&transforms[t][0]);
+
+	const size_t nBins=modeCount.size();
+	const size_t nTags=tags.size();
+	const size_t hx=transform.getComplexSizeX();
+	const double norm=1.0/double(nCounted);
+	std::vector<complex_type> rho(nTags);
+
+	for(size_t mode=0;mode<modeBin.size();mode++)
+	{
+		uint32_t bin=modeBin[mode];
+		if(bin>=nBins) continue;
+		size_t x=mode%hx;
+		double weight=norm*((x==0 || (nx%2==0 && x==nx/2))?1.0:2.0);
+
+		complex_type total(0.0,0.0);
+		for(size_t a=0;a<nTags;a++)
+		{
+			rho[a]=transforms[a][mode];
+			total+=rho[a];
+		}
+		sums[0][bin]+=weight*std::norm(total);
+		size_t pair=1;
+		for(size_t a=0;a<nTags;a++)
+			for(size_t b=a;b<nTags;b++)
+				sums[pair++][bin]+=weight*(rho[a].real()*rho[b].real()+rho[a].imag()*rho[b].imag());
+	}
+	nFrames++;
+	return true;
+}
+
+template<class IngredientsType>
+void AnalyzerStructureFactor<IngredientsType>::cleanup()
+{
+	std::cout<<"AnalyzerStructureFactor::cleanup()...";
+	writeResults();
+	std::cout<<"done\n";
+}
+
+/**
+ * @return Columns q, S(q), S_ab(q) for all tag pairs a<=b in the order
+ * (0,0),(0,1),...,(1,1),..., and the number of modes, one row per non-empty bin.
+ * q is the average |q| of the modes in the bin.
+ * */
+template<class IngredientsType>
+std::vector<std::vector<double> > AnalyzerStructureFactor<IngredientsType>::getResults() const
+{
+	std::vector<std::vector<double> > results(sums.size()+2);
+	for(size_t bin=0;bin<modeCount.size();bin++)
+	{
+		if(modeCount[bin]==0.0) continue;
+		results[0].push_back(modeQ[bin]/modeCount[bin]);
+		for(size_t s=0;s<sums.size();s++)
+			results[s+1].push_back(nFrames>0?sums[s][bin]/(modeCount[bin]*double(nFrames)):0.0);
+		results.back().push_back(modeCount[bin]);
+	}
+	return results;
+}
+
+template<class IngredientsType>
+void AnalyzerStructureFactor<IngredientsType>::writeResults() const
+{
+	std::vector<std::vector<double> > results=getResults();
+
+	std::stringstream comment;
+	comment<<"Created by AnalyzerStructureFactor\n";
+	comment<<"grid "<<nx<<"x"<<ny<<"x"<<nz<<" (spacing "<<gridSpacing<<"), bin width "<<binWidth<<", "<<nFrames<<" frames\n";
+	comment<<"S_ab(q)=Re(rho_a(q) rho_b(q)^*)/N, S(q)=|rho(q)|^2/N is the sum over all ordered pairs\n";
+	comment<<"format: q\t S";
+	for(size_t a=0;a<tags.size();a++)
+		for(size_t b=a;b<tags.size();b++)
+			comment<<"\t S_"<<tags[a]<<"_"<<tags[b];
+	comment<<"\t nModes\n";
+
+	ResultFormattingTools::writeResultFile(outputFile,ingredients,results,comment.str());
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_ANALYZER_ANALYZERWRITECHECKPOINT_H
+#define LEMONADE_ANALYZER_ANALYZERWRITECHECKPOINT_H
+
+#include <string>
+
+#include <LeMonADE/analyzer/AbstractAnalyzer.h>
+#include <LeMonADE/io/SystemCheckpoint.h>
+#include <LeMonADE/utility/TaskManager.h>
+
+/***********************************************************************/
+/**
+ * @file
+ *
+ * @class AnalyzerWriteCheckpoint
+ *
+ * @brief Analyzer periodically writing a binary checkpoint of the simulation.
+ *
+ * @details Every call of execute() replaces the checkpoint file with the
+ * current state of the system, the random number generators and (optionally)
+ * the TaskManager, see writeSystemCheckpoint(). The execution period is given
+ * when adding the analyzer to the TaskManager. The analyzer should be added
+ * as the last task, such that all other analyzers have already processed the
+ * current cycle when the checkpoint is written. The simulation can then be
+ * continued with readSystemCheckpoint().
+ *
+ * @tparam IngredientsType Ingredients class storing all system information( e.g. monomers, bonds, etc).
+ **/
+template <class IngredientsType>
+class AnalyzerWriteCheckpoint: public AbstractAnalyzer
+{
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param filename Name of the checkpoint file, replaced at each execution
+   * @param ing Reference to the system
+   * @param taskmanager TaskManager executing this analyzer, whose state is stored as well (may be NULL)
+   */
+  AnalyzerWriteCheckpoint(const std::string& filename,const IngredientsType& ing,const TaskManager* taskmanager=NULL)
+  :checkpointFilename(filename),ingredients(ing),taskmanager(taskmanager)
+  {}
+
+  virtual ~AnalyzerWriteCheckpoint(){}
+
+  //! Nothing to initialize
+  virtual void initialize(){}
+
+  //! Writes the checkpoint
+  virtual bool execute()
+  {
+	  writeSystemCheckpoint(checkpointFilename,ingredients,taskmanager);
+	  return true;
+  }
+
+  //! Nothing to clean up
+  virtual void cleanup(){}
+
+  //! Returns the name of the checkpoint file
+  const std::string& getFilename() const {return checkpointFilename;}
+
+private:
+  //! Name of the checkpoint file
+  std::string checkpointFilename;
+
+  //! Reference to the system
+  const IngredientsType& ingredients;
+
+  //! TaskManager whose state is stored with the checkpoint, may be NULL
+  const TaskManager* taskmanager;
+};
+
+#endif /* LEMONADE_ANALYZER_ANALYZERWRITECHECKPOINT_H */
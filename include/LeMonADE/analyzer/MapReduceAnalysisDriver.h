@@ -0,0 +1,405 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_ANALYZER_MAPREDUCEANALYSISDRIVER_H
+#define LEMONADE_ANALYZER_MAPREDUCEANALYSISDRIVER_H
+
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+
+#include <LeMonADE/analyzer/MergeableAnalyzer.h>
+#include <LeMonADE/io/FileImport.h>
+#include <LeMonADE/utility/Threads.h>
+
+/*****************************************************************************/
+/**
+ * @file
+ *
+ * @class MapReduceAnalysisDriver
+ *
+ * @brief Evaluates a trajectory file with MergeableAnalyzers on several threads
+ *
+ * @details The frames of the file are divided into chunks of consecutive
+ * frames. Every worker thread owns its own Ingredients and FileImport and
+ * evaluates the chunks assigned to it with partial analyzers created by
+ * MergeableAnalyzer::clone() (map). The main thread merges the partial
+ * analyzers into the original analyzers in the order of the chunks (reduce),
+ * such that the results are the same as if every analyzer was executed
+ * sequentially on every frame of the file, including the first one.
+ *
+ * The analyzers are initialized after the first frame was read into the
+ * Ingredients given to the constructor, and cleaned up after all chunks were
+ * merged. Commands other than !mcs in the middle of the file (e.g. changes of
+ * the bonds) are applied by every worker before it evaluates a later chunk.
+ *
+ * Usage:
+ * @code
+ * MapReduceAnalysisDriver<IngredientsType> driver("trajectory.bfm",ingredients,4);
+ * driver.addAnalyzer(new AnalyzerRadiusOfGyration<IngredientsType>(ingredients));
+ * driver.run();
+ * @endcode
+ *
+ * @tparam IngredientsType Ingredients class storing all system information
+ **/
+/*****************************************************************************/
+template<class IngredientsType>
+class MapReduceAnalysisDriver
+{
+public:
+  MapReduceAnalysisDriver(const std::string& filename, IngredientsType& ing, uint32_t nThreads=0, uint32_t framesPerChunk=0);
+  virtual ~MapReduceAnalysisDriver();
+
+  //! Adds an analyzer, which is deleted by the driver
+  void addAnalyzer(MergeableAnalyzer<IngredientsType>* analyzer);
+
+  //! Evaluates the complete file with all analyzers
+  void run();
+
+  //! Number of worker threads
+  uint32_t getNThreads() const {return nThreads;}
+
+  //! Number of frames per chunk, 0 if chosen automatically
+  uint32_t getFramesPerChunk() const {return framesPerChunk;}
+
+  //! Use the sidecar frame index of FileImport (default: false, see FileImport::setUseFrameIndex())
+  void setUseFrameIndex(bool use){useFrameIndex=use;}
+
+private:
+  typedef MergeableAnalyzer<IngredientsType> analyzer_type;
+
+  //! A range of frames evaluated by one worker
+  struct Chunk
+  {
+    Chunk(uint32_t first, uint32_t last):firstFrame(first),lastFrame(last),done(false),failed(false){}
+    uint32_t firstFrame;
+    uint32_t lastFrame;
+    //! partial analyzers, one per analyzer of the driver
+    std::vector<analyzer_type*> partials;
+    bool done;
+    bool failed;
+    std::string error;
+  };
+
+  //! Thread evaluating chunks with its own copy of the system
+  class Worker: public Thread
+  {
+  public:
+    Worker(MapReduceAnalysisDriver& d, const std::string& filename, bool useFrameIndex)
+      :driver(d),ingredients(),file(filename,ingredients),lastFrame(0)
+    {
+      file.setUseFrameIndex(useFrameIndex);
+    }
+
+    MapReduceAnalysisDriver& driver;
+    IngredientsType ingredients;
+    FileImport<IngredientsType> file;
+    //! last frame read by this worker, 0 if none
+    uint32_t lastFrame;
+
+  protected:
+    virtual void run(){driver.work(*this);}
+  };
+
+  friend class Worker;
+
+  //! no copies
+  MapReduceAnalysisDriver(const MapReduceAnalysisDriver&);
+  MapReduceAnalysisDriver& operator=(const MapReduceAnalysisDriver&);
+
+  //! Main loop of the worker threads
+  void work(Worker& worker);
+
+  //! Evaluates a chunk with the partial analyzers
+  void evaluate(Worker& worker, Chunk& chunk);
+
+  //! Merges the chunks in order as they are finished
+  void reduce();
+
+  //! Stops and deletes all worker threads
+  void stopWorkers();
+
+  //! Deletes the partial analyzers of all chunks
+  void deletePartials();
+
+  std::string filename;
+  IngredientsType& ingredients;
+  std::vector<analyzer_type*> analyzers;
+  uint32_t nThreads;
+  uint32_t framesPerChunk;
+  bool useFrameIndex;
+
+  std::vector<Worker*> workers;
+  std::vector<Chunk> chunks;
+  //! next chunk to be assigned to a worker
+  size_t nextChunk;
+  //! number of chunks merged so far
+  size_t nMergedChunks;
+  //! limits the number of evaluated, but not yet merged chunks
+  size_t maxChunksInFlight;
+  bool stopping;
+
+  Mutex mutex;
+  //! Signals a finished chunk to the main thread
+  Condition chunkDone;
+  //! Signals a merged chunk to the workers
+  Condition chunkMerged;
+};
+
+/*****************************************************************************/
+/**
+ * @param filename The trajectory file (bfm format)
+ * @param ing The Ingredients the analyzers given to addAnalyzer() work on
+ * @param nThreads Number of worker threads (default: number of processors)
+ * @param framesPerChunk Number of frames per chunk (default: chosen such that every thread gets about 8 chunks)
+ */
+template<class IngredientsType>
+MapReduceAnalysisDriver<IngredientsType>::MapReduceAnalysisDriver(const std::string& filename_, IngredientsType& ing, uint32_t nThreads_, uint32_t framesPerChunk_)
+  :filename(filename_),ingredients(ing),nThreads(nThreads_),framesPerChunk(framesPerChunk_),useFrameIndex(false)
+  ,nextChunk(0),nMergedChunks(0),maxChunksInFlight(0),stopping(false)
+{
+	if(nThreads==0) nThreads=Thread::hardwareConcurrency();
+}
+
+template<class IngredientsType>
+MapReduceAnalysisDriver<IngredientsType>::~MapReduceAnalysisDriver()
+{
+	stopWorkers();
+	deletePartials();
+	for(size_t n=0;n<analyzers.size();n++)
+	{
+		delete analyzers[n];
+		analyzers[n]=0;
+	}
+}
+
+template<class IngredientsType>
+void MapReduceAnalysisDriver<IngredientsType>::addAnalyzer(MergeableAnalyzer<IngredientsType>* analyzer)
+{
+	if(analyzer==0)
+		throw std::runtime_error("MapReduceAnalysisDriver::addAnalyzer(): analyzer is NULL");
+	analyzers.push_back(analyzer);
+}
+
+/*****************************************************************************/
+/**
+ * @details Reads the header and the first frame, initializes the analyzers,
+ * evaluates all frames on the worker threads while merging the results and
+ * finally calls cleanup() of the analyzers. After run() the Ingredients
+ * contain the first frame of the file.
+ *
+ * @throw <std::runtime_error> if a worker fails to read or evaluate a chunk
+ */
+template<class IngredientsType>
+void MapReduceAnalysisDriver<IngredientsType>::run()
+{
+	FileImport<IngredientsType> file(filename,ingredients);
+	file.setUseFrameIndex(useFrameIndex);
+	file.initialize();
+	file.read();
+	ingredients.synchronize();
+
+	for(size_t n=0;n<analyzers.size();n++)
+		analyzers[n]->initialize();
+
+	uint32_t nFrames=file.getNumFrames();
+	uint32_t chunkSize=framesPerChunk;
+	if(chunkSize==0) chunkSize=nFrames/(8*nThreads);
+	if(chunkSize==0) chunkSize=1;
+
+	chunks.clear();
+	for(uint32_t first=1;first<=nFrames;first+=chunkSize)
+		chunks.push_back(Chunk(first,std::min(first+chunkSize-1,nFrames)));
+
+	nextChunk=0;
+	nMergedChunks=0;
+	maxChunksInFlight=2*nThreads;
+	stopping=false;
+
+	//the workers read the header sequentially and take the frame positions from file
+	for(uint32_t n=0;n<nThreads;n++)
+	{
+		workers.push_back(new Worker(*this,filename,file.getUseFrameIndex()));
+		workers.back()->file.initialize(file);
+	}
+	for(size_t n=0;n<workers.size();n++)
+		workers[n]->start();
+
+	try
+	{
+		reduce();
+	}
+	catch(...)
+	{
+		stopWorkers();
+		deletePartials();
+		throw;
+	}
+
+	stopWorkers();
+
+	for(size_t n=0;n<analyzers.size();n++)
+		analyzers[n]->cleanup();
+}
+
+/*****************************************************************************/
+template<class IngredientsType>
+void MapReduceAnalysisDriver<IngredientsType>::reduce()
+{
+	MutexLock lock(mutex);
+	while(nMergedChunks<chunks.size())
+	{
+		Chunk& chunk=chunks[nMergedChunks];
+		while(!chunk.done) chunkDone.wait(mutex);
+
+		if(chunk.failed)
+		{
+			std::stringstream errormessage;
+			errormessage<<"MapReduceAnalysisDriver::run(): error evaluating frames "
+			            <<chunk.firstFrame<<" to "<<chunk.lastFrame<<"\n"<<chunk.error;
+			throw std::runtime_error(errormessage.str());
+		}
+
+		//the mutex stays locked, such that no partial analyzers are created
+		//from the original ones while they are modified
+		for(size_t n=0;n<analyzers.size();n++)
+		{
+			analyzers[n]->merge(*(chunk.partials[n]));
+			delete chunk.partials[n];
+		}
+		chunk.partials.clear();
+
+		nMergedChunks++;
+		chunkMerged.broadcast();
+	}
+}
+
+/*****************************************************************************/
+template<class IngredientsType>
+void MapReduceAnalysisDriver<IngredientsType>::work(Worker& worker)
+{
+	MutexLock lock(mutex);
+	while(true)
+	{
+		while(!stopping && nextChunk<chunks.size() && nextChunk>=nMergedChunks+maxChunksInFlight)
+			chunkMerged.wait(mutex);
+		if(stopping || nextChunk>=chunks.size())
+			return;
+
+		Chunk& chunk=chunks[nextChunk++];
+
+		mutex.unlock();
+		evaluate(worker,chunk);
+		mutex.lock();
+
+		chunk.done=true;
+		chunkDone.signal();
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @details Commands of frames skipped since the last chunk of the worker are
+ * applied first by reading these frames. Called with unlocked mutex.
+ */
+template<class IngredientsType>
+void MapReduceAnalysisDriver<IngredientsType>::evaluate(Worker& worker, Chunk& chunk)
+{
+	try
+	{
+		for(uint32_t frame=worker.lastFrame+1;frame<chunk.firstFrame;frame++)
+		{
+			if(worker.file.frameHasCommands(frame))
+				worker.file.gotoFrame(frame);
+		}
+
+		worker.file.gotoFrame(chunk.firstFrame);
+		worker.lastFrame=chunk.firstFrame;
+		worker.ingredients.synchronize();
+
+		{
+			MutexLock lock(mutex);
+			for(size_t n=0;n<analyzers.size();n++)
+				chunk.partials.push_back(analyzers[n]->clone(worker.ingredients));
+		}
+
+		for(uint32_t frame=chunk.firstFrame;frame<=chunk.lastFrame;frame++)
+		{
+			if(frame>chunk.firstFrame)
+			{
+				worker.file.read();
+				worker.lastFrame=frame;
+				worker.ingredients.synchronize();
+			}
+			for(size_t n=0;n<chunk.partials.size();n++)
+				chunk.partials[n]->execute();
+		}
+	}
+	catch(std::exception& e)
+	{
+		chunk.failed=true;
+		chunk.error=e.what();
+	}
+	catch(...)
+	{
+		chunk.failed=true;
+		chunk.error="unknown exception";
+	}
+}
+
+/*****************************************************************************/
+template<class IngredientsType>
+void MapReduceAnalysisDriver<IngredientsType>::stopWorkers()
+{
+	{
+		MutexLock lock(mutex);
+		stopping=true;
+		chunkMerged.broadcast();
+	}
+	for(size_t n=0;n<workers.size();n++)
+	{
+		workers[n]->join();
+		delete workers[n];
+	}
+	workers.clear();
+}
+
+template<class IngredientsType>
+void MapReduceAnalysisDriver<IngredientsType>::deletePartials()
+{
+	for(size_t c=0;c<chunks.size();c++)
+	{
+		for(size_t n=0;n<chunks[c].partials.size();n++)
+			delete chunks[c].partials[n];
+		chunks[c].partials.clear();
+	}
+}
+
+#endif // LEMONADE_ANALYZER_MAPREDUCEANALYSISDRIVER_H
@@ -0,0 +1,81 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_ANALYZER_MERGEABLEANALYZER_H
+#define LEMONADE_ANALYZER_MERGEABLEANALYZER_H
+
+#include <LeMonADE/analyzer/AbstractAnalyzer.h>
+
+/**
+ * @file
+ *
+ * @class MergeableAnalyzer
+ *
+ * @brief Base class for analyzers whose results can be computed on parts of a trajectory and merged
+ *
+ * @details Analyzers deriving from this class can be used by the MapReduceAnalysisDriver,
+ * which evaluates chunks of consecutive frames on worker threads. For every chunk
+ * the driver creates a partial analyzer with clone(), calls only execute() on it for
+ * every frame of the chunk and finally merges it into the original analyzer with
+ * merge(). The chunks are merged in the order of the frames. initialize() and
+ * cleanup() are only called for the original analyzer.
+ *
+ * A partial analyzer must not write any output, it only accumulates its results.
+ * Since they can still be used with the TaskManager, these analyzers are
+ * AbstractAnalyzers as well.
+ *
+ * @tparam IngredientsType Ingredients class storing all system information
+ **/
+template < class IngredientsType >
+class MergeableAnalyzer: public AbstractAnalyzer
+{
+public:
+  virtual ~MergeableAnalyzer(){}
+
+  /**
+   * @brief Creates a partial analyzer evaluating the system ing with the settings of this analyzer.
+   *
+   * @details Called after initialize() of this analyzer. The returned object is
+   * owned and deleted by the caller.
+   *
+   * @param ing The system the partial analyzer works on
+   * @return Pointer to a new analyzer
+   **/
+  virtual MergeableAnalyzer<IngredientsType>* clone(const IngredientsType& ing) const = 0;
+
+  /**
+   * @brief Adds the results of a partial analyzer created by clone().
+   *
+   * @details The frames evaluated by partial directly follow the frames
+   * evaluated (or merged) by this analyzer so far.
+   *
+   * @param partial Analyzer created by clone() of this analyzer
+   **/
+  virtual void merge(MergeableAnalyzer<IngredientsType>& partial) = 0;
+};
+
+#endif // LEMONADE_ANALYZER_MERGEABLEANALYZER_H
@@ -46,6 +46,10 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  *
  * @tparam Edge Type of information that can be stored on a bond. Default is \a int.
  *
+ * @tparam StatisticsPolicy Move statistics collected by the features, FeatureStatisticsDisabled
+ * or FeatureStatisticsCounting (see FeatureStatistics.h). Default is DefaultFeatureStatistics,
+ * which is selected by the cmake option LEMONADE_FEATURE_STATISTICS.
+ *
  * @typedef ConfigureSystem::feature_list
  * @brief Final list of features used to construct Ingredients (Loki typelist).
  * @details Here the list of features given as a template parameter is automatically
@@ -74,11 +78,12 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  * */
 
 
-template <class MonomerBaseType, class FeatureList, uint max_connectivity=7, class Edge=int> class ConfigureSystem
+template <class MonomerBaseType, class FeatureList, uint max_connectivity=7, class Edge=int,
+          class StatisticsPolicy=DefaultFeatureStatistics> class ConfigureSystem
 {
 public:
   typedef typename InsertFeatureRequests < FeatureList >::Result feature_list;
-  typedef typename GenerateContextType<feature_list>::Result context_type;
+  typedef typename GenerateContextType<feature_list,StatisticsPolicy>::Result context_type;
   typedef typename GenerateMonomerType<MonomerBaseType,feature_list>::Result monomer_type;
   typedef Molecules<monomer_type,max_connectivity,Edge> molecules_type;
   enum {MY_ERRORSTATE=ConsistencyCheck< feature_list,::Loki::NullType>::MY_ERRORSTATE};
@@ -32,6 +32,9 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <vector>
 #include <map>
 #include <stdlib.h>
+#include <stdint.h>
+#include <sstream>
+#include <stdexcept>
 
 
 /**
@@ -37,6 +37,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include "extern/loki/HierarchyGenerators.h"
 
 #include <LeMonADE/core/TypelistExtensions.h>
+#include <LeMonADE/core/FeatureStatistics.h>
 /**
  * @file
  *
@@ -50,6 +51,12 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  * features can thus be called for every used feature in the system (see
  * member functions)
  *
+ * Depending on the statistics policy of the hierarchy (the statistics_policy of
+ * its root, see StatisticsModelFeature), every FeatureHolder counts the calls of
+ * checkMove and applyMove of its Feature and the rejected moves per type of move
+ * (see FeatureStatistics.h). By default, and always for the monomer types built by
+ * GenerateMonomerType, the policy is empty and compiles to nothing.
+ *
  * @tparam Feature
  * @brief Feature held by this FeatureHolder
  *
@@ -57,11 +64,17 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  * @brief Linear hierarchy of the rest of the used features
  *
  **/
-template < class Feature, class Base > class FeatureHolder: public Feature, public Base
+template < class Feature, class Base > class FeatureHolder: public Feature, public Base,
+	private FeatureStatisticsPolicyOf<Base>::Result::template Apply<Feature>::Result
 {
+  //! Statistics policy of this level of the hierarchy
+  typedef typename FeatureStatisticsPolicyOf<Base>::Result::template Apply<Feature>::Result statistics_type;
 
 public:
 
+  //! Statistics policy of the whole hierarchy
+  typedef typename FeatureStatisticsPolicyOf<Base>::Result statistics_policy;
+
   	/**
 	 * @brief Export the relevant functionality for reading bfm-files of all used Features.
 	 *
@@ -88,6 +101,28 @@ public:
 	Base   ::exportWrite(file);
   }
 
+  /**
+   * @brief Stores the internal state of all used Features in a binary checkpoint.
+   *
+   * @param checkpoint Writer of the checkpoint file
+   **/
+  template < class CheckpointWriter > void saveCheckpoint( CheckpointWriter& checkpoint) const
+  {
+	Feature::saveCheckpoint(checkpoint);
+	Base   ::saveCheckpoint(checkpoint);
+  }
+
+  /**
+   * @brief Restores the internal state of all used Features from a binary checkpoint.
+   *
+   * @param checkpoint Reader of the checkpoint file
+   **/
+  template < class CheckpointReader > void loadCheckpoint( CheckpointReader& checkpoint)
+  {
+	Feature::loadCheckpoint(checkpoint);
+	Base   ::loadCheckpoint(checkpoint);
+  }
+
   /**
    * @brief Overloaded function to stream all metadata of the Features to an output stream.
    *
@@ -109,6 +144,24 @@ public:
 	free(demangled);
   }
 
+  /**
+   * @brief Collects the move statistics of all Features (see FeatureStatistics.h).
+   *
+   * @param entries Container the FeatureStatisticsEntry of every feature and move type is appended to
+   */
+  template < class Container > void collectFeatureStatistics( Container& entries ) const
+  {
+	statistics_type::collectStatistics(entries);
+	Base::collectFeatureStatistics(entries);
+  }
+
+  //! Sets the move statistics of all Features to zero
+  void resetFeatureStatistics()
+  {
+	statistics_type::resetStatistics();
+	Base::resetFeatureStatistics();
+  }
+
   /**
    * @brief Check for all Features the Move.
    *
@@ -123,7 +176,10 @@ public:
   {
     //check move compatibility with current feature and
     // the rest of the features.
-    return Feature::checkMove(ingedients,move) && Base::checkMove(ingedients,move);
+    uint64_t start=statistics_type::template beginMoveStatistics<MoveType>();
+    bool accepted=Feature::checkMove(ingedients,move);
+    statistics_type::template countCheck<MoveType>(start,accepted);
+    return accepted && Base::checkMove(ingedients,move);
   }
 
 
@@ -139,7 +195,9 @@ public:
   {
     //check move compatibility with current feature and
     // the rest of the features.
+    uint64_t start=statistics_type::template beginMoveStatistics<MoveType>();
     Feature::applyMove(ingedients,move);
+    statistics_type::template countApply<MoveType>(start);
     Base::applyMove(ingedients,move);
   }
 
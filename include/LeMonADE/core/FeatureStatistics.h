@@ -0,0 +1,352 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_CORE_FEATURESTATISTICS_H
+#define LEMONADE_CORE_FEATURESTATISTICS_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Optional per-feature statistics of checkMove and applyMove calls
+ *
+ * @details The statistics are disabled by default and then compile to nothing.
+ * Whether they are collected is part of the type of the Ingredients: the
+ * statistics policy is the last template parameter of ConfigureSystem, which
+ * is FeatureStatisticsDisabled or FeatureStatisticsCounting. Optionally, the
+ * counting policy also measures the cost of every call with the cycle counter
+ * of the cpu (time stamp counter on x86, nanoseconds of the monotonic clock
+ * elsewhere). The default policy DefaultFeatureStatistics counts if
+ * LEMONADE_FEATURE_STATISTICS is defined (cmake option of the same name) and
+ * additionally measures the cost if LEMONADE_FEATURE_STATISTICS_TIMING is defined.
+ * As the policy is part of the type, translation units using different
+ * policies can be linked into the same program. The statistics are
+ * collected by FeatureHolder and accessed through
+ * Ingredients::printFeatureStatistics() and Ingredients::getFeatureStatistics().
+ * */
+/*****************************************************************************/
+
+#include <cxxabi.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+/*****************************************************************************/
+/**
+ * @struct FeatureStatisticsEntry
+ * @brief Counters of one feature for one type of move
+ **/
+/*****************************************************************************/
+struct FeatureStatisticsEntry
+{
+	FeatureStatisticsEntry()
+	:checks(0),rejections(0),checkTicks(0),applies(0),applyTicks(0){}
+
+	//! Demangled name of the feature
+	std::string feature;
+	//! Demangled name of the move type
+	std::string move;
+	//! Number of calls of the feature's checkMove
+	uint64_t checks;
+	//! Number of calls of the feature's checkMove returning false
+	uint64_t rejections;
+	//! Cycles spent in the feature's checkMove (0 without timing)
+	uint64_t checkTicks;
+	//! Number of calls of the feature's applyMove
+	uint64_t applies;
+	//! Cycles spent in the feature's applyMove (0 without timing)
+	uint64_t applyTicks;
+};
+
+//! Demangled name of a type
+inline std::string featureStatisticsTypeName(const std::type_info& type)
+{
+	int status=0;
+	char* demangled=abi::__cxa_demangle(type.name(),0,0,&status);
+	std::string name((status==0 && demangled!=0)?demangled:type.name());
+	std::free(demangled);
+	return name;
+}
+
+//! Names of all move types registered by FeatureStatisticsMoveIndex, indexed by their index
+inline std::vector<std::string>& featureStatisticsMoveNames()
+{
+	static std::vector<std::string> names;
+	return names;
+}
+
+//! Appends the move name to featureStatisticsMoveNames() and returns its index
+inline size_t registerFeatureStatisticsMove(const std::type_info& type)
+{
+	static pthread_mutex_t registryMutex=PTHREAD_MUTEX_INITIALIZER;
+	std::string name=featureStatisticsTypeName(type);
+	pthread_mutex_lock(&registryMutex);
+	std::vector<std::string>& names=featureStatisticsMoveNames();
+	size_t index=0;
+	while(index<names.size() && names[index]!=name) index++;
+	if(index==names.size()) names.push_back(name);
+	pthread_mutex_unlock(&registryMutex);
+	return index;
+}
+
+/**
+ * @class FeatureStatisticsMoveIndex
+ * @brief Assigns a consecutive index to every move type used with checkMove
+ **/
+template<class MoveType> struct FeatureStatisticsMoveIndex
+{
+	static size_t get()
+	{
+		static const size_t index=registerFeatureStatisticsMove(typeid(MoveType));
+		return index;
+	}
+};
+
+/**
+ * @class FeatureStatisticsClock
+ * @brief Cycle counter used for the timing
+ *
+ * @details The clock is a template on the timing switch of the statistics policy.
+ **/
+template<bool Timing> struct FeatureStatisticsClock
+{
+	//! Without timing the counter is always 0
+	static uint64_t ticks() {return 0;}
+};
+
+template<> struct FeatureStatisticsClock<true>
+{
+	//! Current value of the cycle counter
+	static uint64_t ticks()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		timespec t;
+		clock_gettime(CLOCK_MONOTONIC,&t);
+		return uint64_t(t.tv_sec)*1000000000u+uint64_t(t.tv_nsec);
+#endif
+	}
+};
+
+/*****************************************************************************/
+/**
+ * @class NoFeatureStatistics
+ * @brief Statistics policy of FeatureHolder doing nothing (default)
+ *
+ * @details All functions are empty inlines, such that checkMove and applyMove
+ * compile to the same code as without statistics. The template parameter only
+ * makes the (empty) base classes of different FeatureHolders distinct.
+ **/
+/*****************************************************************************/
+template<class FeatureType> class NoFeatureStatistics
+{
+public:
+	template<class MoveType> uint64_t beginMoveStatistics() const {return 0;}
+	template<class MoveType> void countCheck(uint64_t, bool) {}
+	template<class MoveType> void countApply(uint64_t) {}
+	template<class Container> void collectStatistics(Container&) const {}
+	void resetStatistics() {}
+};
+
+/*****************************************************************************/
+/**
+ * @class CountingFeatureStatistics
+ * @brief Statistics policy of FeatureHolder counting the calls of one feature
+ *
+ * @details Counters are kept per move type, indexed by FeatureStatisticsMoveIndex.
+ * Like the features themselves, the counters are not synchronized between threads.
+ * The cycles are only measured if Timing is true.
+ **/
+/*****************************************************************************/
+template<class FeatureType, bool Timing> class CountingFeatureStatistics
+{
+public:
+	//! Start of a call: returns the current cycle counter (0 without timing)
+	template<class MoveType> uint64_t beginMoveStatistics() const
+	{
+		return FeatureStatisticsClock<Timing>::ticks();
+	}
+
+	//! Counts a call of checkMove started at start
+	template<class MoveType> void countCheck(uint64_t start, bool accepted)
+	{
+		FeatureStatisticsEntry& entry=getEntry(FeatureStatisticsMoveIndex<MoveType>::get());
+		entry.checks++;
+		if(!accepted) entry.rejections++;
+		entry.checkTicks+=FeatureStatisticsClock<Timing>::ticks()-start;
+	}
+
+	//! Counts a call of applyMove started at start
+	template<class MoveType> void countApply(uint64_t start)
+	{
+		FeatureStatisticsEntry& entry=getEntry(FeatureStatisticsMoveIndex<MoveType>::get());
+		entry.applies++;
+		entry.applyTicks+=FeatureStatisticsClock<Timing>::ticks()-start;
+	}
+
+	//! Appends the counters of all move types used so far to entries
+	template<class Container> void collectStatistics(Container& entries) const
+	{
+		std::string featureName=featureStatisticsTypeName(typeid(FeatureType));
+		const std::vector<std::string>& moveNames=featureStatisticsMoveNames();
+		for(size_t n=0;n<counters.size();n++)
+		{
+			if(counters[n].checks==0 && counters[n].applies==0) continue;
+			FeatureStatisticsEntry entry=counters[n];
+			entry.feature=featureName;
+			entry.move=moveNames[n];
+			entries.push_back(entry);
+		}
+	}
+
+	//! Sets all counters to zero
+	void resetStatistics() {counters.clear();}
+
+private:
+	FeatureStatisticsEntry& getEntry(size_t index)
+	{
+		if(index>=counters.size()) counters.resize(index+1);
+		return counters[index];
+	}
+
+	std::vector<FeatureStatisticsEntry> counters;
+};
+
+/**
+ * @class FeatureStatisticsDisabled
+ * @brief Statistics policy of ConfigureSystem collecting no statistics
+ **/
+struct FeatureStatisticsDisabled
+{
+	//! Statistics policy of the FeatureHolder of FeatureType
+	template<class FeatureType> struct Apply
+	{
+		typedef NoFeatureStatistics<FeatureType> Result;
+	};
+	enum {ENABLED=0};
+};
+
+/**
+ * @class FeatureStatisticsCounting
+ * @brief Statistics policy of ConfigureSystem counting the calls of every feature
+ *
+ * @tparam Timing If true, the cycles spent in every call are measured as well
+ **/
+template<bool Timing=false> struct FeatureStatisticsCounting
+{
+	//! Statistics policy of the FeatureHolder of FeatureType
+	template<class FeatureType> struct Apply
+	{
+		typedef CountingFeatureStatistics<FeatureType,Timing> Result;
+	};
+	enum {ENABLED=1};
+};
+
+//! Implementation of FeatureStatisticsPolicyOf
+template<class Hierarchy, bool HasPolicy> struct SelectFeatureStatisticsPolicy
+{
+	typedef typename Hierarchy::statistics_policy Result;
+};
+
+template<class Hierarchy> struct SelectFeatureStatisticsPolicy<Hierarchy,false>
+{
+	typedef FeatureStatisticsDisabled Result;
+};
+
+/**
+ * @class FeatureStatisticsPolicyOf
+ * @brief Statistics policy of the (partial) hierarchy a FeatureHolder is built on
+ *
+ * @details This is the statistics_policy of the hierarchy, or FeatureStatisticsDisabled
+ * if it has none. The latter is the case for the monomer types, which are assembled
+ * from the monomer extensions by FeatureHolder as well (see GenerateMonomerType).
+ **/
+template<class Hierarchy> class FeatureStatisticsPolicyOf
+{
+	template<class T> static char test(typename T::statistics_policy*);
+	template<class T> static long test(...);
+public:
+	typedef typename SelectFeatureStatisticsPolicy<Hierarchy,sizeof(test<Hierarchy>(0))==sizeof(char)>::Result Result;
+};
+
+//! Statistics policy used by ConfigureSystem if none is given explicitly
+#if defined(LEMONADE_FEATURE_STATISTICS_TIMING)
+typedef FeatureStatisticsCounting<true> DefaultFeatureStatistics;
+#elif defined(LEMONADE_FEATURE_STATISTICS)
+typedef FeatureStatisticsCounting<false> DefaultFeatureStatistics;
+#else
+typedef FeatureStatisticsDisabled DefaultFeatureStatistics;
+#endif
+
+/**
+ * @brief Prints the statistics as a table
+ *
+ * @details Besides the raw counters the table contains the fraction of the
+ * checks rejected by the feature and the average cost per call in cycles.
+ * Features are listed in the order of the feature hierarchy, i.e. in the order
+ * in which checkMove is called. A feature is only asked if all features
+ * before accepted the move.
+ *
+ * @param stream output stream
+ * @param entries statistics as collected by Ingredients::getFeatureStatistics()
+ */
+inline void printFeatureStatisticsTable(std::ostream& stream, const std::vector<FeatureStatisticsEntry>& entries)
+{
+	std::ios_base::fmtflags flags=stream.flags();
+	std::streamsize precision=stream.precision();
+
+	stream<<std::right<<std::setw(14)<<"checks"<<std::setw(14)<<"rejected"<<std::setw(10)<<"reject%"
+	      <<std::setw(14)<<"cycles/check"<<std::setw(14)<<"applies"<<std::setw(14)<<"cycles/apply"
+	      <<"  feature / move"<<std::endl;
+	for(size_t n=0;n<entries.size();n++)
+	{
+		const FeatureStatisticsEntry& e=entries[n];
+		stream<<std::setw(14)<<e.checks<<std::setw(14)<<e.rejections
+		      <<std::setw(10)<<std::fixed<<std::setprecision(2)
+		      <<(e.checks>0?100.0*double(e.rejections)/double(e.checks):0.0)
+		      <<std::setw(14)<<std::setprecision(1)<<(e.checks>0?double(e.checkTicks)/double(e.checks):0.0)
+		      <<std::setw(14)<<e.applies
+		      <<std::setw(14)<<(e.applies>0?double(e.applyTicks)/double(e.applies):0.0)
+		      <<"  "<<e.feature<<" / "<<e.move<<std::endl;
+	}
+
+	stream.flags(flags);
+	stream.precision(precision);
+}
+
+#endif /* LEMONADE_CORE_FEATURESTATISTICS_H */
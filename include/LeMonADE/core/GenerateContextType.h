@@ -49,6 +49,19 @@ struct EmptyModelFeature : public Feature {
 
 };
 
+/**
+ * @class StatisticsModelFeature
+ * @brief Dead end of the feature hierarchy carrying the statistics policy (see FeatureStatistics.h)
+ *
+ * @details Every FeatureHolder of the hierarchy takes the policy from here. As
+ * the root is part of the type of every level, hierarchies with different
+ * policies are different types.
+ **/
+template <class StatisticsPolicy> struct StatisticsModelFeature : public EmptyModelFeature {
+	//! Statistics policy of all FeatureHolders of the hierarchy
+	typedef StatisticsPolicy statistics_policy;
+};
+
 
 /**
  * @class FullExpand
@@ -162,10 +175,12 @@ template<class TList> struct InsertFeatureRequests
 /**
  * @class GenerateContextType
  * @brief Generates a linear hierarchy type from the typelist of features given as template parameter
+ *
+ * @tparam StatisticsPolicy Policy of the move statistics of the features (see FeatureStatistics.h)
  **/
-template < class TList > struct  GenerateContextType
+template < class TList, class StatisticsPolicy=DefaultFeatureStatistics > struct  GenerateContextType
 {
-	typedef ::Loki::GenLinearHierarchy < TList , FeatureHolder, EmptyModelFeature >  Result;
+	typedef ::Loki::GenLinearHierarchy < TList , FeatureHolder, StatisticsModelFeature<StatisticsPolicy> >  Result;
 };
 
 
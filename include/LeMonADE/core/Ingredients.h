@@ -30,6 +30,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <vector>
 #include <string>
+#include <typeinfo>
 
 #include <LeMonADE/core/ConfigureSystem.h>
 
@@ -264,6 +265,63 @@ public:
 		context_type::exportWrite(file);
 	}
 
+	/**
+	 * @brief Stores the complete state of the system in a binary checkpoint.
+	 *
+	 * @details Writes a signature of the system type, name, comments and the
+	 * Molecules, and delegates the rest to all features. Use writeSystemCheckpoint()
+	 * (SystemCheckpoint.h) to include the random number generators and the TaskManager.
+	 *
+	 * @param checkpoint Writer of the checkpoint file (see CheckpointWriter)
+	 */
+	template<class CheckpointWriter>
+	void saveCheckpoint(CheckpointWriter& checkpoint) const
+	{
+		checkpoint.beginSection("Ingredients");
+		checkpoint.writeString(typeid(Ingredients).name());
+		checkpoint.writeString(name);
+		checkpoint.write(uint64_t(comments.size()));
+		for(size_t n=0;n<comments.size();n++)
+			checkpoint.writeString(comments[n]);
+
+		molecules.saveCheckpoint(checkpoint);
+		context_type::saveCheckpoint(checkpoint);
+	}
+
+	/**
+	 * @brief Restores the complete state of the system from a binary checkpoint.
+	 *
+	 * @details The state is restored as it was saved, no synchronization is needed
+	 * afterwards.
+	 *
+	 * @throw <std::runtime_error> if the checkpoint was written by a different type of system.
+	 *
+	 * @param checkpoint Reader of the checkpoint file (see CheckpointReader)
+	 */
+	template<class CheckpointReader>
+	void loadCheckpoint(CheckpointReader& checkpoint)
+	{
+		checkpoint.beginSection("Ingredients");
+		std::string signature;
+		checkpoint.readString(signature);
+		if(signature!=typeid(Ingredients).name())
+		{
+			std::stringstream errormessage;
+			errormessage<<"Ingredients::loadCheckpoint: checkpoint "<<checkpoint.getFilename()
+				    <<" was written by a system with a different set of features";
+			throw std::runtime_error(errormessage.str());
+		}
+		checkpoint.readString(name);
+		uint64_t nComments;
+		checkpoint.read(nComments);
+		comments.resize(nComments);
+		for(size_t n=0;n<comments.size();n++)
+			checkpoint.readString(comments[n]);
+
+		molecules.loadCheckpoint(checkpoint);
+		context_type::loadCheckpoint(checkpoint);
+	}
+
 	/**
 	 * @brief Overloaded function to stream all metadata to an output stream
 	 *
@@ -278,6 +336,43 @@ public:
 		stream << std::endl << "not registered features: " << std::endl << std::endl << getSumOfComments() << std::endl;
 	}
 
+	/**
+	 * @brief Prints the number of checked and rejected moves per feature and move type.
+	 *
+	 * @details The statistics are only collected if the statistics policy of
+	 * ConfigureSystem counts, by default if LeMonADE is compiled with
+	 * LEMONADE_FEATURE_STATISTICS (and LEMONADE_FEATURE_STATISTICS_TIMING for the
+	 * cost per call), see FeatureStatistics.h.
+	 *
+	 * @param stream output stream
+	 */
+	void printFeatureStatistics(std::ostream& stream) const {
+		if(!context_type::statistics_policy::ENABLED){
+			stream << "feature statistics disabled, compile with LEMONADE_FEATURE_STATISTICS" << std::endl;
+			return;
+		}
+		std::vector<FeatureStatisticsEntry> entries;
+		getFeatureStatistics(entries);
+		stream << std::endl << "feature statistics of " << name << ": " << std::endl << std::endl;
+		printFeatureStatisticsTable(stream, entries);
+	}
+
+	/**
+	 * @brief Collects the move statistics of all features.
+	 *
+	 * @details The entries are ordered like the features in the hierarchy. The
+	 * result is empty if the statistics are disabled.
+	 *
+	 * @param entries Vector the statistics are written to (previous content is removed)
+	 */
+	void getFeatureStatistics(std::vector<FeatureStatisticsEntry>& entries) const {
+		entries.clear();
+		context_type::collectFeatureStatistics(entries);
+	}
+
+	//! Sets the move statistics of all features to zero
+	void resetFeatureStatistics() { context_type::resetFeatureStatistics(); }
+
 	/**
 	 * @brief Adding metadata information the the system.
 	 *
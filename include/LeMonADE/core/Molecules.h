@@ -39,6 +39,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/core/MoleculesRead.h>
 #include <LeMonADE/core/MoleculesWrite.h>
 #include <LeMonADE/io/FileImport.h>
+#include <LeMonADE/utility/ConnectedComponents.h>
 
 /**
  * @file
@@ -90,7 +91,7 @@ template < class Vertex, uint max_connectivity = 7, class Edge = int > class Mol
   //constructors
   /*****************************************************************************/
   //! Standard constructor that initialize with zero vertices at age equal 0
-  Molecules():vertices(0),myAge(0){}
+  Molecules():vertices(0),myAge(0),componentsValid(false){}
 
   //! Conversion constructor
   template < class V, uint m, class E> Molecules (const Molecules<V,m,E>& src);
@@ -119,7 +120,7 @@ template < class Vertex, uint max_connectivity = 7, class Edge = int > class Mol
    *
    * @param newGraphSize the number of vertices the graph should hold
    */
-  void     	resize(uint32_t newGraphSize) {vertices.resize(newGraphSize);}
+  void     	resize(uint32_t newGraphSize) {vertices.resize(newGraphSize); componentsValid=false;}
 
   /**
    * @brief Returns the actual size of the graph, esp. the number of vertices.
@@ -161,6 +162,7 @@ template < class Vertex, uint max_connectivity = 7, class Edge = int > class Mol
   uint32_t addMonomer(vertex_type monomer)
   {
 	  vertices.push_back(monomer);
+	  componentsValid=false;
 	  return (vertices.size()-1);
   }
 
@@ -191,6 +193,7 @@ template < class Vertex, uint max_connectivity = 7, class Edge = int > class Mol
 	  monomer.setY(y);
 	  monomer.setZ(z);
 	  vertices.push_back(monomer);
+	  componentsValid=false;
 
 	  return (vertices.size()-1);
   }
@@ -259,7 +262,7 @@ template < class Vertex, uint max_connectivity = 7, class Edge = int > class Mol
 
 
   //! Clear the graph destroying all vertices&edges and setting the age to zero.
-  void clear(){resize(0); edges.clear(); myAge=0;}
+  void clear(){resize(0); edges.clear(); myAge=0; componentsValid=false;}
 
   /** Delete all the edges (bonds) in the graph. This does not destroy the vertices&edges.
    * @todo check where this might be used?
@@ -269,6 +272,15 @@ template < class Vertex, uint max_connectivity = 7, class Edge = int > class Mol
   //! returns the edges of the graph 
   std::map < std::pair < uint32_t, uint32_t > , Edge > getEdges() const {return edges;}
 
+  //! Returns the connected components (molecules) of the graph
+  const ConnectedComponents& getConnectedComponents() const;
+
+  //! Stores vertices, edges and age as raw binary blocks in a checkpoint (see CheckpointWriter)
+  template < class CheckpointWriter > void saveCheckpoint(CheckpointWriter& checkpoint) const;
+
+  //! Replaces the graph by the vertices, edges and age stored in a checkpoint
+  template < class CheckpointReader > void loadCheckpoint(CheckpointReader& checkpoint);
+
 private:
 
   /**
@@ -287,6 +299,12 @@ private:
 
   //! Age of the configuration in Monte-Carlo steps (MCS)
   uint64_t myAge;
+
+  //! Cached connected components, see getConnectedComponents()
+  mutable ConnectedComponents components;
+
+  //! False if the vertices or the connectivity changed since the components were labelled
+  mutable bool componentsValid;
 };
 
 
@@ -306,6 +324,7 @@ private:
 template < class Vertex, uint max_connectivity, class Edge>
 template < class V, uint m, class E >
 Molecules<Vertex,max_connectivity, Edge>::Molecules (const Molecules<V,m,E>& src)
+:componentsValid(false)
 {
 
 	clear();
@@ -396,6 +415,7 @@ Molecules<Vertex,max_connectivity, Edge>& Molecules<Vertex, max_connectivity, Ed
 #endif //DEBUG
 
 	vertices.resize(oldsize+src.size());
+	componentsValid=false;
 
 #ifdef DEBUG
 	std::cout << "new size after resize: " << (vertices.size())<< std::endl;
@@ -473,6 +493,7 @@ void Molecules <Vertex,max_connectivity,Edge>::connect(uint32_t a, uint32_t b, c
     //store connection information in edges map, if connecting went fine
     IndexPair edge_key(std::min(a,b),std::max(a,b));
     edges[edge_key] = edgeVal;
+    componentsValid=false;
 }
 
 
@@ -490,6 +511,7 @@ void Molecules <Vertex,max_connectivity, Edge>::disconnect(uint32_t a, uint32_t
    vertices.at(b).disconnect(a);
    IndexPair idx(std::min(a,b),std::max(a,b));
    edges.erase(idx);
+   componentsValid=false;
 }
 
 
@@ -612,6 +634,26 @@ bool Molecules<Vertex, max_connectivity, Edge>::areConnected(uint32_t a, uint32_
 }
 
 
+/**
+ * @details The components are labelled on the first call after the vertices
+ * or the connectivity changed (addMonomer(), resize(), connect(), disconnect(),
+ * ...) and cached until the next change. Labelling is linear in the number of
+ * vertices and bonds, see ConnectedComponents. The first call after a change
+ * modifies the cache, so it must not run concurrently with other calls.
+ *
+ * @return The connected components of the graph
+ */
+template<class Vertex, uint max_connectivity, class Edge>
+const ConnectedComponents& Molecules<Vertex, max_connectivity, Edge>::getConnectedComponents() const
+{
+	if(!componentsValid || components.getNumberOfVertices()!=vertices.size())
+	{
+		components.compute(*this);
+		componentsValid=true;
+	}
+	return components;
+}
+
 /**
  * This function loops over all vertices in the graph, checks if they are connected,
  * and disconnect them if applicable.
@@ -630,4 +672,57 @@ void Molecules<Vertex, max_connectivity, Edge>::clearBonds()
 
 
 
+/**
+ * @details The vertices including their neighbor lists are written as one raw
+ * block, the edges as a list of index pairs and edge information. Vertex and
+ * Edge therefore have to be plain data types, which is the case for all monomer
+ * extensions provided by the features.
+ *
+ * @param checkpoint Writer of the checkpoint file
+ */
+template < class Vertex, uint max_connectivity, class Edge>
+template < class CheckpointWriter >
+void Molecules<Vertex,max_connectivity,Edge>::saveCheckpoint(CheckpointWriter& checkpoint) const
+{
+	checkpoint.beginSection("Molecules");
+	checkpoint.write(myAge);
+	checkpoint.writeVector(vertices);
+
+	checkpoint.write(uint64_t(edges.size()));
+	typename std::map < IndexPair, Edge >::const_iterator it;
+	for(it=edges.begin();it!=edges.end();++it)
+	{
+		checkpoint.write(it->first.first);
+		checkpoint.write(it->first.second);
+		checkpoint.write(it->second);
+	}
+}
+
+/**
+ * @param checkpoint Reader of the checkpoint file
+ */
+template < class Vertex, uint max_connectivity, class Edge>
+template < class CheckpointReader >
+void Molecules<Vertex,max_connectivity,Edge>::loadCheckpoint(CheckpointReader& checkpoint)
+{
+	checkpoint.beginSection("Molecules");
+	checkpoint.read(myAge);
+	checkpoint.readVector(vertices);
+	componentsValid=false;
+
+	edges.clear();
+	uint64_t nEdges;
+	checkpoint.read(nEdges);
+	for(uint64_t n=0;n<nEdges;n++)
+	{
+		IndexPair indices;
+		Edge edge;
+		checkpoint.read(indices.first);
+		checkpoint.read(indices.second);
+		checkpoint.read(edge);
+		//edges were written in sorted order, so insertion at the end is constant time
+		edges.insert(edges.end(),std::make_pair(indices,edge));
+	}
+}
+
 #endif
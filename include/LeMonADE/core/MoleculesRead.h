@@ -38,10 +38,12 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <limits>
 #include <list>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
 
-
-#include <LeMonADE/io/AbstractRead.h>
 #include <LeMonADE/io/AbstractRead.h>
+#include <LeMonADE/io/MappedFileBuffer.h>
+#include <LeMonADE/utility/Vector3D.h>
 
 
 /***********************************************************************/
@@ -95,6 +97,10 @@ class ReadBonds: public ReadToDestination < IngredientsType >
 	ReadBonds(IngredientsType& destination):ReadToDestination< IngredientsType > (destination){}
 
 	void execute();
+
+ private:
+	//! Zero-copy implementation of execute() for memory mapped input
+	void executeMapped(MappedFileBuffer& buffer);
 };
 
 /***********************************************************************/
@@ -106,6 +112,12 @@ class ReadBonds: public ReadToDestination < IngredientsType >
 template < class IngredientsType >
 void ReadBonds<IngredientsType>::execute()
 {
+  //decode memory mapped input directly
+  MappedFileBuffer* mappedBuffer=this->getMappedBuffer();
+  if(mappedBuffer!=0){
+    executeMapped(*mappedBuffer);
+    return;
+  }
 
   int a,b;
   int nBonds=0;
@@ -152,6 +164,54 @@ void ReadBonds<IngredientsType>::execute()
 
 }
 
+/***********************************************************************/
+/**
+ * @brief Reads \b !bonds directly from the memory mapped file.
+ *
+ * @details Same behavior as the stream based implementation in execute(),
+ * but the bond partners are decoded in place without temporary strings.
+ *
+ * @throw <std::runtime_error> if bond could not be read.
+ **/
+template < class IngredientsType >
+void ReadBonds<IngredientsType>::executeMapped(MappedFileBuffer& buffer)
+{
+  int a,b;
+  int nBonds=0;
+  const char* lineBegin;
+  const char* lineEnd;
+
+  //go to next line and save the position of the get pointer
+  if(buffer.position()!=buffer.end()) buffer.setPosition(buffer.position()+1);
+  const char* previous=buffer.position();
+
+  this->getMappedLine(buffer,lineBegin,lineEnd);
+
+  while(lineBegin!=lineEnd && this->getInputStream().good()){
+
+    //if the line contains a bfm Read, stop the procedure and set the get pointer back
+    if(this->detectRead(lineBegin,lineEnd)){
+      buffer.setPosition(previous);
+      break;
+    }
+
+    //read bond partners
+    const char* pos=lineBegin;
+    if(!MappedFileBuffer::parseInteger(pos,lineEnd,a) || !MappedFileBuffer::parseInteger(pos,lineEnd,b)){
+      std::stringstream errormessage;
+      errormessage<<"ReadBonds<IngredientsType>::execute()\n"
+		  <<"Could not read bond partners in "<<nBonds+1<<" th bond definition\n";
+      throw std::runtime_error(errormessage.str());
+    }
+
+    //if still here, add bond to bondset
+    this->getDestination().modifyMolecules().connect(a-1,b-1);
+    nBonds++;
+    previous=buffer.position();
+    this->getMappedLine(buffer,lineBegin,lineEnd);
+  }
+}
+
 /***********************************************************************/
 /**
  * @class ReadRemoveBonds
@@ -167,6 +227,10 @@ class ReadRemoveBonds: public ReadToDestination < IngredientsType >
 	ReadRemoveBonds(IngredientsType& destination):ReadToDestination< IngredientsType > (destination){}
 
 	void execute();
+
+ private:
+	//! Zero-copy implementation of execute() for memory mapped input
+	void executeMapped(MappedFileBuffer& buffer);
 };
 /***********************************************************************/
 /**
@@ -178,6 +242,13 @@ class ReadRemoveBonds: public ReadToDestination < IngredientsType >
 template < class IngredientsType >
 void ReadRemoveBonds<IngredientsType>::execute()
 {
+  //decode memory mapped input directly
+  MappedFileBuffer* mappedBuffer=this->getMappedBuffer();
+  if(mappedBuffer!=0){
+    executeMapped(*mappedBuffer);
+    return;
+  }
+
   int a,b;
   int nBreaks=0;
   
@@ -223,6 +294,50 @@ void ReadRemoveBonds<IngredientsType>::execute()
 
 }
 
+/***********************************************************************/
+/**
+ * @brief Reads \b !remove_bonds directly from the memory mapped file.
+ *
+ * @throw <std::runtime_error> if broken bond could not be read.
+ **/
+template < class IngredientsType >
+void ReadRemoveBonds<IngredientsType>::executeMapped(MappedFileBuffer& buffer)
+{
+  int a,b;
+  int nBreaks=0;
+  const char* lineBegin;
+  const char* lineEnd;
+
+  //go to next line and save the position of the get pointer
+  if(buffer.position()!=buffer.end()) buffer.setPosition(buffer.position()+1);
+  const char* previous=buffer.position();
+
+  this->getMappedLine(buffer,lineBegin,lineEnd);
+
+  while(lineBegin!=lineEnd && this->getInputStream().good()){
+
+    //if the line contains a bfm Read, stop the procedure and set the get pointer back
+    if(this->detectRead(lineBegin,lineEnd)){
+      buffer.setPosition(previous);
+      break;
+    }
+
+    //read bond partners
+    const char* pos=lineBegin;
+    if(!MappedFileBuffer::parseInteger(pos,lineEnd,a) || !MappedFileBuffer::parseInteger(pos,lineEnd,b)){
+      std::stringstream errormessage;
+      errormessage<<"ReadRemoveBonds<IngredientsType>::execute()\n"
+		  <<"Could not read broken bond partners in "<<nBreaks+1<<" th broken bond definition\n";
+      throw std::runtime_error(errormessage.str());
+    }
+
+    this->getDestination().modifyMolecules().disconnect(a-1,b-1);
+    nBreaks++;
+    previous=buffer.position();
+    this->getMappedLine(buffer,lineBegin,lineEnd);
+  }
+}
+
 /***********************************************************************/
 /**
  * @class ReadMcs
@@ -260,6 +375,27 @@ class ReadMcs: public ReadToDestination < IngredientsType >
 	//! processes a line beginning with keyword solvent
 	void processSolventContinueLine(const std::string& line,uint32_t& offset);
 
+	//! Zero-copy implementation of execute() for memory mapped input
+	void executeMapped(MappedFileBuffer& buffer);
+
+	//! processes a regular mcs line [pos,lineEnd) from the memory mapped file
+	void processRegularLine(const char* pos, const char* lineEnd);
+
+	//! processes the compressed solvent positions in [pos,lineEnd) from the memory mapped file
+	void processSolventPositions(const char* pos, const char* lineEnd, uint32_t& offset);
+
+	//! throws or warns if the number of monomers in the frame is inconsistent and resets the counter
+	void finishFrame();
+
+	//! returns the bond vector of an ASCII bond identifier, cached for the current frame
+	const VectorInt3& getCachedBondVector(unsigned char identifier);
+
+	//! bond vectors of the ASCII bond identifiers used in the current frame
+	VectorInt3 bondVectorCache[256];
+
+	//! flags if the entry in bondVectorCache is valid for the current frame
+	bool bondVectorCached[256];
+
 
  public:
   //! Empty Constructor, but delegates call to the Feature. Default: no ignoring of missing monomers.
@@ -291,6 +427,13 @@ class ReadMcs: public ReadToDestination < IngredientsType >
  **/
 template < class IngredientsType > void ReadMcs< IngredientsType >::execute()
 {
+  //decode memory mapped input directly
+  MappedFileBuffer* mappedBuffer=this->getMappedBuffer();
+  if(mappedBuffer!=0){
+    executeMapped(*mappedBuffer);
+    return;
+  }
+
   //get writeable reference to the molecules container
   typename IngredientsType::molecules_type& molecules = this->getDestination().modifyMolecules();
 
@@ -391,6 +534,19 @@ template < class IngredientsType > void ReadMcs< IngredientsType >::execute()
 	  }
   }
 
+  finishFrame();
+}
+
+/***********************************************************************/
+/**
+ * @brief Checks the number of monomers read in the current frame.
+ *
+ * @throw <std::runtime_error> if monomers are missing (and this is not ignored).
+ **/
+template < class IngredientsType > void ReadMcs< IngredientsType >::finishFrame()
+{
+  typename IngredientsType::molecules_type& molecules = this->getDestination().modifyMolecules();
+
   //if total number of monomers in !mcs differs from previous, throw exception
   if((uint32_t)monomerCount!=molecules.size()){
 
@@ -420,6 +576,198 @@ template < class IngredientsType > void ReadMcs< IngredientsType >::execute()
 
 }
 
+/***********************************************************************/
+/**
+ * @brief Reads \b !mcs directly from the memory mapped file.
+ *
+ * @details Same behavior as the stream based implementation in execute(),
+ * but coordinates, bond characters and compressed solvent are decoded in place
+ * from the mapped bytes without temporary strings or stringstreams. The bond
+ * vectors of the ASCII bond identifiers are looked up only once per frame.
+ *
+ * @throw <std::runtime_error> if Monte-Carlo-Step could not be parsed or if monomers are missing.
+ **/
+template < class IngredientsType > void ReadMcs< IngredientsType >::executeMapped(MappedFileBuffer& buffer)
+{
+  typename IngredientsType::molecules_type& molecules = this->getDestination().modifyMolecules();
+
+  if ( this->isFirstCall() ) {
+	std::cout << "ReadMcs:execute() : updating ";
+	std::cout << "connectivity and ";
+	std::cout << "positions.";
+  }
+
+  std::fill(bondVectorCached,bondVectorCached+256,false);
+
+  //read mcs number from file and update data
+  unsigned long mcs;
+  const char* pos=buffer.position();
+  if(!MappedFileBuffer::parseInteger(pos,buffer.end(),mcs)){
+    this->getInputStream().setstate(std::ios_base::failbit);
+    std::stringstream errormessage;
+    errormessage<<"ReadMcs<IngredientsType>::execute()\n"
+		<<"Could not read mcs number. Previous mcs number was "<<molecules.getAge();
+    throw std::runtime_error(errormessage.str());
+  }
+  buffer.setPosition(pos);
+  molecules.setAge(mcs);
+
+  nFrames++;
+  if(nFrames%1000 == 0) std::cout<<"Setting age: "<<mcs<<std::endl;
+
+  //the rest of the line must not contain jumps (see FeatureJumps)
+  const char* lineBegin;
+  const char* lineEnd;
+  this->getMappedLine(buffer,lineBegin,lineEnd);
+  for(const char* c=lineBegin;c!=lineEnd;++c)
+  {
+	  if(*c!=' ' && *c!=':')
+	  {
+		  std::stringstream errormessage;
+		  errormessage<<"ReadMcs<IngredientsType>::execute()\n"
+				<<"It seems this is an old bfm-file with jumps.\n"
+				<<"Please use FeatureJumps for read-in backward-functionality.\n"
+				<<"In LeMonADe-files there´re no jumps anymore!\n"
+				<<"Jumps at !mcs: "<<molecules.getAge();
+		  throw std::runtime_error(errormessage.str());
+	  }
+  }
+
+  //go on with the all positions etc.
+  const char* previous=buffer.position();
+  this->getMappedLine(buffer,lineBegin,lineEnd);
+
+  while(lineBegin!=lineEnd && !this->getInputStream().fail()){
+
+	  //if the line contains a bfm Read, stop the procedure and set the get pointer back
+	  if(this->detectRead(lineBegin,lineEnd)){
+		  buffer.setPosition(previous);
+		  this->getInputStream().clear();
+		  return;
+	  }
+
+	  //if the line starts with the solvent keyword, process the compressed solvent format
+	  if(lineEnd-lineBegin>=8 && std::strncmp(lineBegin,"solvent ",8)==0)
+	  {
+		  size_t startMonomerIndex=monomerCount;
+		  uint32_t offset=0;
+		  processSolventPositions(lineBegin+8,lineEnd,offset);
+		  previous=buffer.position();
+		  this->getMappedLine(buffer,lineBegin,lineEnd);
+
+		  //if solvent extends over more than one line, process "sc" lines as well
+		  while(lineEnd-lineBegin>=3 && std::strncmp(lineBegin,"sc ",3)==0)
+		  {
+			  processSolventPositions(lineBegin+3,lineEnd,offset);
+			  previous=buffer.position();
+			  this->getMappedLine(buffer,lineBegin,lineEnd);
+		  }
+		  size_t stopMonomerIndex=monomerCount;
+
+		  //remember which monomers are to be compressed when writing an output file
+		  this->getDestination().setCompressedOutputIndices(startMonomerIndex,stopMonomerIndex-1);
+	  }
+	  else
+	  {
+		  processRegularLine(lineBegin,lineEnd);
+		  previous=buffer.position();
+		  this->getMappedLine(buffer,lineBegin,lineEnd);
+	  }
+  }
+
+  finishFrame();
+}
+
+//! reads coordinates of a connected chain directly from the mapped line [pos,lineEnd)
+template<class IngredientsType>void ReadMcs<IngredientsType>::processRegularLine(const char* pos, const char* lineEnd)
+{
+	typename IngredientsType::molecules_type& molecules = this->getDestination().modifyMolecules();
+	int x,y,z;
+
+	//read first three coordinates
+	if(!MappedFileBuffer::parseInteger(pos,lineEnd,x) ||
+	   !MappedFileBuffer::parseInteger(pos,lineEnd,y) ||
+	   !MappedFileBuffer::parseInteger(pos,lineEnd,z))
+	{
+		std::stringstream errormessage;
+		errormessage<<"ParsingError::ReadMcs<IngredientsType>::execute()\n"
+				<<"Could not read chain initial coordinates in mcs "<<molecules.getAge();
+		throw std::runtime_error(errormessage.str());
+	}
+
+	molecules[monomerCount].setAllCoordinates(x,y,z);
+	++monomerCount;
+
+	//ignore the separating space
+	if(pos!=lineEnd) ++pos;
+
+	//read the ASCII coded bond vectors of this chain
+	for(;pos!=lineEnd && *pos!=0;++pos)
+	{
+		const VectorInt3& bond=getCachedBondVector(static_cast<unsigned char>(*pos));
+		x+=bond.getX();
+		y+=bond.getY();
+		z+=bond.getZ();
+
+		molecules[monomerCount].setAllCoordinates(x,y,z);
+
+		//set up connections at first monte carlo step
+		if ( this->isFirstCall())
+		{
+			molecules.connect(monomerCount-1,monomerCount);
+		}
+
+		++monomerCount;
+	}
+}
+
+//! reads folded coordinates of compressed solvent from the mapped range [pos,lineEnd)
+template<class IngredientsType> void ReadMcs<IngredientsType>::processSolventPositions(const char* pos, const char* lineEnd, uint32_t& offset)
+{
+	typename IngredientsType::molecules_type& molecules = this->getDestination().modifyMolecules();
+	//need these values to turn the linear index in the file back into positions
+	uint32_t boxX=this->getDestination().getBoxX();
+	uint32_t boxY=this->getDestination().getBoxY();
+
+	int32_t distance;
+	while(pos!=lineEnd && *pos!=0)
+	{
+		//distances larger than 94 are written as decimal numbers between spaces
+		if(*pos==' ')
+		{
+			if(!MappedFileBuffer::parseInteger(pos,lineEnd,distance)) break;
+			if(pos!=lineEnd) ++pos;
+		}
+		else
+		{
+			distance=int32_t(static_cast<unsigned char>(*pos))-33;
+			++pos;
+		}
+
+		offset+=distance;
+
+		//transform linear offset index back into 3d coordinates
+		molecules[monomerCount].setAllCoordinates(offset%boxX,int32_t(offset/boxX)%boxY,int32_t(offset/(boxX*boxY)));
+		++monomerCount;
+	}
+}
+
+/**
+ * @details The identifiers are resolved through the bondset only once per
+ * frame, which avoids repeated map look-ups for every monomer.
+ *
+ * @throw <std::runtime_error> if the identifier is not part of the bondset.
+ */
+template<class IngredientsType> const VectorInt3& ReadMcs<IngredientsType>::getCachedBondVector(unsigned char identifier)
+{
+	if(!bondVectorCached[identifier])
+	{
+		bondVectorCache[identifier]=this->getDestination().getBondset().getBondVector(identifier);
+		bondVectorCached[identifier]=true;
+	}
+	return bondVectorCache[identifier];
+}
+
 //! reads coordinates from a line containing a connected chain
 template<class IngredientsType>void ReadMcs<IngredientsType>::processRegularLine(const std::string& line )
 {
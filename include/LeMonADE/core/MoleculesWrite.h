@@ -35,6 +35,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <algorithm>
 
 #include <LeMonADE/io/AbstractWrite.h>
+#include <LeMonADE/io/TextBuffer.h>
 #include <LeMonADE/utility/Vector3D.h>
 
 
@@ -71,6 +72,11 @@ public:
  * @class WriteMcs
  * @brief Handles BFM-File-Write \b !mcs.
  *
+ * @details The frame is formatted into a TextBuffer, which is kept between
+ * the frames, and written to the stream with a single write. Apart from the
+ * first frames, where the buffers grow to their final size, no memory is
+ * allocated.
+ *
  * @tparam IngredientsType Ingredients class storing all system information.
  **/
 template <class IngredientsType>
@@ -82,11 +88,17 @@ public:
 	void writeStream(std::ostream& strm);
 
 private:
-	std::string writeSolventBlock(std::pair<size_t,size_t>) const;
-	std::string compressNumber(int32_t) const;
+	void writeSolventBlock(std::pair<size_t,size_t>);
+	void writeCompressedNumber(int32_t dist, int32_t& lineCount);
+	template<class VectorType>
+	void writePosition(const VectorType& position);
 	int32_t foldBack(int32_t,uint32_t) const;
 	//!maximum length of a line in compressed solvent format
 	static const int32_t maxLineLength=200;
+	//!the frame is formatted in this buffer
+	TextBuffer contents;
+	//!linear indices of the solvent positions, reused for every solvent block
+	std::vector<int32_t> solventPositions;
 };
 
 /*******************Implementation of members  ******************************/
@@ -106,11 +118,12 @@ void WriteMcs<IngredientsType>::writeStream(std::ostream& strm)
 	if(compressedIndices.size()!=0) itCompressedIndices=compressedIndices.begin();
 	else itCompressedIndices=compressedIndices.end();
 
-	//first the mcs is written into this stringstream
-	std::stringstream contents;
+	//the frame is formatted in the buffer first
+	contents.clear();
 
 	//write command and age
-	contents<<"\n!mcs="<< molecules.getAge();
+	contents.append("\n!mcs=");
+	contents.appendInteger(molecules.getAge());
 
 	//write monomers, bonds,solvents
 	for(size_t n=0;n< molecules.size();n++)
@@ -120,7 +133,7 @@ void WriteMcs<IngredientsType>::writeStream(std::ostream& strm)
 		{
 			if(itCompressedIndices->first==n)
 			{
-				contents<<writeSolventBlock(*itCompressedIndices);
+				writeSolventBlock(*itCompressedIndices);
 				n=itCompressedIndices->second+1;
 				itCompressedIndices++;
 				if(n>=molecules.size()) break;
@@ -130,43 +143,35 @@ void WriteMcs<IngredientsType>::writeStream(std::ostream& strm)
 		//write position of next non-solvent
 		if(molecules.getNumLinks(n)==0)
 		{
-			contents<<"\n";
-			contents << molecules[n].getVector3D();
-		}
-		else if(n==0)
-		{
-			contents<<"\n";
-			contents << molecules[n].getVector3D();
-			contents<<" ";
+			contents.append('\n');
+			writePosition(molecules[n]);
 		}
 		//if the actual monomer is a chainstart, start a new subchain in !mcs Read
-		else if (!molecules.areConnected(n,n-1)){
-			contents<<"\n";
-			contents << molecules[n].getVector3D();
-			contents << " ";
+		else if(n==0 || !molecules.areConnected(n,n-1))
+		{
+			contents.append('\n');
+			writePosition(molecules[n]);
+			contents.append(' ');
 		}
 		//otherwise write the bond
 		else
 		{
-			contents<<char(this->getSource().getBondset().getBondIdentifier(
+			contents.append(char(this->getSource().getBondset().getBondIdentifier(
 				(molecules[n].getX())-(molecules[n-1].getX()),
 				(molecules[n].getY())-(molecules[n-1].getY()),
-				(molecules[n].getZ())-(molecules[n-1].getZ()) ) );
-
-			contents.flush();
+				(molecules[n].getZ())-(molecules[n-1].getZ()) ) ));
 		}
 	}
 
-	contents<<"\n\n";
-	contents.flush();
-	strm << contents.str();
+	contents.append("\n\n");
+	contents.writeTo(strm);
 	strm.flush();
 }
 
 /**
- * @brief Returns a string containing compressed solvent coordinates
+ * @brief Appends the compressed solvent coordinates to the output
  * @details Compresses the monomers in the index range given by \a solventIndices
- * into the solvent format and returns the resulting string. The compression works
+ * into the solvent format and appends the result to the frame. The compression works
  * as follows: The coordinates in the box are indexed in a linear fashion as
  * index=foldedZ*boxX*boxY+foldedY*boxX+foldedX
  * where folded(XYZ) are the coordinates of the solvent folded into the box. Then
@@ -205,10 +210,14 @@ void WriteMcs<IngredientsType>::writeStream(std::ostream& strm)
  * lines. In the second of these lines there is a decimal number 1000 with a
  * space before and after, to indicate this is to be read as a decimal distance.
  *
+ * The linear indices are sorted in a vector, which is kept between the frames.
+ * Several solvents on the same position (possible without excluded volume)
+ * appear as repeated indices, which are written as distance 0.
+ *
  * @throw <std::runtime_error> if indices are out of range
  **/
 template<class IngredientsType>
-std::string WriteMcs<IngredientsType>::writeSolventBlock(std::pair<size_t,size_t> solventIndices) const
+void WriteMcs<IngredientsType>::writeSolventBlock(std::pair<size_t,size_t> solventIndices)
 {
 	const typename IngredientsType::molecules_type& molecules(this->getSource().getMolecules());
 	//exception if indices out of range
@@ -224,71 +233,73 @@ std::string WriteMcs<IngredientsType>::writeSolventBlock(std::pair<size_t,size_t
 	uint32_t boxY=this->getSource().getBoxY();
 	uint32_t boxZ=this->getSource().getBoxZ();
 
-	//everything is written in a stringstream for convenience first
-	std::stringstream solventBlock;
-	//now translate all solvent coordinates to integer indices and save them in the map
-	//the map stores how many solvents sit on which position (if there is no
-	//excluded volume interaction, there could be more than one)
-	std::map<int32_t,int32_t> coordinates;
+	//now translate all solvent coordinates to integer indices and sort them
+	solventPositions.clear();
 	for(size_t i=solventIndices.first;i<solventIndices.second+1;i++)
 	{
 		//transform the position of the solvent to a linear index
 		int32_t foldedX=foldBack(molecules[i].getX(),boxX);
 		int32_t foldedY=foldBack(molecules[i].getY(),boxY);
 		int32_t foldedZ=foldBack(molecules[i].getZ(),boxZ);
-		int32_t linIndex=foldedZ*boxX*boxY+foldedY*boxX+foldedX;
-		coordinates[linIndex]+=1;
+		solventPositions.push_back(foldedZ*boxX*boxY+foldedY*boxX+foldedX);
 	}
+	std::sort(solventPositions.begin(),solventPositions.end());
 
 	//write the solvent keyword
-	solventBlock<<"\nsolvent ";
+	contents.append("\nsolvent ");
 
-	 //now write the map
+	//now write the index differences in compressed format
 	int32_t oldIndex=0;
 	int32_t lineCount=0;
-	typedef std::map<int32_t,int32_t>::const_iterator iterator;
-	for(iterator i=coordinates.begin();i!=coordinates.end();i++)
+	for(size_t i=0;i<solventPositions.size();i++)
 	{
-		//write the index difference in compressed format
-		solventBlock<<compressNumber((i->first)-oldIndex);
-		lineCount++;
-		//insert new line if line has become too long
-		if(lineCount>maxLineLength)
-		{
-			solventBlock<<"\n"<<"sc ";
-			lineCount=0;
-		}
-		oldIndex=i->first;
-		//now write a zero if there are more solvents in the same position
-		for(int32_t k=1;k<i->second;k++)
-		{
-			solventBlock<<compressNumber(0);
-			lineCount++;
-			//insert new line if line has become too long
-			if(lineCount>maxLineLength)
-			{
-				solventBlock<<"\n"<<"sc ";
-				lineCount=0;
-			}
-		}
-
+		writeCompressedNumber(solventPositions[i]-oldIndex,lineCount);
+		oldIndex=solventPositions[i];
 	}
-	return solventBlock.str();
 }
 
 /***********************************************************************/
-//!compresses an integer number to char(number+33) for number<95, otherwise the decimal representation is kept
+/**
+ * @details Writes char(dist+33) for dist<95, otherwise the decimal representation
+ * surrounded by spaces. A new line starting with "sc " is inserted if the line
+ * has become too long.
+ *
+ * @param dist distance between adjacent solvent indices
+ * @param lineCount number of distances written into the current line
+ **/
 template<class IngredientsType>
-std::string WriteMcs<IngredientsType>::compressNumber(int32_t dist) const
+void WriteMcs<IngredientsType>::writeCompressedNumber(int32_t dist, int32_t& lineCount)
 {
-	std::stringstream compressedNumber;
 	int32_t maxSingleDistance=94; //128-33-1
 	if(dist<=maxSingleDistance)
-		compressedNumber<<char(dist+33); //offset of 33 for zero distance
+		contents.append(char(dist+33)); //offset of 33 for zero distance
 	else
-		compressedNumber<<char(32)<<dist<<char(32); //ASCII 32=space
+	{
+		contents.append(char(32)); //ASCII 32=space
+		contents.appendInteger(dist);
+		contents.append(char(32));
+	}
+
+	lineCount++;
+	//insert new line if line has become too long
+	if(lineCount>maxLineLength)
+	{
+		contents.append("\nsc ");
+		lineCount=0;
+	}
+}
 
-	return compressedNumber.str();
+/***********************************************************************/
+//!writes the coordinates separated by spaces, like operator<< of Vector3D
+template<class IngredientsType>
+template<class VectorType>
+void WriteMcs<IngredientsType>::writePosition(const VectorType& position)
+{
+	contents.appendInteger(position.getX());
+	contents.append(' ');
+	contents.appendInteger(position.getY());
+	contents.append(' ');
+	contents.appendInteger(position.getZ());
 }
 
 /***********************************************************************/
@@ -91,6 +91,18 @@ public:
   //! Export the relevant functionality for writing bfm-files to the responsible writer object
   template < class FileWrite > void exportWrite( FileWrite& ) const {}
 
+  //! Stores the complete internal state of the feature in a binary checkpoint (see CheckpointWriter)
+  template < class CheckpointWriter > void saveCheckpoint( CheckpointWriter& ) const {}
+
+  //! Restores the internal state of the feature from a binary checkpoint written by saveCheckpoint
+  template < class CheckpointReader > void loadCheckpoint( CheckpointReader& ) {}
+
+  //! End of the recursion collecting the move statistics in FeatureHolder
+  template < class Container > void collectFeatureStatistics( Container& ) const {}
+
+  //! End of the recursion resetting the move statistics in FeatureHolder
+  void resetFeatureStatistics() {}
+
 
   /**
    * @brief Check for all Move. Does Nothing - Return True for all implementations.
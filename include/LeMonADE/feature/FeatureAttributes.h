@@ -85,6 +85,36 @@ public:
   ReadAttributes(IngredientsType& i):ReadToDestination<IngredientsType>(i){}
   virtual ~ReadAttributes(){}
   virtual void execute();
+
+private:
+  //! Zero-copy implementation of execute() for memory mapped input
+  void executeMapped(MappedFileBuffer& buffer);
+
+  //! Decodes an integer attribute directly from the mapped file
+  static bool parseAttribute(const char*& pos, const char* end, int32_t& attribute)
+  {
+    return MappedFileBuffer::parseInteger(pos,end,attribute);
+  }
+
+  //! Decodes any other attribute type with its stream operator
+  template<class AttributeType>
+  static bool parseAttribute(const char*& pos, const char* end, AttributeType& attribute)
+  {
+    std::stringstream stream(std::string(pos,end));
+    stream>>attribute;
+    return !stream.fail();
+  }
+
+  //! Skips blanks and the separator character, returns false if the separator is missing
+  static bool findMappedSeparator(const char*& pos, const char* end, char separator)
+  {
+    while(pos!=end && *pos==' ') ++pos;
+    if(pos!=end && *pos==separator){
+      ++pos;
+      return true;
+    }
+    return false;
+  }
 };
 
 
@@ -203,6 +233,13 @@ template < class IngredientsType, class TagType >
 // template <class TagType >
 void ReadAttributes<IngredientsType,TagType>::execute()
 {
+  //decode memory mapped input directly
+  MappedFileBuffer* mappedBuffer=this->getMappedBuffer();
+  if(mappedBuffer!=0){
+    executeMapped(*mappedBuffer);
+    return;
+  }
+
   //some variables used during reading
   //counts the number of attribute lines in the file
   int nAttributes=0;
@@ -306,6 +343,85 @@ void ReadAttributes<IngredientsType,TagType>::execute()
 }
 
 
+/**
+ * @brief Reads \b !attributes directly from the memory mapped file.
+ *
+ * @throw <std::runtime_error> attributes and identifier could not be read.
+ **/
+template < class IngredientsType, class TagType >
+void ReadAttributes<IngredientsType,TagType>::executeMapped(MappedFileBuffer& buffer)
+{
+  int nAttributes=0;
+  int startIndex,stopIndex;
+  TagType attribute;
+  const char* lineBegin;
+  const char* lineEnd;
+  typename IngredientsType::molecules_type& molecules=this->getDestination().modifyMolecules();
+
+  //go to next line and save the position of the get pointer
+  this->getMappedLine(buffer,lineBegin,lineEnd);
+  const char* previous=buffer.position();
+
+  this->getMappedLine(buffer,lineBegin,lineEnd);
+
+  while(lineBegin!=lineEnd && !this->getInputStream().fail()){
+
+    //stop at next Read and set the get-pointer to the position before the Read
+    if(this->detectRead(lineBegin,lineEnd)){
+      buffer.setPosition(previous);
+      this->getInputStream().clear();
+      break;
+    }
+
+    const char* pos=lineBegin;
+    if(!MappedFileBuffer::parseInteger(pos,lineEnd,startIndex)){
+      std::stringstream messagestream;
+      messagestream<<"ReadAttributes<IngredientsType>::execute()\n"
+		   <<"Could not read first index in attributes line "<<nAttributes+1;
+      throw std::runtime_error(messagestream.str());
+    }
+
+    if(!findMappedSeparator(pos,lineEnd,'-')){
+      std::stringstream messagestream;
+      messagestream<<"ReadAttributes<IngredientsType>::execute()\n"
+		   <<"Wrong definition of attributes\nCould not find separator \"-\" "
+		   <<"in attribute definition no "<<nAttributes+1;
+      throw std::runtime_error(messagestream.str());
+    }
+
+    if(!MappedFileBuffer::parseInteger(pos,lineEnd,stopIndex)){
+      std::stringstream messagestream;
+      messagestream<<"ReadAttributes<IngredientsType>::execute()\n"
+		   <<"Could not read second index in attributes line "<<nAttributes+1;
+      throw std::runtime_error(messagestream.str());
+    }
+
+    if(!findMappedSeparator(pos,lineEnd,':')){
+      std::stringstream messagestream;
+      messagestream<<"ReadAttributes<IngredientsType>::execute()\n"
+		   <<"Wrong definition of attributes\nCould not find separator \":\" "
+		   <<"in attribute definition no "<<nAttributes+1;
+      throw std::runtime_error(messagestream.str());
+    }
+
+    if(!parseAttribute(pos,lineEnd,attribute)){
+      std::stringstream messagestream;
+      messagestream<<"ReadAttributes<IngredientsType>::execute()\n"
+		   <<"could not read attribute in attribute definition no "<<nAttributes+1;
+      throw std::runtime_error(messagestream.str());
+    }
+
+    //use n-1 as index, because bfm-files start counting indices at 1 (not 0)
+    for(int n=startIndex;n<=stopIndex;n++)
+      molecules[n-1].setAttributeTag(attribute);
+
+    nAttributes++;
+    previous=buffer.position();
+    this->getMappedLine(buffer,lineBegin,lineEnd);
+  }
+}
+
+
 //! Executes the routine to write \b !attributes.
 template < class IngredientsType, class TagType>
 void WriteAttributes<IngredientsType,TagType>::writeStream(std::ostream& strm)
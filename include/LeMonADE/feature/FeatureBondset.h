@@ -41,6 +41,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/updater/moves/MoveBase.h>
 #include <LeMonADE/updater/moves/MoveLocalBase.h>
 #include <LeMonADE/updater/moves/MoveConnectBase.h>
+#include <LeMonADE/updater/moves/MoveReptationBase.h>
 
 
 
@@ -144,6 +145,55 @@ class FeatureBondset : public Feature
     fileWriter.registerWrite("!set_of_bondvectors", new WriteBondset<FeatureBondset>(*this));
   }
 
+  /**
+   * @brief Stores the set of bond-vectors in a binary checkpoint
+   *
+   * @param checkpoint Writer of the checkpoint file
+   */
+  template <class CheckpointWriter>
+  void saveCheckpoint(CheckpointWriter& checkpoint) const
+  {
+    checkpoint.beginSection("FeatureBondset");
+    checkpoint.write(uint64_t(bondset.size()));
+    for(typename BondSetType::iterator it=bondset.begin();it!=bondset.end();++it)
+    {
+      checkpoint.write(it->first);
+      checkpoint.write(it->second.getX());
+      checkpoint.write(it->second.getY());
+      checkpoint.write(it->second.getZ());
+    }
+    checkpoint.write(bondset.isLookupSynchronized());
+  }
+
+  /**
+   * @brief Restores the set of bond-vectors from a binary checkpoint
+   *
+   * @details The look-up table is rebuilt from the bond-vectors, if it was
+   * synchronized when the checkpoint was written.
+   *
+   * @param checkpoint Reader of the checkpoint file
+   */
+  template <class CheckpointReader>
+  void loadCheckpoint(CheckpointReader& checkpoint)
+  {
+    checkpoint.beginSection("FeatureBondset");
+    bondset.clear();
+    uint64_t nBonds;
+    checkpoint.read(nBonds);
+    for(uint64_t n=0;n<nBonds;n++)
+    {
+      int32_t identifier,x,y,z;
+      checkpoint.read(identifier);
+      checkpoint.read(x);
+      checkpoint.read(y);
+      checkpoint.read(z);
+      bondset.addBond(x,y,z,identifier);
+    }
+    bool synchronized;
+    checkpoint.read(synchronized);
+    if(synchronized) bondset.updateLookupTable();
+  }
+
   /**
    * @brief Check move for all unknown moves: this does nothing
    *
@@ -208,6 +258,22 @@ class FeatureBondset : public Feature
 
           return true;
   }
+  /**
+   * @brief Overloaded for MoveReptationBase. See MoveReptationSc
+   *
+   * @details Checks if the new bond between the moved end monomer and the other chain end is valid.
+   * Returns if move is allowed (\a true ) or rejected (\a false ).
+   *
+   * @param [in] ingredients A reference to the IngredientsType - mainly the system.
+   * @param [in] move A reference to ReptationMoveType.
+   * @return if move is allowed (true) or rejected (false).
+   */
+  template<class IngredientsType,class ReptationMoveType>
+  bool checkMove(const IngredientsType& ingredients, const MoveReptationBase<ReptationMoveType>& move) const
+  {
+	  return bondset.isValidStrongCheck(move.getBondVector());
+  }
+
   /**
    * @brief Updates the bond-set lookup table if necessary
    *
@@ -45,6 +45,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/updater/moves/MoveAddMonomerBase.h>
 #include <LeMonADE/updater/moves/MoveConnectBase.h>
 #include <LeMonADE/updater/moves/MoveConnectSc.h>
+#include <LeMonADE/updater/moves/MoveReptationBase.h>
 
 /*****************************************************************/
 /**
@@ -246,6 +247,24 @@ public:
 	fileWriter.registerWrite("!periodic_z",new WritePeriodicZ<FeatureBox>(*this));
 	}
 
+	//! Stores box size and periodicity in a binary checkpoint
+	template <class CheckpointWriter>
+	void saveCheckpoint(CheckpointWriter& checkpoint) const {
+	checkpoint.beginSection("FeatureBox");
+	checkpoint.write(boxX); checkpoint.write(boxY); checkpoint.write(boxZ);
+	checkpoint.write(periodicX); checkpoint.write(periodicY); checkpoint.write(periodicZ);
+	checkpoint.write(periodicInitX); checkpoint.write(periodicInitY); checkpoint.write(periodicInitZ);
+	}
+
+	//! Restores box size and periodicity from a binary checkpoint
+	template <class CheckpointReader>
+	void loadCheckpoint(CheckpointReader& checkpoint) {
+	checkpoint.beginSection("FeatureBox");
+	checkpoint.read(boxX); checkpoint.read(boxY); checkpoint.read(boxZ);
+	checkpoint.read(periodicX); checkpoint.read(periodicY); checkpoint.read(periodicZ);
+	checkpoint.read(periodicInitX); checkpoint.read(periodicInitY); checkpoint.read(periodicInitZ);
+	}
+
 	/**
 	 * @brief For all unknown moves: this does nothing
 	 *
@@ -356,6 +375,31 @@ public:
 
 	}
 
+	/**
+	 * @brief Overloaded for MoveReptationBase (MoveReptationSc)
+	 *
+	 * @details Returns true if the new position of the moved end monomer doesn´t violate the p.b.c.
+	 * In non-periodic directions the new position must lie within the box as for MoveLocalBase.
+	 *
+	 * @param [in] ingredients A reference to the IngredientsType - mainly the system
+	 * @param [in] move Move of type MoveReptationSc
+	 * @return True if move is allowed with p.b.c. or rejected (false).
+	 */
+	template<class IngredientsType,class ReptationMoveType>
+	bool checkMove(const IngredientsType& ingredients, const MoveReptationBase<ReptationMoveType>& move) const
+	{
+		VectorInt3 pos=move.getPosition();
+
+		if(	(periodicX || (pos.getX()<(getBoxX()-1) && pos.getX()>=0) ) &&
+			(periodicY || (pos.getY()<(getBoxY()-1) && pos.getY()>=0) ) &&
+			(periodicZ || (pos.getZ()<(getBoxZ()-1) && pos.getZ()>=0) )
+		)
+			return true;
+		else
+			return false;
+
+	}
+
 
 private:
 
@@ -0,0 +1,511 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_FEATURE_FEATURECLUSTERTRACKING_H
+#define LEMONADE_FEATURE_FEATURECLUSTERTRACKING_H
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <LeMonADE/feature/Feature.h>
+#include <LeMonADE/feature/FeatureBox.h>
+#include <LeMonADE/updater/moves/MoveBase.h>
+#include <LeMonADE/updater/moves/MoveAddMonomerBase.h>
+#include <LeMonADE/updater/moves/MoveConnectBase.h>
+#include <LeMonADE/updater/moves/MoveDisconnectBase.h>
+#include <LeMonADE/utility/DistanceCalculation.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+/*****************************************************************************/
+/**
+ * @file
+ *
+ * @class FeatureClusterTracking
+ *
+ * @brief Keeps track of the clusters (connected molecules) during network formation
+ *
+ * @details The clusters are stored in a union-find structure (union by size
+ * and path compression), which is updated whenever a bond is created by a
+ * connection move (MoveConnectBase, e.g. MoveConnectSc in UpdaterSimpleConnection)
+ * and extended by monomers added with MoveAddMonomerBase. Every bond costs
+ * O(alpha(N)), i.e. quasi constant time, such that the cluster statistics
+ * are available at any time without traversing the graph.
+ *
+ * The feature reports the moments of the cluster size distribution
+ * M_k=sum_clusters size^k (k=0...3), the largest cluster and the weight
+ * average cluster size M_2/M_1, also without the largest cluster (sol).
+ *
+ * Percolation is detected across the periodic images: every monomer stores
+ * the periodic image of its cluster root it is connected to. A bond between
+ * two monomers of the same cluster closes a loop; if the loop spans a
+ * non-zero number of periodic images, the cluster is infinite (percolating)
+ * in the corresponding directions. The bond vectors are taken with the
+ * minimum image convention, thus folded and unfolded positions are both
+ * handled. Note that FeatureBondset rejects connections between unfolded
+ * positions in different periodic images.
+ *
+ * A union-find structure cannot split clusters. A bond broken by a move
+ * derived from MoveDisconnectBase therefore only marks the clusters as
+ * outdated in O(1). The clusters are rebuilt from the graph in O(N alpha(N))
+ * by the next call of one of the getters (or synchronize()), such that any
+ * number of broken and new bonds between two queries costs a single rebuild.
+ * Bonds created or removed in other ways (e.g. directly by Molecules::connect())
+ * are taken into account by synchronize(), which does the same rebuild.
+ **/
+/*****************************************************************************/
+class FeatureClusterTracking : public Feature
+{
+public:
+	//! The box size and periodicity are needed for the percolation check
+	typedef LOKI_TYPELIST_1(FeatureBox) required_features_front;
+
+	FeatureClusterTracking():largestRoot(0),largestSize(0),sumSize0(0),sumSize2(0),sumSize3(0.0),percolationDirections(0),nBonds(0)
+	,outdated(false),outdatedSource(0),outdatedRebuild(0){}
+
+	//! Copies are taken from the rebuilt clusters, because the copy belongs to another system
+	FeatureClusterTracking(const FeatureClusterTracking& other):Feature(other){assign(other);}
+
+	//! See copy constructor
+	FeatureClusterTracking& operator=(const FeatureClusterTracking& other){if(this!=&other) assign(other); return *this;}
+
+	//! check move for all moves - always true
+	template<class IngredientsType>
+	bool checkMove(const IngredientsType& ingredients, const MoveBase& move) const {return true;}
+
+	//! apply move for all other moves - does nothing
+	template<class IngredientsType>
+	void applyMove(IngredientsType& ing, const MoveBase& move){}
+
+	//! joins the clusters of the two monomers connected by the move
+	template<class IngredientsType, class SpecializedMove>
+	void applyMove(IngredientsType& ing, const MoveConnectBase<SpecializedMove>& move);
+
+	//! marks the clusters as outdated after a bond was broken, they are rebuilt on the next query
+	template<class IngredientsType, class SpecializedMove>
+	void applyMove(IngredientsType& ing, const MoveDisconnectBase<SpecializedMove>& move);
+
+	//! adds the new monomer as cluster of size one
+	template<class IngredientsType, class SpecializedMove, class TagType>
+	void applyMove(IngredientsType& ing, const MoveAddMonomerBase<SpecializedMove,TagType>& move);
+
+	//! Rebuilds the clusters from all bonds of the system
+	template<class IngredientsType>
+	void synchronize(IngredientsType& ingredients);
+
+	//! Returns the index of the cluster root of a monomer. Two monomers are in the same cluster if the roots are equal.
+	uint32_t getClusterRoot(uint32_t monomer) const {update(); VectorInt3 shift; return findRoot(monomer,shift);}
+
+	//! Returns the size of the cluster of a monomer
+	uint32_t getClusterSize(uint32_t monomer) const {return nodes[getClusterRoot(monomer)].size;}
+
+	//! Number of clusters (including single monomers)
+	uint64_t getNumberOfClusters() const {update(); return sumSize0;}
+
+	//! Number of tracked monomers
+	uint64_t getNumberOfMonomers() const {update(); return nodes.size();}
+
+	//! Number of tracked bonds
+	uint64_t getNumberOfBonds() const {update(); return nBonds;}
+
+	//! Moment M_k=sum_clusters size^k of the cluster size distribution, k=0...3
+	double getClusterSizeMoment(uint32_t k) const;
+
+	//! Size of the largest cluster
+	uint32_t getLargestClusterSize() const {update(); return largestSize;}
+
+	//! Root of the largest cluster, see getClusterRoot()
+	uint32_t getLargestClusterRoot() const {update(); return largestRoot;}
+
+	//! Weight average cluster size M_2/M_1
+	double getWeightAverageClusterSize() const;
+
+	//! Weight average cluster size without the largest cluster
+	double getWeightAverageSolClusterSize() const;
+
+	/**
+	 * @brief Directions in which a cluster is percolating
+	 * @return bit mask: bit 0 for x, bit 1 for y, bit 2 for z
+	 */
+	uint8_t getPercolationDirections(uint32_t monomer) const {return nodes[getClusterRoot(monomer)].percolation;}
+
+	//! Directions in which any cluster percolates, see getPercolationDirections(uint32_t)
+	uint8_t getPercolationDirections() const {update(); return percolationDirections;}
+
+	//! True if any cluster is infinite in at least one direction
+	bool isPercolating() const {return getPercolationDirections()!=0;}
+
+	//! Store the clusters in a binary checkpoint
+	template<class CheckpointWriter>
+	void saveCheckpoint(CheckpointWriter& checkpoint) const
+	{
+		update();
+		checkpoint.beginSection("FeatureClusterTracking");
+		checkpoint.writeVector(nodes);
+		checkpoint.write(largestRoot);
+		checkpoint.write(largestSize);
+		checkpoint.write(sumSize0);
+		checkpoint.write(sumSize2);
+		checkpoint.write(sumSize3);
+		checkpoint.write(percolationDirections);
+		checkpoint.write(nBonds);
+		checkpoint.write(box);
+	}
+
+	//! Restore the clusters from a binary checkpoint
+	template<class CheckpointReader>
+	void loadCheckpoint(CheckpointReader& checkpoint)
+	{
+		checkpoint.beginSection("FeatureClusterTracking");
+		checkpoint.readVector(nodes);
+		checkpoint.read(largestRoot);
+		checkpoint.read(largestSize);
+		checkpoint.read(sumSize0);
+		checkpoint.read(sumSize2);
+		checkpoint.read(sumSize3);
+		checkpoint.read(percolationDirections);
+		checkpoint.read(nBonds);
+		checkpoint.read(box);
+		outdated=false;
+	}
+
+protected:
+	//! Rebuilds the clusters from all bonds of the system
+	template<class IngredientsType>
+	void rebuild(const IngredientsType& ingredients);
+
+	//! Joins the clusters of monomers a and b connected by a new bond
+	template<class MoleculesType>
+	void link(const MoleculesType& molecules, uint32_t a, uint32_t b);
+
+	//! Adds monomers as single clusters until n monomers are tracked
+	void addSingleMonomers(size_t n);
+
+	//! Rebuilds the clusters if bonds were broken since the last rebuild
+	void update() const
+	{
+		//the clusters are a cache of the graph, so rebuilding does not change the logical state
+		if(outdated) outdatedRebuild(const_cast<FeatureClusterTracking&>(*this),outdatedSource);
+	}
+
+	//! Calls rebuild() for the system of type IngredientsType stored as untyped pointer
+	template<class IngredientsType>
+	static void rebuildFrom(FeatureClusterTracking& feature, const void* ingredients)
+	{
+		feature.rebuild(*static_cast<const IngredientsType*>(ingredients));
+	}
+
+	//! Copies the rebuilt state of other
+	void assign(const FeatureClusterTracking& other);
+
+private:
+	//! Entry of the union-find structure for every monomer
+	struct Node
+	{
+		//! parent in the tree, the root is its own parent
+		uint32_t parent;
+		//! number of monomers in the cluster, only valid for roots
+		uint32_t size;
+		//! periodic image of the parent, in which the monomer is connected to it
+		int32_t shift[3];
+		//! directions in which the cluster percolates, only valid for roots
+		uint8_t percolation;
+	};
+
+	//! Returns the root of a monomer and its image relative to the root, compressing the path
+	uint32_t findRoot(uint32_t monomer, VectorInt3& shift) const;
+
+	//! union-find structure, mutable for path compression
+	mutable std::vector<Node> nodes;
+	uint32_t largestRoot;
+	uint32_t largestSize;
+	//! moments of the cluster size distribution, M_1 is the number of monomers
+	uint64_t sumSize0;
+	uint64_t sumSize2;
+	double sumSize3;
+	//! directions in which any cluster percolates
+	uint8_t percolationDirections;
+	uint64_t nBonds;
+	//! minimum image convention used for the bond vectors
+	Lemonade::MinImageBox box;
+	//! true if bonds were broken since the last rebuild
+	bool outdated;
+	//! system and matching instantiation of rebuild() used by update()
+	const void* outdatedSource;
+	void (*outdatedRebuild)(FeatureClusterTracking&, const void*);
+};
+
+/******************************************************************************/
+//member implementations
+/******************************************************************************/
+
+/**
+ * @details The bond is already inserted by the move, see MoveConnectSc::apply().
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @param move connection move between move.getIndex() and move.getPartner()
+ */
+template<class IngredientsType, class SpecializedMove>
+void FeatureClusterTracking::applyMove(IngredientsType& ing, const MoveConnectBase<SpecializedMove>& move)
+{
+	//outdated clusters are rebuilt including the new bond
+	if(outdated) return;
+	const typename IngredientsType::molecules_type& molecules=ing.getMolecules();
+	addSingleMonomers(molecules.size());
+	link(molecules,move.getIndex(),move.getPartner());
+}
+
+/**
+ * @details The bond is already removed by the move, see MoveDisconnectSc::apply().
+ * Only the system is stored, the rebuild is done by update() on the next query.
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @param move move breaking the bond between move.getIndex() and move.getPartner()
+ */
+template<class IngredientsType, class SpecializedMove>
+void FeatureClusterTracking::applyMove(IngredientsType& ing, const MoveDisconnectBase<SpecializedMove>& move)
+{
+	outdated=true;
+	outdatedSource=&ing;
+	outdatedRebuild=&rebuildFrom<IngredientsType>;
+}
+
+/**
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @param move the move adding the monomer
+ */
+template<class IngredientsType, class SpecializedMove, class TagType>
+void FeatureClusterTracking::applyMove(IngredientsType& ing, const MoveAddMonomerBase<SpecializedMove,TagType>& move)
+{
+	if(outdated) return;
+	addSingleMonomers(ing.getMolecules().size());
+}
+
+/**
+ * @param ingredients A reference to the IngredientsType - mainly the system.
+ */
+template<class IngredientsType>
+void FeatureClusterTracking::synchronize(IngredientsType& ingredients)
+{
+	std::cout<<"FeatureClusterTracking::synchronizing clusters...";
+	box=Lemonade::MinImageBox(ingredients);
+	rebuild(ingredients);
+	std::cout<<"done: "<<sumSize0<<" clusters, largest "<<largestSize<<std::endl;
+}
+
+/**
+ * @param ingredients A reference to the IngredientsType - mainly the system.
+ */
+template<class IngredientsType>
+void FeatureClusterTracking::rebuild(const IngredientsType& ingredients)
+{
+	outdated=false;
+	nodes.clear();
+	largestRoot=0;
+	largestSize=0;
+	sumSize0=0;
+	sumSize2=0;
+	sumSize3=0.0;
+	percolationDirections=0;
+	nBonds=0;
+
+	const typename IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+	addSingleMonomers(molecules.size());
+	for(uint32_t n=0;n<molecules.size();n++)
+		for(uint32_t k=0;k<molecules.getNumLinks(n);k++)
+		{
+			uint32_t partner=molecules.getNeighborIdx(n,k);
+			if(partner>n) link(molecules,n,partner);
+		}
+}
+
+/**
+ * @details The image of b relative to a is the minimum image bond vector
+ * minus the difference of their positions in units of the box size.
+ * Within one cluster the images relative to the root have to differ by
+ * exactly this vector, otherwise the bond closes a loop around the periodic
+ * box.
+ */
+template<class MoleculesType>
+void FeatureClusterTracking::link(const MoleculesType& molecules, uint32_t a, uint32_t b)
+{
+	nBonds++;
+	VectorInt3 difference(molecules[b].getVector3D()-molecules[a].getVector3D());
+	VectorInt3 image;
+	for(size_t d=0;d<3;d++)
+		image[d]=box.isPeriodic(d)?(box.component(d,difference[d])-difference[d])/int32_t(box.getBox(d)):0;
+
+	VectorInt3 shiftA,shiftB;
+	uint32_t rootA=findRoot(a,shiftA);
+	uint32_t rootB=findRoot(b,shiftB);
+
+	if(rootA==rootB)
+	{
+		VectorInt3 loop(shiftB-shiftA-image);
+		for(size_t d=0;d<3;d++)
+			if(loop[d]!=0) nodes[rootA].percolation|=uint8_t(1u<<d);
+		percolationDirections|=nodes[rootA].percolation;
+		return;
+	}
+
+	//union by size: attach the smaller cluster
+	if(nodes[rootA].size<nodes[rootB].size)
+	{
+		std::swap(rootA,rootB);
+		std::swap(shiftA,shiftB);
+		image=VectorInt3(0,0,0)-image;
+	}
+
+	uint64_t sizeA=nodes[rootA].size, sizeB=nodes[rootB].size;
+	VectorInt3 rootShift(shiftA+image-shiftB);
+	Node& attached=nodes[rootB];
+	attached.parent=rootA;
+	for(size_t d=0;d<3;d++) attached.shift[d]=rootShift[d];
+	nodes[rootA].size=uint32_t(sizeA+sizeB);
+	nodes[rootA].percolation|=attached.percolation;
+
+	sumSize0--;
+	sumSize2+=2*sizeA*sizeB;
+	sumSize3+=3.0*double(sizeA)*double(sizeB)*double(sizeA+sizeB);
+	if(sizeA+sizeB>=largestSize)
+	{
+		largestSize=uint32_t(sizeA+sizeB);
+		largestRoot=rootA;
+	}
+}
+
+/**
+ * @details Two passes: first the root and the image relative to it are
+ * determined, then every node on the path is attached directly to the root.
+ */
+inline uint32_t FeatureClusterTracking::findRoot(uint32_t monomer, VectorInt3& shift) const
+{
+	uint32_t root=monomer;
+	shift.setAllCoordinates(0,0,0);
+	while(nodes[root].parent!=root)
+	{
+		const Node& node=nodes[root];
+		shift+=VectorInt3(node.shift[0],node.shift[1],node.shift[2]);
+		root=node.parent;
+	}
+
+	VectorInt3 remaining(shift);
+	uint32_t current=monomer;
+	while(nodes[current].parent!=root && current!=root)
+	{
+		Node& node=nodes[current];
+		uint32_t next=node.parent;
+		VectorInt3 oldShift(node.shift[0],node.shift[1],node.shift[2]);
+		node.parent=root;
+		for(size_t d=0;d<3;d++) node.shift[d]=remaining[d];
+		remaining-=oldShift;
+		current=next;
+	}
+	return root;
+}
+
+inline void FeatureClusterTracking::addSingleMonomers(size_t n)
+{
+	Node single;
+	single.size=1;
+	single.shift[0]=single.shift[1]=single.shift[2]=0;
+	single.percolation=0;
+	while(nodes.size()<n)
+	{
+		single.parent=uint32_t(nodes.size());
+		nodes.push_back(single);
+		sumSize0++;
+		sumSize2++;
+		sumSize3+=1.0;
+		if(largestSize==0)
+		{
+			largestSize=1;
+			largestRoot=single.parent;
+		}
+	}
+}
+
+/**
+ * @param k order of the moment, 0 to 3
+ * @throw std::runtime_error for other orders
+ */
+inline double FeatureClusterTracking::getClusterSizeMoment(uint32_t k) const
+{
+	update();
+	switch(k)
+	{
+		case 0: return double(sumSize0);
+		case 1: return double(nodes.size());
+		case 2: return double(sumSize2);
+		case 3: return sumSize3;
+		default:
+		{
+			std::stringstream errormessage;
+			errormessage<<"FeatureClusterTracking::getClusterSizeMoment(): moment "<<k<<" is not tracked";
+			throw std::runtime_error(errormessage.str());
+		}
+	}
+}
+
+inline double FeatureClusterTracking::getWeightAverageClusterSize() const
+{
+	update();
+	return nodes.empty()?0.0:double(sumSize2)/double(nodes.size());
+}
+
+inline double FeatureClusterTracking::getWeightAverageSolClusterSize() const
+{
+	update();
+	uint64_t sol=nodes.size()-largestSize;
+	if(sol==0) return 0.0;
+	return double(sumSize2-uint64_t(largestSize)*largestSize)/double(sol);
+}
+
+/**
+ * @details Outdated clusters of other are rebuilt first, because the stored
+ * system of other must not be used by the copy.
+ */
+inline void FeatureClusterTracking::assign(const FeatureClusterTracking& other)
+{
+	other.update();
+	nodes=other.nodes;
+	largestRoot=other.largestRoot;
+	largestSize=other.largestSize;
+	sumSize0=other.sumSize0;
+	sumSize2=other.sumSize2;
+	sumSize3=other.sumSize3;
+	percolationDirections=other.percolationDirections;
+	nBonds=other.nBonds;
+	box=other.box;
+	outdated=false;
+	outdatedSource=0;
+	outdatedRebuild=0;
+}
+
+#endif /* LEMONADE_FEATURE_FEATURECLUSTERTRACKING_H */
@@ -28,17 +28,21 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef LEMONADE_FEATURE_FEATURECONNECTIONSC_H
 #define LEMONADE_FEATURE_FEATURECONNECTIONSC_H
 
+#include <vector>
+
 #include <LeMonADE/feature/Feature.h>
 #include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
 #include <LeMonADE/feature/FeatureLatticePowerOfTwo.h>
 #include <LeMonADE/updater/moves/MoveBase.h>
 #include <LeMonADE/updater/moves/MoveConnectBase.h>
 #include <LeMonADE/updater/moves/MoveConnectSc.h>
+#include <LeMonADE/updater/moves/MoveDisconnectBase.h>
 #include <LeMonADE/updater/moves/MoveLocalBcc.h>
 #include <LeMonADE/updater/moves/MoveLocalSc.h>
 #include <LeMonADE/updater/moves/MoveLocalScDiag.h>
 #include <LeMonADE/updater/moves/MoveAddMonomerBcc.h>
 #include <LeMonADE/updater/moves/MoveAddMonomerSc.h>
+#include <LeMonADE/updater/moves/MoveReptationSc.h>
 #include <LeMonADE/utility/Lattice.h>
 #include <LeMonADE/io/AbstractRead.h>
 #include <LeMonADE/io/AbstractWrite.h>
@@ -191,6 +195,20 @@ public:
  *
  * @details Works only in combination with an excluded volume feature
  *
+ * Besides the lattice of unsaturated reactive monomers, the feature keeps an
+ * index of these monomers in a flat list, which is updated together with the
+ * lattice (synchronize, connection and add-monomer moves). Updaters can draw
+ * reaction attempts from this list instead of from all monomers, see
+ * UpdaterSimpleConnection::setConnectionMode().
+ *
+ * Bonds between two reactive monomers can be broken again by moves derived
+ * from MoveDisconnectBase (e.g. MoveDisconnectSc). The monomers become
+ * unsaturated again and return to the lattice and the index.
+ *
+ * Reptation moves (MoveReptationSc) move the lattice entry of the chain end
+ * and update the saturation of its old and new neighbor. MoveReptationSc::linearize()
+ * changes the indices of the monomers and synchronizes the system afterwards.
+ *
  * @tparam 
  * */
 
@@ -249,6 +267,10 @@ public:
 	template<class IngredientsType, class SpecializedMove> 
 	bool checkMove(const IngredientsType& ingredients, const MoveConnectBase<SpecializedMove>& move) const;
 
+	//! check disconnect move: only bonds between two reactive monomers can be broken
+	template<class IngredientsType, class SpecializedMove> 
+	bool checkMove(const IngredientsType& ingredients, const MoveDisconnectBase<SpecializedMove>& move) const;
+
 	//! check bas connect move - always true 
 	template<class IngredientsType>
 	bool checkMove(const IngredientsType& ingredients, const MoveLocalSc& move) const {return true;};
@@ -277,6 +299,10 @@ public:
 	//!apply move for the scBFM connection move for connection
 	template<class IngredientsType, class SpecializedMove> 
 	void applyMove(IngredientsType& ing, const MoveConnectBase<SpecializedMove>& move);
+
+	//! puts the monomers of a broken bond back on the lattice and into the index
+	template<class IngredientsType, class SpecializedMove>
+	void applyMove(IngredientsType& ing, const MoveDisconnectBase<SpecializedMove>& move);
 	
 	//!apply move for the scBFM local move which changes the lattice
 	template<class IngredientsType>
@@ -289,6 +315,10 @@ public:
 	//!
 	template<class IngredientsType, class TagType>
 	void applyMove(IngredientsType& ing, const MoveAddMonomerSc<TagType>& move);	
+
+	//! apply function for sc reptation moves
+	template<class IngredientsType>
+	void applyMove(IngredientsType& ing, const MoveReptationSc& move);
 	
 	//! Synchronize with system: Fill the lattice with 1 (occupied) and 0 (free).
 	template<class IngredientsType>
@@ -304,16 +334,54 @@ public:
 	//! return uint32_t(-1)=4294967295 if place is empty
 	uint32_t getIdFromLattice(const int x, const int y, const int z) const { return connectionLattice.getLatticeEntry(x,y,z)-1;};
 
+	//! Number of reactive monomers with less than their maximum number of bonds
+	uint32_t getNumUnsaturatedReactiveMonomers() const {return uint32_t(unsaturatedMonomers.size());}
+
+	//! Index of the k-th unsaturated reactive monomer, the order changes with every saturated monomer
+	uint32_t getUnsaturatedReactiveMonomer(uint32_t k) const {return unsaturatedMonomers[k];}
+
+	//! Store the state of the lattice occupation in a binary checkpoint
+	template<class CheckpointWriter>
+	void saveCheckpoint(CheckpointWriter& checkpoint) const
+	{
+		checkpoint.beginSection("FeatureConnectionSc");
+		checkpoint.write(latticeFilledUp);
+		connectionLattice.saveCheckpoint(checkpoint);
+		checkpoint.writeVector(unsaturatedMonomers);
+		checkpoint.writeVector(unsaturatedPosition);
+	}
+
+	//! Restore the state of the lattice occupation from a binary checkpoint
+	template<class CheckpointReader>
+	void loadCheckpoint(CheckpointReader& checkpoint)
+	{
+		checkpoint.beginSection("FeatureConnectionSc");
+		checkpoint.read(latticeFilledUp);
+		connectionLattice.loadCheckpoint(checkpoint);
+		checkpoint.readVector(unsaturatedMonomers);
+		checkpoint.readVector(unsaturatedPosition);
+	}
+
 protected:
 
 	//! Populates the lattice using the coordinates of molecules.
 	template<class IngredientsType> void fillLattice(
 			IngredientsType& ingredients);
 
+	//! Adds an unsaturated reactive monomer to the index
+	void addUnsaturatedMonomer(uint32_t monomer);
+
+	//! Removes a saturated monomer from the index by swapping in the last entry
+	void removeUnsaturatedMonomer(uint32_t monomer);
+
 	//! Tag for indication if the lattice is populated.
 	bool latticeFilledUp;
 	//!
 	Lattice<uint32_t> connectionLattice;
+	//! unsaturated reactive monomers, the same monomers as on connectionLattice
+	std::vector<uint32_t> unsaturatedMonomers;
+	//! position of every monomer in unsaturatedMonomers, uint32_t(-1) if not contained
+	std::vector<uint32_t> unsaturatedPosition;
 
 };
 
@@ -406,13 +474,68 @@ void FeatureConnectionSc  ::applyMove(IngredientsType& ing,const MoveConnectBase
   const typename IngredientsType::molecules_type& molecules=ing.getMolecules();
   uint32_t ID(move.getIndex());
   if ( molecules.getNumLinks(ID) ==  molecules[ID].getNumMaxLinks())
+  {
     connectionLattice.setLatticeEntry(molecules[ID].getVector3D(),0);
+    removeUnsaturatedMonomer(ID);
+  }
   uint32_t Neighbor(move.getPartner());
   if ( molecules.getNumLinks(Neighbor) ==  molecules[Neighbor].getNumMaxLinks())
+  {
     connectionLattice.setLatticeEntry(molecules[Neighbor].getVector3D(),0);
+    removeUnsaturatedMonomer(Neighbor);
+  }
 //connection is made in the move 
 }
 /******************************************************************************/
+/**
+ * @fn bool FeatureConnectionSc::checkMove( const IngredientsType& ingredients, const MoveDisconnectBase<SpecializedMove>& move )const
+ * @brief Bonds can only be broken between two reactive monomers, i.e. bonds
+ * to unreactive monomers (e.g. the backbone of a chain) are permanent.
+ *
+ * @param [in] ingredients A reference to the IngredientsType - mainly the system
+ * @param [in] move the move breaking the bond between move.getIndex() and move.getPartner()
+ * @return true if the bond exists and both monomers are reactive
+ */
+/******************************************************************************/
+template<class IngredientsType, class SpecializedMove> 
+bool FeatureConnectionSc ::checkMove(const IngredientsType& ingredients, const MoveDisconnectBase<SpecializedMove>& move) const
+{
+	if (!latticeFilledUp)
+	    throw std::runtime_error("*****FeatureConnectionSc::checkMove....lattice is not populated. Run synchronize!\n");
+	const typename IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+	uint32_t ID(move.getIndex());
+	uint32_t Neighbor(move.getPartner());
+
+	if ( !molecules[ID].isReactive() || !molecules[Neighbor].isReactive() ) return false;
+	return molecules.areConnected(ID,Neighbor);
+}
+/******************************************************************************/
+/**
+ * @fn void FeatureConnectionSc ::applyMove(IngredientsType& ing, const MoveDisconnectBase<SpecializedMove>& move)
+ * @brief Both monomers have a free reactive site again after the bond is
+ * removed by the move.
+ *
+ * @param [in] ing A reference to the IngredientsType - mainly the system
+ * @param [in] move the move breaking the bond between move.getIndex() and move.getPartner()
+ */
+/******************************************************************************/
+template<class IngredientsType, class SpecializedMove> 
+void FeatureConnectionSc  ::applyMove(IngredientsType& ing,const MoveDisconnectBase<SpecializedMove>& move)
+{
+  const typename IngredientsType::molecules_type& molecules=ing.getMolecules();
+  uint32_t monomers[2]={move.getIndex(),move.getPartner()};
+  for(size_t i=0;i<2;i++)
+  {
+    uint32_t ID(monomers[i]);
+    if ( molecules[ID].isReactive() && molecules.getNumLinks(ID) < molecules[ID].getNumMaxLinks())
+    {
+      connectionLattice.setLatticeEntry(molecules[ID].getVector3D(),ID+1);
+      addUnsaturatedMonomer(ID);
+    }
+  }
+//bond is removed in the move 
+}
+/******************************************************************************/
 /**
  * @fn void FeatureConnectionSc ::applyMove(IngredientsType& ing, const MoveLocalSc& move)
  *
@@ -458,7 +581,57 @@ void FeatureConnectionSc  ::applyMove(IngredientsType& ing,const MoveAddMonomerS
   uint32_t MonID(move.getMonomerIndex()); 
   VectorInt3 pos=ing.getMolecules()[MonID];
   if (move.isReactive()) 
-    connectionLattice.setLatticeEntry(pos,MonID+1 );
+  {
+    //the reactivity of the move is stored in the monomer, as done by synchronize
+    ing.modifyMolecules()[MonID].setReactive(true);
+    ing.modifyMolecules()[MonID].setNumMaxLinks(move.getNumMaxLinks());
+    if(move.getNumMaxLinks()>0)
+    {
+      connectionLattice.setLatticeEntry(pos,MonID+1 );
+      addUnsaturatedMonomer(MonID);
+    }
+  }
+}
+/******************************************************************************/
+/**
+ * @fn void FeatureConnectionSc ::applyMove(IngredientsType& ing, const MoveReptationSc& move)
+ * @brief The lattice entry of an unsaturated chain end follows the move. The
+ * old neighbor loses a bond and may become unsaturated, the other chain end
+ * gains a bond and may become saturated.
+ *
+ * @param [in] ing A reference to the IngredientsType - mainly the system
+ * @param [in] move the reptation move, which is applied after this function
+ */
+/******************************************************************************/
+template<class IngredientsType>
+void FeatureConnectionSc  ::applyMove(IngredientsType& ing,const MoveReptationSc& move)
+{
+  const typename IngredientsType::molecules_type& molecules=ing.getMolecules();
+  uint32_t ID(move.getIndex());
+  //the new site may fold back onto the old one (e.g. a dimer taking the
+  //reverse bond), so the old entry is cleared before the new one is set
+  if ( connectionLattice.getLatticeEntry(molecules[ID].getVector3D())==ID+1 )
+  {
+    connectionLattice.setLatticeEntry(molecules[ID].getVector3D(),0);
+    connectionLattice.setLatticeEntry(move.getPosition(),ID+1);
+  }
+
+  //in a chain of two monomers the neighbor keeps its bond
+  uint32_t oldNeighbor(move.getOldNeighbor());
+  uint32_t newNeighbor(move.getNewNeighbor());
+  if ( oldNeighbor==newNeighbor ) return;
+
+  if ( molecules[oldNeighbor].isReactive() && molecules.getNumLinks(oldNeighbor)==molecules[oldNeighbor].getNumMaxLinks() )
+  {
+    connectionLattice.setLatticeEntry(molecules[oldNeighbor].getVector3D(),oldNeighbor+1);
+    addUnsaturatedMonomer(oldNeighbor);
+  }
+  if ( molecules[newNeighbor].isReactive() && molecules.getNumLinks(newNeighbor)+1==molecules[newNeighbor].getNumMaxLinks() )
+  {
+    connectionLattice.setLatticeEntry(molecules[newNeighbor].getVector3D(),0);
+    removeUnsaturatedMonomer(newNeighbor);
+  }
+//bonds are changed in the move
 }
 /******************************************************************************/
 /**
@@ -494,6 +667,8 @@ void FeatureConnectionSc::fillLattice(IngredientsType& ingredients)
   
 	connectionLattice.setupLattice(ingredients.getBoxX(),ingredients.getBoxY(),ingredients.getBoxZ());
 	const typename IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+	unsaturatedMonomers.clear();
+	unsaturatedPosition.assign(molecules.size(),uint32_t(-1));
 	//copy the lattice occupation from the monomer coordinates
 	for(size_t n=0;n<molecules.size();n++)
 	{
@@ -509,11 +684,31 @@ void FeatureConnectionSc::fillLattice(IngredientsType& ingredients)
 			// with and unreactive monomer
 			VectorInt3 pos=molecules[n];
 			connectionLattice.setLatticeEntry(pos,n+1);
+			addUnsaturatedMonomer(n);
 		}
 	}
 	latticeFilledUp=true;
 }
 
+inline void FeatureConnectionSc::addUnsaturatedMonomer(uint32_t monomer)
+{
+	if(unsaturatedPosition.size()<=monomer) unsaturatedPosition.resize(monomer+1,uint32_t(-1));
+	if(unsaturatedPosition[monomer]!=uint32_t(-1)) return;
+	unsaturatedPosition[monomer]=uint32_t(unsaturatedMonomers.size());
+	unsaturatedMonomers.push_back(monomer);
+}
+
+inline void FeatureConnectionSc::removeUnsaturatedMonomer(uint32_t monomer)
+{
+	if(unsaturatedPosition.size()<=monomer || unsaturatedPosition[monomer]==uint32_t(-1)) return;
+	uint32_t position=unsaturatedPosition[monomer];
+	uint32_t last=unsaturatedMonomers.back();
+	unsaturatedMonomers[position]=last;
+	unsaturatedPosition[last]=position;
+	unsaturatedMonomers.pop_back();
+	unsaturatedPosition[monomer]=uint32_t(-1);
+}
+
 /**
  * @brief Executes the reading routine to extract \b !attributes.
  *
@@ -37,6 +37,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/updater/moves/MoveAddMonomerBcc.h>
 #include <LeMonADE/updater/moves/MoveLocalSc.h>
 #include <LeMonADE/updater/moves/MoveAddMonomerSc.h>
+#include <LeMonADE/updater/moves/MoveReptationSc.h>
 
 
 /*****************************************************************************/
@@ -132,6 +133,10 @@ public:
 	template<class IngredientsType, class TagType>
 	bool checkMove(const IngredientsType& ingredients, const MoveAddMonomerSc<TagType>& move) const;
 
+	//! check sc reptation move: Throw error if wrong lattice Type is used
+	template<class IngredientsType>
+	bool checkMove(const IngredientsType& ingredients, const MoveReptationSc& move) const;
+
 	//! apply move for basic moves - does nothing
 	template<class IngredientsType>
 	void applyMove(IngredientsType& ing, const MoveBase& move);
@@ -148,6 +153,22 @@ public:
 	template<class IngredientsType>
 	void synchronize(IngredientsType& ingredients);
 
+	//! Store the state of the lattice occupation in a binary checkpoint
+	template<class CheckpointWriter>
+	void saveCheckpoint(CheckpointWriter& checkpoint) const
+	{
+		checkpoint.beginSection("FeatureExcludedVolumeBcc");
+		checkpoint.write(latticeFilledUp);
+	}
+
+	//! Restore the state of the lattice occupation from a binary checkpoint
+	template<class CheckpointReader>
+	void loadCheckpoint(CheckpointReader& checkpoint)
+	{
+		checkpoint.beginSection("FeatureExcludedVolumeBcc");
+		checkpoint.read(latticeFilledUp);
+	}
+
 private:
 
 	//! Populates the lattice using the coordinates of molecules.
@@ -219,6 +240,25 @@ const IngredientsType& ingredients, const MoveLocalSc& move) const
 	return false;
 }
 
+/******************************************************************************/
+/**
+ * @fn bool FeatureExcludedVolumeBcc< LatticeClassType<LatticeValueType> >::checkMove( const IngredientsType& ingredients, const MoveReptationSc& move )const
+ * @brief Throws a runtime error because the lattice type is inconsitent with the move type
+ *
+ * @param [in] ingredients A reference to the IngredientsType - mainly the system
+ * @param [in] move MoveReptationSc
+ * @return false, throws exception
+ */
+/******************************************************************************/
+template<template<typename> class LatticeClassType, typename LatticeValueType>
+template<class IngredientsType>
+bool FeatureExcludedVolumeBcc< LatticeClassType<LatticeValueType> >::checkMove(
+const IngredientsType& ingredients, const MoveReptationSc& move) const
+{
+	throw std::runtime_error("*****FeatureExcludedVolumeBcc::check MoveReptationSc: wrong lattice type ... \n");
+	return false;
+}
+
 /******************************************************************************/
 /**
  * @fn bool FeatureExcludedVolumeSc< LatticeClassType<LatticeValueType> >::checkMove( const IngredientsType& ingredients, const MoveAddMonomerSc& move )const
@@ -38,6 +38,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/updater/moves/MoveAddMonomerSc.h>
 #include <LeMonADE/updater/moves/MoveLocalBcc.h>
 #include <LeMonADE/updater/moves/MoveAddMonomerBcc.h>
+#include <LeMonADE/updater/moves/MoveReptationSc.h>
 
 /*****************************************************************************/
 /**
@@ -133,6 +134,10 @@ public:
 	template<class IngredientsType, class TagType>
 	bool checkMove(const IngredientsType& ingredients, const MoveAddMonomerBcc<TagType>& move) const;
 
+	//! check move for sc reptation move
+	template<class IngredientsType>
+	bool checkMove(const IngredientsType& ingredients, const MoveReptationSc& move) const;
+
 	//! apply move for basic moves - does nothing
 	template<class IngredientsType>
 	void applyMove(IngredientsType& ing, const MoveBase& move);
@@ -149,10 +154,30 @@ public:
 	template<class IngredientsType, class TagType>
 	void applyMove(IngredientsType& ing, const MoveAddMonomerSc<TagType>& move);
 
+	//! apply move for sc reptation moves
+	template<class IngredientsType>
+	void applyMove(IngredientsType& ing, const MoveReptationSc& move);
+
 	//! Synchronize with system: Fill the lattice with 1 (occupied) and 0 (free).
 	template<class IngredientsType>
 	void synchronize(IngredientsType& ingredients);
 
+	//! Store the state of the lattice occupation in a binary checkpoint
+	template<class CheckpointWriter>
+	void saveCheckpoint(CheckpointWriter& checkpoint) const
+	{
+		checkpoint.beginSection("FeatureExcludedVolumeSc");
+		checkpoint.write(latticeFilledUp);
+	}
+
+	//! Restore the state of the lattice occupation from a binary checkpoint
+	template<class CheckpointReader>
+	void loadCheckpoint(CheckpointReader& checkpoint)
+	{
+		checkpoint.beginSection("FeatureExcludedVolumeSc");
+		checkpoint.read(latticeFilledUp);
+	}
+
 protected:
 
 	//! Populates the lattice using the coordinates of molecules.
@@ -531,6 +556,71 @@ void FeatureExcludedVolumeSc<LatticeClassType<LatticeValueType> >::applyMove(Ing
 	}
 }
 
+/******************************************************************************/
+/**
+ * @fn bool FeatureExcludedVolumeSc< LatticeClassType<LatticeValueType> >::checkMove( const IngredientsType& ingredients, const MoveReptationSc& move )const
+ * @brief checks excluded volume for moves of type MoveReptationSc
+ *
+ * @details The eight lattice sites at the new position of the moved end monomer
+ * must be free. Sites, which are occupied by the moved monomer itself, count as free.
+ *
+ * @param [in] ingredients A reference to the IngredientsType - mainly the system.
+ * @param [in] move A reference to MoveReptationSc.
+ * @return if move is allowed (\a true) or rejected (\a false).
+ * */
+/******************************************************************************/
+template<template<typename> class LatticeClassType, typename LatticeValueType>
+template < class IngredientsType>
+bool FeatureExcludedVolumeSc< LatticeClassType<LatticeValueType> >::checkMove( const IngredientsType& ingredients, const MoveReptationSc& move ) const
+{
+	if(!latticeFilledUp)
+	  throw std::runtime_error("*****FeatureExcludedVolumeSc::checkMove....lattice is not populated. Run synchronize!\n");
+
+	VectorInt3 newPos=move.getPosition();
+
+	for(int32_t dx=0;dx<2;dx++)
+	  for(int32_t dy=0;dy<2;dy++)
+	    for(int32_t dz=0;dz<2;dz++)
+	    {
+	      VectorInt3 site=newPos+VectorInt3(dx,dy,dz);
+	      if(ingredients.getLatticeEntry(site) && !move.isOldSite(ingredients,site)) return false;
+	    }
+
+	return true;
+}
+
+/******************************************************************************/
+/**
+ * @fn void FeatureExcludedVolumeSc< LatticeClassType<LatticeValueType> >::applyMove(IngredientsType& ing, const MoveReptationSc& move)
+ * @brief Updates the lattice occupation according to the move for moves of type MoveReptationSc.
+ *
+ * @details The value stored on the lattice is carried over to the new position,
+ * such that features storing other values than 1 on the lattice keep their information.
+ *
+ * @param [in] ing A reference to the IngredientsType - mainly the system.
+ * @param [in] move A reference to MoveReptationSc.
+ * */
+/******************************************************************************/
+template<template<typename> class LatticeClassType, typename LatticeValueType>
+template<class IngredientsType>
+void FeatureExcludedVolumeSc< LatticeClassType<LatticeValueType> >::applyMove(IngredientsType& ing, const MoveReptationSc& move)
+{
+	VectorInt3 oldPos=ing.getMolecules()[move.getIndex()];
+	VectorInt3 newPos=move.getPosition();
+	LatticeValueType value=ing.getLatticeEntry(oldPos);
+
+	//old and new position may overlap, so first clear all old sites
+	for(int32_t dx=0;dx<2;dx++)
+	  for(int32_t dy=0;dy<2;dy++)
+	    for(int32_t dz=0;dz<2;dz++)
+	      ing.setLatticeEntry(oldPos+VectorInt3(dx,dy,dz),LatticeValueType(0));
+
+	for(int32_t dx=0;dx<2;dx++)
+	  for(int32_t dy=0;dy<2;dy++)
+	    for(int32_t dz=0;dz<2;dz++)
+	      ing.setLatticeEntry(newPos+VectorInt3(dx,dy,dz),value);
+}
+
 /******************************************************************************/
 /**
  * @fn bool FeatureExcludedVolumeSc< LatticeClassType<LatticeValueType> >::checkMove( const IngredientsType& ingredients, const MoveAddMonomerSc& move )const
@@ -38,6 +38,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <LeMonADE/updater/moves/MoveBase.h>
 #include <LeMonADE/updater/moves/MoveLocalSc.h>
+#include <LeMonADE/updater/moves/MoveReptationBase.h>
 
 /**
  * @file
@@ -170,6 +171,21 @@ public:
     return molecules[monoIndex].getMovableTag();
   }
 
+  /**
+   * @brief Overloaded for MoveReptationBase. See MoveReptationSc
+   *
+   * @details Checks if the end monomer, which is moved to the other chain end, is not fixed.
+   *
+   * @param [in] ingredients A reference to the IngredientsType - mainly the system.
+   * @param [in] move A reference to MoveReptationBase.
+   * @return if monomer is movable (true) or fixed (false).
+   */
+  template<class IngredientsType,class ReptationMoveType>
+  bool checkMove(const IngredientsType& ingredients, const MoveReptationBase<ReptationMoveType>& move) const
+  {
+    return ingredients.getMolecules()[move.getIndex()].getMovableTag();
+  }
+
 };
 
 
@@ -109,6 +109,12 @@ public:
 	//delocate memory
         void deleteLattice();
 
+	//! Stores the lattice geometry and all lattice entries as raw block in a binary checkpoint
+	template<class CheckpointWriter> void saveCheckpoint(CheckpointWriter& checkpoint) const;
+
+	//! Restores the lattice from a binary checkpoint, reallocating memory if necessary
+	template<class CheckpointReader> void loadCheckpoint(CheckpointReader& checkpoint);
+
 protected:
 
 	//! Hold the value of lattice size in X
@@ -413,4 +419,46 @@ void FeatureLatticeBase<SpecializedClass<ValueType> >::clearLattice()
 		lattice[i]=ValueType();
 }
 
+/**
+ * @param checkpoint Writer of the checkpoint file
+ */
+template<template<typename> class SpecializedClass, typename ValueType>
+template<class CheckpointWriter>
+void FeatureLatticeBase<SpecializedClass<ValueType> >::saveCheckpoint(CheckpointWriter& checkpoint) const
+{
+	checkpoint.beginSection("FeatureLatticeBase");
+	checkpoint.write(_boxX); checkpoint.write(_boxY); checkpoint.write(_boxZ);
+	checkpoint.write(boxXm1); checkpoint.write(boxYm1); checkpoint.write(boxZm1);
+	checkpoint.write(xPro); checkpoint.write(proXY);
+
+	uint64_t latticeSize=(lattice!=NULL)?uint64_t(_boxX)*_boxY*_boxZ:0;
+	checkpoint.writeArray(lattice,latticeSize);
+}
+
+/**
+ * @details The lattice content is read as one block, no synchronization with
+ * the monomers is needed afterwards.
+ *
+ * @param checkpoint Reader of the checkpoint file
+ */
+template<template<typename> class SpecializedClass, typename ValueType>
+template<class CheckpointReader>
+void FeatureLatticeBase<SpecializedClass<ValueType> >::loadCheckpoint(CheckpointReader& checkpoint)
+{
+	checkpoint.beginSection("FeatureLatticeBase");
+	uint32_t oldSize=(lattice!=NULL)?_boxX*_boxY*_boxZ:0;
+	checkpoint.read(_boxX); checkpoint.read(_boxY); checkpoint.read(_boxZ);
+	checkpoint.read(boxXm1); checkpoint.read(boxYm1); checkpoint.read(boxZm1);
+	checkpoint.read(xPro); checkpoint.read(proXY);
+
+	uint64_t latticeSize;
+	checkpoint.read(latticeSize);
+	if(latticeSize!=oldSize)
+	{
+		deleteLattice();
+		if(latticeSize>0) lattice = new ValueType[latticeSize];
+	}
+	if(latticeSize>0) checkpoint.readBlock(lattice,latticeSize);
+}
+
 #endif /* LEMONADE_FEATURE_FEATURELATTICEBASE_H */
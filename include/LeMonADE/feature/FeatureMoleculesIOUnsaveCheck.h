@@ -95,6 +95,40 @@ public:
 	 * */
 	const std::map<size_t,size_t>& getCompressedOutputIndices() const {return solventIndices;}
 
+	//! store the metadata and the compressed output ranges in a binary checkpoint
+	template<class CheckpointWriter>
+	void saveCheckpoint(CheckpointWriter& checkpoint) const
+	{
+		checkpoint.beginSection("FeatureMoleculesIOUnsaveCheck");
+		checkpoint.write(numberOfMonomers);
+		checkpoint.write(maxConnectivity);
+		checkpoint.write(uint64_t(solventIndices.size()));
+		for(std::map<size_t,size_t>::const_iterator it=solventIndices.begin();it!=solventIndices.end();++it)
+		{
+			checkpoint.write(uint64_t(it->first));
+			checkpoint.write(uint64_t(it->second));
+		}
+	}
+
+	//! restore the metadata and the compressed output ranges from a binary checkpoint
+	template<class CheckpointReader>
+	void loadCheckpoint(CheckpointReader& checkpoint)
+	{
+		checkpoint.beginSection("FeatureMoleculesIOUnsaveCheck");
+		checkpoint.read(numberOfMonomers);
+		checkpoint.read(maxConnectivity);
+		solventIndices.clear();
+		uint64_t nRanges;
+		checkpoint.read(nRanges);
+		for(uint64_t n=0;n<nRanges;n++)
+		{
+			uint64_t startIdx,stopIdx;
+			checkpoint.read(startIdx);
+			checkpoint.read(stopIdx);
+			solventIndices[startIdx]=stopIdx;
+		}
+	}
+
 private:
 	//metadata
 	uint numberOfMonomers,maxConnectivity;
@@ -162,6 +162,24 @@ public:
   template <class IngredientsType>
   void exportWrite(AnalyzerWriteBfmFile <IngredientsType>& fileWriter) const;
 
+  //! stores the interaction energies and the probability lookup table in a binary checkpoint
+  template <class CheckpointWriter>
+  void saveCheckpoint(CheckpointWriter& checkpoint) const
+  {
+    checkpoint.beginSection("FeatureNNInteractionBcc");
+    checkpoint.writeArray(&interactionTable[0][0],256*256);
+    checkpoint.writeArray(&probabilityLookup[0][0],256*256);
+  }
+
+  //! restores the interaction energies and the probability lookup table from a binary checkpoint
+  template <class CheckpointReader>
+  void loadCheckpoint(CheckpointReader& checkpoint)
+  {
+    checkpoint.beginSection("FeatureNNInteractionBcc");
+    checkpoint.readArray(&interactionTable[0][0],256*256);
+    checkpoint.readArray(&probabilityLookup[0][0],256*256);
+  }
+
 };
 
 
@@ -39,6 +39,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/feature/Feature.h>
 #include <LeMonADE/updater/moves/MoveBase.h>
 #include <LeMonADE/updater/moves/MoveLocalSc.h>
+#include <LeMonADE/updater/moves/MoveReptationSc.h>
 #include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
 #include <LeMonADE/feature/FeatureBoltzmann.h>
 #include <LeMonADE/feature/FeatureAttributes.h>
@@ -89,6 +90,11 @@ private:
   double calculateAcceptanceProbability(const IngredientsType& ingredients,
 					const MoveLocalSc& move) const;
 
+  //! Returns this feature's factor for the acceptance probability for the given reptation move
+  template<class IngredientsType>
+  double calculateAcceptanceProbability(const IngredientsType& ingredients,
+					const MoveReptationSc& move) const;
+
   //! Occupies the lattice with the attribute tags of all monomers
   template<class IngredientsType>
   void fillLattice(IngredientsType& ingredients);
@@ -124,6 +130,10 @@ public:
   template<class IngredientsType>
     bool checkMove(const IngredientsType& ingredients,MoveLocalSc& move) const;
 
+  //! check for sc-BFM reptation move
+  template<class IngredientsType>
+    bool checkMove(const IngredientsType& ingredients,MoveReptationSc& move) const;
+
   //! check move for bcc-BFM local move. always throws std::runtime_error
   template<class IngredientsType>
     bool checkMove(const IngredientsType& ingredients,const MoveLocalBcc& move) const;
@@ -140,8 +150,8 @@ public:
   template<class IngredientsType>
     void applyMove(IngredientsType& ing, const MoveAddMonomerSc<int32_t>& move);
 
-  //note: apply function for sc-BFM local move is not necessary, because
-  //job of moving lattice entries is done by the underlying FeatureLatticeType
+  //note: apply function for sc-BFM local and reptation moves is not necessary, because
+  //job of moving lattice entries is done by FeatureExcludedVolumeSc
 
   //! guarantees that the lattice is properly occupied with monomer attributes
   template<class IngredientsType>
@@ -161,6 +171,24 @@ public:
   template <class IngredientsType>
   void exportWrite(AnalyzerWriteBfmFile <IngredientsType>& fileWriter) const;
 
+  //! stores the interaction energies and the probability lookup table in a binary checkpoint
+  template <class CheckpointWriter>
+  void saveCheckpoint(CheckpointWriter& checkpoint) const
+  {
+    checkpoint.beginSection("FeatureNNInteractionSc");
+    checkpoint.writeArray(&interactionTable[0][0],256*256);
+    checkpoint.writeArray(&probabilityLookup[0][0],256*256);
+  }
+
+  //! restores the interaction energies and the probability lookup table from a binary checkpoint
+  template <class CheckpointReader>
+  void loadCheckpoint(CheckpointReader& checkpoint)
+  {
+    checkpoint.beginSection("FeatureNNInteractionSc");
+    checkpoint.readArray(&interactionTable[0][0],256*256);
+    checkpoint.readArray(&probabilityLookup[0][0],256*256);
+  }
+
 };
 
 
@@ -218,6 +246,24 @@ bool FeatureNNInteractionSc<LatticeClassType>::checkMove(const IngredientsType&
   return true;
 }
 
+/**
+ * @details calculates the factor for the acceptance probability of the reptation
+ * move arising from the contact interactions and adds it to the move.
+ *
+ * @param [in] ingredients A reference to the IngredientsType - mainly the system
+ * @param [in] move Monte Carlo move of type MoveReptationSc
+ * @return true (always)
+ **/
+template<template<typename> class LatticeClassType>
+template<class IngredientsType>
+bool FeatureNNInteractionSc<LatticeClassType>::checkMove(const IngredientsType& ingredients,
+							 MoveReptationSc& move) const
+{
+  double prob=calculateAcceptanceProbability(ingredients,move);
+  move.multiplyProbability(prob);
+  return true;
+}
+
 /**
  * @details Because moves of type MoveLocalBcc must not be used with this
  * feature, this function always throws an exception when called. The function
@@ -543,6 +589,53 @@ double FeatureNNInteractionSc<LatticeClassType>::calculateAcceptanceProbability(
 
 }
 
+/**
+ * @details The end monomer of a reptation move leaves its old position and
+ * appears at the other chain end, so all its contacts change. The 24 lattice
+ * sites adjacent to the faces of the monomer are checked at the new position
+ * (new contacts) and at the old position (lost contacts). At the new position
+ * the sites occupied by the moved monomer itself are skipped, because they are
+ * free after the move. At the old position the sites of the new position are
+ * still free, such that they do not contribute.
+ *
+ * @tparam IngredientsType The type of the system including all features
+ * @param [in] ingredients A reference to the IngredientsType - mainly the system
+ * @param [in] move reference to the reptation move for which the calculation is performed
+ * @return acceptance probability factor for the move arising from nearest neighbor contacts
+ **/
+template<template<typename> class LatticeClassType>
+template<class IngredientsType>
+double FeatureNNInteractionSc<LatticeClassType>::calculateAcceptanceProbability(
+    const IngredientsType& ingredients,
+    const MoveReptationSc& move) const
+{
+    VectorInt3 oldPos=ingredients.getMolecules()[move.getIndex()];
+    VectorInt3 newPos=move.getPosition();
+    int32_t monoType=ingredients.getMolecules()[move.getIndex()].getAttributeTag();
+
+    double prob=1.0;
+    double prob_div=1.0;
+
+    //the face neighbors of the cube [0,1]^3 are the sites in [-1,2]^3 with
+    //exactly one coordinate outside of [0,1]
+    for(int32_t dx=-1;dx<=2;dx++)
+      for(int32_t dy=-1;dy<=2;dy++)
+        for(int32_t dz=-1;dz<=2;dz++)
+        {
+          int32_t nOutside=(dx<0 || dx>1)+(dy<0 || dy>1)+(dz<0 || dz>1);
+          if(nOutside!=1) continue;
+
+          VectorInt3 shift(dx,dy,dz);
+          VectorInt3 site=newPos+shift;
+          if(!move.isOldSite(ingredients,site))
+            prob*=getProbabilityFactor(monoType,int32_t(ingredients.getLatticeEntry(site)));
+          prob_div*=getProbabilityFactor(monoType,int32_t(ingredients.getLatticeEntry(oldPos+shift)));
+        }
+
+    prob/=prob_div;
+    return prob;
+}
+
 /**
  * @param typeA monomer attribute tag in range [1,255]
  * @param typeB monomer attribute tag in range [1,255]
@@ -32,6 +32,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/updater/moves/MoveBase.h>
 #include <LeMonADE/updater/moves/MoveLocalSc.h>
 #include <LeMonADE/updater/moves/MoveLocalScDiag.h>
+#include <LeMonADE/updater/moves/MoveReptationSc.h>
 #include <LeMonADE/io/FileImport.h>
 #include <LeMonADE/analyzer/AnalyzerWriteBfmFile.h>
 #include <LeMonADE/feature/FeatureBoltzmann.h>
@@ -108,6 +109,10 @@ public:
 
 	template<class IngredientsType>
 	bool checkMove(const IngredientsType& ingredients, MoveLocalScDiag& move) const;
+
+	//! the reptation move is not supported, throws an exception
+	template<class IngredientsType>
+	bool checkMove(const IngredientsType& ingredients, const MoveReptationSc& move) const;
 	
 	//! getter function for the harmonic potential spring length r0 in V(r)=k/2(r-r0)^2
 	double getEquilibriumLength() const{
@@ -142,6 +147,28 @@ public:
 	template<class IngredientsType>
 	void synchronize(IngredientsType& ingredients);
 
+	//! stores the spring parameters and the monomer groups in a binary checkpoint
+	template<class CheckpointWriter>
+	void saveCheckpoint(CheckpointWriter& checkpoint) const
+	{
+		checkpoint.beginSection("FeatureSpringPotentialTwoGroups");
+		checkpoint.write(equilibrium_length);
+		checkpoint.write(spring_constant);
+		checkpoint.writeVector(affectedMonomerGroup0);
+		checkpoint.writeVector(affectedMonomerGroup1);
+	}
+
+	//! restores the spring parameters and the monomer groups from a binary checkpoint
+	template<class CheckpointReader>
+	void loadCheckpoint(CheckpointReader& checkpoint)
+	{
+		checkpoint.beginSection("FeatureSpringPotentialTwoGroups");
+		checkpoint.read(equilibrium_length);
+		checkpoint.read(spring_constant);
+		checkpoint.readVector(affectedMonomerGroup0);
+		checkpoint.readVector(affectedMonomerGroup1);
+	}
+
 private:
 	//! equilibrium length r0 in harmonic potential V(r)=k/2(r-r0)^2
 	double equilibrium_length;
@@ -488,6 +515,22 @@ bool FeatureSpringPotentialTwoGroups::checkMove(const IngredientsType& ingredien
 	return true;
 }
 
+/**
+ * The reptation move changes the positions of the group members in a way
+ * the potential difference is not computed for. It is rejected with an
+ * exception instead of being accepted without a check.
+ *
+ * @param [in] ingredients A reference to the IngredientsType - mainly the system
+ * @param [in] move the reptation move: MoveReptationSc
+ * @throw std::runtime_error always
+ */
+template<class IngredientsType>
+bool FeatureSpringPotentialTwoGroups::checkMove(const IngredientsType&, const MoveReptationSc&) const
+{
+	throw std::runtime_error("FeatureSpringPotentialTwoGroups::checkMove: MoveReptationSc is not supported");
+	return false;
+}
+
 /**
  * This function performs the Monte-Carlo check for the MoveLocalSc.
  * The center of mass differences induced by the moveand the resulting potential difference is calculated.
@@ -39,6 +39,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/io/AbstractRead.h>
 #include <LeMonADE/io/AbstractWrite.h>
 #include <LeMonADE/updater/moves/MoveAddMonomerSc.h>
+#include <LeMonADE/updater/moves/MoveReptationSc.h>
 
 
 /**
@@ -68,7 +69,7 @@ public:
     }
 
     //! setter function for the base vector of the wall
-    VectorInt3 setBase(uint32_t baseX_, uint32_t baseY_, uint32_t baseZ_) {
+    void setBase(uint32_t baseX_, uint32_t baseY_, uint32_t baseZ_) {
         base.setAllCoordinates(baseX_,baseY_,baseZ_);
     }
 
@@ -78,7 +79,7 @@ public:
     }
 
     //! setter function for the normal vector of the wall
-    VectorInt3 setNormal(uint32_t norX_, uint32_t norY_, uint32_t norZ_) {
+    void setNormal(uint32_t norX_, uint32_t norY_, uint32_t norZ_) {
       VectorInt3 test(norX_, norY_, norZ_);
       if(test==VectorInt3(1,0,0) || test==VectorInt3(0,1,0) || test==VectorInt3(0,0,1) ){
         normal.setAllCoordinates(norX_,norY_,norZ_);
@@ -128,6 +129,10 @@ public:
     template<class IngredientsType, class TagType>
     bool checkMove(const IngredientsType& ingredients,MoveAddMonomerSc<TagType>& addmove);
 
+    //! check move function for sc reptation move
+    template<class IngredientsType>
+    bool checkMove(const IngredientsType& ingredients,MoveReptationSc& move);
+
     //! implemantation of synchronize
     template<class IngredientsType>
     void synchronize(const IngredientsType& ingredients);
@@ -153,11 +158,31 @@ public:
         walls.clear();
     }
 
+    //! store the walls in a binary checkpoint
+    template<class CheckpointWriter>
+    void saveCheckpoint(CheckpointWriter& checkpoint) const{
+        checkpoint.beginSection("FeatureWall");
+        checkpoint.writeVector(walls);
+    }
+
+    //! restore the walls from a binary checkpoint
+    template<class CheckpointReader>
+    void loadCheckpoint(CheckpointReader& checkpoint){
+        checkpoint.beginSection("FeatureWall");
+        checkpoint.readVector(walls);
+    }
+
 
 private:
     //! walls container
     std::vector<Wall> walls;
 
+    //! returns the coordinate along the normal of the wall, or -1 if the normal is not a unit vector of the lattice
+    static int32_t getNormalDirection(const Wall& wall);
+
+    //! checks if a monomer at position does not touch any of the walls
+    bool isPositionAllowed(const VectorInt3& position) const;
+
 };
 
 
@@ -205,35 +230,54 @@ class ReadWall : public ReadToDestination < IngredientsType >
 
 
 /**
- * @details checking if move is going to touch one of the walls
+ * @details Walls are only defined for the unit vectors along the lattice
+ * directions as normals, see Wall::setNormal.
  *
- * @param [in] ingredients A reference to the IngredientsType - mainly the system
- * @param [in] move local sc move
+ * @param [in] wall the wall
+ * @return 0, 1 or 2 for normals along x, y or z, -1 otherwise
  */
-template<class IngredientsType>
-bool FeatureWall::checkMove(const IngredientsType& ingredients, MoveLocalSc& move)
+inline int32_t FeatureWall::getNormalDirection(const Wall& wall)
 {
-    uint32_t counter(0);
-
-	for (size_t i = 0; i < ingredients.getWalls().size(); i++) { //check all walls in the system
+	const VectorInt3 normal(wall.getNormal());
+	if (normal == VectorInt3(1,0,0)) return 0;
+	if (normal == VectorInt3(0,1,0)) return 1;
+	if (normal == VectorInt3(0,0,1)) return 2;
+	return -1;
+}
 
-		uint8_t direction;
-        VectorInt3 unitX(1,0,0);
-        VectorInt3 unitY(0,1,0);
-        VectorInt3 unitZ(0,0,1);
+/**
+ * @details A monomer touches a wall, if its coordinate along the normal of the
+ * wall is the coordinate of the base minus one. Walls with other normals are
+ * rejected by synchronize() and are skipped here. The walls are accessed
+ * directly, because getWalls() returns a copy.
+ *
+ * @param [in] position the new position of the monomer
+ */
+inline bool FeatureWall::isPositionAllowed(const VectorInt3& position) const
+{
+	for (size_t i = 0; i < walls.size(); i++) { //check all walls in the system
 
-		if (ingredients.getWalls()[i].getNormal() == unitX) { direction = 0; } //points direction of normal and sets variable direction to look only on this part of the new position vector later
-		if (ingredients.getWalls()[i].getNormal() == unitY) { direction = 1; }
-		if (ingredients.getWalls()[i].getNormal() == unitZ) { direction = 2; }
+		int32_t direction = getNormalDirection(walls[i]);
+		if (direction < 0) continue;
 
-		if ((ingredients.getMolecules()[move.getIndex()] + move.getDir()).getCoordinate(direction) != ingredients.getWalls()[i].getBase().getCoordinate(direction)-1) { //if new position has NOT the same value in "direction" as the wall -1, permit the move
-			counter++;
+		if (position.getCoordinate(direction) == walls[i].getBase().getCoordinate(direction)-1) {
+			return false;
 		}
 	}
 
-	if (counter == ingredients.getWalls().size()) {return true;}
+	return true;
+}
 
-	return false;
+/**
+ * @details checking if move is going to touch one of the walls
+ *
+ * @param [in] ingredients A reference to the IngredientsType - mainly the system
+ * @param [in] move local sc move
+ */
+template<class IngredientsType>
+bool FeatureWall::checkMove(const IngredientsType& ingredients, MoveLocalSc& move)
+{
+	return isPositionAllowed(ingredients.getMolecules()[move.getIndex()] + move.getDir());
 }
 
 /**
@@ -245,52 +289,46 @@ bool FeatureWall::checkMove(const IngredientsType& ingredients, MoveLocalSc& mov
 template<class IngredientsType, class TagType>
 bool FeatureWall::checkMove(const IngredientsType& ingredients, MoveAddMonomerSc<TagType>& addmove)
 {
-    uint32_t counter(0);
-
-	for (size_t i = 0; i < ingredients.getWalls().size(); i++) { //check all walls in the system
-
-		uint8_t direction;
-        VectorInt3 unitX(1,0,0);
-        VectorInt3 unitY(0,1,0);
-        VectorInt3 unitZ(0,0,1);
-
-		if (ingredients.getWalls()[i].getNormal() == unitX) { direction = 0; } //points direction of normal and sets variable direction to look only on this part of the new position vector later
-		if (ingredients.getWalls()[i].getNormal() == unitY) { direction = 1; }
-		if (ingredients.getWalls()[i].getNormal() == unitZ) { direction = 2; }
-
-		if (addmove.getPosition().getCoordinate(direction) != ingredients.getWalls()[i].getBase().getCoordinate(direction)-1) { //if new molecule has NOT the same value in "direction" as the wall -1, permit the move
-			counter++;
-		}
-	}
-
-	if (counter == ingredients.getWalls().size()) {return true;}
+	return isPositionAllowed(addmove.getPosition());
+}
 
-	return false;
+/**
+ * @details checking if the moved chain end is going to touch one of the walls
+ *
+ * @param [in] ingredients A reference to the IngredientsType - mainly the system
+ * @param [in] move reptation move of a chain end
+ */
+template<class IngredientsType>
+bool FeatureWall::checkMove(const IngredientsType& ingredients, MoveReptationSc& move)
+{
+	return isPositionAllowed(move.getPosition());
 }
 
 /**
  * @brief Synchronize this feature with the system given as argument
  *
- * @details checking all monomer positions to be not in conflict with one of the walls
+ * @details checking all walls to have a unit vector along a lattice direction as
+ * normal and all monomer positions to be not in conflict with one of the walls
  *
- * @throw <std::runtime_error> monomer occupies a position on the walls
+ * @throw <std::runtime_error> wall with an invalid normal or monomer occupies a position on the walls
  * @param [in] ingredients a reference to the IngredientsType - mainly the system
  **/
 template<class IngredientsType>
 void FeatureWall::synchronize(const IngredientsType& ingredients)
 {
-    uint8_t direction;
-    VectorInt3 unitX(1,0,0);
-    VectorInt3 unitY(0,1,0);
-    VectorInt3 unitZ(0,0,1);
+    for (size_t w = 0; w < ingredients.getWalls().size(); w++) {
+        if (getNormalDirection(ingredients.getWalls()[w]) < 0) {
+            std::ostringstream errorMessage;
+            errorMessage << "FeatureWall::synchronize(const IngredientsType& ingredients): wall " << w << " has the normal " << ingredients.getWalls()[w].getNormal() << ", which is not (1,0,0), (0,1,0) or (0,0,1).\n";
+            throw std::runtime_error(errorMessage.str());
+        }
+    }
 
     for (size_t i=0; i<ingredients.getMolecules().size(); i++) {
 
         for (size_t w = 0; w < ingredients.getWalls().size(); w++) {
 
-            if (ingredients.getWalls()[w].getNormal() == unitX) { direction = 0; }
-            if (ingredients.getWalls()[w].getNormal() == unitY) { direction = 1; }
-            if (ingredients.getWalls()[w].getNormal() == unitZ) { direction = 2; }
+            int32_t direction = getNormalDirection(ingredients.getWalls()[w]);
 
             if (ingredients.getMolecules()[i].getCoordinate(direction) == ingredients.getWalls()[w].getBase().getCoordinate(direction)-1) {
                 std::ostringstream errorMessage;
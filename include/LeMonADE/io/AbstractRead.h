@@ -40,6 +40,8 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <vector>
 #include <sstream>
 
+#include <LeMonADE/io/MappedFileBuffer.h>
+
 /***********************************************************************/
  /**
   * @class AbstractRead
@@ -79,6 +81,15 @@ protected:
   //! Convenience function for detecting a command line
   bool detectRead(std::string& line) const;
 
+  //! Convenience function for detecting a command line in the range [lineBegin,lineEnd)
+  bool detectRead(const char* lineBegin, const char* lineEnd) const;
+
+  //! Returns the memory mapped buffer behind the input stream, or 0 if the input is not memory mapped
+  MappedFileBuffer* getMappedBuffer();
+
+  //! Zero-copy counterpart of std::getline for memory mapped input
+  bool getMappedLine(MappedFileBuffer& buffer, const char*& lineBegin, const char*& lineEnd);
+
   //! Convenience function for detecting a separator character
   bool findSeparator(std::istream& stream,char separator);
 
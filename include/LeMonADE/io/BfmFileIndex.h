@@ -0,0 +1,150 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_IO_BFMFILEINDEX_H
+#define LEMONADE_IO_BFMFILEINDEX_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class BfmFileIndex
+ * */
+/*****************************************************************************/
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*****************************************************************************/
+/**
+ * @class BfmFileIndex
+ *
+ * @brief Persistent sidecar index of the frames (!mcs) in a bfm-file
+ *
+ * @details The index stores the byte offset and the mcs of every frame of a
+ * bfm-file in the file <bfm-file>.idx, such that FileImport does not have to
+ * scan the complete trajectory every time it is opened. Together with the
+ * frames, the size and the modification time of the bfm-file as well as a
+ * checksum of the last scanned bytes are stored. For every frame it is also
+ * stored whether other commands than !mcs (e.g. !add_bonds) belong to it. When the index is loaded,
+ * it is compared to the current state of the bfm-file:
+ * - Valid: the file did not change, the index can be used as is.
+ * - Grown: data was appended to the file. The indexed frames are still valid
+ *   and only the new part of the file has to be scanned.
+ * - Invalid or Missing: the file has to be scanned completely.
+ *
+ * FileImport only uses the index if it is enabled with FileImport::setUseFrameIndex().
+ * The index file is binary in native byte order and only meant as a cache.
+ * It is written append-only when frames are added to an existing index.
+ * Failing to read or write the index is never an error.
+ * */
+/*****************************************************************************/
+class BfmFileIndex
+{
+public:
+
+  //! One frame in the bfm-file
+  struct Entry
+  {
+    //! Monte Carlo time of the frame
+    uint64_t mcs;
+    //! Position in the bfm-file from where the frame is read
+    uint64_t offset;
+    //! Additional information on the frame, see FrameFlags
+    uint64_t flags;
+  };
+
+  //! Bits used in Entry::flags
+  enum FrameFlags
+  {
+    //! Commands other than !mcs precede the frame (e.g. !add_bonds)
+    HasCommands=1
+  };
+
+  //! Result of comparing the index to the bfm-file
+  enum Status {Missing, Invalid, Grown, Valid};
+
+  BfmFileIndex(const std::string& bfmFilename);
+
+  //! Loads the index file and compares it to the bfm-file
+  Status load();
+
+  //! Writes the index file, only appending new frames if possible
+  bool save();
+
+  //! Removes all frames and the stored file information
+  void clear();
+
+  //! Adds a frame to the index
+  void addEntry(uint64_t mcs, uint64_t offset, uint64_t flags=0);
+
+  //! Stores size, modification time and checksum of the indexed part of the bfm-file
+  bool setIndexedFile(uint64_t indexedSize);
+
+  //! Returns the indexed frames in the order of the bfm-file
+  const std::vector<Entry>& getEntries() const {return entries;}
+
+  //! Returns the size of the bfm-file covered by the index
+  uint64_t getIndexedFileSize() const {return fileSize;}
+
+  //! Returns the name of the index file
+  const std::string& getIndexFilename() const {return indexFilename;}
+
+  //! Name of the index file belonging to a bfm-file
+  static std::string indexFilenameOf(const std::string& bfmFilename){return bfmFilename+".idx";}
+
+private:
+
+  //! Reads size and modification time of the bfm-file
+  bool readFileStatus(uint64_t& size, int64_t& modificationTime) const;
+
+  //! Checksum (FNV-1a) of the last bytes of the bfm-file up to position end
+  bool tailChecksum(uint64_t end, uint64_t& checksum) const;
+
+  //! Name of the indexed bfm-file
+  std::string bfmFilename;
+
+  //! Name of the index file
+  std::string indexFilename;
+
+  //! Frames in the order of the bfm-file
+  std::vector<Entry> entries;
+
+  //! Number of entries already present in the index file
+  size_t nSavedEntries;
+
+  //! Size of the bfm-file when it was indexed
+  uint64_t fileSize;
+
+  //! Modification time of the bfm-file when it was indexed
+  int64_t modificationTime;
+
+  //! Checksum of the last bytes of the indexed part of the bfm-file
+  uint64_t checksum;
+};
+
+#endif /* LEMONADE_IO_BFMFILEINDEX_H */
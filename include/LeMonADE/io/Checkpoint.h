@@ -0,0 +1,201 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_IO_CHECKPOINT_H
+#define LEMONADE_IO_CHECKPOINT_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of the classes CheckpointWriter and CheckpointReader
+ * */
+/*****************************************************************************/
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*****************************************************************************/
+/**
+ * @class CheckpointWriter
+ *
+ * @brief Writes the complete binary state of a simulation to a checkpoint file
+ *
+ * @details Values are stored in their native binary representation, such that
+ * a restart reproduces the state bit by bit. Large blocks of plain data (e.g.
+ * the lattice or the monomer array) are written as single raw blocks. The data
+ * is organized in named sections, which are checked by the CheckpointReader
+ * when the file is read. The file is first written to filename.tmp and only
+ * moved to its final name by close(), such that an interrupted run never
+ * leaves an incomplete checkpoint behind.
+ *
+ * The format depends on the byte order and the type sizes of the machine, so
+ * checkpoint files are meant for restarts on the same platform with the same
+ * executable. Use the bfm-file format for portable output.
+ * */
+/*****************************************************************************/
+class CheckpointWriter
+{
+public:
+  //! Opens filename.tmp for writing and writes the file header
+  explicit CheckpointWriter(const std::string& filename);
+
+  //! Removes the temporary file if close() was not called
+  ~CheckpointWriter();
+
+  //! Starts a new section with the given name
+  void beginSection(const std::string& name);
+
+  //! Writes a single value of plain data type
+  template<class T>
+  void write(const T& value){writeBytes(&value,sizeof(T));}
+
+  //! Writes the number of elements followed by the raw block of n values of plain data type
+  template<class T>
+  void writeArray(const T* values, uint64_t n)
+  {
+	  write(n);
+	  if(n>0) writeBytes(values,n*sizeof(T));
+  }
+
+  //! Writes a vector of plain data type as raw block
+  template<class T>
+  void writeVector(const std::vector<T>& values)
+  {
+	  writeArray(values.empty()?0:&values[0],values.size());
+  }
+
+  //! Writes a string
+  void writeString(const std::string& str);
+
+  //! Finishes the file and moves it to its final name
+  void close();
+
+  //! Returns the name of the checkpoint file
+  const std::string& getFilename() const {return filename;}
+
+private:
+  //! no copies, the file is owned by this object
+  CheckpointWriter(const CheckpointWriter&);
+  CheckpointWriter& operator=(const CheckpointWriter&);
+
+  void writeBytes(const void* data, uint64_t n);
+
+  //! Final name of the checkpoint file
+  std::string filename;
+  //! Name of the file written until close() is called
+  std::string tmpFilename;
+  //! The file stream
+  std::ofstream file;
+  //! True if close() was called successfully
+  bool closed;
+};
+
+/*****************************************************************************/
+/**
+ * @class CheckpointReader
+ *
+ * @brief Reads a checkpoint file written by CheckpointWriter
+ *
+ * @details The data has to be read in exactly the same order as it was
+ * written. Section names and array sizes are checked and a std::runtime_error
+ * is thrown on any mismatch or read error, such that an incompatible or
+ * corrupted checkpoint is never loaded silently.
+ * */
+/*****************************************************************************/
+class CheckpointReader
+{
+public:
+  //! Opens the file and checks the file header
+  explicit CheckpointReader(const std::string& filename);
+
+  //! Reads the name of the next section and checks it against name
+  void beginSection(const std::string& name);
+
+  //! Reads a single value of plain data type
+  template<class T>
+  void read(T& value){readBytes(&value,sizeof(T));}
+
+  //! Reads a raw block of values which is expected to contain exactly n values
+  template<class T>
+  void readArray(T* values, uint64_t n)
+  {
+	  uint64_t storedSize;
+	  read(storedSize);
+	  if(storedSize!=n)
+	  {
+		  std::stringstream errormessage;
+		  errormessage<<"CheckpointReader: array of "<<storedSize<<" elements in file "
+			      <<filename<<" does not match expected size "<<n;
+		  throw std::runtime_error(errormessage.str());
+	  }
+	  if(n>0) readBytes(values,n*sizeof(T));
+  }
+
+  //! Reads the raw block of an array whose size was already read with read()
+  template<class T>
+  void readBlock(T* values, uint64_t n)
+  {
+	  if(n>0) readBytes(values,n*sizeof(T));
+  }
+
+  //! Reads a vector of plain data type, which is resized accordingly
+  template<class T>
+  void readVector(std::vector<T>& values)
+  {
+	  uint64_t storedSize;
+	  read(storedSize);
+	  values.resize(storedSize);
+	  if(storedSize>0) readBytes(&values[0],storedSize*sizeof(T));
+  }
+
+  //! Reads a string
+  void readString(std::string& str);
+
+  //! Checks that the end of the checkpoint was reached
+  void close();
+
+  //! Returns the name of the checkpoint file
+  const std::string& getFilename() const {return filename;}
+
+private:
+  //! no copies, the file is owned by this object
+  CheckpointReader(const CheckpointReader&);
+  CheckpointReader& operator=(const CheckpointReader&);
+
+  void readBytes(void* data, uint64_t n);
+
+  //! Name of the checkpoint file
+  std::string filename;
+  //! The file stream
+  std::ifstream file;
+};
+
+#endif /* LEMONADE_IO_CHECKPOINT_H */
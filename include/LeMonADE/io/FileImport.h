@@ -45,6 +45,8 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <LeMonADE/Version.h>
 #include <LeMonADE/io/AbstractRead.h>
+#include <LeMonADE/io/BfmFileIndex.h>
+#include <LeMonADE/io/MappedFileBuffer.h>
 #include <LeMonADE/io/Parser.h>
 
 
@@ -59,6 +61,12 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  *
  * @brief Manages the import of data from .bfm files
  *
+ * @details initialize() scans the file for the positions of all frames. Optionally
+ * (see setUseFrameIndex()) the positions are cached in the sidecar index file
+ * <filename>.idx, such that large trajectories are not scanned again when they are
+ * opened the next time. The index is disabled by default, because it writes a
+ * file next to the input, which may be read-only or shared.
+ *
  * @tparam IngredientsType Ingredients class storing all system information( e.g. monomers, bonds, etc).
  */
 template <class IngredientsType>
@@ -66,7 +74,7 @@ class FileImport{
 
 public:
 
-  FileImport(const std::string& sourcefile,IngredientsType& dataStorage);
+  FileImport(const std::string& sourcefile,IngredientsType& dataStorage,bool useMemoryMap=true);
   virtual ~FileImport();
 
 
@@ -87,6 +95,9 @@ public:
 	  //bfmData.synchronize(bfmData);
   }
 
+  //! Read the header and take the frame positions from an initialized FileImport of the same file
+  void initialize(const FileImport<IngredientsType>& scannedFile);
+
   //! Parse and process bfm-file up to first conformation (incl. read-in first !mcs)
   void readHeader();
 
@@ -96,6 +107,9 @@ public:
   //! Jumps to the given !mcs in the file and reads it (unsafely forward-winding).
   bool gotoMcs(uint64_t mcs);
 
+  //! Processes the commands following the last conformation in the file, without reading the conformation again.
+  bool readAfterLastFrame();
+
   //! Jumps to the given frame in the file and reads it (unsafely forward/reverse-winding).
   bool gotoFrame(uint32_t frame);
 
@@ -118,6 +132,17 @@ public:
   //! Returns the number of frames (occurrence of !mcs) in the file.
   uint32_t getNumFrames(){return framePositionInFile.size();}
 
+  /**
+   * @brief Returns true if other commands than !mcs are read together with the frame
+   *
+   * @details These are all commands between the previous and this !mcs, e.g. !add_bonds
+   * or !remove_bonds. Frames without such commands only change the monomer data and can
+   * be decoded independently of each other (see FileImportPipeline).
+   *
+   * @param frame The frame number (starting at 1)
+   */
+  bool frameHasCommands(uint32_t frame) const {return framesWithCommands.count(frame)>0;}
+
 
 
   //! Returns the recent frames (occurrence of !mcs) in the file.
@@ -151,7 +176,20 @@ public:
   void setFilename(std::string filename){this->filename = filename;}
 
   //! Close the file stream.
-  void close(){file.close();};
+  void close(){mappedBuffer.close();fileBuffer.close();file.setstate(std::ios_base::badbit);};
+
+  //! Returns true if the file is read from a memory mapping instead of a file stream
+  bool isMemoryMapped() const {return mappedBuffer.is_open();}
+
+  /**
+   * @brief Enable or disable the sidecar frame index (default: disabled)
+   * @details Must be called before initialize() to take effect.
+   * @param use If true, the frame positions are read from and written to <filename>.idx
+   */
+  void setUseFrameIndex(bool use){useFrameIndex=use;}
+
+  //! Returns true if the sidecar frame index is used
+  bool getUseFrameIndex() const {return useFrameIndex;}
 
   //! Get pointer to data container
   IngredientsType& getDestination(){return bfmData;}
@@ -165,8 +203,14 @@ private:
   //! Name of bfm-file with file suffix *.bfm
   std::string filename;
 
-  //! File stream associated with the input file (FileImport::file)
-  std::ifstream file;
+  //! Memory mapping of the input file (default backend)
+  MappedFileBuffer mappedBuffer;
+
+  //! Conventional file buffer, used if the file cannot be memory mapped
+  std::filebuf fileBuffer;
+
+  //! Input stream associated with the input file, reading from mappedBuffer or fileBuffer
+  std::istream file;
 
   //! Parser that finds and returns Read strings from input file
   Parser parser;
@@ -193,6 +237,15 @@ private:
   //! Maps frame number to mcs.
   std::map<uint32_t,uint64_t> framePositionInFile;
 
+  //! Frame numbers of the frames with other commands than !mcs
+  std::set<uint32_t> framesWithCommands;
+
+  //! Persistent index of the frame positions, avoids scanning the complete file
+  BfmFileIndex frameIndex;
+
+  //! If true, the frame positions are taken from and stored in frameIndex
+  bool useFrameIndex;
+
   //saves the complete first conformation. this is useful for
   //jumping back to the first conformation
   //! Holing the first conformation in the file. Useful for rewinding.
@@ -201,6 +254,9 @@ private:
   //! Scans the complete file for the positions of the !mcs commands
   void scanFile();
 
+  //! Adds the position of a frame found by scanFile() to the maps and the frame index
+  void addFramePosition(uint64_t mcs, std::streampos position, bool hasCommands);
+
 };
 
 /***********************************************************************
@@ -218,19 +274,29 @@ private:
  * the Feature, reading the header of the file, and scans for all commands. At the end it synchronizes
  * itself with the Ingredients.
  *
+ * By default the file is memory mapped and the reads on the hot path (e.g. !mcs, !bonds)
+ * decode the data directly from the mapped bytes. If the file cannot be mapped, or if
+ * \a useMemoryMap is false, a conventional file stream is used instead.
+ *
  * @throw <std::runtime_error> No File Access.
  * @param sourcefile Name of the file to read in
  * @param dataStorage Class holding all information of the system (mainly Ingredients )
+ * @param useMemoryMap Read from a memory mapping of the file if possible (default)
  *
  * @todo Did I understand that correctly that the first !mcs is read not the last in the file?
  */
 template <class IngredientsType>
-FileImport<IngredientsType>::FileImport(const std::string& sourcefile,IngredientsType& dataStorage)
-  :bfmData(dataStorage),filename(sourcefile),parser(file),firstMcs(0)
+FileImport<IngredientsType>::FileImport(const std::string& sourcefile,IngredientsType& dataStorage,bool useMemoryMap)
+  :bfmData(dataStorage),filename(sourcefile),file(0),parser(file),firstMcs(0)
+  ,frameIndex(sourcefile),useFrameIndex(false)
 {
-  //open the source file
-  file.open(sourcefile.c_str(),std::ios_base::in|std::ios_base::binary);
-  if(file.fail()) throw std::runtime_error(std::string("error opening input file ")+sourcefile+std::string("\n"));
+  //open the source file. use the memory mapping if possible
+  if(useMemoryMap && mappedBuffer.open(sourcefile))
+	  file.rdbuf(&mappedBuffer);
+  else if(fileBuffer.open(sourcefile.c_str(),std::ios_base::in|std::ios_base::binary))
+	  file.rdbuf(&fileBuffer);
+
+  if(file.rdbuf()==0 || file.fail()) throw std::runtime_error(std::string("error opening input file ")+sourcefile+std::string("\n"));
 
   //the features' read-Reads are registered here!!
   bfmData.exportRead(*this);
@@ -452,6 +518,11 @@ void FileImport<IngredientsType>::executeRead(const std::string& ReadString)
  * the map mcsPositionInFile. The positions saved there are right after the
  * previous !mcs. It does \b NOT parse the !mcs nor it sets any system informations.
  *
+ * If enabled by setUseFrameIndex(), the positions are stored in the sidecar index
+ * file <filename>.idx (see BfmFileIndex). If a valid index exists, the positions are taken from it without scanning the file.
+ * If the file has grown since the index was written, only the new part of the file is
+ * scanned and the new frames are appended to the index.
+ *
  * @throw <runtime_error> if IO-error (different from eof) occurs.
  *
  * @todo Rename to scanFileForMCS()!
@@ -459,8 +530,6 @@ void FileImport<IngredientsType>::executeRead(const std::string& ReadString)
 template <class IngredientsType>
 void FileImport<IngredientsType>::scanFile()
 {
-	std::cout<<"scanning file...this may take some seconds for large files...";
-	std::cout.flush();
 	//save this position and return to it after the operation
 	std::streampos startingPosition=file.tellg();
 
@@ -468,29 +537,76 @@ void FileImport<IngredientsType>::scanFile()
 	std::streampos mcsPosition;
 	uint64_t mcs;
 
-	//first go to the beginning of the file and find the position of
-	//the first mcs command. this position is not saved, because it
-	//is not necessarily clear, which commands preceeding the first
-	// !mcs area part of this !mcs (e.g. solvent). Therefore, the
-	//complete first conformation is saved in readHeader().
 	file.clear();
 	mcsPositionInFile.clear();
 	framePositionInFile.clear();
-	file.seekg(0,std::ios::beg);
+	framesWithCommands.clear();
+
+	//number of bytes visible to the input stream
+	file.seekg(0,std::ios::end);
+	uint64_t scannedSize=uint64_t(std::streamoff(file.tellg()));
 
-	//the information of the first frame/conformation is read-in by readHeader()
-	while(!file.fail() && (read != "endoffile"))
+	//take over the frames from the sidecar index, if it matches the file
+	BfmFileIndex::Status indexStatus=BfmFileIndex::Missing;
+	if(useFrameIndex) indexStatus=frameIndex.load();
+	else frameIndex.clear();
+
+	if(indexStatus==BfmFileIndex::Valid || indexStatus==BfmFileIndex::Grown)
 	{
-		mcsPosition=file.tellg();
+		const std::vector<BfmFileIndex::Entry>& entries=frameIndex.getEntries();
+		for(size_t n=0;n<entries.size() && entries[n].offset<scannedSize;n++)
+		{
+			mcsPositionInFile.insert(std::make_pair(entries[n].mcs,std::streampos(std::streamoff(entries[n].offset))));
+			framePositionInFile.insert(std::make_pair(mcsPositionInFile.size(),entries[n].mcs));
+			if(entries[n].flags & BfmFileIndex::HasCommands)
+				framesWithCommands.insert(mcsPositionInFile.size());
+		}
+	}
 
-		read=parser.findRead();
+	if(indexStatus==BfmFileIndex::Valid || (indexStatus==BfmFileIndex::Grown && scannedSize<=frameIndex.getIndexedFileSize()))
+	{
+		std::cout<<"using frame index "<<frameIndex.getIndexFilename()<<"\n";
+		file.clear();
+		file.seekg(startingPosition);
+		return;
+	}
 
-		if (read=="!mcs")
+	std::cout<<"scanning file...this may take some seconds for large files...";
+	std::cout.flush();
+
+	file.clear();
+
+	if(indexStatus==BfmFileIndex::Grown && !mcsPositionInFile.empty())
+	{
+		//the file has grown: continue scanning at the last indexed frame
+		file.seekg(std::streampos(std::streamoff(frameIndex.getEntries().back().offset)));
+	}
+	else
+	{
+		//first go to the beginning of the file and find the position of
+		//the first mcs command. this position is not saved, because it
+		//is not necessarily clear, which commands preceeding the first
+		// !mcs area part of this !mcs (e.g. solvent). Therefore, the
+		//complete first conformation is saved in readHeader().
+		mcsPositionInFile.clear();
+		framePositionInFile.clear();
+		framesWithCommands.clear();
+		frameIndex.clear();
+		file.seekg(0,std::ios::beg);
+
+		//the information of the first frame/conformation is read-in by readHeader()
+		while(!file.fail() && (read != "endoffile"))
 		{
-			file>>mcs;
-			mcsPositionInFile.insert(std::make_pair(mcs,mcsPosition));
-			framePositionInFile.insert(std::make_pair(mcsPositionInFile.size(),mcs));
-			break;
+			mcsPosition=file.tellg();
+
+			read=parser.findRead();
+
+			if (read=="!mcs")
+			{
+				file>>mcs;
+				addFramePosition(mcs,mcsPosition,false);
+				break;
+			}
 		}
 	}
 
@@ -501,9 +617,13 @@ void FileImport<IngredientsType>::scanFile()
 
 		mcsPosition=file.tellg();
 
+		//remember if other commands are read with this frame
+		bool hasCommands=false;
+
 		read=parser.findRead();
 		while(read!="!mcs" && !file.fail() && read!="endoffile" )
 			{
+			hasCommands=true;
 			read=parser.findRead();
 
 			}
@@ -518,10 +638,14 @@ void FileImport<IngredientsType>::scanFile()
 			throw std::runtime_error(errormessage.str());
 		}
 		//std::cout<<"insterting mcs "<<mcs<<" at filepointer pos "<<mcsPosition<<std::endl;
-		mcsPositionInFile.insert(std::make_pair(mcs,mcsPosition));
-		framePositionInFile.insert(std::make_pair(mcsPositionInFile.size(),mcs));
+		addFramePosition(mcs,mcsPosition,hasCommands);
 	}
 
+	//store the positions for the next time the file is opened. failing to
+	//write the index (e.g. read-only directory) is not an error
+	if(useFrameIndex && !(frameIndex.setIndexedFile(scannedSize) && frameIndex.save()))
+		std::cerr<<"\nWARNING: could not write frame index "<<frameIndex.getIndexFilename()<<"\n";
+
 	//go back to the position the file was at before this function was called
 	file.clear();
 	file.seekg(startingPosition);
@@ -530,6 +654,86 @@ void FileImport<IngredientsType>::scanFile()
 
 }
 
+/**
+ * @details Like initialize(), but instead of scanning the file (or loading its sidecar
+ * index) the frame positions are copied from another FileImport that has already been
+ * initialized on the same file. This is used to set up several readers of one file,
+ * e.g. the decoders of FileImportPipeline, without scanning the file once per reader.
+ *
+ * @param scannedFile Initialized FileImport reading the same file
+ * @throw <runtime_error> if scannedFile reads a different file or has not been initialized
+ **/
+template <class IngredientsType>
+void FileImport<IngredientsType>::initialize(const FileImport<IngredientsType>& scannedFile)
+{
+	if(scannedFile.filename!=filename || scannedFile.mcsPositionInFile.empty())
+	{
+		std::stringstream errormessage;
+		errormessage<<"FileImport::initialize(): cannot take the frame positions of "<<filename
+		            <<" from the uninitialized or different file "<<scannedFile.filename<<"\n";
+		throw std::runtime_error(errormessage.str());
+	}
+
+	readHeader();
+
+	mcsPositionInFile=scannedFile.mcsPositionInFile;
+	framePositionInFile=scannedFile.framePositionInFile;
+	framesWithCommands=scannedFile.framesWithCommands;
+}
+
+/**
+ * @details Positions of mcs that are already known are ignored.
+ *
+ * @param mcs The time of the frame
+ * @param position Position in the file from where the frame is read
+ * @param hasCommands True if other commands than !mcs are read with the frame
+ **/
+template <class IngredientsType>
+void FileImport<IngredientsType>::addFramePosition(uint64_t mcs, std::streampos position, bool hasCommands)
+{
+	if(mcsPositionInFile.insert(std::make_pair(mcs,position)).second)
+	{
+		framePositionInFile.insert(std::make_pair(mcsPositionInFile.size(),mcs));
+		if(hasCommands) framesWithCommands.insert(mcsPositionInFile.size());
+		frameIndex.addEntry(mcs,uint64_t(std::streamoff(position)),hasCommands?BfmFileIndex::HasCommands:0);
+	}
+}
+
+/**
+ * @details Commands following the last !mcs block of the file are processed by
+ * the read() call after the last conformation, which returns false. If the last
+ * conformation was not read sequentially (e.g. by FileImportPipeline), this
+ * function positions the file right behind the last !mcs command, skipping the
+ * commands preceding it, and processes the rest of the file. The commands and the
+ * conformation of the last frame are therefore not executed a second time.
+ *
+ * @throw <runtime_error> if the last !mcs cannot be found at its scanned position
+ * @return The result of read(), i.e. false if the end of the file is reached.
+ */
+template <class IngredientsType>
+bool FileImport<IngredientsType>::readAfterLastFrame()
+{
+	if(framePositionInFile.empty()) return false;
+
+	file.clear();
+	file.seekg(mcsPositionInFile[framePositionInFile.rbegin()->second]);
+
+	std::string read;
+	while(!file.fail() && read!="!mcs" && read!="endoffile")
+		read=parser.findRead();
+
+	uint64_t mcs;
+	if(read=="!mcs") file>>mcs;
+	if(read!="!mcs" || file.fail() || mcs!=framePositionInFile.rbegin()->second)
+	{
+		std::stringstream errormessage;
+		errormessage<<"FileImport::readAfterLastFrame(): last frame not found at its position in "<<filename<<"\n";
+		throw std::runtime_error(errormessage.str());
+	}
+
+	return this->read();
+}
+
 //jumps to the mcs given as argument and reads the conformation
 /**
  * @details IMPORTANT: TOPOLOGY MIGHT NOT BE CORRECT IF IT IS CHANGING SOMEWHERE IN THE
@@ -0,0 +1,511 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_IO_FILEIMPORTPIPELINE_H
+#define LEMONADE_IO_FILEIMPORTPIPELINE_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class template FileImportPipeline
+ * */
+/*****************************************************************************/
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+
+#include <LeMonADE/io/FileImport.h>
+#include <LeMonADE/utility/Threads.h>
+
+/*****************************************************************************/
+/**
+ * @class FileImportPipeline
+ *
+ * @brief Decodes the next frames of a bfm-file on worker threads while the current frame is processed
+ *
+ * @details The pipeline reads the frames of a file that is opened by a FileImport
+ * in sequential order, like FileImport::read(). Up to nFramesAhead frames are
+ * decoded in advance by nThreads decoders, each owning private Ingredients
+ * and its own FileImport of the same file. The decoded monomers are
+ * stored in preallocated buffers and copied into the Ingredients by read().
+ *
+ * Frames are only decoded independently if no other command than !mcs belongs
+ * to them (see FileImport::frameHasCommands()). Frames with commands such as
+ * !add_bonds or !remove_bonds act as a barrier: all previous frames are consumed,
+ * the frame is read sequentially by the main FileImport, and every decoder reads
+ * it as well, such that the state of all decoders stays consistent with the
+ * sequentially read file. The pipeline therefore pays off for trajectories
+ * where such commands are rare.
+ *
+ * The pipeline relies on the frame positions found by FileImport::scanFile(),
+ * i.e. the FileImport must be initialized before start() is called. The
+ * Ingredients of the decoders are default constructed and set up by reading
+ * the header of the file, i.e. the decoded data must not depend on settings
+ * made before reading the file.
+ *
+ * @tparam IngredientsType Ingredients class storing all system information
+ **/
+/*****************************************************************************/
+template<class IngredientsType>
+class FileImportPipeline
+{
+public:
+  typedef typename IngredientsType::molecules_type molecules_type;
+  typedef typename molecules_type::vertex_type vertex_type;
+
+  FileImportPipeline(FileImport<IngredientsType>& fileImport, IngredientsType& ing, uint32_t nThreads, uint32_t nFramesAhead=0);
+  ~FileImportPipeline();
+
+  //! Starts decoding at the given frame (frames count from 1)
+  void start(uint32_t nextFrame);
+
+  //! Reads the next frame into the Ingredients. Returns false if the end of the file is reached.
+  bool read();
+
+  //! Discards all decoded frames and continues at the given frame
+  void restart(uint32_t nextFrame);
+
+  //! Number of frames decoded in advance
+  uint32_t getNFramesAhead() const {return slots.size();}
+
+  //! Number of decoder threads
+  uint32_t getNThreads() const {return decoders.size();}
+
+private:
+
+  //! State of a buffer for one decoded frame
+  enum SlotState {Free, Pending, Decoding, Ready};
+
+  //! Buffer for one decoded frame
+  struct Slot
+  {
+    Slot():frame(0),state(Free),age(0),failed(false){}
+    uint32_t frame;
+    SlotState state;
+    uint64_t age;
+    std::vector<vertex_type> monomers;
+    bool failed;
+    std::string error;
+  };
+
+  //! Worker thread with its own Ingredients and FileImport
+  class Decoder: public Thread
+  {
+  public:
+    Decoder(FileImportPipeline& p, const std::string& filename, bool useFrameIndex)
+      :pipeline(p),ingredients(),file(filename,ingredients),syncFrame(0),failed(false)
+    {
+      file.setUseFrameIndex(useFrameIndex);
+    }
+
+    FileImportPipeline& pipeline;
+    IngredientsType ingredients;
+    FileImport<IngredientsType> file;
+    //! Frame with commands the decoder has to read, 0 if none
+    uint32_t syncFrame;
+    bool failed;
+    std::string error;
+
+  protected:
+    virtual void run(){pipeline.work(*this);}
+  };
+
+  friend class Decoder;
+
+  //! Main loop of the decoder threads
+  void work(Decoder& decoder);
+
+  //! Decodes a frame with the given decoder and stores it in the slot
+  void decode(Decoder& decoder, Slot& slot);
+
+  //! Assigns the next frames to free slots. Must be called with locked mutex.
+  void schedule();
+
+  //! Waits until no slot is being decoded and frees all slots. Must be called with locked mutex.
+  void discardSlots();
+
+  //! Reads a frame with commands in all decoders and the main FileImport
+  bool readFrameWithCommands();
+
+  //! Throws an exception if a decoder failed. Must be called with locked mutex.
+  void checkDecoders();
+
+  //! Stops and joins all decoder threads
+  void stop();
+
+  FileImport<IngredientsType>& file;
+  IngredientsType& ingredients;
+
+  std::vector<Decoder*> decoders;
+  std::vector<Slot> slots;
+
+  //! Next frame to be returned by read()
+  uint32_t nextFrame;
+  //! Last frame assigned to a slot
+  uint32_t lastScheduled;
+  //! Number of decoders that still have to read syncFrame
+  uint32_t nPendingSyncs;
+  //! True if the end of the file was processed
+  bool endOfFile;
+  //! True if the threads have to terminate
+  bool stopping;
+  bool started;
+
+  Mutex mutex;
+  //! Signals new work to the decoders
+  Condition workAvailable;
+  //! Signals finished work to the main thread
+  Condition workDone;
+};
+
+/*****************************************************************************/
+/**
+ * @details The decoders open the file of fileImport. They are initialized in start().
+ *
+ * @param fileImport The FileImport reading the file sequentially
+ * @param ing The Ingredients the frames are read into
+ * @param nThreads Number of decoder threads (at least 1)
+ * @param nFramesAhead Number of frames decoded in advance (default: 2*nThreads)
+ */
+template<class IngredientsType>
+FileImportPipeline<IngredientsType>::FileImportPipeline(FileImport<IngredientsType>& fileImport, IngredientsType& ing, uint32_t nThreads, uint32_t nFramesAhead)
+  :file(fileImport),ingredients(ing),nextFrame(1),lastScheduled(0),nPendingSyncs(0)
+  ,endOfFile(false),stopping(false),started(false)
+{
+	if(nThreads==0) nThreads=1;
+	if(nFramesAhead==0) nFramesAhead=2*nThreads;
+
+	slots.resize(nFramesAhead);
+	for(uint32_t n=0;n<nThreads;n++)
+		decoders.push_back(new Decoder(*this,file.getFilename(),file.getUseFrameIndex()));
+}
+
+template<class IngredientsType>
+FileImportPipeline<IngredientsType>::~FileImportPipeline()
+{
+	stop();
+	for(size_t n=0;n<decoders.size();n++)
+	{
+		delete decoders[n];
+		decoders[n]=0;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @details Initializes the FileImport of every decoder, which reads the header
+ * and takes the frame positions from the main FileImport, such that the file
+ * is not scanned again. Then the decoder threads are started.
+ *
+ * @param firstFrame The next frame read() returns
+ */
+template<class IngredientsType>
+void FileImportPipeline<IngredientsType>::start(uint32_t firstFrame)
+{
+	if(started)
+		throw std::runtime_error("FileImportPipeline::start(): pipeline is already running");
+
+	for(size_t n=0;n<decoders.size();n++)
+		decoders[n]->file.initialize(file);
+
+	nextFrame=firstFrame;
+	lastScheduled=firstFrame-1;
+	started=true;
+
+	for(size_t n=0;n<decoders.size();n++)
+		decoders[n]->start();
+
+	MutexLock lock(mutex);
+	schedule();
+}
+
+template<class IngredientsType>
+void FileImportPipeline<IngredientsType>::stop()
+{
+	{
+		MutexLock lock(mutex);
+		stopping=true;
+		workAvailable.broadcast();
+	}
+	for(size_t n=0;n<decoders.size();n++)
+		decoders[n]->join();
+}
+
+/*****************************************************************************/
+/**
+ * @details Behaves like FileImport::read(): the next frame is read into the
+ * Ingredients. Frames decoded in advance are copied from the buffers, frames
+ * with other commands than !mcs are read sequentially.
+ *
+ * @throw <std::runtime_error> if a decoder failed to read a frame
+ * @return True if a frame was read. False if the end of the file is reached.
+ */
+template<class IngredientsType>
+bool FileImportPipeline<IngredientsType>::read()
+{
+	if(!started)
+		throw std::runtime_error("FileImportPipeline::read(): pipeline was not started");
+
+	if(nextFrame>file.getNumFrames())
+	{
+		//process commands following the last frame once, like the sequential
+		//FileImport would do, without applying the last frame again
+		if(!endOfFile)
+		{
+			endOfFile=true;
+			file.readAfterLastFrame();
+		}
+		return false;
+	}
+
+	if(file.frameHasCommands(nextFrame))
+		return readFrameWithCommands();
+
+	Slot& slot=slots[nextFrame%slots.size()];
+	{
+		MutexLock lock(mutex);
+		schedule();
+		while(!(slot.frame==nextFrame && slot.state==Ready))
+		{
+			checkDecoders();
+			workDone.wait(mutex);
+		}
+	}
+
+	if(slot.failed)
+	{
+		std::stringstream errormessage;
+		errormessage<<"FileImportPipeline::read(): error decoding frame "<<nextFrame<<"\n"<<slot.error;
+		throw std::runtime_error(errormessage.str());
+	}
+
+	//copy the monomers. the connectivity is not affected
+	molecules_type& molecules=ingredients.modifyMolecules();
+	if(molecules.size()!=slot.monomers.size())
+	{
+		std::stringstream errormessage;
+		errormessage<<"FileImportPipeline::read(): frame "<<nextFrame<<" contains "<<slot.monomers.size()
+		            <<" monomers, expected "<<molecules.size()<<"\n";
+		throw std::runtime_error(errormessage.str());
+	}
+	for(size_t n=0;n<slot.monomers.size();n++)
+		molecules[n]=slot.monomers[n];
+	molecules.setAge(slot.age);
+
+	MutexLock lock(mutex);
+	slot.state=Free;
+	nextFrame++;
+	schedule();
+
+	return true;
+}
+
+/*****************************************************************************/
+/**
+ * @details All frames before were already consumed, so the decoders are idle.
+ * Every decoder reads the frame such that the commands are applied to its
+ * Ingredients, while the main FileImport reads it into the Ingredients.
+ */
+template<class IngredientsType>
+bool FileImportPipeline<IngredientsType>::readFrameWithCommands()
+{
+	uint32_t frame=nextFrame;
+	{
+		MutexLock lock(mutex);
+		discardSlots();
+		for(size_t n=0;n<decoders.size();n++)
+			decoders[n]->syncFrame=frame;
+		nPendingSyncs=decoders.size();
+		workAvailable.broadcast();
+	}
+
+	file.gotoFrame(frame);
+
+	MutexLock lock(mutex);
+	while(nPendingSyncs>0)
+	{
+		checkDecoders();
+		workDone.wait(mutex);
+	}
+	checkDecoders();
+
+	nextFrame=frame+1;
+	lastScheduled=frame;
+	schedule();
+
+	return true;
+}
+
+/*****************************************************************************/
+/**
+ * @details Used after jumping to a different position in the file with the
+ * main FileImport. As for FileImport::gotoFrame(), commands of skipped
+ * frames are not processed. The decoders take over the connectivity of the
+ * Ingredients, such that they continue from the same state as the main FileImport.
+ *
+ * @param frame The next frame read() returns
+ */
+template<class IngredientsType>
+void FileImportPipeline<IngredientsType>::restart(uint32_t frame)
+{
+	MutexLock lock(mutex);
+	discardSlots();
+	//the decoders are idle now, they only wait for work
+	for(size_t n=0;n<decoders.size();n++)
+		decoders[n]->ingredients.modifyMolecules()=ingredients.getMolecules();
+	nextFrame=frame;
+	lastScheduled=frame-1;
+	endOfFile=false;
+	schedule();
+}
+
+/*****************************************************************************/
+template<class IngredientsType>
+void FileImportPipeline<IngredientsType>::schedule()
+{
+	uint32_t nFrames=file.getNumFrames();
+	while(lastScheduled+1<nextFrame+slots.size() && lastScheduled+1<=nFrames && !file.frameHasCommands(lastScheduled+1))
+	{
+		lastScheduled++;
+		Slot& slot=slots[lastScheduled%slots.size()];
+		slot.frame=lastScheduled;
+		slot.state=Pending;
+		slot.failed=false;
+	}
+	workAvailable.broadcast();
+}
+
+/*****************************************************************************/
+template<class IngredientsType>
+void FileImportPipeline<IngredientsType>::discardSlots()
+{
+	for(size_t n=0;n<slots.size();n++)
+	{
+		while(slots[n].state==Decoding) workDone.wait(mutex);
+		slots[n].state=Free;
+	}
+	lastScheduled=nextFrame-1;
+}
+
+/*****************************************************************************/
+template<class IngredientsType>
+void FileImportPipeline<IngredientsType>::checkDecoders()
+{
+	for(size_t n=0;n<decoders.size();n++)
+	{
+		if(decoders[n]->failed)
+		{
+			std::stringstream errormessage;
+			errormessage<<"FileImportPipeline: decoder "<<n<<" failed\n"<<decoders[n]->error;
+			throw std::runtime_error(errormessage.str());
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @details The decoder waits for frames with commands it has to read
+ * (syncFrame) and for pending slots, which are decoded in the order of the frames.
+ */
+template<class IngredientsType>
+void FileImportPipeline<IngredientsType>::work(Decoder& decoder)
+{
+	MutexLock lock(mutex);
+	while(!stopping)
+	{
+		//frames with commands are read first, no frame after them is pending
+		if(decoder.syncFrame!=0)
+		{
+			uint32_t frame=decoder.syncFrame;
+			mutex.unlock();
+			try
+			{
+				decoder.file.gotoFrame(frame);
+			}
+			catch(std::exception& e)
+			{
+				decoder.error=e.what();
+				decoder.failed=true;
+			}
+			mutex.lock();
+			decoder.syncFrame=0;
+			nPendingSyncs--;
+			workDone.broadcast();
+			if(decoder.failed) return;
+			continue;
+		}
+
+		//find the pending frame with the smallest frame number
+		Slot* next=0;
+		for(size_t n=0;n<slots.size();n++)
+			if(slots[n].state==Pending && (next==0 || slots[n].frame<next->frame))
+				next=&slots[n];
+
+		if(next==0)
+		{
+			workAvailable.wait(mutex);
+			continue;
+		}
+
+		next->state=Decoding;
+		mutex.unlock();
+		decode(decoder,*next);
+		mutex.lock();
+		next->state=Ready;
+		workDone.broadcast();
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @details Called without locked mutex. Only the decoder's own FileImport and
+ * the slot, which is marked as Decoding, are accessed.
+ */
+template<class IngredientsType>
+void FileImportPipeline<IngredientsType>::decode(Decoder& decoder, Slot& slot)
+{
+	try
+	{
+		decoder.file.gotoFrame(slot.frame);
+
+		const molecules_type& molecules=decoder.ingredients.getMolecules();
+		slot.monomers.resize(molecules.size());
+		for(size_t n=0;n<molecules.size();n++)
+			slot.monomers[n]=molecules[n];
+		slot.age=molecules.getAge();
+	}
+	catch(std::exception& e)
+	{
+		slot.failed=true;
+		slot.error=e.what();
+	}
+}
+
+#endif /* LEMONADE_IO_FILEIMPORTPIPELINE_H */
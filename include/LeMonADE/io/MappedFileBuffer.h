@@ -0,0 +1,156 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_IO_MAPPEDFILEBUFFER_H
+#define LEMONADE_IO_MAPPEDFILEBUFFER_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class MappedFileBuffer
+ * */
+/*****************************************************************************/
+
+#include <streambuf>
+#include <string>
+#include <cstring>
+#include <stdint.h>
+
+/*****************************************************************************/
+/**
+ * @class MappedFileBuffer
+ *
+ * @brief Read-only stream buffer on top of a memory mapped file
+ *
+ * @details The complete file is mapped into memory and used directly as the
+ * get area of the stream buffer, i.e. no data is copied when reading. The
+ * buffer can be used with an ordinary std::istream, such that all reading
+ * routines working on streams (AbstractRead) continue to work. Reading routines
+ * on the hot path (e.g. !mcs, !bonds, !attributes) can additionally access the
+ * mapped bytes directly through position(), end() and setPosition() and decode
+ * the data without creating temporary strings or stringstreams. The static
+ * helper functions provide the necessary zero-copy tokenizing.
+ * */
+/*****************************************************************************/
+class MappedFileBuffer: public std::streambuf
+{
+public:
+  MappedFileBuffer();
+  virtual ~MappedFileBuffer();
+
+  //! Maps the file into memory. Returns false if the file cannot be mapped (e.g. empty file).
+  bool open(const std::string& filename);
+
+  //! Unmaps the file
+  void close();
+
+  //! True if a file is currently mapped
+  bool is_open() const {return data!=0;}
+
+  //! Size of the mapped file in bytes
+  size_t size() const {return length;}
+
+  //! Pointer to the current read position in the mapped file
+  const char* position() const {return gptr();}
+
+  //! Pointer to the first byte behind the mapped file
+  const char* end() const {return egptr();}
+
+  //! Moves the read position to pos, which must point into the mapped file
+  void setPosition(const char* pos){setg(eback(),const_cast<char*>(pos),egptr());}
+
+  //! Returns a pointer to the next newline in [pos,end) or end if there is none
+  static const char* findLineEnd(const char* pos, const char* end)
+  {
+	  const char* lineEnd=static_cast<const char*>(std::memchr(pos,'\n',end-pos));
+	  return (lineEnd==0)?end:lineEnd;
+  }
+
+  //! Advances pos behind all whitespace characters (like operator>> does)
+  static void skipWhitespace(const char*& pos, const char* end)
+  {
+	  while(pos!=end && (*pos==' ' || (*pos>='\t' && *pos<='\r'))) ++pos;
+  }
+
+  //! Decodes a decimal integer at pos (leading whitespace skipped) and advances pos behind it
+  template<class IntType>
+  static bool parseInteger(const char*& pos, const char* end, IntType& value);
+
+protected:
+  virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which=std::ios_base::in);
+  virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which=std::ios_base::in);
+  virtual std::streamsize showmanyc();
+
+private:
+  //! no copies, the mapping is owned by this object
+  MappedFileBuffer(const MappedFileBuffer&);
+  MappedFileBuffer& operator=(const MappedFileBuffer&);
+
+  //! Start of the mapped memory
+  char* data;
+  //! Length of the mapped memory in bytes
+  size_t length;
+};
+
+/**
+ * @details Behaves like operator>> for integral types: leading whitespace
+ * is ignored, an optional sign is accepted and at least one digit is required.
+ * On failure pos is left unchanged.
+ *
+ * @param pos Current position, moved behind the number on success
+ * @param end End of the readable range
+ * @param value The decoded number
+ * @return True if a number could be decoded
+ */
+template<class IntType>
+bool MappedFileBuffer::parseInteger(const char*& pos, const char* end, IntType& value)
+{
+	const char* cur=pos;
+	skipWhitespace(cur,end);
+
+	bool negative=false;
+	if(cur!=end && (*cur=='-' || *cur=='+'))
+	{
+		negative=(*cur=='-');
+		++cur;
+	}
+
+	if(cur==end || *cur<'0' || *cur>'9') return false;
+
+	IntType result=0;
+	while(cur!=end && *cur>='0' && *cur<='9')
+	{
+		result=result*10+IntType(*cur-'0');
+		++cur;
+	}
+
+	value=negative?IntType(0)-result:result;
+	pos=cur;
+	return true;
+}
+
+#endif /* LEMONADE_IO_MAPPEDFILEBUFFER_H */
@@ -39,6 +39,8 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <fstream>
 #include <iostream>
 
+#include <LeMonADE/io/MappedFileBuffer.h>
+
 /*****************************************************************************/
 /**
  * @class Parser
@@ -60,6 +62,9 @@ public:
   std::string findRead();
 
 private:
+  //! Zero-copy implementation of findRead() for memory mapped input
+  std::string findReadMapped(MappedFileBuffer& buffer);
+
   //! Stream to be parsed
   std::istream& stream;
 };
@@ -0,0 +1,128 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_IO_SYSTEMCHECKPOINT_H
+#define LEMONADE_IO_SYSTEMCHECKPOINT_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Functions for writing and reading complete checkpoints of a simulation
+ *
+ * @details A system checkpoint contains the complete state of the Ingredients
+ * (Molecules and all features), the state of the random number generators and,
+ * optionally, the cycle counter and task states of a TaskManager. Restarting
+ * from a checkpoint continues the simulation bit-identically to an uninterrupted
+ * run, provided the same executable is used and the TaskManager is set up with
+ * the same updaters and analyzers. Loading does not call synchronize(), all
+ * derived data (lattices, lookup tables) is restored directly.
+ *
+ * Example:
+ * \code
+ * //...setting up ingredients and taskmanager as for the first run
+ * taskmanager.initialize();
+ * readSystemCheckpoint("restart.chk",ingredients,&taskmanager);
+ * taskmanager.run(nCycles);
+ * \endcode
+ * */
+/*****************************************************************************/
+
+#include <string>
+
+#include <LeMonADE/io/Checkpoint.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+#include <LeMonADE/utility/TaskManager.h>
+
+/**
+ * @brief Writes a complete checkpoint of the simulation to a file
+ *
+ * @details The file is replaced atomically, i.e. an existing checkpoint of
+ * the same name remains valid until the new one is completely written.
+ *
+ * @param filename Name of the checkpoint file
+ * @param ingredients The system to be stored
+ * @param taskmanager TaskManager whose state is stored, may be NULL
+ */
+template<class IngredientsType>
+void writeSystemCheckpoint(const std::string& filename,
+			   const IngredientsType& ingredients,
+			   const TaskManager* taskmanager=NULL)
+{
+	CheckpointWriter checkpoint(filename);
+
+	ingredients.saveCheckpoint(checkpoint);
+
+	RandomNumberGenerators rng;
+	rng.saveCheckpoint(checkpoint);
+
+	checkpoint.beginSection("SystemCheckpoint");
+	checkpoint.write(bool(taskmanager!=NULL));
+	if(taskmanager!=NULL) taskmanager->saveCheckpoint(checkpoint);
+
+	checkpoint.close();
+}
+
+/**
+ * @brief Restores the state of the simulation from a checkpoint file
+ *
+ * @details The ingredients have to be of the same type as the ones used to write
+ * the checkpoint. If a TaskManager is given, its cycle counter is restored
+ * and it has to hold the same number of updaters and analyzers as the one
+ * used for writing. If the checkpoint contains no TaskManager state, the
+ * TaskManager is left unchanged. If no TaskManager is given, a stored
+ * TaskManager state is ignored.
+ *
+ * @throw <std::runtime_error> if the file cannot be read or does not match the system
+ *
+ * @param filename Name of the checkpoint file
+ * @param ingredients The system to be restored
+ * @param taskmanager TaskManager whose state is restored, may be NULL
+ */
+template<class IngredientsType>
+void readSystemCheckpoint(const std::string& filename,
+			  IngredientsType& ingredients,
+			  TaskManager* taskmanager=NULL)
+{
+	CheckpointReader checkpoint(filename);
+
+	ingredients.loadCheckpoint(checkpoint);
+
+	RandomNumberGenerators rng;
+	rng.loadCheckpoint(checkpoint);
+
+	checkpoint.beginSection("SystemCheckpoint");
+	bool hasTaskManager;
+	checkpoint.read(hasTaskManager);
+	//a stored state is still read without TaskManager, such that close()
+	//checks the complete file
+	if(hasTaskManager && taskmanager!=NULL) taskmanager->loadCheckpoint(checkpoint);
+	else if(hasTaskManager) TaskManager::skipCheckpoint(checkpoint);
+
+	checkpoint.close();
+}
+
+#endif /* LEMONADE_IO_SYSTEMCHECKPOINT_H */
@@ -0,0 +1,153 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_IO_TEXTBUFFER_H
+#define LEMONADE_IO_TEXTBUFFER_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class TextBuffer
+ * */
+/*****************************************************************************/
+
+#include <ostream>
+#include <vector>
+#include <cstring>
+#include <stdint.h>
+
+/*****************************************************************************/
+/**
+ * @class TextBuffer
+ *
+ * @brief Growable character buffer for formatting output without temporary objects
+ *
+ * @details Writing routines producing large amounts of text per frame (e.g.
+ * WriteMcs) can format their output into a TextBuffer, which is kept between
+ * frames. clear() keeps the allocated memory, such that after the first frame
+ * no memory is allocated anymore. Integers are converted by appendInteger()
+ * without using streams. The contents are written to a stream in a single
+ * call of writeTo().
+ * */
+/*****************************************************************************/
+class TextBuffer
+{
+public:
+  TextBuffer():length(0){}
+
+  //! Removes the contents, the allocated memory is kept
+  void clear(){length=0;}
+
+  //! Number of characters in the buffer
+  size_t size() const {return length;}
+
+  //! Pointer to the contents, not null-terminated
+  const char* data() const {return buffer.empty()?0:&buffer[0];}
+
+  //! Appends a single character
+  void append(char c)
+  {
+	  reserve(1);
+	  buffer[length++]=c;
+  }
+
+  //! Appends n characters
+  void append(const char* str, size_t n)
+  {
+	  reserve(n);
+	  std::memcpy(&buffer[length],str,n);
+	  length+=n;
+  }
+
+  //! Appends a null-terminated string
+  void append(const char* str){append(str,std::strlen(str));}
+
+  //! Appends the decimal representation of an integer, like operator<< does
+  template<class IntType>
+  void appendInteger(IntType value);
+
+  //! Writes the contents to strm with a single write
+  void writeTo(std::ostream& strm) const
+  {
+	  if(length>0) strm.write(&buffer[0],length);
+  }
+
+private:
+  //! Makes sure that n more characters fit into the buffer
+  void reserve(size_t n)
+  {
+	  if(length+n>buffer.size())
+	  {
+		  size_t newSize=2*buffer.size();
+		  if(newSize<length+n) newSize=length+n;
+		  if(newSize<256) newSize=256;
+		  buffer.resize(newSize);
+	  }
+  }
+
+  //! the allocated memory, only the first length characters are used
+  std::vector<char> buffer;
+  size_t length;
+};
+
+/**
+ * @details The digits are generated from the back into a small local array.
+ * Negative numbers are converted digit by digit without negating the value,
+ * such that also the smallest value of signed types is handled correctly.
+ *
+ * @param value Integer to be appended
+ */
+template<class IntType>
+void TextBuffer::appendInteger(IntType value)
+{
+	char digits[24];
+	char* end=digits+sizeof(digits);
+	char* pos=end;
+
+	//written such that no warning is issued for unsigned types
+	bool negative=!(value>IntType(0)) && value!=IntType(0);
+
+	if(negative)
+	{
+		do{
+			*--pos=char('0'-int(value%10));
+			value/=10;
+		}while(value!=IntType(0));
+		*--pos='-';
+	}
+	else
+	{
+		do{
+			*--pos=char('0'+int(value%10));
+			value/=10;
+		}while(value!=IntType(0));
+	}
+
+	append(pos,size_t(end-pos));
+}
+
+#endif /* LEMONADE_IO_TEXTBUFFER_H */
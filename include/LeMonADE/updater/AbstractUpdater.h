@@ -28,6 +28,8 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef LEMONADE_UPDATER_ABSTRACTUPDATER_H
 #define LEMONADE_UPDATER_ABSTRACTUPDATER_H
 
+#include <stdint.h>
+
 /**
  * @file
  *
@@ -43,8 +45,8 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 class AbstractUpdater
 {
 public:
-	//! Standard constructor (empty)
-  AbstractUpdater(){}
+	//! Standard constructor, sets the work counters to zero
+  AbstractUpdater():attemptedMoves(0),acceptedMoves(0),performedMcs(0){}
 
   //! Standard destructor (empty)
   virtual ~AbstractUpdater(){}
@@ -76,6 +78,40 @@ public:
    *
    **/
   virtual void cleanup() = 0;
+
+  //! Total number of moves attempted by this updater, as reported with addWorkCounters()
+  uint64_t getAttemptedMoves() const {return attemptedMoves;}
+
+  //! Total number of moves accepted by this updater, as reported with addWorkCounters()
+  uint64_t getAcceptedMoves() const {return acceptedMoves;}
+
+  //! Total number of Monte Carlo steps performed by this updater, as reported with addWorkCounters()
+  uint64_t getPerformedMcs() const {return performedMcs;}
+
+protected:
+  /**
+   * @brief Reports work done in execute() for the statistics of the TaskManager.
+   *
+   * @details Updaters performing Monte Carlo moves should call this once per
+   * execute() with the numbers of this call. The counters are optional, updaters
+   * not reporting anything appear with zero work in the statistics.
+   *
+   * @param attempted number of attempted moves
+   * @param accepted number of accepted (applied) moves
+   * @param mcs number of Monte Carlo steps
+   **/
+  void addWorkCounters(uint64_t attempted, uint64_t accepted, uint64_t mcs)
+  {
+	  attemptedMoves+=attempted;
+	  acceptedMoves+=accepted;
+	  performedMcs+=mcs;
+  }
+
+private:
+  //! Work counters, see addWorkCounters()
+  uint64_t attemptedMoves;
+  uint64_t acceptedMoves;
+  uint64_t performedMcs;
 };
 
 
@@ -0,0 +1,188 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_ABSTRACT_ADD_MOLECULES_H
+#define LEMONADE_UPDATER_ABSTRACT_ADD_MOLECULES_H
+/**
+ * @file
+ *
+ * @class UpdaterAbstractAddMolecules
+ *
+ * @brief Abstract updater adding a number of molecules of given architectures
+ *
+ * @details Derived classes only describe their architecture by implementing
+ * getNumberOfMolecules() and getMolecule(), which returns the parent and the
+ * attribute tag of every monomer of a molecule (see
+ * UpdaterAbstractCreate::addMolecule()). This class adds the molecules one
+ * after the other, such that the monomers of every molecule are stored
+ * consecutively in the order given by getMolecule(). Optionally the whole
+ * system is relaxed with moveSystem() after every molecule and after the last
+ * one. This updater requires FeatureAttributes.
+ *
+ * @tparam IngredientsType
+ **/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/updater/UpdaterAbstractCreate.h>
+
+template<class IngredientsType>
+class UpdaterAbstractAddMolecules: public UpdaterAbstractCreate<IngredientsType>
+{
+  typedef UpdaterAbstractCreate<IngredientsType> BaseClass;
+
+public:
+  UpdaterAbstractAddMolecules(IngredientsType& ingredients_, const std::string& name_);
+
+  virtual void initialize();
+  virtual bool execute();
+  virtual void cleanup();
+
+  //! number of molecules added by the updater
+  virtual uint32_t getNumberOfMolecules() const=0;
+
+  //! parents (negative for none) and attribute tags of the monomers of molecule m
+  virtual void getMolecule(uint32_t m, std::vector<int32_t>& parents, std::vector<int32_t>& types) const=0;
+
+  //! total number of monomers added by the updater
+  uint64_t getNumberOfMonomers() const;
+
+  //! set the number of MCS of moveSystem() after every molecule and after the last one
+  void setRelaxationSteps(int32_t stepsPerMolecule, int32_t finalSteps){relaxationSteps=stepsPerMolecule;finalRelaxationSteps=finalSteps;}
+
+  //! getter function for calculated density
+  double getDensity() const {return density;}
+
+protected:
+  using BaseClass::ingredients;
+  using BaseClass::addMolecule;
+  using BaseClass::moveSystem;
+
+private:
+  //! name of the derived updater used in messages
+  std::string name;
+
+  //! lattice occupation density
+  double density;
+
+  //! bool for execution
+  bool wasExecuted;
+
+  //! MCS of relaxation after every molecule
+  int32_t relaxationSteps;
+
+  //! MCS of relaxation after the last molecule
+  int32_t finalRelaxationSteps;
+};
+
+/**
+* @param ingredients_ a reference to the IngredientsType - mainly the system
+* @param name_ name of the derived updater used in messages
+*/
+template < class IngredientsType >
+UpdaterAbstractAddMolecules<IngredientsType>::UpdaterAbstractAddMolecules(IngredientsType& ingredients_, const std::string& name_):
+BaseClass(ingredients_), name(name_), density(0.0), wasExecuted(false), relaxationSteps(0), finalRelaxationSteps(0)
+{}
+
+template < class IngredientsType >
+uint64_t UpdaterAbstractAddMolecules<IngredientsType>::getNumberOfMonomers() const{
+  uint64_t nMonomers(0);
+  std::vector<int32_t> parents, types;
+  for(uint32_t m=0;m<getNumberOfMolecules();m++){
+    getMolecule(m,parents,types);
+    nMonomers+=parents.size();
+  }
+  return nMonomers;
+}
+
+/**
+* @brief initialise function, calculate the target density to compare with at the end.
+*
+* @tparam IngredientsType Features used in the system. See Ingredients.
+*/
+template < class IngredientsType >
+void UpdaterAbstractAddMolecules<IngredientsType>::initialize(){
+  std::cout << "initialize "<<name << std::endl;
+
+  uint64_t nMonomers(getNumberOfMonomers());
+  density=(double)( ingredients.getMolecules().size() + nMonomers ) * 8  /(double)( ingredients.getBoxX()*ingredients.getBoxY()*ingredients.getBoxZ() );
+
+  std::cout << "add "<<nMonomers<<" monomers in "<<getNumberOfMolecules()<<" molecules to the box"<<std::endl;
+
+  BaseClass::initialize();
+  execute();
+}
+
+/**
+* @brief Execution of the system creation
+*
+* @tparam IngredientsType Features used in the system. See Ingredients.
+* @throw std::runtime_error if a monomer could not be placed
+*/
+template < class IngredientsType >
+bool UpdaterAbstractAddMolecules<IngredientsType>::execute(){
+  if(wasExecuted)
+    return true;
+
+  std::cout << "execute "<<name << std::endl;
+
+  std::vector<int32_t> parents, types;
+  for(uint32_t m=0;m<getNumberOfMolecules();m++){
+    getMolecule(m,parents,types);
+    if(!addMolecule(parents,types)){
+      std::stringstream errormessage;
+      errormessage<<name<<": could not place molecule "<<m<<", the box is too dense";
+      throw std::runtime_error(errormessage.str());
+    }
+    if(relaxationSteps>0 && m+1<getNumberOfMolecules())
+      moveSystem(relaxationSteps);
+  }
+  if(finalRelaxationSteps>0)
+    moveSystem(finalRelaxationSteps);
+
+  ingredients.synchronize();
+  double lattice_volume(ingredients.getBoxX()*ingredients.getBoxY()*ingredients.getBoxZ());
+  std::cout << "real lattice occupation density =" << (8*ingredients.getMolecules().size()) / lattice_volume<<std::endl;
+  wasExecuted=true;
+  return true;
+}
+
+/**
+* @brief Standard clean up.
+*
+* @tparam IngredientsType Features used in the system. See Ingredients.
+*/
+template < class IngredientsType >
+void UpdaterAbstractAddMolecules<IngredientsType>::cleanup(){
+
+}
+
+#endif /* LEMONADE_UPDATER_ABSTRACT_ADD_MOLECULES_H */
@@ -38,14 +38,39 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  * @details This abstract class provides the three basic functions to create systems: add a single monomer, add a connected monomer and move the system to find some free space.
  * This Updater requires FeatureAttributes.
  *
+ * New monomers are placed with the help of a FreeSiteIndex, which holds all
+ * positions not blocked by the excluded volume of existing monomers. A single
+ * monomer is placed on a random free site and a monomer bonded to a parent
+ * takes a random free bond vector of length 2, instead of trying random
+ * positions. Only with setLongBondFallback(true) it takes one of the longer
+ * bond vectors of the bondset if all of length 2 are blocked. This is off by
+ * default, because it changes the bond vector statistics of the created
+ * systems. If a parent is completely enclosed, first only the parent and
+ * the monomers bonded to it are moved, then the monomers around it and only
+ * then the whole system. Thus dense systems are set up in a time almost
+ * linear in the number of monomers.
+ * The index follows monomers added and moved by this class. If the system is
+ * changed otherwise, e.g. by a simulation between two calls,
+ * invalidateFreeSites() has to be called, which initialize() does as well.
+ * Every position is still checked with MoveAddMonomerSc and the index is
+ * rebuilt once if it offers no site, but the relaxation moves update an
+ * outdated index with wrong positions, so the placement may fail otherwise.
+ *
  * @tparam IngredientsType
  *
  **/
 
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
 #include <LeMonADE/updater/AbstractUpdater.h>
 #include <LeMonADE/utility/MonomerGroup.h>
 #include <LeMonADE/utility/DepthIterator.h>
 #include <LeMonADE/utility/Vector3D.h>
+#include <LeMonADE/utility/FreeSiteIndex.h>
 #include <LeMonADE/updater/moves/MoveLocalSc.h>
 #include <LeMonADE/updater/moves/MoveAddMonomerSc.h>
 
@@ -53,12 +78,21 @@ template<class IngredientsType>
 class UpdaterAbstractCreate:public AbstractUpdater
 {
 public:
-  UpdaterAbstractCreate(IngredientsType& ingredients_):ingredients(ingredients_){}
+  UpdaterAbstractCreate(IngredientsType& ingredients_):ingredients(ingredients_),longBondFallback(false),freeSitesValid(false),indexedMonomers(0),gridMonomers(0),gridUses(0){}
 
   virtual void initialize();
   virtual bool execute();
   virtual void cleanup();
 
+  //! forces a rebuild of the index of free sites before the next monomer is added
+  void invalidateFreeSites(){freeSitesValid=false;}
+
+  //! allows bonded monomers to take a longer bond vector if all of length 2 are blocked (default: false)
+  void setLongBondFallback(bool use){longBondFallback=use;}
+
+  //! true if bonded monomers may take a longer bond vector if all of length 2 are blocked
+  bool getLongBondFallback() const {return longBondFallback;}
+
 protected:
   IngredientsType& ingredients;
 
@@ -79,29 +113,80 @@ protected:
   
   //! function to add a ring around a chain monomer
   bool addRing(uint32_t parent_id, int32_t type=1, uint32_t NRingMonomers=5);
+
+  //! function to add a molecule given by the parent of every monomer
+  bool addMolecule(const std::vector<int32_t>& parents, const std::vector<int32_t>& types);
   
   //! function to move the whole system
   void moveSystem(int32_t nsteps);
 
+  //! function to move the monomers around a monomer
+  void moveNeighborhood(uint32_t monomer, int32_t nsteps);
+
+  //! function to move a monomer and the monomers bonded to it
+  void moveBondedMonomers(uint32_t monomer, uint32_t depth, int32_t nsteps);
+
   //! function to find groups of connected monomers
   void linearizeSystem();
 
   //! function to get a random bondvector of length 2
   VectorInt3 randomBondvector();
 
+  //! brings the index of free sites up to date with the monomers in the system
+  void updateFreeSites();
+
 private:
   RandomNumberGenerators rng;
 
+  //! use the longer bond vectors if all of length 2 are blocked
+  bool longBondFallback;
+
+  //! positions where a new monomer does not overlap with existing ones
+  FreeSiteIndex freeSites;
+
+  //! false if freeSites has to be rebuilt
+  bool freeSitesValid;
+
+  //! number of monomers known to freeSites
+  size_t indexedMonomers;
+
+  //! bond vectors of the bondset with length 2, used first when adding bonded monomers
+  std::vector<VectorInt3> shortBondvectors;
+
+  //! all other bond vectors of the bondset
+  std::vector<VectorInt3> longBondvectors;
+
+  //! sorts the monomers into cells of the grid used by moveNeighborhood
+  void buildNeighborGrid();
+
+  //! true if a distance lies within the neighborhood moved by moveNeighborhood
+  bool isInNeighborhood(const VectorInt3& distance) const;
+
+  //! edge length of the grid cells
+  enum {gridCellSize=8};
+
+  //! number of cells in x, y and z
+  int32_t gridCells[3];
+
+  //! monomers sorted by cell and the first entry of every cell
+  std::vector<uint32_t> gridMonomerIds;
+  std::vector<uint32_t> gridCellStart;
+
+  //! number of monomers when the grid was built and number of uses since then
+  size_t gridMonomers;
+  uint32_t gridUses;
+
 };
 
 /**
-* The initialize function handles the new systems information.
+* The initialize function handles the new systems information. The system may
+* have changed since the last call, so the index of free sites is rebuilt.
 *
 * @tparam IngredientsType Features used in the system. See Ingredients.
 */
 template < class IngredientsType >
 void UpdaterAbstractCreate<IngredientsType>::initialize(){
-
+  invalidateFreeSites();
 }
 
 /**
@@ -127,26 +212,40 @@ void UpdaterAbstractCreate<IngredientsType>::cleanup(){
 /******************************************************************************/
 /**
  * @brief function to add a standalone monomer
+ * @details The position is drawn from the free sites. Sites rejected by the
+ * features (e.g. walls) are removed from the index.
  * @param type attribute tag of the new monomer
  * @return <b false> if position is not free, <b true> if move was applied
  */
 template<class IngredientsType>
 bool UpdaterAbstractCreate<IngredientsType>::addSingleMonomer(int32_t type){
+  updateFreeSites();
+
   // set properties of add Monomer Move
   MoveAddMonomerSc<> addmove;
   addmove.init(ingredients);
   addmove.setTag(type);
 
+  bool rebuilt(false);
   int32_t counter(0);
   while(counter<10000){
-    VectorInt3 newPosition((rng.r250_rand32() % (ingredients.getBoxX()-1)),
-				  (rng.r250_rand32() % (ingredients.getBoxY()-1)),
-				  (rng.r250_rand32() % (ingredients.getBoxZ()-1)));
+    if(freeSites.getNumberOfFreeSites()==0){
+      // the index may be outdated, try again with a new one
+      if(rebuilt) return false;
+      invalidateFreeSites();
+      updateFreeSites();
+      rebuilt=true;
+      continue;
+    }
+    VectorInt3 newPosition(freeSites.getFreeSite(rng.r250_rand32() % freeSites.getNumberOfFreeSites()));
     addmove.setPosition(newPosition);
     if(addmove.check(ingredients)==true){
       addmove.apply(ingredients);
+      freeSites.occupy(newPosition);
+      indexedMonomers++;
       return true;
     }
+    freeSites.remove(newPosition);
     counter++;
   }
   return false;
@@ -155,40 +254,116 @@ bool UpdaterAbstractCreate<IngredientsType>::addSingleMonomer(int32_t type){
 /******************************************************************************/
 /**
  * @brief function to add a monomer to a parent monomer
+ * @details The bond vector is drawn from the bond vectors of length 2 leading
+ * to a free site. If all of them are blocked and setLongBondFallback(true) was
+ * called, the other bond vectors of the bondset are tried (always, if the
+ * bondset has no bond vectors of length 2). If the parent is completely enclosed, the parent and
+ * its bonded neighbors are moved, after every tenth unsuccessful try all
+ * monomers around it, and after every hundredth try the whole system. The
+ * number of bonds up to which bonded neighbors are moved grows with the number
+ * of tries, as a branch point is often enclosed by its own molecule. Before
+ * the first move the index of free sites is rebuilt, as an outdated index may
+ * report the parent as enclosed and would mislead the moves.
  * @param parent_id id of monomer to connect with
  * @param type attribute tag of the new monomer
  * @return <b false> if position is not free, <b true> if move was applied
  */
 template<class IngredientsType>
 bool UpdaterAbstractCreate<IngredientsType>::addMonomerToParent(uint32_t parent_id, int32_t type){
+  updateFreeSites();
+
   // set properties of add Monomer Move
   MoveAddMonomerSc<> addmove;
   addmove.init(ingredients);
   addmove.setTag(type);
 
+  std::vector<VectorInt3> candidates;
+  bool rebuilt(false);
   int32_t counter(0);
+  // without bond vectors of length 2 the others are always used
+  const int nSets((longBondFallback || shortBondvectors.empty()) ? 2 : 1);
 
   while(counter<10000){
-    //try at most 30 random bondvectors to find a new monomer position
-    for(uint i=0;i<30;i++){
-      VectorInt3 bondvector(randomBondvector());
-      // set position of new monomer
-      addmove.setPosition(ingredients.getMolecules()[parent_id]+bondvector);
-
-      // check new position (excluded volume)
-      if(addmove.check(ingredients)==true){
-	addmove.apply(ingredients);
-	ingredients.modifyMolecules().connect( parent_id, (ingredients.getMolecules().size()-1) );
-	return true;
+    const VectorInt3 parentPosition(ingredients.getMolecules()[parent_id]);
+    for(int set=0;set<nSets;set++){
+      const std::vector<VectorInt3>& bondvectors(set==0 ? shortBondvectors : longBondvectors);
+      candidates.clear();
+      for(size_t k=0;k<bondvectors.size();k++)
+	if(freeSites.isFree(parentPosition+bondvectors[k]))
+	  candidates.push_back(bondvectors[k]);
+
+      while(!candidates.empty()){
+	size_t k(rng.r250_rand32() % candidates.size());
+	// set position of new monomer
+	addmove.setPosition(parentPosition+candidates[k]);
+
+	// check new position (excluded volume, other features)
+	if(addmove.check(ingredients)==true){
+	  addmove.apply(ingredients);
+	  ingredients.modifyMolecules().connect( parent_id, (ingredients.getMolecules().size()-1) );
+	  freeSites.occupy(addmove.getPosition());
+	  indexedMonomers++;
+	  return true;
+	}
+	freeSites.remove(addmove.getPosition());
+	candidates[k]=candidates.back();
+	candidates.pop_back();
       }
     }
+    // the index may be outdated, try again with a new one
+    if(!rebuilt){
+      invalidateFreeSites();
+      updateFreeSites();
+      rebuilt=true;
+      continue;
+    }
     // if no position matches, we need to move the system a bit
-    moveSystem(2);
+    if(counter%100==99)
+      moveSystem(2);
+    else if(counter%10==9)
+      moveNeighborhood(parent_id,10);
+    else
+      moveBondedMonomers(parent_id,4+uint32_t(counter/100),10);
     counter++;
   }
   return false;
 }
 
+/******************************************************************************/
+/**
+ * @brief function to add a molecule given by the parent of every monomer
+ * @details This is the common core of the updaters for branched and
+ * polydisperse architectures. The monomers are appended in the given order.
+ * Monomer k is bonded to monomer parents[k] of the molecule, which has to be
+ * added before, i.e. parents[k]<k. A negative parent starts a new, unbonded
+ * monomer on a free site. Every monomer is placed with addSingleMonomer() or
+ * addMonomerToParent(), so the free-site index and the relaxation of
+ * enclosed monomers are used.
+ * @param parents index of the parent of every monomer within the molecule, negative for none
+ * @param types attribute tag of every monomer
+ * @return <b false> if a monomer could not be placed, <b true> otherwise
+ * @throw std::runtime_error if the sizes differ or a parent is not added before its child
+ */
+template<class IngredientsType>
+bool UpdaterAbstractCreate<IngredientsType>::addMolecule(const std::vector<int32_t>& parents, const std::vector<int32_t>& types){
+  if(parents.size()!=types.size()){
+    std::stringstream errormessage;
+    errormessage<<"UpdaterAbstractCreate::addMolecule(): "<<parents.size()<<" parents given for "<<types.size()<<" monomers";
+    throw std::runtime_error(errormessage.str());
+  }
+  const uint32_t offset(ingredients.getMolecules().size());
+  for(size_t k=0;k<parents.size();k++){
+    if(parents[k]>=int32_t(k)){
+      std::stringstream errormessage;
+      errormessage<<"UpdaterAbstractCreate::addMolecule(): parent "<<parents[k]<<" of monomer "<<k<<" is not added before";
+      throw std::runtime_error(errormessage.str());
+    }
+    bool added(parents[k]<0 ? addSingleMonomer(types[k]) : addMonomerToParent(offset+uint32_t(parents[k]),types[k]));
+    if(!added) return false;
+  }
+  return true;
+}
+
 /******************************************************************************/
 /**
  * @brief function to add a monomer to a specific position. if position is not free return false
@@ -466,14 +641,175 @@ bool UpdaterAbstractCreate<IngredientsType>::addRing(uint32_t parent, int32_t ty
  */
 template<class IngredientsType>
 void UpdaterAbstractCreate<IngredientsType>::moveSystem(int32_t nsteps){
+  if(freeSitesValid) updateFreeSites();
   MoveLocalSc move;
   for(int32_t n=0;n<nsteps;n++){
     for(int32_t m=0;m<ingredients.getMolecules().size();m++){
       move.init(ingredients);
       if(move.check(ingredients)==true){
 	move.apply(ingredients);
+	if(freeSitesValid)
+	  freeSites.move(ingredients.getMolecules()[move.getIndex()]-move.getDir(),ingredients.getMolecules()[move.getIndex()]);
+      }
+    }
+  }
+}
+
+/******************************************************************************/
+/**
+ * @brief function to move the monomers around a monomer
+ * @details All monomers with a distance of at most 5 lattice units in every
+ * direction (minimum image in periodic directions) are moved with local moves,
+ * which frees space around an enclosed monomer. The monomers are found with a
+ * coarse grid, which is only rebuilt after the system grew by one percent or
+ * after 100 uses, so a call costs a time independent of the system size.
+ * Monomers added or moved into the neighborhood since the last rebuild may be
+ * missed, which only makes the relaxation less efficient.
+ * @param monomer index of the central monomer
+ * @param nsteps number of move attempts per neighboring monomer
+ */
+template<class IngredientsType>
+void UpdaterAbstractCreate<IngredientsType>::moveNeighborhood(uint32_t monomer, int32_t nsteps){
+  updateFreeSites();
+  const typename IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+  if(gridUses>=100 || gridMonomers==0 || molecules.size()>gridMonomers+gridMonomers/100 || molecules.size()<gridMonomers)
+    buildNeighborGrid();
+  gridUses++;
+
+  const int32_t box[3]={ingredients.getBoxX(),ingredients.getBoxY(),ingredients.getBoxZ()};
+  const bool periodic[3]={ingredients.isPeriodicX(),ingredients.isPeriodicY(),ingredients.isPeriodicZ()};
+  const VectorInt3 center(molecules[monomer]);
+
+  //range of cells containing the neighborhood, cells may be visited twice in small periodic boxes
+  int32_t cellBegin[3], cellEnd[3];
+  for(size_t d=0;d<3;d++){
+    int32_t c(center[d]);
+    if(periodic[d]) c=((c%box[d])+box[d])%box[d];
+    cellBegin[d]=(c-5-int32_t(gridCellSize)+1)/int32_t(gridCellSize)-1;
+    cellEnd[d]=(c+5)/int32_t(gridCellSize)+1;
+    if(periodic[d] && cellEnd[d]-cellBegin[d]>gridCells[d]) {cellBegin[d]=0;cellEnd[d]=gridCells[d];}
+    if(!periodic[d]) {cellBegin[d]=std::max(cellBegin[d],0);cellEnd[d]=std::min(cellEnd[d],gridCells[d]);}
+  }
+
+  std::vector<uint32_t> neighbors;
+  for(int32_t cz=cellBegin[2];cz<cellEnd[2];cz++)
+    for(int32_t cy=cellBegin[1];cy<cellEnd[1];cy++)
+      for(int32_t cx=cellBegin[0];cx<cellEnd[0];cx++){
+	int32_t c[3]={cx,cy,cz};
+	for(size_t d=0;d<3;d++) c[d]=((c[d]%gridCells[d])+gridCells[d])%gridCells[d];
+	uint32_t cell(c[0]+gridCells[0]*(c[1]+gridCells[1]*c[2]));
+	for(uint32_t k=gridCellStart[cell];k<gridCellStart[cell+1];k++){
+	  uint32_t n(gridMonomerIds[k]);
+	  if(n<molecules.size() && isInNeighborhood(molecules[n]-center) && std::find(neighbors.begin(),neighbors.end(),n)==neighbors.end())
+	    neighbors.push_back(n);
+	}
+      }
+  //the monomers added since the last rebuild are often the ones around the center
+  for(uint32_t n=uint32_t(std::min<size_t>(gridMonomers,molecules.size()));n<molecules.size();n++)
+    if(isInNeighborhood(molecules[n]-center))
+      neighbors.push_back(n);
+  if(neighbors.empty()) neighbors.push_back(monomer);
+
+  MoveLocalSc move;
+  for(int32_t n=0;n<nsteps*int32_t(neighbors.size());n++){
+    move.init(ingredients,neighbors[rng.r250_rand32()%neighbors.size()]);
+    if(move.check(ingredients)==true){
+      move.apply(ingredients);
+      freeSites.move(molecules[move.getIndex()]-move.getDir(),molecules[move.getIndex()]);
+    }
+  }
+}
+
+/******************************************************************************/
+/**
+ * @brief true if all components of the distance are at most 5 lattice units
+ * @details Uses the minimum image in periodic directions.
+ */
+template<class IngredientsType>
+bool UpdaterAbstractCreate<IngredientsType>::isInNeighborhood(const VectorInt3& distance) const{
+  const int32_t box[3]={ingredients.getBoxX(),ingredients.getBoxY(),ingredients.getBoxZ()};
+  const bool periodic[3]={ingredients.isPeriodicX(),ingredients.isPeriodicY(),ingredients.isPeriodicZ()};
+  for(size_t d=0;d<3;d++){
+    int32_t x(distance[d]);
+    if(periodic[d]){
+      x=((x%box[d])+box[d])%box[d];
+      if(x>box[d]/2) x-=box[d];
+    }
+    if(x<-5 || x>5) return false;
+  }
+  return true;
+}
+
+/******************************************************************************/
+/**
+ * @brief sorts the monomers into cells of the grid used by moveNeighborhood
+ * @details Counting sort of the folded positions, positions outside a
+ * non-periodic box are put into the boundary cells.
+ */
+template<class IngredientsType>
+void UpdaterAbstractCreate<IngredientsType>::buildNeighborGrid(){
+  const typename IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+  const int32_t box[3]={ingredients.getBoxX(),ingredients.getBoxY(),ingredients.getBoxZ()};
+  for(size_t d=0;d<3;d++)
+    gridCells[d]=std::max(1,box[d]/int32_t(gridCellSize));
+
+  std::vector<uint32_t> cellOf(molecules.size());
+  gridCellStart.assign(size_t(gridCells[0])*gridCells[1]*gridCells[2]+1,0);
+  for(uint32_t n=0;n<molecules.size();n++){
+    int32_t c[3];
+    for(size_t d=0;d<3;d++){
+      int32_t x(((molecules[n][d]%box[d])+box[d])%box[d]);
+      c[d]=std::min(x/int32_t(gridCellSize),gridCells[d]-1);
+    }
+    cellOf[n]=c[0]+gridCells[0]*(c[1]+gridCells[1]*c[2]);
+    gridCellStart[cellOf[n]+1]++;
+  }
+  for(size_t cell=1;cell<gridCellStart.size();cell++)
+    gridCellStart[cell]+=gridCellStart[cell-1];
+
+  gridMonomerIds.resize(molecules.size());
+  std::vector<uint32_t> fill(gridCellStart.begin(),gridCellStart.end()-1);
+  for(uint32_t n=0;n<molecules.size();n++)
+    gridMonomerIds[fill[cellOf[n]]++]=n;
+
+  gridMonomers=molecules.size();
+  gridUses=0;
+}
+
+/******************************************************************************/
+/**
+ * @brief function to move a monomer and the monomers bonded to it
+ * @param monomer index of the central monomer
+ * @param depth largest number of bonds between the central and a moved monomer
+ * @param nsteps number of move attempts per moved monomer
+ */
+template<class IngredientsType>
+void UpdaterAbstractCreate<IngredientsType>::moveBondedMonomers(uint32_t monomer, uint32_t depth, int32_t nsteps){
+  updateFreeSites();
+  const typename IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+
+  //breadth first search, the monomers of one generation follow each other
+  std::vector<uint32_t> group(1,monomer);
+  size_t generationBegin(0);
+  for(uint32_t generation=0;generation<depth;generation++){
+    size_t generationEnd(group.size());
+    for(size_t k=generationBegin;k<generationEnd;k++){
+      for(uint32_t l=0;l<molecules.getNumLinks(group[k]);l++){
+	uint32_t neighbor(molecules.getNeighborIdx(group[k],l));
+	if(std::find(group.begin(),group.end(),neighbor)==group.end())
+	  group.push_back(neighbor);
       }
     }
+    generationBegin=generationEnd;
+  }
+
+  MoveLocalSc move;
+  for(int32_t n=0;n<nsteps*int32_t(group.size());n++){
+    move.init(ingredients,group[rng.r250_rand32()%group.size()]);
+    if(move.check(ingredients)==true){
+      move.apply(ingredients);
+      freeSites.move(molecules[move.getIndex()]-move.getDir(),molecules[move.getIndex()]);
+    }
   }
 }
 
@@ -544,4 +880,40 @@ VectorInt3 UpdaterAbstractCreate<IngredientsType>::randomBondvector(){
   }else
     throw std::runtime_error("UpdaterAbstractCreate::randomBondvector: bondvectors not part of the bondvectorset.");
 }
+/******************************************************************************/
+/**
+ * @brief brings the index of free sites up to date with the monomers in the system
+ * @details Monomers appended since the last call are added to the index. If
+ * the index was invalidated or monomers were removed, it is rebuilt from all
+ * monomer positions, which takes a time proportional to the box volume.
+ */
+template<class IngredientsType>
+void UpdaterAbstractCreate<IngredientsType>::updateFreeSites(){
+  const typename IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+  if(freeSitesValid && indexedMonomers<=molecules.size()){
+    for(size_t n=indexedMonomers;n<molecules.size();n++)
+      freeSites.occupy(molecules[n]);
+    indexedMonomers=molecules.size();
+    return;
+  }
+
+  uint32_t box[3]={uint32_t(ingredients.getBoxX()),uint32_t(ingredients.getBoxY()),uint32_t(ingredients.getBoxZ())};
+  bool periodic[3]={ingredients.isPeriodicX(),ingredients.isPeriodicY(),ingredients.isPeriodicZ()};
+  freeSites.setup(box,periodic);
+  for(size_t n=0;n<molecules.size();n++)
+    freeSites.occupy(molecules[n]);
+  indexedMonomers=molecules.size();
+
+  shortBondvectors.clear();
+  longBondvectors.clear();
+  std::map<int32_t, VectorInt3>::const_iterator it;
+  for(it=ingredients.getBondset().begin();it!=ingredients.getBondset().end();++it){
+    const VectorInt3& bondvector(it->second);
+    if(bondvector*bondvector==4)
+      shortBondvectors.push_back(bondvector);
+    else
+      longBondvectors.push_back(bondvector);
+  }
+  freeSitesValid=true;
+}
 #endif /* LEMONADE_UPDATER_ABSTRACT_CREATE_H */
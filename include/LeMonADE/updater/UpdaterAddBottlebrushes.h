@@ -0,0 +1,63 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_ADD_BOTTLEBRUSHES_H
+#define LEMONADE_UPDATER_ADD_BOTTLEBRUSHES_H
+/**
+ * @file
+ *
+ * @class UpdaterAddBottlebrushes
+ *
+ * @brief Updater to add monodisperse bottlebrush polymers
+ *
+ * @details A bottlebrush is a comb where every backbone monomer carries a side
+ * chain, see UpdaterAddCombs for the order of the monomers, i.e. every
+ * backbone monomer is followed by its side chain. This updater
+ * requires FeatureAttributes.
+ *
+ * @tparam IngredientsType
+ *
+ * @param ingredients_ The system, holding either an empty simulation box for system setup
+ * or a prefilled ingredients where the bottlebrushes shall be added
+ * @param NBrushes_ number of bottlebrushes
+ * @param NBackbone_ number of backbone monomers
+ * @param NMonoPerSideChain_ number of monomers in a side chain
+ * @param typeBackbone_ attribute tag of the backbone monomers
+ * @param typeSideChain_ attribute tag of the side chain monomers
+ **/
+
+#include <LeMonADE/updater/UpdaterAddCombs.h>
+
+template<class IngredientsType>
+class UpdaterAddBottlebrushes: public UpdaterAddCombs<IngredientsType>
+{
+public:
+  UpdaterAddBottlebrushes(IngredientsType& ingredients_, uint32_t NBrushes_, uint32_t NBackbone_, uint32_t NMonoPerSideChain_, int32_t typeBackbone_=1, int32_t typeSideChain_=2)
+  :UpdaterAddCombs<IngredientsType>(ingredients_,"UpdaterAddBottlebrushes",NBrushes_,NBackbone_,NBackbone_,NMonoPerSideChain_,typeBackbone_,typeSideChain_){}
+};
+
+#endif /* LEMONADE_UPDATER_ADD_BOTTLEBRUSHES_H */
@@ -0,0 +1,159 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_ADD_COMBS_H
+#define LEMONADE_UPDATER_ADD_COMBS_H
+/**
+ * @file
+ *
+ * @class UpdaterAddCombs
+ *
+ * @brief Updater to add monodisperse comb polymers
+ *
+ * @details Every comb consists of a linear backbone of NBackbone monomers and
+ * NSideChains side chains of NMonoPerSideChain monomers. Side chain i is
+ * grafted to backbone monomer (2i+1)*NBackbone/(2*NSideChains), so the side
+ * chains are spread evenly and with NSideChains=NBackbone every backbone
+ * monomer carries one side chain. The monomers are stored in the order they
+ * are grown: every backbone monomer is followed by the side chains grafted to
+ * it. Growing the side chains right after their grafting point packs much
+ * better in dense systems than growing the whole backbone first, where the
+ * grafting points are enclosed by the time the side chains are added. This
+ * updater requires FeatureAttributes.
+ *
+ * @tparam IngredientsType
+ *
+ * @param ingredients_ The system, holding either an empty simulation box for system setup
+ * or a prefilled ingredients where the combs shall be added
+ * @param NCombs_ number of combs
+ * @param NBackbone_ number of backbone monomers
+ * @param NSideChains_ number of side chains per comb, at most NBackbone_
+ * @param NMonoPerSideChain_ number of monomers in a side chain
+ * @param typeBackbone_ attribute tag of the backbone monomers
+ * @param typeSideChain_ attribute tag of the side chain monomers
+ **/
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <LeMonADE/updater/UpdaterAbstractAddMolecules.h>
+
+template<class IngredientsType>
+class UpdaterAddCombs: public UpdaterAbstractAddMolecules<IngredientsType>
+{
+  typedef UpdaterAbstractAddMolecules<IngredientsType> BaseClass;
+
+public:
+  UpdaterAddCombs(IngredientsType& ingredients_, uint32_t NCombs_, uint32_t NBackbone_, uint32_t NSideChains_, uint32_t NMonoPerSideChain_, int32_t typeBackbone_=1, int32_t typeSideChain_=2);
+
+  virtual uint32_t getNumberOfMolecules() const {return NCombs;}
+
+  virtual void getMolecule(uint32_t m, std::vector<int32_t>& parents, std::vector<int32_t>& types) const;
+
+  //! getter function for number of backbone monomers
+  uint32_t getNBackbone() const {return NBackbone;}
+
+  //! getter function for number of side chains
+  uint32_t getNSideChains() const {return NSideChains;}
+
+  //! getter function for number of monomers in a side chain
+  uint32_t getNMonomerPerSideChain() const {return NMonoPerSideChain;}
+
+protected:
+  //! constructor for derived architectures using their own name in messages
+  UpdaterAddCombs(IngredientsType& ingredients_, const std::string& name_, uint32_t NCombs_, uint32_t NBackbone_, uint32_t NSideChains_, uint32_t NMonoPerSideChain_, int32_t typeBackbone_, int32_t typeSideChain_);
+
+private:
+  //! throws if there are more side chains than backbone monomers
+  void checkParameters() const;
+
+  //! number of combs
+  uint32_t NCombs;
+
+  //! number of backbone monomers
+  uint32_t NBackbone;
+
+  //! number of side chains per comb
+  uint32_t NSideChains;
+
+  //! number of monomers per side chain
+  uint32_t NMonoPerSideChain;
+
+  //! attribute tag of the backbone
+  int32_t typeBackbone;
+
+  //! attribute tag of the side chains
+  int32_t typeSideChain;
+};
+
+/**
+* @throw std::runtime_error if NSideChains_ is larger than NBackbone_
+*/
+template < class IngredientsType >
+UpdaterAddCombs<IngredientsType>::UpdaterAddCombs(IngredientsType& ingredients_, uint32_t NCombs_, uint32_t NBackbone_, uint32_t NSideChains_, uint32_t NMonoPerSideChain_, int32_t typeBackbone_, int32_t typeSideChain_)
+:BaseClass(ingredients_,"UpdaterAddCombs"),NCombs(NCombs_),NBackbone(NBackbone_),NSideChains(NSideChains_),NMonoPerSideChain(NMonoPerSideChain_),typeBackbone(typeBackbone_),typeSideChain(typeSideChain_)
+{
+  checkParameters();
+}
+
+template < class IngredientsType >
+UpdaterAddCombs<IngredientsType>::UpdaterAddCombs(IngredientsType& ingredients_, const std::string& name_, uint32_t NCombs_, uint32_t NBackbone_, uint32_t NSideChains_, uint32_t NMonoPerSideChain_, int32_t typeBackbone_, int32_t typeSideChain_)
+:BaseClass(ingredients_,name_),NCombs(NCombs_),NBackbone(NBackbone_),NSideChains(NSideChains_),NMonoPerSideChain(NMonoPerSideChain_),typeBackbone(typeBackbone_),typeSideChain(typeSideChain_)
+{
+  checkParameters();
+}
+
+template < class IngredientsType >
+void UpdaterAddCombs<IngredientsType>::checkParameters() const{
+  if(NSideChains>NBackbone){
+    std::stringstream errormessage;
+    errormessage<<"UpdaterAddCombs: "<<NSideChains<<" side chains do not fit on a backbone of "<<NBackbone<<" monomers";
+    throw std::runtime_error(errormessage.str());
+  }
+}
+
+template < class IngredientsType >
+void UpdaterAddCombs<IngredientsType>::getMolecule(uint32_t /*m*/, std::vector<int32_t>& parents, std::vector<int32_t>& types) const{
+  parents.clear();
+  types.clear();
+  int32_t lastBackbone(-1);
+  uint32_t i(0);
+  for(uint32_t k=0;k<NBackbone;k++){
+    parents.push_back(lastBackbone);
+    types.push_back(typeBackbone);
+    lastBackbone=int32_t(parents.size())-1;
+    // side chains grafted to this backbone monomer
+    for(;i<NSideChains && (uint64_t(2*i+1)*NBackbone)/(2*uint64_t(NSideChains))==k;i++)
+      for(uint32_t j=0;j<NMonoPerSideChain;j++){
+	parents.push_back(j==0 ? lastBackbone : int32_t(parents.size())-1);
+	types.push_back(typeSideChain);
+      }
+  }
+}
+
+#endif /* LEMONADE_UPDATER_ADD_COMBS_H */
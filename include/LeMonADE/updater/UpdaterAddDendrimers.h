@@ -0,0 +1,145 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_ADD_DENDRIMERS_H
+#define LEMONADE_UPDATER_ADD_DENDRIMERS_H
+/**
+ * @file
+ *
+ * @class UpdaterAddDendrimers
+ *
+ * @brief Updater to add monodisperse dendrimers
+ *
+ * @details A dendrimer of G generations starts at a core monomer with
+ * coreFunctionality branches. Every branch is a spacer of spacerLength monomers
+ * ending in a branch point. The branch points of generation g<G start
+ * branchFunctionality-1 new branches each, the branch points of generation G
+ * are the end groups. The monomers are stored generation by generation, every
+ * branch as its spacer followed by its branch point. This updater requires
+ * FeatureAttributes.
+ *
+ * @tparam IngredientsType
+ *
+ * @param ingredients_ The system, holding either an empty simulation box for system setup
+ * or a prefilled ingredients where the dendrimers shall be added
+ * @param NDendrimers_ number of dendrimers
+ * @param NGenerations_ number of generations
+ * @param coreFunctionality_ number of branches at the core
+ * @param branchFunctionality_ functionality of the branch points, at least 2
+ * @param spacerLength_ number of monomers between two branch points
+ * @param typeCore_ attribute tag of the core monomers
+ * @param typeBranchPoint_ attribute tag of the branch points
+ * @param typeSpacer_ attribute tag of the spacer monomers
+ **/
+
+#include <sstream>
+#include <stdexcept>
+
+#include <LeMonADE/updater/UpdaterAbstractAddMolecules.h>
+
+template<class IngredientsType>
+class UpdaterAddDendrimers: public UpdaterAbstractAddMolecules<IngredientsType>
+{
+  typedef UpdaterAbstractAddMolecules<IngredientsType> BaseClass;
+
+public:
+  UpdaterAddDendrimers(IngredientsType& ingredients_, uint32_t NDendrimers_, uint32_t NGenerations_, uint32_t coreFunctionality_=3, uint32_t branchFunctionality_=3, uint32_t spacerLength_=1, int32_t typeCore_=1, int32_t typeBranchPoint_=2, int32_t typeSpacer_=3);
+
+  virtual uint32_t getNumberOfMolecules() const {return NDendrimers;}
+
+  virtual void getMolecule(uint32_t m, std::vector<int32_t>& parents, std::vector<int32_t>& types) const;
+
+  //! getter function for number of generations
+  uint32_t getNGenerations() const {return NGenerations;}
+
+private:
+  //! number of dendrimers
+  uint32_t NDendrimers;
+
+  //! number of generations
+  uint32_t NGenerations;
+
+  //! number of branches at the core
+  uint32_t coreFunctionality;
+
+  //! functionality of the branch points
+  uint32_t branchFunctionality;
+
+  //! number of monomers between two branch points
+  uint32_t spacerLength;
+
+  //! attribute tag of the core
+  int32_t typeCore;
+
+  //! attribute tag of the branch points
+  int32_t typeBranchPoint;
+
+  //! attribute tag of the spacers
+  int32_t typeSpacer;
+};
+
+/**
+* @throw std::runtime_error if branchFunctionality_ is smaller than 2
+*/
+template < class IngredientsType >
+UpdaterAddDendrimers<IngredientsType>::UpdaterAddDendrimers(IngredientsType& ingredients_, uint32_t NDendrimers_, uint32_t NGenerations_, uint32_t coreFunctionality_, uint32_t branchFunctionality_, uint32_t spacerLength_, int32_t typeCore_, int32_t typeBranchPoint_, int32_t typeSpacer_)
+:BaseClass(ingredients_,"UpdaterAddDendrimers"),NDendrimers(NDendrimers_),NGenerations(NGenerations_),coreFunctionality(coreFunctionality_)
+,branchFunctionality(branchFunctionality_),spacerLength(spacerLength_),typeCore(typeCore_),typeBranchPoint(typeBranchPoint_),typeSpacer(typeSpacer_)
+{
+  if(branchFunctionality<2){
+    std::stringstream errormessage;
+    errormessage<<"UpdaterAddDendrimers: functionality of the branch points is "<<branchFunctionality<<", but must be at least 2";
+    throw std::runtime_error(errormessage.str());
+  }
+}
+
+template < class IngredientsType >
+void UpdaterAddDendrimers<IngredientsType>::getMolecule(uint32_t /*m*/, std::vector<int32_t>& parents, std::vector<int32_t>& types) const{
+  parents.assign(1,-1);
+  types.assign(1,typeCore);
+  std::vector<int32_t> branchPoints(1,0);
+  std::vector<int32_t> nextBranchPoints;
+  for(uint32_t g=1;g<=NGenerations;g++){
+    nextBranchPoints.clear();
+    uint32_t nBranches(g==1 ? coreFunctionality : branchFunctionality-1);
+    for(size_t p=0;p<branchPoints.size();p++)
+      for(uint32_t b=0;b<nBranches;b++){
+	int32_t parent(branchPoints[p]);
+	for(uint32_t s=0;s<spacerLength;s++){
+	  parents.push_back(parent);
+	  types.push_back(typeSpacer);
+	  parent=int32_t(parents.size())-1;
+	}
+	parents.push_back(parent);
+	types.push_back(typeBranchPoint);
+	nextBranchPoints.push_back(int32_t(parents.size())-1);
+      }
+    branchPoints.swap(nextBranchPoints);
+  }
+}
+
+#endif /* LEMONADE_UPDATER_ADD_DENDRIMERS_H */
@@ -132,6 +132,7 @@ void UpdaterAddLinearChains<IngredientsType>::initialize(){
 
   std::cout << "add "<<NChain*NMonoPerChain<<" monomers to the box"<<std::endl;
 
+  BaseClass::initialize();
   execute();
 }
 
@@ -0,0 +1,765 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_ADD_LINEAR_CHAINS_PARALLEL_H
+#define LEMONADE_UPDATER_ADD_LINEAR_CHAINS_PARALLEL_H
+/**
+ * @file
+ *
+ * @class UpdaterAddLinearChainsParallel
+ *
+ * @brief Updater to create a solution or melt of monodisperse linear chains using several threads.
+ *
+ * @details As with UpdaterAddLinearChains, NChain chains of NMonoPerChain
+ * monomers are appended to the molecules chain by chain, the monomers of a
+ * chain are bonded consecutively and tagged alternating with type1 and type2.
+ *
+ * Instead of adding every monomer with MoveAddMonomerSc, the
+ * box is divided into slabs along z and every thread grows its share of the
+ * chains using a FreeSiteIndex of its slab. A chain starts inside the slab,
+ * but may grow into a halo of haloThickness lattice units on both sides,
+ * i.e. into the neighboring slabs. The slabs are at least two halos thick, so
+ * the halos of every second slab do not overlap: first the even slabs grow
+ * their chains in parallel, then the odd slabs, whose index also contains the
+ * chains of the even slabs. In the second phase the odd slabs reach to the
+ * middle of the even slabs. Thus the threads need no synchronization and
+ * chains cross the slab boundaries. In a periodic box the number of slabs is
+ * even.
+ * The halo is three times the root mean square extent in z of an ideal chain
+ * with bonds of length 2, which are preferred by the growth, such that a chain
+ * of the first phase is hardly ever deformed by this limit. If the box is
+ * thinner than two slabs, a single thread grows all chains in the whole box.
+ *
+ * Every monomer is placed as in UpdaterAbstractCreate::addMonomerToParent:
+ * on a random free site reachable by a bond of length 2 (the other bonds of
+ * the bondset only if none is free and setLongBondFallback(true) was called).
+ * If the chain end is enclosed, the monomers around it are moved by local
+ * moves with the same schedule as in addMonomerToParent. A thread moves only
+ * the monomers it grew and, in the second phase, the monomers of the first
+ * phase lying in its region; the monomers present before are never moved.
+ * The histogram of the bond vectors, the mean squared end-to-end distance and
+ * the radius of gyration thus agree with those of UpdaterAddLinearChains
+ * within the scatter between serial setups, which is tested at a dense and a
+ * dilute filling.
+ *
+ * Afterwards the chains are appended to the molecules in the order of the slabs
+ * and the system is synchronized once. Chains a thread could not place are
+ * built in a final serial pass with the methods of UpdaterAbstractCreate.
+ * Within the slabs only the excluded volume and the bondset are considered.
+ * Features restricting the positions further (e.g. walls) are only checked
+ * by the final synchronize, so for such systems UpdaterAddLinearChains should
+ * be used.
+ *
+ * @tparam IngredientsType
+ *
+ * @param ingredients_ The system, holding either an empty simulation box for system setup
+ * or a prefilled ingredients where the linear chains shall be added
+ * @param NChain_ number of chains that are added to ingredients
+ * @param NMonoPerChain_ number of monomer is each chain
+ * @param type1_ attribute tag of "even" monomers
+ * @param type2_ attribute tag of "odd" monomers
+ * @param nThreads_ number of threads, 0 uses Thread::hardwareConcurrency()
+ **/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/updater/UpdaterAbstractCreate.h>
+#include <LeMonADE/utility/FreeSiteIndex.h>
+#include <LeMonADE/utility/R250.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+#include <LeMonADE/utility/Threads.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+template<class IngredientsType>
+class UpdaterAddLinearChainsParallel: public UpdaterAbstractCreate<IngredientsType>
+{
+  typedef UpdaterAbstractCreate<IngredientsType> BaseClass;
+  typedef typename IngredientsType::molecules_type molecules_type;
+
+public:
+  UpdaterAddLinearChainsParallel(IngredientsType& ingredients_, uint32_t NChain_, uint32_t NMonoPerChain_, int32_t type1_=1, int32_t type2_=2, unsigned int nThreads_=0);
+
+  virtual void initialize();
+  virtual bool execute();
+  virtual void cleanup();
+
+  //! getter function for number of monomers in chains
+  const int32_t getNMonomerPerChain() const {return NMonoPerChain;}
+
+  //! getter function for number of chains
+  const int32_t getNChain() const {return NChain;}
+
+  //! getter function for calculated density
+  const double getDensity() const {return density;}
+
+  //! getter function for the number of slabs used in the last execution
+  uint32_t getNumberOfSlabs() const {return nSlabs;}
+
+  //! getter function for the number of chains built in the final serial pass
+  uint32_t getNumberOfSerialChains() const {return nSerialChains;}
+
+  //! getter function for the distance chains of the even slabs reached out of their slab in the last execution
+  uint32_t getHaloThickness() const {return haloThickness;}
+
+  //! minimal thickness of a slab in z
+  enum {minSlabThickness=16};
+
+private:
+  // provide access to functions of UpdaterAbstractCreate used in this updater
+  using BaseClass::ingredients;
+  using BaseClass::addMonomerToParent;
+  using BaseClass::addSingleMonomer;
+  using BaseClass::linearizeSystem;
+
+  //! grows the chains of one slab in a separate thread
+  class Worker: public Thread
+  {
+  public:
+    Worker(const molecules_type& molecules, const std::vector<VectorInt3>& grown,
+	   const uint32_t box[3], const bool periodic[3],
+	   int32_t z0, int32_t z1, int32_t zBegin, int32_t zEnd, uint32_t nChains, uint32_t chainLength,
+	   const std::vector<VectorInt3>& shortBondvectors, const std::vector<VectorInt3>& longBondvectors,
+	   const std::vector<VectorInt3>& bondset, const uint32_t* seeds);
+
+    //! unfolded positions of the placed chains, chain by chain
+    const std::vector<VectorInt3>& getPositions() const {return positions;}
+
+    //! writes the chains of the first phase moved by this thread back to grown
+    void storeAdopted(std::vector<VectorInt3>& grown) const;
+
+    //! number of chains which could not be placed
+    uint32_t getNumberOfFailedChains() const {return nFailed;}
+
+    //! true if run() was left by an exception
+    bool hasFailed() const {return failed;}
+
+    //! message of the exception run() was left with
+    const std::string& getError() const {return error;}
+
+  protected:
+    virtual void run();
+
+  private:
+    //! grows the chains of the slab
+    void growChains();
+
+    //! tries to grow a single chain, its monomers are appended to positions
+    bool growChain();
+
+    //! moves the monomers around the enclosed chain end, as UpdaterAbstractCreate::addMonomerToParent does
+    void relax(uint32_t counter);
+
+    //! performs nsteps local moves per monomer of the group on randomly chosen monomers of the group
+    void moveMonomers(const std::vector<uint32_t>& group, uint32_t nsteps);
+
+    //! performs a local move of monomer n by dir, if the sites are free and the bonds stay valid
+    bool moveMonomer(uint32_t n, const VectorInt3& dir);
+
+    //! local position of monomer n, the monomers in positions are followed by the adopted ones
+    const VectorInt3& getMonomer(uint32_t n) const
+    {return n<positions.size() ? positions[n] : adoptedPositions[n-positions.size()];}
+
+    //! true if the vector is in the bondset
+    bool isValidBond(const VectorInt3& bond) const;
+
+    //! removes the sites blocked by a monomer at the unfolded position pos from the index
+    void occupyImages(const VectorInt3& pos);
+
+    //! true if the slab covers the whole box without halos
+    bool isWholeBox() const {return zBegin==z0 && zEnd==z1 && uint32_t(zEnd-zBegin)==box[2];}
+
+    const molecules_type& molecules;
+    //! chains grown by the threads of the first phase
+    const std::vector<VectorInt3>& grown;
+    uint32_t box[3];
+    bool periodic[3];
+    //! the slab, where the chains start
+    int32_t z0;
+    int32_t z1;
+    //! the slab and its halos, where the chains may grow
+    int32_t zBegin;
+    int32_t zEnd;
+    uint32_t nChains;
+    uint32_t chainLength;
+    const std::vector<VectorInt3>& shortBondvectors;
+    const std::vector<VectorInt3>& longBondvectors;
+    //! random number generator of this thread
+    R250 rng;
+    //! free sites of the slab and its halos in coordinates relative to zBegin
+    FreeSiteIndex freeSites;
+    //! lookup table of the bondset for vectors with components in [-bondRange,bondRange]
+    std::vector<bool> validBonds;
+    int32_t bondRange;
+    //! unfolded positions of the chains, z relative to zBegin until all chains are grown
+    std::vector<VectorInt3> positions;
+    //! monomers of grown well inside the slab, which only this thread may move
+    std::vector<uint32_t> adoptedIndices;
+    //! their positions, z relative to zBegin
+    std::vector<VectorInt3> adoptedPositions;
+    //! z of a position in grown minus z of the adopted position
+    std::vector<int32_t> adoptedShifts;
+    std::vector<VectorInt3> candidates;
+    std::vector<uint32_t> group;
+    uint32_t nFailed;
+    //! an exception must not leave the thread, it is reported by execute()
+    bool failed;
+    std::string error;
+  };
+
+  //! throws an exception if one of the workers of the phase failed, then all workers are deleted
+  void checkWorkers(std::vector<Worker*>& workers, uint32_t phase);
+
+  //! number of monomers in a chain
+  uint32_t NMonoPerChain;
+
+  //! number of linear chains in the box
+  uint32_t NChain;
+
+  //! lattice occupation density
+  double density;
+
+  //! bool for execution
+  bool wasExecuted;
+
+  //! attribute tag of even monomers
+  int32_t type1;
+
+  //! getAttributeTag of odd monomers
+  int32_t type2;
+
+  //! requested number of threads
+  unsigned int nThreads;
+
+  //! number of slabs used
+  uint32_t nSlabs;
+
+  //! number of chains built in the final serial pass
+  uint32_t nSerialChains;
+
+  //! distance chains of the even slabs may reach out of their slab
+  uint32_t haloThickness;
+
+  //! seeds the random number generators of the threads
+  RandomNumberGenerators rng;
+};
+
+/**
+* @brief Constructor handling the new systems paramters
+*
+* @param ingredients_ a reference to the IngredientsType - mainly the system
+* @param NChain_ number of chains to be added in the system instead of solvent
+* @param NMonoPerChain_ number of monomers in one chain
+* @param type1_ attribute tag of "even" monomers
+* @param type2_ attribute tag of "odd" monomers
+* @param nThreads_ number of threads, 0 uses Thread::hardwareConcurrency()
+*/
+template < class IngredientsType >
+UpdaterAddLinearChainsParallel<IngredientsType>::UpdaterAddLinearChainsParallel(IngredientsType& ingredients_, uint32_t NChain_, uint32_t NMonoPerChain_, int32_t type1_, int32_t type2_, unsigned int nThreads_):
+BaseClass(ingredients_), NMonoPerChain(NMonoPerChain_), NChain(NChain_), density(0.0), wasExecuted(false),
+type1(type1_), type2(type2_), nThreads(nThreads_), nSlabs(0), nSerialChains(0), haloThickness(0)
+{}
+
+/**
+* @brief initialise function, calculate the target density to compare with at the end.
+*
+* @tparam IngredientsType Features used in the system. See Ingredients.
+*/
+template < class IngredientsType >
+void UpdaterAddLinearChainsParallel<IngredientsType>::initialize(){
+  std::cout << "initialize UpdaterAddLinearChainsParallel" << std::endl;
+
+  // get the target density from the sum of existing monomers and the new added chains
+  density=(double)( ingredients.getMolecules().size() + NMonoPerChain*NChain ) * 8  /(double)( ingredients.getBoxX()*ingredients.getBoxY()*ingredients.getBoxZ() );
+
+  std::cout << "add "<<NChain*NMonoPerChain<<" monomers to the box"<<std::endl;
+
+  BaseClass::initialize();
+  execute();
+}
+
+/**
+* @brief Execution of the system creation
+*
+* @details The chains are distributed to the slabs according to their
+* thickness. The even slabs are filled first, then the odd ones. The seeds of
+* the threads are drawn from the global random number generator, such that a
+* seeded setup is reproducible for a fixed number of threads.
+*
+* @tparam IngredientsType Features used in the system. See Ingredients.
+*/
+template < class IngredientsType >
+bool UpdaterAddLinearChainsParallel<IngredientsType>::execute(){
+  if(wasExecuted)
+    return true;
+
+  std::cout << "execute UpdaterAddLinearChainsParallel" << std::endl;
+
+  const uint32_t box[3]={uint32_t(ingredients.getBoxX()),uint32_t(ingredients.getBoxY()),uint32_t(ingredients.getBoxZ())};
+  const bool periodic[3]={ingredients.isPeriodicX(),ingredients.isPeriodicY(),ingredients.isPeriodicZ()};
+  const size_t oldSize=ingredients.getMolecules().size();
+
+  std::vector<VectorInt3> shortBondvectors;
+  std::vector<VectorInt3> longBondvectors;
+  std::vector<VectorInt3> bondset;
+  std::map<int32_t, VectorInt3>::const_iterator it;
+  for(it=ingredients.getBondset().begin();it!=ingredients.getBondset().end();++it){
+    bondset.push_back(it->second);
+    if(it->second*it->second==4)
+      shortBondvectors.push_back(it->second);
+    else
+      longBondvectors.push_back(it->second);
+  }
+  // as in addMonomerToParent, the longer bonds are only a fallback if enabled
+  if(!this->getLongBondFallback() && !shortBondvectors.empty())
+    longBondvectors.clear();
+
+  // the halo is three times the extent in z of an ideal chain of the bonds
+  // mostly used by the growth, the slabs hold two halos
+  double squaredBond(4.0);
+  if(shortBondvectors.empty())
+    for(size_t k=0;k<longBondvectors.size();k++)
+      squaredBond=std::max(squaredBond,double(longBondvectors[k]*longBondvectors[k]));
+  haloThickness=uint32_t(std::ceil(3.0*std::sqrt(double(std::max(NMonoPerChain,1u)-1)*squaredBond/3.0)))+2;
+  const uint32_t slabThickness=std::max<uint32_t>(minSlabThickness,2*haloThickness);
+  unsigned int threads=(nThreads==0 ? Thread::hardwareConcurrency() : nThreads);
+  nSlabs=std::max<uint32_t>(1,std::min<uint32_t>(std::max(threads,1u),box[2]/slabThickness));
+  // the first and the last slab of a periodic box grow in different phases
+  if(periodic[2] && nSlabs%2==1 && nSlabs>1)
+    nSlabs--;
+
+  // draw the seeds in the order of the slabs
+  std::vector<uint32_t> seeds(size_t(nSlabs)*R250_RANDOM_PREFETCH);
+  for(size_t n=0;n<seeds.size();n++)
+    seeds[n]=rng.r250_rand32();
+
+  // grow the chains of the even slabs, then those of the odd slabs
+  std::vector<Worker*> workers(nSlabs,static_cast<Worker*>(0));
+  std::vector<VectorInt3> grown;
+  std::vector<size_t> grownBegin(nSlabs,0);
+  for(uint32_t phase=0;phase<2;phase++){
+    for(uint32_t s=phase;s<nSlabs;s+=2){
+      int32_t z0=int32_t(uint64_t(box[2])*s/nSlabs);
+      int32_t z1=int32_t(uint64_t(box[2])*(s+1)/nSlabs);
+      int32_t zBegin(z0), zEnd(z1);
+      if(nSlabs>1 && phase==0){
+	zBegin=z0-int32_t(haloThickness);
+	zEnd=z1+int32_t(haloThickness);
+	if(!periodic[2]){
+	  zBegin=std::max(zBegin,0);
+	  zEnd=std::min(zEnd,int32_t(box[2]));
+	}
+      }
+      else if(nSlabs>1){
+	// the odd slabs reach to the middle of the even ones, so they cover the
+	// box and every chain of the first phase can be moved in the second one
+	const int32_t zPrevious=int32_t(uint64_t(box[2])*(s-1)/nSlabs);
+	zBegin=(s==1 && !periodic[2]) ? 0 : (zPrevious+z0)/2;
+	if(s+1==nSlabs)
+	  zEnd=int32_t(box[2])+(periodic[2] ? int32_t(uint64_t(box[2])/nSlabs)/2 : 0);
+	else if(s+2==nSlabs && !periodic[2])
+	  zEnd=int32_t(box[2]);
+	else
+	  zEnd=(z1+int32_t(uint64_t(box[2])*(s+2)/nSlabs))/2;
+      }
+      uint32_t nChains=uint32_t(uint64_t(NChain)*(s+1)/nSlabs-uint64_t(NChain)*s/nSlabs);
+      workers[s]=new Worker(ingredients.getMolecules(),grown,box,periodic,z0,z1,zBegin,zEnd,nChains,NMonoPerChain,shortBondvectors,longBondvectors,bondset,&seeds[size_t(s)*R250_RANDOM_PREFETCH]);
+    }
+    for(uint32_t s=phase;s<nSlabs;s+=2) workers[s]->start();
+    for(uint32_t s=phase;s<nSlabs;s+=2) workers[s]->join();
+    checkWorkers(workers,phase);
+    if(phase==0)
+      for(uint32_t s=0;s<nSlabs;s+=2){
+	grownBegin[s]=grown.size();
+	grown.insert(grown.end(),workers[s]->getPositions().begin(),workers[s]->getPositions().end());
+      }
+  }
+  for(uint32_t s=1;s<nSlabs;s+=2)
+    workers[s]->storeAdopted(grown);
+
+  // concatenate the chains in the order of the slabs
+  nSerialChains=0;
+  molecules_type& molecules=ingredients.modifyMolecules();
+  for(uint32_t s=0;s<nSlabs;s++){
+    const std::vector<VectorInt3>& positions(workers[s]->getPositions());
+    for(size_t n=0;n<positions.size();n++){
+      // the chains of the first phase may have been moved in the second one
+      const VectorInt3& pos(s%2==0 ? grown[grownBegin[s]+n] : positions[n]);
+      uint32_t index=molecules.addMonomer(pos.getX(),pos.getY(),pos.getZ());
+      molecules[index].setAttributeTag(n%NMonoPerChain%2==0 ? type1 : type2);
+      if(n%NMonoPerChain!=0)
+	molecules.connect(index-1,index);
+    }
+    nSerialChains+=workers[s]->getNumberOfFailedChains();
+    delete workers[s];
+  }
+  ingredients.synchronize();
+
+  // chains which could not be placed by a thread are built serially, see getNumberOfSerialChains()
+  for(uint32_t i=0;i<nSerialChains;i++){
+    for(uint32_t j=0;j<NMonoPerChain;j++){
+      if(j==0)
+	addSingleMonomer(type1);
+      else{
+	if(ingredients.getMolecules()[ingredients.getMolecules().size()-1].getAttributeTag() == type1)
+	  addMonomerToParent(ingredients.getMolecules().size()-1,type2);
+	else
+	  addMonomerToParent(ingredients.getMolecules().size()-1,type1);
+      }
+    }
+  }
+
+  ingredients.synchronize();
+  double lattice_volume(ingredients.getBoxX()*ingredients.getBoxY()*ingredients.getBoxZ());
+  if(std::abs(density - ( (double)(ingredients.getMolecules().size()*8) / lattice_volume )) > 0.0000000001 ){
+    std::cout << density << " " <<( (ingredients.getMolecules().size()*8) / lattice_volume)<<std::endl;
+    throw std::runtime_error("UpdaterAddLinearChainsParallel: number of monomers in molecules does not match the calculated number of monomers!");
+  }
+  std::cout << "real lattice occupation density =" << (8*ingredients.getMolecules().size()) / lattice_volume<<std::endl;
+  wasExecuted=true;
+  // the new chains are already stored consecutively, only monomers present
+  // before may have to be sorted
+  if(oldSize>0)
+    linearizeSystem();
+  return true;
+}
+
+/**
+* @details Called after the workers of the phase were joined. The exception
+* is thrown in the calling thread, as the workers must not throw.
+*
+* @throw <std::runtime_error> if a worker failed
+*/
+template < class IngredientsType >
+void UpdaterAddLinearChainsParallel<IngredientsType>::checkWorkers(std::vector<Worker*>& workers, uint32_t phase){
+  std::stringstream errormessage;
+  bool failed(false);
+  for(uint32_t s=phase;s<workers.size();s+=2){
+    if(workers[s]->hasFailed()){
+      failed=true;
+      errormessage<<"UpdaterAddLinearChainsParallel: growing the chains of slab "<<s<<" failed: "<<workers[s]->getError()<<"\n";
+    }
+  }
+  if(!failed)
+    return;
+  for(size_t s=0;s<workers.size();s++){
+    delete workers[s];
+    workers[s]=0;
+  }
+  throw std::runtime_error(errormessage.str());
+}
+
+/**
+* @brief Standard clean up.
+*
+* @tparam IngredientsType Features used in the system. See Ingredients.
+*/
+template < class IngredientsType >
+void UpdaterAddLinearChainsParallel<IngredientsType>::cleanup(){
+
+}
+
+/******************************************************************************/
+/**
+ * @details The chains start in z0<=z<z1 and grow in zBegin<=z<zEnd. The free
+ * sites are set up from all monomers present before and the chains grown by
+ * the first phase. A slab covering the whole box keeps the periodicity in z,
+ * otherwise the slab with its halos is treated as non-periodic in z, which
+ * excludes the last layer.
+ */
+template < class IngredientsType >
+UpdaterAddLinearChainsParallel<IngredientsType>::Worker::Worker(const molecules_type& molecules_, const std::vector<VectorInt3>& grown_,
+								 const uint32_t box_[3], const bool periodic_[3],
+								 int32_t z0_, int32_t z1_, int32_t zBegin_, int32_t zEnd_, uint32_t nChains_, uint32_t chainLength_,
+								 const std::vector<VectorInt3>& shortBondvectors_, const std::vector<VectorInt3>& longBondvectors_,
+								 const std::vector<VectorInt3>& bondset, const uint32_t* seeds)
+:molecules(molecules_),grown(grown_),z0(z0_),z1(z1_),zBegin(zBegin_),zEnd(zEnd_),nChains(nChains_),chainLength(chainLength_)
+,shortBondvectors(shortBondvectors_),longBondvectors(longBondvectors_),bondRange(0),nFailed(0),failed(false)
+{
+  for(size_t d=0;d<3;d++){
+    box[d]=box_[d];
+    periodic[d]=periodic_[d];
+  }
+  rng.setState(seeds);
+
+  for(size_t k=0;k<bondset.size();k++)
+    for(size_t d=0;d<3;d++)
+      bondRange=std::max(bondRange,std::abs(bondset[k][d]));
+  const int32_t width=2*bondRange+1;
+  validBonds.assign(size_t(width)*width*width,false);
+  for(size_t k=0;k<bondset.size();k++)
+    validBonds[size_t((bondset[k][0]+bondRange)+width*((bondset[k][1]+bondRange)+width*(bondset[k][2]+bondRange)))]=true;
+}
+
+/**
+ * @details Setting up the index is part of the work of the thread, as it
+ * touches every site of the slab.
+ */
+template < class IngredientsType >
+void UpdaterAddLinearChainsParallel<IngredientsType>::Worker::run()
+{
+  try{
+    growChains();
+  }
+  catch(std::exception& e){
+    failed=true;
+    error=e.what();
+  }
+  catch(...){
+    failed=true;
+    error="unknown exception";
+  }
+}
+
+template < class IngredientsType >
+void UpdaterAddLinearChainsParallel<IngredientsType>::Worker::growChains()
+{
+  const uint32_t slabBox[3]={box[0],box[1],uint32_t(zEnd-zBegin)};
+  const bool slabPeriodic[3]={periodic[0],periodic[1],isWholeBox() && periodic[2]};
+  freeSites.setup(slabBox,slabPeriodic);
+
+  for(size_t n=0;n<molecules.size();n++)
+    occupyImages(molecules[n]);
+  for(size_t n=0;n<grown.size();n++)
+    occupyImages(grown[n]);
+
+  // the monomers of grown, whose bonded neighbors lie in the slab with its
+  // halos, are adopted; no other thread reaches them
+  const int32_t boxZ=int32_t(box[2]);
+  for(size_t n=0;n<grown.size();n++){
+    int32_t zLocal=grown[n].getZ()-zBegin;
+    if(periodic[2]) zLocal=((zLocal%boxZ)+boxZ)%boxZ;
+    if(zLocal>=bondRange && zLocal+2+bondRange<=zEnd-zBegin){
+      adoptedIndices.push_back(uint32_t(n));
+      adoptedPositions.push_back(VectorInt3(grown[n].getX(),grown[n].getY(),zLocal));
+      adoptedShifts.push_back(grown[n].getZ()-zLocal);
+    }
+  }
+
+  positions.reserve(size_t(nChains)*chainLength);
+  for(uint32_t c=0;c<nChains;c++)
+    if(!growChain()) nFailed++;
+
+  // the chains may be moved until the last one is grown, then they get box coordinates
+  for(size_t n=0;n<positions.size();n++)
+    positions[n].setZ(positions[n].getZ()+zBegin);
+}
+
+/**
+ * @details Monomers blocking sites of the slab and its halos lie in
+ * zBegin-1<=z<=zEnd, in a periodic box also their periodic images.
+ */
+template < class IngredientsType >
+void UpdaterAddLinearChainsParallel<IngredientsType>::Worker::occupyImages(const VectorInt3& pos)
+{
+  if(isWholeBox()){
+    freeSites.occupy(pos);
+    return;
+  }
+  const int32_t boxZ=int32_t(box[2]);
+  int32_t z=pos.getZ();
+  if(periodic[2]) z=((z%boxZ)+boxZ)%boxZ;
+  for(int32_t image=-1;image<=1;image++){
+    int32_t zLocal=z-zBegin+image*boxZ;
+    if((image==0 || periodic[2]) && zLocal>=-1 && zLocal<=zEnd-zBegin)
+      freeSites.occupy(VectorInt3(pos.getX(),pos.getY(),zLocal));
+  }
+}
+
+/**
+ * @details The chain starts on a random free site of the slab and every further monomer
+ * takes a random free bond vector of length 2 (the other vectors of the bondset
+ * only as in UpdaterAbstractCreate::addMonomerToParent). If the chain end is
+ * enclosed, the monomers of the thread around it are moved with the same
+ * schedule as in addMonomerToParent, see relax(). A chain, whose end can not
+ * be continued after 10000 such tries, is removed again and built serially.
+ * @return true if the chain was placed
+ */
+template < class IngredientsType >
+bool UpdaterAddLinearChainsParallel<IngredientsType>::Worker::growChain()
+{
+  const size_t start=positions.size();
+  if(freeSites.getNumberOfFreeSites()==0) return false;
+
+  // the first monomer lies in the slab, which holds at least half of the sites
+  VectorInt3 first(freeSites.getFreeSite(rng.r250_rand()%freeSites.getNumberOfFreeSites()));
+  for(uint32_t draw=1;draw<100 && (first.getZ()<z0-zBegin || first.getZ()>=z1-zBegin);draw++)
+    first=freeSites.getFreeSite(rng.r250_rand()%freeSites.getNumberOfFreeSites());
+  if(first.getZ()<z0-zBegin || first.getZ()>=z1-zBegin) return false;
+  positions.push_back(first);
+  freeSites.occupy(positions.back());
+
+  uint32_t counter=0;
+  while(positions.size()-start<chainLength && counter<10000){
+    const VectorInt3 parent(positions.back());
+    bool added=false;
+    for(int set=0;set<2 && !added;set++){
+      const std::vector<VectorInt3>& bondvectors(set==0 ? shortBondvectors : longBondvectors);
+      candidates.clear();
+      for(size_t k=0;k<bondvectors.size();k++)
+	if(freeSites.isFree(parent+bondvectors[k]))
+	  candidates.push_back(parent+bondvectors[k]);
+      if(!candidates.empty()){
+	positions.push_back(candidates[rng.r250_rand()%candidates.size()]);
+	freeSites.occupy(positions.back());
+	added=true;
+	counter=0;
+      }
+    }
+    if(!added){
+      relax(counter);
+      counter++;
+    }
+  }
+  if(positions.size()-start==chainLength)
+    return true;
+
+  while(positions.size()>start){
+    freeSites.release(positions.back());
+    positions.pop_back();
+  }
+  return false;
+}
+
+/**
+ * @details As in UpdaterAbstractCreate::addMonomerToParent, every hundredth try
+ * moves all monomers twice, every tenth try the monomers within 5 lattice units
+ * of the chain end ten times and the other tries the chain end and its bonded
+ * neighbors up to 4+counter/100 bonds ten times. Only the monomers grown by
+ * this thread and the adopted ones are moved, the monomers present before and
+ * those grown by the other threads of the phase are fixed.
+ */
+template < class IngredientsType >
+void UpdaterAddLinearChainsParallel<IngredientsType>::Worker::relax(uint32_t counter)
+{
+  const uint32_t end=uint32_t(positions.size()-1);
+  const uint32_t nMonomers=uint32_t(positions.size()+adoptedPositions.size());
+  group.clear();
+  if(counter%100==99){
+    for(uint32_t n=0;n<nMonomers;n++) group.push_back(n);
+    moveMonomers(group,2);
+  }
+  else if(counter%10==9){
+    const VectorInt3 center(positions[end]);
+    for(uint32_t n=0;n<nMonomers;n++){
+      bool inside=true;
+      for(size_t d=0;d<3 && inside;d++){
+	int32_t x=getMonomer(n)[d]-center[d];
+	if(d<2 && periodic[d]){
+	  const int32_t b=int32_t(box[d]);
+	  x=((x%b)+b)%b;
+	  if(x>b/2) x-=b;
+	}
+	inside=(x>=-5 && x<=5);
+      }
+      if(inside) group.push_back(n);
+    }
+    moveMonomers(group,10);
+  }
+  else{
+    // the bonded neighbors of a linear chain end are the preceding monomers
+    const uint32_t chainStart=end-end%chainLength;
+    const uint32_t depth=4+counter/100;
+    for(uint32_t n=end+1;n>chainStart && end+1-n<=depth;n--) group.push_back(n-1);
+    moveMonomers(group,10);
+  }
+}
+
+template < class IngredientsType >
+void UpdaterAddLinearChainsParallel<IngredientsType>::Worker::moveMonomers(const std::vector<uint32_t>& group_, uint32_t nsteps)
+{
+  static const VectorInt3 directions[6]={VectorInt3(1,0,0),VectorInt3(-1,0,0),VectorInt3(0,1,0),
+					 VectorInt3(0,-1,0),VectorInt3(0,0,1),VectorInt3(0,0,-1)};
+  for(size_t n=0;n<size_t(nsteps)*group_.size();n++){
+    uint32_t monomer=group_[rng.r250_rand()%group_.size()];
+    moveMonomer(monomer,directions[rng.r250_rand()%6]);
+  }
+}
+
+/**
+ * @details The move is checked like MoveLocalSc with the excluded volume and
+ * the bondset. The free sites of the slab with its halos restrict the monomers
+ * to the region the thread owns. An adopted monomer must keep its bonded
+ * neighbors in this region, so it stays bondRange away from its borders.
+ */
+template < class IngredientsType >
+bool UpdaterAddLinearChainsParallel<IngredientsType>::Worker::moveMonomer(uint32_t n, const VectorInt3& dir)
+{
+  const VectorInt3 oldPos(getMonomer(n));
+  const VectorInt3 newPos(oldPos+dir);
+  if(n<positions.size()){
+    const uint32_t k=n%chainLength;
+    if(k>0 && !isValidBond(newPos-positions[n-1])) return false;
+    if(k+1<chainLength && n+1<positions.size() && !isValidBond(positions[n+1]-newPos)) return false;
+  }
+  else{
+    const uint32_t a=uint32_t(n-positions.size());
+    const uint32_t g=adoptedIndices[a];
+    const uint32_t k=g%chainLength;
+    if(newPos.getZ()<bondRange || newPos.getZ()+2+bondRange>zEnd-zBegin) return false;
+    // neighbors, which are not adopted, are fixed during the second phase
+    const VectorInt3 shift(0,0,adoptedShifts[a]);
+    if(k>0 && !isValidBond(newPos-((a>0 && adoptedIndices[a-1]==g-1) ? adoptedPositions[a-1] : grown[g-1]-shift))) return false;
+    if(k+1<chainLength && !isValidBond(((a+1<adoptedIndices.size() && adoptedIndices[a+1]==g+1) ? adoptedPositions[a+1] : grown[g+1]-shift)-newPos)) return false;
+  }
+
+  freeSites.release(oldPos);
+  if(!freeSites.isFree(newPos)){
+    freeSites.occupy(oldPos);
+    return false;
+  }
+  freeSites.occupy(newPos);
+  if(n<positions.size())
+    positions[n]=newPos;
+  else
+    adoptedPositions[n-positions.size()]=newPos;
+  return true;
+}
+
+template < class IngredientsType >
+bool UpdaterAddLinearChainsParallel<IngredientsType>::Worker::isValidBond(const VectorInt3& bond) const
+{
+  const int32_t width=2*bondRange+1;
+  for(size_t d=0;d<3;d++)
+    if(bond[d]<-bondRange || bond[d]>bondRange) return false;
+  return validBonds[size_t((bond[0]+bondRange)+width*((bond[1]+bondRange)+width*(bond[2]+bondRange)))];
+}
+
+template < class IngredientsType >
+void UpdaterAddLinearChainsParallel<IngredientsType>::Worker::storeAdopted(std::vector<VectorInt3>& grown_) const
+{
+  for(size_t a=0;a<adoptedIndices.size();a++)
+    grown_[adoptedIndices[a]]=adoptedPositions[a]+VectorInt3(0,0,adoptedShifts[a]);
+}
+
+#endif /* LEMONADE_UPDATER_ADD_LINEAR_CHAINS_PARALLEL_H */
@@ -0,0 +1,141 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_ADD_POLYDISPERSE_CHAINS_H
+#define LEMONADE_UPDATER_ADD_POLYDISPERSE_CHAINS_H
+/**
+ * @file
+ *
+ * @class UpdaterAddPolydisperseChains
+ *
+ * @brief Updater to add linear chains of different lengths
+ *
+ * @details The chain lengths are either given explicitly, or the lengths of
+ * NChain chains are taken from a number distribution of chain lengths. In
+ * the latter case chain i gets the length at the quantile (i+0.5)/NChain of
+ * the distribution, so the sample follows the distribution as closely as
+ * possible and the setup is reproducible. As in UpdaterAddLinearChains the
+ * monomers of every chain are tagged alternating with type1 and type2. This
+ * updater requires FeatureAttributes.
+ *
+ * @tparam IngredientsType
+ **/
+
+#include <sstream>
+#include <stdexcept>
+
+#include <LeMonADE/updater/UpdaterAbstractAddMolecules.h>
+
+template<class IngredientsType>
+class UpdaterAddPolydisperseChains: public UpdaterAbstractAddMolecules<IngredientsType>
+{
+  typedef UpdaterAbstractAddMolecules<IngredientsType> BaseClass;
+
+public:
+  //! adds one chain for every entry of chainLengths_
+  UpdaterAddPolydisperseChains(IngredientsType& ingredients_, const std::vector<uint32_t>& chainLengths_, int32_t type1_=1, int32_t type2_=2);
+
+  //! adds NChain chains, distribution_[N] is the relative number of chains of length N
+  UpdaterAddPolydisperseChains(IngredientsType& ingredients_, uint32_t NChain, const std::vector<double>& distribution_, int32_t type1_=1, int32_t type2_=2);
+
+  virtual uint32_t getNumberOfMolecules() const {return uint32_t(chainLengths.size());}
+
+  virtual void getMolecule(uint32_t m, std::vector<int32_t>& parents, std::vector<int32_t>& types) const;
+
+  //! getter function for the lengths of the chains
+  const std::vector<uint32_t>& getChainLengths() const {return chainLengths;}
+
+private:
+  //! lengths of the chains
+  std::vector<uint32_t> chainLengths;
+
+  //! attribute tag of even monomers
+  int32_t type1;
+
+  //! attribute tag of odd monomers
+  int32_t type2;
+};
+
+/**
+* @param ingredients_ a reference to the IngredientsType - mainly the system
+* @param chainLengths_ number of monomers of every chain
+* @param type1_ attribute tag of "even" monomers
+* @param type2_ attribute tag of "odd" monomers
+*/
+template < class IngredientsType >
+UpdaterAddPolydisperseChains<IngredientsType>::UpdaterAddPolydisperseChains(IngredientsType& ingredients_, const std::vector<uint32_t>& chainLengths_, int32_t type1_, int32_t type2_)
+:BaseClass(ingredients_,"UpdaterAddPolydisperseChains"),chainLengths(chainLengths_),type1(type1_),type2(type2_)
+{}
+
+/**
+* @param ingredients_ a reference to the IngredientsType - mainly the system
+* @param NChain number of chains
+* @param distribution_ relative number of chains of length N at index N, need not be normalized
+* @param type1_ attribute tag of "even" monomers
+* @param type2_ attribute tag of "odd" monomers
+* @throw std::runtime_error if the distribution has negative entries or no chain of positive length
+*/
+template < class IngredientsType >
+UpdaterAddPolydisperseChains<IngredientsType>::UpdaterAddPolydisperseChains(IngredientsType& ingredients_, uint32_t NChain, const std::vector<double>& distribution_, int32_t type1_, int32_t type2_)
+:BaseClass(ingredients_,"UpdaterAddPolydisperseChains"),type1(type1_),type2(type2_)
+{
+  double norm(0.0);
+  for(size_t N=0;N<distribution_.size();N++){
+    if(distribution_[N]<0.0){
+      std::stringstream errormessage;
+      errormessage<<"UpdaterAddPolydisperseChains: negative weight "<<distribution_[N]<<" of chain length "<<N;
+      throw std::runtime_error(errormessage.str());
+    }
+    if(N>0) norm+=distribution_[N];
+  }
+  if(norm<=0.0)
+    throw std::runtime_error("UpdaterAddPolydisperseChains: the chain length distribution is empty");
+
+  // walk along the cumulative distribution, chain lengths are increasing
+  size_t N(1);
+  double cumulative(distribution_[1]/norm);
+  for(uint32_t i=0;i<NChain;i++){
+    double quantile((i+0.5)/NChain);
+    while(cumulative<quantile && N+1<distribution_.size()){
+      N++;
+      cumulative+=distribution_[N]/norm;
+    }
+    chainLengths.push_back(uint32_t(N));
+  }
+}
+
+template < class IngredientsType >
+void UpdaterAddPolydisperseChains<IngredientsType>::getMolecule(uint32_t m, std::vector<int32_t>& parents, std::vector<int32_t>& types) const{
+  parents.clear();
+  types.clear();
+  for(uint32_t k=0;k<chainLengths[m];k++){
+    parents.push_back(int32_t(k)-1);
+    types.push_back(k%2==0 ? type1 : type2);
+  }
+}
+
+#endif /* LEMONADE_UPDATER_ADD_POLYDISPERSE_CHAINS_H */
@@ -0,0 +1,102 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_ADD_STARS_H
+#define LEMONADE_UPDATER_ADD_STARS_H
+/**
+ * @file
+ *
+ * @class UpdaterAddStars
+ *
+ * @brief Updater to add monodisperse star polymers
+ *
+ * @details Every star consists of a core monomer and NArms arms of
+ * NMonoPerArm monomers. The core is stored first, followed by the arms one
+ * after the other, each starting at the core. This updater requires
+ * FeatureAttributes.
+ *
+ * @tparam IngredientsType
+ *
+ * @param ingredients_ The system, holding either an empty simulation box for system setup
+ * or a prefilled ingredients where the stars shall be added
+ * @param NStars_ number of stars
+ * @param NArms_ number of arms of a star
+ * @param NMonoPerArm_ number of monomers in an arm without the core
+ * @param typeCore_ attribute tag of the core monomers
+ * @param typeArm_ attribute tag of the arm monomers
+ **/
+
+#include <LeMonADE/updater/UpdaterAbstractAddMolecules.h>
+
+template<class IngredientsType>
+class UpdaterAddStars: public UpdaterAbstractAddMolecules<IngredientsType>
+{
+  typedef UpdaterAbstractAddMolecules<IngredientsType> BaseClass;
+
+public:
+  UpdaterAddStars(IngredientsType& ingredients_, uint32_t NStars_, uint32_t NArms_, uint32_t NMonoPerArm_, int32_t typeCore_=1, int32_t typeArm_=2)
+  :BaseClass(ingredients_,"UpdaterAddStars"),NStars(NStars_),NArms(NArms_),NMonoPerArm(NMonoPerArm_),typeCore(typeCore_),typeArm(typeArm_){}
+
+  virtual uint32_t getNumberOfMolecules() const {return NStars;}
+
+  virtual void getMolecule(uint32_t m, std::vector<int32_t>& parents, std::vector<int32_t>& types) const;
+
+  //! getter function for number of arms
+  uint32_t getNArms() const {return NArms;}
+
+  //! getter function for number of monomers in an arm
+  uint32_t getNMonomerPerArm() const {return NMonoPerArm;}
+
+private:
+  //! number of stars
+  uint32_t NStars;
+
+  //! number of arms per star
+  uint32_t NArms;
+
+  //! number of monomers per arm
+  uint32_t NMonoPerArm;
+
+  //! attribute tag of the core
+  int32_t typeCore;
+
+  //! attribute tag of the arms
+  int32_t typeArm;
+};
+
+template < class IngredientsType >
+void UpdaterAddStars<IngredientsType>::getMolecule(uint32_t /*m*/, std::vector<int32_t>& parents, std::vector<int32_t>& types) const{
+  parents.assign(1,-1);
+  types.assign(1,typeCore);
+  for(uint32_t a=0;a<NArms;a++)
+    for(uint32_t j=0;j<NMonoPerArm;j++){
+      parents.push_back(j==0 ? 0 : int32_t(parents.size())-1);
+      types.push_back(typeArm);
+    }
+}
+
+#endif /* LEMONADE_UPDATER_ADD_STARS_H */
@@ -37,12 +37,17 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <LeMonADE/updater/AbstractUpdater.h>
 #include <LeMonADE/io/FileImport.h>
+#include <LeMonADE/io/FileImportPipeline.h>
 
 /*****************************************************************************/
 /**
  * @class UpdaterReadBfmFile
  *
  * @brief Updater that reads configurations from bfm-file. On each execute call it reads the next configuration.
+ *
+ * @details With READ_STEPWISE, the frames can optionally be decoded on worker threads
+ * while the analyzers process the current frame (see FileImportPipeline). This is
+ * enabled by passing a number of decoder threads larger than zero.
  **/
 template <class IngredientsType>
 class UpdaterReadBfmFile: public AbstractUpdater
@@ -54,9 +59,18 @@ public:
 	 * @param filename PathAndFilename+Suffix to be loaded
 	 * @param ing A reference to the IngredientsType - mainly the system
 	 * @param readType ENUM for specify read-in
+	 * @param nDecoderThreads Number of threads decoding frames in advance (READ_STEPWISE only). Default 0: no threads.
+	 * @param nFramesAhead Number of frames decoded in advance. Default 0: twice the number of threads.
 	 */
-  UpdaterReadBfmFile(std::string filename,IngredientsType& ing,int readType)
-    :ingredients(ing),file(filename,ing),myReadType(readType){};
+  UpdaterReadBfmFile(std::string filename,IngredientsType& ing,int readType,uint32_t nDecoderThreads=0,uint32_t nFramesAhead=0)
+    :ingredients(ing),file(filename,ing),myReadType(readType)
+    ,nThreads(nDecoderThreads),nAhead(nFramesAhead),pipeline(0){};
+
+  //! Stops the decoder threads if present
+  virtual ~UpdaterReadBfmFile(){delete pipeline;}
+
+  //! Use the sidecar frame index of FileImport (default: false). Must be called before initialize().
+  void setUseFrameIndex(bool use){file.setUseFrameIndex(use);}
 
 
   /**
@@ -84,12 +98,20 @@ public:
    **/
   virtual void initialize()
   {
-
 	  file.initialize();
 
 
 		if(myReadType==READ_STEPWISE)
+		{
 			file.read();
+
+			//decode the following frames in advance
+			if(nThreads>0 && pipeline==0)
+			{
+				pipeline=new FileImportPipeline<IngredientsType>(file,ingredients,nThreads,nAhead);
+				pipeline->start(file.getRecentFrameCount()+1);
+			}
+		}
 		else if(myReadType==READ_LAST_CONFIG_SAVE)
 		{
 			file.gotoEndSave();
@@ -125,7 +147,7 @@ public:
 	bool retVal = false;
 
 	if(myReadType==READ_STEPWISE)
-		retVal=file.read();
+		retVal=(pipeline!=0)?pipeline->read():file.read();
 
 	/*
 	else if(myReadType==READ_LAST_CONFIG_SAVE)
@@ -195,13 +217,28 @@ public:
 
 
   //! Jumps to the last conformation in the file and reads it (unsafely forward-winding).
-  void gotoEnd(){file.gotoEnd();}
+  void gotoEnd(){file.gotoEnd();restartPipeline();}
 
-  //! Jumps to the last conformation in the file and reads it (unsafely reverse-winding).
-  void gotoStart(){file.gotoStart();}
+  /**
+   * @brief Jumps to the first conformation in the file and reads it (unsafely reverse-winding).
+   *
+   * @details If the first frame is at mcs 0, FileImport::gotoStart() reads it and
+   * the decoding continues with the second frame. Otherwise the first conformation is
+   * restored from the header and the file is positioned before the first frame,
+   * which is then read again by the next execute(), as in the sequential case.
+   **/
+  void gotoStart()
+  {
+	file.gotoStart();
+	if(pipeline!=0)
+	{
+		if(file.getMinAge()==0) restartPipeline();
+		else pipeline->restart(1);
+	}
+  }
 
   //! Jumps to frame and reads conformation in the file and reads it (unsafely verse-winding).
-  void gotoFrame(uint32_t frame){file.gotoFrame(frame);}
+  void gotoFrame(uint32_t frame){file.gotoFrame(frame);restartPipeline();}
 
 
   //! Close the file stream.
@@ -217,6 +254,22 @@ private:
 	//! ENUM-type BFM_READ_TYPE specify the read-in
 	int myReadType;
 
+	//! Number of threads decoding frames in advance
+	uint32_t nThreads;
+
+	//! Number of frames decoded in advance
+	uint32_t nAhead;
+
+	//! Decodes frames in advance if nThreads>0, created in initialize()
+	FileImportPipeline<IngredientsType>* pipeline;
+
+	//! Continues decoding after the frame the file was positioned at
+	void restartPipeline(){if(pipeline!=0) pipeline->restart(file.getRecentFrameCount()+1);}
+
+	//! no copies, the pipeline is owned by this object
+	UpdaterReadBfmFile(const UpdaterReadBfmFile&);
+	UpdaterReadBfmFile& operator=(const UpdaterReadBfmFile&);
+
 };
 
 #endif
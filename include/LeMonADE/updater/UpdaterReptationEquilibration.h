@@ -0,0 +1,202 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_UPDATERREPTATIONEQUILIBRATION_H
+#define LEMONADE_UPDATER_UPDATERREPTATIONEQUILIBRATION_H
+
+#include <LeMonADE/updater/AbstractUpdater.h>
+#include <LeMonADE/updater/moves/MoveReptationSc.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+
+/**
+ * @file
+ *
+ * @class UpdaterReptationEquilibration
+ *
+ * @brief Simulation updater for the equilibration of melts of linear chains
+ *
+ * @details Every Monte Carlo step consists of a sweep of local moves (MoveType)
+ * over all monomers followed by reptation moves (ReptationMoveType, e.g.
+ * MoveReptationSc), on average getReptationFrequency() attempts per chain.
+ * The reptation moves relax the chain conformations on a time scale growing
+ * only with the square of the chain length and speed up the equilibration of
+ * long chains considerably. The dynamics is not physical, so the updater must
+ * not be used for the measurement of dynamic properties.
+ *
+ * During execute() the monomers of the chains are stored in ring buffer
+ * order, see MoveReptationSc. By default the consecutive order of the
+ * monomers along the chains is restored by linearize() at the end of every
+ * execute(), i.e. analyzers and writers always see the usual order. As this
+ * rotates the monomer data of all chains and synchronizes the system, the
+ * ring buffers can be kept across calls with setLinearizationPeriod(): the
+ * order is then only restored every period calls to execute() and in
+ * cleanup() (period 0: in cleanup() only). Analyzers running in between see
+ * permuted monomer indices, which no longer follow the chain contour, and
+ * e.g. AnalyzerWriteBfmFile writes frames that do not match the bonds of its
+ * header. A period larger than one should therefore only be used with
+ * analyzers running at multiples of the period, or for pure equilibration
+ * runs. Only linear chains with consecutive monomer indices are moved by
+ * reptation, all other molecules are equilibrated by the local moves only.
+ *
+ * @tparam IngredientsType Ingredients class storing all system information( e.g. monomers, bonds, etc).
+ * @tparam MoveType name of the specialized local move.
+ * @tparam ReptationMoveType name of the specialized reptation move, e.g. MoveReptationSc
+ */
+template<class IngredientsType, class MoveType, class ReptationMoveType=MoveReptationSc>
+class UpdaterReptationEquilibration:public AbstractUpdater
+{
+public:
+  /**
+   * @brief Standard Constructor initialized with ref to Ingredients and MCS per cycle
+   *
+   * @param ing a reference to the IngredientsType - mainly the system
+   * @param steps MCS per cycle to performed by execute()
+   * @param frequency reptation attempts per chain and MCS
+   */
+  UpdaterReptationEquilibration(IngredientsType& ing, uint32_t steps=1, double frequency=1.0)
+  :ingredients(ing),nsteps(steps),reptationFrequency(frequency)
+  ,linearizationPeriod(1),nExecutions(0)
+  ,NReptationAttempts(0),NReptations(0){}
+
+  //! Performs steps MCS of local moves and reptation attempts
+  bool execute();
+
+  //! Detects the linear chains in the system
+  virtual void initialize(){reptationMove.setupChains(ingredients);}
+
+  //! Restores the consecutive order of the monomers along the chains
+  virtual void cleanup(){linearize();}
+
+  //! Restores the consecutive order of the monomers along the chains and synchronizes the system if necessary
+  void linearize(){reptationMove.linearize(ingredients);}
+
+  //! Sets the number of calls to execute() after which the order is restored (default 1), 0 for cleanup() only
+  void setLinearizationPeriod(uint32_t period){linearizationPeriod=period;}
+
+  //! Number of calls to execute() after which the order is restored, 0 for cleanup() only
+  uint32_t getLinearizationPeriod() const {return linearizationPeriod;}
+
+  //! Sets the number of reptation attempts per chain and MCS
+  void setReptationFrequency(double frequency){reptationFrequency=frequency;}
+
+  //! Number of reptation attempts per chain and MCS
+  double getReptationFrequency() const {return reptationFrequency;}
+
+  //! Number of chains moved by reptation
+  uint32_t getNumberOfChains() const {return reptationMove.getNumberOfChains();}
+
+  //! Number of reptation attempts so far
+  uint64_t getNumReptationAttempts() const {return NReptationAttempts;}
+
+  //! Number of accepted reptation moves so far
+  uint64_t getNumReptations() const {return NReptations;}
+
+protected:
+  //! A reference to the IngredientsType - mainly the system
+  IngredientsType& ingredients;
+
+  //! Specialized move to be used for the movement of the monomers
+  MoveType move;
+
+  //! Specialized move to be used for the reptation of the chains
+  ReptationMoveType reptationMove;
+
+  //! random number generator (seed set in main program)
+  RandomNumberGenerators rng;
+
+private:
+  //! Number of mcs to be executed
+  uint32_t nsteps;
+
+  //! reptation attempts per chain and MCS
+  double reptationFrequency;
+
+  //! calls to execute() after which the order is restored, 0 for cleanup() only
+  uint32_t linearizationPeriod;
+
+  //! number of calls to execute()
+  uint64_t nExecutions;
+
+  //! statistics
+  uint64_t NReptationAttempts;
+  uint64_t NReptations;
+};
+
+/**
+ * @details The number of reptation attempts per MCS is the reptation frequency
+ * times the number of chains, rounded stochastically such that the average is
+ * exact. The work counters contain the local moves only. The chains are only
+ * left in ring buffer order if a linearization period other than 1 is set.
+ */
+template<class IngredientsType, class MoveType, class ReptationMoveType>
+bool UpdaterReptationEquilibration<IngredientsType,MoveType,ReptationMoveType>::execute()
+{
+  uint64_t nAccepted=0;
+
+  if(reptationMove.getNumberOfChains()==0)
+    reptationMove.setupChains(ingredients);
+
+  for(uint32_t n=0;n<nsteps;n++)
+  {
+    for(size_t m=0;m<ingredients.getMolecules().size();m++)
+    {
+      move.init(ingredients);
+      if(move.check(ingredients)==true)
+      {
+        move.apply(ingredients);
+        nAccepted++;
+      }
+    }
+
+    if(reptationMove.getNumberOfChains()>0)
+    {
+      uint64_t nAttempts=uint64_t(reptationFrequency*double(reptationMove.getNumberOfChains())+rng.r250_drand());
+      for(uint64_t attempt=0;attempt<nAttempts;attempt++)
+      {
+        NReptationAttempts++;
+        reptationMove.init(ingredients);
+        if(reptationMove.check(ingredients)==true)
+        {
+          reptationMove.apply(ingredients);
+          NReptations++;
+        }
+      }
+    }
+
+    ingredients.modifyMolecules().setAge(ingredients.getMolecules().getAge()+1);
+  }
+
+  //restore the consecutive order of the monomers for analyzers and output
+  nExecutions++;
+  if(linearizationPeriod>0 && nExecutions%linearizationPeriod==0)
+    linearize();
+
+  addWorkCounters(uint64_t(nsteps)*ingredients.getMolecules().size(),nAccepted,nsteps);
+  return true;
+}
+
+#endif /* LEMONADE_UPDATER_UPDATERREPTATIONEQUILIBRATION_H */
@@ -0,0 +1,289 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_UPDATERREVERSIBLECONNECTION_H
+#define LEMONADE_UPDATER_UPDATERREVERSIBLECONNECTION_H
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <LeMonADE/updater/AbstractUpdater.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+
+/**
+ * @file
+ *
+ * @class UpdaterReversibleConnection
+ *
+ * @brief Simulation updater for dynamic networks with reversible bonds
+ *
+ * @details Every Monte Carlo step consists of a sweep of local moves (MoveType)
+ * over all monomers followed by reaction attempts, on average
+ * getReactionFrequency() attempts per reactive monomer. For every attempt a
+ * reactive monomer and one of the bond directions of the connection moves are
+ * chosen at random. If the monomer is bonded in this direction, breaking the
+ * bond is proposed (DisconnectionMoveType, e.g. MoveDisconnectSc), otherwise
+ * connecting to the monomer at this site (ConnectionMoveType, e.g.
+ * MoveConnectSc). Both proposals are made with the same probability for a
+ * given pair of monomers, so accepting connections with probability p_connect
+ * and breaks with probability p_break fulfills detailed balance with the
+ * equilibrium constant p_connect/p_break. The probabilities are set directly
+ * (rates) or from the bond energy with the Metropolis criterion (setBondEnergy()).
+ *
+ * Only bonds between two reactive monomers are broken, see FeatureConnectionSc.
+ * Every reaction attempt needs only the bonds of one monomer and a lattice
+ * lookup, the reactive monomers are collected once in initialize().
+ *
+ * @tparam IngredientsType Ingredients class storing all system information( e.g. monomers, bonds, etc).
+ * @tparam MoveType name of the specialized local move.
+ * @tparam ConnectionMoveType name of the specialized connection move, e.g. MoveConnectSc
+ * @tparam DisconnectionMoveType name of the specialized move breaking bonds, e.g. MoveDisconnectSc
+ */
+template<class IngredientsType, class MoveType, class ConnectionMoveType, class DisconnectionMoveType>
+class UpdaterReversibleConnection:public AbstractUpdater
+{
+public:
+  /**
+   * @brief Standard Constructor initialized with ref to Ingredients and MCS per cycle
+   *
+   * @param ing a reference to the IngredientsType - mainly the system
+   * @param steps MCS per cycle to performed by execute()
+   * @param frequency reaction attempts per reactive monomer and MCS
+   */
+  UpdaterReversibleConnection(IngredientsType& ing, uint32_t steps=1, double frequency=1.0)
+  :ingredients(ing),nsteps(steps),reactionFrequency(frequency)
+  ,probabilityConnect(1.0),probabilityBreak(1.0)
+  ,NReactiveSites(0),NReactedSites(0),NReactionAttempts(0),NConnections(0),NBreaks(0){}
+
+  //! Performs steps MCS of local moves and reaction attempts
+  bool execute();
+
+  //! Collects the reactive monomers and counts the reacted sites
+  virtual void initialize();
+
+  virtual void cleanup(){};
+
+  //! Sets the acceptance probabilities for new and broken bonds
+  void setReactionProbabilities(double connect, double disconnect);
+
+  //! Sets the acceptance probabilities from the bond energy in units of kT with the Metropolis criterion
+  void setBondEnergy(double energy)
+  {
+    setReactionProbabilities(std::min(1.0,std::exp(-energy)),std::min(1.0,std::exp(energy)));
+  }
+
+  //! Acceptance probability of a proposed new bond
+  double getConnectionProbability() const {return probabilityConnect;}
+
+  //! Acceptance probability of a proposed bond break
+  double getBreakProbability() const {return probabilityBreak;}
+
+  //! Sets the number of reaction attempts per reactive monomer and MCS
+  void setReactionFrequency(double frequency){reactionFrequency=frequency;}
+
+  //! Number of reaction attempts per reactive monomer and MCS
+  double getReactionFrequency() const {return reactionFrequency;}
+
+  //! Fraction of reacted sites
+  double getConversion() const {return double(NReactedSites)/double(NReactiveSites);}
+
+  //! Number of reaction attempts so far
+  uint64_t getNumReactionAttempts() const {return NReactionAttempts;}
+
+  //! Number of bonds formed so far
+  uint64_t getNumConnections() const {return NConnections;}
+
+  //! Number of bonds broken so far
+  uint64_t getNumBreaks() const {return NBreaks;}
+
+protected:
+  //! One reaction attempt for a random reactive monomer and direction
+  void attemptReaction();
+
+  //! Returns true with the given probability
+  bool accept(double probability){return probability>=1.0 || rng.r250_drand()<probability;}
+
+  //! A reference to the IngredientsType - mainly the system
+  IngredientsType& ingredients;
+
+  //! Specialized move to be used for the movement of the monomers
+  MoveType move;
+
+  //! Specialized move to be used for the connection between reactive monomers
+  ConnectionMoveType connectionMove;
+
+  //! Specialized move to be used for breaking bonds between reactive monomers
+  DisconnectionMoveType disconnectionMove;
+
+  //! random number generator (seed set in main program)
+  RandomNumberGenerators rng;
+
+private:
+  //! Number of mcs to be executed
+  uint32_t nsteps;
+
+  //! reaction attempts per reactive monomer and MCS
+  double reactionFrequency;
+
+  //! acceptance probabilities
+  double probabilityConnect;
+  double probabilityBreak;
+
+  //! all reactive monomers
+  std::vector<uint32_t> reactiveMonomers;
+
+  //! number of reactive sites and of sites bonded to other reactive monomers
+  uint64_t NReactiveSites;
+  uint64_t NReactedSites;
+
+  //! statistics
+  uint64_t NReactionAttempts;
+  uint64_t NConnections;
+  uint64_t NBreaks;
+};
+
+/**
+ * @param connect acceptance probability of a new bond, in [0,1]
+ * @param disconnect acceptance probability of a bond break, in [0,1]
+ * @throw std::runtime_error if a probability is out of range
+ */
+template<class IngredientsType, class MoveType, class ConnectionMoveType, class DisconnectionMoveType>
+void UpdaterReversibleConnection<IngredientsType,MoveType,ConnectionMoveType,DisconnectionMoveType>::setReactionProbabilities(double connect, double disconnect)
+{
+  if(!(connect>=0.0 && connect<=1.0) || !(disconnect>=0.0 && disconnect<=1.0))
+  {
+    std::stringstream errormessage;
+    errormessage<<"UpdaterReversibleConnection::setReactionProbabilities(): probabilities "
+                <<connect<<" and "<<disconnect<<" are not in [0,1]";
+    throw std::runtime_error(errormessage.str());
+  }
+  probabilityConnect=connect;
+  probabilityBreak=disconnect;
+}
+
+/**
+ * @details The number of reaction attempts per MCS is the reaction frequency
+ * times the number of reactive monomers, rounded stochastically such that the
+ * average is exact.
+ */
+template<class IngredientsType, class MoveType, class ConnectionMoveType, class DisconnectionMoveType>
+bool UpdaterReversibleConnection<IngredientsType,MoveType,ConnectionMoveType,DisconnectionMoveType>::execute()
+{
+  uint64_t nAccepted=0;
+
+  for(uint32_t n=0;n<nsteps;n++)
+  {
+    for(size_t m=0;m<ingredients.getMolecules().size();m++)
+    {
+      move.init(ingredients);
+      if(move.check(ingredients)==true)
+      {
+        move.apply(ingredients);
+        nAccepted++;
+      }
+    }
+
+    uint64_t nAttempts=uint64_t(reactionFrequency*double(reactiveMonomers.size())+rng.r250_drand());
+    for(uint64_t attempt=0;attempt<nAttempts;attempt++)
+      attemptReaction();
+
+    ingredients.modifyMolecules().setAge(ingredients.getMolecules().getAge()+1);
+  }
+  addWorkCounters(uint64_t(nsteps)*ingredients.getMolecules().size(),nAccepted,nsteps);
+  return true;
+}
+
+/**
+ * @details The random numbers for the acceptance are only drawn for
+ * proposals allowed by the features.
+ */
+template<class IngredientsType, class MoveType, class ConnectionMoveType, class DisconnectionMoveType>
+void UpdaterReversibleConnection<IngredientsType,MoveType,ConnectionMoveType,DisconnectionMoveType>::attemptReaction()
+{
+  NReactionAttempts++;
+  uint32_t index=reactiveMonomers[rng.r250_rand32()%reactiveMonomers.size()];
+  const VectorInt3& direction=connectionMove.getShellPosition(rng.r250_rand32()%connectionMove.getNumShellPositions());
+
+  disconnectionMove.init(ingredients,index,direction);
+  if(disconnectionMove.getPartner()!=uint32_t(-1))
+  {
+    if(disconnectionMove.check(ingredients) && accept(probabilityBreak))
+    {
+      disconnectionMove.apply(ingredients);
+      NReactedSites-=2;
+      NBreaks++;
+    }
+    return;
+  }
+
+  connectionMove.init(ingredients,index,direction);
+  if(connectionMove.check(ingredients) && accept(probabilityConnect))
+  {
+    connectionMove.apply(ingredients);
+    NReactedSites+=2;
+    NConnections++;
+  }
+}
+
+/**
+ * @throw std::runtime_error if there are no reactive monomers
+ */
+template<class IngredientsType, class MoveType, class ConnectionMoveType, class DisconnectionMoveType>
+void UpdaterReversibleConnection<IngredientsType,MoveType,ConnectionMoveType,DisconnectionMoveType>::initialize()
+{
+  reactiveMonomers.clear();
+  NReactiveSites=0;
+  NReactedSites=0;
+  for(uint32_t i=0;i<ingredients.getMolecules().size();i++)
+  {
+    if(!ingredients.getMolecules()[i].isReactive()) continue;
+    reactiveMonomers.push_back(i);
+    uint32_t nIrreversibleBonds=0;
+    for(uint32_t n=0;n<ingredients.getMolecules().getNumLinks(i);n++)
+    {
+      uint32_t neighbor(ingredients.getMolecules().getNeighborIdx(i,n));
+      if(ingredients.getMolecules()[neighbor].isReactive())
+        NReactedSites++;
+      else
+        nIrreversibleBonds++;
+    }
+    NReactiveSites+=(ingredients.getMolecules()[i].getNumMaxLinks()-nIrreversibleBonds);
+  }
+
+  if(reactiveMonomers.empty())
+  {
+    std::stringstream errormessage;
+    errormessage<<"UpdaterReversibleConnection::initialize(): there are no reactive monomers.\n"
+                <<"Check if the system is correctly setup with reactivity!";
+    throw std::runtime_error(errormessage.str());
+  }
+}
+
+#endif /* LEMONADE_UPDATER_UPDATERREVERSIBLECONNECTION_H */
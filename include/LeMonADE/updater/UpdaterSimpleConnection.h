@@ -29,6 +29,8 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #define LEMONADE_UPDATER_UPDATERSIMPLECONNECTION_H
 
 
+#include <vector>
+
 #include <LeMonADE/updater/moves/MoveLocalBase.h>
 #include <LeMonADE/utility/RandomNumberGenerators.h>
 #include<LeMonADE/updater/AbstractUpdater.h>
@@ -44,6 +46,16 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  * @details It takes the type of move as template argument MoveType
  * and the number of mcs to be executed as argument for the constructor
  *
+ * Two connection modes are available (see setConnectionMode()):
+ * - CollisionReaction (default): a connection is attempted whenever a move of a
+ *   reactive monomer is rejected, in the direction of the rejected move.
+ * - IndexedReaction: after every sweep of moves, reaction attempts are drawn
+ *   from the index of unsaturated reactive monomers kept by FeatureConnectionSc,
+ *   one attempt per unsaturated monomer. For every attempt the partners in the
+ *   bond shell are looked up directly on the connection lattice and one of the
+ *   allowed partners is connected at random. Saturated monomers are never
+ *   drawn, so the attempts are not wasted at high conversion.
+ *
  * @tparam IngredientsType Ingredients class storing all system information( e.g. monomers, bonds, etc).
  * @tparam MoveType name of the specialized move.
  */
@@ -53,6 +65,9 @@ class UpdaterSimpleConnection:public AbstractUpdater
 {
 
 public:
+  //! How reaction partners are found, see class description
+  enum ConnectionMode {CollisionReaction, IndexedReaction};
+
   /**
    * @brief Standard Constructor initialized with ref to Ingredients and MCS per cycle
    *
@@ -60,7 +75,8 @@ public:
    * @param steps MCS per cycle to performed by execute()
    */
   UpdaterSimpleConnection(IngredientsType& ing,uint32_t steps = 1 )
-  :ingredients(ing),nsteps(steps),NReactedSites(0),NReactiveSites(0){}
+  :ingredients(ing),nsteps(steps),NReactedSites(0),NReactiveSites(0)
+  ,connectionMode(CollisionReaction),NReactionAttempts(0),NReactions(0){}
 
   
  
@@ -96,6 +112,18 @@ public:
   
   //! get conversion of the reaction process
   double getConversion(){return (double(NReactedSites))/(double(NReactiveSites));};
+
+  //! Select how reaction partners are found, see class description
+  void setConnectionMode(ConnectionMode mode){connectionMode=mode;}
+
+  //! Current connection mode
+  ConnectionMode getConnectionMode() const {return connectionMode;}
+
+  //! Number of reaction attempts in IndexedReaction mode
+  uint64_t getNumReactionAttempts() const {return NReactionAttempts;}
+
+  //! Number of connections made in IndexedReaction mode
+  uint64_t getNumReactions() const {return NReactions;}
   
 protected:
   
@@ -116,12 +144,22 @@ protected:
   
   //! random number generator (seed set in main program)
   RandomNumberGenerators rng;
+
+  //! One reaction attempt per unsaturated reactive monomer
+  void reactIndexed();
   
 private:
 
   //! Number of mcs to be executed
   uint32_t nsteps;
 
+  //! How reaction partners are found
+  ConnectionMode connectionMode;
+
+  //! Statistics of the IndexedReaction mode
+  uint64_t NReactionAttempts;
+  uint64_t NReactions;
+
 };
 /**Implementation of the member functions
  * @brief 
@@ -133,6 +171,8 @@ bool UpdaterSimpleConnection<IngredientsType,MoveType,ConnectionMoveType>::execu
 // 	time_t startTimer = time(NULL); //in seconds
 // 	std::cout<<"connection mcs "<<ingredients.getMolecules().getAge() << " passed time " << ((difftime(time(NULL), startTimer)) ) <<std::endl;
 
+	uint64_t nAccepted=0;
+
 	for(int n=0;n<nsteps;n++)
 	{
 		// std::vector<uint32_t> TagedMonomers;
@@ -147,8 +187,9 @@ bool UpdaterSimpleConnection<IngredientsType,MoveType,ConnectionMoveType>::execu
 			if(move.check(ingredients)==true)
 			{
 				move.apply(ingredients);
+				nAccepted++;
 			}
-			else // move is reject due to e.g. excluded volume, bond length, Metropolis etc
+			else if(connectionMode==CollisionReaction) // move is reject due to e.g. excluded volume, bond length, Metropolis etc
 			{
 				// as we connect as face-to-face colliding algorithm
 				// use the move direction in previous check as destination direction
@@ -166,14 +207,60 @@ bool UpdaterSimpleConnection<IngredientsType,MoveType,ConnectionMoveType>::execu
 			}
 		}
 
+		if(connectionMode==IndexedReaction)
+			reactIndexed();
+
 		ingredients.modifyMolecules().setAge(ingredients.getMolecules().getAge()+1);
 	}
+	addWorkCounters(uint64_t(nsteps)*ingredients.getMolecules().size(),nAccepted,nsteps);
 // 	std::cout <<"Conversion at "<<ingredients.getMolecules().getAge() << " is " << getConversion()  << std::endl;
 // 	std::cout<<"connection mcs "<<ingredients.getMolecules().getAge() << " with " << (((1.0*nsteps)*ingredients.getMolecules().size())/(difftime(time(NULL), startTimer)) ) << " [attempted connections/s]" <<std::endl;
 // 	std::cout<<"connection mcs "<<ingredients.getMolecules().getAge() << " passed time " << ((difftime(time(NULL), startTimer)) ) << " with " << nsteps << "connection MCS "<<std::endl;
 	return false;
 };
 
+/**
+ * @details The number of attempts is the number of unsaturated reactive
+ * monomers at the beginning of the sweep. For every attempt a monomer is drawn
+ * from the index of FeatureConnectionSc and all partners in the bond shell are
+ * checked with the connection move. One of the allowed partners is chosen with
+ * equal probability and connected.
+ */
+template<class IngredientsType,class MoveType, class ConnectionMoveType>
+void UpdaterSimpleConnection<IngredientsType,MoveType,ConnectionMoveType>::reactIndexed()
+{
+	const uint32_t nAttempts=ingredients.getNumUnsaturatedReactiveMonomers();
+	const uint32_t nShell=connectionMove.getNumShellPositions();
+	std::vector<VectorInt3> allowed;
+	allowed.reserve(nShell);
+
+	for(uint32_t attempt=0;attempt<nAttempts;attempt++)
+	{
+		const uint32_t nUnsaturated=ingredients.getNumUnsaturatedReactiveMonomers();
+		if(nUnsaturated==0) break;
+		NReactionAttempts++;
+
+		uint32_t index=ingredients.getUnsaturatedReactiveMonomer(rng.r250_rand32()%nUnsaturated);
+		VectorInt3 position(ingredients.getMolecules()[index].getVector3D());
+
+		allowed.clear();
+		for(uint32_t i=0;i<nShell;i++)
+		{
+			const VectorInt3& direction=connectionMove.getShellPosition(i);
+			uint32_t partner=ingredients.getIdFromLattice(position+direction);
+			if(partner==uint32_t(-1) || partner==index) continue;
+			connectionMove.init(ingredients,index,direction);
+			if(connectionMove.check(ingredients)) allowed.push_back(direction);
+		}
+		if(allowed.empty()) continue;
+
+		connectionMove.init(ingredients,index,allowed[rng.r250_rand32()%allowed.size()]);
+		connectionMove.apply(ingredients);
+		NReactedSites+=2;
+		NReactions++;
+	}
+}
+
 template<class IngredientsType,class MoveType, class ConnectionMoveType>
 void  UpdaterSimpleConnection<IngredientsType,MoveType,ConnectionMoveType>::initialize()
 {
@@ -30,6 +30,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <LeMonADE/updater/AbstractUpdater.h>
 #include <LeMonADE/updater/moves/MoveLocalBase.h>
+#include <LeMonADE/utility/Timer.h>
 
 /**
  * @file
@@ -70,9 +71,10 @@ public:
    */
   bool execute()
   {
-	time_t startTimer = time(NULL); //in seconds
-	std::cout<<"mcs "<<ingredients.getMolecules().getAge() << " passed time " << ((difftime(time(NULL), startTimer)) ) <<std::endl;
+	Timer timer;
+	std::cout<<"mcs "<<ingredients.getMolecules().getAge() << " passed time " << timer.elapsed() <<std::endl;
 
+	uint64_t nAccepted=0;
 
     for(uint32_t n=0;n<nsteps;n++){
 
@@ -83,6 +85,7 @@ public:
 		if(move.check(ingredients)==true)
 		{
 			move.apply(ingredients);
+			nAccepted++;
 		}
 	}
 
@@ -90,8 +93,12 @@ public:
 
     ingredients.modifyMolecules().setAge(ingredients.modifyMolecules().getAge()+nsteps);
 
-    std::cout<<"mcs "<<ingredients.getMolecules().getAge() << " with " << (((1.0*nsteps)*ingredients.getMolecules().size())/(difftime(time(NULL), startTimer)) ) << " [attempted moves/s]" <<std::endl;
-    std::cout<<"mcs "<<ingredients.getMolecules().getAge() << " passed time " << ((difftime(time(NULL), startTimer)) ) << " with " << nsteps << " MCS "<<std::endl;
+    uint64_t nAttempted=uint64_t(nsteps)*ingredients.getMolecules().size();
+    addWorkCounters(nAttempted,nAccepted,nsteps);
+
+    double passedTime=timer.elapsed();
+    std::cout<<"mcs "<<ingredients.getMolecules().getAge() << " with " << (double(nAttempted)/passedTime) << " [attempted moves/s]" <<std::endl;
+    std::cout<<"mcs "<<ingredients.getMolecules().getAge() << " passed time " << passedTime << " with " << nsteps << " MCS "<<std::endl;
 
     return true;
   }
@@ -62,6 +62,11 @@ public:
   template <class IngredientsType> bool check(IngredientsType& ing);
   template< class IngredientsType> void apply(IngredientsType& ing);
 
+  //! Number of possible bond directions
+  uint32_t getNumShellPositions() const {return 6;}
+  //! Bond direction i, see shellPositions
+  const VectorInt3& getShellPosition(uint32_t i) const {return shellPositions[i];}
+
 private:
   // holds the possible move directions
   /**
@@ -0,0 +1,210 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_MOVES_MOVEDISCONNECTSC_H
+#define LEMONADE_UPDATER_MOVES_MOVEDISCONNECTSC_H
+
+#include <limits>
+#include <stdexcept>
+
+#include <LeMonADE/updater/moves/MoveDisconnectBase.h>
+
+/*****************************************************************************/
+/**
+ * @file
+ *
+ * @class MoveDisconnectSc
+ *
+ * @brief Breaks the bond between a monomer and its partner in one of the directions of MoveConnectSc
+ *
+ * @details The move is the reverse of MoveConnectSc: it is initialized with a
+ * monomer and one of the six bond vectors (+-2,0,0), (0,+-2,0), (0,0,+-2). If the
+ * monomer is bonded to a partner with exactly this bond vector, the move breaks
+ * this bond, otherwise the partner is uint32_t(-1) and check() returns false.
+ * Since the bonds are created by MoveConnectSc with the same bond vectors,
+ * choosing monomer and direction with the same probabilities for both moves
+ * gives symmetric proposal probabilities, see UpdaterReversibleConnection.
+ *
+ * The class is a specialization of MoveDisconnectBase using the (CRTP) to avoid virtual functions.
+ **/
+/*****************************************************************************/
+
+class MoveDisconnectSc:public MoveDisconnectBase<MoveDisconnectSc>
+{
+public:
+  MoveDisconnectSc(){
+    shellPositions[0]=VectorInt3( 2, 0, 0);
+    shellPositions[1]=VectorInt3(-2, 0, 0);
+    shellPositions[2]=VectorInt3( 0, 2, 0);
+    shellPositions[3]=VectorInt3( 0,-2, 0);
+    shellPositions[4]=VectorInt3( 0, 0, 2);
+    shellPositions[5]=VectorInt3( 0, 0,-2);
+  }
+
+  // overload initialise function to be able to set the moves index and direction if neccessary
+  template <class IngredientsType> void init(const IngredientsType& ing);
+  template <class IngredientsType> void init(const IngredientsType& ing, uint32_t index);
+  template <class IngredientsType> void init(const IngredientsType& ing, uint32_t index, VectorInt3 dir );
+
+  template <class IngredientsType> bool check(IngredientsType& ing);
+  template< class IngredientsType> void apply(IngredientsType& ing);
+
+  //! Number of possible bond directions
+  uint32_t getNumShellPositions() const {return 6;}
+  //! Bond direction i, see shellPositions
+  const VectorInt3& getShellPosition(uint32_t i) const {return shellPositions[i];}
+
+private:
+  //! finds the partner of the monomer with the bond vector of the move
+  template <class IngredientsType> void findPartner(const IngredientsType& ing);
+
+  /**
+   * @brief Array that holds the 6 possible bond vectors, the same as for MoveConnectSc
+   */
+  VectorInt3 shellPositions[6];
+};
+
+/////////////////////////////////////////////////////////////////////////////
+/////////// implementation of the members ///////////////////////////////////
+
+/*****************************************************************************/
+/**
+ * @brief Initialize the move with a random monomer and direction.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ **/
+template <class IngredientsType>
+void MoveDisconnectSc::init(const IngredientsType& ing)
+{
+  this->resetProbability();
+  this->setIndex( (this->randomNumbers.r250_rand32()) %(ing.getMolecules().size()) );
+  this->setDir(shellPositions[ this->randomNumbers.r250_rand32() % 6]);
+  findPartner(ing);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Initialize the move with a given monomer index and a random direction.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @param index index of the monomer whose bond is broken
+ **/
+template <class IngredientsType>
+void MoveDisconnectSc::init(const IngredientsType& ing, uint32_t index)
+{
+  this->resetProbability();
+
+  if( index < ing.getMolecules().size() )
+    this->setIndex( index );
+  else
+    throw std::runtime_error("MoveDisconnectSc::init(ing, index): index out of range!");
+
+  this->setDir(shellPositions[ this->randomNumbers.r250_rand32() % 6]);
+  findPartner(ing);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Initialize the move with a given monomer index and bond vector.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @param index index of the monomer whose bond is broken
+ * @param dir bond vector to the partner, one of the shellPositions
+ **/
+template <class IngredientsType>
+void MoveDisconnectSc::init(const IngredientsType& ing, uint32_t index, VectorInt3 dir )
+{
+  this->resetProbability();
+
+  if( index < ing.getMolecules().size() )
+    this->setIndex( index );
+  else
+    throw std::runtime_error("MoveDisconnectSc::init(ing, index, dir): index out of range!");
+
+  bool valid=false;
+  for(uint32_t i=0;i<6;i++) valid=valid || (dir==shellPositions[i]);
+  if(!valid)
+    throw std::runtime_error("MoveDisconnectSc::init(ing, index, dir): direction vector out of range!");
+  this->setDir(dir);
+  findPartner(ing);
+}
+
+/**
+ * @details Only the bonds of the monomer are searched, i.e. the time does not
+ * depend on the system size.
+ */
+template <class IngredientsType>
+void MoveDisconnectSc::findPartner(const IngredientsType& ing)
+{
+  const typename IngredientsType::molecules_type& molecules=ing.getMolecules();
+  const uint32_t index=this->getIndex();
+  this->setPartner(std::numeric_limits<uint32_t>::max());
+  for(uint32_t k=0;k<molecules.getNumLinks(index);k++)
+  {
+    uint32_t neighbor=molecules.getNeighborIdx(index,k);
+    if(molecules[neighbor]-molecules[index]==this->getDir())
+    {
+      this->setPartner(neighbor);
+      return;
+    }
+  }
+}
+
+/*****************************************************************************/
+/**
+ * @brief Check if the move is accepted by the system.
+ *
+ * @details This function delegates the checking to the Feature.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @return True if move is valid. False, otherwise.
+ **/
+template <class IngredientsType>
+bool MoveDisconnectSc::check(IngredientsType& ing)
+{
+  if (std::numeric_limits<uint32_t>::max() == this->getPartner() ) return false ;
+  //send the move to the Features to be checked
+  return ing.checkMove(ing,*this);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Apply the move to the system.
+ *
+ * @details As for MoveConnectSc, the bond is removed first and then the
+ * features apply the move, i.e. they see the system without the bond.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ **/
+template< class IngredientsType>
+void MoveDisconnectSc::apply(IngredientsType& ing)
+{
+  ing.modifyMolecules().disconnect(this->getIndex(),this->getPartner());
+  ing.applyMove(ing,*this);
+}
+
+#endif /* LEMONADE_UPDATER_MOVES_MOVEDISCONNECTSC_H */
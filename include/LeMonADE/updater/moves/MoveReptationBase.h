@@ -0,0 +1,173 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_MOVES_MOVEREPTATIONBASE_H
+#define LEMONADE_UPDATER_MOVES_MOVEREPTATIONBASE_H
+
+#include <LeMonADE/updater/moves/MoveBase.h>
+#include <LeMonADE/utility/Vector3D.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+
+/*****************************************************************************/
+/**
+ * @file
+ *
+ * @class MoveReptationBase
+ *
+ * @brief Base class for reptation (slithering snake) moves. The specialized version is MoveReptationSc.
+ *
+ * @details A reptation move removes the end monomer of a linear chain from its
+ * bonded neighbor and attaches it to the other end of the chain. The monomer
+ * keeps its index, i.e. the move changes the position of one monomer and
+ * replaces one bond. The implementation details are given by the template
+ * parameter.
+ * This way, using the "Curiously Recurring Template Pattern (CRTP) to avoid virtual functions
+ * but still providing their functionality. A specialized
+ * move type derived from this class must then be constructed in the following
+ * way: "class MySpecialMove:public MoveReptationBase<MySpecialMove>".
+ * It must implement the functions init,check and apply. Calls to the corresponding
+ * functions in this base class are then redirected to the specialized implementation.
+ * See for an example the class MoveReptationSc.
+ * Since this class simply serves as a common base, the functions apply(), check(), and init() don't do
+ * anything particular.
+ *
+ * @tparam <SpecializedMove> name of the specialized move.
+ *
+ **/
+/*****************************************************************************/
+template <class SpecializedMove>
+class MoveReptationBase:public MoveBase
+{
+ public:
+	//! Returns the index of the end monomer which is moved
+	uint32_t getIndex() const {return index;}
+
+	//! Returns the index of the monomer the moved monomer is bonded to before the move
+	uint32_t getOldNeighbor() const {return oldNeighbor;}
+
+	//! Returns the index of the other chain end, to which the moved monomer is bonded after the move
+	uint32_t getNewNeighbor() const {return newNeighbor;}
+
+	//! Returns the bond vector from the new neighbor to the moved monomer
+	const VectorInt3& getBondVector() const {return bondVector;}
+
+	//! Returns the position of the moved monomer after the move
+	const VectorInt3& getPosition() const {return position;}
+
+	//here come the functions that are implemented by the specialization
+	template <class IngredientsType> void init(const IngredientsType& ingredients);
+	template <class IngredientsType> bool check(IngredientsType& ingredients);
+	template <class IngredientsType> void apply(IngredientsType& ingredients);
+
+ protected:
+	//! Set the index of the moved end monomer
+	void setIndex(uint32_t i) {index=i;}
+
+	//! Set the neighbor of the moved monomer before the move
+	void setOldNeighbor(uint32_t i) {oldNeighbor=i;}
+
+	//! Set the other chain end
+	void setNewNeighbor(uint32_t i) {newNeighbor=i;}
+
+	//! Set the new bond vector and the position of the moved monomer after the move
+	void setBond(const VectorInt3& bond, const VectorInt3& newPosition) {bondVector=bond;position=newPosition;}
+
+	//! Random Number Generator (RNG)
+	RandomNumberGenerators randomNumbers;
+
+ private:
+	//! Index of the moved end monomer
+	uint32_t index;
+
+	//! Index of the bonded neighbor of the moved monomer before the move
+	uint32_t oldNeighbor;
+
+	//! Index of the other chain end
+	uint32_t newNeighbor;
+
+	//! Bond vector from the other chain end to the moved monomer
+	VectorInt3 bondVector;
+
+	//! Position of the moved monomer after the move
+	VectorInt3 position;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// implementation of the members
+////////////////////////////////////////////////////////////////////////////////
+/*****************************************************************************/
+/**
+ * @brief Initialize the move. Done by the SpecializedMove.
+ *
+ * @details Here, this is only redirected to the implementation
+ * given in the template parameter
+ *
+ * @tparam <SpecializedMove> name of the specialized move.
+ **/
+/*****************************************************************************/
+template <class SpecializedMove>
+template <class IngredientsType>
+void MoveReptationBase<SpecializedMove>::init(const IngredientsType& ingredients)
+{
+  static_cast<SpecializedMove*>(this)->init(ingredients);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Check if the move is accepted by the system. Done by the SpecializedMove.
+ *
+ * @details Here, this is only redirected to the implementation
+ * given in the template parameter.
+ *
+ * @tparam <SpecializedMove> name of the specialized move.
+ **/
+/*****************************************************************************/
+template <class SpecializedMove>
+template <class IngredientsType>
+bool MoveReptationBase<SpecializedMove>::check(IngredientsType& ingredients)
+{
+  return static_cast<SpecializedMove*>(this)->check(ingredients);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Apply the move to the system.
+ *
+ * @details Here, this is only redirected to the implementation
+ * given in the template parameter
+ *
+ * @tparam <SpecializedMove> name of the specialized move.
+ * */
+/*****************************************************************************/
+template <class SpecializedMove>
+template <class IngredientsType>
+void MoveReptationBase<SpecializedMove>::apply(IngredientsType& ingredients)
+{
+  static_cast<SpecializedMove*>(this)->apply(ingredients);
+}
+
+#endif /* LEMONADE_UPDATER_MOVES_MOVEREPTATIONBASE_H */
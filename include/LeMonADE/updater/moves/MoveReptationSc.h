@@ -0,0 +1,426 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UPDATER_MOVES_MOVEREPTATIONSC_H
+#define LEMONADE_UPDATER_MOVES_MOVEREPTATIONSC_H
+
+#include <map>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+
+#include <LeMonADE/updater/moves/MoveReptationBase.h>
+
+/*****************************************************************************/
+/**
+ * @file
+ *
+ * @class MoveReptationSc
+ *
+ * @brief Reptation (slithering snake) move for linear chains in the scBFM.
+ *
+ * @details The move takes one end monomer of a linear chain, removes its bond
+ * to the next monomer along the chain and attaches it to the other chain end
+ * with a bond vector chosen from the bondset. Chain, end and bond vector are
+ * drawn with uniform probability, which makes the proposal symmetric. The move
+ * does not describe a physical dynamics and is meant for the equilibration of
+ * melts only, see UpdaterReptationEquilibration.
+ *
+ * The moved monomer keeps its index. Instead of shifting the coordinates of all
+ * monomers along the chain, every chain is stored as a ring buffer: a chain
+ * occupies the index range [first,first+length) and the member head is the
+ * offset of the index of the first monomer along the chain contour. A move only
+ * changes one position, one bond and the head of the chain. The function
+ * linearize() restores the usual order, where monomer first+i is the i-th
+ * monomer along the chain, by rotating the monomer data within every chain.
+ * As the attributes travel with the monomers, the sequence of a heteropolymer
+ * is rotated by the moves and the reptation move is thus only meaningful for
+ * homopolymers (or for sequences, which are invariant under the rotation).
+ *
+ * The chains are detected on the first call to init() or when the number of
+ * monomers has changed. Only linear chains, whose monomers have consecutive
+ * indices and are bonded in this order, are considered. All other molecules
+ * are never moved. If the connectivity of the system is changed by other means,
+ * linearize() has to be called before and resetChains() afterwards.
+ *
+ * The features FeatureExcludedVolumeSc, FeatureBondset, FeatureNNInteractionSc,
+ * FeatureBox, FeatureFixedMonomers and FeatureWall implement the checks for this
+ * move and FeatureConnectionSc follows the changed position and bonds. The lattice
+ * value of FeatureExcludedVolumeScIdOnLattice is carried along with the monomer.
+ * FeatureExcludedVolumeBcc and FeatureSpringPotentialTwoGroups reject the move
+ * with an exception. Features not mentioned here do not depend on the positions
+ * or bonds and accept the move.
+ * As linearize() changes the indices of the monomers, it synchronizes the
+ * system, such that features storing monomer indices (e.g. FeatureConnectionSc
+ * and FeatureExcludedVolumeScIdOnLattice with the predicate MonomerID) are
+ * brought up to date.
+ *
+ * The class is a specialization of MoveReptationBase using the (CRTP) to avoid virtual functions.
+ **/
+/*****************************************************************************/
+class MoveReptationSc:public MoveReptationBase<MoveReptationSc>
+{
+public:
+  MoveReptationSc():nMonomers(0),chain(0),frontEnd(true){}
+
+  // overload initialise function to be able to set the chain, end and bond vector if neccessary
+  template <class IngredientsType> void init(const IngredientsType& ing);
+  template <class IngredientsType> void init(const IngredientsType& ing, uint32_t chainIdx, bool front, VectorInt3 bond);
+
+  template <class IngredientsType> bool check(IngredientsType& ing);
+  template< class IngredientsType> void apply(IngredientsType& ing);
+
+  //! Restore the consecutive order of the monomers along all chains
+  template <class IngredientsType> void linearize(IngredientsType& ing);
+
+  //! Detect the linear chains and bond vectors in the system
+  template <class IngredientsType> void setupChains(const IngredientsType& ing);
+
+  //! Forget the chains, such that they are detected again on the next call to init()
+  void resetChains(){chains.clear();bondVectors.clear();nMonomers=0;}
+
+  //! Returns true if the lattice site is occupied by the moved monomer before the move
+  template <class IngredientsType> bool isOldSite(const IngredientsType& ing, const VectorInt3& site) const;
+
+  //! Returns the number of chains handled by the move
+  uint32_t getNumberOfChains() const {return chains.size();}
+
+  //! Returns the index of the first monomer of the index range of chain i
+  uint32_t getChainFirst(uint32_t i) const {return chains.at(i).first;}
+
+  //! Returns the number of monomers of chain i
+  uint32_t getChainLength(uint32_t i) const {return chains.at(i).length;}
+
+  //! Returns the offset of the first monomer along the contour of chain i within its index range
+  uint32_t getChainHead(uint32_t i) const {return chains.at(i).head;}
+
+  //! Returns the index of the k-th monomer along the contour of chain i
+  uint32_t getChainMonomer(uint32_t i, uint32_t k) const
+  {
+    const ChainInfo& c=chains.at(i);
+    return c.first+(c.head+k)%c.length;
+  }
+
+private:
+  //! Index range and ring buffer offset of a linear chain
+  struct ChainInfo
+  {
+    uint32_t first;
+    uint32_t length;
+    uint32_t head;
+  };
+
+  //! Sets index, neighbors and new position for the given chain, end and bond vector
+  template <class IngredientsType> void setMove(const IngredientsType& ing, uint32_t chainIdx, bool front, const VectorInt3& bond);
+
+  //! Linear chains in the system
+  std::vector<ChainInfo> chains;
+
+  //! Bond vectors the moved monomer can be attached with
+  std::vector<VectorInt3> bondVectors;
+
+  //! Number of monomers at the time the chains were detected
+  size_t nMonomers;
+
+  //! Chain of the current move
+  uint32_t chain;
+
+  //! True if the first monomer along the contour is moved, false for the last one
+  bool frontEnd;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+/////////// implementation of the members ///////////////////////////////////
+
+/*****************************************************************************/
+/**
+ * @brief Detect the linear chains and store the bond vectors of the bondset.
+ *
+ * @details Searches the system for linear chains of at least two monomers,
+ * whose monomers have consecutive indices and are bonded in this order.
+ * The ring buffer offsets of all chains are set to zero, i.e. the
+ * system must be in linear order, see linearize().
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ **/
+template <class IngredientsType>
+void MoveReptationSc::setupChains(const IngredientsType& ing)
+{
+  const typename IngredientsType::molecules_type& molecules=ing.getMolecules();
+
+  chains.clear();
+  bondVectors.clear();
+  nMonomers=molecules.size();
+
+  uint32_t i=0;
+  while(i<nMonomers)
+  {
+    //a chain starts with an end monomer bonded to the next index
+    if(molecules.getNumLinks(i)!=1 || i+1>=nMonomers || molecules.getNeighborIdx(i,0)!=i+1)
+    {
+      ++i;
+      continue;
+    }
+
+    uint32_t j=i+1;
+    while(molecules.getNumLinks(j)==2 && j+1<nMonomers && molecules.areConnected(j,j+1))
+      ++j;
+
+    if(molecules.getNumLinks(j)==1)
+    {
+      ChainInfo c;
+      c.first=i;
+      c.length=j-i+1;
+      c.head=0;
+      chains.push_back(c);
+    }
+    i=j+1;
+  }
+
+  std::map<int32_t,VectorInt3>::const_iterator bondVec;
+  for(bondVec=ing.getBondset().begin();bondVec!=ing.getBondset().end();++bondVec)
+    bondVectors.push_back(bondVec->second);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Set the properties of the move.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @param chainIdx index of the chain
+ * @param front true if the first monomer along the contour is moved to the end
+ * @param bond bond vector from the other chain end to the moved monomer
+ **/
+template <class IngredientsType>
+void MoveReptationSc::setMove(const IngredientsType& ing, uint32_t chainIdx, bool front, const VectorInt3& bond)
+{
+  const ChainInfo& c=chains[chainIdx];
+  chain=chainIdx;
+  frontEnd=front;
+
+  if(front)
+  {
+    this->setIndex(c.first+c.head);
+    this->setOldNeighbor(c.first+(c.head+1)%c.length);
+    this->setNewNeighbor(c.first+(c.head+c.length-1)%c.length);
+  }
+  else
+  {
+    this->setIndex(c.first+(c.head+c.length-1)%c.length);
+    this->setOldNeighbor(c.first+(c.head+c.length-2)%c.length);
+    this->setNewNeighbor(c.first+c.head);
+  }
+
+  VectorInt3 newPosition=ing.getMolecules()[this->getNewNeighbor()];
+  newPosition+=bond;
+  this->setBond(bond,newPosition);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Initialize the move.
+ *
+ * @details Resets the move probability to unity. Dice a chain, one of its ends
+ * and a bond vector from the bondset. If no chains are known or the number of
+ * monomers has changed, the chains are detected first.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @throw std::runtime_error if the system contains no linear chains
+ **/
+template <class IngredientsType>
+void MoveReptationSc::init(const IngredientsType& ing)
+{
+  this->resetProbability();
+
+  if(chains.empty() || nMonomers!=ing.getMolecules().size())
+    setupChains(ing);
+
+  if(chains.empty() || bondVectors.empty())
+    throw std::runtime_error("MoveReptationSc::init(ing): no linear chains or no bond vectors in the system!");
+
+  uint32_t chainIdx=this->randomNumbers.r250_rand32()%chains.size();
+  bool front=((this->randomNumbers.r250_rand32()&1)==0);
+  uint32_t bondIdx=this->randomNumbers.r250_rand32()%bondVectors.size();
+
+  setMove(ing,chainIdx,front,bondVectors[bondIdx]);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Initialize the move with a given chain, end and bond vector.
+ *
+ * @details Resets the move probability to unity and sets the move properties.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @param chainIdx index of the chain, see getNumberOfChains()
+ * @param front true if the first monomer along the contour is moved to the end
+ * @param bond bond vector from the other chain end to the moved monomer
+ * @throw std::runtime_error if the chain index is out of range
+ **/
+template <class IngredientsType>
+void MoveReptationSc::init(const IngredientsType& ing, uint32_t chainIdx, bool front, VectorInt3 bond)
+{
+  this->resetProbability();
+
+  if(chains.empty() || nMonomers!=ing.getMolecules().size())
+    setupChains(ing);
+
+  if(chainIdx>=chains.size())
+  {
+    std::stringstream errormessage;
+    errormessage<<"MoveReptationSc::init(ing, chain, front, bond): chain index "<<chainIdx;
+    errormessage<<" out of range, number of chains is "<<chains.size()<<"\n";
+    throw std::runtime_error(errormessage.str());
+  }
+
+  setMove(ing,chainIdx,front,bond);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Returns true if the lattice site is occupied by the moved monomer before the move.
+ *
+ * @details The moved monomer jumps to the other chain end and may therefore
+ * overlap with its own old position. The features use this function to
+ * exclude these sites from the checks. The comparison is done modulo the box
+ * size, because the positions are not folded back into the box.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @param site lattice site to be checked
+ **/
+template <class IngredientsType>
+bool MoveReptationSc::isOldSite(const IngredientsType& ing, const VectorInt3& site) const
+{
+  VectorInt3 diff=site-ing.getMolecules()[this->getIndex()];
+
+  int32_t dx=((diff.getX()%ing.getBoxX())+ing.getBoxX())%ing.getBoxX();
+  int32_t dy=((diff.getY()%ing.getBoxY())+ing.getBoxY())%ing.getBoxY();
+  int32_t dz=((diff.getZ()%ing.getBoxZ())+ing.getBoxZ())%ing.getBoxZ();
+
+  return (dx<=1 && dy<=1 && dz<=1);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Check if the move is accepted by the system.
+ *
+ * @details This function delegates the checking to the Feature.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ * @return True if move is valid. False, otherwise.
+ **/
+template <class IngredientsType>
+bool MoveReptationSc::check(IngredientsType& ing)
+{
+  //send the move to the Features to be checked
+  return ing.checkMove(ing,*this);
+}
+
+/*****************************************************************************/
+/**
+ * @brief Apply the move to the system.
+ *
+ * @details The features apply the move first, because they need the old
+ * position of the monomer. Then the monomer is moved, the bond to the old
+ * neighbor is replaced by the bond to the other chain end and the ring buffer
+ * offset of the chain is advanced.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ **/
+template <class IngredientsType>
+void MoveReptationSc::apply(IngredientsType& ing)
+{
+  //move must FIRST be applied to the features
+  ing.applyMove(ing,*this);
+
+  typename IngredientsType::molecules_type& molecules=ing.modifyMolecules();
+  uint32_t index=this->getIndex();
+
+  typename IngredientsType::molecules_type::edge_type bondInfo=molecules.getLinkInfo(index,this->getOldNeighbor());
+  molecules.disconnect(index,this->getOldNeighbor());
+  const VectorInt3& position=this->getPosition();
+  molecules[index].setAllCoordinates(position.getX(),position.getY(),position.getZ());
+  molecules.connect(this->getNewNeighbor(),index,bondInfo);
+
+  ChainInfo& c=chains[chain];
+  if(frontEnd)
+    c.head=(c.head+1)%c.length;
+  else
+    c.head=(c.head+c.length-1)%c.length;
+}
+
+/*****************************************************************************/
+/**
+ * @brief Restore the consecutive order of the monomers along all chains.
+ *
+ * @details For every chain with a non-zero ring buffer offset the monomer data
+ * (position and attributes) is rotated within the index range of the chain,
+ * such that monomer first+i is again the i-th monomer along the contour.
+ * The bonds are changed accordingly. The lattice occupation is not affected,
+ * but values stored for a monomer index belong to another monomer afterwards.
+ * Therefore the system is synchronized, if any chain was rotated.
+ *
+ * @param ing A reference to the IngredientsType - mainly the system
+ **/
+template <class IngredientsType>
+void MoveReptationSc::linearize(IngredientsType& ing)
+{
+  typedef typename IngredientsType::molecules_type molecules_type;
+  molecules_type& molecules=ing.modifyMolecules();
+  std::vector<typename molecules_type::vertex_type> buffer;
+  bool rotated(false);
+
+  for(size_t n=0;n<chains.size();n++)
+  {
+    ChainInfo& c=chains[n];
+    if(c.head==0) continue;
+    rotated=true;
+
+    buffer.resize(c.length);
+    for(uint32_t k=0;k<c.length;k++)
+      buffer[k]=molecules[c.first+(c.head+k)%c.length];
+    //assigning through operator[] copies the monomer data, but not the bonds
+    for(uint32_t k=0;k<c.length;k++)
+      molecules[c.first+k]=buffer[k];
+
+    //the bond between the last and the first index becomes the bond at the old head
+    if(c.length>2)
+    {
+      uint32_t last=c.first+c.length-1;
+      typename molecules_type::edge_type bondInfo=molecules.getLinkInfo(last,c.first);
+      molecules.disconnect(last,c.first);
+      molecules.connect(c.first+c.head-1,c.first+c.head,bondInfo);
+    }
+    c.head=0;
+  }
+
+  //features storing monomer indices refer to the old order
+  if(rotated)
+    ing.synchronize();
+}
+
+#endif /* LEMONADE_UPDATER_MOVES_MOVEREPTATIONSC_H */
@@ -0,0 +1,263 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UTILITY_CELLLIST_H
+#define LEMONADE_UTILITY_CELLLIST_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class CellList
+ * */
+/*****************************************************************************/
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <LeMonADE/utility/Vector3D.h>
+
+/*****************************************************************************/
+/**
+ * @class CellList
+ *
+ * @brief Linked-cell list for finding all pairs of points closer than a cutoff
+ *
+ * @details The box is divided into cells with an edge length of at least the
+ * cutoff, so all partners of a point within the cutoff are found in the cell
+ * of the point and its 26 neighbor cells. The points of a cell are stored as a
+ * linked list (first point per cell, next point per point), i.e. memory is
+ * linear in the number of points and cells, and finding all pairs takes a
+ * time proportional to the number of points for a fixed density.
+ * Periodic directions are wrapped with the minimum image convention, which
+ * requires the cutoff to be at most half the box size. In non-periodic
+ * directions points outside the box are assigned to the boundary cells.
+ * The pair loop can be restricted to a range of cells, such that several
+ * threads can process disjoint ranges.
+ **/
+/*****************************************************************************/
+class CellList
+{
+public:
+  CellList():cutoff(0.0),nPoints(0){}
+
+  //! Sets up the cells for a box and a cutoff
+  void setup(const uint32_t box[3], const bool periodic[3], double cutoff);
+
+  //! Sorts the points into the cells. The positions are copied (folded into the box).
+  template<class PositionContainer>
+  void build(const PositionContainer& positions);
+
+  //! Total number of cells
+  size_t getNumberOfCells() const {return firstPoint.size();}
+
+  //! Number of cells in direction d
+  uint32_t getNumberOfCells(size_t d) const {return nCells[d];}
+
+  //! Number of points sorted into the cells
+  size_t getNumberOfPoints() const {return nPoints;}
+
+  /**
+   * @brief Calls f(i,j,distance) for every pair of points i!=j with a distance below the cutoff
+   *
+   * @details Each pair is reported exactly once, from the cell with the
+   * smaller index (or the common cell). distance is the minimum image vector
+   * from i to j.
+   *
+   * @param cellBegin first cell whose pairs are evaluated
+   * @param cellEnd cell behind the last cell whose pairs are evaluated
+   * @param f functor with operator()(uint32_t i, uint32_t j, const VectorInt3& distance)
+   */
+  template<class PairFunction>
+  void forEachPair(size_t cellBegin, size_t cellEnd, PairFunction& f) const;
+
+  //! Calls f(i,j,distance) for all pairs within the cutoff
+  template<class PairFunction>
+  void forEachPair(PairFunction& f) const {forEachPair(0,getNumberOfCells(),f);}
+
+  //! Marker for the end of a linked list
+  enum {end=0xFFFFFFFFu};
+
+private:
+  //! cell index of a folded position
+  uint32_t cellIndex(const VectorInt3& folded) const;
+
+  uint32_t boxSize[3];
+  bool isPeriodic[3];
+  double cutoff;
+  //! cutoff squared, pairs closer than this are reported
+  int64_t cutoff2;
+  uint32_t nCells[3];
+  //! edge length of the cells
+  double cellSize[3];
+  //! first point in every cell
+  std::vector<uint32_t> firstPoint;
+  //! next point in the same cell
+  std::vector<uint32_t> nextPoint;
+  //! positions folded into the box
+  std::vector<VectorInt3> folded;
+  size_t nPoints;
+};
+
+/*****************************************************************************/
+//implementation of members
+
+/**
+ * @param box box size in x, y and z
+ * @param periodic periodicity in x, y and z
+ * @param cutoff largest distance of reported pairs (pairs with distance < cutoff are reported)
+ *
+ * @throw std::runtime_error if the cutoff is not positive or larger than half a periodic box size
+ */
+inline void CellList::setup(const uint32_t box[3], const bool periodic[3], double cutoff)
+{
+  if(!(cutoff>0.0))
+    throw std::runtime_error("CellList::setup(): the cutoff must be positive");
+
+  this->cutoff=cutoff;
+  //pairs at exactly the cutoff are not reported, integer squared distances are compared
+  cutoff2=int64_t(cutoff*cutoff);
+  if(double(cutoff2)==cutoff*cutoff) cutoff2--;
+
+  size_t total=1;
+  for(size_t d=0;d<3;d++)
+  {
+    if(box[d]==0)
+      throw std::runtime_error("CellList::setup(): box size must be positive");
+    if(periodic[d] && cutoff>0.5*double(box[d]))
+    {
+      std::stringstream errormessage;
+      errormessage<<"CellList::setup(): cutoff "<<cutoff<<" exceeds half of the periodic box size "<<box[d];
+      throw std::runtime_error(errormessage.str());
+    }
+    boxSize[d]=box[d];
+    isPeriodic[d]=periodic[d];
+    nCells[d]=std::max<uint32_t>(1,uint32_t(double(box[d])/cutoff));
+    cellSize[d]=double(box[d])/double(nCells[d]);
+    total*=nCells[d];
+  }
+  firstPoint.assign(total,uint32_t(end));
+}
+
+template<class PositionContainer>
+void CellList::build(const PositionContainer& positions)
+{
+  nPoints=positions.size();
+  std::fill(firstPoint.begin(),firstPoint.end(),uint32_t(end));
+  nextPoint.resize(nPoints);
+  folded.resize(nPoints);
+
+  for(size_t n=0;n<nPoints;n++)
+  {
+    VectorInt3 pos(positions[n]);
+    for(size_t d=0;d<3;d++)
+    {
+      int32_t b=int32_t(boxSize[d]);
+      if(isPeriodic[d]) pos[d]=((pos[d]%b)+b)%b;
+    }
+    folded[n]=pos;
+    uint32_t cell=cellIndex(pos);
+    nextPoint[n]=firstPoint[cell];
+    firstPoint[cell]=uint32_t(n);
+  }
+}
+
+inline uint32_t CellList::cellIndex(const VectorInt3& pos) const
+{
+  uint32_t c[3];
+  for(size_t d=0;d<3;d++)
+  {
+    double scaled=double(pos[d])/cellSize[d];
+    if(scaled<0.0) c[d]=0;
+    else c[d]=std::min(uint32_t(scaled),nCells[d]-1);
+  }
+  return c[0]+nCells[0]*(c[1]+nCells[1]*c[2]);
+}
+
+template<class PairFunction>
+void CellList::forEachPair(size_t cellBegin, size_t cellEnd, PairFunction& f) const
+{
+  for(size_t cell=cellBegin;cell<cellEnd;cell++)
+  {
+    if(firstPoint[cell]==end) continue;
+    int32_t c[3]={int32_t(cell%nCells[0]),int32_t((cell/nCells[0])%nCells[1]),int32_t(cell/(size_t(nCells[0])*nCells[1]))};
+
+    //neighbor cells with an index >= cell, each only once (small boxes have fewer than 27 distinct neighbors)
+    uint32_t neighbors[27];
+    size_t nNeighbors=0;
+    for(int32_t dz=-1;dz<=1;dz++)
+      for(int32_t dy=-1;dy<=1;dy++)
+	for(int32_t dx=-1;dx<=1;dx++)
+	{
+	  int32_t offset[3]={dx,dy,dz};
+	  int32_t n[3];
+	  bool valid=true;
+	  for(size_t d=0;d<3;d++)
+	  {
+	    n[d]=c[d]+offset[d];
+	    if(n[d]<0 || n[d]>=int32_t(nCells[d]))
+	    {
+	      if(!isPeriodic[d]){valid=false;break;}
+	      n[d]=(n[d]+int32_t(nCells[d]))%int32_t(nCells[d]);
+	    }
+	  }
+	  if(!valid) continue;
+	  uint32_t neighbor=uint32_t(n[0]+int32_t(nCells[0])*(n[1]+int32_t(nCells[1])*n[2]));
+	  if(neighbor<cell || firstPoint[neighbor]==end) continue;
+	  if(std::find(neighbors,neighbors+nNeighbors,neighbor)==neighbors+nNeighbors)
+	    neighbors[nNeighbors++]=neighbor;
+	}
+
+    for(uint32_t i=firstPoint[cell];i!=end;i=nextPoint[i])
+    {
+      const VectorInt3& pi=folded[i];
+      for(size_t k=0;k<nNeighbors;k++)
+      {
+	//in the own cell only the points behind i in the list
+	uint32_t j=(neighbors[k]==cell)?nextPoint[i]:firstPoint[neighbors[k]];
+	for(;j!=end;j=nextPoint[j])
+	{
+	  VectorInt3 distance(folded[j]-pi);
+	  for(size_t d=0;d<3;d++)
+	  {
+	    if(!isPeriodic[d]) continue;
+	    int32_t b=int32_t(boxSize[d]);
+	    if(2*distance[d]>b) distance[d]-=b;
+	    else if(2*distance[d]<-b) distance[d]+=b;
+	  }
+	  int64_t r2=int64_t(distance[0])*distance[0]+int64_t(distance[1])*distance[1]+int64_t(distance[2])*distance[2];
+	  if(r2<=cutoff2) f(i,j,distance);
+	}
+      }
+    }
+  }
+}
+
+#endif /* LEMONADE_UTILITY_CELLLIST_H */
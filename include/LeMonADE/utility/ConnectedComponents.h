@@ -0,0 +1,202 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UTILITY_CONNECTEDCOMPONENTS_H
+#define LEMONADE_UTILITY_CONNECTEDCOMPONENTS_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class ConnectedComponents
+ * */
+/*****************************************************************************/
+
+#include <stdint.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*****************************************************************************/
+/**
+ * @class ConnectedComponents
+ *
+ * @brief Labels the connected components (molecules) of a graph in linear time
+ *
+ * @details Every vertex gets the index of its component, and the members of
+ * all components are stored in one array with offsets (compressed sparse rows):
+ * the members of component c are getMembers()[getOffsets()[c]...getOffsets()[c+1]-1].
+ * The graph is traversed depth first with an explicit stack and a flat array
+ * of component indices as visited marker, i.e. the run time is linear in the
+ * number of vertices and bonds. The components are numbered in the order of
+ * their smallest vertex index and the members are stored in the order of the
+ * traversal, which is the same order as produced by GraphIteratorDepthFirst.
+ * Optionally a predicate excludes vertices, which then belong to no component.
+ *
+ * The graph needs the members size(), getNumLinks(i) and getNeighborIdx(i,j),
+ * e.g. Molecules, which also caches its components (see Molecules::getConnectedComponents()).
+ **/
+/*****************************************************************************/
+class ConnectedComponents
+{
+public:
+  ConnectedComponents():offsets(1,0){}
+
+  //! Labels the components of all vertices of the graph
+  template<class Graph>
+  explicit ConnectedComponents(const Graph& graph):offsets(1,0){compute(graph);}
+
+  //! Labels the components of all vertices of the graph
+  template<class Graph>
+  void compute(const Graph& graph){compute(graph,AllVertices());}
+
+  //! Labels the components of the vertices for which pred(graph,i) is true
+  template<class Graph, class Predicate>
+  void compute(const Graph& graph, const Predicate& pred);
+
+  //! Removes all components
+  void clear(){componentIds.clear();offsets.assign(1,0);members.clear();}
+
+  //! Component index of vertices excluded by the predicate
+  enum {unassigned=0xFFFFFFFFu};
+
+  //! Number of components
+  size_t getNumberOfComponents() const {return offsets.size()-1;}
+
+  //! Number of vertices of the graph
+  size_t getNumberOfVertices() const {return componentIds.size();}
+
+  //! Component index of a vertex, ConnectedComponents::unassigned if excluded
+  uint32_t getComponentId(uint32_t vertex) const {return componentIds[vertex];}
+
+  //! Component index of all vertices
+  const std::vector<uint32_t>& getComponentIds() const {return componentIds;}
+
+  //! Number of vertices in component c
+  uint32_t getComponentSize(size_t c) const {return offsets[c+1]-offsets[c];}
+
+  //! k-th member of component c
+  uint32_t getMember(size_t c, size_t k) const {return members[offsets[c]+k];}
+
+  //! Start of the members of all components, size getNumberOfComponents()+1
+  const std::vector<uint32_t>& getOffsets() const {return offsets;}
+
+  //! Members of all components, sorted by component
+  const std::vector<uint32_t>& getMembers() const {return members;}
+
+  /**
+   * @brief Appends one group per component to groups
+   * @param groups container of groups, e.g. std::vector<MonomerGroup<...> >
+   * @param groupInit every group starts as a copy of groupInit
+   */
+  template<class GroupContainer, class GroupType>
+  void fillGroups(GroupContainer& groups, const GroupType& groupInit) const
+  {
+    for(size_t c=0;c<getNumberOfComponents();c++)
+    {
+      groups.push_back(groupInit);
+      for(uint32_t k=offsets[c];k<offsets[c+1];k++) groups.back().push_back(members[k]);
+    }
+  }
+
+private:
+  //! predicate including all vertices
+  struct AllVertices
+  {
+    template<class Graph>
+    bool operator()(const Graph&, int) const {return true;}
+  };
+
+  std::vector<uint32_t> componentIds;
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> members;
+};
+
+/**
+ * @details The predicate has the same meaning as for GraphIteratorDepthFirst,
+ * it is evaluated once per vertex.
+ * @param graph the graph
+ * @param pred functor with operator()(const Graph&, int) returning true for allowed vertices
+ * @throw std::runtime_error if a bond points to a vertex outside of the graph
+ */
+template<class Graph, class Predicate>
+void ConnectedComponents::compute(const Graph& graph, const Predicate& pred)
+{
+  const uint32_t nVertices=uint32_t(graph.size());
+  Predicate predicate(pred);
+  std::vector<bool> allowed(nVertices);
+  for(uint32_t i=0;i<nVertices;i++) allowed[i]=predicate(graph,int(i));
+
+  componentIds.assign(nVertices,uint32_t(unassigned));
+  offsets.assign(1,0);
+  members.clear();
+  members.reserve(nVertices);
+
+  //vertex and index of its next neighbor to look at
+  std::vector<std::pair<uint32_t,uint32_t> > stack;
+
+  for(uint32_t start=0;start<nVertices;start++)
+  {
+    if(!allowed[start] || componentIds[start]!=uint32_t(unassigned)) continue;
+
+    const uint32_t component=uint32_t(offsets.size()-1);
+    componentIds[start]=component;
+    members.push_back(start);
+    stack.push_back(std::make_pair(start,uint32_t(0)));
+
+    while(!stack.empty())
+    {
+      std::pair<uint32_t,uint32_t>& top=stack.back();
+      if(top.second>=graph.getNumLinks(top.first))
+      {
+        stack.pop_back();
+        continue;
+      }
+
+      uint32_t neighbor=graph.getNeighborIdx(top.first,top.second);
+      ++top.second;
+      if(neighbor>=nVertices)
+      {
+        std::stringstream errormessage;
+        errormessage<<"ConnectedComponents::compute(): vertex "<<top.first<<" is connected to "<<neighbor
+                    <<", but the graph has only "<<nVertices<<" vertices";
+        throw std::runtime_error(errormessage.str());
+      }
+      if(allowed[neighbor] && componentIds[neighbor]==uint32_t(unassigned))
+      {
+        componentIds[neighbor]=component;
+        members.push_back(neighbor);
+        //invalidates top
+        stack.push_back(std::make_pair(neighbor,uint32_t(0)));
+      }
+    }
+    offsets.push_back(uint32_t(members.size()));
+  }
+}
+
+#endif /* LEMONADE_UTILITY_CONNECTEDCOMPONENTS_H */
@@ -32,6 +32,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <set>
 #include <stack>
 
+#include <LeMonADE/utility/ConnectedComponents.h>
 #include <LeMonADE/utility/DepthIteratorPredicates.h>
 
 /******************************************************************************/
@@ -250,39 +251,23 @@ private:
 // };
 
 /**
- * @deprecated
+ * @brief Appends one group per connected component of the vertices allowed by pred
  *
- * @todo we should reconsider this approach for usability
- * @todo comment!!!
+ * @details The groups and the order of their members are the same as obtained by
+ * iterating with GraphIteratorDepthFirst, but the components are labelled by
+ * ConnectedComponents in linear time.
+ *
+ * @param g the graph, e.g. Molecules
+ * @param groups container of groups the components are appended to
+ * @param group_init every group starts as a copy of group_init
+ * @param pred predicate of the allowed vertices (see DepthIteratorPredicates.h)
  **/
 template < class Graph, class GroupContainer, class GroupType, class Predicate >
 void fill_connected_groups ( const Graph& g , GroupContainer& groups, const GroupType& group_init, const Predicate& pred )
 {
-
-  std::set < int > visited;
-//   deque < int > tmp_group;
-
-  bool end = false;
-  while (!end)
-  {
-
-    GraphIteratorDepthFirst< Graph, Predicate > iter( g, &visited, pred );
-
-    if ( iter.isEnd() )
-    {
-      end = true;
-      break;
-    }
-
-    groups.push_back ( group_init );
-
-    do
-    {
-      groups.back().push_back(iter.getVertexIdx());
-      ++iter;
-    }
-    while ( !iter.isEnd() );
-  };
+  ConnectedComponents components;
+  components.compute(g,pred);
+  components.fillGroups(groups,group_init);
 }
 
 /**
@@ -33,7 +33,11 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  * @brief helper functions to calculate distances using the minimum image convention
  * */
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
 
 #include "extern/loki/NullType.h"
 
@@ -198,6 +202,281 @@ double MinImageDistance (const VectorDouble3 R1, const VectorDouble3 R2, Ingredi
   return MinImageVector(R1,R2,ing).getLength();
 }
 
+
+// Batch calculations on many pairs
+
+/**
+ * @brief Coordinates of many positions as structure of arrays (SoA) without ownership
+ *
+ * @details x, y and z point to \\a size contiguous coordinates each, e.g. the
+ * arrays of a CoordinatesSoA object or a part of them.
+ */
+struct CoordinateSpan
+{
+  CoordinateSpan():x(0),y(0),z(0),size(0){}
+  CoordinateSpan(const int32_t* x, const int32_t* y, const int32_t* z, size_t size):x(x),y(y),z(z),size(size){}
+
+  const int32_t* x;
+  const int32_t* y;
+  const int32_t* z;
+  size_t size;
+};
+
+/**
+ * @brief Owns the coordinates of many positions as structure of arrays (SoA)
+ */
+struct CoordinatesSoA
+{
+  std::vector<int32_t> x;
+  std::vector<int32_t> y;
+  std::vector<int32_t> z;
+
+  size_t size() const {return x.size();}
+
+  void resize(size_t n){x.resize(n);y.resize(n);z.resize(n);}
+
+  //! copies the positions from any container of vectors, e.g. the molecules
+  template<class PositionContainer>
+  void assign(const PositionContainer& positions)
+  {
+    resize(positions.size());
+    for(size_t n=0;n<positions.size();n++)
+    {
+      x[n]=positions[n].getX();
+      y[n]=positions[n].getY();
+      z[n]=positions[n].getZ();
+    }
+  }
+
+  VectorInt3 get(size_t n) const {return VectorInt3(x[n],y[n],z[n]);}
+
+  //! coordinates n in [begin,end)
+  CoordinateSpan span(size_t begin, size_t end) const
+  {
+    if(begin>=end) return CoordinateSpan();
+    return CoordinateSpan(&x[begin],&y[begin],&z[begin],end-begin);
+  }
+
+  //! all coordinates
+  CoordinateSpan span() const {return span(0,size());}
+};
+
+/**
+ * @brief minimum image convention of a box, evaluated once for batch calculations
+ *
+ * @details The box sizes and periodicity are queried once, and for every
+ * direction the folding is chosen: a bit mask for power of two box sizes, the
+ * remainder for other periodic box sizes and the plain difference in
+ * non-periodic directions. The batch functions work on coordinate arrays and
+ * have no branches in their inner loops, such that the compiler can use SIMD
+ * instructions for them.
+ * A difference is folded into [-box/2,box/2), which agrees with
+ * MinImageDistanceComponent() for even box sizes. For odd box sizes the
+ * result is always the shortest image, i.e. in [-(box-1)/2,(box-1)/2].
+ */
+class MinImageBox
+{
+public:
+  //! non-periodic in all directions
+  MinImageBox()
+  {
+    const uint32_t box[3]={1,1,1};
+    const bool periodic[3]={false,false,false};
+    setup(box,periodic);
+  }
+
+  MinImageBox(const uint32_t box[3], const bool periodic[3]){setup(box,periodic);}
+
+  //! reads the box sizes and periodicity from the ingredients (FeatureBox)
+  template<class IngredientsType>
+  explicit MinImageBox(const IngredientsType& ing)
+  {
+    const uint32_t box[3]={uint32_t(ing.getBoxX()),uint32_t(ing.getBoxY()),uint32_t(ing.getBoxZ())};
+    const bool periodic[3]={ing.isPeriodicX(),ing.isPeriodicY(),ing.isPeriodicZ()};
+    setup(box,periodic);
+  }
+
+  uint32_t getBox(size_t d) const {return uint32_t(boxSize[d]);}
+  bool isPeriodic(size_t d) const {return mode[d]!=NonPeriodic;}
+  bool isPowerOfTwo(size_t d) const {return mode[d]==PowerOfTwo;}
+
+  //! shortest image of the difference delta=x2-x1 in direction d
+  int32_t component(size_t d, int32_t delta) const
+  {
+    switch(mode[d])
+    {
+      case PowerOfTwo: return ((delta+half[d])&mask[d])-half[d];
+      case Arbitrary: return foldShifted(delta+half[d],boxSize[d])-half[d];
+      default: return delta;
+    }
+  }
+
+  //! shortest vector from r1 to an image of r2
+  VectorInt3 vector(const VectorInt3& r1, const VectorInt3& r2) const
+  {
+    return VectorInt3(component(0,r2.getX()-r1.getX()),component(1,r2.getY()-r1.getY()),component(2,r2.getZ()-r1.getZ()));
+  }
+
+  /**
+   * @brief delta[n]=shortest image of x2[n]-x1[n] in direction d for n<count
+   * @details delta may be the same array as x1 or x2
+   */
+  void components(size_t d, const int32_t* x1, const int32_t* x2, int32_t* delta, size_t count) const
+  {
+    const int32_t h=half[d];
+    if(mode[d]==PowerOfTwo)
+    {
+      const int32_t m=mask[d];
+      for(size_t n=0;n<count;n++) delta[n]=((x2[n]-x1[n]+h)&m)-h;
+    }
+    else if(mode[d]==Arbitrary)
+    {
+      const int32_t b=boxSize[d];
+      for(size_t n=0;n<count;n++) delta[n]=foldShifted(x2[n]-x1[n]+h,b)-h;
+    }
+    else
+      for(size_t n=0;n<count;n++) delta[n]=x2[n]-x1[n];
+  }
+
+  //! delta[n]=shortest image of x2[n]-x1 in direction d for n<count
+  void components(size_t d, int32_t x1, const int32_t* x2, int32_t* delta, size_t count) const
+  {
+    const int32_t h=half[d];
+    if(mode[d]==PowerOfTwo)
+    {
+      const int32_t m=mask[d];
+      for(size_t n=0;n<count;n++) delta[n]=((x2[n]-x1+h)&m)-h;
+    }
+    else if(mode[d]==Arbitrary)
+    {
+      const int32_t b=boxSize[d];
+      for(size_t n=0;n<count;n++) delta[n]=foldShifted(x2[n]-x1+h,b)-h;
+    }
+    else
+      for(size_t n=0;n<count;n++) delta[n]=x2[n]-x1;
+  }
+
+private:
+  enum FoldingMode {NonPeriodic,PowerOfTwo,Arbitrary};
+
+  //! value folded into [0,box) without branches
+  static int32_t foldShifted(int32_t value, int32_t box)
+  {
+    int32_t r=value%box;
+    return r+((r>>31)&box);
+  }
+
+  void setup(const uint32_t box[3], const bool periodic[3])
+  {
+    for(size_t d=0;d<3;d++)
+    {
+      if(periodic[d] && box[d]==0)
+      {
+        std::stringstream errormessage;
+        errormessage<<"MinImageBox: periodic box size must be positive in direction "<<d;
+        throw std::runtime_error(errormessage.str());
+      }
+      boxSize[d]=int32_t(box[d]);
+      half[d]=int32_t(box[d]/2);
+      mask[d]=int32_t(box[d])-1;
+      if(!periodic[d]) {mode[d]=NonPeriodic;half[d]=0;}
+      else if((box[d]&(box[d]-1))==0) mode[d]=PowerOfTwo;
+      else mode[d]=Arbitrary;
+    }
+  }
+
+  FoldingMode mode[3];
+  int32_t boxSize[3];
+  int32_t half[3];
+  int32_t mask[3];
+};
+
+/**
+ * @brief shortest vectors d[n] from r1[n] to an image of r2[n] for all pairs of two spans
+ * @param box minimum image convention
+ * @param r1 first positions
+ * @param r2 second positions, same size as r1
+ * @param dx,dy,dz output arrays with r1.size entries
+ * @throw std::runtime_error if the spans differ in size
+ */
+inline void MinImageVectors(const MinImageBox& box, const CoordinateSpan& r1, const CoordinateSpan& r2, int32_t* dx, int32_t* dy, int32_t* dz)
+{
+  if(r1.size!=r2.size)
+  {
+    std::stringstream errormessage;
+    errormessage<<"MinImageVectors: spans of different size "<<r1.size<<" and "<<r2.size;
+    throw std::runtime_error(errormessage.str());
+  }
+  box.components(0,r1.x,r2.x,dx,r1.size);
+  box.components(1,r1.y,r2.y,dy,r1.size);
+  box.components(2,r1.z,r2.z,dz,r1.size);
+}
+
+/**
+ * @brief shortest vectors d[n] from r1 to an image of r2[n]
+ * @param box minimum image convention
+ * @param r1 reference position
+ * @param r2 positions
+ * @param dx,dy,dz output arrays with r2.size entries
+ */
+inline void MinImageVectors(const MinImageBox& box, const VectorInt3& r1, const CoordinateSpan& r2, int32_t* dx, int32_t* dy, int32_t* dz)
+{
+  box.components(0,r1.getX(),r2.x,dx,r2.size);
+  box.components(1,r1.getY(),r2.y,dy,r2.size);
+  box.components(2,r1.getZ(),r2.z,dz,r2.size);
+}
+
+/**
+ * @brief squared minimum image distances of all pairs (r1[n],r2[n])
+ * @details The pairs are processed in blocks, such that the components stay in
+ * the cache between folding and summation.
+ * @param box minimum image convention
+ * @param r1 first positions
+ * @param r2 second positions, same size as r1
+ * @param distance2 output array with r1.size entries
+ * @throw std::runtime_error if the spans differ in size
+ */
+inline void MinImageSquaredDistances(const MinImageBox& box, const CoordinateSpan& r1, const CoordinateSpan& r2, int64_t* distance2)
+{
+  const size_t blockSize=256;
+  int32_t dx[blockSize],dy[blockSize],dz[blockSize];
+  if(r1.size!=r2.size)
+  {
+    std::stringstream errormessage;
+    errormessage<<"MinImageSquaredDistances: spans of different size "<<r1.size<<" and "<<r2.size;
+    throw std::runtime_error(errormessage.str());
+  }
+  for(size_t begin=0;begin<r2.size;begin+=blockSize)
+  {
+    size_t count=std::min(blockSize,r2.size-begin);
+    MinImageVectors(box,CoordinateSpan(r1.x+begin,r1.y+begin,r1.z+begin,count),CoordinateSpan(r2.x+begin,r2.y+begin,r2.z+begin,count),dx,dy,dz);
+    int64_t* out=distance2+begin;
+    for(size_t n=0;n<count;n++)
+      out[n]=int64_t(dx[n])*dx[n]+int64_t(dy[n])*dy[n]+int64_t(dz[n])*dz[n];
+  }
+}
+
+/**
+ * @brief squared minimum image distances of r1 to all positions r2[n]
+ * @param box minimum image convention
+ * @param r1 reference position
+ * @param r2 positions
+ * @param distance2 output array with r2.size entries
+ */
+inline void MinImageSquaredDistances(const MinImageBox& box, const VectorInt3& r1, const CoordinateSpan& r2, int64_t* distance2)
+{
+  const size_t blockSize=256;
+  int32_t dx[blockSize],dy[blockSize],dz[blockSize];
+  for(size_t begin=0;begin<r2.size;begin+=blockSize)
+  {
+    size_t count=std::min(blockSize,r2.size-begin);
+    MinImageVectors(box,r1,CoordinateSpan(r2.x+begin,r2.y+begin,r2.z+begin,count),dx,dy,dz);
+    int64_t* out=distance2+begin;
+    for(size_t n=0;n<count;n++)
+      out[n]=int64_t(dx[n])*dx[n]+int64_t(dy[n])*dy[n]+int64_t(dz[n])*dz[n];
+  }
+}
+
 };
 
 
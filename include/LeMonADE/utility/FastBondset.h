@@ -102,6 +102,9 @@ public:
 	//! Resets/delete the look-up table of bond-vectors
 	void resetLookupTable();
 
+	//! True if the look-up table is up to date with the set of bond-vectors
+	bool isLookupSynchronized() const {return lookupSynchronized;}
+
 	//! Check if a vector is a valid bond-vector (i.e. part of the set)
 	bool isValid(const VectorInt3& bondVector) const;
 
@@ -0,0 +1,155 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UTILITY_FASTFOURIERTRANSFORM_H
+#define LEMONADE_UTILITY_FASTFOURIERTRANSFORM_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of classes FastFourierTransform and RealFourierTransform3D
+ * */
+/*****************************************************************************/
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/*****************************************************************************/
+/**
+ * @class FastFourierTransform
+ *
+ * @brief One dimensional complex discrete Fourier transform of arbitrary length
+ *
+ * @details Calculates X_k = sum_j x_j exp(-2 pi i j k / n). Lengths which are
+ * a power of two are transformed with an iterative radix-2 algorithm, all
+ * other lengths with Bluestein's algorithm, which expresses the transform as
+ * a convolution of power of two length. The twiddle factors are calculated in
+ * setup(). forward() does not modify the object, so one object can be used by
+ * several threads at the same time, as long as each thread has its own
+ * workspace.
+ **/
+/*****************************************************************************/
+class FastFourierTransform
+{
+public:
+  typedef std::complex<double> complex_type;
+
+  //! Sets up the transform of length n
+  explicit FastFourierTransform(size_t n=1);
+
+  //! Prepares the transform of length n
+  void setup(size_t n);
+
+  //! Length of the transform
+  size_t size() const {return length;}
+
+  //! Number of complex values needed as workspace by forward()
+  size_t getWorkspaceSize() const {return powerOfTwo?0:paddedLength;}
+
+  //! In place forward transform of data[0]...data[size()-1]
+  void forward(complex_type* data, complex_type* workspace) const;
+
+  //! True if n is a power of two (n>0)
+  static bool isPowerOfTwo(size_t n){return n>0 && (n&(n-1))==0;}
+
+private:
+  //! In place radix-2 transform of length paddedLength (or length, if it is a power of two)
+  void radix2(complex_type* data) const;
+
+  //! length of the transform
+  size_t length;
+  //! true if radix-2 is used directly
+  bool powerOfTwo;
+  //! length of the radix-2 transform, the smallest power of two >=2*length-1 for Bluestein's algorithm
+  size_t paddedLength;
+  //! exp(-2 pi i k / paddedLength) for k<paddedLength/2
+  std::vector<complex_type> twiddles;
+  //! bit reversed index for the reordering in radix2()
+  std::vector<size_t> bitReverse;
+  //! exp(-pi i k^2 / length) for Bluestein's algorithm
+  std::vector<complex_type> chirp;
+  //! transform of the convolution kernel of Bluestein's algorithm, scaled by 1/paddedLength
+  std::vector<complex_type> kernelTransform;
+};
+
+/*****************************************************************************/
+/**
+ * @class RealFourierTransform3D
+ *
+ * @brief Three dimensional discrete Fourier transform of real data
+ *
+ * @details The input is an array of nx*ny*nz real values with x as fastest
+ * index. Because the transform of real data is hermitian, only the half with
+ * kx=0...nx/2 is calculated, i.e. the output has (nx/2+1)*ny*nz complex values
+ * with kx as fastest index. The transform is carried out as one dimensional
+ * transforms along x (real data, with a half length complex transform for even
+ * nx), then along y and z. The lines of each direction are distributed on the
+ * given number of threads.
+ **/
+/*****************************************************************************/
+class RealFourierTransform3D
+{
+public:
+  typedef FastFourierTransform::complex_type complex_type;
+
+  RealFourierTransform3D();
+
+  //! Prepares the transform of an nx*ny*nz grid using nThreads threads
+  void setup(size_t nx, size_t ny, size_t nz, unsigned int nThreads=1);
+
+  //! Size of the real grid in x
+  size_t getSizeX() const {return nx;}
+  //! Size of the grid in y
+  size_t getSizeY() const {return ny;}
+  //! Size of the grid in z
+  size_t getSizeZ() const {return nz;}
+  //! Size of the complex output in x, i.e. nx/2+1
+  size_t getComplexSizeX() const {return nx/2+1;}
+  //! Number of threads used
+  unsigned int getNumberOfThreads() const {return nThreads;}
+
+  //! Transforms in[nx*ny*nz] into out[(nx/2+1)*ny*nz]
+  void forward(const double* in, complex_type* out) const;
+
+  //! Transforms the lines [begin,end) of one direction (0:x, 1:y, 2:z). Used by the worker threads.
+  void transformLines(int direction, size_t begin, size_t end, const double* in, complex_type* out) const;
+
+private:
+  size_t nx, ny, nz;
+  unsigned int nThreads;
+  //! true if nx is even and the x-lines use the half length transform
+  bool halfLengthX;
+  //! transform along x: length nx/2 for even nx, nx otherwise
+  FastFourierTransform fftX;
+  FastFourierTransform fftY;
+  FastFourierTransform fftZ;
+  //! exp(-2 pi i k / nx) for the recombination of the half length transform
+  std::vector<complex_type> twiddlesX;
+};
+
+#endif /* LEMONADE_UTILITY_FASTFOURIERTRANSFORM_H */
@@ -0,0 +1,254 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UTILITY_FREESITEINDEX_H
+#define LEMONADE_UTILITY_FREESITEINDEX_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class FreeSiteIndex
+ * */
+/*****************************************************************************/
+
+#include <stdint.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <LeMonADE/utility/Vector3D.h>
+
+/*****************************************************************************/
+/**
+ * @class FreeSiteIndex
+ *
+ * @brief Set of lattice sites where a sc-BFM monomer can be placed
+ *
+ * @details A site is free if the 2x2x2 cube of a monomer at this site does not
+ * overlap with the cube of any other monomer, i.e. if there is no monomer
+ * within the 27 sites around it. For every site the number of monomers
+ * blocking it is counted, and the free sites are stored in an array with a
+ * reverse index per lattice site. Thus a random free site is drawn in O(1),
+ * and placing, removing or moving a monomer updates 27 sites in O(1).
+ * In non-periodic directions the cube must fit into the box, so the last
+ * layer of sites is never free.
+ * The index only knows about excluded volume. Other constraints (walls, fixed
+ * sites, etc.) have to be checked by the caller, who may remove rejected sites
+ * with remove(). Memory is nine bytes per lattice site.
+ **/
+/*****************************************************************************/
+class FreeSiteIndex
+{
+public:
+  FreeSiteIndex(){boxSize[0]=boxSize[1]=boxSize[2]=0;}
+
+  //! Sets up an empty box, where all sites are free
+  void setup(const uint32_t box[3], const bool periodic[3]);
+
+  //! Sets up the box and marks the sites blocked by monomers at the given positions
+  template<class PositionContainer>
+  void build(const uint32_t box[3], const bool periodic[3], const PositionContainer& positions);
+
+  //! Removes the sites blocked by a monomer at position pos
+  void occupy(const VectorInt3& pos);
+
+  //! Frees the sites blocked only by a monomer at position pos, which was removed or moved
+  void release(const VectorInt3& pos);
+
+  //! Updates the sites for a monomer moved from oldPos to newPos
+  void move(const VectorInt3& oldPos, const VectorInt3& newPos){release(oldPos);occupy(newPos);}
+
+  //! Removes a single site, e.g. if it was rejected by another constraint
+  void remove(const VectorInt3& pos);
+
+  //! True if a monomer can be placed at pos (folded into the box)
+  bool isFree(const VectorInt3& pos) const
+  {
+    uint32_t site;
+    return siteIndex(pos,site) && position[site]!=none;
+  }
+
+  //! Number of free sites
+  uint32_t getNumberOfFreeSites() const {return uint32_t(freeSites.size());}
+
+  //! The k-th free site, the order changes when sites are removed
+  VectorInt3 getFreeSite(uint32_t k) const
+  {
+    uint32_t site=freeSites[k];
+    return VectorInt3(int32_t(site%boxSize[0]),int32_t((site/boxSize[0])%boxSize[1]),int32_t(site/(boxSize[0]*boxSize[1])));
+  }
+
+  //! Marker for sites which are not free
+  enum {none=0xFFFFFFFFu};
+
+private:
+  //! index of the folded position, false if outside a non-periodic box
+  bool siteIndex(const VectorInt3& pos, uint32_t& site) const;
+
+  //! true if the cube of a monomer at the site fits into the box
+  bool isAdmissible(uint32_t site) const;
+
+  //! removes a site by swapping in the last free site
+  void removeSite(uint32_t site);
+
+  //! appends a site to the free sites
+  void addSite(uint32_t site);
+
+  uint32_t boxSize[3];
+  bool isPeriodic[3];
+  //! all free sites in arbitrary order
+  std::vector<uint32_t> freeSites;
+  //! position of every site in freeSites, none if the site is not free
+  std::vector<uint32_t> position;
+  //! number of monomers blocking every site
+  std::vector<uint8_t> blocking;
+};
+
+/*****************************************************************************/
+//implementation of members
+
+/**
+ * @param box box size in x, y and z
+ * @param periodic periodicity in x, y and z
+ *
+ * @throw std::runtime_error if a box size is zero or the box has more than 2^32-1 sites
+ */
+inline void FreeSiteIndex::setup(const uint32_t box[3], const bool periodic[3])
+{
+  uint64_t total=1;
+  for(size_t d=0;d<3;d++)
+  {
+    if(box[d]==0)
+      throw std::runtime_error("FreeSiteIndex::setup(): box size must be positive");
+    boxSize[d]=box[d];
+    isPeriodic[d]=periodic[d];
+    total*=box[d];
+  }
+  if(total>=uint64_t(none))
+  {
+    std::stringstream errormessage;
+    errormessage<<"FreeSiteIndex::setup(): box "<<box[0]<<"x"<<box[1]<<"x"<<box[2]<<" has too many sites";
+    throw std::runtime_error(errormessage.str());
+  }
+
+  position.assign(total,uint32_t(none));
+  blocking.assign(total,0);
+  freeSites.clear();
+  freeSites.reserve(total);
+  for(uint32_t site=0;site<uint32_t(total);site++)
+    if(isAdmissible(site)) addSite(site);
+}
+
+template<class PositionContainer>
+void FreeSiteIndex::build(const uint32_t box[3], const bool periodic[3], const PositionContainer& positions)
+{
+  setup(box,periodic);
+  for(size_t n=0;n<positions.size();n++)
+    occupy(positions[n]);
+}
+
+inline void FreeSiteIndex::occupy(const VectorInt3& pos)
+{
+  for(int32_t dz=-1;dz<=1;dz++)
+    for(int32_t dy=-1;dy<=1;dy++)
+      for(int32_t dx=-1;dx<=1;dx++)
+      {
+	uint32_t site;
+	if(siteIndex(VectorInt3(pos.getX()+dx,pos.getY()+dy,pos.getZ()+dz),site))
+	{
+	  blocking[site]++;
+	  removeSite(site);
+	}
+      }
+}
+
+/**
+ * @details A site removed with remove() becomes free again, if the last
+ * monomer blocking it is released.
+ */
+inline void FreeSiteIndex::release(const VectorInt3& pos)
+{
+  for(int32_t dz=-1;dz<=1;dz++)
+    for(int32_t dy=-1;dy<=1;dy++)
+      for(int32_t dx=-1;dx<=1;dx++)
+      {
+	uint32_t site;
+	if(siteIndex(VectorInt3(pos.getX()+dx,pos.getY()+dy,pos.getZ()+dz),site) && blocking[site]>0)
+	{
+	  if(--blocking[site]==0 && isAdmissible(site)) addSite(site);
+	}
+      }
+}
+
+inline void FreeSiteIndex::remove(const VectorInt3& pos)
+{
+  uint32_t site;
+  if(siteIndex(pos,site)) removeSite(site);
+}
+
+inline bool FreeSiteIndex::siteIndex(const VectorInt3& pos, uint32_t& site) const
+{
+  uint32_t folded[3];
+  for(size_t d=0;d<3;d++)
+  {
+    int32_t b=int32_t(boxSize[d]);
+    int32_t x=pos[d];
+    if(isPeriodic[d]) x=((x%b)+b)%b;
+    else if(x<0 || x>=b) return false;
+    folded[d]=uint32_t(x);
+  }
+  site=folded[0]+boxSize[0]*(folded[1]+boxSize[1]*folded[2]);
+  return true;
+}
+
+inline bool FreeSiteIndex::isAdmissible(uint32_t site) const
+{
+  return (isPeriodic[0] || site%boxSize[0]+1<boxSize[0]) &&
+         (isPeriodic[1] || (site/boxSize[0])%boxSize[1]+1<boxSize[1]) &&
+         (isPeriodic[2] || site/(boxSize[0]*boxSize[1])+1<boxSize[2]);
+}
+
+inline void FreeSiteIndex::addSite(uint32_t site)
+{
+  if(position[site]!=none) return;
+  position[site]=uint32_t(freeSites.size());
+  freeSites.push_back(site);
+}
+
+inline void FreeSiteIndex::removeSite(uint32_t site)
+{
+  uint32_t k=position[site];
+  if(k==none) return;
+  uint32_t last=freeSites.back();
+  freeSites[k]=last;
+  position[last]=k;
+  freeSites.pop_back();
+  position[site]=uint32_t(none);
+}
+
+#endif /* LEMONADE_UTILITY_FREESITEINDEX_H */
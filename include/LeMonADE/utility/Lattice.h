@@ -79,6 +79,11 @@ public:
 	//! Set the value on a lattice point
 	void setLatticeEntry(const int x, const int y, const int z, LatticeType val);
 
+	//! Store the lattice geometry and all entries as raw block in a binary checkpoint
+	template<class CheckpointWriter> void saveCheckpoint(CheckpointWriter& checkpoint) const;
+
+	//! Restore the lattice from a binary checkpoint, reallocating memory if necessary
+	template<class CheckpointReader> void loadCheckpoint(CheckpointReader& checkpoint);
 
 
 private:
@@ -402,4 +407,43 @@ inline uint32_t Lattice<LatticeType>::foldBackZ(int value) const{
 
 
 
+/**
+ * @param checkpoint Writer of the checkpoint file
+ */
+template<class LatticeType>
+template<class CheckpointWriter>
+void Lattice<LatticeType>::saveCheckpoint(CheckpointWriter& checkpoint) const
+{
+	checkpoint.beginSection("Lattice");
+	checkpoint.write(_boxX); checkpoint.write(_boxY); checkpoint.write(_boxZ);
+	checkpoint.write(boxXm1); checkpoint.write(boxYm1); checkpoint.write(boxZm1);
+	checkpoint.write(xPro); checkpoint.write(proXY);
+
+	uint64_t latticeSize=(lattice!=NULL)?uint64_t(_boxX)*_boxY*_boxZ:0;
+	checkpoint.writeArray(lattice,latticeSize);
+}
+
+/**
+ * @param checkpoint Reader of the checkpoint file
+ */
+template<class LatticeType>
+template<class CheckpointReader>
+void Lattice<LatticeType>::loadCheckpoint(CheckpointReader& checkpoint)
+{
+	checkpoint.beginSection("Lattice");
+	uint32_t oldSize=(lattice!=NULL)?_boxX*_boxY*_boxZ:0;
+	checkpoint.read(_boxX); checkpoint.read(_boxY); checkpoint.read(_boxZ);
+	checkpoint.read(boxXm1); checkpoint.read(boxYm1); checkpoint.read(boxZm1);
+	checkpoint.read(xPro); checkpoint.read(proXY);
+
+	uint64_t latticeSize;
+	checkpoint.read(latticeSize);
+	if(latticeSize!=oldSize)
+	{
+		deleteLattice();
+		if(latticeSize>0) lattice = new LatticeType[latticeSize];
+	}
+	if(latticeSize>0) checkpoint.readBlock(lattice,latticeSize);
+}
+
 #endif /* LEMONADE_UTILITY_LATTICE_H */
\ No newline at end of file
@@ -0,0 +1,232 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UTILITY_MULTITAUCORRELATOR_H
+#define LEMONADE_UTILITY_MULTITAUCORRELATOR_H
+
+#include <stdint.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class MultiTauCorrelator
+ * */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * @class MultiTauCorrelator
+ *
+ * @brief Streaming time correlation of frames on logarithmically spaced lags
+ *
+ * @tparam FrameType Data of one sample, e.g. positions of all monomers. Must be copy assignable.
+ * @tparam PairFunction Functor with void operator()(const FrameType& earlier,
+ * const FrameType& later, std::vector<double>& result), which writes the
+ * observables of the frame pair (e.g. squared displacements) into result.
+ *
+ * @details The frames are passed one after another to add(). The correlator
+ * consists of levels with \a pointsPerLevel frames each. Level 0 keeps the last
+ * frames and evaluates the lags 1...pointsPerLevel-1. Every \a blockingFactor-th
+ * frame of level l is passed on to level l+1, such that level l covers the lags
+ * j*blockingFactor^l with pointsPerLevel/blockingFactor<=j<pointsPerLevel.
+ * The frames are subsampled instead of averaged, so observables which are
+ * not linear in the frame (like the mean square displacement) are evaluated
+ * exactly, only with fewer pairs at large lags.
+ * Memory and work per frame are independent of the length of the time series,
+ * the number of levels grows with its logarithm. The observables are averaged
+ * over all evaluated pairs of the same lag.
+ **/
+/*****************************************************************************/
+template<class FrameType, class PairFunction>
+class MultiTauCorrelator
+{
+public:
+  //! Sets up an empty correlator
+  MultiTauCorrelator(uint32_t pointsPerLevel=16, uint32_t blockingFactor=2, uint32_t maxLevels=32,
+		     const PairFunction& pairFunction=PairFunction());
+
+  //! Adds the next frame of the time series and evaluates all lags ending at it
+  void add(const FrameType& frame){addToLevel(0,frame);}
+
+  //! Removes all frames and results, the parameters are kept
+  void clear();
+
+  //! Returns the lags (in units of frames) and the averaged observables for all lags evaluated so far
+  void getResults(std::vector<uint64_t>& lags, std::vector<std::vector<double> >& averages, std::vector<uint64_t>& counts) const;
+
+  //! Number of frames passed to add()
+  uint64_t getNumberOfFrames() const {return levels.empty()?0:levels[0].nFrames;}
+
+  //! Number of levels used so far
+  size_t getNumberOfLevels() const {return levels.size();}
+
+  //! Number of frames kept per level
+  uint32_t getPointsPerLevel() const {return pointsPerLevel;}
+
+  //! Factor between the lag resolution of consecutive levels
+  uint32_t getBlockingFactor() const {return blockingFactor;}
+
+  //! Access to the pair function, e.g. for changing its parameters
+  PairFunction& getPairFunction(){return pairFunction;}
+
+private:
+  //! Frames of one level and the accumulated observables per lag
+  struct Level
+  {
+    //! ring buffer of the last pointsPerLevel frames
+    std::vector<FrameType> frames;
+    //! position of the next frame in the ring buffer
+    uint32_t next;
+    //! frames added to this level
+    uint64_t nFrames;
+    //! sum of the observables per lag index
+    std::vector<std::vector<double> > sums;
+    //! number of pairs per lag index
+    std::vector<uint64_t> counts;
+  };
+
+  void addToLevel(size_t level, const FrameType& frame);
+
+  uint32_t pointsPerLevel;
+  uint32_t blockingFactor;
+  uint32_t maxLevels;
+  PairFunction pairFunction;
+  std::vector<Level> levels;
+  //! temporary storage for the observables of one pair
+  std::vector<double> pairResult;
+};
+
+/*****************************************************************************/
+//implementation of members
+
+/**
+ * @param pointsPerLevel frames kept per level, must be a multiple of blockingFactor
+ * @param blockingFactor every blockingFactor-th frame is passed to the next level (at least 2)
+ * @param maxLevels frames are no longer correlated beyond this level, which limits memory and the largest lag
+ * @param pairFunction functor calculating the observables of a pair of frames
+ *
+ * @throw std::runtime_error if the parameters are inconsistent
+ */
+template<class FrameType, class PairFunction>
+MultiTauCorrelator<FrameType,PairFunction>::MultiTauCorrelator(uint32_t pointsPerLevel, uint32_t blockingFactor, uint32_t maxLevels, const PairFunction& pairFunction)
+:pointsPerLevel(pointsPerLevel)
+,blockingFactor(blockingFactor)
+,maxLevels(maxLevels)
+,pairFunction(pairFunction)
+{
+  if(blockingFactor<2 || pointsPerLevel<blockingFactor || pointsPerLevel%blockingFactor!=0 || maxLevels==0)
+  {
+    std::stringstream errormessage;
+    errormessage<<"MultiTauCorrelator: invalid parameters pointsPerLevel="<<pointsPerLevel
+		<<" blockingFactor="<<blockingFactor<<" maxLevels="<<maxLevels
+		<<". pointsPerLevel must be a multiple of blockingFactor>=2.";
+    throw std::runtime_error(errormessage.str());
+  }
+  //frames are passed on between levels by reference, so the levels must not be reallocated
+  levels.reserve(maxLevels);
+}
+
+template<class FrameType, class PairFunction>
+void MultiTauCorrelator<FrameType,PairFunction>::clear()
+{
+  levels.clear();
+}
+
+/**
+ * @details Level 0 evaluates lags from 1 on, higher levels only the lags not
+ * covered with better resolution by the level below.
+ */
+template<class FrameType, class PairFunction>
+void MultiTauCorrelator<FrameType,PairFunction>::addToLevel(size_t level, const FrameType& frame)
+{
+  if(level>=maxLevels) return;
+  if(level==levels.size())
+  {
+    levels.push_back(Level());
+    levels.back().frames.resize(pointsPerLevel);
+    levels.back().next=0;
+    levels.back().nFrames=0;
+    levels.back().sums.resize(pointsPerLevel);
+    levels.back().counts.resize(pointsPerLevel,0);
+  }
+
+  Level& current=levels[level];
+  uint32_t position=current.next;
+  current.frames[position]=frame;
+  current.next=(position+1)%pointsPerLevel;
+  current.nFrames++;
+
+  uint32_t firstLag=(level==0)?1:pointsPerLevel/blockingFactor;
+  for(uint32_t lag=firstLag;lag<pointsPerLevel && lag<current.nFrames;lag++)
+  {
+    const FrameType& earlier=current.frames[(position+pointsPerLevel-lag)%pointsPerLevel];
+    pairFunction(earlier,current.frames[position],pairResult);
+
+    std::vector<double>& sum=current.sums[lag];
+    if(sum.size()<pairResult.size()) sum.resize(pairResult.size(),0.0);
+    for(size_t k=0;k<pairResult.size();k++) sum[k]+=pairResult[k];
+    current.counts[lag]++;
+  }
+
+  if((current.nFrames-1)%blockingFactor==0)
+    addToLevel(level+1,current.frames[position]);
+}
+
+/**
+ * @param[out] lags lag in units of frames, increasing
+ * @param[out] averages observables averaged over all pairs of the lag, one vector per lag
+ * @param[out] counts number of pairs evaluated per lag
+ */
+template<class FrameType, class PairFunction>
+void MultiTauCorrelator<FrameType,PairFunction>::getResults(std::vector<uint64_t>& lags, std::vector<std::vector<double> >& averages, std::vector<uint64_t>& counts) const
+{
+  lags.clear();
+  averages.clear();
+  counts.clear();
+
+  uint64_t resolution=1;
+  for(size_t level=0;level<levels.size();level++)
+  {
+    uint32_t firstLag=(level==0)?1:pointsPerLevel/blockingFactor;
+    for(uint32_t lag=firstLag;lag<pointsPerLevel;lag++)
+    {
+      uint64_t count=levels[level].counts[lag];
+      if(count==0) continue;
+      lags.push_back(lag*resolution);
+      counts.push_back(count);
+      averages.push_back(levels[level].sums[lag]);
+      for(size_t k=0;k<averages.back().size();k++) averages.back()[k]/=double(count);
+    }
+    resolution*=blockingFactor;
+  }
+}
+
+#endif /* LEMONADE_UTILITY_MULTITAUCORRELATOR_H */
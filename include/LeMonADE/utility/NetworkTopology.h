@@ -0,0 +1,437 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UTILITY_NETWORKTOPOLOGY_H
+#define LEMONADE_UTILITY_NETWORKTOPOLOGY_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class NetworkTopology
+ * */
+/*****************************************************************************/
+
+#include <stdint.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <LeMonADE/utility/ConnectedComponents.h>
+
+/*****************************************************************************/
+/**
+ * @class NetworkTopology
+ *
+ * @brief Classifies the monomers and strands of a polymer network in linear time
+ *
+ * @details The analysis proceeds in three steps:
+ * - Dangling parts are stripped iteratively: monomers with at most one bond are
+ *   removed until only the 2-core of the graph is left. Removed monomers are
+ *   DanglingMonomer, this includes all tree-like molecules (sol).
+ * - The core is contracted to a multigraph of junctions (core monomers with at
+ *   least three core bonds) connected by strands (paths of core monomers with two
+ *   core bonds). Strands starting and ending at the same junction are loops of
+ *   first order, every pair of strands connecting the same two junctions is a
+ *   loop of second order. Cycles without junction are free rings.
+ * - The elastically active network is obtained from the junction graph by
+ *   repeatedly removing first order loops, junctions with one strand and merging
+ *   the two strands of junctions with two strands. What remains are the active
+ *   junctions with at least three active strands. Monomers of the core which are
+ *   not part of an active strand are InactiveMonomer, the others ActiveMonomer.
+ *
+ * The cycle rank is the number of bonds minus the number of monomers plus the
+ * number of molecules. The cycle rank of the active network is lower by the
+ * number of first order loops removed in the last step (including loops created
+ * by merging strands) and the number of free rings.
+ *
+ * All steps use flat arrays and a union-find over the strands, i.e. the run time
+ * is linear in the number of monomers and bonds. The graph needs the members
+ * size(), getNumLinks(i) and getNeighborIdx(i,j), e.g. Molecules.
+ **/
+/*****************************************************************************/
+class NetworkTopology
+{
+public:
+  //! Classification of the monomers
+  enum MonomerClass {DanglingMonomer=0, InactiveMonomer=1, ActiveMonomer=2};
+
+  NetworkTopology(){clear();}
+
+  //! Analyzes the graph
+  template<class Graph>
+  explicit NetworkTopology(const Graph& graph){compute(graph);}
+
+  //! Analyzes the graph
+  template<class Graph>
+  void compute(const Graph& graph);
+
+  //! Removes all results
+  void clear();
+
+  //! Number of monomers of the graph
+  uint64_t getNumberOfMonomers() const {return monomerClass.size();}
+  //! Number of bonds of the graph
+  uint64_t getNumberOfBonds() const {return nBonds;}
+  //! Number of molecules (connected components) of the graph
+  uint64_t getNumberOfMolecules() const {return nMolecules;}
+  //! Cycle rank, i.e. the number of independent cycles of the graph
+  uint64_t getCycleRank() const {return nBonds+nMolecules-monomerClass.size();}
+
+  //! Number of monomers removed with the dangling parts
+  uint64_t getNumberOfDanglingMonomers() const {return nDangling;}
+  //! Number of junctions, i.e. monomers with at least three bonds after removing the dangling parts
+  uint64_t getNumberOfJunctions() const {return nJunctions;}
+  //! Number of strands between the junctions
+  uint64_t getNumberOfStrands() const {return strandEnds.size()/2;}
+  //! Number of strands starting and ending at the same junction
+  uint64_t getNumberOfFirstOrderLoops() const {return nFirstOrderLoops;}
+  //! Number of pairs of strands connecting the same two junctions
+  uint64_t getNumberOfSecondOrderLoops() const {return nSecondOrderLoops;}
+  //! Number of cycles without junctions
+  uint64_t getNumberOfFreeRings() const {return nFreeRings;}
+
+  //! Number of junctions of the elastically active network
+  uint64_t getNumberOfActiveJunctions() const {return nActiveJunctions;}
+  //! Number of strands of the elastically active network, merged at junctions with two active strands
+  uint64_t getNumberOfActiveStrands() const {return nActiveStrands;}
+  //! Number of monomers of the elastically active network
+  uint64_t getNumberOfActiveMonomers() const {return nActive;}
+  //! Number of monomers in the core, which are not part of the elastically active network
+  uint64_t getNumberOfInactiveMonomers() const {return monomerClass.size()-nDangling-nActive;}
+  //! Cycle rank of the elastically active network, signed such that an inconsistent count cannot wrap around
+  int64_t getActiveCycleRank() const {return int64_t(getCycleRank())-int64_t(nRemovedLoops)-int64_t(nFreeRings);}
+
+  //! Classification of a monomer
+  MonomerClass getMonomerClass(uint32_t monomer) const {return MonomerClass(monomerClass[monomer]);}
+
+  //! Monomers at both ends of strand s, the strand is (getStrandEnd(s,0), ..., getStrandEnd(s,1))
+  uint32_t getStrandEnd(size_t strand, size_t end) const {return junctionMonomers[strandEnds[2*strand+end]];}
+  //! Number of monomers between the junctions of strand s
+  uint32_t getStrandLength(size_t strand) const {return strandOffsets[strand+1]-strandOffsets[strand];}
+
+private:
+  enum {none=0xFFFFFFFFu};
+
+  //! representative of the merged strands, with path halving
+  uint32_t findStrand(uint32_t strand);
+
+  //! walks along a strand from junction over first, returns the junction at the other end
+  template<class Graph>
+  uint32_t walkStrand(const Graph& graph, uint32_t junction, uint32_t first);
+
+  //! stores the monomer classes
+  std::vector<uint8_t> monomerClass;
+  //! number of bonds to monomers, which are not (yet) removed
+  std::vector<uint32_t> coreDegree;
+  //! junction index of each monomer, none for other monomers
+  std::vector<uint32_t> junctionIds;
+  //! monomer index of each junction
+  std::vector<uint32_t> junctionMonomers;
+  //! junction indices at both ends of the strands
+  std::vector<uint32_t> strandEnds;
+  //! monomers between the junctions, for strand s at strandOffsets[s]...strandOffsets[s+1]-1
+  std::vector<uint32_t> strandOffsets;
+  std::vector<uint32_t> strandMembers;
+  //! union-find of strands merged at junctions with two strands
+  std::vector<uint32_t> strandParent;
+  //! core monomers already assigned to a strand or free ring
+  std::vector<bool> visited;
+
+  uint64_t nBonds;
+  uint64_t nMolecules;
+  uint64_t nDangling;
+  uint64_t nJunctions;
+  uint64_t nFirstOrderLoops;
+  uint64_t nSecondOrderLoops;
+  uint64_t nFreeRings;
+  uint64_t nRemovedLoops;
+  uint64_t nActiveJunctions;
+  uint64_t nActiveStrands;
+  uint64_t nActive;
+};
+
+inline void NetworkTopology::clear()
+{
+  monomerClass.clear();
+  coreDegree.clear();
+  junctionIds.clear();
+  junctionMonomers.clear();
+  strandEnds.clear();
+  strandOffsets.assign(1,0);
+  strandMembers.clear();
+  strandParent.clear();
+  visited.clear();
+  nBonds=nMolecules=nDangling=nJunctions=0;
+  nFirstOrderLoops=nSecondOrderLoops=nFreeRings=nRemovedLoops=0;
+  nActiveJunctions=nActiveStrands=nActive=0;
+}
+
+inline uint32_t NetworkTopology::findStrand(uint32_t strand)
+{
+  while(strandParent[strand]!=strand)
+  {
+    strandParent[strand]=strandParent[strandParent[strand]];
+    strand=strandParent[strand];
+  }
+  return strand;
+}
+
+/**
+ * @details Appends the monomers with two core bonds to strandMembers and
+ * marks them as visited. The walk starts at first, the neighbor of the junction
+ * monomer, and never turns back to the monomer it came from.
+ */
+template<class Graph>
+uint32_t NetworkTopology::walkStrand(const Graph& graph, uint32_t junction, uint32_t first)
+{
+  uint32_t previous=junctionMonomers[junction];
+  uint32_t current=first;
+  while(junctionIds[current]==uint32_t(none))
+  {
+    visited[current]=true;
+    strandMembers.push_back(current);
+    uint32_t next=uint32_t(none);
+    for(uint32_t k=0;k<graph.getNumLinks(current);k++)
+    {
+      uint32_t neighbor=graph.getNeighborIdx(current,k);
+      if(neighbor!=previous && monomerClass[neighbor]!=DanglingMonomer) next=neighbor;
+    }
+    previous=current;
+    current=next;
+  }
+  return junctionIds[current];
+}
+
+/**
+ * @param graph the network, e.g. Molecules
+ * @throw std::runtime_error if a bond points to a vertex outside of the graph
+ */
+template<class Graph>
+void NetworkTopology::compute(const Graph& graph)
+{
+  clear();
+  const uint32_t nMonomers=uint32_t(graph.size());
+
+  //molecules, this also checks the bonds
+  nMolecules=ConnectedComponents(graph).getNumberOfComponents();
+
+  //strip the dangling parts, all other monomers are inactive until the end
+  monomerClass.assign(nMonomers,uint8_t(InactiveMonomer));
+  coreDegree.resize(nMonomers);
+  std::vector<uint32_t> stack;
+  for(uint32_t n=0;n<nMonomers;n++)
+  {
+    coreDegree[n]=graph.getNumLinks(n);
+    nBonds+=coreDegree[n];
+    if(coreDegree[n]<=1) stack.push_back(n);
+  }
+  nBonds/=2;
+
+  while(!stack.empty())
+  {
+    uint32_t n=stack.back();
+    stack.pop_back();
+    monomerClass[n]=DanglingMonomer;
+    nDangling++;
+    for(uint32_t k=0;k<graph.getNumLinks(n);k++)
+    {
+      uint32_t neighbor=graph.getNeighborIdx(n,k);
+      if(monomerClass[neighbor]==DanglingMonomer) continue;
+      if(--coreDegree[neighbor]==1) stack.push_back(neighbor);
+    }
+  }
+
+  //junctions
+  junctionIds.assign(nMonomers,uint32_t(none));
+  visited.assign(nMonomers,false);
+  for(uint32_t n=0;n<nMonomers;n++)
+    if(monomerClass[n]!=DanglingMonomer && coreDegree[n]>=3)
+    {
+      junctionIds[n]=uint32_t(junctionMonomers.size());
+      junctionMonomers.push_back(n);
+    }
+  nJunctions=junctionMonomers.size();
+
+  //strands, every strand is found from both ends, but walked only once
+  for(uint32_t j=0;j<nJunctions;j++)
+  {
+    const uint32_t n=junctionMonomers[j];
+    for(uint32_t k=0;k<graph.getNumLinks(n);k++)
+    {
+      uint32_t neighbor=graph.getNeighborIdx(n,k);
+      if(monomerClass[neighbor]==DanglingMonomer || visited[neighbor]) continue;
+      if(junctionIds[neighbor]!=uint32_t(none) && junctionIds[neighbor]<j) continue;
+
+      uint32_t other=walkStrand(graph,j,neighbor);
+      strandEnds.push_back(j);
+      strandEnds.push_back(other);
+      strandOffsets.push_back(uint32_t(strandMembers.size()));
+    }
+  }
+  const uint32_t nStrands=uint32_t(strandEnds.size()/2);
+
+  //remaining core monomers are on free rings
+  for(uint32_t n=0;n<nMonomers;n++)
+  {
+    if(monomerClass[n]==DanglingMonomer || visited[n] || junctionIds[n]!=uint32_t(none)) continue;
+    nFreeRings++;
+    uint32_t current=n;
+    while(current!=uint32_t(none))
+    {
+      visited[current]=true;
+      uint32_t next=uint32_t(none);
+      for(uint32_t k=0;k<graph.getNumLinks(current);k++)
+      {
+        uint32_t neighbor=graph.getNeighborIdx(current,k);
+        if(monomerClass[neighbor]!=DanglingMonomer && !visited[neighbor]) next=neighbor;
+      }
+      current=next;
+    }
+  }
+
+  //strands at every junction (compressed sparse rows), first order loops only once
+  std::vector<uint32_t> incidentOffsets(nJunctions+1,0);
+  for(uint32_t s=0;s<nStrands;s++)
+  {
+    incidentOffsets[strandEnds[2*s]+1]++;
+    if(strandEnds[2*s+1]!=strandEnds[2*s]) incidentOffsets[strandEnds[2*s+1]+1]++;
+    else nFirstOrderLoops++;
+  }
+  for(uint32_t j=0;j<nJunctions;j++) incidentOffsets[j+1]+=incidentOffsets[j];
+  std::vector<uint32_t> incident(incidentOffsets[nJunctions]);
+  {
+    std::vector<uint32_t> fill(incidentOffsets.begin(),incidentOffsets.end()-1);
+    for(uint32_t s=0;s<nStrands;s++)
+    {
+      incident[fill[strandEnds[2*s]]++]=s;
+      if(strandEnds[2*s+1]!=strandEnds[2*s]) incident[fill[strandEnds[2*s+1]]++]=s;
+    }
+  }
+
+  //second order loops: strands to the same junction counted with a marker per junction
+  {
+    std::vector<uint32_t> marker(nJunctions,uint32_t(none));
+    std::vector<uint32_t> count(nJunctions,0);
+    for(uint32_t j=0;j<nJunctions;j++)
+      for(uint32_t k=incidentOffsets[j];k<incidentOffsets[j+1];k++)
+      {
+        uint32_t s=incident[k];
+        uint32_t other=strandEnds[2*s]+strandEnds[2*s+1]-j;
+        if(other<=j) continue;
+        if(marker[other]!=j){marker[other]=j;count[other]=0;}
+        nSecondOrderLoops+=count[other]++;
+      }
+  }
+
+  //reduce the junction graph to the elastically active network
+  std::vector<uint32_t> degree(nJunctions,0);
+  std::vector<bool> strandAlive(nStrands,true);
+  std::vector<bool> junctionRemoved(nJunctions,false);
+  std::vector<uint32_t> mergedInto(nJunctions,uint32_t(none));
+  std::vector<uint32_t> ends(strandEnds);
+  strandParent.resize(nStrands);
+  for(uint32_t s=0;s<nStrands;s++)
+  {
+    strandParent[s]=s;
+    if(ends[2*s]==ends[2*s+1]){strandAlive[s]=false;nRemovedLoops++;}
+    else{degree[ends[2*s]]++;degree[ends[2*s+1]]++;}
+  }
+  for(uint32_t j=0;j<nJunctions;j++)
+    if(degree[j]<=2) stack.push_back(j);
+
+  while(!stack.empty())
+  {
+    uint32_t j=stack.back();
+    stack.pop_back();
+    if(junctionRemoved[j] || degree[j]>2) continue;
+    junctionRemoved[j]=true;
+
+    //the remaining strands of j
+    uint32_t alive[2]={uint32_t(none),uint32_t(none)};
+    uint32_t nAlive=0;
+    for(uint32_t k=incidentOffsets[j];k<incidentOffsets[j+1] && nAlive<degree[j];k++)
+    {
+      uint32_t s=findStrand(incident[k]);
+      if(strandAlive[s]) alive[nAlive++]=s;
+    }
+
+    if(degree[j]==1)
+    {
+      uint32_t s=alive[0];
+      uint32_t other=ends[2*s]+ends[2*s+1]-j;
+      strandAlive[s]=false;
+      if(--degree[other]<=2) stack.push_back(other);
+    }
+    else if(degree[j]==2)
+    {
+      //merge the second strand into the first
+      uint32_t s=alive[0], t=alive[1];
+      uint32_t a=ends[2*s]+ends[2*s+1]-j;
+      uint32_t b=ends[2*t]+ends[2*t+1]-j;
+      strandParent[t]=s;
+      strandAlive[t]=false;
+      ends[2*s]=a;
+      ends[2*s+1]=b;
+      mergedInto[j]=s;
+      if(a==b)
+      {
+        strandAlive[s]=false;
+        nRemovedLoops++;
+        degree[a]-=2;
+        if(degree[a]<=2) stack.push_back(a);
+      }
+    }
+    degree[j]=0;
+  }
+
+  //final classification of the core monomers
+  for(uint32_t s=0;s<nStrands;s++)
+  {
+    uint32_t root=findStrand(s);
+    if(s==root && strandAlive[s]) nActiveStrands++;
+    uint8_t value=uint8_t(strandAlive[root]?ActiveMonomer:InactiveMonomer);
+    for(uint32_t k=strandOffsets[s];k<strandOffsets[s+1];k++) monomerClass[strandMembers[k]]=value;
+  }
+  for(uint32_t j=0;j<nJunctions;j++)
+  {
+    bool active=!junctionRemoved[j];
+    if(active) nActiveJunctions++;
+    else if(mergedInto[j]!=uint32_t(none)) active=strandAlive[findStrand(mergedInto[j])];
+    monomerClass[junctionMonomers[j]]=uint8_t(active?ActiveMonomer:InactiveMonomer);
+  }
+  for(uint32_t n=0;n<nMonomers;n++)
+    if(monomerClass[n]==ActiveMonomer) nActive++;
+
+  //only needed during the computation
+  std::vector<uint32_t>().swap(coreDegree);
+  std::vector<uint32_t>().swap(junctionIds);
+  std::vector<uint32_t>().swap(strandParent);
+  std::vector<bool>().swap(visited);
+}
+
+#endif /* LEMONADE_UTILITY_NETWORKTOPOLOGY_H */
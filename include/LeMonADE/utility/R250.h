@@ -30,6 +30,8 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 #define R250_RANDOM_PREFETCH			256
 #define R250_RAND_NORMALIZE			2.3283064370807974e-10
+//! number of 32 bit values needed to store the complete state (array and positions)
+#define R250_FULL_STATE_SIZE			(R250_RANDOM_PREFETCH+4)
 
 #include <stdint.h>
 #include <iostream>
@@ -88,6 +90,10 @@ public:
 	void loadDefaultState();
 	//! initializes the internal state array with 256 values from argument stateArray.
 	void setState( uint32_t const * stateArray );
+	//! copies the complete internal state (R250_FULL_STATE_SIZE values) to stateArray, e.g. for checkpoints
+	void saveFullState( uint32_t * stateArray ) const;
+	//! restores the complete internal state saved by saveFullState, the generator continues exactly where it was saved
+	void restoreFullState( uint32_t const * stateArray );
 
 private:
 	//! applies the random number algorithm to the internal state array (next 256 numbers are generated)
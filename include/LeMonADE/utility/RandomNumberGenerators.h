@@ -35,6 +35,8 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 //#define RANDOMNUMBERGENERATOR_ENABLE_CPP11
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include <LeMonADE/utility/R250.h>
@@ -108,6 +110,13 @@ class RandomNumberGenerators
 		void seedMT(uint32_t seed);
 #endif /*RANDOMNUMBERGENERATOR_ENABLE_CPP11*/
 
+		////////////////////////////////////////////////////////////////
+		//functions for checkpoints
+		//! stores the complete state of the generators in a binary checkpoint (see CheckpointWriter)
+		template<class CheckpointWriter> void saveCheckpoint(CheckpointWriter& checkpoint) const;
+		//! restores the state of the generators from a binary checkpoint, the random sequences continue exactly
+		template<class CheckpointReader> void loadCheckpoint(CheckpointReader& checkpoint);
+
 	private:
 
 		//instances of random number engines made static so that the
@@ -123,4 +132,43 @@ class RandomNumberGenerators
 #endif /*RANDOMNUMBERGENERATOR_ENABLE_CPP11*/
 };
 
+/**
+ * @details The full state of the R250Engine (and of the Mersenne Twister, if enabled)
+ * is stored. The state of std::rand() cannot be accessed and is therefore not
+ * part of the checkpoint.
+ *
+ * @param checkpoint Writer of the checkpoint file
+ */
+template<class CheckpointWriter>
+void RandomNumberGenerators::saveCheckpoint(CheckpointWriter& checkpoint) const
+{
+	checkpoint.beginSection("RandomNumberGenerators");
+	std::vector<uint32_t> state(R250_FULL_STATE_SIZE);
+	r250Engine->saveFullState(&state[0]);
+	checkpoint.writeVector(state);
+#ifdef RANDOMNUMBERGENERATOR_ENABLE_CPP11
+	std::ostringstream mtState;
+	mtState<<*mt19937Engine;
+	checkpoint.writeString(mtState.str());
+#endif /*RANDOMNUMBERGENERATOR_ENABLE_CPP11*/
+}
+
+/**
+ * @param checkpoint Reader of the checkpoint file
+ */
+template<class CheckpointReader>
+void RandomNumberGenerators::loadCheckpoint(CheckpointReader& checkpoint)
+{
+	checkpoint.beginSection("RandomNumberGenerators");
+	std::vector<uint32_t> state(R250_FULL_STATE_SIZE);
+	checkpoint.readArray(&state[0],state.size());
+	r250Engine->restoreFullState(&state[0]);
+#ifdef RANDOMNUMBERGENERATOR_ENABLE_CPP11
+	std::string mtStateString;
+	checkpoint.readString(mtStateString);
+	std::istringstream mtState(mtStateString);
+	mtState>>*mt19937Engine;
+#endif /*RANDOMNUMBERGENERATOR_ENABLE_CPP11*/
+}
+
 #endif /* LEMONADE_UTILITY_RANDOMNUMBERGENERATORS_H */
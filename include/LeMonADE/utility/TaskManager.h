@@ -35,12 +35,17 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  **/
 /*****************************************************************************/
 
+#include <fstream>
 #include <iostream>
 #include <list>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
+#include <stdint.h>
 
 #include <LeMonADE/analyzer/AbstractAnalyzer.h>
 #include <LeMonADE/updater/AbstractUpdater.h>
+#include <LeMonADE/utility/Timer.h>
 
 using std::vector;
 
@@ -50,6 +55,22 @@ using std::vector;
  *
  * @brief Manages Updaters and Analyzers
  *
+ * @details In every cycle all due updaters are executed first, then all due
+ * analyzers. By default the analyzers are executed one after the other in
+ * the order they were added. With setAnalyzerThreads() analyzers declaring
+ * themselves thread safe (AbstractAnalyzer::isThreadSafe()) are executed
+ * concurrently by worker threads, while the remaining analyzers run in the
+ * calling thread. Thread safe analyzers working on a snapshot
+ * (AbstractAnalyzer::needsSnapshot()) may additionally overlap with the
+ * updaters of the following cycle. In parallel mode the execution order of
+ * analyzers within one cycle is not defined.
+ *
+ * The TaskManager measures the wall time and the number of calls of every
+ * task and collects the work counters reported by the updaters (see
+ * AbstractUpdater::addWorkCounters()). A summary table is printed by
+ * cleanup() and the statistics can additionally be written periodically to
+ * a file in CSV or JSON lines format (see setStatisticsOutput()).
+ *
  * @todo rename execution routine
  *
  * @todo use pure virtual routine of AbstractAnalyzer and AbstractUpdater
@@ -72,6 +93,11 @@ public:
 
   int getNCircles(){return nCircles;}
 
+  //! Sets the number of worker threads executing thread safe analyzers in parallel. 0 (default) executes all analyzers serially.
+  void setAnalyzerThreads(unsigned int nThreads);
+  //! Returns the number of worker threads for analyzers. 0 means serial execution.
+  unsigned int getAnalyzerThreads() const {return nAnalyzerThreads;}
+
   //! Start execution circle of updaters and analyzers
   void run();
 
@@ -84,6 +110,28 @@ public:
   //! Calles cleanup() routine on all updater- and analyzer-objects
   void cleanup();
 
+  //! Formats of the periodic statistics output, see setStatisticsOutput()
+  enum StatisticsFormat{
+    STATISTICS_CSV=0,	//!< comma separated values with a header line
+    STATISTICS_JSONL=1	//!< one JSON object per task and line
+  };
+
+  //! Writes the statistics of all tasks every period cycles to the file filename
+  void setStatisticsOutput(const std::string& filename, int period, StatisticsFormat format=STATISTICS_CSV);
+
+  //! Enables or disables the summary table printed by cleanup() (default: enabled)
+  void setPrintStatistics(bool print){printStatisticsAtCleanup=print;}
+
+  //! Prints a table with the run time, number of calls and work of all tasks
+  void printStatistics(std::ostream& stream) const;
+
+  //! Stores the cycle counter and the execution state of all tasks in a binary checkpoint
+  template<class CheckpointWriter> void saveCheckpoint(CheckpointWriter& checkpoint) const;
+  //! Restores the cycle counter and the execution state of all tasks from a binary checkpoint
+  template<class CheckpointReader> void loadCheckpoint(CheckpointReader& checkpoint);
+  //! Reads the state stored by saveCheckpoint without restoring it
+  template<class CheckpointReader> static void skipCheckpoint(CheckpointReader& checkpoint);
+
 private:
 
   //! Holds an analyzer and executes it with period execution_period
@@ -91,6 +139,20 @@ private:
 
   //! Holds an updater and executes it with period execution_period
   class UpdaterObject;
+  //! Worker threads executing thread safe analyzers
+  class AnalyzerPool;
+
+  //! Executes all analyzers due in the current cycle
+  void executeAnalyzers();
+  //! Waits for analyzers still running in worker threads
+  void waitForAnalyzers();
+  //! Appends the current statistics to the statistics file
+  void writeStatistics();
+
+  //! no copies, the TaskManager owns its tasks
+  TaskManager(const TaskManager&);
+  TaskManager& operator=(const TaskManager&);
+
 
 
 
@@ -102,6 +164,21 @@ private:
 
   //! nCircles counter for execution loops
   int nCircles;
+  //! Number of worker threads for analyzers (0: serial execution)
+  unsigned int nAnalyzerThreads;
+  //! Worker threads for analyzers, NULL in serial mode
+  AnalyzerPool* analyzerPool;
+
+  //! Total wall time spent in run() in seconds
+  double runTime;
+  //! Print the statistics in cleanup()
+  bool printStatisticsAtCleanup;
+  //! File for the periodic statistics output (not open if disabled)
+  std::ofstream statisticsFile;
+  //! Period of the statistics output in cycles
+  int statisticsPeriod;
+  //! Format of the statistics output
+  StatisticsFormat statisticsFormat;
 };
 
 /*****************************************************************************/
@@ -117,16 +194,42 @@ private:
 class TaskManager::AnalyzerObject{
 public:
   AnalyzerObject(AbstractAnalyzer* a,unsigned int period)
-    :myAnalyzer(a),execution_period(period),isFirstExecution(true){};
+    :myAnalyzer(a),execution_period(period),isFirstExecution(true),nCalls(0),elapsedTime(0.0){};
 
   ~AnalyzerObject(){delete myAnalyzer;};
 
   /**
-   * @brief Executes the analyzer
+   * @brief Executes the analyzer, taking a snapshot first if the analyzer needs one
    *
    * @todo rename to execute
    **/
-  void run(){ myAnalyzer->execute();};
+  void run(){
+    if(myAnalyzer->needsSnapshot()) takeSnapshot();
+    execute();
+  };
+  //! Calls the analyzer's execute routine and measures its run time
+  void execute(){
+    Timer timer;
+    myAnalyzer->execute();
+    elapsedTime+=timer.elapsed();
+    nCalls++;
+  }
+  //! Calls the analyzer's takeSnapshot routine and measures its run time
+  void takeSnapshot(){
+    Timer timer;
+    myAnalyzer->takeSnapshot();
+    elapsedTime+=timer.elapsed();
+  }
+  //! Returns the held analyzer
+  AbstractAnalyzer* getAnalyzer(){return myAnalyzer;}
+  //! Returns the held analyzer
+  const AbstractAnalyzer* getAnalyzer() const {return myAnalyzer;}
+  //! Number of executions
+  uint64_t getNCalls() const {return nCalls;}
+  //! Total run time of all executions (including snapshots) in seconds
+  double getElapsedTime() const {return elapsedTime;}
+  //! Execution period
+  unsigned int getPeriod() const {return execution_period;}
 
   //! Calls the analyzer's initialize routine
   void initialize(){myAnalyzer->initialize();}
@@ -134,6 +237,10 @@ public:
   //! Calls the analyzer's cleanup routine
   void cleanup(){myAnalyzer->cleanup();}
 
+  //! True if a task with execution period 0 was not executed yet
+  bool getFirstExecution() const {return isFirstExecution;}
+  //! Sets the state of a task with execution period 0 (used for checkpoints)
+  void setFirstExecution(bool first){isFirstExecution=first;}
   //! Decides whether or not to execute in execution circle given as argument
   bool shouldExecute(int nCircles){
     if(execution_period!=0) return (nCircles%execution_period==0);
@@ -146,6 +253,8 @@ private:
   AbstractAnalyzer* myAnalyzer;
   unsigned int execution_period;
   bool isFirstExecution;
+  uint64_t nCalls;
+  double elapsedTime;
 };
 
 /*****************************************************************************/
@@ -161,7 +270,7 @@ private:
 class TaskManager::UpdaterObject{
 public:
   UpdaterObject(AbstractUpdater* u, unsigned int period)
-    :myUpdater(u),execution_period(period),isFirstExecution(true){};
+    :myUpdater(u),execution_period(period),isFirstExecution(true),nCalls(0),elapsedTime(0.0){};
 
   ~UpdaterObject(){delete myUpdater;};
 
@@ -170,7 +279,21 @@ public:
    *
    * @todo rename to execute
    **/
-  bool run(){return myUpdater->execute();}
+  bool run(){
+    Timer timer;
+    bool result=myUpdater->execute();
+    elapsedTime+=timer.elapsed();
+    nCalls++;
+    return result;
+  }
+  //! Returns the held updater
+  const AbstractUpdater* getUpdater() const {return myUpdater;}
+  //! Number of executions
+  uint64_t getNCalls() const {return nCalls;}
+  //! Total run time of all executions in seconds
+  double getElapsedTime() const {return elapsedTime;}
+  //! Execution period
+  unsigned int getPeriod() const {return execution_period;}
 
   //! Calls the updater's initialize routine
   void initialize(){myUpdater->initialize();}
@@ -178,6 +301,10 @@ public:
   //! Calls the updater's cleanup routine
   void cleanup(){myUpdater->cleanup();}
 
+  //! True if a task with execution period 0 was not executed yet
+  bool getFirstExecution() const {return isFirstExecution;}
+  //! Sets the state of a task with execution period 0 (used for checkpoints)
+  void setFirstExecution(bool first){isFirstExecution=first;}
   //! Decides whether or not to execute in execution circle given as argument
   bool shouldExecute(int nCircles){
     if(execution_period!=0) return (nCircles%execution_period==0);
@@ -191,6 +318,94 @@ private:
   AbstractUpdater* myUpdater;
   unsigned int execution_period;
   bool isFirstExecution;
+  uint64_t nCalls;
+  double elapsedTime;
 };
 
+/*****************************************************************************/
+/**
+ * @details The tasks themselves are not stored, i.e. the TaskManager used for
+ * loading the checkpoint has to be set up with the same updaters and analyzers
+ * in the same order. Only the number of tasks is checked.
+ *
+ * @param checkpoint Writer of the checkpoint file
+ **/
+template<class CheckpointWriter>
+void TaskManager::saveCheckpoint(CheckpointWriter& checkpoint) const
+{
+  checkpoint.beginSection("TaskManager");
+  checkpoint.write(nCircles);
+  checkpoint.write(uint64_t(updater.size()));
+  checkpoint.write(uint64_t(analyzer.size()));
+
+  for(size_t n=0;n<updater.size();n++)
+    checkpoint.write(updater[n]->getFirstExecution());
+  for(size_t n=0;n<analyzer.size();n++)
+    checkpoint.write(analyzer[n]->getFirstExecution());
+}
+
+/*****************************************************************************/
+/**
+ * @throw std::runtime_error if the number of tasks differs from the checkpoint
+ *
+ * @param checkpoint Reader of the checkpoint file
+ **/
+template<class CheckpointReader>
+void TaskManager::loadCheckpoint(CheckpointReader& checkpoint)
+{
+  checkpoint.beginSection("TaskManager");
+  int storedCircles;
+  uint64_t nUpdaters,nAnalyzers;
+  checkpoint.read(storedCircles);
+  checkpoint.read(nUpdaters);
+  checkpoint.read(nAnalyzers);
+
+  if(nUpdaters!=updater.size() || nAnalyzers!=analyzer.size())
+  {
+    std::stringstream errormessage;
+    errormessage<<"TaskManager::loadCheckpoint: checkpoint contains "<<nUpdaters
+		<<" updaters and "<<nAnalyzers<<" analyzers, but "<<updater.size()
+		<<" updaters and "<<analyzer.size()<<" analyzers are registered";
+    throw std::runtime_error(errormessage.str());
+  }
+
+  nCircles=storedCircles;
+  for(size_t n=0;n<updater.size();n++)
+  {
+    bool first;
+    checkpoint.read(first);
+    updater[n]->setFirstExecution(first);
+  }
+  for(size_t n=0;n<analyzer.size();n++)
+  {
+    bool first;
+    checkpoint.read(first);
+    analyzer[n]->setFirstExecution(first);
+  }
+}
+
+/*****************************************************************************/
+/**
+ * @details Used if a checkpoint is loaded without TaskManager, such that the
+ * rest of the checkpoint is still read and checked.
+ *
+ * @param checkpoint Reader of the checkpoint file
+ **/
+template<class CheckpointReader>
+void TaskManager::skipCheckpoint(CheckpointReader& checkpoint)
+{
+  checkpoint.beginSection("TaskManager");
+  int storedCircles;
+  uint64_t nUpdaters,nAnalyzers;
+  checkpoint.read(storedCircles);
+  checkpoint.read(nUpdaters);
+  checkpoint.read(nAnalyzers);
+
+  for(uint64_t n=0;n<nUpdaters+nAnalyzers;n++)
+  {
+    bool first;
+    checkpoint.read(first);
+  }
+}
+
 #endif /* LEMONADE_UTILITY_TASKMANAGER_H */
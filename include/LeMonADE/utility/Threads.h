@@ -0,0 +1,156 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UTILITY_THREADS_H
+#define LEMONADE_UTILITY_THREADS_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Minimal wrappers around POSIX threads used for parallel tasks
+ * */
+/*****************************************************************************/
+
+#include <pthread.h>
+
+/*****************************************************************************/
+/**
+ * @class Mutex
+ * @brief Non-recursive mutual exclusion lock
+ **/
+/*****************************************************************************/
+class Mutex
+{
+public:
+  Mutex();
+  ~Mutex();
+
+  void lock();
+  void unlock();
+
+private:
+  //! the condition variable needs access to the native handle
+  friend class Condition;
+
+  //! no copies
+  Mutex(const Mutex&);
+  Mutex& operator=(const Mutex&);
+
+  pthread_mutex_t mutex;
+};
+
+/*****************************************************************************/
+/**
+ * @class MutexLock
+ * @brief Locks a Mutex for the lifetime of the object
+ **/
+/*****************************************************************************/
+class MutexLock
+{
+public:
+  explicit MutexLock(Mutex& m):mutex(m){mutex.lock();}
+  ~MutexLock(){mutex.unlock();}
+
+private:
+  MutexLock(const MutexLock&);
+  MutexLock& operator=(const MutexLock&);
+
+  Mutex& mutex;
+};
+
+/*****************************************************************************/
+/**
+ * @class Condition
+ * @brief Condition variable to be used together with a locked Mutex
+ **/
+/*****************************************************************************/
+class Condition
+{
+public:
+  Condition();
+  ~Condition();
+
+  //! Releases the locked mutex, waits for a notification and locks the mutex again
+  void wait(Mutex& mutex);
+
+  //! Wakes up one waiting thread
+  void signal();
+
+  //! Wakes up all waiting threads
+  void broadcast();
+
+private:
+  Condition(const Condition&);
+  Condition& operator=(const Condition&);
+
+  pthread_cond_t condition;
+};
+
+/*****************************************************************************/
+/**
+ * @class Thread
+ *
+ * @brief Base class for objects running their member function run() in a separate thread
+ *
+ * @details The thread is started with start() and must be joined with join()
+ * before the object is destroyed. Exceptions must not leave run().
+ **/
+/*****************************************************************************/
+class Thread
+{
+public:
+  Thread();
+  virtual ~Thread();
+
+  //! Starts run() in a new thread
+  void start();
+
+  //! Waits for the thread to finish
+  void join();
+
+  //! Returns true if the thread was started and not yet joined
+  bool isRunning() const {return running;}
+
+  //! Number of processors available, at least 1
+  static unsigned int hardwareConcurrency();
+
+protected:
+  //! Function executed in the thread
+  virtual void run()=0;
+
+private:
+  Thread(const Thread&);
+  Thread& operator=(const Thread&);
+
+  //! Entry point passed to pthread_create
+  static void* entry(void* thread);
+
+  pthread_t thread;
+  bool running;
+};
+
+#endif /* LEMONADE_UTILITY_THREADS_H */
@@ -0,0 +1,76 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#ifndef LEMONADE_UTILITY_TIMER_H
+#define LEMONADE_UTILITY_TIMER_H
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Definition of class Timer
+ * */
+/*****************************************************************************/
+
+#include <time.h>
+
+/*****************************************************************************/
+/**
+ * @class Timer
+ *
+ * @brief Measures wall time intervals with the monotonic system clock
+ *
+ * @details In contrast to time(NULL) the clock has (typically) nanosecond
+ * resolution and is not affected by changes of the system time, so it is
+ * suitable for measuring the run time of single tasks.
+ **/
+/*****************************************************************************/
+class Timer
+{
+public:
+  //! Starts the timer
+  Timer():startTime(now()){}
+
+  //! Restarts the timer
+  void restart(){startTime=now();}
+
+  //! Seconds passed since construction or the last restart()
+  double elapsed() const {return now()-startTime;}
+
+  //! Current time of the monotonic clock in seconds (arbitrary origin)
+  static double now()
+  {
+	  timespec t;
+	  clock_gettime(CLOCK_MONOTONIC,&t);
+	  return double(t.tv_sec)+1.0e-9*double(t.tv_nsec);
+  }
+
+private:
+  //! Time of the start in seconds
+  double startTime;
+};
+
+#endif /* LEMONADE_UTILITY_TIMER_H */
@@ -30,9 +30,21 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <vector>
 #include <sstream>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <stdint.h>
 // #include <ostream>
 #include <LeMonADE/utility/ResultFormattingTools.h>
+#include <LeMonADE/utility/Threads.h>
 /****************************************************************************/
+/**
+ * @class TrackLinks
+ * @brief Buffers reaction records and writes them as text table
+ * @details For high reaction rates use the binary BondEventLogWriter, which
+ * avoids the text formatting and can write on a background thread.
+ */
 template<class T=uint32_t >
 class TrackLinks
 {
@@ -146,6 +158,247 @@ void TrackLinks<T>::dumpReactions()
 	//set all time series vectors back to zero size
 	resetConnection();
 }
+/****************************************************************************/
+/**
+ * @struct BondEvent
+ * @brief A single bond creation or bond breaking event
+ * @details The type uses the convention of TrackLinks: 0 for a break and
+ * 1 for a new bond, monomer id's start at 0.
+ */
+struct BondEvent
+{
+  enum EventType {BondBreak=0, BondCreation=1};
+
+  BondEvent():mcs(0),id1(0),id2(0),type(BondCreation){}
+  BondEvent(uint64_t mcs_, uint32_t id1_, uint32_t id2_, uint32_t type_)
+  :mcs(mcs_),id1(id1_),id2(id2_),type(type_){}
+
+  //! time of the event in MCS
+  uint64_t mcs;
+  //! the two monomers of the bond
+  uint32_t id1;
+  uint32_t id2;
+  //! BondBreak or BondCreation
+  uint32_t type;
+
+  //! size of one record in the file: mcs, id1, id2 and type without padding
+  static const uint32_t recordSize=20;
+};
+
+/****************************************************************************/
+/**
+ * @class BondEventLogWriter
+ * @brief Append-only binary log of bond events
+ *
+ * @details Every event is stored as fixed-width record of BondEvent::recordSize
+ * bytes (mcs, id1, id2, type in native byte order) behind a short file header.
+ * The records are collected in a buffer of bufferedEvents records, which is
+ * written as one block when it is full. With backgroundWriting the block is
+ * handed to a writer thread and the simulation continues on a second buffer,
+ * so it only waits if the disk is slower than the reactions.
+ * The log is read back with BondEventLogReader.
+ *
+ * Like checkpoints the format depends on the byte order of the machine, which
+ * is checked by the reader.
+ */
+class BondEventLogWriter
+{
+public:
+  //! Opens the log, if append is true new events are added to an existing log
+  BondEventLogWriter(const std::string& filename, uint32_t bufferedEvents=65536,
+		     bool backgroundWriting=false, bool append=false);
+  //! Writes the remaining events and closes the file, errors are ignored
+  ~BondEventLogWriter();
+
+  //! Adds an event to the log
+  void addEvent(uint64_t mcs, uint32_t id1, uint32_t id2, uint32_t type)
+  {
+    char* record=&activeBuffer[activeEvents*BondEvent::recordSize];
+    std::memcpy(record,&mcs,8);
+    std::memcpy(record+8,&id1,4);
+    std::memcpy(record+12,&id2,4);
+    std::memcpy(record+16,&type,4);
+    if(++activeEvents==bufferedEvents) flushBuffer();
+    nEvents++;
+  }
+
+  //! Adds an event to the log
+  void addEvent(const BondEvent& event){addEvent(event.mcs,event.id1,event.id2,event.type);}
+
+  //! Adds a new bond to the log
+  void addConnection(uint64_t mcs, uint32_t id1, uint32_t id2){addEvent(mcs,id1,id2,BondEvent::BondCreation);}
+
+  //! Adds a broken bond to the log
+  void addBreak(uint64_t mcs, uint32_t id1, uint32_t id2){addEvent(mcs,id1,id2,BondEvent::BondBreak);}
+
+  //! Writes all buffered events to the file
+  void flush();
+
+  //! Writes all buffered events, stops the writer thread and closes the file
+  void close();
+
+  //! Number of events added by this writer
+  uint64_t getNumEvents() const {return nEvents;}
+
+  //! Name of the log file
+  const std::string& getFilename() const {return filename;}
+
+private:
+  //! no copies, the file is owned by this object
+  BondEventLogWriter(const BondEventLogWriter&);
+  BondEventLogWriter& operator=(const BondEventLogWriter&);
+
+  //! thread writing the full buffers in the background
+  class WriterThread: public Thread
+  {
+  public:
+    explicit WriterThread(BondEventLogWriter& writer_):writer(writer_){}
+  protected:
+    virtual void run(){writer.writeLoop();}
+  private:
+    BondEventLogWriter& writer;
+  };
+
+  //! Writes the active buffer directly or hands it to the writer thread
+  void flushBuffer();
+  //! Waits until the writer thread finished the pending buffer
+  void waitForPendingBuffer();
+  //! Writes a block to the file, returns false on error
+  bool writeBlock(const char* data, uint64_t nBytes);
+  //! Main loop of the writer thread
+  void writeLoop();
+
+  std::string filename;
+  std::ofstream file;
+  uint32_t bufferedEvents;
+  bool backgroundWriting;
+
+  //! buffer filled by addEvent()
+  std::vector<char> activeBuffer;
+  uint32_t activeEvents;
+  //! buffer handed to the writer thread
+  std::vector<char> pendingBuffer;
+  uint32_t pendingEvents;
+
+  //! synchronization with the writer thread, protects pendingEvents, stopWriting and writeError
+  Mutex mutex;
+  Condition condition;
+  WriterThread writerThread;
+  bool stopWriting;
+  bool writeError;
+
+  bool closed;
+  uint64_t nEvents;
+};
+
+/****************************************************************************/
+/**
+ * @class BondEventLogReader
+ * @brief Reads a log written by BondEventLogWriter and replays it
+ *
+ * @details The events can be read one by one with readEvent() or applied to
+ * the topology of a Molecules object with replay(). The reader keeps track of
+ * the number of applied events, such that replay() moves forward and backward
+ * in time: going back undoes the events in reverse order. The molecules passed
+ * to replay() must therefore always be the ones used in the previous calls,
+ * initially with the topology at the start of the log. The file is read in
+ * blocks, so replaying needs only memory for one block of records.
+ */
+class BondEventLogReader
+{
+public:
+  //! Opens the log and checks the file header
+  explicit BondEventLogReader(const std::string& filename, uint32_t bufferedEvents=65536);
+
+  //! Number of events in the log
+  uint64_t getNumEvents() const {return nEvents;}
+
+  //! Returns the k-th event of the log
+  BondEvent getEvent(uint64_t k);
+
+  //! Reads the next event, returns false at the end of the log
+  bool readEvent(BondEvent& event);
+
+  //! Number of events read or replayed so far, the index of the next event
+  uint64_t getPosition() const {return position;}
+
+  //! Moves to the start of the log without changing any molecules
+  void rewind(){position=0;}
+
+  //! Applies or undoes events such that the molecules have the topology at time mcs
+  template<class MoleculesType>
+  void replay(MoleculesType& molecules, uint64_t mcs);
+
+private:
+  //! Applies an event to the molecules, or its inverse if undo is true
+  template<class MoleculesType>
+  void applyEvent(MoleculesType& molecules, const BondEvent& event, bool undo) const;
+
+  //! Loads the block containing record k into the buffer
+  void loadBlock(uint64_t k);
+
+  std::string filename;
+  std::ifstream file;
+  uint64_t nEvents;
+  uint64_t position;
+
+  //! buffered records and the index of the first record in the buffer
+  std::vector<char> buffer;
+  uint32_t bufferedEvents;
+  uint64_t bufferBegin;
+  uint64_t bufferEnd;
+};
+
+/****************************************************************************/
+/**
+ * @details Events with a time equal to mcs are applied. Every event is checked
+ * against the current topology, a std::runtime_error is thrown if the log
+ * creates an existing bond or breaks a missing one, which means the molecules
+ * do not match the position in the log.
+ *
+ * @param molecules molecules with the topology at the current position of the reader
+ * @param mcs time to move to
+ */
+template<class MoleculesType>
+void BondEventLogReader::replay(MoleculesType& molecules, uint64_t mcs)
+{
+  while(position<nEvents)
+  {
+    BondEvent event=getEvent(position);
+    if(event.mcs>mcs) break;
+    applyEvent(molecules,event,false);
+    position++;
+  }
+  while(position>0)
+  {
+    BondEvent event=getEvent(position-1);
+    if(event.mcs<=mcs) break;
+    applyEvent(molecules,event,true);
+    position--;
+  }
+}
+
+/****************************************************************************/
+template<class MoleculesType>
+void BondEventLogReader::applyEvent(MoleculesType& molecules, const BondEvent& event, bool undo) const
+{
+  bool create=((event.type==BondEvent::BondCreation)!=undo);
+  if(event.id1>=molecules.size() || event.id2>=molecules.size() ||
+     molecules.areConnected(event.id1,event.id2)==create)
+  {
+    std::stringstream errormessage;
+    errormessage<<"BondEventLogReader::replay(): "<<(undo?"undoing ":"applying ")
+                <<(event.type==BondEvent::BondCreation?"bond creation ":"bond break ")
+                <<event.id1<<"-"<<event.id2<<" at mcs "<<event.mcs
+                <<" does not match the topology, log file "<<filename;
+    throw std::runtime_error(errormessage.str());
+  }
+  if(create)
+    molecules.connect(event.id1,event.id2);
+  else
+    molecules.disconnect(event.id1,event.id2);
+}
+
 /****************************************************************************/
 
 #endif 	/*LEMONADE_UPDATER_TRACKCONNECTION_H*/
@@ -49,6 +49,79 @@ bool AbstractRead::detectRead(std::string& line) const {
         return false;
 }
 
+/**
+ * @brief Checks if the line [lineBegin,lineEnd) contains a Read-string (i.e. !... or #!...)
+ *
+ * @param lineBegin Pointer to the first character of the line
+ * @param lineEnd Pointer behind the last character of the line
+ * @return True if line is an command. False - everything else.
+ */
+bool AbstractRead::detectRead(const char* lineBegin, const char* lineEnd) const {
+    if (lineBegin==lineEnd)
+        return false;
+    else if (*lineBegin=='!')
+        return true;
+    else if (lineEnd-lineBegin>1 && lineBegin[0]=='#' && lineBegin[1]=='!')
+        return true;
+    else
+        return false;
+}
+
+/***********************************************************************
+ * returns the memory mapped buffer if the input stream reads from one
+ ***********************************************************************/
+/**
+ * @brief Returns the memory mapped buffer the input stream is reading from.
+ *
+ * @details Reads on the hot path use this to decode data directly from the
+ * mapped file. If the input stream is not memory mapped, they fall back to
+ * the stream based implementation.
+ *
+ * @return Pointer to the MappedFileBuffer, or 0 if the input is not memory mapped.
+ */
+MappedFileBuffer* AbstractRead::getMappedBuffer() {
+    MappedFileBuffer* buffer=dynamic_cast<MappedFileBuffer*>(source->rdbuf());
+    if(buffer!=0 && buffer->is_open())
+        return buffer;
+    else
+        return 0;
+}
+
+/***********************************************************************
+ * zero-copy getline on memory mapped input
+ ***********************************************************************/
+/**
+ * @brief Returns the next line of the memory mapped input without copying it.
+ *
+ * @details The read position is moved behind the newline character. The state
+ * of the input stream is updated in the same way std::getline would do it,
+ * i.e. eofbit is set if the last line has no newline character, and failbit
+ * and eofbit are set if no line could be extracted.
+ *
+ * @param buffer The memory mapped buffer of the input stream
+ * @param lineBegin Set to the first character of the line
+ * @param lineEnd Set behind the last character of the line (excluding the newline)
+ * @return True if a line could be extracted.
+ */
+bool AbstractRead::getMappedLine(MappedFileBuffer& buffer, const char*& lineBegin, const char*& lineEnd) {
+    lineBegin=buffer.position();
+    if(lineBegin==buffer.end() || !source->good()){
+        lineEnd=lineBegin;
+        source->setstate(std::ios_base::eofbit|std::ios_base::failbit);
+        return false;
+    }
+
+    lineEnd=MappedFileBuffer::findLineEnd(lineBegin,buffer.end());
+    if(lineEnd==buffer.end()){
+        buffer.setPosition(lineEnd);
+        source->setstate(std::ios_base::eofbit);
+    }
+    else
+        buffer.setPosition(lineEnd+1);
+
+    return true;
+}
+
 /***********************************************************************
  * checks if the next character in the stream is separator. ignores whitespace.
  ***********************************************************************/
@@ -0,0 +1,285 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#include <LeMonADE/io/BfmFileIndex.h>
+
+#include <cstring>
+#include <fstream>
+
+#include <sys/stat.h>
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Implementation of BfmFileIndex
+ * */
+/*****************************************************************************/
+
+namespace
+{
+	//! identifies the index file format
+	const char indexMagic[8]={'B','F','M','I','N','D','E','X'};
+	//! version of the index file format
+	const uint32_t indexVersion=2;
+	//! used to detect index files written with a different byte order
+	const uint32_t byteOrderMark=0x01020304;
+	//! number of bytes at the end of the indexed part of the file used for the checksum
+	const uint64_t checksumLength=4096;
+
+	//! size of the header of the index file in bytes
+	const std::streamoff headerSize=sizeof(indexMagic)+2*sizeof(uint32_t)+4*sizeof(uint64_t);
+	//! size of one entry in the index file in bytes
+	const std::streamoff entrySize=3*sizeof(uint64_t);
+
+	template<class T>
+	void writeValue(std::ostream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value),sizeof(T));
+	}
+
+	template<class T>
+	void readValue(std::istream& stream, T& value)
+	{
+		stream.read(reinterpret_cast<char*>(&value),sizeof(T));
+	}
+}
+
+/*****************************************************************************/
+BfmFileIndex::BfmFileIndex(const std::string& filename)
+  :bfmFilename(filename)
+  ,indexFilename(indexFilenameOf(filename))
+  ,nSavedEntries(0)
+  ,fileSize(0)
+  ,modificationTime(0)
+  ,checksum(0)
+{}
+
+/*****************************************************************************/
+/**
+ * @details If the index file is missing, corrupted or does not match the
+ * bfm-file, the index is cleared. If the bfm-file has grown and the already
+ * indexed part is unchanged, the loaded entries are kept and Grown is
+ * returned, such that only the new part of the file has to be scanned.
+ *
+ * @return Status of the index compared to the bfm-file
+ */
+BfmFileIndex::Status BfmFileIndex::load()
+{
+	clear();
+
+	std::ifstream indexFile(indexFilename.c_str(),std::ios_base::in|std::ios_base::binary);
+	if(!indexFile.is_open()) return Missing;
+
+	char magic[sizeof(indexMagic)];
+	uint32_t version=0,bom=0;
+	uint64_t storedSize=0,storedChecksum=0,nEntries=0;
+	int64_t storedTime=0;
+
+	indexFile.read(magic,sizeof(magic));
+	readValue(indexFile,version);
+	readValue(indexFile,bom);
+	readValue(indexFile,storedSize);
+	readValue(indexFile,storedTime);
+	readValue(indexFile,storedChecksum);
+	readValue(indexFile,nEntries);
+
+	if(indexFile.fail() || std::memcmp(magic,indexMagic,sizeof(indexMagic))!=0
+	   || version!=indexVersion || bom!=byteOrderMark)
+		return Invalid;
+
+	//compare with the current state of the bfm-file
+	uint64_t currentSize;
+	int64_t currentTime;
+	uint64_t currentChecksum;
+	if(!readFileStatus(currentSize,currentTime) || currentSize<storedSize
+	   || !tailChecksum(storedSize,currentChecksum) || currentChecksum!=storedChecksum)
+		return Invalid;
+
+	//the number of frames must match the size of the index file, such that a
+	//truncated or corrupted index does not lead to a huge allocation
+	indexFile.seekg(0,std::ios_base::end);
+	std::streamoff indexSize=indexFile.tellg();
+	indexFile.seekg(headerSize,std::ios_base::beg);
+	if(indexFile.fail() || indexSize<headerSize
+	   || nEntries!=uint64_t((indexSize-headerSize)/entrySize))
+		return Invalid;
+
+	//read the frames
+	entries.resize(nEntries);
+	for(size_t n=0;n<entries.size();n++)
+	{
+		readValue(indexFile,entries[n].mcs);
+		readValue(indexFile,entries[n].offset);
+		readValue(indexFile,entries[n].flags);
+	}
+
+	if(indexFile.fail())
+	{
+		clear();
+		return Invalid;
+	}
+
+	nSavedEntries=entries.size();
+	fileSize=storedSize;
+	modificationTime=storedTime;
+	checksum=storedChecksum;
+
+	if(currentSize==storedSize && currentTime==storedTime) return Valid;
+	else if(currentSize>storedSize) return Grown;
+
+	//same size but modified: the file has to be scanned again
+	clear();
+	return Invalid;
+}
+
+/*****************************************************************************/
+/**
+ * @details If the index file was loaded before, the header is updated and
+ * only the frames added since then are appended to the file. Otherwise the
+ * index file is written completely.
+ *
+ * @return True if the index file could be written
+ */
+bool BfmFileIndex::save()
+{
+	std::fstream indexFile;
+
+	if(nSavedEntries>0)
+	{
+		indexFile.open(indexFilename.c_str(),std::ios_base::in|std::ios_base::out|std::ios_base::binary);
+		if(!indexFile.is_open()) nSavedEntries=0;
+	}
+
+	if(nSavedEntries==0)
+	{
+		indexFile.open(indexFilename.c_str(),std::ios_base::out|std::ios_base::trunc|std::ios_base::binary);
+		if(!indexFile.is_open()) return false;
+	}
+
+	uint64_t nEntries=entries.size();
+
+	indexFile.seekp(0);
+	indexFile.write(indexMagic,sizeof(indexMagic));
+	writeValue(indexFile,indexVersion);
+	writeValue(indexFile,byteOrderMark);
+	writeValue(indexFile,fileSize);
+	writeValue(indexFile,modificationTime);
+	writeValue(indexFile,checksum);
+	writeValue(indexFile,nEntries);
+
+	indexFile.seekp(headerSize+std::streamoff(nSavedEntries)*entrySize);
+	for(size_t n=nSavedEntries;n<entries.size();n++)
+	{
+		writeValue(indexFile,entries[n].mcs);
+		writeValue(indexFile,entries[n].offset);
+		writeValue(indexFile,entries[n].flags);
+	}
+
+	indexFile.flush();
+	if(indexFile.fail()) return false;
+
+	nSavedEntries=entries.size();
+	return true;
+}
+
+/*****************************************************************************/
+void BfmFileIndex::clear()
+{
+	entries.clear();
+	nSavedEntries=0;
+	fileSize=0;
+	modificationTime=0;
+	checksum=0;
+}
+
+/*****************************************************************************/
+void BfmFileIndex::addEntry(uint64_t mcs, uint64_t offset, uint64_t flags)
+{
+	Entry entry;
+	entry.mcs=mcs;
+	entry.offset=offset;
+	entry.flags=flags;
+	entries.push_back(entry);
+}
+
+/*****************************************************************************/
+/**
+ * @details Must be called with the number of bytes of the bfm-file that
+ * were scanned. If the file grows while it is scanned, the next load()
+ * detects the additional data and only the new part is scanned.
+ *
+ * @param indexedSize Number of bytes of the bfm-file covered by the index
+ * @return True if the file information could be determined
+ */
+bool BfmFileIndex::setIndexedFile(uint64_t indexedSize)
+{
+	uint64_t currentSize;
+	if(!readFileStatus(currentSize,modificationTime) || currentSize<indexedSize)
+		return false;
+
+	fileSize=indexedSize;
+	return tailChecksum(fileSize,checksum);
+}
+
+/*****************************************************************************/
+bool BfmFileIndex::readFileStatus(uint64_t& size, int64_t& time) const
+{
+	struct stat fileStatus;
+	if(stat(bfmFilename.c_str(),&fileStatus)!=0) return false;
+
+	size=uint64_t(fileStatus.st_size);
+	time=int64_t(fileStatus.st_mtime);
+	return true;
+}
+
+/*****************************************************************************/
+/**
+ * @details The checksum over the last bytes of the indexed part of the file
+ * detects files that were replaced by a different file of larger size.
+ */
+bool BfmFileIndex::tailChecksum(uint64_t end, uint64_t& result) const
+{
+	uint64_t begin=(end>checksumLength)?end-checksumLength:0;
+
+	std::ifstream source(bfmFilename.c_str(),std::ios_base::in|std::ios_base::binary);
+	if(!source.is_open()) return false;
+
+	std::vector<char> buffer(end-begin);
+	source.seekg(std::streamoff(begin));
+	if(!buffer.empty()) source.read(&buffer[0],std::streamsize(buffer.size()));
+	if(source.fail()) return false;
+
+	//64 bit FNV-1a hash
+	result=14695981039346656037ULL;
+	for(size_t n=0;n<buffer.size();n++)
+	{
+		result^=uint64_t(static_cast<unsigned char>(buffer[n]));
+		result*=1099511628211ULL;
+	}
+
+	return true;
+}
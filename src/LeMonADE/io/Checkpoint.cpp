@@ -0,0 +1,202 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#include <LeMonADE/io/Checkpoint.h>
+
+#include <cstdio>
+#include <cstring>
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Implementation of CheckpointWriter and CheckpointReader
+ * */
+/*****************************************************************************/
+
+namespace
+{
+	//! identifies the checkpoint file format
+	const char checkpointMagic[8]={'L','M','C','H','K','P','N','T'};
+	//! version of the checkpoint file format
+	const uint32_t checkpointVersion=1;
+	//! used to detect files written with a different byte order
+	const uint32_t byteOrderMark=0x01020304;
+	//! name of the section marking the end of a complete checkpoint
+	const char endSection[]="end of checkpoint";
+}
+
+/*****************************************************************************/
+CheckpointWriter::CheckpointWriter(const std::string& filename_)
+  :filename(filename_)
+  ,tmpFilename(filename_+".tmp")
+  ,closed(false)
+{
+	file.open(tmpFilename.c_str(),std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+	if(!file.is_open())
+	{
+		std::stringstream errormessage;
+		errormessage<<"CheckpointWriter: cannot open file "<<tmpFilename<<" for writing";
+		throw std::runtime_error(errormessage.str());
+	}
+
+	writeBytes(checkpointMagic,sizeof(checkpointMagic));
+	write(checkpointVersion);
+	write(byteOrderMark);
+}
+
+/*****************************************************************************/
+CheckpointWriter::~CheckpointWriter()
+{
+	if(!closed)
+	{
+		file.close();
+		std::remove(tmpFilename.c_str());
+	}
+}
+
+/*****************************************************************************/
+void CheckpointWriter::beginSection(const std::string& name)
+{
+	writeString(name);
+}
+
+/*****************************************************************************/
+void CheckpointWriter::writeString(const std::string& str)
+{
+	writeArray(str.data(),str.size());
+}
+
+/*****************************************************************************/
+/**
+ * @details Writes the end marker, flushes the file and renames it from
+ * filename.tmp to filename, replacing an existing checkpoint of the same name.
+ */
+void CheckpointWriter::close()
+{
+	if(closed) return;
+
+	beginSection(endSection);
+	file.close();
+
+	if(file.fail() || std::rename(tmpFilename.c_str(),filename.c_str())!=0)
+	{
+		std::remove(tmpFilename.c_str());
+		closed=true;
+		std::stringstream errormessage;
+		errormessage<<"CheckpointWriter: error while writing file "<<filename;
+		throw std::runtime_error(errormessage.str());
+	}
+	closed=true;
+}
+
+/*****************************************************************************/
+void CheckpointWriter::writeBytes(const void* data, uint64_t n)
+{
+	file.write(static_cast<const char*>(data),std::streamsize(n));
+	if(file.fail())
+	{
+		std::stringstream errormessage;
+		errormessage<<"CheckpointWriter: error while writing file "<<tmpFilename;
+		throw std::runtime_error(errormessage.str());
+	}
+}
+
+/*****************************************************************************/
+CheckpointReader::CheckpointReader(const std::string& filename_)
+  :filename(filename_)
+{
+	file.open(filename.c_str(),std::ios_base::in|std::ios_base::binary);
+	if(!file.is_open())
+	{
+		std::stringstream errormessage;
+		errormessage<<"CheckpointReader: cannot open file "<<filename;
+		throw std::runtime_error(errormessage.str());
+	}
+
+	char magic[sizeof(checkpointMagic)];
+	uint32_t version=0,bom=0;
+	file.read(magic,sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version),sizeof(version));
+	file.read(reinterpret_cast<char*>(&bom),sizeof(bom));
+
+	if(file.fail() || std::memcmp(magic,checkpointMagic,sizeof(magic))!=0
+	   || version!=checkpointVersion || bom!=byteOrderMark)
+	{
+		std::stringstream errormessage;
+		errormessage<<"CheckpointReader: file "<<filename<<" is not a compatible checkpoint file";
+		throw std::runtime_error(errormessage.str());
+	}
+}
+
+/*****************************************************************************/
+void CheckpointReader::beginSection(const std::string& name)
+{
+	std::string storedName;
+	readString(storedName);
+	if(storedName!=name)
+	{
+		std::stringstream errormessage;
+		errormessage<<"CheckpointReader: expected section \""<<name<<"\" in file "
+			    <<filename<<", found \""<<storedName<<"\"";
+		throw std::runtime_error(errormessage.str());
+	}
+}
+
+/*****************************************************************************/
+void CheckpointReader::readString(std::string& str)
+{
+	uint64_t length;
+	read(length);
+	//sections names and comments are short, a large value means a corrupted file
+	if(length>(uint64_t(1)<<32))
+	{
+		std::stringstream errormessage;
+		errormessage<<"CheckpointReader: corrupted string in file "<<filename;
+		throw std::runtime_error(errormessage.str());
+	}
+	str.resize(length);
+	if(length>0) readBytes(&str[0],length);
+}
+
+/*****************************************************************************/
+void CheckpointReader::close()
+{
+	beginSection(endSection);
+	file.close();
+}
+
+/*****************************************************************************/
+void CheckpointReader::readBytes(void* data, uint64_t n)
+{
+	file.read(static_cast<char*>(data),std::streamsize(n));
+	if(file.fail())
+	{
+		std::stringstream errormessage;
+		errormessage<<"CheckpointReader: unexpected end of file "<<filename;
+		throw std::runtime_error(errormessage.str());
+	}
+}
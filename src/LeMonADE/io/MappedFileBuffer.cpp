@@ -0,0 +1,130 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#include <LeMonADE/io/MappedFileBuffer.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Implementation of MappedFileBuffer
+ * */
+/*****************************************************************************/
+
+/*****************************************************************************/
+//constructor and destructor
+MappedFileBuffer::MappedFileBuffer()
+  :data(0),length(0)
+{}
+
+MappedFileBuffer::~MappedFileBuffer()
+{
+	close();
+}
+
+/*****************************************************************************/
+/**
+ * @details The file is mapped read-only and the kernel is advised that it
+ * is read sequentially. Empty files cannot be mapped, in this case (and on
+ * any other error) false is returned and the caller should fall back to
+ * conventional file streams.
+ *
+ * @param filename Name of the file to be mapped
+ * @return True if the file was mapped successfully
+ */
+bool MappedFileBuffer::open(const std::string& filename)
+{
+	close();
+
+	int fd=::open(filename.c_str(),O_RDONLY);
+	if(fd<0) return false;
+
+	struct stat fileStatus;
+	if(fstat(fd,&fileStatus)!=0 || fileStatus.st_size<=0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	size_t fileLength=size_t(fileStatus.st_size);
+	void* mapping=mmap(0,fileLength,PROT_READ,MAP_PRIVATE,fd,0);
+	//the mapping stays valid after closing the file descriptor
+	::close(fd);
+	if(mapping==MAP_FAILED) return false;
+
+	madvise(mapping,fileLength,MADV_SEQUENTIAL);
+
+	data=static_cast<char*>(mapping);
+	length=fileLength;
+	setg(data,data,data+length);
+	return true;
+}
+
+/*****************************************************************************/
+void MappedFileBuffer::close()
+{
+	if(data!=0) munmap(data,length);
+	data=0;
+	length=0;
+	setg(0,0,0);
+}
+
+/*****************************************************************************/
+/**
+ * @details Only the get area can be positioned. Positions outside of the
+ * mapped file are rejected by returning an invalid position.
+ */
+MappedFileBuffer::pos_type MappedFileBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+	if(!(which & std::ios_base::in) || data==0) return pos_type(off_type(-1));
+
+	off_type base=0;
+	if(dir==std::ios_base::cur) base=off_type(gptr()-eback());
+	else if(dir==std::ios_base::end) base=off_type(length);
+
+	off_type newPosition=base+off;
+	if(newPosition<0 || newPosition>off_type(length)) return pos_type(off_type(-1));
+
+	setg(eback(),eback()+newPosition,egptr());
+	return pos_type(newPosition);
+}
+
+/*****************************************************************************/
+MappedFileBuffer::pos_type MappedFileBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+	return seekoff(off_type(pos),std::ios_base::beg,which);
+}
+
+/*****************************************************************************/
+std::streamsize MappedFileBuffer::showmanyc()
+{
+	return (gptr()<egptr())?std::streamsize(egptr()-gptr()):std::streamsize(-1);
+}
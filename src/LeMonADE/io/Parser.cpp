@@ -47,6 +47,11 @@ Parser::~Parser(){}
 //finds the next Read in the stream and returns the Readstring
 std::string Parser::findRead()
 {
+  //memory mapped input is scanned directly without copying lines
+  MappedFileBuffer* mappedBuffer=dynamic_cast<MappedFileBuffer*>(stream.rdbuf());
+  if(mappedBuffer!=0 && mappedBuffer->is_open())
+    return findReadMapped(*mappedBuffer);
+
 	std::string line, Read;
 	std::streampos linestart;
 
@@ -78,3 +83,45 @@ std::string Parser::findRead()
   //if still here, the end of the file has been reached
   return "endoffile";
 }
+
+/*****************************************************************************/
+/*****************************************************************************/
+//same as findRead, but scanning the mapped file in place
+std::string Parser::findReadMapped(MappedFileBuffer& buffer)
+{
+  while(!stream.eof() && !stream.fail()){
+    const char* lineStart=buffer.position();
+    if(lineStart==buffer.end()){
+      stream.setstate(std::ios_base::eofbit|std::ios_base::failbit);
+      break;
+    }
+    const char* lineEnd=MappedFileBuffer::findLineEnd(lineStart,buffer.end());
+
+    if(lineEnd-lineStart>1){
+      bool ReadFound=(lineStart[0]=='!' || (lineStart[0]=='#' && lineStart[1]=='!'));
+      if(ReadFound){
+	const char* assignment=static_cast<const char*>(std::memchr(lineStart,'=',lineEnd-lineStart));
+	//without = sign the Read ends at the first whitespace
+	if(assignment==0){
+	  const char* readEnd=lineStart;
+	  while(readEnd!=lineEnd && *readEnd!=' ' && !(*readEnd>='\t' && *readEnd<='\r')) ++readEnd;
+	  buffer.setPosition(readEnd);
+	  return std::string(lineStart,readEnd);
+	}
+	else{
+	  buffer.setPosition(assignment+1);
+	  return std::string(lineStart,assignment);
+	}
+      }
+    }
+
+    //skip this line
+    if(lineEnd==buffer.end()){
+      buffer.setPosition(lineEnd);
+      stream.setstate(std::ios_base::eofbit);
+    }
+    else buffer.setPosition(lineEnd+1);
+  }
+  //if still here, the end of the file has been reached
+  return "endoffile";
+}
@@ -0,0 +1,305 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#include <LeMonADE/utility/FastFourierTransform.h>
+#include <LeMonADE/utility/Threads.h>
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Implementation of the classes FastFourierTransform and RealFourierTransform3D
+ * */
+/*****************************************************************************/
+
+namespace
+{
+const double pi=3.14159265358979323846;
+
+//! exp(-2 pi i k / n)
+inline FastFourierTransform::complex_type unitRoot(size_t k, size_t n)
+{
+	return std::polar(1.0,-2.0*pi*double(k)/double(n));
+}
+
+/**
+ * @brief Transforms a range of lines of one direction in a separate thread
+ */
+class FourierTransformWorker: public Thread
+{
+public:
+	FourierTransformWorker(const RealFourierTransform3D& transform, int direction, size_t begin, size_t end,
+			       const double* in, RealFourierTransform3D::complex_type* out)
+	:transform(transform),direction(direction),begin(begin),end(end),in(in),out(out){}
+
+protected:
+	virtual void run(){transform.transformLines(direction,begin,end,in,out);}
+
+private:
+	const RealFourierTransform3D& transform;
+	int direction;
+	size_t begin;
+	size_t end;
+	const double* in;
+	RealFourierTransform3D::complex_type* out;
+};
+}
+
+/*****************************************************************************/
+FastFourierTransform::FastFourierTransform(size_t n)
+{
+	setup(n);
+}
+
+/**
+ * @param n length of the transform, must be positive
+ * @throw std::runtime_error if n is zero
+ */
+void FastFourierTransform::setup(size_t n)
+{
+	if(n==0)
+		throw std::runtime_error("FastFourierTransform::setup(): length must be positive");
+
+	length=n;
+	powerOfTwo=isPowerOfTwo(n);
+	paddedLength=1;
+	while(paddedLength<(powerOfTwo?n:2*n-1)) paddedLength*=2;
+
+	twiddles.resize(paddedLength/2);
+	for(size_t k=0;k<twiddles.size();k++) twiddles[k]=unitRoot(k,paddedLength);
+
+	size_t bits=0;
+	while((size_t(1)<<bits)<paddedLength) bits++;
+	bitReverse.resize(paddedLength);
+	for(size_t i=0;i<paddedLength;i++)
+	{
+		size_t reversed=0;
+		for(size_t b=0;b<bits;b++)
+			if(i&(size_t(1)<<b)) reversed|=size_t(1)<<(bits-1-b);
+		bitReverse[i]=reversed;
+	}
+
+	chirp.clear();
+	kernelTransform.clear();
+	if(powerOfTwo) return;
+
+	//k^2 is reduced modulo 2n to keep the argument of the exponential small
+	chirp.resize(n);
+	for(size_t k=0;k<n;k++)
+	{
+		uint64_t k2=(uint64_t(k)*uint64_t(k))%(2*uint64_t(n));
+		chirp[k]=std::polar(1.0,-pi*double(k2)/double(n));
+	}
+
+	kernelTransform.assign(paddedLength,complex_type(0.0,0.0));
+	kernelTransform[0]=std::conj(chirp[0]);
+	for(size_t k=1;k<n;k++)
+	{
+		kernelTransform[k]=std::conj(chirp[k]);
+		kernelTransform[paddedLength-k]=std::conj(chirp[k]);
+	}
+	radix2(&kernelTransform[0]);
+	for(size_t k=0;k<paddedLength;k++) kernelTransform[k]/=double(paddedLength);
+}
+
+/**
+ * @param data length values, replaced by their transform
+ * @param workspace getWorkspaceSize() values, not needed for powers of two
+ */
+void FastFourierTransform::forward(complex_type* data, complex_type* workspace) const
+{
+	if(powerOfTwo)
+	{
+		radix2(data);
+		return;
+	}
+
+	//Bluestein: X_k = chirp_k * sum_j (x_j chirp_j) conj(chirp_{k-j}), the sum is a cyclic convolution
+	for(size_t j=0;j<length;j++) workspace[j]=data[j]*chirp[j];
+	for(size_t j=length;j<paddedLength;j++) workspace[j]=complex_type(0.0,0.0);
+	radix2(workspace);
+	//inverse transform as conj(forward(conj(.)))
+	for(size_t j=0;j<paddedLength;j++) workspace[j]=std::conj(workspace[j]*kernelTransform[j]);
+	radix2(workspace);
+	for(size_t k=0;k<length;k++) data[k]=std::conj(workspace[k])*chirp[k];
+}
+
+void FastFourierTransform::radix2(complex_type* data) const
+{
+	const size_t n=paddedLength;
+	for(size_t i=0;i<n;i++)
+	{
+		size_t j=bitReverse[i];
+		if(i<j) std::swap(data[i],data[j]);
+	}
+
+	for(size_t len=2;len<=n;len*=2)
+	{
+		size_t half=len/2;
+		size_t step=n/len;
+		for(size_t i=0;i<n;i+=len)
+		{
+			for(size_t k=0;k<half;k++)
+			{
+				complex_type u=data[i+k];
+				complex_type v=data[i+k+half]*twiddles[k*step];
+				data[i+k]=u+v;
+				data[i+k+half]=u-v;
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+RealFourierTransform3D::RealFourierTransform3D()
+:nx(1),ny(1),nz(1),nThreads(1),halfLengthX(false)
+{
+}
+
+/**
+ * @param nx size of the real grid in x
+ * @param ny size of the grid in y
+ * @param nz size of the grid in z
+ * @param nThreads number of threads used in forward(), 0 means one per processor
+ *
+ * @throw std::runtime_error if a size is zero
+ */
+void RealFourierTransform3D::setup(size_t nx, size_t ny, size_t nz, unsigned int nThreads)
+{
+	if(nx==0 || ny==0 || nz==0)
+	{
+		std::stringstream errormessage;
+		errormessage<<"RealFourierTransform3D::setup(): invalid grid size "<<nx<<"x"<<ny<<"x"<<nz;
+		throw std::runtime_error(errormessage.str());
+	}
+
+	this->nx=nx;
+	this->ny=ny;
+	this->nz=nz;
+	this->nThreads=(nThreads==0)?Thread::hardwareConcurrency():nThreads;
+
+	halfLengthX=(nx%2==0);
+	fftX.setup(halfLengthX?nx/2:nx);
+	fftY.setup(ny);
+	fftZ.setup(nz);
+
+	twiddlesX.resize(nx/2+1);
+	for(size_t k=0;k<twiddlesX.size();k++) twiddlesX[k]=unitRoot(k,nx);
+}
+
+/**
+ * @param in real grid of nx*ny*nz values, x fastest
+ * @param out (nx/2+1)*ny*nz complex values, kx fastest
+ */
+void RealFourierTransform3D::forward(const double* in, complex_type* out) const
+{
+	const size_t hx=getComplexSizeX();
+	const size_t nLines[3]={ny*nz,hx*nz,hx*ny};
+
+	for(int direction=0;direction<3;direction++)
+	{
+		size_t nWorkers=std::min<size_t>(nThreads,nLines[direction]);
+		if(nWorkers<=1)
+		{
+			transformLines(direction,0,nLines[direction],in,out);
+			continue;
+		}
+
+		std::vector<FourierTransformWorker*> workers;
+		for(size_t n=0;n<nWorkers;n++)
+		{
+			size_t begin=nLines[direction]*n/nWorkers;
+			size_t end=nLines[direction]*(n+1)/nWorkers;
+			workers.push_back(new FourierTransformWorker(*this,direction,begin,end,in,out));
+			workers.back()->start();
+		}
+		for(size_t n=0;n<nWorkers;n++)
+		{
+			workers[n]->join();
+			delete workers[n];
+		}
+	}
+}
+
+/**
+ * @details The x-lines read from in and write to out, the y- and z-lines
+ * transform out in place.
+ */
+void RealFourierTransform3D::transformLines(int direction, size_t begin, size_t end, const double* in, complex_type* out) const
+{
+	const size_t hx=getComplexSizeX();
+	const FastFourierTransform& fft=(direction==0)?fftX:((direction==1)?fftY:fftZ);
+	std::vector<complex_type> line(fft.size());
+	std::vector<complex_type> workspace(fft.getWorkspaceSize()+1);
+
+	for(size_t l=begin;l<end;l++)
+	{
+		if(direction==0)
+		{
+			const double* row=in+l*nx;
+			complex_type* result=out+l*hx;
+			if(halfLengthX)
+			{
+				//even and odd values are transformed together as real and imaginary part
+				const size_t h=nx/2;
+				for(size_t j=0;j<h;j++) line[j]=complex_type(row[2*j],row[2*j+1]);
+				fft.forward(&line[0],&workspace[0]);
+				for(size_t k=0;k<=h;k++)
+				{
+					complex_type zk=line[k%h];
+					complex_type zc=std::conj(line[(h-k)%h]);
+					complex_type even=0.5*(zk+zc);
+					complex_type odd=complex_type(0.0,-0.5)*(zk-zc);
+					result[k]=even+twiddlesX[k]*odd;
+				}
+			}
+			else
+			{
+				for(size_t j=0;j<nx;j++) line[j]=complex_type(row[j],0.0);
+				fft.forward(&line[0],&workspace[0]);
+				for(size_t k=0;k<hx;k++) result[k]=line[k];
+			}
+		}
+		else
+		{
+			size_t kx=l%hx;
+			size_t other=l/hx;
+			//offset and stride of the line in the output array
+			size_t offset=(direction==1)?kx+hx*ny*other:kx+hx*other;
+			size_t stride=(direction==1)?hx:hx*ny;
+			for(size_t j=0;j<fft.size();j++) line[j]=out[offset+j*stride];
+			fft.forward(&line[0],&workspace[0]);
+			for(size_t j=0;j<fft.size();j++) out[offset+j*stride]=line[j];
+		}
+	}
+}
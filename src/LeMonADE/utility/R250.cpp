@@ -25,6 +25,8 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 --------------------------------------------------------------------------------*/
 
+#include <stdexcept>
+
 #include <LeMonADE/utility/R250.h>
 
 /**
@@ -109,6 +111,38 @@ void R250::setState( uint32_t const * stateArray )
 		refresh();
 }
 
+//in contrast to setState, the array is not shuffled here and also the
+//positions within the array are stored, such that the sequence of random
+//numbers continues identically after restoreFullState
+void R250::saveFullState( uint32_t * stateArray ) const
+{
+		for(size_t i=0;i<R250_RANDOM_PREFETCH;i++)
+		{
+			stateArray[i]=array[i];
+		}
+		stateArray[R250_RANDOM_PREFETCH]  =uint32_t(dice-array);
+		stateArray[R250_RANDOM_PREFETCH+1]=uint32_t(pos-array);
+		stateArray[R250_RANDOM_PREFETCH+2]=uint32_t(other147-array);
+		stateArray[R250_RANDOM_PREFETCH+3]=uint32_t(other250-array);
+}
+
+void R250::restoreFullState( uint32_t const * stateArray )
+{
+		for(size_t i=0;i<4;i++)
+		{
+			if(stateArray[R250_RANDOM_PREFETCH+i]>R250_RANDOM_PREFETCH)
+				throw std::runtime_error("R250::restoreFullState: invalid state");
+		}
+		for(size_t i=0;i<R250_RANDOM_PREFETCH;i++)
+		{
+			array[i]=stateArray[i];
+		}
+		dice    =array+stateArray[R250_RANDOM_PREFETCH];
+		pos     =array+stateArray[R250_RANDOM_PREFETCH+1];
+		other147=array+stateArray[R250_RANDOM_PREFETCH+2];
+		other250=array+stateArray[R250_RANDOM_PREFETCH+3];
+}
+
 /**
  * this resets the state array to a predefined value, so that a defined state
  * can always be obtained if needed. the numbers were generated from /dev/urandom
@@ -25,7 +25,16 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 --------------------------------------------------------------------------------*/
 
+#include <cxxabi.h>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <string>
+#include <typeinfo>
+#include <utility>
+
 #include <LeMonADE/utility/TaskManager.h>
+#include <LeMonADE/utility/Threads.h>
 
 /*****************************************************************************/
 /**
@@ -34,11 +43,173 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  * */
 /*****************************************************************************/
 
+/*****************************************************************************/
+/**
+ * @class TaskManager::AnalyzerPool
+ *
+ * @brief Worker threads executing thread safe analyzers
+ *
+ * @details Jobs are distinguished by the data they read: LIVE jobs read the
+ * current state of the system and must be finished before the updaters run
+ * again, SNAPSHOT jobs only read data copied by the analyzer before and may
+ * overlap with the updaters. Exceptions thrown in a worker are reported by
+ * the next call of wait().
+ **/
+/*****************************************************************************/
+class TaskManager::AnalyzerPool
+{
+public:
+  enum JobType{LIVE=0,SNAPSHOT=1};
+
+  explicit AnalyzerPool(unsigned int nThreads);
+  ~AnalyzerPool();
+
+  //! Queues the analyzer for execution in a worker thread
+  void submit(AnalyzerObject* analyzer, JobType type);
+
+  //! Waits until all jobs of the given type are finished
+  void wait(JobType type);
+
+private:
+  class Worker: public Thread
+  {
+  public:
+    explicit Worker(AnalyzerPool& p):pool(p){}
+  protected:
+    virtual void run(){pool.work();}
+  private:
+    AnalyzerPool& pool;
+  };
+
+  //! Loop of the worker threads
+  void work();
+
+  Mutex mutex;
+  Condition jobAvailable;
+  Condition jobFinished;
+  std::deque<std::pair<AnalyzerObject*,JobType> > jobs;
+  //! number of queued or running jobs of each type
+  size_t pending[2];
+  bool stopping;
+  bool failed;
+  std::string error;
+  std::vector<Worker*> workers;
+};
+
+TaskManager::AnalyzerPool::AnalyzerPool(unsigned int nThreads)
+  :stopping(false),failed(false)
+{
+  pending[LIVE]=0;
+  pending[SNAPSHOT]=0;
+  for(unsigned int n=0;n<nThreads;n++)
+  {
+    workers.push_back(new Worker(*this));
+    workers.back()->start();
+  }
+}
+
+/**
+ * @details Remaining jobs are finished before the workers are stopped.
+ **/
+TaskManager::AnalyzerPool::~AnalyzerPool()
+{
+  {
+    MutexLock lock(mutex);
+    stopping=true;
+    jobAvailable.broadcast();
+  }
+  for(size_t n=0;n<workers.size();n++)
+  {
+    workers[n]->join();
+    delete workers[n];
+  }
+}
+
+void TaskManager::AnalyzerPool::submit(AnalyzerObject* analyzer, JobType type)
+{
+  MutexLock lock(mutex);
+  jobs.push_back(std::make_pair(analyzer,type));
+  pending[type]++;
+  jobAvailable.signal();
+}
+
+/**
+ * @throw <std::runtime_error> if an analyzer executed by a worker threw an exception
+ **/
+void TaskManager::AnalyzerPool::wait(JobType type)
+{
+  MutexLock lock(mutex);
+  while(pending[type]>0) jobFinished.wait(mutex);
+
+  if(failed)
+  {
+    failed=false;
+    std::stringstream errormessage;
+    errormessage<<"TaskManager: analyzer executed in worker thread failed: "<<error;
+    throw std::runtime_error(errormessage.str());
+  }
+}
+
+void TaskManager::AnalyzerPool::work()
+{
+  while(true)
+  {
+    std::pair<AnalyzerObject*,JobType> job;
+    {
+      MutexLock lock(mutex);
+      while(jobs.empty() && !stopping) jobAvailable.wait(mutex);
+      if(jobs.empty()) return;
+      job=jobs.front();
+      jobs.pop_front();
+    }
+
+    std::string jobError;
+    bool jobFailed=false;
+    try
+    {
+      job.first->execute();
+    }
+    catch(std::exception& e)
+    {
+      jobFailed=true;
+      jobError=e.what();
+    }
+    catch(...)
+    {
+      jobFailed=true;
+      jobError="unknown exception";
+    }
+
+    MutexLock lock(mutex);
+    if(jobFailed && !failed)
+    {
+      failed=true;
+      error=jobError;
+    }
+    pending[job.second]--;
+    jobFinished.broadcast();
+  }
+}
+
+/*****************************************************************************/
 //constructor and destructor
-TaskManager::TaskManager():running(true),nCircles(0){}
+TaskManager::TaskManager()
+  :running(true)
+  ,nCircles(0)
+  ,nAnalyzerThreads(0)
+  ,analyzerPool(NULL)
+  ,runTime(0.0)
+  ,printStatisticsAtCleanup(true)
+  ,statisticsPeriod(0)
+  ,statisticsFormat(STATISTICS_CSV)
+{}
 
 TaskManager::~TaskManager()
 {
+    //finish analyzers still running in worker threads
+    delete analyzerPool;
+    analyzerPool=NULL;
+
     vector <UpdaterObject*>::iterator uIterator(updater.begin());
     vector <AnalyzerObject*>::iterator aIterator(analyzer.begin());
 
@@ -87,15 +258,13 @@ void TaskManager::addUpdater(AbstractUpdater* u, int period)
 void TaskManager::run()
 {
   vector <UpdaterObject*>::iterator uIterator;
-  vector <AnalyzerObject*>::iterator aIterator;
+  Timer timer;
 
   //if there are no updaters, execute all analyzers and return
   if(updater.size()==0){
-    aIterator=analyzer.begin();
-    while(aIterator!=analyzer.end() ){
-      if((*aIterator)->shouldExecute(nCircles)) (*aIterator)->run();
-      ++aIterator;
-    }
+    executeAnalyzers();
+    waitForAnalyzers();
+    runTime+=timer.elapsed();
     return;
   }
   //else run as long as there are updates coming in from updater objects
@@ -118,13 +287,12 @@ void TaskManager::run()
       if(!running) break;
 
       //call all analyzers
-      aIterator=analyzer.begin();
-      while(aIterator!=analyzer.end() ){
-	if((*aIterator)->shouldExecute(nCircles)) (*aIterator)->run();
-	++aIterator;
-      }
+      executeAnalyzers();
 
+      writeStatistics();
     }
+    waitForAnalyzers();
+    runTime+=timer.elapsed();
   }
 
 
@@ -142,7 +310,7 @@ void TaskManager::run(int nPeriods)
 {
 
   vector <UpdaterObject*>::iterator uIterator;
-  vector <AnalyzerObject*>::iterator aIterator;
+  Timer timer;
   int actualCircles=nCircles;
   while(nCircles<nPeriods+actualCircles){
     ++nCircles;
@@ -156,14 +324,84 @@ void TaskManager::run(int nPeriods)
     }
 
     //call all analyzers
+    executeAnalyzers();
+
+    writeStatistics();
+  }
+  waitForAnalyzers();
+  runTime+=timer.elapsed();
+}
+
+/*****************************************************************************/
+/**
+ * @details With nThreads>0, analyzers declaring themselves thread safe are
+ * executed concurrently by nThreads worker threads. All other analyzers are
+ * still executed by the thread calling run().
+ *
+ * @param nThreads number of worker threads, 0 for serial execution of all analyzers
+ **/
+void TaskManager::setAnalyzerThreads(unsigned int nThreads)
+{
+  if(nThreads==nAnalyzerThreads) return;
+
+  waitForAnalyzers();
+  delete analyzerPool;
+  analyzerPool=NULL;
+
+  nAnalyzerThreads=nThreads;
+  if(nAnalyzerThreads>0) analyzerPool=new AnalyzerPool(nAnalyzerThreads);
+}
+
+/*****************************************************************************/
+/**
+ * @details In parallel mode, analyzers from the previous cycle working on a
+ * snapshot are finished first. Then all due thread safe analyzers are passed
+ * to the worker threads (taking their snapshot before), while the remaining
+ * due analyzers are executed in this thread. Returns when all analyzers
+ * reading the current state of the system are finished, such that the
+ * updaters can safely continue.
+ **/
+void TaskManager::executeAnalyzers()
+{
+  vector <AnalyzerObject*>::iterator aIterator;
+
+  if(analyzerPool==NULL){
     aIterator=analyzer.begin();
     while(aIterator!=analyzer.end() ){
       if((*aIterator)->shouldExecute(nCircles)) (*aIterator)->run();
       ++aIterator;
     }
+    return;
+  }
 
+  analyzerPool->wait(AnalyzerPool::SNAPSHOT);
+
+  vector <AnalyzerObject*> serialAnalyzers;
+  aIterator=analyzer.begin();
+  while(aIterator!=analyzer.end() ){
+    if((*aIterator)->shouldExecute(nCircles)){
+      AbstractAnalyzer* current=(*aIterator)->getAnalyzer();
+      if(!current->isThreadSafe()) serialAnalyzers.push_back(*aIterator);
+      else if(current->needsSnapshot()){
+	(*aIterator)->takeSnapshot();
+	analyzerPool->submit(*aIterator,AnalyzerPool::SNAPSHOT);
+      }
+      else analyzerPool->submit(*aIterator,AnalyzerPool::LIVE);
+    }
+    ++aIterator;
   }
 
+  for(size_t n=0;n<serialAnalyzers.size();n++) serialAnalyzers[n]->run();
+
+  analyzerPool->wait(AnalyzerPool::LIVE);
+}
+
+/*****************************************************************************/
+void TaskManager::waitForAnalyzers()
+{
+  if(analyzerPool==NULL) return;
+  analyzerPool->wait(AnalyzerPool::LIVE);
+  analyzerPool->wait(AnalyzerPool::SNAPSHOT);
 }
 
 /*****************************************************************************/
@@ -197,6 +435,8 @@ void TaskManager::cleanup()
     vector <UpdaterObject*>::iterator uIterator;
     vector <AnalyzerObject*>::iterator aIterator;
 
+    waitForAnalyzers();
+
     uIterator=updater.begin();
     while(uIterator!=updater.end()){
       (*uIterator)->cleanup();
@@ -208,6 +448,181 @@ void TaskManager::cleanup()
       (*aIterator)->cleanup();
       ++aIterator;
     }
+
+    if(printStatisticsAtCleanup) printStatistics(std::cout);
+}
+
+namespace
+{
+  //! Readable class name of the object, demangled if possible
+  template<class T>
+  std::string taskName(const T& task)
+  {
+    const char* mangled=typeid(task).name();
+    int status=0;
+    char* demangled=abi::__cxa_demangle(mangled,NULL,NULL,&status);
+    std::string name((status==0 && demangled!=NULL)?demangled:mangled);
+    std::free(demangled);
+    return name;
+  }
+
+  //! Quotes a string for the CSV (quotes doubled) or JSON (backslash escapes) output
+  std::string quoted(const std::string& text, bool json)
+  {
+    std::string result("\"");
+    for(size_t n=0;n<text.size();n++)
+    {
+      if(text[n]=='"') result+=(json?'\\':'"');
+      else if(json && text[n]=='\\') result+='\\';
+      result+=text[n];
+    }
+    result+='"';
+    return result;
+  }
+}
+
+/*****************************************************************************/
+/**
+ * @details For every task the table lists the number of calls, the total
+ * wall time and its share of the time spent in run(), the time per call and
+ * for updaters the reported work: attempted moves per second, acceptance
+ * ratio and Monte Carlo steps per second.
+ *
+ * @param stream output stream for the table
+ **/
+void TaskManager::printStatistics(std::ostream& stream) const
+{
+  std::ios_base::fmtflags flags=stream.flags();
+  std::streamsize precision=stream.precision();
+
+  stream<<"TaskManager statistics after "<<nCircles<<" cycles, total run time "
+	<<std::fixed<<std::setprecision(3)<<runTime<<" s\n";
+  stream<<std::left<<std::setw(10)<<"task"<<std::right
+	<<std::setw(12)<<"calls"
+	<<std::setw(12)<<"time[s]"
+	<<std::setw(8)<<"share%"
+	<<std::setw(12)<<"ms/call"
+	<<std::setw(14)<<"moves/s"
+	<<std::setw(10)<<"accepted"
+	<<std::setw(12)<<"MCS/s"
+	<<"  name\n";
+
+  for(size_t n=0;n<updater.size();n++)
+  {
+    const UpdaterObject& task=*updater[n];
+    const AbstractUpdater& u=*task.getUpdater();
+    double time=task.getElapsedTime();
+    stream<<std::left<<std::setw(10)<<"updater"<<std::right
+	  <<std::setw(12)<<task.getNCalls()
+	  <<std::setw(12)<<std::setprecision(3)<<time
+	  <<std::setw(8)<<std::setprecision(1)<<(runTime>0.0?100.0*time/runTime:0.0)
+	  <<std::setw(12)<<std::setprecision(3)<<(task.getNCalls()>0?1000.0*time/double(task.getNCalls()):0.0);
+    if(u.getAttemptedMoves()>0 && time>0.0)
+      stream<<std::setw(14)<<std::scientific<<std::setprecision(3)<<double(u.getAttemptedMoves())/time
+	    <<std::setw(10)<<std::fixed<<std::setprecision(4)<<double(u.getAcceptedMoves())/double(u.getAttemptedMoves());
+    else
+      stream<<std::setw(14)<<"-"<<std::setw(10)<<"-";
+    if(u.getPerformedMcs()>0 && time>0.0)
+      stream<<std::setw(12)<<std::setprecision(1)<<double(u.getPerformedMcs())/time;
+    else
+      stream<<std::setw(12)<<"-";
+    stream<<"  "<<taskName(u)<<"\n";
+  }
+
+  for(size_t n=0;n<analyzer.size();n++)
+  {
+    const AnalyzerObject& task=*analyzer[n];
+    double time=task.getElapsedTime();
+    stream<<std::left<<std::setw(10)<<"analyzer"<<std::right
+	  <<std::setw(12)<<task.getNCalls()
+	  <<std::setw(12)<<std::setprecision(3)<<time
+	  <<std::setw(8)<<std::setprecision(1)<<(runTime>0.0?100.0*time/runTime:0.0)
+	  <<std::setw(12)<<std::setprecision(3)<<(task.getNCalls()>0?1000.0*time/double(task.getNCalls()):0.0)
+	  <<std::setw(14)<<"-"<<std::setw(10)<<"-"<<std::setw(12)<<"-"
+	  <<"  "<<taskName(*task.getAnalyzer())<<"\n";
+  }
+  stream<<std::flush;
+
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+/*****************************************************************************/
+/**
+ * @details The statistics are cumulative since the start, one line (CSV) or
+ * one JSON object (JSONL) is written per task and output. The columns are:
+ * cycle, type, index, name, period, calls, seconds, attempted_moves,
+ * accepted_moves and mcs. An existing file is replaced.
+ *
+ * @param filename name of the output file
+ * @param period output period in cycles, 0 disables the output
+ * @param format STATISTICS_CSV or STATISTICS_JSONL
+ * @throw <std::runtime_error> if the file cannot be opened
+ **/
+void TaskManager::setStatisticsOutput(const std::string& filename, int period, StatisticsFormat format)
+{
+  if(statisticsFile.is_open()) statisticsFile.close();
+  statisticsPeriod=0;
+  if(period<=0) return;
+
+  statisticsFile.open(filename.c_str());
+  if(!statisticsFile.is_open())
+  {
+    std::stringstream errormessage;
+    errormessage<<"TaskManager::setStatisticsOutput(): cannot open file "<<filename;
+    throw std::runtime_error(errormessage.str());
+  }
+  statisticsPeriod=period;
+  statisticsFormat=format;
+  statisticsFile<<std::setprecision(9);
+  if(statisticsFormat==STATISTICS_CSV)
+    statisticsFile<<"cycle,type,index,name,period,calls,seconds,attempted_moves,accepted_moves,mcs\n";
+}
+
+/*****************************************************************************/
+void TaskManager::writeStatistics()
+{
+  if(statisticsPeriod<=0 || nCircles%statisticsPeriod!=0) return;
+
+  //analyzers in worker threads modify their statistics
+  waitForAnalyzers();
+
+  for(size_t n=0;n<updater.size()+analyzer.size();n++)
+  {
+    bool isUpdater=(n<updater.size());
+    size_t index=isUpdater?n:n-updater.size();
+    std::string name;
+    unsigned int period;
+    uint64_t calls,attempted=0,accepted=0,mcs=0;
+    double seconds;
+    if(isUpdater){
+      const UpdaterObject& task=*updater[index];
+      name=taskName(*task.getUpdater());
+      period=task.getPeriod();
+      calls=task.getNCalls();
+      seconds=task.getElapsedTime();
+      attempted=task.getUpdater()->getAttemptedMoves();
+      accepted=task.getUpdater()->getAcceptedMoves();
+      mcs=task.getUpdater()->getPerformedMcs();
+    }
+    else{
+      const AnalyzerObject& task=*analyzer[index];
+      name=taskName(*task.getAnalyzer());
+      period=task.getPeriod();
+      calls=task.getNCalls();
+      seconds=task.getElapsedTime();
+    }
+
+    if(statisticsFormat==STATISTICS_CSV)
+      statisticsFile<<nCircles<<","<<(isUpdater?"updater":"analyzer")<<","<<index<<","<<quoted(name,false)<<","
+		    <<period<<","<<calls<<","<<seconds<<","<<attempted<<","<<accepted<<","<<mcs<<"\n";
+    else
+      statisticsFile<<"{\"cycle\":"<<nCircles<<",\"type\":\""<<(isUpdater?"updater":"analyzer")<<"\",\"index\":"<<index
+		    <<",\"name\":"<<quoted(name,true)<<",\"period\":"<<period<<",\"calls\":"<<calls
+		    <<",\"seconds\":"<<seconds<<",\"attempted_moves\":"<<attempted
+		    <<",\"accepted_moves\":"<<accepted<<",\"mcs\":"<<mcs<<"}\n";
+  }
+  statisticsFile.flush();
 }
 
 
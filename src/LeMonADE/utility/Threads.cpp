@@ -0,0 +1,130 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#include <LeMonADE/utility/Threads.h>
+
+#include <stdexcept>
+#include <unistd.h>
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Implementation of the thread wrappers
+ * */
+/*****************************************************************************/
+
+/*****************************************************************************/
+Mutex::Mutex()
+{
+	if(pthread_mutex_init(&mutex,0)!=0)
+		throw std::runtime_error("Mutex::Mutex(): could not initialize mutex");
+}
+
+Mutex::~Mutex()
+{
+	pthread_mutex_destroy(&mutex);
+}
+
+void Mutex::lock()
+{
+	pthread_mutex_lock(&mutex);
+}
+
+void Mutex::unlock()
+{
+	pthread_mutex_unlock(&mutex);
+}
+
+/*****************************************************************************/
+Condition::Condition()
+{
+	if(pthread_cond_init(&condition,0)!=0)
+		throw std::runtime_error("Condition::Condition(): could not initialize condition variable");
+}
+
+Condition::~Condition()
+{
+	pthread_cond_destroy(&condition);
+}
+
+void Condition::wait(Mutex& mutex)
+{
+	pthread_cond_wait(&condition,&mutex.mutex);
+}
+
+void Condition::signal()
+{
+	pthread_cond_signal(&condition);
+}
+
+void Condition::broadcast()
+{
+	pthread_cond_broadcast(&condition);
+}
+
+/*****************************************************************************/
+Thread::Thread():running(false)
+{}
+
+Thread::~Thread()
+{
+	//a thread must not outlive its object
+	if(running) join();
+}
+
+/**
+ * @throw <std::runtime_error> if the thread is already running or cannot be created
+ */
+void Thread::start()
+{
+	if(running)
+		throw std::runtime_error("Thread::start(): thread is already running");
+
+	if(pthread_create(&thread,0,&Thread::entry,this)!=0)
+		throw std::runtime_error("Thread::start(): could not create thread");
+
+	running=true;
+}
+
+void Thread::join()
+{
+	if(!running) return;
+	pthread_join(thread,0);
+	running=false;
+}
+
+unsigned int Thread::hardwareConcurrency()
+{
+	long n=sysconf(_SC_NPROCESSORS_ONLN);
+	return (n>0)?static_cast<unsigned int>(n):1;
+}
+
+void* Thread::entry(void* thread)
+{
+	static_cast<Thread*>(thread)->run();
+	return 0;
+}
@@ -0,0 +1,389 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+#include <LeMonADE/utility/TrackConnection.h>
+
+#include <algorithm>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Implementation of BondEventLogWriter and BondEventLogReader
+ * */
+/*****************************************************************************/
+
+namespace
+{
+	//! identifies the bond event log format
+	const char bondEventMagic[8]={'L','M','B','O','N','D','E','V'};
+	//! version of the bond event log format
+	const uint32_t bondEventVersion=1;
+	//! used to detect files written with a different byte order
+	const uint32_t byteOrderMark=0x01020304;
+	//! size of the header: magic, version, byte order mark and record size
+	const uint64_t headerSize=sizeof(bondEventMagic)+3*sizeof(uint32_t);
+
+	//! reads and checks the header, returns false if the file is no compatible log
+	bool readHeader(std::istream& stream)
+	{
+		char magic[sizeof(bondEventMagic)];
+		uint32_t version=0,bom=0,recordSize=0;
+		stream.read(magic,sizeof(magic));
+		stream.read(reinterpret_cast<char*>(&version),sizeof(version));
+		stream.read(reinterpret_cast<char*>(&bom),sizeof(bom));
+		stream.read(reinterpret_cast<char*>(&recordSize),sizeof(recordSize));
+		return !stream.fail() && std::memcmp(magic,bondEventMagic,sizeof(magic))==0
+		       && version==bondEventVersion && bom==byteOrderMark
+		       && recordSize==BondEvent::recordSize;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @param filename name of the log file
+ * @param bufferedEvents number of events collected before a block is written
+ * @param backgroundWriting write the blocks on a separate thread
+ * @param append add the events to an existing log instead of replacing it,
+ * a new log is created if the file does not exist. An incomplete last record,
+ * as left behind by a crashed run, is removed before appending.
+ * @throw std::runtime_error if the file cannot be opened or is no compatible log
+ */
+BondEventLogWriter::BondEventLogWriter(const std::string& filename_, uint32_t bufferedEvents_,
+				       bool backgroundWriting_, bool append)
+  :filename(filename_)
+  ,bufferedEvents(bufferedEvents_)
+  ,backgroundWriting(backgroundWriting_)
+  ,activeEvents(0)
+  ,pendingEvents(0)
+  ,writerThread(*this)
+  ,stopWriting(false)
+  ,writeError(false)
+  ,closed(false)
+  ,nEvents(0)
+{
+	if(bufferedEvents==0)
+		throw std::runtime_error("BondEventLogWriter: the buffer must hold at least one event");
+
+	bool writeHeader=true;
+	if(append)
+	{
+		std::ifstream existing(filename.c_str(),std::ios_base::in|std::ios_base::binary);
+		if(existing.is_open() && existing.peek()!=std::ifstream::traits_type::eof())
+		{
+			existing.seekg(0,std::ios_base::end);
+			uint64_t size=uint64_t(existing.tellg());
+			existing.seekg(0,std::ios_base::beg);
+
+			//a run killed while writing the header leaves no usable event, start a new log
+			if(size>=headerSize)
+			{
+				if(!readHeader(existing))
+				{
+					std::stringstream errormessage;
+					errormessage<<"BondEventLogWriter: cannot append to file "<<filename
+						    <<", it is not a bond event log";
+					throw std::runtime_error(errormessage.str());
+				}
+				existing.close();
+
+				//a run killed while writing leaves a partial record, which is dropped
+				uint64_t completeSize=headerSize+(size-headerSize)/BondEvent::recordSize*BondEvent::recordSize;
+				if(completeSize!=size && ::truncate(filename.c_str(),off_t(completeSize))!=0)
+				{
+					std::stringstream errormessage;
+					errormessage<<"BondEventLogWriter: cannot remove the incomplete last record of file "<<filename;
+					throw std::runtime_error(errormessage.str());
+				}
+				writeHeader=false;
+			}
+		}
+	}
+
+	file.open(filename.c_str(),std::ios_base::out|std::ios_base::binary|
+		  (writeHeader?std::ios_base::trunc:std::ios_base::app));
+	if(!file.is_open())
+	{
+		std::stringstream errormessage;
+		errormessage<<"BondEventLogWriter: cannot open file "<<filename<<" for writing";
+		throw std::runtime_error(errormessage.str());
+	}
+
+	if(writeHeader)
+	{
+		uint32_t recordSize=BondEvent::recordSize;
+		file.write(bondEventMagic,sizeof(bondEventMagic));
+		file.write(reinterpret_cast<const char*>(&bondEventVersion),sizeof(bondEventVersion));
+		file.write(reinterpret_cast<const char*>(&byteOrderMark),sizeof(byteOrderMark));
+		file.write(reinterpret_cast<const char*>(&recordSize),sizeof(recordSize));
+	}
+
+	activeBuffer.resize(uint64_t(bufferedEvents)*BondEvent::recordSize);
+	if(backgroundWriting)
+	{
+		pendingBuffer.resize(activeBuffer.size());
+		writerThread.start();
+	}
+}
+
+/*****************************************************************************/
+BondEventLogWriter::~BondEventLogWriter()
+{
+	try
+	{
+		close();
+	}
+	catch(std::exception&)
+	{
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @details With background writing this waits until the writer thread has
+ * written everything.
+ * @throw std::runtime_error on a write error
+ */
+void BondEventLogWriter::flush()
+{
+	flushBuffer();
+	if(backgroundWriting) waitForPendingBuffer();
+	file.flush();
+	if(file.fail() || writeError)
+	{
+		std::stringstream errormessage;
+		errormessage<<"BondEventLogWriter: error while writing file "<<filename;
+		throw std::runtime_error(errormessage.str());
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @throw std::runtime_error on a write error
+ */
+void BondEventLogWriter::close()
+{
+	if(closed) return;
+	closed=true;
+
+	bool flushed=true;
+	try
+	{
+		flushBuffer();
+	}
+	catch(std::runtime_error&)
+	{
+		flushed=false;
+	}
+
+	if(backgroundWriting)
+	{
+		mutex.lock();
+		stopWriting=true;
+		condition.broadcast();
+		mutex.unlock();
+		writerThread.join();
+	}
+	file.close();
+
+	if(!flushed || file.fail() || writeError)
+	{
+		std::stringstream errormessage;
+		errormessage<<"BondEventLogWriter: error while writing file "<<filename;
+		throw std::runtime_error(errormessage.str());
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @details With background writing the active buffer is swapped with the
+ * pending one, which requires that the writer thread has finished the previous
+ * block.
+ */
+void BondEventLogWriter::flushBuffer()
+{
+	if(activeEvents==0) return;
+
+	uint64_t nBytes=uint64_t(activeEvents)*BondEvent::recordSize;
+	if(!backgroundWriting)
+	{
+		activeEvents=0;
+		if(!writeBlock(&activeBuffer[0],nBytes))
+		{
+			std::stringstream errormessage;
+			errormessage<<"BondEventLogWriter: error while writing file "<<filename;
+			throw std::runtime_error(errormessage.str());
+		}
+		return;
+	}
+
+	MutexLock lock(mutex);
+	while(pendingEvents>0 && !writeError) condition.wait(mutex);
+	if(writeError)
+	{
+		std::stringstream errormessage;
+		errormessage<<"BondEventLogWriter: error while writing file "<<filename;
+		throw std::runtime_error(errormessage.str());
+	}
+	activeBuffer.swap(pendingBuffer);
+	pendingEvents=activeEvents;
+	activeEvents=0;
+	condition.broadcast();
+}
+
+/*****************************************************************************/
+void BondEventLogWriter::waitForPendingBuffer()
+{
+	MutexLock lock(mutex);
+	while(pendingEvents>0 && !writeError) condition.wait(mutex);
+}
+
+/*****************************************************************************/
+bool BondEventLogWriter::writeBlock(const char* data, uint64_t nBytes)
+{
+	file.write(data,std::streamsize(nBytes));
+	return !file.fail();
+}
+
+/*****************************************************************************/
+/**
+ * @details Waits for pending blocks and writes them without holding the
+ * mutex, until close() sets stopWriting and nothing is pending any more.
+ */
+void BondEventLogWriter::writeLoop()
+{
+	mutex.lock();
+	while(true)
+	{
+		while(pendingEvents==0 && !stopWriting) condition.wait(mutex);
+		if(pendingEvents==0) break;
+
+		uint64_t nBytes=uint64_t(pendingEvents)*BondEvent::recordSize;
+		mutex.unlock();
+		bool success=writeBlock(&pendingBuffer[0],nBytes);
+		mutex.lock();
+
+		if(!success) writeError=true;
+		pendingEvents=0;
+		condition.broadcast();
+	}
+	mutex.unlock();
+}
+
+/*****************************************************************************/
+/**
+ * @param filename name of the log file
+ * @param bufferedEvents number of records read at once
+ * @throw std::runtime_error if the file cannot be opened or is no compatible log
+ */
+BondEventLogReader::BondEventLogReader(const std::string& filename_, uint32_t bufferedEvents_)
+  :filename(filename_)
+  ,nEvents(0)
+  ,position(0)
+  ,bufferedEvents(std::max(bufferedEvents_,uint32_t(1)))
+  ,bufferBegin(0)
+  ,bufferEnd(0)
+{
+	file.open(filename.c_str(),std::ios_base::in|std::ios_base::binary);
+	if(!file.is_open())
+	{
+		std::stringstream errormessage;
+		errormessage<<"BondEventLogReader: cannot open file "<<filename;
+		throw std::runtime_error(errormessage.str());
+	}
+	if(!readHeader(file))
+	{
+		std::stringstream errormessage;
+		errormessage<<"BondEventLogReader: file "<<filename<<" is not a compatible bond event log";
+		throw std::runtime_error(errormessage.str());
+	}
+
+	//an incomplete last record of an unfinished log is ignored
+	file.seekg(0,std::ios_base::end);
+	nEvents=(uint64_t(file.tellg())-headerSize)/BondEvent::recordSize;
+	buffer.resize(uint64_t(bufferedEvents)*BondEvent::recordSize);
+}
+
+/*****************************************************************************/
+/**
+ * @throw std::runtime_error if k is not smaller than getNumEvents()
+ */
+BondEvent BondEventLogReader::getEvent(uint64_t k)
+{
+	if(k>=nEvents)
+	{
+		std::stringstream errormessage;
+		errormessage<<"BondEventLogReader::getEvent(): event "<<k<<" does not exist, the log "
+			    <<filename<<" contains "<<nEvents<<" events";
+		throw std::runtime_error(errormessage.str());
+	}
+	if(k<bufferBegin || k>=bufferEnd) loadBlock(k);
+
+	const char* record=&buffer[(k-bufferBegin)*BondEvent::recordSize];
+	BondEvent event;
+	std::memcpy(&event.mcs,record,8);
+	std::memcpy(&event.id1,record+8,4);
+	std::memcpy(&event.id2,record+12,4);
+	std::memcpy(&event.type,record+16,4);
+	return event;
+}
+
+/*****************************************************************************/
+bool BondEventLogReader::readEvent(BondEvent& event)
+{
+	if(position>=nEvents) return false;
+	event=getEvent(position++);
+	return true;
+}
+
+/*****************************************************************************/
+/**
+ * @details Moving backward, the block ends with record k, otherwise it starts
+ * with record k, such that sequential access in both directions reads every
+ * record only once.
+ */
+void BondEventLogReader::loadBlock(uint64_t k)
+{
+	if(k<bufferBegin)
+		bufferBegin=(k+1>bufferedEvents)?(k+1-bufferedEvents):0;
+	else
+		bufferBegin=k;
+	bufferEnd=std::min(bufferBegin+bufferedEvents,nEvents);
+
+	file.clear();
+	file.seekg(std::streamoff(headerSize+bufferBegin*BondEvent::recordSize),std::ios_base::beg);
+	file.read(&buffer[0],std::streamsize((bufferEnd-bufferBegin)*BondEvent::recordSize));
+	if(file.fail())
+	{
+		bufferBegin=bufferEnd=0;
+		std::stringstream errormessage;
+		errormessage<<"BondEventLogReader: error while reading file "<<filename;
+		throw std::runtime_error(errormessage.str());
+	}
+}
@@ -0,0 +1,150 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class AnalyzerMeanSquareDisplacement
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <LeMonADE/core/ConfigureSystem.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureAttributes.h>
+#include <LeMonADE/analyzer/AnalyzerMeanSquareDisplacement.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+using namespace std;
+
+class AnalyzerMeanSquareDisplacementTest: public ::testing::Test{
+protected:
+	typedef LOKI_TYPELIST_1(FeatureAttributes<>) Features;
+	typedef ConfigureSystem<VectorInt3,Features> Config;
+	typedef Ingredients < Config> MyIngredients;
+	MyIngredients ingredients;
+
+	/**
+	 * two dimers: the first one moves as a whole in +x, the monomers of the
+	 * second one move apart in x with a fixed center of mass
+	 */
+	void setupDimers()
+	{
+		ingredients.modifyMolecules().resize(4);
+		ingredients.modifyMolecules()[0].setAllCoordinates(0,0,0);
+		ingredients.modifyMolecules()[1].setAllCoordinates(2,0,0);
+		ingredients.modifyMolecules()[2].setAllCoordinates(10,0,0);
+		ingredients.modifyMolecules()[3].setAllCoordinates(12,0,0);
+		ingredients.modifyMolecules().connect(0,1);
+		ingredients.modifyMolecules().connect(2,3);
+	}
+
+	void moveDimers(uint64_t frame)
+	{
+		int32_t step=int32_t(frame);
+		ingredients.modifyMolecules()[0].setAllCoordinates(step,0,0);
+		ingredients.modifyMolecules()[1].setAllCoordinates(2+step,0,0);
+		ingredients.modifyMolecules()[2].setAllCoordinates(10-step,0,0);
+		ingredients.modifyMolecules()[3].setAllCoordinates(12+step,0,0);
+	}
+
+	/* suppress cout output for better readability -->un/comment here:*/
+	public:
+		//redirect cout output
+		virtual void SetUp(){
+			originalBuffer=cout.rdbuf();
+			cout.rdbuf(tempStream.rdbuf());
+		};
+		//restore original output
+		virtual void TearDown(){
+			cout.rdbuf(originalBuffer);
+		};
+
+private:
+	std::streambuf* originalBuffer;
+	std::ostringstream tempStream;
+	/* ** */
+};
+
+TEST_F(AnalyzerMeanSquareDisplacementTest, BallisticDimers)
+{
+	setupDimers();
+	AnalyzerMeanSquareDisplacement<MyIngredients> analyzer(ingredients,"MSDTest.dat",8,2);
+	analyzer.initialize();
+
+	const uint64_t nFrames=200, interval=10;
+	for(uint64_t n=0;n<nFrames;n++)
+	{
+		moveDimers(n);
+		ingredients.modifyMolecules().setAge(n*interval);
+		analyzer.takeSnapshot();
+		analyzer.execute();
+	}
+
+	std::vector<std::vector<double> > results=analyzer.getResults();
+	ASSERT_EQ(results.size(),size_t(5));
+	ASSERT_GT(results[0].size(),size_t(10));
+	for(size_t n=0;n<results[0].size();n++)
+	{
+		double lag=results[0][n]/double(interval);
+		//all monomers move by lag
+		EXPECT_DOUBLE_EQ(results[1][n],lag*lag);
+		//only the monomers of the second dimer move relative to its center
+		EXPECT_DOUBLE_EQ(results[2][n],0.5*lag*lag);
+		//only the center of the first dimer moves
+		EXPECT_DOUBLE_EQ(results[3][n],0.5*lag*lag);
+		EXPECT_GT(results[4][n],0.0);
+	}
+
+	analyzer.cleanup();
+	std::ifstream file("MSDTest.dat");
+	EXPECT_TRUE(file.is_open());
+	file.close();
+	remove("MSDTest.dat");
+}
+
+TEST_F(AnalyzerMeanSquareDisplacementTest, IrregularInterval)
+{
+	setupDimers();
+	AnalyzerMeanSquareDisplacement<MyIngredients> analyzer(ingredients,"MSDTest.dat");
+	analyzer.initialize();
+
+	ingredients.modifyMolecules().setAge(0);
+	analyzer.takeSnapshot();
+	EXPECT_NO_THROW(analyzer.execute());
+	ingredients.modifyMolecules().setAge(10);
+	analyzer.takeSnapshot();
+	EXPECT_NO_THROW(analyzer.execute());
+	ingredients.modifyMolecules().setAge(25);
+	analyzer.takeSnapshot();
+	EXPECT_THROW(analyzer.execute(),std::runtime_error);
+}
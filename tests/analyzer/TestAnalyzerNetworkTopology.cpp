@@ -0,0 +1,127 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class AnalyzerNetworkTopology
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/analyzer/AnalyzerNetworkTopology.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
+
+class AnalyzerNetworkTopologyTest: public ::testing::Test{
+public:
+  typedef LOKI_TYPELIST_1(FeatureMoleculesIO) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> IngredientsType;
+
+  IngredientsType ingredients;
+
+  //! reads the data lines of a result file
+  std::vector<std::vector<double> > readResultFile(const std::string& filename)
+  {
+    std::vector<std::vector<double> > lines;
+    std::ifstream file(filename.c_str());
+    std::string line;
+    while(std::getline(file,line))
+    {
+      if(line.empty() || line[0]=='#') continue;
+      std::stringstream stream(line);
+      std::vector<double> values;
+      double value;
+      while(stream>>value) values.push_back(value);
+      lines.push_back(values);
+    }
+    return lines;
+  }
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=std::cout.rdbuf();
+    std::cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    std::cout.rdbuf(originalBuffer);
+  };
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+TEST_F(AnalyzerNetworkTopologyTest, TimeSeries)
+{
+  //two junctions connected by three strands of two monomers, only the bonds matter
+  ingredients.modifyMolecules().addMonomer(0,0,0);
+  ingredients.modifyMolecules().addMonomer(6,0,0);
+  for(int32_t y=0;y<6;y+=2)
+  {
+    uint32_t first=ingredients.getMolecules().size();
+    ingredients.modifyMolecules().addMonomer(2,y,0);
+    ingredients.modifyMolecules().addMonomer(4,y,0);
+    ingredients.modifyMolecules().connect(0,first);
+    ingredients.modifyMolecules().connect(first,first+1);
+    ingredients.modifyMolecules().connect(first+1,1);
+  }
+
+  AnalyzerNetworkTopology<IngredientsType> analyzer(ingredients,"NetworkTopologyTest.dat");
+  analyzer.initialize();
+  analyzer.execute();
+  EXPECT_EQ(2u,analyzer.getTopology().getNumberOfActiveJunctions());
+
+  //cut one strand
+  ingredients.modifyMolecules().disconnect(2,3);
+  ingredients.modifyMolecules().setAge(100);
+  analyzer.execute();
+  EXPECT_EQ(0u,analyzer.getTopology().getNumberOfActiveJunctions());
+  analyzer.cleanup();
+
+  std::vector<std::vector<double> > results=readResultFile("NetworkTopologyTest.dat");
+  ASSERT_EQ(2u,results.size());
+  ASSERT_EQ(12u,results[0].size());
+  //mcs junctions strands danglingMonomers firstOrderLoops secondOrderLoops freeRings activeJunctions activeStrands activeMonomers cycleRank activeCycleRank
+  const double first[12]={0,2,3,0,0,3,0,2,3,8,2,2};
+  const double second[12]={100,0,0,2,0,0,1,0,0,0,1,0};
+  for(size_t n=0;n<12;n++)
+  {
+    EXPECT_DOUBLE_EQ(first[n],results[0][n]);
+    EXPECT_DOUBLE_EQ(second[n],results[1][n]);
+  }
+  remove("NetworkTopologyTest.dat");
+}
@@ -0,0 +1,172 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class AnalyzerRadialDistribution
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <LeMonADE/core/ConfigureSystem.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureBox.h>
+#include <LeMonADE/analyzer/AnalyzerRadialDistribution.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+using namespace std;
+
+class AnalyzerRadialDistributionTest: public ::testing::Test{
+protected:
+	typedef LOKI_TYPELIST_1(FeatureBox) Features;
+	typedef ConfigureSystem<VectorInt3,Features> Config;
+	typedef Ingredients < Config> MyIngredients;
+	MyIngredients ingredients;
+
+	void setupBox(int32_t box)
+	{
+		ingredients.setBoxX(box);
+		ingredients.setBoxY(box);
+		ingredients.setBoxZ(box);
+		ingredients.setPeriodicX(true);
+		ingredients.setPeriodicY(true);
+		ingredients.setPeriodicZ(true);
+	}
+
+	/* suppress cout output for better readability -->un/comment here:*/
+	public:
+		//redirect cout output
+		virtual void SetUp(){
+			originalBuffer=cout.rdbuf();
+			cout.rdbuf(tempStream.rdbuf());
+		};
+		//restore original output
+		virtual void TearDown(){
+			cout.rdbuf(originalBuffer);
+		};
+
+private:
+	std::streambuf* originalBuffer;
+	std::ostringstream tempStream;
+	/* ** */
+};
+
+TEST_F(AnalyzerRadialDistributionTest, FilledLattice)
+{
+	//every lattice site occupied: g(r)=N/(N-1) in every bin
+	setupBox(8);
+	for(int32_t x=0;x<8;x++)
+		for(int32_t y=0;y<8;y++)
+			for(int32_t z=0;z<8;z++)
+				ingredients.modifyMolecules().addMonomer(x,y,z);
+
+	AnalyzerRadialDistribution<MyIngredients> analyzer(ingredients,"RadialDistributionTest.dat","ContactsTest.dat",4.0,0.5,1.2,2);
+	analyzer.initialize();
+	for(size_t frame=0;frame<2;frame++)
+	{
+		analyzer.takeSnapshot();
+		analyzer.execute();
+	}
+
+	//columns r, g, g_intra, g_inter
+	std::vector<std::vector<double> > results=analyzer.getResults();
+	ASSERT_EQ(results.size(),size_t(4));
+	ASSERT_GT(results[0].size(),size_t(4));
+	for(size_t n=0;n<results[0].size();n++)
+	{
+		EXPECT_NEAR(results[1][n],512.0/511.0,1e-10);
+		EXPECT_DOUBLE_EQ(results[2][n],0.0);
+		EXPECT_DOUBLE_EQ(results[3][n],results[1][n]);
+		EXPECT_LT(results[0][n],4.0);
+	}
+
+	//six neighbors at distance 1, all unbonded in other molecules
+	const std::vector<std::vector<double> >& contacts=analyzer.getContacts();
+	ASSERT_EQ(contacts[0].size(),size_t(2));
+	EXPECT_DOUBLE_EQ(contacts[1][0],0.0);
+	EXPECT_DOUBLE_EQ(contacts[2][0],6.0);
+
+	analyzer.cleanup();
+	std::ifstream file("RadialDistributionTest.dat");
+	EXPECT_TRUE(file.is_open());
+	file.close();
+	std::ifstream contactFile("ContactsTest.dat");
+	EXPECT_TRUE(contactFile.is_open());
+	contactFile.close();
+	remove("RadialDistributionTest.dat");
+	remove("ContactsTest.dat");
+}
+
+TEST_F(AnalyzerRadialDistributionTest, Contacts)
+{
+	setupBox(16);
+	//a chain of four monomers bent into a square across the periodic boundary
+	ingredients.modifyMolecules().addMonomer(0,0,0);
+	ingredients.modifyMolecules().addMonomer(-2,0,0);
+	ingredients.modifyMolecules().addMonomer(-2,2,0);
+	ingredients.modifyMolecules().addMonomer(0,2,0);
+	ingredients.modifyMolecules().connect(0,1);
+	ingredients.modifyMolecules().connect(1,2);
+	ingredients.modifyMolecules().connect(2,3);
+	//a single monomer in contact with the first one
+	ingredients.modifyMolecules().addMonomer(0,0,18);
+	ingredients.modifyMolecules().setAge(100);
+
+	AnalyzerRadialDistribution<MyIngredients> analyzer(ingredients,"RadialDistributionTest.dat","ContactsTest.dat",6.0,1.0);
+	analyzer.initialize();
+	analyzer.takeSnapshot();
+	analyzer.execute();
+
+	//the pair 0-3 is an intra contact, 0-4 an inter contact, each counts for two monomers
+	const std::vector<std::vector<double> >& contacts=analyzer.getContacts();
+	ASSERT_EQ(contacts[0].size(),size_t(1));
+	EXPECT_DOUBLE_EQ(contacts[0][0],100.0);
+	EXPECT_DOUBLE_EQ(contacts[1][0],0.4);
+	EXPECT_DOUBLE_EQ(contacts[2][0],0.4);
+
+	//bin [2,3): intra pairs are the three bonds, 0-3, 0-2 and 1-3,
+	//inter pairs are 0-4, 1-4 and 3-4
+	std::vector<std::vector<double> > results=analyzer.getResults();
+	double ideal=0.5*5.0*4.0/(16.0*16.0*16.0);
+	for(size_t n=0;n<results[0].size();n++)
+	{
+		EXPECT_NEAR(results[1][n],results[2][n]+results[3][n],1e-10);
+		if(results[0][n]==2.5)
+		{
+			//lattice vectors with 2<=r<3: 6 of length 2, 24 of sqrt(5), 24 of sqrt(6), 12 of sqrt(8)
+			double norm=1.0/(ideal*66.0);
+			EXPECT_NEAR(results[2][n],6.0*norm,1e-10);
+			EXPECT_NEAR(results[3][n],3.0*norm,1e-10);
+		}
+	}
+}
@@ -43,7 +43,10 @@
 #include <LeMonADE/core/Molecules.h>
 #include <LeMonADE/core/Ingredients.h>
 #include <LeMonADE/feature/FeatureAttributes.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
 #include <LeMonADE/analyzer/AnalyzerRadiusOfGyration.h>
+#include <LeMonADE/analyzer/MapReduceAnalysisDriver.h>
+#include <LeMonADE/io/FileImport.h>
 #include <LeMonADE/utility/Vector3D.h>
 
 
@@ -346,3 +349,57 @@ TEST_F(AnalyzerRadiusOfGyrationTest, CheckGroups)
 	EXPECT_EQ(value,4.0);
 
 }
+
+/*****************************************************************************/
+/**
+ * @fn TEST_F(AnalyzerRadiusOfGyrationTest, MapReduce)
+ * @brief Evaluating a file with the MapReduceAnalysisDriver must give the same
+ * output as evaluating it sequentially frame by frame
+ * */
+/*****************************************************************************/
+TEST_F(AnalyzerRadiusOfGyrationTest, MapReduce)
+{
+	typedef LOKI_TYPELIST_1(FeatureMoleculesIO) FeaturesIO;
+	typedef ConfigureSystem<VectorInt3,FeaturesIO,5> ConfigIO;
+	typedef Ingredients<ConfigIO> IngredientsIO;
+
+	std::string inputFile("tests/fileImportTest3.test");
+
+	IngredientsIO sequentialIngredients;
+	FileImport<IngredientsIO> file(inputFile,sequentialIngredients);
+	file.initialize();
+	AnalyzerRadiusOfGyration<IngredientsIO> sequentialAnalyzer(sequentialIngredients,"Rg2Sequential.dat");
+	sequentialAnalyzer.setBufferSize(50);
+	file.read();
+	sequentialIngredients.synchronize();
+	sequentialAnalyzer.initialize();
+	sequentialAnalyzer.execute();
+	while(file.read())
+		sequentialAnalyzer.execute();
+	sequentialAnalyzer.cleanup();
+
+	IngredientsIO parallelIngredients;
+	MapReduceAnalysisDriver<IngredientsIO> driver(inputFile,parallelIngredients,3,7);
+	AnalyzerRadiusOfGyration<IngredientsIO>* parallelAnalyzer=new AnalyzerRadiusOfGyration<IngredientsIO>(parallelIngredients,"Rg2Parallel.dat");
+	parallelAnalyzer->setBufferSize(50);
+	driver.addAnalyzer(parallelAnalyzer);
+	driver.run();
+
+	EXPECT_EQ(fileNLines("Rg2Sequential.dat"),1001u);
+
+	std::ifstream sequentialOutput("Rg2Sequential.dat");
+	std::ifstream parallelOutput("Rg2Parallel.dat");
+	std::string sequentialLine,parallelLine;
+	uint32_t nLines=0;
+	while(std::getline(sequentialOutput,sequentialLine))
+	{
+		ASSERT_TRUE(bool(std::getline(parallelOutput,parallelLine)));
+		EXPECT_EQ(sequentialLine,parallelLine);
+		nLines++;
+	}
+	EXPECT_FALSE(bool(std::getline(parallelOutput,parallelLine)));
+	EXPECT_GT(nLines,1001u);
+
+	remove("Rg2Sequential.dat");
+	remove("Rg2Parallel.dat");
+}
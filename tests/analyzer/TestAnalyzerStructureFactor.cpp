@@ -0,0 +1,191 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class AnalyzerStructureFactor
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include <LeMonADE/core/ConfigureSystem.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureAttributes.h>
+#include <LeMonADE/feature/FeatureBox.h>
+#include <LeMonADE/analyzer/AnalyzerStructureFactor.h>
+#include <LeMonADE/utility/R250.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+using namespace std;
+
+class AnalyzerStructureFactorTest: public ::testing::Test{
+protected:
+	typedef LOKI_TYPELIST_2(FeatureBox,FeatureAttributes<>) Features;
+	typedef ConfigureSystem<VectorInt3,Features> Config;
+	typedef Ingredients < Config> MyIngredients;
+	MyIngredients ingredients;
+
+	void setupBox(int32_t box)
+	{
+		ingredients.setBoxX(box);
+		ingredients.setBoxY(box);
+		ingredients.setBoxZ(box);
+		ingredients.setPeriodicX(true);
+		ingredients.setPeriodicY(true);
+		ingredients.setPeriodicZ(true);
+	}
+
+	void addMonomer(int32_t x, int32_t y, int32_t z, int32_t tag)
+	{
+		ingredients.modifyMolecules().addMonomer(x,y,z);
+		ingredients.modifyMolecules()[ingredients.getMolecules().size()-1].setAttributeTag(tag);
+	}
+
+	/* suppress cout output for better readability -->un/comment here:*/
+	public:
+		//redirect cout output
+		virtual void SetUp(){
+			originalBuffer=cout.rdbuf();
+			cout.rdbuf(tempStream.rdbuf());
+		};
+		//restore original output
+		virtual void TearDown(){
+			cout.rdbuf(originalBuffer);
+		};
+
+private:
+	std::streambuf* originalBuffer;
+	std::ostringstream tempStream;
+	/* ** */
+};
+
+TEST_F(AnalyzerStructureFactorTest, SingleMonomer)
+{
+	setupBox(8);
+	addMonomer(3,-2,17,1);
+
+	AnalyzerStructureFactor<MyIngredients> analyzer(ingredients,"StructureFactorTest.dat");
+	analyzer.initialize();
+	ASSERT_EQ(analyzer.getTags().size(),size_t(1));
+	analyzer.takeSnapshot();
+	analyzer.execute();
+
+	//columns q, S, S_1_1, nModes
+	std::vector<std::vector<double> > results=analyzer.getResults();
+	ASSERT_EQ(results.size(),size_t(4));
+	ASSERT_GT(results[0].size(),size_t(3));
+	double nModes=0.0;
+	for(size_t n=0;n<results[0].size();n++)
+	{
+		EXPECT_NEAR(results[1][n],1.0,1e-10);
+		EXPECT_NEAR(results[2][n],1.0,1e-10);
+		if(n>0)
+		{
+			EXPECT_LT(results[0][n-1],results[0][n]);
+		}
+		nModes+=results[3][n];
+	}
+	//all modes except q=0
+	EXPECT_DOUBLE_EQ(nModes,8.0*8.0*8.0-1.0);
+
+	analyzer.cleanup();
+	std::ifstream file("StructureFactorTest.dat");
+	EXPECT_TRUE(file.is_open());
+	file.close();
+	remove("StructureFactorTest.dat");
+}
+
+TEST_F(AnalyzerStructureFactorTest, PartialStructureFactors)
+{
+	setupBox(6);
+	R250 rng;
+	for(size_t n=0;n<40;n++)
+		addMonomer(int32_t(rng.r250_rand()%24)-12,int32_t(rng.r250_rand()%6),int32_t(rng.r250_rand()%6),1+int32_t(n%3==0));
+	//this tag is not analyzed
+	addMonomer(0,0,0,5);
+
+	std::vector<int32_t> tags;
+	tags.push_back(1);
+	tags.push_back(2);
+	AnalyzerStructureFactor<MyIngredients> analyzer(ingredients,"StructureFactorTest.dat",2);
+	analyzer.setTags(tags);
+	analyzer.initialize();
+	for(size_t frame=0;frame<2;frame++)
+	{
+		analyzer.takeSnapshot();
+		analyzer.execute();
+	}
+
+	//columns q, S, S_1_1, S_1_2, S_2_2, nModes
+	std::vector<std::vector<double> > results=analyzer.getResults();
+	ASSERT_EQ(results.size(),size_t(6));
+
+	//density on the grid, Parseval: sum_q |rho(q)|^2 = V sum_r rho(r)^2
+	std::vector<double> density(6*6*6,0.0);
+	for(size_t n=0;n<40;n++)
+	{
+		VectorInt3 pos=ingredients.getMolecules()[n];
+		density[((pos[0]%6)+6)%6+6*(pos[1]+6*pos[2])]+=1.0;
+	}
+	double sumSquares=0.0;
+	for(size_t n=0;n<density.size();n++) sumSquares+=density[n]*density[n];
+
+	double sumS=0.0;
+	for(size_t n=0;n<results[0].size();n++)
+	{
+		EXPECT_NEAR(results[1][n],results[2][n]+2.0*results[3][n]+results[4][n],1e-10);
+		sumS+=results[1][n]*results[5][n];
+	}
+	EXPECT_NEAR(sumS,(216.0*sumSquares-40.0*40.0)/40.0,1e-8);
+}
+
+TEST_F(AnalyzerStructureFactorTest, GridSpacing)
+{
+	setupBox(8);
+	addMonomer(0,0,0,1);
+
+	AnalyzerStructureFactor<MyIngredients> analyzer(ingredients,"StructureFactorTest.dat",1,3);
+	EXPECT_THROW(analyzer.initialize(),std::runtime_error);
+
+	//coarser grid: fewer modes, q up to pi/2 per direction
+	AnalyzerStructureFactor<MyIngredients> coarse(ingredients,"StructureFactorTest.dat",1,2);
+	coarse.initialize();
+	coarse.takeSnapshot();
+	coarse.execute();
+	std::vector<std::vector<double> > results=coarse.getResults();
+	double nModes=0.0;
+	for(size_t n=0;n<results[0].size();n++) nModes+=results[3][n];
+	EXPECT_DOUBLE_EQ(nModes,4.0*4.0*4.0-1.0);
+	EXPECT_LT(results[0].back(),0.5*3.1416*std::sqrt(3.0));
+}
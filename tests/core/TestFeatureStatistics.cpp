@@ -0,0 +1,168 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the optional per-feature move statistics
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/core/ConfigureSystem.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureBox.h>
+#include <LeMonADE/feature/FeatureBondset.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
+#include <LeMonADE/updater/moves/MoveLocalSc.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+
+using namespace std;
+
+class FeatureStatisticsTest: public ::testing::Test{
+public:
+  typedef LOKI_TYPELIST_3(FeatureBox, FeatureBondset<>, FeatureExcludedVolumeSc<>) Features;
+  //statistics are enabled for this test only
+  typedef ConfigureSystem<VectorInt3,Features,7,int,FeatureStatisticsCounting<> > Config;
+  typedef Ingredients<Config> Ing;
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=std::cout.rdbuf();
+    std::cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    std::cout.rdbuf(originalBuffer);
+  };
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+/* *****************************************************************************
+ * every feature only sees the moves accepted by the features before it
+ * ****************************************************************************/
+TEST_F(FeatureStatisticsTest,CountsPerFeature)
+{
+	RandomNumberGenerators rng;
+	rng.seedAll();
+
+	Ing ingredients;
+	ingredients.setBoxX(16);
+	ingredients.setBoxY(16);
+	ingredients.setBoxZ(16);
+	ingredients.setPeriodicX(true);
+	ingredients.setPeriodicY(true);
+	ingredients.setPeriodicZ(true);
+	ingredients.modifyBondset().addBFMclassicBondset();
+	//dense linear chains, such that all features reject moves
+	for(int32_t chain=0;chain<16;chain++)
+	{
+		for(int32_t n=0;n<8;n++)
+		{
+			ingredients.modifyMolecules().addMonomer(2*n,2*(chain%8),4*(chain/8));
+			if(n>0) ingredients.modifyMolecules().connect(chain*8+n-1,chain*8+n);
+		}
+	}
+	ingredients.synchronize();
+
+	uint64_t nAccepted=0;
+	MoveLocalSc move;
+	for(int n=0;n<10000;n++)
+	{
+		move.init(ingredients);
+		if(move.check(ingredients))
+		{
+			move.apply(ingredients);
+			nAccepted++;
+		}
+	}
+
+	std::vector<FeatureStatisticsEntry> entries;
+	ingredients.getFeatureStatistics(entries);
+	//FeatureLattice is inserted by FeatureExcludedVolumeSc
+	ASSERT_EQ(4u,entries.size());
+	EXPECT_EQ("FeatureBox",entries[0].feature);
+	EXPECT_EQ("FeatureLattice<bool>",entries[2].feature);
+	EXPECT_EQ("FeatureExcludedVolumeSc<FeatureLattice<bool> >",entries[3].feature);
+	EXPECT_EQ(10000u,entries[0].checks);
+	for(size_t n=0;n<entries.size();n++)
+	{
+		EXPECT_EQ("MoveLocalSc",entries[n].move);
+		EXPECT_EQ(0u,entries[n].checkTicks);
+		EXPECT_EQ(nAccepted,entries[n].applies);
+		if(n+1<entries.size())
+		{
+			EXPECT_EQ(entries[n].checks-entries[n].rejections,entries[n+1].checks);
+		}
+	}
+	EXPECT_GT(entries[1].rejections,0u);
+	EXPECT_EQ(0u,entries[2].rejections);
+	EXPECT_GT(entries[3].rejections,0u);
+	EXPECT_EQ(nAccepted,entries[3].checks-entries[3].rejections);
+
+	std::stringstream table;
+	ingredients.printFeatureStatistics(table);
+	EXPECT_NE(std::string::npos,table.str().find("FeatureBondset<FastBondset> / MoveLocalSc"));
+
+	//copies keep the counters, reset clears them
+	Ing copy(ingredients);
+	ingredients.resetFeatureStatistics();
+	ingredients.getFeatureStatistics(entries);
+	EXPECT_TRUE(entries.empty());
+	copy.getFeatureStatistics(entries);
+	EXPECT_EQ(4u,entries.size());
+}
+
+/* *****************************************************************************
+ * the disabled policy adds nothing to the features
+ * ****************************************************************************/
+TEST_F(FeatureStatisticsTest,DisabledPolicyIsEmpty)
+{
+	struct Holder: public FeatureBox, private NoFeatureStatistics<FeatureBox>{};
+	EXPECT_EQ(sizeof(FeatureBox),sizeof(Holder));
+	EXPECT_EQ(1,int(Ing::statistics_policy::ENABLED));
+
+	//explicitly disabled statistics collect nothing
+	typedef ConfigureSystem<VectorInt3,Features,7,int,FeatureStatisticsDisabled> DisabledConfig;
+	Ingredients<DisabledConfig> ingredients;
+	EXPECT_EQ(0,int(Ingredients<DisabledConfig>::statistics_policy::ENABLED));
+	std::vector<FeatureStatisticsEntry> entries;
+	ingredients.getFeatureStatistics(entries);
+	EXPECT_TRUE(entries.empty());
+	std::stringstream table;
+	ingredients.printFeatureStatistics(table);
+	EXPECT_NE(std::string::npos,table.str().find("disabled"));
+}
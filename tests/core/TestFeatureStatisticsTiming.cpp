@@ -0,0 +1,119 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the per-feature move statistics with timing
+ *
+ * @details The Ingredients use the counting statistics policy with timing,
+ * while TestFeatureStatistics.cpp covers the counters without timing.
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <vector>
+
+#include <LeMonADE/core/ConfigureSystem.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureBox.h>
+#include <LeMonADE/feature/FeatureBondset.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
+#include <LeMonADE/updater/moves/MoveLocalSc.h>
+
+class FeatureStatisticsTimingTest: public ::testing::Test{
+public:
+  typedef LOKI_TYPELIST_3(FeatureBondset<>, FeatureBox, FeatureExcludedVolumeSc<FeatureLatticePowerOfTwo<bool> >) Features;
+  //statistics with timing are enabled for this test only
+  typedef ConfigureSystem<VectorInt3,Features,7,int,FeatureStatisticsCounting<true> > Config;
+  typedef Ingredients<Config> Ing;
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=std::cout.rdbuf();
+    std::cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    std::cout.rdbuf(originalBuffer);
+  };
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+/* *****************************************************************************
+ * with timing the cycles of checkMove and applyMove are accumulated
+ * ****************************************************************************/
+TEST_F(FeatureStatisticsTimingTest,CyclesPerFeature)
+{
+	EXPECT_EQ(1,int(Ing::statistics_policy::ENABLED));
+
+	Ing ingredients;
+	ingredients.setBoxX(16);
+	ingredients.setBoxY(16);
+	ingredients.setBoxZ(16);
+	ingredients.setPeriodicX(true);
+	ingredients.setPeriodicY(true);
+	ingredients.setPeriodicZ(true);
+	ingredients.modifyBondset().addBFMclassicBondset();
+	for(int32_t n=0;n<8;n++)
+	{
+		ingredients.modifyMolecules().addMonomer(2*n,0,0);
+		if(n>0) ingredients.modifyMolecules().connect(n-1,n);
+	}
+	ingredients.synchronize();
+
+	MoveLocalSc move;
+	for(int n=0;n<1000;n++)
+	{
+		move.init(ingredients);
+		if(move.check(ingredients)) move.apply(ingredients);
+	}
+
+	std::vector<FeatureStatisticsEntry> entries;
+	ingredients.getFeatureStatistics(entries);
+	ASSERT_EQ(4u,entries.size());
+	EXPECT_EQ(1000u,entries[0].checks);
+	for(size_t n=0;n<entries.size();n++)
+	{
+		EXPECT_GT(entries[n].checkTicks,0u);
+		if(entries[n].applies>0)
+		{
+			EXPECT_GT(entries[n].applyTicks,0u);
+		}
+	}
+
+	//reset clears the cycles as well
+	ingredients.resetFeatureStatistics();
+	ingredients.getFeatureStatistics(entries);
+	EXPECT_TRUE(entries.empty());
+}
@@ -365,3 +365,45 @@ TEST_F(MoleculesTest,Clear){
   EXPECT_EQ(0,ingredients.getMolecules().size());
 
 }
+
+TEST_F(MoleculesTest, ConnectedComponents){
+  Molecules <VectorInt3,4> molecules;
+  molecules.resize(6);
+  molecules.connect(0,2);
+  molecules.connect(2,4);
+  molecules.connect(1,3);
+
+  //components {0,2,4}, {1,3}, {5}
+  const ConnectedComponents& components=molecules.getConnectedComponents();
+  EXPECT_EQ(3,components.getNumberOfComponents());
+  EXPECT_EQ(0,components.getComponentId(4));
+  EXPECT_EQ(1,components.getComponentId(3));
+  EXPECT_EQ(2,components.getComponentId(5));
+  EXPECT_EQ(3,components.getComponentSize(0));
+
+  //every change of the connectivity invalidates the cache
+  molecules.connect(4,5);
+  EXPECT_EQ(2,molecules.getConnectedComponents().getNumberOfComponents());
+  EXPECT_EQ(0,molecules.getConnectedComponents().getComponentId(5));
+  molecules.disconnect(0,2);
+  EXPECT_EQ(3,molecules.getConnectedComponents().getNumberOfComponents());
+  EXPECT_EQ(2,molecules.getConnectedComponents().getComponentId(2));
+  molecules.addMonomer(1,2,3);
+  EXPECT_EQ(4,molecules.getConnectedComponents().getNumberOfComponents());
+  EXPECT_EQ(7,molecules.getConnectedComponents().getNumberOfVertices());
+  //resize does not remove bonds to the removed vertices
+  molecules.disconnect(1,3);
+  molecules.resize(2);
+  EXPECT_EQ(2,molecules.getConnectedComponents().getNumberOfComponents());
+
+  //copies carry a valid cache
+  Molecules <VectorInt3,4> copy;
+  copy=molecules;
+  EXPECT_EQ(2,copy.getConnectedComponents().getNumberOfComponents());
+  copy.connect(0,1);
+  EXPECT_EQ(1,copy.getConnectedComponents().getNumberOfComponents());
+  EXPECT_EQ(2,molecules.getConnectedComponents().getNumberOfComponents());
+
+  molecules.clear();
+  EXPECT_EQ(0,molecules.getConnectedComponents().getNumberOfComponents());
+}
@@ -33,8 +33,12 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "gtest/gtest.h"
 
+#include <cstdio>
+#include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <LeMonADE/updater/AbstractUpdater.h>
 #include <LeMonADE/analyzer/AbstractAnalyzer.h>
@@ -199,3 +203,180 @@ TEST(TaskManagerTest, InitAndCleanup)
 
 
 
+/*
+ * dummies for the tests of the parallel analyzer stage. the updater counts
+ * the cycles, the analyzers record the counter they see in every execution.
+ */
+class CountingUpdater:public AbstractUpdater
+{
+public:
+	CountingUpdater(int& c):counter(&c){}
+	bool execute(){(*counter)++; return true;}
+	void initialize(){}
+	void cleanup(){}
+private:
+	int* counter;
+};
+
+class RecordingAnalyzer: public AbstractAnalyzer
+{
+public:
+	RecordingAnalyzer(const int& c,bool threadSafe,bool snapshot,int failAt=-1)
+	:counter(&c),snapshotCounter(0),threadSafe(threadSafe),snapshot(snapshot),failAt(failAt){}
+
+	bool execute(){
+		int value=snapshot?snapshotCounter:*counter;
+		if(value==failAt) throw std::runtime_error("RecordingAnalyzer failed");
+		//some work, such that executions really overlap
+		double sum=0.0;
+		for(int n=0;n<100000;n++) sum+=double(n%7);
+		if(sum<0.0) return false;
+		record.push_back(value);
+		return true;
+	}
+	void initialize(){}
+	void cleanup(){}
+
+	bool isThreadSafe() const {return threadSafe;}
+	bool needsSnapshot() const {return snapshot;}
+	void takeSnapshot(){snapshotCounter=*counter;}
+
+	vector<int> record;
+private:
+	const int* counter;
+	int snapshotCounter;
+	bool threadSafe,snapshot;
+	int failAt;
+};
+
+/*
+ * with worker threads, all analyzers see the same state as in serial execution
+ */
+TEST(TaskManagerTest, ParallelAnalyzers)
+{
+  int counter=0;
+  TaskManager taskmanager;
+  EXPECT_EQ(0u,taskmanager.getAnalyzerThreads());
+  taskmanager.setAnalyzerThreads(3);
+  EXPECT_EQ(3u,taskmanager.getAnalyzerThreads());
+
+  vector<RecordingAnalyzer*> analyzers;
+  analyzers.push_back(new RecordingAnalyzer(counter,false,false));
+  analyzers.push_back(new RecordingAnalyzer(counter,true,false));
+  analyzers.push_back(new RecordingAnalyzer(counter,true,false));
+  analyzers.push_back(new RecordingAnalyzer(counter,true,true));
+  analyzers.push_back(new RecordingAnalyzer(counter,true,true));
+  analyzers.push_back(new RecordingAnalyzer(counter,false,true));
+
+  taskmanager.addUpdater(new CountingUpdater(counter));
+  for(size_t n=0;n<analyzers.size();n++) taskmanager.addAnalyzer(analyzers[n],n==2?2:1);
+
+  taskmanager.initialize();
+  taskmanager.run(20);
+  taskmanager.run(10);
+  taskmanager.cleanup();
+
+  EXPECT_EQ(30,counter);
+  for(size_t n=0;n<analyzers.size();n++)
+  {
+	  int period=(n==2?2:1);
+	  ASSERT_EQ(size_t(30/period),analyzers[n]->record.size());
+	  for(size_t i=0;i<analyzers[n]->record.size();i++)
+		  EXPECT_EQ(int((i+1)*period),analyzers[n]->record[i]);
+  }
+
+  //switching back to serial execution
+  taskmanager.setAnalyzerThreads(0);
+  taskmanager.run(2);
+  EXPECT_EQ(32,analyzers[3]->record.back());
+}
+
+/*
+ * exceptions in worker threads are passed to the caller of run()
+ */
+TEST(TaskManagerTest, ParallelAnalyzerException)
+{
+  int counter=0;
+  TaskManager taskmanager;
+  taskmanager.setAnalyzerThreads(2);
+  taskmanager.addUpdater(new CountingUpdater(counter));
+  taskmanager.addAnalyzer(new RecordingAnalyzer(counter,true,false));
+  taskmanager.addAnalyzer(new RecordingAnalyzer(counter,true,true,3));
+
+  EXPECT_THROW(taskmanager.run(5),std::runtime_error);
+  EXPECT_NO_THROW(taskmanager.run(1));
+}
+
+/*
+ * updater reporting a fixed amount of work per execution
+ */
+class WorkingUpdater:public AbstractUpdater
+{
+public:
+	bool execute(){addWorkCounters(100,25,2); return true;}
+	void initialize(){}
+	void cleanup(){}
+};
+
+/*
+ * the calls, times and work counters of all tasks are recorded and reported
+ */
+TEST(TaskManagerTest, Statistics)
+{
+  int counter=0;
+  TaskManager taskmanager;
+  WorkingUpdater* updater=new WorkingUpdater;
+  taskmanager.addUpdater(updater);
+  taskmanager.addUpdater(new CountingUpdater(counter),2);
+  taskmanager.addAnalyzer(new RecordingAnalyzer(counter,false,false),3);
+
+  taskmanager.setStatisticsOutput("TaskManagerStatistics.csv",5);
+  taskmanager.run(10);
+  EXPECT_EQ(1000u,updater->getAttemptedMoves());
+  EXPECT_EQ(250u,updater->getAcceptedMoves());
+  EXPECT_EQ(20u,updater->getPerformedMcs());
+
+  std::stringstream table;
+  taskmanager.printStatistics(table);
+  std::string line;
+  std::getline(table,line);
+  EXPECT_EQ(0u,line.find("TaskManager statistics after 10 cycles"));
+  std::getline(table,line);
+  std::getline(table,line);
+  EXPECT_EQ(0u,line.find("updater"));
+  EXPECT_NE(std::string::npos,line.find("WorkingUpdater"));
+  EXPECT_NE(std::string::npos,line.find("0.2500"));
+  std::getline(table,line);
+  std::getline(table,line);
+  EXPECT_EQ(0u,line.find("analyzer"));
+  EXPECT_NE(std::string::npos,line.find("RecordingAnalyzer"));
+
+  //switch to JSON lines, closes the CSV file
+  taskmanager.setStatisticsOutput("TaskManagerStatistics.jsonl",3,TaskManager::STATISTICS_JSONL);
+  taskmanager.run(3);
+  taskmanager.setStatisticsOutput("",0);
+
+  std::ifstream csv("TaskManagerStatistics.csv");
+  std::vector<std::string> lines;
+  while(std::getline(csv,line)) lines.push_back(line);
+  ASSERT_EQ(7u,lines.size());
+  EXPECT_EQ("cycle,type,index,name,period,calls,seconds,attempted_moves,accepted_moves,mcs",lines[0]);
+  EXPECT_EQ(0u,lines[1].find("5,updater,0,\"WorkingUpdater\",1,5,"));
+  EXPECT_NE(std::string::npos,lines[1].find(",500,125,10"));
+  EXPECT_EQ(0u,lines[5].find("10,updater,1,\"CountingUpdater\",2,5,"));
+  EXPECT_EQ(0u,lines[6].find("10,analyzer,0,\"RecordingAnalyzer\",3,3,"));
+  EXPECT_NE(std::string::npos,lines[6].find(",0,0,0"));
+  csv.close();
+
+  std::ifstream jsonl("TaskManagerStatistics.jsonl");
+  lines.clear();
+  while(std::getline(jsonl,line)) lines.push_back(line);
+  ASSERT_EQ(3u,lines.size());
+  EXPECT_EQ(0u,lines[0].find("{\"cycle\":12,\"type\":\"updater\",\"index\":0,\"name\":\"WorkingUpdater\",\"period\":1,\"calls\":12,"));
+  EXPECT_NE(std::string::npos,lines[0].find("\"attempted_moves\":1200,\"accepted_moves\":300,\"mcs\":24}"));
+  EXPECT_EQ(0u,lines[2].find("{\"cycle\":12,\"type\":\"analyzer\",\"index\":0,"));
+  jsonl.close();
+
+  std::remove("TaskManagerStatistics.csv");
+  std::remove("TaskManagerStatistics.jsonl");
+}
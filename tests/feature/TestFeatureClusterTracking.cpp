@@ -0,0 +1,313 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class FeatureClusterTracking
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <vector>
+
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureClusterTracking.h>
+#include <LeMonADE/feature/FeatureConnectionSc.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
+#include <LeMonADE/updater/UpdaterSimpleConnection.h>
+#include <LeMonADE/updater/moves/MoveConnectSc.h>
+#include <LeMonADE/updater/moves/MoveDisconnectSc.h>
+#include <LeMonADE/updater/moves/MoveLocalSc.h>
+#include <LeMonADE/utility/ConnectedComponents.h>
+
+class TestFeatureClusterTracking: public ::testing::Test{
+public:
+  typedef LOKI_TYPELIST_4(FeatureMoleculesIO, FeatureConnectionSc, FeatureExcludedVolumeSc< FeatureLatticePowerOfTwo <uint8_t> >, FeatureClusterTracking) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> IngredientsType;
+
+  IngredientsType ingredients;
+
+  //! without bond set: bonds across the periodic boundary between folded positions are allowed
+  typedef LOKI_TYPELIST_3(FeatureConnectionSc, FeatureExcludedVolumeSc< FeatureLatticePowerOfTwo <uint8_t> >, FeatureClusterTracking) FeaturesFolded;
+  typedef Ingredients<ConfigureSystem<VectorInt3,FeaturesFolded> > IngredientsFolded;
+
+  template<class IngredientsT>
+  void setupBox(IngredientsT& ing, uint32_t box)
+  {
+    ing.setBoxX(box);
+    ing.setBoxY(box);
+    ing.setBoxZ(box);
+    ing.setPeriodicX(true);
+    ing.setPeriodicY(true);
+    ing.setPeriodicZ(true);
+  }
+
+  template<class IngredientsT>
+  void connect(IngredientsT& ing, uint32_t index, VectorInt3 dir)
+  {
+    MoveConnectSc move;
+    move.init(ing,index,dir);
+    ASSERT_TRUE(move.check(ing));
+    move.apply(ing);
+  }
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=std::cout.rdbuf();
+    std::cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    std::cout.rdbuf(originalBuffer);
+  };
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+TEST_F(TestFeatureClusterTracking, Percolation)
+{
+  IngredientsFolded ingredients;
+  setupBox(ingredients,8);
+  //a line along x through the periodic box, one monomer in the next periodic image
+  ingredients.modifyMolecules().addMonomer(0,0,0);
+  ingredients.modifyMolecules().addMonomer(2,0,0);
+  ingredients.modifyMolecules().addMonomer(4,0,0);
+  ingredients.modifyMolecules().addMonomer(14,0,0);
+  //a square in the y-z-plane
+  ingredients.modifyMolecules().addMonomer(0,4,4);
+  ingredients.modifyMolecules().addMonomer(0,6,4);
+  ingredients.modifyMolecules().addMonomer(0,6,6);
+  ingredients.modifyMolecules().addMonomer(0,4,6);
+  for(uint32_t n=0;n<ingredients.getMolecules().size();n++)
+  {
+    ingredients.modifyMolecules()[n].setReactive(true);
+    ingredients.modifyMolecules()[n].setNumMaxLinks(2);
+  }
+  ingredients.synchronize();
+
+  EXPECT_EQ(8u,ingredients.getNumberOfClusters());
+  EXPECT_EQ(1u,ingredients.getLargestClusterSize());
+  EXPECT_FALSE(ingredients.isPercolating());
+
+  connect(ingredients,0,VectorInt3(2,0,0));
+  connect(ingredients,1,VectorInt3(2,0,0));
+  connect(ingredients,2,VectorInt3(2,0,0));
+  EXPECT_EQ(5u,ingredients.getNumberOfClusters());
+  EXPECT_EQ(4u,ingredients.getLargestClusterSize());
+  EXPECT_EQ(ingredients.getClusterRoot(0),ingredients.getClusterRoot(3));
+  EXPECT_FALSE(ingredients.isPercolating());
+
+  connect(ingredients,4,VectorInt3(0,2,0));
+  connect(ingredients,5,VectorInt3(0,0,2));
+  connect(ingredients,6,VectorInt3(0,-2,0));
+  connect(ingredients,7,VectorInt3(0,0,-2));
+  EXPECT_EQ(2u,ingredients.getNumberOfClusters());
+  EXPECT_EQ(0,ingredients.getPercolationDirections(4));
+  EXPECT_FALSE(ingredients.isPercolating());
+
+  //closing the line around the periodic box
+  connect(ingredients,3,VectorInt3(2,0,0));
+  EXPECT_EQ(2u,ingredients.getNumberOfClusters());
+  EXPECT_EQ(1,ingredients.getPercolationDirections(0));
+  EXPECT_EQ(0,ingredients.getPercolationDirections(4));
+  EXPECT_EQ(1,ingredients.getPercolationDirections());
+  EXPECT_TRUE(ingredients.isPercolating());
+  EXPECT_EQ(8u,ingredients.getNumberOfBonds());
+
+  //the rebuild from the graph gives the same result
+  ingredients.synchronize();
+  EXPECT_EQ(2u,ingredients.getNumberOfClusters());
+  EXPECT_EQ(1,ingredients.getPercolationDirections(0));
+  EXPECT_EQ(0,ingredients.getPercolationDirections(4));
+  EXPECT_EQ(8u,ingredients.getNumberOfBonds());
+}
+
+TEST_F(TestFeatureClusterTracking, Moments)
+{
+  setupBox(ingredients,16);
+  ingredients.modifyBondset().addBFMclassicBondset();
+  //clusters of size 3, 2 and 1
+  ingredients.modifyMolecules().addMonomer(0,0,0);
+  ingredients.modifyMolecules().addMonomer(2,0,0);
+  ingredients.modifyMolecules().addMonomer(4,0,0);
+  ingredients.modifyMolecules().addMonomer(0,8,0);
+  ingredients.modifyMolecules().addMonomer(0,10,0);
+  ingredients.modifyMolecules().addMonomer(8,8,8);
+  for(uint32_t n=0;n<ingredients.getMolecules().size();n++)
+  {
+    ingredients.modifyMolecules()[n].setReactive(true);
+    ingredients.modifyMolecules()[n].setNumMaxLinks(2);
+  }
+  ingredients.synchronize();
+  connect(ingredients,0,VectorInt3(2,0,0));
+  connect(ingredients,2,VectorInt3(-2,0,0));
+  connect(ingredients,4,VectorInt3(0,-2,0));
+
+  EXPECT_DOUBLE_EQ(3.0,ingredients.getClusterSizeMoment(0));
+  EXPECT_DOUBLE_EQ(6.0,ingredients.getClusterSizeMoment(1));
+  EXPECT_DOUBLE_EQ(14.0,ingredients.getClusterSizeMoment(2));
+  EXPECT_DOUBLE_EQ(36.0,ingredients.getClusterSizeMoment(3));
+  EXPECT_THROW(ingredients.getClusterSizeMoment(4),std::runtime_error);
+  EXPECT_DOUBLE_EQ(14.0/6.0,ingredients.getWeightAverageClusterSize());
+  EXPECT_DOUBLE_EQ(5.0/3.0,ingredients.getWeightAverageSolClusterSize());
+  EXPECT_EQ(3u,ingredients.getLargestClusterSize());
+  EXPECT_EQ(ingredients.getClusterRoot(1),ingredients.getLargestClusterRoot());
+  EXPECT_EQ(3u,ingredients.getClusterSize(2));
+  EXPECT_EQ(2u,ingredients.getClusterSize(3));
+  EXPECT_EQ(1u,ingredients.getClusterSize(5));
+}
+
+TEST_F(TestFeatureClusterTracking, NetworkFormation)
+{
+  setupBox(ingredients,16);
+  ingredients.modifyBondset().addBFMclassicBondset();
+  for(int32_t x=0;x<16;x+=4)
+    for(int32_t y=0;y<16;y+=2)
+      for(int32_t z=0;z<16;z+=4)
+      {
+        ingredients.modifyMolecules().addMonomer(x,y,z);
+        ingredients.modifyMolecules()[ingredients.getMolecules().size()-1].setReactive(true);
+        ingredients.modifyMolecules()[ingredients.getMolecules().size()-1].setNumMaxLinks(3);
+      }
+  ingredients.synchronize();
+
+  UpdaterSimpleConnection<IngredientsType,MoveLocalSc,MoveConnectSc> updater(ingredients,10);
+  updater.initialize();
+  for(uint32_t cycle=0;cycle<20;cycle++)
+  {
+    updater.execute();
+
+    //compare to the labelling of the complete graph
+    const ConnectedComponents& components=ingredients.getMolecules().getConnectedComponents();
+    ASSERT_EQ(components.getNumberOfComponents(),ingredients.getNumberOfClusters());
+    double m2=0.0, m3=0.0;
+    uint32_t largest=0;
+    for(uint32_t c=0;c<components.getNumberOfComponents();c++)
+    {
+      double size=components.getComponentSize(c);
+      m2+=size*size;
+      m3+=size*size*size;
+      largest=std::max(largest,components.getComponentSize(c));
+    }
+    EXPECT_DOUBLE_EQ(m2,ingredients.getClusterSizeMoment(2));
+    EXPECT_DOUBLE_EQ(m3,ingredients.getClusterSizeMoment(3));
+    EXPECT_EQ(largest,ingredients.getLargestClusterSize());
+
+    for(uint32_t n=0;n<ingredients.getMolecules().size();n++)
+    {
+      uint32_t root=ingredients.getClusterRoot(n);
+      EXPECT_EQ(components.getComponentId(n),components.getComponentId(root));
+      EXPECT_EQ(components.getComponentSize(components.getComponentId(n)),ingredients.getClusterSize(n));
+    }
+  }
+  EXPECT_GT(ingredients.getNumberOfBonds(),0u);
+
+  uint8_t percolation=ingredients.getPercolationDirections();
+  uint64_t nClusters=ingredients.getNumberOfClusters();
+  ingredients.synchronize();
+  EXPECT_EQ(percolation,ingredients.getPercolationDirections());
+  EXPECT_EQ(nClusters,ingredients.getNumberOfClusters());
+}
+
+TEST_F(TestFeatureClusterTracking, BondBreaking)
+{
+  setupBox(ingredients,16);
+  ingredients.modifyBondset().addBFMclassicBondset();
+  for(int32_t x=0;x<8;x+=2)
+  {
+    ingredients.modifyMolecules().addMonomer(x,4,4);
+    ingredients.modifyMolecules()[ingredients.getMolecules().size()-1].setReactive(true);
+    ingredients.modifyMolecules()[ingredients.getMolecules().size()-1].setNumMaxLinks(2);
+  }
+  ingredients.modifyMolecules().connect(0,1);
+  ingredients.modifyMolecules().connect(1,2);
+  ingredients.modifyMolecules().connect(2,3);
+  ingredients.synchronize();
+  EXPECT_EQ(1u,ingredients.getNumberOfClusters());
+  EXPECT_EQ(4u,ingredients.getLargestClusterSize());
+
+  MoveDisconnectSc move;
+  move.init(ingredients,1,VectorInt3(2,0,0));
+  ASSERT_TRUE(move.check(ingredients));
+  move.apply(ingredients);
+  EXPECT_EQ(2u,ingredients.getNumberOfClusters());
+  EXPECT_EQ(2u,ingredients.getLargestClusterSize());
+  EXPECT_EQ(2u,ingredients.getNumberOfBonds());
+  EXPECT_EQ(ingredients.getClusterRoot(0),ingredients.getClusterRoot(1));
+  EXPECT_NE(ingredients.getClusterRoot(1),ingredients.getClusterRoot(2));
+  EXPECT_DOUBLE_EQ(8.0,ingredients.getClusterSizeMoment(2));
+}
+
+TEST_F(TestFeatureClusterTracking, LazyRebuildAfterBondBreaking)
+{
+  setupBox(ingredients,16);
+  ingredients.modifyBondset().addBFMclassicBondset();
+  for(int32_t x=0;x<12;x+=2)
+  {
+    ingredients.modifyMolecules().addMonomer(x,4,4);
+    ingredients.modifyMolecules()[ingredients.getMolecules().size()-1].setReactive(true);
+    ingredients.modifyMolecules()[ingredients.getMolecules().size()-1].setNumMaxLinks(2);
+  }
+  for(uint32_t n=0;n<5;n++) ingredients.modifyMolecules().connect(n,n+1);
+  ingredients.synchronize();
+  EXPECT_EQ(1u,ingredients.getNumberOfClusters());
+
+  //several breaks and a new bond between two queries
+  MoveDisconnectSc move;
+  move.init(ingredients,0,VectorInt3(2,0,0));
+  ASSERT_TRUE(move.check(ingredients));
+  move.apply(ingredients);
+  move.init(ingredients,2,VectorInt3(2,0,0));
+  ASSERT_TRUE(move.check(ingredients));
+  move.apply(ingredients);
+  move.init(ingredients,4,VectorInt3(2,0,0));
+  ASSERT_TRUE(move.check(ingredients));
+  move.apply(ingredients);
+  connect(ingredients,2,VectorInt3(2,0,0));
+
+  //a copy taken while the clusters are outdated is independent of the original
+  IngredientsType copy(ingredients);
+
+  EXPECT_EQ(3u,ingredients.getNumberOfClusters());
+  EXPECT_EQ(3u,ingredients.getNumberOfBonds());
+  EXPECT_EQ(4u,ingredients.getLargestClusterSize());
+  EXPECT_EQ(ingredients.getClusterRoot(1),ingredients.getClusterRoot(4));
+  EXPECT_NE(ingredients.getClusterRoot(0),ingredients.getClusterRoot(1));
+  EXPECT_NE(ingredients.getClusterRoot(4),ingredients.getClusterRoot(5));
+  EXPECT_DOUBLE_EQ(18.0,ingredients.getClusterSizeMoment(2));
+
+  EXPECT_EQ(3u,copy.getNumberOfClusters());
+  EXPECT_EQ(4u,copy.getLargestClusterSize());
+}
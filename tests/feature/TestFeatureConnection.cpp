@@ -298,3 +298,59 @@ TEST_F(TestFeatureConnectionSc,MoveLocalSc)
     move.apply(ingredients);
     EXPECT_EQ(std::numeric_limits<uint32_t>::max(),ingredients.getIdFromLattice(2,1,0));
 }
+
+TEST_F(TestFeatureConnectionSc,UnsaturatedReactiveIndex)
+{
+  //prepare ingredients
+    ingredients.setBoxX(12);
+    ingredients.setBoxY(12);
+    ingredients.setBoxZ(12);
+    ingredients.setPeriodicX(1);
+    ingredients.setPeriodicY(1);
+    ingredients.setPeriodicZ(1);
+    ingredients.modifyBondset().addBFMclassicBondset();
+    ingredients.modifyMolecules().resize(4);
+    ingredients.modifyMolecules()[0].setAllCoordinates(0,0,0);
+    ingredients.modifyMolecules()[1].setAllCoordinates(2,0,0);
+    ingredients.modifyMolecules()[2].setAllCoordinates(0,4,0);
+    ingredients.modifyMolecules()[3].setAllCoordinates(4,0,0);
+    ingredients.modifyMolecules()[0].setReactive(true);
+    ingredients.modifyMolecules()[1].setReactive(true);
+    ingredients.modifyMolecules()[2].setReactive(false);
+    ingredients.modifyMolecules()[3].setReactive(true);
+    ingredients.modifyMolecules()[0].setNumMaxLinks(1);
+    ingredients.modifyMolecules()[1].setNumMaxLinks(2);
+    ingredients.modifyMolecules()[2].setNumMaxLinks(2);
+    ingredients.modifyMolecules()[3].setNumMaxLinks(1);
+    ingredients.synchronize(ingredients);
+    EXPECT_EQ(3,ingredients.getNumUnsaturatedReactiveMonomers());
+
+    MoveConnectSc connect;
+    connect.init(ingredients,0,VectorInt3(2,0,0));
+    EXPECT_TRUE(connect.check(ingredients));
+    connect.apply(ingredients);
+    //monomer 0 is saturated
+    ASSERT_EQ(2,ingredients.getNumUnsaturatedReactiveMonomers());
+    EXPECT_NE(0,ingredients.getUnsaturatedReactiveMonomer(0));
+    EXPECT_NE(0,ingredients.getUnsaturatedReactiveMonomer(1));
+
+    MoveAddMonomerSc<> add;
+    add.init(ingredients);
+    add.setPosition(VectorInt3(6,6,6));
+    add.setReactive(true);
+    add.setNumMaxLinks(1);
+    EXPECT_TRUE(add.check(ingredients));
+    add.apply(ingredients);
+    EXPECT_EQ(3,ingredients.getNumUnsaturatedReactiveMonomers());
+
+    connect.init(ingredients,1,VectorInt3(2,0,0));
+    EXPECT_TRUE(connect.check(ingredients));
+    connect.apply(ingredients);
+    ASSERT_EQ(1,ingredients.getNumUnsaturatedReactiveMonomers());
+    EXPECT_EQ(4,ingredients.getUnsaturatedReactiveMonomer(0));
+
+    //synchronize gives the same index
+    ingredients.synchronize(ingredients);
+    ASSERT_EQ(1,ingredients.getNumUnsaturatedReactiveMonomers());
+    EXPECT_EQ(4,ingredients.getUnsaturatedReactiveMonomer(0));
+}
@@ -998,3 +998,77 @@ TEST_F(FeatureMoleculesIOTest,getSetCompressedOutputIndices)
 	ingredients.setCompressedOutputIndices(10,114);
 	EXPECT_EQ(ingredients.getCompressedOutputIndices().at(10),114);
 }
+
+/************************************************************************/
+//the !mcs output of a system with chains, unconnected monomers and
+//compressed solvent must not change. the reference file was written by
+//the stringstream based implementation of WriteMcs
+/************************************************************************/
+TEST_F(FeatureMoleculesIOTest,WriteMcsReferenceOutput)
+{
+	MyIngredients ingredients;
+	ingredients.setBoxX(64);
+	ingredients.setBoxY(64);
+	ingredients.setBoxZ(64);
+	ingredients.setPeriodicX(true);
+	ingredients.setPeriodicY(true);
+	ingredients.setPeriodicZ(true);
+	ingredients.modifyBondset().addBFMclassicBondset();
+
+	//deterministic pseudo random positions
+	uint32_t seed=12345;
+
+	//chains with different bond vectors, some crossing the box boundaries
+	for(int32_t chain=0;chain<20;chain++)
+	{
+		VectorInt3 position(chain*7-60,chain*3,-chain*5);
+		for(int32_t n=0;n<10;n++)
+		{
+			if(n%3==0) position+=VectorInt3(2,0,0);
+			else if(n%3==1) position+=VectorInt3(0,-3,0);
+			else position+=VectorInt3(1,2,-2);
+			ingredients.modifyMolecules().addMonomer(position);
+			if(n>0) ingredients.modifyMolecules().connect(ingredients.getMolecules().size()-2,ingredients.getMolecules().size()-1);
+		}
+	}
+
+	//solvent block with low and high density regions and double occupancy
+	size_t solventStart=ingredients.getMolecules().size();
+	for(int32_t n=0;n<3000;n++)
+	{
+		seed=seed*1103515245u+12345u;
+		int32_t x=int32_t((seed>>8)%200)-100;
+		seed=seed*1103515245u+12345u;
+		int32_t y=int32_t((seed>>8)%(n<1000?8:64));
+		seed=seed*1103515245u+12345u;
+		int32_t z=int32_t((seed>>8)%(n<2000?64:4))-128;
+		ingredients.modifyMolecules().addMonomer(VectorInt3(x,y,z));
+		if(n%97==0) ingredients.modifyMolecules().addMonomer(VectorInt3(x+64,y,z));
+	}
+	ingredients.setCompressedOutputIndices(solventStart,ingredients.getMolecules().size()-1);
+
+	//unconnected monomers between two solvent blocks
+	for(int32_t n=0;n<5;n++)
+		ingredients.modifyMolecules().addMonomer(VectorInt3(-1000*n,n,1234567*n));
+
+	//solvent block at the end of the system
+	solventStart=ingredients.getMolecules().size();
+	for(int32_t n=0;n<50;n++)
+		ingredients.modifyMolecules().addMonomer(VectorInt3(n*n,n,-n));
+	ingredients.setCompressedOutputIndices(solventStart,ingredients.getMolecules().size()-1);
+
+	std::ostringstream output;
+	WriteMcs<MyIngredients> writer(ingredients);
+	writer.writeStream(output);
+	ingredients.modifyMolecules().setAge(123456789012ull);
+	for(size_t n=0;n<10;n++)
+		ingredients.modifyMolecules()[n].modifyVector3D()+=VectorInt3(64,-64,128);
+	writer.writeStream(output);
+
+	std::ifstream reference("tests/writeMcsReference.test",std::ios::binary);
+	ASSERT_TRUE(reference.is_open());
+	std::stringstream referenceContents;
+	referenceContents<<reference.rdbuf();
+
+	EXPECT_EQ(referenceContents.str(),output.str());
+}
@@ -0,0 +1,234 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the binary checkpoint/restart
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/core/ConfigureSystem.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
+#include <LeMonADE/feature/FeatureNNInteractionSc.h>
+#include <LeMonADE/feature/FeatureLatticePowerOfTwo.h>
+#include <LeMonADE/updater/UpdaterSimpleSimulator.h>
+#include <LeMonADE/updater/moves/MoveLocalSc.h>
+#include <LeMonADE/analyzer/AnalyzerWriteCheckpoint.h>
+#include <LeMonADE/io/SystemCheckpoint.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+#include <LeMonADE/utility/TaskManager.h>
+
+using namespace std;
+
+class CheckpointTest: public ::testing::Test{
+public:
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO, FeatureBondset<>,FeatureNNInteractionSc<FeatureLatticePowerOfTwo>) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> Ing;
+
+  //sets up some chains of type 1 and 2 with attractive interaction
+  void setupSystem(Ing& ingredients)
+  {
+	  ingredients.setBoxX(32);
+	  ingredients.setBoxY(32);
+	  ingredients.setBoxZ(32);
+	  ingredients.setPeriodicX(true);
+	  ingredients.setPeriodicY(true);
+	  ingredients.setPeriodicZ(true);
+	  ingredients.modifyBondset().addBFMclassicBondset();
+	  ingredients.setNNInteraction(1,2,-0.4);
+	  ingredients.addComment("checkpoint test system");
+
+	  Ing::molecules_type& molecules=ingredients.modifyMolecules();
+	  for(int32_t chain=0;chain<8;chain++)
+	  {
+		  for(int32_t n=0;n<8;n++)
+		  {
+			  uint32_t idx=molecules.addMonomer(2*n,4*(chain%4),8*(chain/4));
+			  molecules[idx].setAttributeTag(1+chain%2);
+			  if(n>0) molecules.connect(idx-1,idx);
+		  }
+	  }
+	  ingredients.setCompressedOutputIndices(56,63);
+	  ingredients.synchronize();
+  }
+
+  //reads the complete contents of a file
+  std::string fileContents(const std::string& filename)
+  {
+	  std::ifstream file(filename.c_str(),std::ios_base::in|std::ios_base::binary);
+	  return std::string(std::istreambuf_iterator<char>(file),std::istreambuf_iterator<char>());
+  }
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=std::cout.rdbuf();
+    std::cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    std::cout.rdbuf(originalBuffer);
+  };
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+/* *****************************************************************************
+ * a simulation restarted from a checkpoint continues bit-identically
+ * ****************************************************************************/
+TEST_F(CheckpointTest,RestartIsBitIdentical)
+{
+	RandomNumberGenerators rng;
+	rng.seedAll();
+
+	//reference run: 5 cycles, checkpoint, 5 more cycles
+	Ing reference;
+	setupSystem(reference);
+	TaskManager referenceTasks;
+	referenceTasks.addUpdater(new UpdaterSimpleSimulator<Ing,MoveLocalSc>(reference,20));
+	referenceTasks.addAnalyzer(new AnalyzerWriteCheckpoint<Ing>("checkpointTestReference.chk",reference,&referenceTasks),5);
+	referenceTasks.initialize();
+	referenceTasks.run(5);
+	EXPECT_EQ(0,std::rename("checkpointTestReference.chk","checkpointTestCycle5.chk"));
+	referenceTasks.run(5);
+	referenceTasks.cleanup();
+
+	std::vector<uint32_t> referenceRandomNumbers;
+	for(int n=0;n<1000;n++) referenceRandomNumbers.push_back(rng.r250_rand32());
+
+	//restarted run: different state everywhere before loading the checkpoint
+	Ing restarted;
+	TaskManager restartedTasks;
+	restartedTasks.addUpdater(new UpdaterSimpleSimulator<Ing,MoveLocalSc>(restarted,20));
+	restartedTasks.addAnalyzer(new AnalyzerWriteCheckpoint<Ing>("checkpointTestRestarted.chk",restarted,&restartedTasks),5);
+	restartedTasks.initialize();
+	rng.seedAll();
+
+	readSystemCheckpoint("checkpointTestCycle5.chk",restarted,&restartedTasks);
+	EXPECT_EQ(5,restartedTasks.getNCircles());
+	EXPECT_EQ(64u,restarted.getMolecules().size());
+	EXPECT_EQ(100u,restarted.getMolecules().getAge());
+	EXPECT_EQ(reference.getBoxX(),restarted.getBoxX());
+	EXPECT_EQ(reference.getSumOfComments(),restarted.getSumOfComments());
+	EXPECT_EQ(reference.getNNInteraction(1,2),restarted.getNNInteraction(1,2));
+	EXPECT_EQ(reference.getBondset().size(),restarted.getBondset().size());
+	EXPECT_EQ(reference.getCompressedOutputIndices(),restarted.getCompressedOutputIndices());
+
+	restartedTasks.run(5);
+	restartedTasks.cleanup();
+
+	ASSERT_EQ(reference.getMolecules().size(),restarted.getMolecules().size());
+	EXPECT_EQ(reference.getMolecules().getAge(),restarted.getMolecules().getAge());
+	for(uint32_t n=0;n<reference.getMolecules().size();n++)
+	{
+		EXPECT_EQ(reference.getMolecules()[n],restarted.getMolecules()[n]);
+		EXPECT_EQ(reference.getMolecules()[n].getAttributeTag(),restarted.getMolecules()[n].getAttributeTag());
+		ASSERT_EQ(reference.getMolecules().getNumLinks(n),restarted.getMolecules().getNumLinks(n));
+		for(uint32_t l=0;l<reference.getMolecules().getNumLinks(n);l++)
+			EXPECT_EQ(reference.getMolecules().getNeighborIdx(n,l),restarted.getMolecules().getNeighborIdx(n,l));
+	}
+	for(int32_t x=0;x<32;x++)
+		for(int32_t y=0;y<32;y++)
+			for(int32_t z=0;z<32;z++)
+				ASSERT_EQ(reference.getLatticeEntry(x,y,z),restarted.getLatticeEntry(x,y,z));
+
+	for(int n=0;n<1000;n++) EXPECT_EQ(referenceRandomNumbers[n],rng.r250_rand32());
+
+	//the checkpoints of both runs after 10 cycles are identical
+	std::string referenceCheckpoint=fileContents("checkpointTestReference.chk");
+	EXPECT_FALSE(referenceCheckpoint.empty());
+	EXPECT_TRUE(referenceCheckpoint==fileContents("checkpointTestRestarted.chk"));
+
+	std::remove("checkpointTestReference.chk");
+	std::remove("checkpointTestRestarted.chk");
+	std::remove("checkpointTestCycle5.chk");
+}
+
+/* *****************************************************************************
+ * incompatible or incomplete checkpoints are rejected
+ * ****************************************************************************/
+TEST_F(CheckpointTest,Errors)
+{
+	Ing ingredients;
+	setupSystem(ingredients);
+
+	EXPECT_THROW(readSystemCheckpoint("checkpointTestMissing.chk",ingredients),std::runtime_error);
+
+	//the file only appears after close()
+	{
+		CheckpointWriter writer("checkpointTestErrors.chk");
+		ingredients.saveCheckpoint(writer);
+		EXPECT_FALSE(std::ifstream("checkpointTestErrors.chk").is_open());
+		//writer is destroyed without close(), no file must remain
+	}
+	EXPECT_FALSE(std::ifstream("checkpointTestErrors.chk").is_open());
+	EXPECT_FALSE(std::ifstream("checkpointTestErrors.chk.tmp").is_open());
+
+	//different number of tasks
+	TaskManager tasks;
+	tasks.addUpdater(new UpdaterSimpleSimulator<Ing,MoveLocalSc>(ingredients,1));
+	writeSystemCheckpoint("checkpointTestErrors.chk",ingredients,&tasks);
+	TaskManager otherTasks;
+	EXPECT_THROW(readSystemCheckpoint("checkpointTestErrors.chk",ingredients,&otherTasks),std::runtime_error);
+	//loading without TaskManager is fine
+	EXPECT_NO_THROW(readSystemCheckpoint("checkpointTestErrors.chk",ingredients));
+	//but the end of the file is still checked
+	std::string withTasks=fileContents("checkpointTestErrors.chk");
+	std::ofstream shortened("checkpointTestErrors.chk",std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+	shortened.write(withTasks.data(),withTasks.size()-1);
+	shortened.close();
+	EXPECT_THROW(readSystemCheckpoint("checkpointTestErrors.chk",ingredients),std::runtime_error);
+	writeSystemCheckpoint("checkpointTestErrors.chk",ingredients,&tasks);
+
+	//different system type
+	typedef LOKI_TYPELIST_2(FeatureMoleculesIO, FeatureBondset<>) OtherFeatures;
+	typedef ConfigureSystem<VectorInt3,OtherFeatures> OtherConfig;
+	Ingredients<OtherConfig> otherIngredients;
+	EXPECT_THROW(readSystemCheckpoint("checkpointTestErrors.chk",otherIngredients),std::runtime_error);
+
+	//truncated file
+	std::string contents=fileContents("checkpointTestErrors.chk");
+	std::ofstream truncated("checkpointTestErrors.chk",std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+	truncated.write(contents.data(),contents.size()/2);
+	truncated.close();
+	EXPECT_THROW(readSystemCheckpoint("checkpointTestErrors.chk",ingredients),std::runtime_error);
+
+	std::remove("checkpointTestErrors.chk");
+}
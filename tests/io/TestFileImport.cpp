@@ -29,6 +29,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <cstdio>
 #include <sstream>
+#include <fstream>
 
 #include <LeMonADE/core/Molecules.h>
 #include <LeMonADE/core/Ingredients.h>
@@ -37,6 +38,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/feature/FeatureBondset.h>
 #include <LeMonADE/io/FileImport.h>
 #include <LeMonADE/io/AbstractRead.h>
+#include <LeMonADE/io/BfmFileIndex.h>
 
 using namespace std;
 /************************************************************************/
@@ -491,3 +493,180 @@ TEST_F(FileImportTest, getMinMaxAge)
     EXPECT_EQ(2000000,file.getMaxAge());
     EXPECT_EQ(1000,file.getMinAge());
 }
+
+/* *****************************************************************************
+ * check the sidecar frame index written by scanFile()
+ */
+
+TEST_F(FileImportTest, FrameIndex)
+{
+	typedef LOKI_TYPELIST_1(FeatureMoleculesIO)	Features;
+	typedef ConfigureSystem<VectorInt3,Features> Config;
+	typedef Ingredients < Config> MyIngredients;
+
+	//write the first two frames of a test file to a temporary file
+	std::ifstream source("tests/fileImportTest.test");
+	std::stringstream content;
+	content<<source.rdbuf();
+	std::string completeFile=content.str();
+	size_t lastFrame=completeFile.find("!mcs=30");
+	ASSERT_NE(std::string::npos,lastFrame);
+
+	std::string tmpFile("tests/frameIndexTest.bfm");
+	std::string indexFile=BfmFileIndex::indexFilenameOf(tmpFile);
+	std::remove(indexFile.c_str());
+	{
+		std::ofstream out(tmpFile.c_str());
+		out<<completeFile.substr(0,lastFrame);
+	}
+
+	//first access: the file is scanned and the index is written
+	{
+		MyIngredients ingredients;
+		FileImport<MyIngredients> file(tmpFile,ingredients);
+		file.setUseFrameIndex(true);
+		file.initialize();
+		EXPECT_EQ(2,file.getNumFrames());
+	}
+	BfmFileIndex index(tmpFile);
+	EXPECT_EQ(BfmFileIndex::Valid,index.load());
+	ASSERT_EQ(2,index.getEntries().size());
+	EXPECT_EQ(10,index.getEntries()[0].mcs);
+	EXPECT_EQ(20,index.getEntries()[1].mcs);
+
+	//second access: the positions are taken from the index
+	{
+		MyIngredients ingredients;
+		FileImport<MyIngredients> file(tmpFile,ingredients);
+		file.setUseFrameIndex(true);
+		file.initialize();
+		EXPECT_EQ(2,file.getNumFrames());
+		file.gotoMcs(20);
+		EXPECT_EQ(20,ingredients.getMolecules().getAge());
+		EXPECT_EQ(VectorInt3(3,5,4),ingredients.getMolecules()[3]);
+	}
+
+	//append the last frame: only the new part is scanned
+	{
+		std::ofstream out(tmpFile.c_str(),std::ios_base::app);
+		out<<completeFile.substr(lastFrame);
+	}
+	EXPECT_EQ(BfmFileIndex::Grown,index.load());
+	{
+		MyIngredients ingredients;
+		FileImport<MyIngredients> file(tmpFile,ingredients);
+		file.setUseFrameIndex(true);
+		file.initialize();
+		EXPECT_EQ(3,file.getNumFrames());
+		file.gotoFrame(3);
+		EXPECT_EQ(30,ingredients.getMolecules().getAge());
+		EXPECT_EQ(VectorInt3(20,20,20),ingredients.getMolecules()[9]);
+		file.gotoMcs(10);
+		EXPECT_EQ(10,ingredients.getMolecules().getAge());
+	}
+	EXPECT_EQ(BfmFileIndex::Valid,index.load());
+	EXPECT_EQ(3,index.getEntries().size());
+
+	//a corrupted number of frames or a truncated index invalidates the index
+	{
+		std::ifstream in(indexFile.c_str(),std::ios_base::binary);
+		std::stringstream indexContent;
+		indexContent<<in.rdbuf();
+		std::string validIndex=indexContent.str();
+		ASSERT_EQ(48+3*24,validIndex.size());
+
+		std::string corrupted(validIndex);
+		uint64_t nEntries=uint64_t(1)<<60;
+		corrupted.replace(40,sizeof(nEntries),reinterpret_cast<const char*>(&nEntries),sizeof(nEntries));
+		{
+			std::ofstream out(indexFile.c_str(),std::ios_base::binary|std::ios_base::trunc);
+			out<<corrupted;
+		}
+		EXPECT_EQ(BfmFileIndex::Invalid,index.load());
+		EXPECT_EQ(0,index.getEntries().size());
+
+		{
+			std::ofstream out(indexFile.c_str(),std::ios_base::binary|std::ios_base::trunc);
+			out<<validIndex.substr(0,validIndex.size()-24);
+		}
+		EXPECT_EQ(BfmFileIndex::Invalid,index.load());
+
+		//the file is scanned again and the index is rewritten
+		MyIngredients ingredients;
+		FileImport<MyIngredients> file(tmpFile,ingredients);
+		file.setUseFrameIndex(true);
+		EXPECT_NO_THROW(file.initialize());
+		EXPECT_EQ(3,file.getNumFrames());
+	}
+	EXPECT_EQ(BfmFileIndex::Valid,index.load());
+
+	//a modified file invalidates the index
+	{
+		std::ofstream out(tmpFile.c_str());
+		out<<completeFile.substr(0,lastFrame-1)<<"\n";
+	}
+	EXPECT_EQ(BfmFileIndex::Invalid,index.load());
+	EXPECT_EQ(0,index.getEntries().size());
+
+	//the index is disabled by default
+	std::remove(indexFile.c_str());
+	{
+		MyIngredients ingredients;
+		FileImport<MyIngredients> file(tmpFile,ingredients);
+		EXPECT_FALSE(file.getUseFrameIndex());
+		file.initialize();
+		EXPECT_EQ(2,file.getNumFrames());
+	}
+	EXPECT_EQ(BfmFileIndex::Missing,index.load());
+
+	std::remove(tmpFile.c_str());
+}
+
+/* *****************************************************************************
+ * check that the frame positions can be taken over from another FileImport
+ */
+
+TEST_F(FileImportTest, InitializeFromScannedFile)
+{
+	typedef LOKI_TYPELIST_1(FeatureMoleculesIO)	Features;
+	typedef ConfigureSystem<VectorInt3,Features> Config;
+	typedef Ingredients < Config> MyIngredients;
+
+	MyIngredients scannedIngredients;
+	FileImport<MyIngredients> scannedFile("tests/fileImportTest.test",scannedIngredients);
+	scannedFile.setUseFrameIndex(false);
+
+	MyIngredients ingredients;
+	FileImport<MyIngredients> file("tests/fileImportTest.test",ingredients);
+	file.setUseFrameIndex(false);
+
+	//the frame positions of an uninitialized file cannot be used
+	EXPECT_THROW(file.initialize(scannedFile),std::runtime_error);
+
+	scannedFile.initialize();
+
+	//the file is not scanned again
+	std::stringstream output;
+	std::streambuf* coutBuffer=std::cout.rdbuf(output.rdbuf());
+	file.initialize(scannedFile);
+	std::cout.rdbuf(coutBuffer);
+	EXPECT_EQ(std::string::npos,output.str().find("scanning file"));
+
+	EXPECT_EQ(10,ingredients.getMolecules().getAge());
+	EXPECT_EQ(scannedFile.getNumFrames(),file.getNumFrames());
+	for(uint32_t frame=1;frame<=file.getNumFrames();frame++)
+		EXPECT_EQ(scannedFile.frameHasCommands(frame),file.frameHasCommands(frame));
+
+	file.gotoFrame(3);
+	EXPECT_EQ(30,ingredients.getMolecules().getAge());
+	EXPECT_EQ(VectorInt3(20,20,20),ingredients.getMolecules()[9]);
+	file.gotoMcs(20);
+	EXPECT_EQ(20,ingredients.getMolecules().getAge());
+	EXPECT_EQ(VectorInt3(3,5,4),ingredients.getMolecules()[3]);
+
+	//a FileImport of another file is rejected
+	MyIngredients otherIngredients;
+	FileImport<MyIngredients> otherFile("tests/fileImportTest.test",otherIngredients);
+	otherFile.setFilename("tests/other.bfm");
+	EXPECT_THROW(otherFile.initialize(scannedFile),std::runtime_error);
+}
@@ -0,0 +1,185 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <sstream>
+#include <fstream>
+
+#include <LeMonADE/core/Molecules.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
+#include <LeMonADE/feature/FeatureAttributes.h>
+#include <LeMonADE/io/FileImport.h>
+#include <LeMonADE/io/MappedFileBuffer.h>
+
+using namespace std;
+
+/************************************************************************/
+//test fixture suppressing the output to cout during the tests
+/************************************************************************/
+class MappedFileBufferTest: public ::testing::Test{
+public:
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=cout.rdbuf();
+    cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    cout.rdbuf(originalBuffer);
+  };
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+/* *****************************************************************************
+ * the buffer must behave like an ordinary input stream buffer
+ * ****************************************************************************/
+TEST_F(MappedFileBufferTest,StreamInterface)
+{
+	MappedFileBuffer buffer;
+	EXPECT_FALSE(buffer.is_open());
+	EXPECT_FALSE(buffer.open("nofile.bfm"));
+
+	ASSERT_TRUE(buffer.open("tests/fileImportTest.test"));
+	EXPECT_TRUE(buffer.is_open());
+
+	//compare with the content read by std::ifstream
+	std::ifstream reference("tests/fileImportTest.test");
+	std::istream mapped(&buffer);
+
+	std::string line,referenceLine;
+	while(getline(reference,referenceLine))
+	{
+		ASSERT_TRUE(getline(mapped,line));
+		EXPECT_EQ(referenceLine,line);
+	}
+	EXPECT_FALSE(getline(mapped,line));
+
+	//seek and tell
+	mapped.clear();
+	mapped.seekg(0);
+	std::streampos start=mapped.tellg();
+	EXPECT_EQ(std::streampos(0),start);
+	getline(mapped,line);
+	EXPECT_EQ("!number_of_monomers=10",line);
+	std::streampos second=mapped.tellg();
+	getline(mapped,line);
+	mapped.seekg(second);
+	getline(mapped,referenceLine);
+	EXPECT_EQ(line,referenceLine);
+
+	mapped.seekg(0,std::ios_base::end);
+	EXPECT_EQ(std::streampos(buffer.size()),mapped.tellg());
+
+	buffer.close();
+	EXPECT_FALSE(buffer.is_open());
+}
+
+/* *****************************************************************************
+ * check the zero-copy integer decoding
+ * ****************************************************************************/
+TEST_F(MappedFileBufferTest,ParseInteger)
+{
+	std::string text(" 12 -7\t+3 x");
+	const char* pos=text.c_str();
+	const char* end=pos+text.size();
+	int value=0;
+
+	EXPECT_TRUE(MappedFileBuffer::parseInteger(pos,end,value));
+	EXPECT_EQ(12,value);
+	EXPECT_TRUE(MappedFileBuffer::parseInteger(pos,end,value));
+	EXPECT_EQ(-7,value);
+	EXPECT_TRUE(MappedFileBuffer::parseInteger(pos,end,value));
+	EXPECT_EQ(3,value);
+
+	//failure leaves the position unchanged
+	const char* before=pos;
+	EXPECT_FALSE(MappedFileBuffer::parseInteger(pos,end,value));
+	EXPECT_EQ(before,pos);
+	EXPECT_EQ(3,value);
+
+	EXPECT_EQ(end,MappedFileBuffer::findLineEnd(text.c_str(),end));
+}
+
+/* *****************************************************************************
+ * reading with and without memory mapping must give the same result
+ * ****************************************************************************/
+TEST_F(MappedFileBufferTest,EquivalentImport)
+{
+	typedef LOKI_TYPELIST_2(FeatureMoleculesIO,FeatureAttributes<>) Features;
+	typedef ConfigureSystem<VectorInt3,Features,7> Config;
+	typedef Ingredients<Config> MyIngredients;
+
+	const char* files[]={"tests/fileImportTest.test","tests/fileImportTest3.test","tests/attributesTest.test"};
+
+	for(size_t f=0;f<3;f++)
+	{
+		MyIngredients mappedIngredients;
+		MyIngredients streamIngredients;
+
+		FileImport<MyIngredients> mappedFile(files[f],mappedIngredients);
+		FileImport<MyIngredients> streamFile(files[f],streamIngredients,false);
+		EXPECT_TRUE(mappedFile.isMemoryMapped());
+		EXPECT_FALSE(streamFile.isMemoryMapped());
+
+		mappedFile.initialize();
+		streamFile.initialize();
+
+		bool mappedRead=true;
+		bool streamRead=true;
+		while(mappedRead && streamRead)
+		{
+			mappedRead=mappedFile.read();
+			streamRead=streamFile.read();
+			EXPECT_EQ(streamRead,mappedRead);
+
+			const MyIngredients::molecules_type& m1=mappedIngredients.getMolecules();
+			const MyIngredients::molecules_type& m2=streamIngredients.getMolecules();
+			ASSERT_EQ(m2.size(),m1.size());
+			EXPECT_EQ(m2.getAge(),m1.getAge());
+			for(size_t n=0;n<m1.size();n++)
+			{
+				EXPECT_EQ(m2[n],m1[n]);
+				EXPECT_EQ(m2[n].getAttributeTag(),m1[n].getAttributeTag());
+				ASSERT_EQ(m2.getNumLinks(n),m1.getNumLinks(n));
+				for(size_t l=0;l<m1.getNumLinks(n);l++)
+					EXPECT_EQ(m2.getNeighborIdx(n,l),m1.getNeighborIdx(n,l));
+			}
+		}
+
+		mappedFile.close();
+		streamFile.close();
+	}
+}
@@ -0,0 +1,113 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class TextBuffer
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <sstream>
+#include <limits>
+
+#include <LeMonADE/io/TextBuffer.h>
+
+using namespace std;
+
+/* *****************************************************************************
+ * the buffer must contain exactly the appended characters
+ * ****************************************************************************/
+TEST(TextBufferTest,Append)
+{
+	TextBuffer buffer;
+	EXPECT_EQ(0u,buffer.size());
+
+	buffer.append('!');
+	buffer.append("mcs=");
+	buffer.append("12345",3);
+	EXPECT_EQ(std::string("!mcs=123"),std::string(buffer.data(),buffer.size()));
+
+	//grow beyond the initial size
+	std::string reference("!mcs=123");
+	for(int n=0;n<1000;n++)
+	{
+		buffer.append(char('a'+n%26));
+		reference+=char('a'+n%26);
+	}
+	EXPECT_EQ(reference,std::string(buffer.data(),buffer.size()));
+
+	std::ostringstream output;
+	buffer.writeTo(output);
+	EXPECT_EQ(reference,output.str());
+
+	//clear keeps nothing of the old contents
+	buffer.clear();
+	EXPECT_EQ(0u,buffer.size());
+	buffer.append("x");
+	EXPECT_EQ(std::string("x"),std::string(buffer.data(),buffer.size()));
+}
+
+/* *****************************************************************************
+ * integers must be formatted like operator<< does
+ * ****************************************************************************/
+template<class IntType>
+std::string formatWithStream(IntType value)
+{
+	std::ostringstream stream;
+	stream<<value;
+	return stream.str();
+}
+
+template<class IntType>
+std::string formatWithBuffer(IntType value)
+{
+	TextBuffer buffer;
+	buffer.appendInteger(value);
+	return std::string(buffer.data(),buffer.size());
+}
+
+TEST(TextBufferTest,AppendInteger)
+{
+	int32_t values32[]={0,1,-1,9,10,-10,99,100,123456,-654321,
+	                    std::numeric_limits<int32_t>::max(),std::numeric_limits<int32_t>::min()};
+	for(size_t n=0;n<sizeof(values32)/sizeof(int32_t);n++)
+		EXPECT_EQ(formatWithStream(values32[n]),formatWithBuffer(values32[n]));
+
+	int64_t values64[]={0,-7,123456789012ll,std::numeric_limits<int64_t>::max(),std::numeric_limits<int64_t>::min()};
+	for(size_t n=0;n<sizeof(values64)/sizeof(int64_t);n++)
+		EXPECT_EQ(formatWithStream(values64[n]),formatWithBuffer(values64[n]));
+
+	uint64_t valuesU64[]={0,10,std::numeric_limits<uint64_t>::max()};
+	for(size_t n=0;n<sizeof(valuesU64)/sizeof(uint64_t);n++)
+		EXPECT_EQ(formatWithStream(valuesU64[n]),formatWithBuffer(valuesU64[n]));
+
+	EXPECT_EQ(std::string("4294967295"),formatWithBuffer(std::numeric_limits<uint32_t>::max()));
+}
@@ -0,0 +1,508 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class MoveReptationSc and UpdaterReptationEquilibration
+ * */
+/*****************************************************************************/
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include <LeMonADE/core/Molecules.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
+#include <LeMonADE/feature/FeatureAttributes.h>
+#include <LeMonADE/feature/FeatureBox.h>
+#include <LeMonADE/feature/FeatureBondset.h>
+#include <LeMonADE/feature/FeatureConnectionSc.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeScIdOnLattice.h>
+#include <LeMonADE/feature/FeatureFixedMonomers.h>
+#include <LeMonADE/feature/FeatureNNInteractionSc.h>
+#include <LeMonADE/feature/FeatureWall.h>
+#include <LeMonADE/updater/UpdaterAddLinearChains.h>
+#include <LeMonADE/updater/UpdaterReptationEquilibration.h>
+#include <LeMonADE/updater/moves/MoveConnectSc.h>
+#include <LeMonADE/updater/moves/MoveLocalSc.h>
+#include <LeMonADE/updater/moves/MoveReptationSc.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+
+class TestMoveReptationSc: public ::testing::Test{
+public:
+  typedef LOKI_TYPELIST_5(FeatureMoleculesIO, FeatureAttributes<>, FeatureFixedMonomers, FeatureBondset<>, FeatureExcludedVolumeSc<FeatureLatticePowerOfTwo<bool> >) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> IngredientsType;
+
+  IngredientsType ingredients;
+
+  //sets up a periodic box and the classic bondset
+  void setupBox(bool periodic=true){
+    ingredients.setBoxX(32);
+    ingredients.setBoxY(32);
+    ingredients.setBoxZ(32);
+    ingredients.setPeriodicX(periodic);
+    ingredients.setPeriodicY(periodic);
+    ingredients.setPeriodicZ(periodic);
+    ingredients.modifyBondset().addBFMclassicBondset();
+  }
+
+  //adds a straight chain of n monomers along x starting at (x,y,z)
+  void addStraightChain(uint32_t n, int32_t x, int32_t y, int32_t z){
+    uint32_t first=ingredients.getMolecules().size();
+    for(uint32_t i=0;i<n;i++){
+      ingredients.modifyMolecules().addMonomer(x+2*int32_t(i),y,z);
+      if(i>0) ingredients.modifyMolecules().connect(first+i-1,first+i);
+    }
+  }
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=std::cout.rdbuf();
+    std::cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    std::cout.rdbuf(originalBuffer);
+  };
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+TEST_F(TestMoveReptationSc, ChainDetection)
+{
+  setupBox();
+  //chain of 5 monomers
+  addStraightChain(5,4,4,4);
+  //single monomer
+  ingredients.modifyMolecules().addMonomer(4,20,4);
+  //star with three arms is not a linear chain
+  ingredients.modifyMolecules().addMonomer(20,20,20);
+  ingredients.modifyMolecules().addMonomer(22,20,20);
+  ingredients.modifyMolecules().addMonomer(20,22,20);
+  ingredients.modifyMolecules().addMonomer(20,20,22);
+  ingredients.modifyMolecules().connect(6,7);
+  ingredients.modifyMolecules().connect(6,8);
+  ingredients.modifyMolecules().connect(6,9);
+  //dimer
+  addStraightChain(2,4,4,20);
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  MoveReptationSc move;
+  move.init(ingredients);
+  EXPECT_EQ(1.0,move.getProbability());
+  ASSERT_EQ(2,move.getNumberOfChains());
+  EXPECT_EQ(0,move.getChainFirst(0));
+  EXPECT_EQ(5,move.getChainLength(0));
+  EXPECT_EQ(10,move.getChainFirst(1));
+  EXPECT_EQ(2,move.getChainLength(1));
+  EXPECT_EQ(0,move.getChainHead(0));
+
+  move.init(ingredients,0,true,VectorInt3(2,0,0));
+  EXPECT_EQ(0,move.getIndex());
+  EXPECT_EQ(1,move.getOldNeighbor());
+  EXPECT_EQ(4,move.getNewNeighbor());
+  EXPECT_EQ(VectorInt3(14,4,4),move.getPosition());
+
+  move.init(ingredients,0,false,VectorInt3(-2,0,0));
+  EXPECT_EQ(4,move.getIndex());
+  EXPECT_EQ(3,move.getOldNeighbor());
+  EXPECT_EQ(0,move.getNewNeighbor());
+  EXPECT_EQ(VectorInt3(2,4,4),move.getPosition());
+
+  EXPECT_ANY_THROW(move.init(ingredients,2,true,VectorInt3(2,0,0)));
+}
+
+TEST_F(TestMoveReptationSc, RingBufferAndLinearize)
+{
+  setupBox();
+  addStraightChain(5,8,8,8);
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  MoveReptationSc move;
+
+  //move the first monomer to the end of the chain
+  move.init(ingredients,0,true,VectorInt3(0,2,0));
+  EXPECT_TRUE(move.check(ingredients));
+  move.apply(ingredients);
+  EXPECT_EQ(VectorInt3(16,10,8),ingredients.getMolecules()[0].getVector3D());
+  EXPECT_TRUE(ingredients.getMolecules().areConnected(4,0));
+  EXPECT_FALSE(ingredients.getMolecules().areConnected(0,1));
+  EXPECT_EQ(1,move.getChainHead(0));
+  EXPECT_EQ(1,move.getChainMonomer(0,0));
+  EXPECT_EQ(0,move.getChainMonomer(0,4));
+  EXPECT_TRUE(ingredients.getLatticeEntry(17,11,9));
+  EXPECT_FALSE(ingredients.getLatticeEntry(8,8,8));
+
+  //the reverse move restores the original conformation
+  move.init(ingredients,0,false,VectorInt3(-2,0,0));
+  EXPECT_EQ(0,move.getIndex());
+  EXPECT_EQ(4,move.getOldNeighbor());
+  EXPECT_EQ(1,move.getNewNeighbor());
+  EXPECT_TRUE(move.check(ingredients));
+  move.apply(ingredients);
+  EXPECT_EQ(VectorInt3(8,8,8),ingredients.getMolecules()[0].getVector3D());
+  EXPECT_TRUE(ingredients.getMolecules().areConnected(0,1));
+  EXPECT_FALSE(ingredients.getMolecules().areConnected(4,0));
+  EXPECT_EQ(0,move.getChainHead(0));
+
+  //two moves of the front end
+  move.init(ingredients,0,true,VectorInt3(0,2,0));
+  EXPECT_TRUE(move.check(ingredients));
+  move.apply(ingredients);
+  move.init(ingredients,0,true,VectorInt3(0,2,0));
+  EXPECT_EQ(1,move.getIndex());
+  EXPECT_EQ(0,move.getNewNeighbor());
+  EXPECT_TRUE(move.check(ingredients));
+  move.apply(ingredients);
+  EXPECT_EQ(2,move.getChainHead(0));
+
+  move.linearize(ingredients);
+  EXPECT_EQ(0,move.getChainHead(0));
+  EXPECT_EQ(VectorInt3(12,8,8),ingredients.getMolecules()[0].getVector3D());
+  EXPECT_EQ(VectorInt3(14,8,8),ingredients.getMolecules()[1].getVector3D());
+  EXPECT_EQ(VectorInt3(16,8,8),ingredients.getMolecules()[2].getVector3D());
+  EXPECT_EQ(VectorInt3(16,10,8),ingredients.getMolecules()[3].getVector3D());
+  EXPECT_EQ(VectorInt3(16,12,8),ingredients.getMolecules()[4].getVector3D());
+  for(uint32_t i=0;i<4;i++)
+    EXPECT_TRUE(ingredients.getMolecules().areConnected(i,i+1));
+  EXPECT_FALSE(ingredients.getMolecules().areConnected(4,0));
+  EXPECT_EQ(4,ingredients.getMolecules().getTotalNumLinks());
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  //a linearized chain is detected again in the same way
+  move.resetChains();
+  move.init(ingredients);
+  EXPECT_EQ(1,move.getNumberOfChains());
+  EXPECT_EQ(5,move.getChainLength(0));
+}
+
+TEST_F(TestMoveReptationSc, Rejections)
+{
+  setupBox();
+  addStraightChain(5,8,8,8);
+  //obstacle at the new position of the front end
+  ingredients.modifyMolecules().addMonomer(16,10,8);
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  MoveReptationSc move;
+
+  //excluded volume
+  move.init(ingredients,0,true,VectorInt3(0,2,0));
+  EXPECT_FALSE(move.check(ingredients));
+  move.init(ingredients,0,true,VectorInt3(0,-2,0));
+  EXPECT_TRUE(move.check(ingredients));
+
+  //bond vector not in the bondset
+  move.init(ingredients,0,true,VectorInt3(0,-4,0));
+  EXPECT_FALSE(move.check(ingredients));
+
+  //fixed end monomer
+  ingredients.modifyMolecules()[0].setMovableTag(false);
+  move.init(ingredients,0,true,VectorInt3(0,-2,0));
+  EXPECT_FALSE(move.check(ingredients));
+  //the other end is still movable
+  move.init(ingredients,0,false,VectorInt3(-2,0,0));
+  EXPECT_EQ(4,move.getIndex());
+  EXPECT_TRUE(move.check(ingredients));
+}
+
+TEST_F(TestMoveReptationSc, Wall)
+{
+  typedef LOKI_TYPELIST_3(FeatureBox, FeatureBondset<>, FeatureWall) WallFeatures;
+  typedef ConfigureSystem<VectorInt3,WallFeatures> WallConfig;
+  typedef Ingredients<WallConfig> WallIngredients;
+
+  WallIngredients ing;
+  ing.setBoxX(32);
+  ing.setBoxY(32);
+  ing.setBoxZ(32);
+  ing.setPeriodicX(true);
+  ing.setPeriodicY(true);
+  ing.setPeriodicZ(true);
+  ing.modifyBondset().addBFMclassicBondset();
+
+  ing.modifyMolecules().addMonomer(8,8,8);
+  ing.modifyMolecules().addMonomer(10,8,8);
+  ing.modifyMolecules().addMonomer(12,8,8);
+  ing.modifyMolecules().connect(0,1);
+  ing.modifyMolecules().connect(1,2);
+
+  //wall in the x-z-plane, monomers must not have y=10
+  Wall wall;
+  wall.setBase(0,11,0);
+  wall.setNormal(0,1,0);
+  ing.addWall(wall);
+  EXPECT_NO_THROW(ing.synchronize());
+
+  MoveReptationSc move;
+  move.init(ing,0,true,VectorInt3(0,2,0));
+  EXPECT_EQ(VectorInt3(12,10,8),move.getPosition());
+  EXPECT_FALSE(move.check(ing));
+  move.init(ing,0,true,VectorInt3(0,-2,0));
+  EXPECT_TRUE(move.check(ing));
+}
+
+TEST_F(TestMoveReptationSc, NonPeriodicBox)
+{
+  setupBox(false);
+  addStraightChain(3,0,0,0);
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  MoveReptationSc move;
+  move.init(ingredients,0,true,VectorInt3(0,-2,0));
+  EXPECT_FALSE(move.check(ingredients));
+  move.init(ingredients,0,true,VectorInt3(0,2,0));
+  EXPECT_TRUE(move.check(ingredients));
+}
+
+TEST_F(TestMoveReptationSc, OverlapWithOldPosition)
+{
+  setupBox();
+  //the front end jumps next to its old position
+  ingredients.modifyMolecules().addMonomer(8,8,8);
+  ingredients.modifyMolecules().addMonomer(10,8,8);
+  ingredients.modifyMolecules().addMonomer(10,10,8);
+  ingredients.modifyMolecules().connect(0,1);
+  ingredients.modifyMolecules().connect(1,2);
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  MoveReptationSc move;
+  move.init(ingredients,0,true,VectorInt3(-2,-1,0));
+  EXPECT_EQ(VectorInt3(8,9,8),move.getPosition());
+  EXPECT_TRUE(move.isOldSite(ingredients,VectorInt3(9,9,9)));
+  EXPECT_TRUE(move.isOldSite(ingredients,VectorInt3(9+32,9-32,9)));
+  EXPECT_FALSE(move.isOldSite(ingredients,VectorInt3(9,10,9)));
+  EXPECT_TRUE(move.check(ingredients));
+  move.apply(ingredients);
+
+  //all lattice sites of the moved monomer are occupied
+  EXPECT_TRUE(ingredients.getLatticeEntry(8,9,8));
+  EXPECT_TRUE(ingredients.getLatticeEntry(9,10,9));
+  EXPECT_FALSE(ingredients.getLatticeEntry(8,8,8));
+  EXPECT_NO_THROW(ingredients.synchronize());
+}
+
+TEST_F(TestMoveReptationSc, NNInteraction)
+{
+  typedef LOKI_TYPELIST_2(FeatureBondset<>, FeatureNNInteractionSc<FeatureLatticePowerOfTwo>) NNFeatures;
+  typedef ConfigureSystem<VectorInt3,NNFeatures> NNConfig;
+  typedef Ingredients<NNConfig> NNIngredients;
+
+  NNIngredients ing;
+  ing.setBoxX(32);
+  ing.setBoxY(32);
+  ing.setBoxZ(32);
+  ing.setPeriodicX(true);
+  ing.setPeriodicY(true);
+  ing.setPeriodicZ(true);
+  ing.modifyBondset().addBFMclassicBondset();
+  ing.setNNInteraction(1,2,0.5);
+
+  ing.modifyMolecules().addMonomer(8,8,8);
+  ing.modifyMolecules().addMonomer(10,8,8);
+  ing.modifyMolecules().addMonomer(12,8,8);
+  ing.modifyMolecules().addMonomer(16,8,8);
+  ing.modifyMolecules().connect(0,1);
+  ing.modifyMolecules().connect(1,2);
+  for(uint32_t i=0;i<3;i++) ing.modifyMolecules()[i].setAttributeTag(1);
+  ing.modifyMolecules()[3].setAttributeTag(2);
+  EXPECT_NO_THROW(ing.synchronize());
+
+  //the front end makes a face contact with the monomer of type 2
+  MoveReptationSc move;
+  move.init(ing,0,true,VectorInt3(2,0,0));
+  move.check(ing);
+  EXPECT_NEAR(std::exp(-2.0),move.getProbability(),1e-10);
+  move.apply(ing);
+  EXPECT_EQ(1,ing.getLatticeEntry(15,9,9));
+
+  //the reverse move has the inverse probability
+  move.init(ing,0,false,VectorInt3(-2,0,0));
+  EXPECT_EQ(0,move.getIndex());
+  move.check(ing);
+  EXPECT_NEAR(std::exp(2.0),move.getProbability(),1e-10);
+  move.apply(ing);
+  EXPECT_EQ(0,ing.getLatticeEntry(15,9,9));
+  EXPECT_EQ(1,ing.getLatticeEntry(9,9,9));
+  EXPECT_NO_THROW(ing.synchronize());
+}
+
+TEST_F(TestMoveReptationSc, MonomerIndicesOnLattice)
+{
+  typedef FeatureExcludedVolumeScIdOnLattice<FeatureLatticePowerOfTwo<uint32_t>, MonomerID > IdExcludedVolume;
+  typedef LOKI_TYPELIST_5(FeatureMoleculesIO, FeatureAttributes<>, FeatureBondset<>, IdExcludedVolume, FeatureConnectionSc) IdFeatures;
+  typedef Ingredients<ConfigureSystem<VectorInt3,IdFeatures,4> > IdIngredientsType;
+
+  IdIngredientsType system;
+  system.setBoxX(32);
+  system.setBoxY(32);
+  system.setBoxZ(32);
+  system.setPeriodicX(true);
+  system.setPeriodicY(true);
+  system.setPeriodicZ(true);
+  system.modifyBondset().addBFMclassicBondset();
+  //reactive chain of 5 monomers, only the ends are unsaturated
+  for(uint32_t i=0;i<5;i++){
+    system.modifyMolecules().addMonomer(8+2*int32_t(i),8,8);
+    system.modifyMolecules()[i].setReactive(true);
+    system.modifyMolecules()[i].setNumMaxLinks(2);
+    if(i>0) system.modifyMolecules().connect(i-1,i);
+  }
+  //reactive monomer, which is connected to the chain at the end
+  system.modifyMolecules().addMonomer(16,12,8);
+  system.modifyMolecules()[5].setReactive(true);
+  system.modifyMolecules()[5].setNumMaxLinks(1);
+  EXPECT_NO_THROW(system.synchronize());
+  EXPECT_EQ(3,system.getNumUnsaturatedReactiveMonomers());
+
+  //move the first monomer to the end of the chain
+  MoveReptationSc move;
+  move.init(system,0,true,VectorInt3(0,2,0));
+  EXPECT_TRUE(move.check(system));
+  move.apply(system);
+  EXPECT_EQ(0,system.getIdFromLattice(16,10,8));
+  EXPECT_EQ(1,system.getIdFromLattice(10,8,8));
+  EXPECT_EQ(uint32_t(-1),system.getIdFromLattice(8,8,8));
+  EXPECT_EQ(uint32_t(-1),system.getIdFromLattice(16,8,8));
+  EXPECT_EQ(3,system.getNumUnsaturatedReactiveMonomers());
+  EXPECT_EQ(1,system.getLatticeEntry(17,11,9));
+
+  //after linearize the lattices hold the new indices
+  move.linearize(system);
+  EXPECT_EQ(VectorInt3(10,8,8),system.getMolecules()[0].getVector3D());
+  EXPECT_EQ(VectorInt3(16,10,8),system.getMolecules()[4].getVector3D());
+  EXPECT_EQ(0,system.getIdFromLattice(10,8,8));
+  EXPECT_EQ(4,system.getIdFromLattice(16,10,8));
+  EXPECT_EQ(uint32_t(-1),system.getIdFromLattice(16,8,8));
+  EXPECT_EQ(3,system.getNumUnsaturatedReactiveMonomers());
+  for(uint32_t i=0;i<5;i++)
+    EXPECT_EQ(i+1,system.getLatticeEntry(system.getMolecules()[i].getVector3D()));
+
+  //a connection finds the monomer at the chain end
+  MoveConnectSc connect;
+  connect.init(system,5,VectorInt3(0,-2,0));
+  EXPECT_EQ(4,connect.getPartner());
+  EXPECT_TRUE(connect.check(system));
+  connect.apply(system);
+  EXPECT_TRUE(system.getMolecules().areConnected(4,5));
+  EXPECT_EQ(1,system.getNumUnsaturatedReactiveMonomers());
+
+  //a reactive dimer taking the reverse bond puts the end back on its own site
+  IdIngredientsType dimer;
+  dimer.setBoxX(32);
+  dimer.setBoxY(32);
+  dimer.setBoxZ(32);
+  dimer.setPeriodicX(true);
+  dimer.setPeriodicY(true);
+  dimer.setPeriodicZ(true);
+  dimer.modifyBondset().addBFMclassicBondset();
+  for(uint32_t i=0;i<2;i++){
+    dimer.modifyMolecules().addMonomer(8+2*int32_t(i),8,8);
+    dimer.modifyMolecules()[i].setReactive(true);
+    dimer.modifyMolecules()[i].setNumMaxLinks(2);
+  }
+  dimer.modifyMolecules().connect(0,1);
+  EXPECT_NO_THROW(dimer.synchronize());
+  EXPECT_EQ(2,dimer.getNumUnsaturatedReactiveMonomers());
+
+  MoveReptationSc dimerMove;
+  dimerMove.init(dimer,0,true,VectorInt3(-2,0,0));
+  EXPECT_EQ(VectorInt3(8,8,8),dimerMove.getPosition());
+  EXPECT_TRUE(dimerMove.check(dimer));
+  dimerMove.apply(dimer);
+  EXPECT_EQ(0,dimer.getIdFromLattice(8,8,8));
+  EXPECT_EQ(1,dimer.getIdFromLattice(10,8,8));
+  EXPECT_EQ(2,dimer.getNumUnsaturatedReactiveMonomers());
+  EXPECT_NO_THROW(dimer.synchronize());
+  EXPECT_EQ(0,dimer.getIdFromLattice(8,8,8));
+}
+
+TEST_F(TestMoveReptationSc, UpdaterReptationEquilibration)
+{
+  RandomNumberGenerators rng;
+  rng.seedAll();
+
+  setupBox();
+  EXPECT_NO_THROW(ingredients.synchronize());
+  UpdaterAddLinearChains<IngredientsType> addChains(ingredients,32,32,1,1);
+  addChains.initialize();
+  addChains.execute();
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  UpdaterReptationEquilibration<IngredientsType,MoveLocalSc> updater(ingredients,10,2.0);
+  updater.initialize();
+  EXPECT_EQ(32,updater.getNumberOfChains());
+  updater.execute();
+  updater.execute();
+
+  EXPECT_EQ(20,ingredients.getMolecules().getAge());
+  EXPECT_EQ(20*32*2,updater.getNumReptationAttempts());
+  EXPECT_GT(updater.getNumReptations(),0);
+  EXPECT_EQ(1,updater.getLinearizationPeriod());
+
+  //the chains are in consecutive order with valid bonds after every execute()
+  const IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+  EXPECT_EQ(32*31,molecules.getTotalNumLinks());
+  for(uint32_t c=0;c<32;c++)
+    for(uint32_t i=0;i<31;i++){
+      uint32_t idx=32*c+i;
+      ASSERT_TRUE(molecules.areConnected(idx,idx+1));
+      EXPECT_TRUE(ingredients.getBondset().isValid(molecules[idx+1]-molecules[idx]));
+    }
+
+  //lattice occupation is consistent with the positions
+  uint32_t nOccupied=0;
+  for(int32_t x=0;x<32;x++)
+    for(int32_t y=0;y<32;y++)
+      for(int32_t z=0;z<32;z++)
+        if(ingredients.getLatticeEntry(x,y,z)) nOccupied++;
+  EXPECT_EQ(8*molecules.size(),nOccupied);
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  //keeping the ring buffers leaves rotated chains until cleanup()
+  updater.setLinearizationPeriod(0);
+  updater.execute();
+  EXPECT_EQ(32*31,molecules.getTotalNumLinks());
+  uint32_t nRotated=0;
+  for(uint32_t c=0;c<32;c++)
+    if(molecules.areConnected(32*c,32*c+31)) nRotated++;
+  EXPECT_GT(nRotated,0u);
+
+  updater.cleanup();
+  EXPECT_EQ(32*31,molecules.getTotalNumLinks());
+  for(uint32_t c=0;c<32;c++)
+    for(uint32_t i=0;i<31;i++)
+      ASSERT_TRUE(molecules.areConnected(32*c+i,32*c+i+1));
+  EXPECT_NO_THROW(ingredients.synchronize());
+}
@@ -36,6 +36,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <cstdio>
 #include <sstream>
+#include <fstream>
 
 #include <LeMonADE/core/Molecules.h>
 #include <LeMonADE/core/Ingredients.h>
@@ -202,3 +203,170 @@ TEST_F(ReadBfmFileTest, getMinMaxAge)
     EXPECT_EQ(2000000,file.getMaxAge());
     EXPECT_EQ(1000,file.getMinAge());
 }
+
+/* *****************************************************************************
+ * reading with decoder threads must give the same frames as sequential reading,
+ * also if bonds are added or removed between the frames
+ */
+
+TEST_F(ReadBfmFileTest, PipelinedReading)
+{
+	typedef LOKI_TYPELIST_1(FeatureMoleculesIO) Features;
+	typedef ConfigureSystem<VectorInt3,Features,5> Config;
+	typedef Ingredients<Config> PipelineIngredients;
+
+	//write a file changing the bonds between some frames
+	std::string tmpFile("tests/pipelinedReadingTest.bfm");
+	{
+		std::ofstream out(tmpFile.c_str());
+		out<<"!number_of_monomers=4\n\n!box_x=64\n!box_y=64\n!box_z=64\n"
+		   <<"!periodic_x=1\n!periodic_y=1\n!periodic_z=1\n\n"
+		   <<"!set_of_bondvectors\n2 0 0:17\n-2 0 0:18\n\n!bonds\n2 3\n\n";
+		for(int frame=1;frame<=40;frame++)
+		{
+			if(frame==5) out<<"!add_bonds\n1 2\n\n";
+			if(frame==12) out<<"!remove_bonds\n1 2\n\n";
+			if(frame==13) out<<"!add_bonds\n3 4\n\n";
+			if(frame==30) out<<"!remove_bonds\n2 3\n\n";
+			out<<"!mcs="<<100*frame<<"\n";
+			for(int n=0;n<4;n++) out<<frame+2*n<<" "<<2*frame<<" "<<-frame<<"\n";
+			out<<"\n";
+		}
+	}
+
+	//the same trajectory starting at mcs 0, gotoStart() then applies the first frame
+	std::string tmpFileMcs0("tests/pipelinedReadingTestMcs0.bfm");
+	{
+		std::ofstream out(tmpFileMcs0.c_str());
+		out<<"!number_of_monomers=4\n\n!box_x=64\n!box_y=64\n!box_z=64\n"
+		   <<"!periodic_x=1\n!periodic_y=1\n!periodic_z=1\n\n"
+		   <<"!set_of_bondvectors\n2 0 0:17\n-2 0 0:18\n\n!bonds\n2 3\n\n";
+		for(int frame=1;frame<=12;frame++)
+		{
+			out<<"!mcs="<<100*(frame-1)<<"\n";
+			for(int n=0;n<4;n++) out<<frame+2*n<<" "<<2*frame<<" "<<-frame<<"\n";
+			out<<"\n";
+		}
+	}
+
+	const char* files[]={"tests/fileImportTest3.test","tests/pipelinedReadingTest.bfm","tests/pipelinedReadingTestMcs0.bfm"};
+
+	for(size_t f=0;f<3;f++)
+	{
+		PipelineIngredients sequential;
+		PipelineIngredients pipelined;
+
+		UpdaterReadBfmFile<PipelineIngredients> sequentialReader(files[f],sequential,UpdaterReadBfmFile<PipelineIngredients>::READ_STEPWISE);
+		UpdaterReadBfmFile<PipelineIngredients> pipelinedReader(files[f],pipelined,UpdaterReadBfmFile<PipelineIngredients>::READ_STEPWISE,2,3);
+
+		//the generated file is read with the sidecar frame index, the fixture without
+		if(f==1) pipelinedReader.setUseFrameIndex(true);
+		sequentialReader.initialize();
+		pipelinedReader.initialize();
+
+		bool sequentialRead=true;
+		bool pipelinedRead=true;
+		size_t nFrames=1;
+		do
+		{
+			ASSERT_EQ(sequential.getMolecules().size(),pipelined.getMolecules().size());
+			EXPECT_EQ(sequential.getMolecules().getAge(),pipelined.getMolecules().getAge());
+			for(size_t n=0;n<sequential.getMolecules().size();n++)
+			{
+				EXPECT_EQ(sequential.getMolecules()[n],pipelined.getMolecules()[n]);
+				ASSERT_EQ(sequential.getMolecules().getNumLinks(n),pipelined.getMolecules().getNumLinks(n));
+				for(size_t l=0;l<sequential.getMolecules().getNumLinks(n);l++)
+					EXPECT_EQ(sequential.getMolecules().getNeighborIdx(n,l),pipelined.getMolecules().getNeighborIdx(n,l));
+			}
+
+			sequentialRead=sequentialReader.execute();
+			pipelinedRead=pipelinedReader.execute();
+			EXPECT_EQ(sequentialRead,pipelinedRead);
+			if(pipelinedRead) nFrames++;
+		}while(sequentialRead && pipelinedRead);
+
+		EXPECT_EQ(sequentialReader.getNumFrames(),nFrames);
+
+		//jumping back restarts the decoding, the frames follow in the same order
+		pipelinedReader.gotoStart();
+		sequentialReader.gotoStart();
+		EXPECT_EQ(sequential.getMolecules().getAge(),pipelined.getMolecules().getAge());
+		do
+		{
+			sequentialRead=sequentialReader.execute();
+			pipelinedRead=pipelinedReader.execute();
+			EXPECT_EQ(sequentialRead,pipelinedRead);
+			EXPECT_EQ(sequential.getMolecules().getAge(),pipelined.getMolecules().getAge());
+			for(size_t n=0;n<sequential.getMolecules().size();n++)
+				EXPECT_EQ(sequential.getMolecules()[n],pipelined.getMolecules()[n]);
+		}while(sequentialRead && pipelinedRead);
+	}
+
+	//bonds in the generated file, the frames with commands are taken from the index
+	{
+		PipelineIngredients ing;
+		FileImport<PipelineIngredients> file(tmpFile,ing);
+		file.setUseFrameIndex(true);
+		file.initialize();
+		EXPECT_FALSE(file.frameHasCommands(4));
+		EXPECT_TRUE(file.frameHasCommands(5));
+		EXPECT_TRUE(file.frameHasCommands(12));
+		EXPECT_FALSE(file.frameHasCommands(14));
+	}
+
+	std::remove(tmpFile.c_str());
+	std::remove(BfmFileIndex::indexFilenameOf(tmpFile).c_str());
+	std::remove(tmpFileMcs0.c_str());
+}
+
+/* *****************************************************************************
+ * commands with the last frame and after it are processed exactly once
+ */
+
+TEST_F(ReadBfmFileTest, PipelinedReadingCommandsInLastFrame)
+{
+	typedef LOKI_TYPELIST_1(FeatureMoleculesIO) Features;
+	typedef ConfigureSystem<VectorInt3,Features,5> Config;
+	typedef Ingredients<Config> PipelineIngredients;
+
+	std::string tmpFile("tests/pipelinedLastFrameTest.bfm");
+	{
+		std::ofstream out(tmpFile.c_str());
+		out<<"!number_of_monomers=4\n\n!box_x=64\n!box_y=64\n!box_z=64\n"
+		   <<"!periodic_x=1\n!periodic_y=1\n!periodic_z=1\n\n"
+		   <<"!set_of_bondvectors\n2 0 0:17\n-2 0 0:18\n\n!bonds\n2 3\n\n";
+		for(int frame=1;frame<=10;frame++)
+		{
+			if(frame==10) out<<"!remove_bonds\n2 3\n\n!add_bonds\n1 2\n\n";
+			out<<"!mcs="<<100*frame<<"\n";
+			for(int n=0;n<4;n++) out<<frame+2*n<<" "<<2*frame<<" "<<-frame<<"\n";
+			out<<"\n";
+		}
+		out<<"!add_bonds\n3 4\n\n";
+	}
+
+	PipelineIngredients sequential;
+	PipelineIngredients pipelined;
+
+	UpdaterReadBfmFile<PipelineIngredients> sequentialReader(tmpFile,sequential,UpdaterReadBfmFile<PipelineIngredients>::READ_STEPWISE);
+	UpdaterReadBfmFile<PipelineIngredients> pipelinedReader(tmpFile,pipelined,UpdaterReadBfmFile<PipelineIngredients>::READ_STEPWISE,2,3);
+	sequentialReader.initialize();
+	pipelinedReader.initialize();
+
+	while(sequentialReader.execute());
+	EXPECT_NO_THROW(while(pipelinedReader.execute()););
+	EXPECT_FALSE(pipelinedReader.execute());
+
+	EXPECT_EQ(1000,pipelined.getMolecules().getAge());
+	for(size_t n=0;n<4;n++)
+	{
+		EXPECT_EQ(sequential.getMolecules()[n],pipelined.getMolecules()[n]);
+		ASSERT_EQ(sequential.getMolecules().getNumLinks(n),pipelined.getMolecules().getNumLinks(n));
+	}
+	EXPECT_TRUE(pipelined.getMolecules().areConnected(0,1));
+	EXPECT_FALSE(pipelined.getMolecules().areConnected(1,2));
+	EXPECT_TRUE(pipelined.getMolecules().areConnected(2,3));
+
+	std::remove(tmpFile.c_str());
+	std::remove(BfmFileIndex::indexFilenameOf(tmpFile).c_str());
+}
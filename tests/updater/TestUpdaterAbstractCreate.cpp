@@ -154,6 +154,22 @@ private:
   using BaseClass::linearizeSystem;
 };
 
+//Define a test class giving access to the placement functions
+template<class IngredientsType>
+class UpdaterTestFreeSites: public UpdaterAbstractCreate<IngredientsType>
+{
+  typedef UpdaterAbstractCreate<IngredientsType> BaseClass;
+
+public:
+  UpdaterTestFreeSites(IngredientsType& ingredients_):BaseClass(ingredients_){}
+
+  virtual bool execute(){return true;}
+
+  bool addAtPosition(VectorInt3 pos){return BaseClass::addMonomerAtPosition(pos);}
+  bool addToParent(uint32_t parent_id){return BaseClass::addMonomerToParent(parent_id);}
+  void updateIndex(){BaseClass::updateFreeSites();}
+};
+
 TEST_F(UpdaterAbstractCreateTest, Constructor)
 {
   typedef LOKI_TYPELIST_3(FeatureMoleculesIO, FeatureExcludedVolumeSc< FeatureLatticePowerOfTwo <uint8_t> >,FeatureAttributes<>) Features;
@@ -328,3 +344,99 @@ TEST_F(UpdaterAbstractCreateTest, TestUpdater)
 
 }
 
+TEST_F(UpdaterAbstractCreateTest, OutdatedFreeSites)
+{
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO, FeatureExcludedVolumeSc< FeatureLatticePowerOfTwo <uint8_t> >,FeatureAttributes<>) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> IngredientsType;
+
+  IngredientsType ingredients;
+  ingredients.setBoxX(32);
+  ingredients.setBoxY(32);
+  ingredients.setBoxZ(32);
+  ingredients.setPeriodicX(true);
+  ingredients.setPeriodicY(true);
+  ingredients.setPeriodicZ(true);
+  ingredients.modifyBondset().addBFMclassicBondset();
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  UpdaterTestFreeSites<IngredientsType> updater(ingredients);
+
+  //a parent enclosed by a cage of 26 monomers, which blocks every bond vector
+  const VectorInt3 parent(16,16,16);
+  EXPECT_TRUE(updater.addAtPosition(parent));
+  for(int32_t x=-2;x<=2;x+=2)
+    for(int32_t y=-2;y<=2;y+=2)
+      for(int32_t z=-2;z<=2;z+=2)
+	if(x!=0 || y!=0 || z!=0)
+	  EXPECT_TRUE(updater.addAtPosition(parent+VectorInt3(x,y,z)));
+  ingredients.synchronize();
+  updater.updateIndex();
+
+  //remove the cage without telling the updater, the index still reports the parent as enclosed
+  for(uint32_t n=1;n<ingredients.getMolecules().size();n++){
+    VectorInt3 pos(ingredients.getMolecules()[n]);
+    ingredients.modifyMolecules()[n].setAllCoordinates(pos.getX(),pos.getY(),pos.getZ()-12);
+  }
+  ingredients.synchronize();
+
+  //the outdated index is rebuilt instead of moving the parent out of its place
+  EXPECT_TRUE(updater.addToParent(0));
+  EXPECT_EQ(28,ingredients.getMolecules().size());
+  EXPECT_EQ(parent,ingredients.getMolecules()[0]);
+  EXPECT_TRUE(ingredients.getMolecules().areConnected(0,27));
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  //the index can be invalidated by the user of the updater after changing the system
+  updater.invalidateFreeSites();
+  EXPECT_TRUE(updater.addToParent(27));
+  EXPECT_NO_THROW(ingredients.synchronize());
+}
+
+TEST_F(UpdaterAbstractCreateTest, LongBondFallback)
+{
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO, FeatureExcludedVolumeSc< FeatureLatticePowerOfTwo <uint8_t> >,FeatureAttributes<>) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> IngredientsType;
+
+  const VectorInt3 parent(16,16,16);
+  const VectorInt3 axes[3]={VectorInt3(2,0,0),VectorInt3(0,2,0),VectorInt3(0,0,2)};
+
+  for(int fallback=0;fallback<2;fallback++)
+  {
+    IngredientsType ingredients;
+    ingredients.setBoxX(32);
+    ingredients.setBoxY(32);
+    ingredients.setBoxZ(32);
+    ingredients.setPeriodicX(true);
+    ingredients.setPeriodicY(true);
+    ingredients.setPeriodicZ(true);
+    ingredients.modifyBondset().addBFMclassicBondset();
+    EXPECT_NO_THROW(ingredients.synchronize());
+
+    UpdaterTestFreeSites<IngredientsType> updater(ingredients);
+    EXPECT_FALSE(updater.getLongBondFallback());
+    updater.setLongBondFallback(fallback==1);
+
+    //the six bond vectors of length 2 are blocked, some longer ones are free
+    EXPECT_TRUE(updater.addAtPosition(parent));
+    for(int n=0;n<3;n++){
+      EXPECT_TRUE(updater.addAtPosition(parent+axes[n]));
+      EXPECT_TRUE(updater.addAtPosition(parent-axes[n]));
+    }
+
+    EXPECT_TRUE(updater.addToParent(0));
+    ASSERT_EQ(8,ingredients.getMolecules().size());
+    VectorInt3 bond(ingredients.getMolecules()[7]-ingredients.getMolecules()[0]);
+    if(fallback==1){
+      //the long bond is taken without moving the parent
+      EXPECT_EQ(parent,ingredients.getMolecules()[0]);
+      EXPECT_GT(bond*bond,4);
+    }
+    else{
+      //by default the system is relaxed until a bond of length 2 is free
+      EXPECT_EQ(4,bond*bond);
+    }
+    EXPECT_NO_THROW(ingredients.synchronize());
+  }
+}
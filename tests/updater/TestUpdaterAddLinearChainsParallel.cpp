@@ -0,0 +1,285 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for UpdaterAddLinearChainsParallel
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <map>
+#include <sstream>
+
+#include <LeMonADE/core/Molecules.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
+#include <LeMonADE/feature/FeatureAttributes.h>
+#include <LeMonADE/updater/UpdaterAddLinearChains.h>
+#include <LeMonADE/updater/UpdaterAddLinearChainsParallel.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+
+using namespace std;
+
+class TestUpdaterAddLinearChainsParallel: public ::testing::Test{
+public:
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO, FeatureExcludedVolumeSc< FeatureLatticePowerOfTwo <uint8_t> >,FeatureAttributes<>) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> IngredientsType;
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=cout.rdbuf();
+    cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    cout.rdbuf(originalBuffer);
+  };
+
+  void setupBox(IngredientsType& ingredients, int32_t boxX, int32_t boxY, int32_t boxZ, bool periodicZ=true){
+    ingredients.setBoxX(boxX);
+    ingredients.setBoxY(boxY);
+    ingredients.setBoxZ(boxZ);
+    ingredients.setPeriodicX(true);
+    ingredients.setPeriodicY(true);
+    ingredients.setPeriodicZ(periodicZ);
+    ingredients.modifyBondset().addBFMclassicBondset();
+    ingredients.synchronize();
+  }
+
+  //checks that the monomers from first on form linear chains of the given length
+  void checkChains(const IngredientsType& ingredients, uint32_t first, uint32_t chainLength){
+    const IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+    for(uint32_t n=first;n<molecules.size();n++){
+      uint32_t k=(n-first)%chainLength;
+      EXPECT_EQ((k%2==0 ? 1 : 2),molecules[n].getAttributeTag());
+      if(k==0 || k==chainLength-1){
+	EXPECT_EQ(1,molecules.getNumLinks(n));
+      }
+      else{
+	EXPECT_EQ(2,molecules.getNumLinks(n));
+      }
+      if(k>0){
+	EXPECT_TRUE(molecules.areConnected(n-1,n));
+      }
+    }
+  }
+
+  //seeds the random number generators, such that the statistical tests can not fail at random
+  void seedRandomNumbers(uint32_t seed){
+    RandomNumberGenerators rng;
+    rng.seedSTDRAND(seed);
+    uint32_t seedArray[R250_RANDOM_PREFETCH];
+    for(size_t n=0;n<R250_RANDOM_PREFETCH;n++)
+      seedArray[n]=std::rand();
+    rng.seedR250(seedArray);
+  }
+
+  //sums the bond vectors by their squared length and the squared end-to-end distance and radius of gyration of the chains
+  void addStatistics(const IngredientsType& ingredients, uint32_t chainLength, std::map<int32_t,double>& bonds, double& endToEnd, double& gyration){
+    const IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+    for(uint32_t first=0;first+chainLength<=molecules.size();first+=chainLength){
+      VectorInt3 ends(molecules[first+chainLength-1]-molecules[first]);
+      endToEnd+=double(ends*ends);
+      VectorDouble3 center;
+      for(uint32_t n=first;n<first+chainLength;n++)
+	center+=VectorDouble3(molecules[n])/double(chainLength);
+      for(uint32_t n=first;n<first+chainLength;n++){
+	VectorDouble3 distance(VectorDouble3(molecules[n])-center);
+	gyration+=distance*distance/double(chainLength);
+	if(n>first){
+	  VectorInt3 bond(molecules[n]-molecules[n-1]);
+	  bonds[bond*bond]+=1.0;
+	}
+      }
+    }
+  }
+
+  //compares the averages of the serial and the parallel updater over several seeds
+  void compareWithSerial(int32_t boxX, int32_t boxZ, uint32_t nChains, uint32_t chainLength, uint32_t nRuns){
+    std::map<int32_t,double> bonds[2];
+    double endToEnd[2]={0.0,0.0};
+    double gyration[2]={0.0,0.0};
+    for(uint32_t run=0;run<nRuns;run++){
+      seedRandomNumbers(1000+run);
+      IngredientsType serial;
+      setupBox(serial,boxX,boxX,boxZ);
+      UpdaterAddLinearChains<IngredientsType> serialUpdater(serial,nChains,chainLength);
+      serialUpdater.initialize();
+      addStatistics(serial,chainLength,bonds[0],endToEnd[0],gyration[0]);
+
+      seedRandomNumbers(2000+run);
+      IngredientsType parallel;
+      setupBox(parallel,boxX,boxX,boxZ);
+      UpdaterAddLinearChainsParallel<IngredientsType> parallelUpdater(parallel,nChains,chainLength,1,2,4);
+      parallelUpdater.initialize();
+      EXPECT_EQ(4u,parallelUpdater.getNumberOfSlabs());
+      addStatistics(parallel,chainLength,bonds[1],endToEnd[1],gyration[1]);
+    }
+
+    //in a single dense serial setup the fraction of a bond length varies by
+    //about 0.1, as it depends on the few moves of the whole system
+    const double nBonds=double(nRuns)*nChains*(chainLength-1);
+    for(int32_t length=4;length<=10;length++)
+      EXPECT_NEAR(bonds[0][length]/nBonds,bonds[1][length]/nBonds,0.06)<<"squared bond length "<<length;
+    //the end-to-end distance fluctuates more than the radius of gyration
+    EXPECT_NEAR(1.0,endToEnd[1]/endToEnd[0],0.1);
+    EXPECT_NEAR(1.0,gyration[1]/gyration[0],0.05);
+  }
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+TEST_F(TestUpdaterAddLinearChainsParallel, Constructor)
+{
+  IngredientsType ingredients;
+
+  UpdaterAddLinearChainsParallel<IngredientsType> updater(ingredients,1,2,1,2,4);
+  EXPECT_EQ(2,updater.getNMonomerPerChain());
+  EXPECT_EQ(1,updater.getNChain());
+  EXPECT_DOUBLE_EQ(0.0,updater.getDensity());
+  EXPECT_EQ(0u,updater.getNumberOfSlabs());
+  EXPECT_EQ(0u,updater.getNumberOfSerialChains());
+}
+
+TEST_F(TestUpdaterAddLinearChainsParallel, SameStructureAsSerial)
+{
+  //volume fraction 0.5 in four slabs
+  IngredientsType serial;
+  setupBox(serial,32,32,256);
+  UpdaterAddLinearChains<IngredientsType> serialUpdater(serial,512,32);
+  serialUpdater.initialize();
+
+  IngredientsType parallel;
+  setupBox(parallel,32,32,256);
+  UpdaterAddLinearChainsParallel<IngredientsType> parallelUpdater(parallel,512,32,1,2,4);
+  EXPECT_NO_THROW(parallelUpdater.initialize());
+  //repeat execution, should not do anything
+  EXPECT_TRUE(parallelUpdater.execute());
+  EXPECT_EQ(4u,parallelUpdater.getNumberOfSlabs());
+  EXPECT_DOUBLE_EQ(0.5,parallelUpdater.getDensity());
+
+  ASSERT_EQ(serial.getMolecules().size(),parallel.getMolecules().size());
+  //synchronize checks excluded volume and bonds
+  EXPECT_NO_THROW(parallel.synchronize());
+  checkChains(parallel,0,32);
+  for(uint32_t n=0;n<serial.getMolecules().size();n++){
+    EXPECT_EQ(serial.getMolecules()[n].getAttributeTag(),parallel.getMolecules()[n].getAttributeTag());
+    EXPECT_EQ(serial.getMolecules().getNumLinks(n),parallel.getMolecules().getNumLinks(n));
+  }
+}
+
+TEST_F(TestUpdaterAddLinearChainsParallel, SameStatisticsAsSerialDense)
+{
+  //volume fraction 0.5, the chains are relaxed by moves while they grow
+  compareWithSerial(16,128,128,16,32);
+}
+
+TEST_F(TestUpdaterAddLinearChainsParallel, SameStatisticsAsSerialDilute)
+{
+  //volume fraction 0.0625, the chains grow almost without moves
+  compareWithSerial(32,256,128,16,32);
+}
+
+TEST_F(TestUpdaterAddLinearChainsParallel, PrefilledNonPeriodicBox)
+{
+  IngredientsType ingredients;
+  setupBox(ingredients,32,32,128,false);
+  UpdaterAddLinearChains<IngredientsType> first(ingredients,32,16);
+  first.initialize();
+  std::vector<VectorInt3> oldPositions;
+  for(uint32_t n=0;n<ingredients.getMolecules().size();n++)
+    oldPositions.push_back(ingredients.getMolecules()[n]);
+
+  UpdaterAddLinearChainsParallel<IngredientsType> second(ingredients,128,16,1,2,3);
+  EXPECT_NO_THROW(second.initialize());
+  EXPECT_EQ(3u,second.getNumberOfSlabs());
+  ASSERT_EQ(160u*16u,ingredients.getMolecules().size());
+  //the chains reach into the neighboring slabs
+  EXPECT_EQ(16u,second.getHaloThickness());
+  EXPECT_NO_THROW(ingredients.synchronize());
+  checkChains(ingredients,0,16);
+
+  for(uint32_t n=0;n<oldPositions.size();n++)
+    EXPECT_EQ(oldPositions[n],ingredients.getMolecules()[n]);
+  for(uint32_t n=0;n<ingredients.getMolecules().size();n++){
+    EXPECT_GE(ingredients.getMolecules()[n].getZ(),0);
+    EXPECT_LE(ingredients.getMolecules()[n].getZ(),126);
+  }
+}
+
+TEST_F(TestUpdaterAddLinearChainsParallel, SingleSlab)
+{
+  //boxes thinner than two slabs are filled by a single thread
+  IngredientsType ingredients;
+  setupBox(ingredients,16,16,16);
+  UpdaterAddLinearChainsParallel<IngredientsType> updater(ingredients,8,16,1,2,8);
+  EXPECT_NO_THROW(updater.initialize());
+  EXPECT_EQ(1u,updater.getNumberOfSlabs());
+  ASSERT_EQ(128u,ingredients.getMolecules().size());
+  EXPECT_NO_THROW(ingredients.synchronize());
+  checkChains(ingredients,0,16);
+}
+
+TEST_F(TestUpdaterAddLinearChainsParallel, IsotropicChains)
+{
+  //the statistical test uses a fixed seed, such that it can not fail at random
+  RandomNumberGenerators rng;
+  rng.seedSTDRAND(1234);
+  uint32_t seedArray[R250_RANDOM_PREFETCH];
+  for(size_t n=0;n<R250_RANDOM_PREFETCH;n++)
+    seedArray[n]=std::rand();
+  rng.seedR250(seedArray);
+
+  //slabs are much thicker than the extent of a chain, even with many threads
+  IngredientsType ingredients;
+  setupBox(ingredients,32,32,256);
+  UpdaterAddLinearChainsParallel<IngredientsType> updater(ingredients,256,64,1,2,16);
+  EXPECT_NO_THROW(updater.initialize());
+  EXPECT_EQ(4u,updater.getNumberOfSlabs());
+  ASSERT_EQ(256u*64u,ingredients.getMolecules().size());
+  checkChains(ingredients,0,64);
+
+  //the chains are not flattened by the slabs
+  double squaredExtent[3]={0.0,0.0,0.0};
+  for(uint32_t n=0;n<256;n++){
+    VectorInt3 endToEnd(ingredients.getMolecules()[64*n+63]-ingredients.getMolecules()[64*n]);
+    for(size_t d=0;d<3;d++)
+      squaredExtent[d]+=double(endToEnd[d])*double(endToEnd[d])/256.0;
+  }
+  double lateral=0.5*(squaredExtent[0]+squaredExtent[1]);
+  EXPECT_GT(squaredExtent[2],0.7*lateral);
+  EXPECT_LT(squaredExtent[2],1.4*lateral);
+}
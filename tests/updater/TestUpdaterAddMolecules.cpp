@@ -0,0 +1,236 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the updaters derived from UpdaterAbstractAddMolecules
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <vector>
+
+#include <LeMonADE/core/Molecules.h>
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
+#include <LeMonADE/feature/FeatureAttributes.h>
+#include <LeMonADE/updater/UpdaterAddStars.h>
+#include <LeMonADE/updater/UpdaterAddCombs.h>
+#include <LeMonADE/updater/UpdaterAddBottlebrushes.h>
+#include <LeMonADE/updater/UpdaterAddDendrimers.h>
+#include <LeMonADE/updater/UpdaterAddPolydisperseChains.h>
+
+using namespace std;
+
+class TestUpdaterAddMolecules: public ::testing::Test{
+public:
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO, FeatureExcludedVolumeSc< FeatureLatticePowerOfTwo <uint8_t> >,FeatureAttributes<>) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> IngredientsType;
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=cout.rdbuf();
+    cout.rdbuf(tempStream.rdbuf());
+    ingredients.setBoxX(32);
+    ingredients.setBoxY(32);
+    ingredients.setBoxZ(32);
+    ingredients.setPeriodicX(true);
+    ingredients.setPeriodicY(true);
+    ingredients.setPeriodicZ(true);
+    ingredients.modifyBondset().addBFMclassicBondset();
+    ingredients.synchronize();
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    cout.rdbuf(originalBuffer);
+  };
+
+  IngredientsType ingredients;
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+TEST_F(TestUpdaterAddMolecules, Stars)
+{
+  UpdaterAddStars<IngredientsType> stars(ingredients,10,4,8,3,4);
+  EXPECT_EQ(330u,stars.getNumberOfMonomers());
+  EXPECT_NO_THROW(stars.initialize());
+  //repeat execution, should not do anything
+  EXPECT_TRUE(stars.execute());
+  ASSERT_EQ(330u,ingredients.getMolecules().size());
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  const IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+  for(uint32_t s=0;s<10;s++){
+    uint32_t core=33*s;
+    EXPECT_EQ(3,molecules[core].getAttributeTag());
+    EXPECT_EQ(4,molecules.getNumLinks(core));
+    for(uint32_t a=0;a<4;a++){
+      EXPECT_TRUE(molecules.areConnected(core,core+1+8*a));
+      EXPECT_EQ(1,molecules.getNumLinks(core+8*(a+1)));
+      EXPECT_EQ(4,molecules[core+8*(a+1)].getAttributeTag());
+    }
+  }
+}
+
+TEST_F(TestUpdaterAddMolecules, Combs)
+{
+  EXPECT_THROW(UpdaterAddCombs<IngredientsType>(ingredients,1,4,5,2),std::runtime_error);
+
+  UpdaterAddCombs<IngredientsType> combs(ingredients,5,20,4,5);
+  EXPECT_NO_THROW(combs.initialize());
+  ASSERT_EQ(200u,ingredients.getMolecules().size());
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  //side chains at the backbone monomers 2, 7, 12 and 17, each stored after its grafting point
+  const IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+  for(uint32_t c=0;c<5;c++){
+    uint32_t n=40*c;
+    for(uint32_t k=0;k<20;k++){
+      EXPECT_EQ(1,molecules[n].getAttributeTag());
+      uint32_t next=n+1;
+      uint32_t expectedLinks=(k==0 || k==19) ? 1 : 2;
+      if(k%5==2){
+	expectedLinks++;
+	EXPECT_TRUE(molecules.areConnected(n,n+1));
+	for(uint32_t j=1;j<=5;j++)
+	  EXPECT_EQ(2,molecules[n+j].getAttributeTag());
+	EXPECT_EQ(1,molecules.getNumLinks(n+5));
+	next=n+6;
+      }
+      EXPECT_EQ(expectedLinks,molecules.getNumLinks(n));
+      if(k<19)
+	EXPECT_TRUE(molecules.areConnected(n,next));
+      n=next;
+    }
+  }
+}
+
+TEST_F(TestUpdaterAddMolecules, DenseBottlebrushes)
+{
+  //volume fraction 0.375
+  UpdaterAddBottlebrushes<IngredientsType> brushes(ingredients,12,32,3);
+  brushes.setRelaxationSteps(0,10);
+  EXPECT_EQ(32u,brushes.getNSideChains());
+  EXPECT_NO_THROW(brushes.initialize());
+  ASSERT_EQ(12u*32u*4u,ingredients.getMolecules().size());
+  EXPECT_NEAR(0.375,brushes.getDensity(),1e-10);
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  const IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+  for(uint32_t b=0;b<12;b++){
+    uint32_t offset=128*b;
+    for(uint32_t k=0;k<32;k++){
+      EXPECT_EQ((k==0 || k==31) ? 2 : 3,molecules.getNumLinks(offset+4*k));
+      EXPECT_TRUE(molecules.areConnected(offset+4*k,offset+4*k+1));
+      if(k>0)
+	EXPECT_TRUE(molecules.areConnected(offset+4*(k-1),offset+4*k));
+    }
+  }
+}
+
+TEST_F(TestUpdaterAddMolecules, Dendrimers)
+{
+  EXPECT_THROW(UpdaterAddDendrimers<IngredientsType>(ingredients,1,2,3,1),std::runtime_error);
+
+  //core with 3 branches, 3 generations of trifunctional branch points, spacers of 2
+  UpdaterAddDendrimers<IngredientsType> dendrimers(ingredients,4,3,3,3,2,1,2,3);
+  EXPECT_EQ(4u*(1+3*(3+6+12)),dendrimers.getNumberOfMonomers());
+  EXPECT_NO_THROW(dendrimers.initialize());
+  ASSERT_EQ(4u*64u,ingredients.getMolecules().size());
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  const IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+  for(uint32_t d=0;d<4;d++){
+    uint32_t nCore=0, nBranchPoints=0, nEnds=0;
+    for(uint32_t n=64*d;n<64*(d+1);n++){
+      if(molecules[n].getAttributeTag()==1){
+	nCore++;
+	EXPECT_EQ(3,molecules.getNumLinks(n));
+      }
+      else if(molecules[n].getAttributeTag()==2){
+	nBranchPoints++;
+	if(molecules.getNumLinks(n)==1) nEnds++;
+	else EXPECT_EQ(3,molecules.getNumLinks(n));
+      }
+      else EXPECT_EQ(2,molecules.getNumLinks(n));
+    }
+    EXPECT_EQ(1u,nCore);
+    EXPECT_EQ(21u,nBranchPoints);
+    EXPECT_EQ(12u,nEnds);
+  }
+}
+
+TEST_F(TestUpdaterAddMolecules, PolydisperseChains)
+{
+  std::vector<uint32_t> lengths;
+  lengths.push_back(3);
+  lengths.push_back(50);
+  lengths.push_back(1);
+  lengths.push_back(20);
+  UpdaterAddPolydisperseChains<IngredientsType> chains(ingredients,lengths,5,6);
+  EXPECT_NO_THROW(chains.initialize());
+  ASSERT_EQ(74u,ingredients.getMolecules().size());
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  const IngredientsType::molecules_type& molecules=ingredients.getMolecules();
+  EXPECT_EQ(1,molecules.getNumLinks(2));
+  EXPECT_EQ(1,molecules.getNumLinks(3));
+  EXPECT_EQ(1,molecules.getNumLinks(52));
+  EXPECT_EQ(0,molecules.getNumLinks(53));
+  EXPECT_EQ(1,molecules.getNumLinks(54));
+  EXPECT_EQ(5,molecules[54].getAttributeTag());
+  EXPECT_EQ(6,molecules[55].getAttributeTag());
+}
+
+TEST_F(TestUpdaterAddMolecules, ChainLengthDistribution)
+{
+  //half of the chains with 10 and a quarter with 20 and 40 monomers each
+  std::vector<double> distribution(41,0.0);
+  distribution[10]=2.0;
+  distribution[20]=1.0;
+  distribution[40]=1.0;
+  UpdaterAddPolydisperseChains<IngredientsType> chains(ingredients,8,distribution);
+  ASSERT_EQ(8u,chains.getChainLengths().size());
+  uint32_t expected[8]={10,10,10,10,20,20,40,40};
+  for(size_t i=0;i<8;i++)
+    EXPECT_EQ(expected[i],chains.getChainLengths()[i]);
+  EXPECT_NO_THROW(chains.initialize());
+  EXPECT_EQ(160u,ingredients.getMolecules().size());
+
+  EXPECT_THROW(UpdaterAddPolydisperseChains<IngredientsType>(ingredients,8,std::vector<double>(10,0.0)),std::runtime_error);
+  distribution[5]=-1.0;
+  EXPECT_THROW(UpdaterAddPolydisperseChains<IngredientsType>(ingredients,8,distribution),std::runtime_error);
+}
@@ -0,0 +1,169 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class UpdaterReversibleConnection
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <sstream>
+
+#include <LeMonADE/core/Ingredients.h>
+#include <LeMonADE/feature/FeatureConnectionSc.h>
+#include <LeMonADE/feature/FeatureExcludedVolumeSc.h>
+#include <LeMonADE/feature/FeatureFixedMonomers.h>
+#include <LeMonADE/feature/FeatureMoleculesIO.h>
+#include <LeMonADE/updater/UpdaterReversibleConnection.h>
+#include <LeMonADE/updater/moves/MoveConnectSc.h>
+#include <LeMonADE/updater/moves/MoveDisconnectSc.h>
+#include <LeMonADE/updater/moves/MoveLocalSc.h>
+#include <LeMonADE/utility/RandomNumberGenerators.h>
+
+class TestUpdaterReversibleConnection: public ::testing::Test{
+public:
+  typedef LOKI_TYPELIST_4(FeatureMoleculesIO, FeatureFixedMonomers, FeatureConnectionSc, FeatureExcludedVolumeSc< FeatureLatticePowerOfTwo <uint8_t> >) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> IngredientsType;
+  typedef UpdaterReversibleConnection<IngredientsType,MoveLocalSc,MoveConnectSc,MoveDisconnectSc> UpdaterType;
+
+  IngredientsType ingredients;
+
+  //! fixed pairs of reactive monomers, which can only bond to each other
+  void setupPairs(bool movable)
+  {
+    ingredients.setBoxX(32);
+    ingredients.setBoxY(32);
+    ingredients.setBoxZ(32);
+    ingredients.setPeriodicX(true);
+    ingredients.setPeriodicY(true);
+    ingredients.setPeriodicZ(true);
+    ingredients.modifyBondset().addBFMclassicBondset();
+    for(int32_t x=0;x<32;x+=8)
+      for(int32_t y=0;y<32;y+=4)
+        for(int32_t z=0;z<32;z+=4)
+          for(int32_t dx=0;dx<=2;dx+=2)
+          {
+            uint32_t n=ingredients.modifyMolecules().addMonomer(x+dx,y,z);
+            ingredients.modifyMolecules()[n].setReactive(true);
+            ingredients.modifyMolecules()[n].setNumMaxLinks(1);
+            ingredients.modifyMolecules()[n].setMovableTag(movable);
+          }
+    ingredients.synchronize();
+  }
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=std::cout.rdbuf();
+    std::cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output
+  virtual void TearDown(){
+    std::cout.rdbuf(originalBuffer);
+  };
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+TEST_F(TestUpdaterReversibleConnection, Probabilities)
+{
+  setupPairs(false);
+  UpdaterType updater(ingredients);
+  EXPECT_EQ(1.0,updater.getConnectionProbability());
+  EXPECT_EQ(1.0,updater.getBreakProbability());
+  updater.setBondEnergy(-std::log(4.0));
+  EXPECT_DOUBLE_EQ(1.0,updater.getConnectionProbability());
+  EXPECT_DOUBLE_EQ(0.25,updater.getBreakProbability());
+  updater.setBondEnergy(std::log(2.0));
+  EXPECT_DOUBLE_EQ(0.5,updater.getConnectionProbability());
+  EXPECT_DOUBLE_EQ(1.0,updater.getBreakProbability());
+  EXPECT_THROW(updater.setReactionProbabilities(1.5,0.5),std::runtime_error);
+  EXPECT_THROW(updater.setReactionProbabilities(0.5,-0.1),std::runtime_error);
+}
+
+TEST_F(TestUpdaterReversibleConnection, DetailedBalance)
+{
+  //every pair is a two state system with equilibrium constant p_connect/p_break=3
+  RandomNumberGenerators rng;
+  rng.seedAll();
+  setupPairs(false);
+  const uint32_t nPairs=ingredients.getMolecules().size()/2;
+  UpdaterType updater(ingredients,1,0.5);
+  updater.setBondEnergy(-std::log(3.0));
+  updater.initialize();
+  EXPECT_EQ(0.0,updater.getConversion());
+
+  for(uint32_t n=0;n<100;n++) updater.execute();
+
+  double bonded=0.0;
+  const uint32_t nSamples=1000;
+  for(uint32_t n=0;n<nSamples;n++)
+  {
+    updater.execute();
+    bonded+=updater.getConversion();
+
+    //the index of FeatureConnectionSc is kept up to date
+    uint32_t nUnsaturated=0;
+    for(uint32_t m=0;m<ingredients.getMolecules().size();m++)
+      if(ingredients.getMolecules().getNumLinks(m)==0) nUnsaturated++;
+    ASSERT_EQ(nUnsaturated,ingredients.getNumUnsaturatedReactiveMonomers());
+  }
+  bonded/=double(nSamples);
+  //the standard error of the average is about 0.002
+  EXPECT_NEAR(0.75,bonded,0.02);
+  EXPECT_GT(updater.getNumBreaks(),uint64_t(nPairs));
+  EXPECT_EQ(updater.getNumConnections()-updater.getNumBreaks(),uint64_t(updater.getConversion()*nPairs+0.5));
+}
+
+TEST_F(TestUpdaterReversibleConnection, MovingMonomers)
+{
+  setupPairs(true);
+  UpdaterType updater(ingredients,10);
+  updater.setReactionProbabilities(0.5,0.1);
+  updater.initialize();
+  for(uint32_t n=0;n<20;n++)
+  {
+    updater.execute();
+    uint64_t nBonds=0;
+    for(uint32_t m=0;m<ingredients.getMolecules().size();m++)
+    {
+      EXPECT_LE(ingredients.getMolecules().getNumLinks(m),1u);
+      nBonds+=ingredients.getMolecules().getNumLinks(m);
+    }
+    EXPECT_DOUBLE_EQ(double(nBonds)/double(ingredients.getMolecules().size()),updater.getConversion());
+    EXPECT_EQ(updater.getNumConnections()-updater.getNumBreaks(),nBonds/2);
+  }
+  EXPECT_EQ(200u,ingredients.getMolecules().getAge());
+  EXPECT_GT(updater.getNumBreaks(),0u);
+}
@@ -201,3 +201,36 @@ TEST_F(TestUpdaterAddLinearChains, TestCompressedSolvent)
   EXPECT_EQ(79,ingredients.getCompressedOutputIndices().begin()->second);
 }
 
+
+TEST_F(TestUpdaterAddLinearChains, DenseMelt)
+{
+  typedef LOKI_TYPELIST_3(FeatureMoleculesIO, FeatureExcludedVolumeSc< FeatureLatticePowerOfTwo <uint8_t> >,FeatureAttributes<>) Features;
+  typedef ConfigureSystem<VectorInt3,Features> Config;
+  typedef Ingredients<Config> IngredientsType;
+
+  //volume fraction 0.5, the free sites become rare at the end
+  IngredientsType ingredients;
+  ingredients.setBoxX(32);
+  ingredients.setBoxY(32);
+  ingredients.setBoxZ(32);
+  ingredients.setPeriodicX(true);
+  ingredients.setPeriodicY(true);
+  ingredients.setPeriodicZ(true);
+  ingredients.modifyBondset().addBFMclassicBondset();
+  EXPECT_NO_THROW(ingredients.synchronize());
+
+  UpdaterAddLinearChains<IngredientsType> Tommy(ingredients, 64, 32);
+  EXPECT_NO_THROW(Tommy.initialize());
+  EXPECT_DOUBLE_EQ(0.5,Tommy.getDensity());
+  ASSERT_EQ((64*32),ingredients.getMolecules().size());
+
+  //synchronize checks excluded volume and bonds
+  EXPECT_NO_THROW(ingredients.synchronize());
+  for(uint32_t n=0;n<ingredients.getMolecules().size();n++)
+  {
+    if(n%32==0 || n%32==31)
+      EXPECT_EQ(1,ingredients.getMolecules().getNumLinks(n));
+    else
+      EXPECT_EQ(2,ingredients.getMolecules().getNumLinks(n));
+  }
+}
@@ -113,4 +113,61 @@ TEST_F(TestUpdaterSimpleConnectionSc, Conversion)
   EXPECT_EQ( 0.5,update.getConversion());
   
   
-}
\ No newline at end of file
+}
+TEST_F(TestUpdaterSimpleConnectionSc, IndexedReaction)
+{
+  ingredients.setBoxX(16);
+  ingredients.setBoxY(16);
+  ingredients.setBoxZ(16);
+  ingredients.setPeriodicX(true);
+  ingredients.setPeriodicY(true);
+  ingredients.setPeriodicZ(true);
+  ingredients.modifyBondset().addBFMclassicBondset();
+  //reactive monomers with two sites and unreactive ones in between
+  for(int32_t x=0;x<16;x+=4)
+    for(int32_t y=0;y<16;y+=2)
+      for(int32_t z=0;z<16;z+=4)
+      {
+        uint32_t n=ingredients.modifyMolecules().addMonomer(x,y,z);
+        ingredients.modifyMolecules()[n].setReactive(y%4==0);
+        ingredients.modifyMolecules()[n].setNumMaxLinks(2);
+      }
+  ingredients.synchronize();
+  EXPECT_EQ(64u,ingredients.getNumUnsaturatedReactiveMonomers());
+
+  UpdaterSimpleConnection<IngredientsType,MoveLocalSc,MoveConnectSc> update(ingredients,10);
+  update.setConnectionMode(update.IndexedReaction);
+  EXPECT_EQ(update.IndexedReaction,update.getConnectionMode());
+  update.initialize();
+  EXPECT_EQ(0.0,update.getConversion());
+
+  for(uint32_t cycle=0;cycle<10;cycle++)
+  {
+    update.execute();
+
+    //the index contains exactly the unsaturated reactive monomers
+    uint32_t nUnsaturated=0;
+    uint64_t nBonds=0;
+    for(uint32_t n=0;n<ingredients.getMolecules().size();n++)
+    {
+      nBonds+=ingredients.getMolecules().getNumLinks(n);
+      if(ingredients.getMolecules()[n].isReactive() &&
+         ingredients.getMolecules().getNumLinks(n)<ingredients.getMolecules()[n].getNumMaxLinks())
+        nUnsaturated++;
+      //only reactive monomers are connected
+      if(ingredients.getMolecules().getNumLinks(n)>0)
+        EXPECT_TRUE(ingredients.getMolecules()[n].isReactive());
+    }
+    ASSERT_EQ(nUnsaturated,ingredients.getNumUnsaturatedReactiveMonomers());
+    for(uint32_t k=0;k<nUnsaturated;k++)
+    {
+      uint32_t n=ingredients.getUnsaturatedReactiveMonomer(k);
+      EXPECT_TRUE(ingredients.getMolecules()[n].isReactive());
+      EXPECT_LT(ingredients.getMolecules().getNumLinks(n),2u);
+    }
+    EXPECT_EQ(nBonds/2,update.getNumReactions());
+    EXPECT_DOUBLE_EQ(double(nBonds)/128.0,update.getConversion());
+  }
+  EXPECT_GT(update.getNumReactions(),0u);
+  EXPECT_GE(update.getNumReactionAttempts(),update.getNumReactions());
+}
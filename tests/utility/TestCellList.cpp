@@ -0,0 +1,150 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class CellList
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <LeMonADE/utility/CellList.h>
+#include <LeMonADE/utility/R250.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+//! collects all reported pairs with their distance vectors
+struct PairCollector
+{
+  void operator()(uint32_t i, uint32_t j, const VectorInt3& distance)
+  {
+    ASSERT_NE(i,j);
+    std::pair<uint32_t,uint32_t> key(std::min(i,j),std::max(i,j));
+    //every pair only once
+    EXPECT_EQ(pairs.count(key),size_t(0));
+    pairs[key]=(i<j)?distance:VectorInt3(0,0,0)-distance;
+  }
+  std::map<std::pair<uint32_t,uint32_t>,VectorInt3> pairs;
+};
+
+//! minimum image distance component for the brute force comparison
+static int32_t minimumImage(int32_t d, int32_t box, bool periodic)
+{
+  if(!periodic) return d;
+  d%=box;
+  if(d>box/2) d-=box;
+  if(d<-box/2) d+=box;
+  return d;
+}
+
+static void compareWithBruteForce(const uint32_t box[3], const bool periodic[3], double cutoff, size_t nPoints, int32_t spread)
+{
+  R250 rng;
+  std::vector<VectorInt3> positions;
+  for(size_t n=0;n<nPoints;n++)
+    positions.push_back(VectorInt3(int32_t(rng.r250_rand()%(spread*box[0]))-int32_t(box[0]),
+				   int32_t(rng.r250_rand()%(spread*box[1]))-int32_t(box[1]),
+				   int32_t(rng.r250_rand()%(spread*box[2]))-int32_t(box[2])));
+  //some points on top of each other
+  positions.push_back(positions[0]);
+
+  CellList cells;
+  cells.setup(box,periodic,cutoff);
+  cells.build(positions);
+  EXPECT_EQ(cells.getNumberOfPoints(),positions.size());
+
+  PairCollector collector;
+  cells.forEachPair(collector);
+
+  //the same result for disjoint cell ranges
+  PairCollector rangeCollector;
+  size_t nCells=cells.getNumberOfCells();
+  for(size_t part=0;part<3;part++)
+    cells.forEachPair(nCells*part/3,nCells*(part+1)/3,rangeCollector);
+  EXPECT_EQ(rangeCollector.pairs.size(),collector.pairs.size());
+
+  size_t nExpected=0;
+  for(uint32_t i=0;i<positions.size();i++)
+    for(uint32_t j=i+1;j<positions.size();j++)
+    {
+      VectorInt3 d;
+      for(size_t k=0;k<3;k++) d[k]=minimumImage(positions[j][k]-positions[i][k],int32_t(box[k]),periodic[k]);
+      if(d*d>=cutoff*cutoff) continue;
+      nExpected++;
+      std::pair<uint32_t,uint32_t> key(i,j);
+      ASSERT_EQ(collector.pairs.count(key),size_t(1));
+      ASSERT_EQ(rangeCollector.pairs.count(key),size_t(1));
+      //ambiguous images at exactly half the box have the same length
+      EXPECT_EQ(collector.pairs[key]*collector.pairs[key],d*d);
+    }
+  EXPECT_EQ(collector.pairs.size(),nExpected);
+}
+
+TEST(CellListTest, Setup)
+{
+  uint32_t box[3]={16,16,8};
+  bool periodic[3]={true,true,false};
+  CellList cells;
+  EXPECT_THROW(cells.setup(box,periodic,0.0),std::runtime_error);
+  EXPECT_THROW(cells.setup(box,periodic,8.5),std::runtime_error);
+  //non-periodic directions are not restricted
+  EXPECT_NO_THROW(cells.setup(box,periodic,8.0));
+  EXPECT_EQ(cells.getNumberOfCells(0),uint32_t(2));
+  EXPECT_EQ(cells.getNumberOfCells(2),uint32_t(1));
+
+  cells.setup(box,periodic,3.0);
+  EXPECT_EQ(cells.getNumberOfCells(0),uint32_t(5));
+  EXPECT_EQ(cells.getNumberOfCells(2),uint32_t(2));
+  EXPECT_EQ(cells.getNumberOfCells(),size_t(5*5*2));
+}
+
+TEST(CellListTest, PeriodicBox)
+{
+  uint32_t box[3]={16,12,20};
+  bool periodic[3]={true,true,true};
+  compareWithBruteForce(box,periodic,4.0,600,3);
+  compareWithBruteForce(box,periodic,5.5,300,1);
+  //less than three cells per direction
+  compareWithBruteForce(box,periodic,6.0,200,2);
+}
+
+TEST(CellListTest, SmallAndNonPeriodicBox)
+{
+  uint32_t box[3]={8,8,8};
+  bool periodic[3]={true,false,true};
+  compareWithBruteForce(box,periodic,4.0,150,2);
+
+  bool closed[3]={false,false,false};
+  compareWithBruteForce(box,closed,3.0,200,1);
+  compareWithBruteForce(box,closed,20.0,100,2);
+}
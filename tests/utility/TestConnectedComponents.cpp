@@ -0,0 +1,165 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class ConnectedComponents
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <set>
+#include <vector>
+
+#include <LeMonADE/core/Molecules.h>
+#include <LeMonADE/utility/ConnectedComponents.h>
+#include <LeMonADE/utility/DepthIterator.h>
+#include <LeMonADE/utility/R250.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+typedef Molecules<VectorInt3,7> Graph;
+
+//! vertices with at most two bonds
+struct atMostTwoLinks
+{
+  bool operator()(const Graph& g, int i) const {return g.getNumLinks(i)<=2;}
+};
+
+//! components found with GraphIteratorDepthFirst, as fill_connected_groups did before
+template<class Predicate>
+std::vector<std::vector<uint32_t> > referenceComponents(const Graph& graph, const Predicate& pred)
+{
+  std::vector<std::vector<uint32_t> > result;
+  std::set<int> visited;
+  while(true)
+  {
+    GraphIteratorDepthFirst<Graph,Predicate> iter(graph,&visited,pred);
+    if(iter.isEnd()) break;
+    result.push_back(std::vector<uint32_t>());
+    do
+    {
+      result.back().push_back(uint32_t(iter.getVertexIdx()));
+      ++iter;
+    }
+    while(!iter.isEnd());
+  }
+  return result;
+}
+
+//! random branched molecules, vertices of one molecule are not consecutive
+void createRandomGraph(Graph& graph, uint32_t nVertices)
+{
+  R250 rng;
+  graph.resize(nVertices);
+  std::vector<uint32_t> order;
+  for(uint32_t n=0;n<nVertices;n++) order.push_back(n);
+  for(uint32_t n=nVertices-1;n>0;n--) std::swap(order[n],order[rng.r250_rand()%(n+1)]);
+
+  for(uint32_t n=1;n<nVertices;n++)
+  {
+    //new molecule every now and then, else attach to a random earlier vertex
+    if(rng.r250_rand()%10==0) continue;
+    uint32_t partner=order[rng.r250_rand()%n];
+    if(graph.getNumLinks(partner)<4) graph.connect(order[n],partner);
+  }
+  //some rings
+  for(uint32_t n=0;n<nVertices/20;n++)
+  {
+    uint32_t a=rng.r250_rand()%nVertices, b=rng.r250_rand()%nVertices;
+    if(a!=b && !graph.areConnected(a,b) && graph.getNumLinks(a)<7 && graph.getNumLinks(b)<7) graph.connect(a,b);
+  }
+}
+
+TEST(ConnectedComponentsTest, SameAsDepthIterator)
+{
+  Graph graph;
+  createRandomGraph(graph,2000);
+
+  ConnectedComponents components(graph);
+  std::vector<std::vector<uint32_t> > reference=referenceComponents(graph,alwaysTrue());
+  ASSERT_EQ(reference.size(),components.getNumberOfComponents());
+  ASSERT_GT(reference.size(),size_t(50));
+  EXPECT_EQ(size_t(2000),components.getMembers().size());
+  for(size_t c=0;c<reference.size();c++)
+  {
+    ASSERT_EQ(reference[c].size(),components.getComponentSize(c));
+    for(size_t k=0;k<reference[c].size();k++)
+    {
+      EXPECT_EQ(reference[c][k],components.getMember(c,k));
+      EXPECT_EQ(c,components.getComponentId(reference[c][k]));
+    }
+  }
+
+  //with a predicate, excluded vertices belong to no component
+  components.compute(graph,atMostTwoLinks());
+  reference=referenceComponents(graph,atMostTwoLinks());
+  ASSERT_EQ(reference.size(),components.getNumberOfComponents());
+  size_t nIncluded=0;
+  for(size_t c=0;c<reference.size();c++)
+  {
+    ASSERT_EQ(reference[c].size(),components.getComponentSize(c));
+    for(size_t k=0;k<reference[c].size();k++) EXPECT_EQ(reference[c][k],components.getMember(c,k));
+    nIncluded+=reference[c].size();
+  }
+  for(uint32_t n=0;n<graph.size();n++)
+    EXPECT_EQ(graph.getNumLinks(n)>2,components.getComponentId(n)==uint32_t(ConnectedComponents::unassigned));
+  EXPECT_EQ(nIncluded,components.getMembers().size());
+}
+
+TEST(ConnectedComponentsTest, Groups)
+{
+  //linear chains of length 10, connected in reverse order
+  Graph graph;
+  graph.resize(100);
+  for(uint32_t n=99;n>0;n--)
+    if(n%10!=0) graph.connect(n,n-1);
+
+  std::vector<std::vector<uint32_t> > groups;
+  fill_connected_groups(graph,groups,std::vector<uint32_t>(),alwaysTrue());
+  ASSERT_EQ(size_t(10),groups.size());
+  for(size_t c=0;c<10;c++)
+  {
+    ASSERT_EQ(size_t(10),groups[c].size());
+    //traversal starts at the smallest index and follows the chain
+    for(size_t k=0;k<10;k++) EXPECT_EQ(uint32_t(10*c+k),groups[c][k]);
+  }
+
+  ConnectedComponents components(graph);
+  std::vector<std::vector<uint32_t> > cached;
+  graph.getConnectedComponents().fillGroups(cached,std::vector<uint32_t>());
+  EXPECT_EQ(groups,cached);
+  EXPECT_EQ(components.getOffsets(),graph.getConnectedComponents().getOffsets());
+
+  //long chains do not overflow the stack
+  Graph chain;
+  chain.resize(1000000);
+  for(uint32_t n=1;n<chain.size();n++) chain.connect(n-1,n);
+  EXPECT_EQ(size_t(1),chain.getConnectedComponents().getNumberOfComponents());
+  EXPECT_EQ(uint32_t(999999),chain.getConnectedComponents().getMember(0,999999));
+}
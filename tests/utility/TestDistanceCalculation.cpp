@@ -31,6 +31,7 @@ along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
 #include <LeMonADE/utility/Vector3D.h>
 #include <LeMonADE/feature/FeatureBox.h>
 #include <LeMonADE/utility/DistanceCalculation.h>
+#include <LeMonADE/utility/R250.h>
 
 using namespace Lemonade;
 
@@ -256,3 +257,72 @@ TEST_F( TestDistanceCalculation, DoubleValuesArbitraryBoxes )
   EXPECT_NEAR(8.2,dist,0.01);
   
 }
+
+TEST_F( TestDistanceCalculation, BatchMinImage )
+{
+  //power of two, even and non-periodic directions
+  ing.setBoxX(16);
+  ing.setPeriodicX(true);
+  ing.setBoxY(12);
+  ing.setPeriodicY(true);
+  ing.setBoxZ(8);
+  ing.setPeriodicZ(false);
+
+  R250 rng;
+  ing.modifyMolecules().resize(1000);
+  for(size_t n=0;n<1000;n++)
+    ing.modifyMolecules()[n].modifyVector3D().setAllCoordinates(int32_t(rng.r250_rand()%200)-100,int32_t(rng.r250_rand()%200)-100,int32_t(rng.r250_rand()%200)-100);
+  Ing::molecules_type const& mol = ing.getMolecules();
+
+  MinImageBox box(ing);
+  EXPECT_TRUE(box.isPowerOfTwo(0));
+  EXPECT_FALSE(box.isPowerOfTwo(1));
+  EXPECT_TRUE(box.isPeriodic(1));
+  EXPECT_FALSE(box.isPeriodic(2));
+
+  CoordinatesSoA positions;
+  positions.assign(mol);
+  ASSERT_EQ(size_t(1000),positions.size());
+  EXPECT_EQ(mol[17].getVector3D(),positions.get(17));
+
+  //pairs (n,n+500)
+  std::vector<int32_t> dx(500),dy(500),dz(500);
+  std::vector<int64_t> distance2(500);
+  MinImageVectors(box,positions.span(0,500),positions.span(500,1000),&dx[0],&dy[0],&dz[0]);
+  MinImageSquaredDistances(box,positions.span(0,500),positions.span(500,1000),&distance2[0]);
+  for(size_t n=0;n<500;n++)
+  {
+    VectorInt3 vec=MinImageVector(mol[n],mol[n+500],ing);
+    EXPECT_EQ(vec,VectorInt3(dx[n],dy[n],dz[n]));
+    EXPECT_EQ(vec,box.vector(mol[n],mol[n+500]));
+    EXPECT_EQ(int64_t(vec*vec),distance2[n]);
+  }
+
+  //one to many, more than one block
+  distance2.resize(1000);
+  MinImageSquaredDistances(box,mol[3].getVector3D(),positions.span(),&distance2[0]);
+  for(size_t n=0;n<1000;n++)
+  {
+    VectorInt3 vec=MinImageVector(mol[3],mol[n],ing);
+    EXPECT_EQ(int64_t(vec*vec),distance2[n]);
+  }
+  MinImageVectors(box,mol[3].getVector3D(),positions.span(0,500),&dx[0],&dy[0],&dz[0]);
+  EXPECT_EQ(VectorInt3(0,0,0),VectorInt3(dx[3],dy[3],dz[3]));
+
+  EXPECT_THROW(MinImageSquaredDistances(box,positions.span(0,10),positions.span(0,11),&distance2[0]),std::runtime_error);
+
+  //odd box sizes give the shortest image
+  uint32_t oddBox[3]={13,13,13};
+  bool periodic[3]={true,true,true};
+  MinImageBox odd(oddBox,periodic);
+  for(int32_t delta=-40;delta<=40;delta++)
+  {
+    int32_t folded=odd.component(0,delta);
+    EXPECT_LE(std::abs(folded),6);
+    EXPECT_EQ(0,(delta-folded)%13);
+  }
+
+  //empty spans
+  CoordinatesSoA empty;
+  EXPECT_NO_THROW(MinImageSquaredDistances(box,empty.span(),empty.span(),&distance2[0]));
+}
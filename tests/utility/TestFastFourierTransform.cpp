@@ -0,0 +1,126 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the classes FastFourierTransform and RealFourierTransform3D
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include <LeMonADE/utility/FastFourierTransform.h>
+#include <LeMonADE/utility/R250.h>
+
+typedef std::complex<double> complex_type;
+
+//! direct evaluation of the discrete Fourier transform
+std::vector<complex_type> directTransform(const std::vector<complex_type>& data)
+{
+  const double pi=3.14159265358979323846;
+  size_t n=data.size();
+  std::vector<complex_type> result(n,complex_type(0.0,0.0));
+  for(size_t k=0;k<n;k++)
+    for(size_t j=0;j<n;j++)
+      result[k]+=data[j]*std::polar(1.0,-2.0*pi*double((j*k)%n)/double(n));
+  return result;
+}
+
+TEST(FastFourierTransformTest, AgreesWithDirectTransform)
+{
+  R250 rng;
+  //powers of two (radix-2) and other lengths (Bluestein)
+  const size_t lengths[]={1,2,3,5,6,8,12,17,64,100};
+  for(size_t l=0;l<sizeof(lengths)/sizeof(lengths[0]);l++)
+  {
+    size_t n=lengths[l];
+    std::vector<complex_type> data(n);
+    for(size_t j=0;j<n;j++) data[j]=complex_type(rng.r250_uniform()-0.5,rng.r250_uniform()-0.5);
+
+    FastFourierTransform fft(n);
+    EXPECT_EQ(fft.size(),n);
+    EXPECT_EQ(fft.getWorkspaceSize()==0,FastFourierTransform::isPowerOfTwo(n));
+    std::vector<complex_type> transformed(data);
+    std::vector<complex_type> workspace(fft.getWorkspaceSize()+1);
+    fft.forward(&transformed[0],&workspace[0]);
+
+    std::vector<complex_type> expected=directTransform(data);
+    for(size_t k=0;k<n;k++)
+    {
+      EXPECT_NEAR(expected[k].real(),transformed[k].real(),1e-10)<<"n="<<n<<" k="<<k;
+      EXPECT_NEAR(expected[k].imag(),transformed[k].imag(),1e-10)<<"n="<<n<<" k="<<k;
+    }
+  }
+  EXPECT_THROW(FastFourierTransform(0),std::runtime_error);
+}
+
+TEST(FastFourierTransformTest, RealTransform3D)
+{
+  const double pi=3.14159265358979323846;
+  R250 rng;
+  //even and odd sizes in x
+  const size_t sizes[2][3]={{8,6,5},{7,4,3}};
+  for(size_t s=0;s<2;s++)
+  {
+    size_t nx=sizes[s][0], ny=sizes[s][1], nz=sizes[s][2];
+    std::vector<double> grid(nx*ny*nz);
+    for(size_t n=0;n<grid.size();n++) grid[n]=rng.r250_uniform();
+
+    for(unsigned int threads=1;threads<=3;threads+=2)
+    {
+      RealFourierTransform3D transform;
+      transform.setup(nx,ny,nz,threads);
+      size_t hx=transform.getComplexSizeX();
+      EXPECT_EQ(hx,nx/2+1);
+      std::vector<complex_type> result(hx*ny*nz);
+      transform.forward(&grid[0],&result[0]);
+
+      for(size_t kz=0;kz<nz;kz++)
+	for(size_t ky=0;ky<ny;ky++)
+	  for(size_t kx=0;kx<hx;kx++)
+	  {
+	    complex_type expected(0.0,0.0);
+	    for(size_t z=0;z<nz;z++)
+	      for(size_t y=0;y<ny;y++)
+		for(size_t x=0;x<nx;x++)
+		{
+		  double phase=double(kx*x)/double(nx)+double(ky*y)/double(ny)+double(kz*z)/double(nz);
+		  expected+=grid[x+nx*(y+ny*z)]*std::polar(1.0,-2.0*pi*phase);
+		}
+	    complex_type value=result[kx+hx*(ky+ny*kz)];
+	    EXPECT_NEAR(expected.real(),value.real(),1e-9);
+	    EXPECT_NEAR(expected.imag(),value.imag(),1e-9);
+	  }
+    }
+  }
+}
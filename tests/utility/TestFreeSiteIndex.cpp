@@ -0,0 +1,110 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class FreeSiteIndex
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include <LeMonADE/utility/FreeSiteIndex.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+TEST(FreeSiteIndexTest, OccupyAndRelease)
+{
+  uint32_t box[3]={8,8,8};
+  bool periodic[3]={true,true,true};
+  FreeSiteIndex index;
+  index.setup(box,periodic);
+  EXPECT_EQ(512u,index.getNumberOfFreeSites());
+
+  //a monomer blocks the 27 sites around it, across the periodic boundaries
+  index.occupy(VectorInt3(0,0,0));
+  EXPECT_EQ(512u-27u,index.getNumberOfFreeSites());
+  EXPECT_FALSE(index.isFree(VectorInt3(7,7,7)));
+  EXPECT_FALSE(index.isFree(VectorInt3(-1,1,0)));
+  EXPECT_FALSE(index.isFree(VectorInt3(8,8,8)));
+  EXPECT_TRUE(index.isFree(VectorInt3(2,0,0)));
+  EXPECT_TRUE(index.isFree(VectorInt3(6,0,0)));
+
+  //overlapping blocked regions are counted
+  index.occupy(VectorInt3(2,0,0));
+  EXPECT_EQ(512u-45u,index.getNumberOfFreeSites());
+  index.release(VectorInt3(0,0,0));
+  EXPECT_EQ(512u-27u,index.getNumberOfFreeSites());
+  EXPECT_FALSE(index.isFree(VectorInt3(1,0,0)));
+  EXPECT_TRUE(index.isFree(VectorInt3(0,0,0)));
+
+  index.move(VectorInt3(2,0,0),VectorInt3(3,0,0));
+  EXPECT_EQ(512u-27u,index.getNumberOfFreeSites());
+  EXPECT_TRUE(index.isFree(VectorInt3(1,0,0)));
+  EXPECT_FALSE(index.isFree(VectorInt3(4,0,0)));
+
+  //all listed sites are free and unique
+  std::vector<bool> seen(512,false);
+  for(uint32_t k=0;k<index.getNumberOfFreeSites();k++)
+  {
+    VectorInt3 site(index.getFreeSite(k));
+    EXPECT_TRUE(index.isFree(site));
+    uint32_t id=site.getX()+8*(site.getY()+8*site.getZ());
+    EXPECT_FALSE(seen[id]);
+    seen[id]=true;
+  }
+
+  //removed sites come back when the last blocking monomer is released
+  index.remove(VectorInt3(0,4,4));
+  EXPECT_FALSE(index.isFree(VectorInt3(0,4,4)));
+  index.occupy(VectorInt3(0,4,4));
+  index.release(VectorInt3(0,4,4));
+  EXPECT_TRUE(index.isFree(VectorInt3(0,4,4)));
+}
+
+TEST(FreeSiteIndexTest, NonPeriodic)
+{
+  uint32_t box[3]={8,8,8};
+  bool periodic[3]={false,true,true};
+  std::vector<VectorInt3> positions(1,VectorInt3(0,0,0));
+  FreeSiteIndex index;
+  index.build(box,periodic,positions);
+
+  //the cube must fit into the box in x, the sites behind x=0 are outside
+  EXPECT_EQ(7u*64u-18u,index.getNumberOfFreeSites());
+  EXPECT_FALSE(index.isFree(VectorInt3(7,4,4)));
+  EXPECT_FALSE(index.isFree(VectorInt3(-1,4,4)));
+  EXPECT_TRUE(index.isFree(VectorInt3(6,4,4)));
+  index.release(VectorInt3(0,0,0));
+  EXPECT_EQ(7u*64u,index.getNumberOfFreeSites());
+  EXPECT_FALSE(index.isFree(VectorInt3(7,0,0)));
+
+  uint32_t empty[3]={8,0,8};
+  EXPECT_THROW(index.setup(empty,periodic),std::runtime_error);
+}
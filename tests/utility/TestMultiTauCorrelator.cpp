@@ -0,0 +1,135 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class MultiTauCorrelator
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include <LeMonADE/utility/MultiTauCorrelator.h>
+#include <LeMonADE/utility/R250.h>
+
+//! squared difference of scalar frames
+struct SquaredDifference
+{
+  void operator()(const double& earlier, const double& later, std::vector<double>& result) const
+  {
+    result.assign(2,0.0);
+    result[0]=(later-earlier)*(later-earlier);
+    result[1]=later-earlier;
+  }
+};
+
+typedef MultiTauCorrelator<double,SquaredDifference> ScalarCorrelator;
+
+TEST(MultiTauCorrelatorTest, Parameters)
+{
+  EXPECT_THROW(ScalarCorrelator(16,1),std::runtime_error);
+  EXPECT_THROW(ScalarCorrelator(15,2),std::runtime_error);
+  EXPECT_THROW(ScalarCorrelator(16,2,0),std::runtime_error);
+  EXPECT_NO_THROW(ScalarCorrelator(8,4,3));
+}
+
+/**
+ * @brief Compares every lag with the average over the same subsampled pairs
+ * calculated directly from the complete time series
+ */
+TEST(MultiTauCorrelatorTest, AgreesWithDirectCalculation)
+{
+  const uint32_t points=8, blocking=2;
+  const size_t nFrames=1000;
+
+  R250 rng;
+  std::vector<double> series(1,0.0);
+  for(size_t n=1;n<nFrames;n++) series.push_back(series.back()+rng.r250_uniform()-0.5);
+
+  ScalarCorrelator correlator(points,blocking);
+  for(size_t n=0;n<nFrames;n++) correlator.add(series[n]);
+  EXPECT_EQ(correlator.getNumberOfFrames(),nFrames);
+
+  std::vector<uint64_t> lags,counts;
+  std::vector<std::vector<double> > averages;
+  correlator.getResults(lags,averages,counts);
+  ASSERT_EQ(lags.size(),averages.size());
+  ASSERT_EQ(lags.size(),counts.size());
+  ASSERT_GT(lags.size(),size_t(points));
+
+  //lags are increasing and the largest one is of the order of the series length
+  for(size_t n=1;n<lags.size();n++) EXPECT_LT(lags[n-1],lags[n]);
+  EXPECT_GT(lags.back(),uint64_t(nFrames/4));
+  EXPECT_LT(lags.back(),uint64_t(nFrames));
+
+  for(size_t n=0;n<lags.size();n++)
+  {
+    //resolution of the level that evaluated the lag
+    uint64_t resolution=1;
+    while(lags[n]/resolution>=points) resolution*=blocking;
+
+    double sum=0.0, sumSigned=0.0;
+    uint64_t count=0;
+    for(uint64_t t=lags[n];t<nFrames;t+=resolution)
+    {
+      if(t%resolution!=0) continue;
+      double diff=series[t]-series[t-lags[n]];
+      sum+=diff*diff;
+      sumSigned+=diff;
+      count++;
+    }
+    EXPECT_EQ(count,counts[n])<<"lag "<<lags[n];
+    EXPECT_NEAR(sum/double(count),averages[n][0],1e-9)<<"lag "<<lags[n];
+    EXPECT_NEAR(sumSigned/double(count),averages[n][1],1e-9)<<"lag "<<lags[n];
+  }
+}
+
+TEST(MultiTauCorrelatorTest, MaxLevelsAndClear)
+{
+  ScalarCorrelator correlator(4,2,3);
+  for(size_t n=0;n<1000;n++) correlator.add(double(n));
+  EXPECT_EQ(correlator.getNumberOfLevels(),size_t(3));
+
+  std::vector<uint64_t> lags,counts;
+  std::vector<std::vector<double> > averages;
+  correlator.getResults(lags,averages,counts);
+  //level 0: 1,2,3, level 1: 4,6, level 2: 8,12
+  ASSERT_EQ(lags.size(),size_t(7));
+  EXPECT_EQ(lags.back(),uint64_t(12));
+  //ballistic motion: the squared displacement is the squared lag
+  for(size_t n=0;n<lags.size();n++)
+    EXPECT_DOUBLE_EQ(averages[n][0],double(lags[n]*lags[n]));
+
+  correlator.clear();
+  EXPECT_EQ(correlator.getNumberOfFrames(),uint64_t(0));
+  correlator.getResults(lags,averages,counts);
+  EXPECT_TRUE(lags.empty());
+}
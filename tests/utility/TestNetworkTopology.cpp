@@ -0,0 +1,232 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the class NetworkTopology
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <LeMonADE/core/Molecules.h>
+#include <LeMonADE/utility/NetworkTopology.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+typedef Molecules<VectorInt3,7> Graph;
+
+//! connects a with b by a strand of length new monomers, returns the first new monomer
+uint32_t addStrand(Graph& graph, uint32_t a, uint32_t b, uint32_t length)
+{
+  uint32_t first=graph.size();
+  uint32_t previous=a;
+  for(uint32_t n=0;n<length;n++)
+  {
+    graph.addMonomer(VectorInt3(0,0,0));
+    graph.connect(previous,graph.size()-1);
+    previous=graph.size()-1;
+  }
+  graph.connect(previous,b);
+  return first;
+}
+
+TEST(NetworkTopologyTest, Classification)
+{
+  Graph graph;
+  //junctions A=0 and B=1 connected by three strands
+  graph.resize(2);
+  graph.connect(0,1);
+  uint32_t theta=addStrand(graph,0,1,2);
+  addStrand(graph,0,1,2);
+  //dangling chain at A
+  graph.addMonomer(VectorInt3(0,0,0));
+  graph.connect(0,6);
+  graph.addMonomer(VectorInt3(0,0,0));
+  graph.connect(6,7);
+  graph.addMonomer(VectorInt3(0,0,0));
+  graph.connect(7,8);
+  //first order loop at B
+  uint32_t loop=addStrand(graph,1,1,3);
+  //free ring and linear chain
+  uint32_t ring=graph.size();
+  graph.resize(ring+9);
+  for(uint32_t n=0;n<4;n++) graph.connect(ring+n,ring+(n+1)%4);
+  for(uint32_t n=4;n<8;n++) graph.connect(ring+n,ring+n+1);
+  ASSERT_EQ(21u,graph.size());
+
+  NetworkTopology topology(graph);
+  EXPECT_EQ(21u,topology.getNumberOfMonomers());
+  EXPECT_EQ(22u,topology.getNumberOfBonds());
+  EXPECT_EQ(3u,topology.getNumberOfMolecules());
+  EXPECT_EQ(4u,topology.getCycleRank());
+  EXPECT_EQ(8u,topology.getNumberOfDanglingMonomers());
+  EXPECT_EQ(2u,topology.getNumberOfJunctions());
+  EXPECT_EQ(4u,topology.getNumberOfStrands());
+  EXPECT_EQ(1u,topology.getNumberOfFirstOrderLoops());
+  EXPECT_EQ(3u,topology.getNumberOfSecondOrderLoops());
+  EXPECT_EQ(1u,topology.getNumberOfFreeRings());
+  EXPECT_EQ(2u,topology.getNumberOfActiveJunctions());
+  EXPECT_EQ(3u,topology.getNumberOfActiveStrands());
+  EXPECT_EQ(6u,topology.getNumberOfActiveMonomers());
+  EXPECT_EQ(7u,topology.getNumberOfInactiveMonomers());
+  EXPECT_EQ(2,topology.getActiveCycleRank());
+
+  EXPECT_EQ(NetworkTopology::ActiveMonomer,topology.getMonomerClass(0));
+  EXPECT_EQ(NetworkTopology::ActiveMonomer,topology.getMonomerClass(theta));
+  EXPECT_EQ(NetworkTopology::DanglingMonomer,topology.getMonomerClass(7));
+  EXPECT_EQ(NetworkTopology::InactiveMonomer,topology.getMonomerClass(loop));
+  EXPECT_EQ(NetworkTopology::InactiveMonomer,topology.getMonomerClass(ring));
+  EXPECT_EQ(NetworkTopology::DanglingMonomer,topology.getMonomerClass(ring+6));
+
+  uint32_t lengths=0;
+  for(uint32_t s=0;s<topology.getNumberOfStrands();s++)
+  {
+    lengths+=topology.getStrandLength(s);
+    EXPECT_LE(topology.getStrandEnd(s,0),1u);
+    EXPECT_LE(topology.getStrandEnd(s,1),1u);
+  }
+  EXPECT_EQ(7u,lengths);
+}
+
+TEST(NetworkTopologyTest, JunctionBondsLast)
+{
+  //theta graph: junctions 6 and 7 connected by three strands of two monomers,
+  //the strands are bonded internally first and to the junctions at the end,
+  //so the junction is the last link of the first strand monomer
+  Graph graph;
+  graph.resize(8);
+  for(uint32_t s=0;s<3;s++) graph.connect(2*s,2*s+1);
+  for(uint32_t s=0;s<3;s++)
+  {
+    graph.connect(2*s,6);
+    graph.connect(2*s+1,7);
+  }
+
+  NetworkTopology topology(graph);
+  EXPECT_EQ(2u,topology.getNumberOfJunctions());
+  EXPECT_EQ(3u,topology.getNumberOfStrands());
+  EXPECT_EQ(0u,topology.getNumberOfFirstOrderLoops());
+  EXPECT_EQ(3u,topology.getNumberOfSecondOrderLoops());
+  EXPECT_EQ(2u,topology.getCycleRank());
+  EXPECT_EQ(2u,topology.getNumberOfActiveJunctions());
+  EXPECT_EQ(3u,topology.getNumberOfActiveStrands());
+  EXPECT_EQ(8u,topology.getNumberOfActiveMonomers());
+  EXPECT_EQ(2,topology.getActiveCycleRank());
+  for(uint32_t s=0;s<topology.getNumberOfStrands();s++)
+  {
+    EXPECT_EQ(2u,topology.getStrandLength(s));
+    EXPECT_NE(topology.getStrandEnd(s,0),topology.getStrandEnd(s,1));
+  }
+
+  //the same network with the bonds added in reverse order
+  Graph reversed;
+  reversed.resize(8);
+  for(uint32_t s=3;s-->0;)
+  {
+    reversed.connect(2*s+1,7);
+    reversed.connect(2*s,6);
+  }
+  for(uint32_t s=3;s-->0;) reversed.connect(2*s,2*s+1);
+  NetworkTopology topologyReversed(reversed);
+  EXPECT_EQ(topology.getNumberOfStrands(),topologyReversed.getNumberOfStrands());
+  EXPECT_EQ(topology.getNumberOfFirstOrderLoops(),topologyReversed.getNumberOfFirstOrderLoops());
+  EXPECT_EQ(topology.getNumberOfSecondOrderLoops(),topologyReversed.getNumberOfSecondOrderLoops());
+  EXPECT_EQ(topology.getNumberOfActiveMonomers(),topologyReversed.getNumberOfActiveMonomers());
+  EXPECT_EQ(topology.getActiveCycleRank(),topologyReversed.getActiveCycleRank());
+}
+
+TEST(NetworkTopologyTest, InactiveCascade)
+{
+  //junctions P, Q, R: loop at P, two strands P-Q, two strands Q-R, loop at R
+  Graph graph;
+  graph.resize(3);
+  addStrand(graph,0,0,2);
+  addStrand(graph,0,1,1);
+  addStrand(graph,0,1,1);
+  addStrand(graph,1,2,1);
+  addStrand(graph,1,2,0);
+  addStrand(graph,2,2,2);
+
+  NetworkTopology topology(graph);
+  EXPECT_EQ(3u,topology.getNumberOfJunctions());
+  EXPECT_EQ(6u,topology.getNumberOfStrands());
+  EXPECT_EQ(2u,topology.getNumberOfFirstOrderLoops());
+  EXPECT_EQ(2u,topology.getNumberOfSecondOrderLoops());
+  EXPECT_EQ(4u,topology.getCycleRank());
+  EXPECT_EQ(0u,topology.getNumberOfDanglingMonomers());
+  EXPECT_EQ(0u,topology.getNumberOfActiveJunctions());
+  EXPECT_EQ(0u,topology.getNumberOfActiveStrands());
+  EXPECT_EQ(0u,topology.getNumberOfActiveMonomers());
+  EXPECT_EQ(0,topology.getActiveCycleRank());
+
+  //a dangling chain at P does not change the result, a third strand P-R activates all
+  graph.addMonomer(VectorInt3(0,0,0));
+  graph.connect(0,graph.size()-1);
+  addStrand(graph,0,2,3);
+  topology.compute(graph);
+  EXPECT_EQ(1u,topology.getNumberOfDanglingMonomers());
+  EXPECT_EQ(3u,topology.getNumberOfActiveJunctions());
+  EXPECT_EQ(5u,topology.getNumberOfActiveStrands());
+  EXPECT_EQ(3,topology.getActiveCycleRank());
+  EXPECT_EQ(NetworkTopology::ActiveMonomer,topology.getMonomerClass(1));
+  EXPECT_EQ(graph.size()-1-2-2,topology.getNumberOfActiveMonomers());
+}
+
+TEST(NetworkTopologyTest, PeriodicLattice)
+{
+  //junctions on a periodic cubic lattice connected by strands of two monomers
+  const uint32_t L=6;
+  Graph graph;
+  graph.resize(L*L*L);
+  for(uint32_t x=0;x<L;x++)
+    for(uint32_t y=0;y<L;y++)
+      for(uint32_t z=0;z<L;z++)
+      {
+        uint32_t n=x+L*(y+L*z);
+        addStrand(graph,n,(x+1)%L+L*(y+L*z),2);
+        addStrand(graph,n,x+L*((y+1)%L+L*z),2);
+        addStrand(graph,n,x+L*(y+L*((z+1)%L)),2);
+      }
+
+  NetworkTopology topology(graph);
+  EXPECT_EQ(L*L*L,topology.getNumberOfActiveJunctions());
+  EXPECT_EQ(3*L*L*L,topology.getNumberOfActiveStrands());
+  EXPECT_EQ(graph.size(),topology.getNumberOfActiveMonomers());
+  EXPECT_EQ(0u,topology.getNumberOfFirstOrderLoops());
+  EXPECT_EQ(0u,topology.getNumberOfSecondOrderLoops());
+  EXPECT_EQ(int64_t(2*L*L*L+1),topology.getActiveCycleRank());
+
+  //cutting all strands in z direction leaves junctions with four strands
+  for(uint32_t n=0;n<L*L*L;n++)
+    graph.disconnect(L*L*L+6*n+4,L*L*L+6*n+5);
+  topology.compute(graph);
+  EXPECT_EQ(L*L*L,topology.getNumberOfActiveJunctions());
+  EXPECT_EQ(2*L*L*L,topology.getNumberOfActiveStrands());
+  EXPECT_EQ(2*L*L*L,topology.getNumberOfDanglingMonomers());
+  EXPECT_EQ(int64_t(L*L*L+L),topology.getActiveCycleRank());
+}
@@ -0,0 +1,226 @@
+/*--------------------------------------------------------------------------------
+    ooo      L   attice-based  |
+  o\.|./o    e   xtensible     | LeMonADE: An Open Source Implementation of the
+ o\.\|/./o   Mon te-Carlo      |           Bond-Fluctuation-Model for Polymers
+oo---0---oo  A   lgorithm and  |
+ o/./|\.\o   D   evelopment    | Copyright (C) 2013-2015 by
+  o/.|.\o    E   nvironment    | LeMonADE Principal Developers (see AUTHORS)
+    ooo                        |
+----------------------------------------------------------------------------------
+
+This file is part of LeMonADE.
+
+LeMonADE is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+LeMonADE is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LeMonADE.  If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+ * @file
+ * @brief Tests for the binary bond event log in TrackConnection.h
+ * */
+/*****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <LeMonADE/core/Molecules.h>
+#include <LeMonADE/utility/TrackConnection.h>
+#include <LeMonADE/utility/Vector3D.h>
+
+class TestTrackConnection: public ::testing::Test{
+public:
+  typedef Molecules<VectorInt3,7> MoleculesType;
+
+  TestTrackConnection():filename("TestTrackConnection.bondlog"){}
+
+  //redirect cout output
+  virtual void SetUp(){
+    originalBuffer=std::cout.rdbuf();
+    std::cout.rdbuf(tempStream.rdbuf());
+  };
+
+  //restore original output and remove the log
+  virtual void TearDown(){
+    std::cout.rdbuf(originalBuffer);
+    std::remove(filename.c_str());
+  };
+
+  //writes a ring of n monomers, which is opened and closed again at every third mcs
+  void writeRing(BondEventLogWriter& writer, uint32_t n)
+  {
+    for(uint32_t i=0;i<n;i++)
+      writer.addConnection(i,i,(i+1)%n);
+    for(uint32_t i=0;i<n;i++)
+    {
+      writer.addBreak(n+3*i,i,(i+1)%n);
+      writer.addConnection(n+3*i+1,i,(i+1)%n);
+    }
+  }
+
+  const std::string filename;
+
+private:
+  std::streambuf* originalBuffer;
+  std::ostringstream tempStream;
+};
+
+TEST_F(TestTrackConnection, WriteAndRead)
+{
+  //foreground and background writing with buffers smaller than the log
+  for(int background=0;background<2;background++)
+  {
+    {
+      BondEventLogWriter writer(filename,7,background==1);
+      writeRing(writer,100);
+      EXPECT_EQ(300u,writer.getNumEvents());
+    }
+
+    BondEventLogReader reader(filename,16);
+    EXPECT_EQ(300u,reader.getNumEvents());
+    BondEvent event;
+    for(uint32_t i=0;i<100;i++)
+    {
+      ASSERT_TRUE(reader.readEvent(event));
+      EXPECT_EQ(uint64_t(i),event.mcs);
+      EXPECT_EQ(i,event.id1);
+      EXPECT_EQ((i+1)%100,event.id2);
+      EXPECT_EQ(uint32_t(BondEvent::BondCreation),event.type);
+    }
+    for(uint32_t i=0;i<100;i++)
+    {
+      ASSERT_TRUE(reader.readEvent(event));
+      EXPECT_EQ(uint64_t(100+3*i),event.mcs);
+      EXPECT_EQ(uint32_t(BondEvent::BondBreak),event.type);
+      ASSERT_TRUE(reader.readEvent(event));
+      EXPECT_EQ(uint64_t(101+3*i),event.mcs);
+      EXPECT_EQ(uint32_t(BondEvent::BondCreation),event.type);
+    }
+    EXPECT_FALSE(reader.readEvent(event));
+    EXPECT_EQ(300u,reader.getPosition());
+
+    //random access
+    EXPECT_EQ(50u,reader.getEvent(50).id1);
+    EXPECT_EQ(uint64_t(100),reader.getEvent(100).mcs);
+    EXPECT_THROW(reader.getEvent(300),std::runtime_error);
+  }
+}
+
+TEST_F(TestTrackConnection, Append)
+{
+  {
+    BondEventLogWriter writer(filename,4);
+    writer.addConnection(1,0,1);
+    writer.addConnection(2,1,2);
+  }
+  {
+    BondEventLogWriter writer(filename,4,true,true);
+    writer.addBreak(3,0,1);
+    writer.flush();
+    EXPECT_EQ(1u,writer.getNumEvents());
+  }
+  BondEventLogReader reader(filename);
+  ASSERT_EQ(3u,reader.getNumEvents());
+  EXPECT_EQ(uint64_t(3),reader.getEvent(2).mcs);
+  EXPECT_EQ(uint32_t(BondEvent::BondBreak),reader.getEvent(2).type);
+
+  //a crashed run leaves a partial record, which is removed when appending
+  {
+    std::ofstream file(filename.c_str(),std::ios_base::out|std::ios_base::app|std::ios_base::binary);
+    file.write("partial",7);
+  }
+  EXPECT_EQ(3u,BondEventLogReader(filename).getNumEvents());
+  {
+    BondEventLogWriter writer(filename,4,false,true);
+    writer.addConnection(4,0,1);
+  }
+  {
+    BondEventLogReader reader(filename);
+    ASSERT_EQ(4u,reader.getNumEvents());
+    EXPECT_EQ(uint64_t(4),reader.getEvent(3).mcs);
+    EXPECT_EQ(0u,reader.getEvent(3).id1);
+    EXPECT_EQ(1u,reader.getEvent(3).id2);
+    EXPECT_EQ(uint32_t(BondEvent::BondCreation),reader.getEvent(3).type);
+  }
+  //the file consists of the header of 20 bytes and complete records
+  std::ifstream complete(filename.c_str(),std::ios_base::in|std::ios_base::binary|std::ios_base::ate);
+  EXPECT_EQ(0,(int64_t(complete.tellg())-20)%int64_t(BondEvent::recordSize));
+  complete.close();
+
+  //a new log replaces the old one
+  {
+    BondEventLogWriter writer(filename);
+    writer.addConnection(5,2,3);
+  }
+  EXPECT_EQ(1u,BondEventLogReader(filename).getNumEvents());
+
+  //no bond event log
+  {
+    std::ofstream file(filename.c_str());
+    file<<"some text which is not a log";
+  }
+  EXPECT_THROW(BondEventLogReader reader(filename),std::runtime_error);
+  EXPECT_THROW(BondEventLogWriter writer(filename,16,false,true),std::runtime_error);
+  EXPECT_THROW(BondEventLogReader reader("TestTrackConnection.doesnotexist"),std::runtime_error);
+}
+
+TEST_F(TestTrackConnection, Replay)
+{
+  const uint32_t n=50;
+  {
+    BondEventLogWriter writer(filename,64,true);
+    writeRing(writer,n);
+  }
+
+  MoleculesType molecules;
+  molecules.resize(n);
+  BondEventLogReader reader(filename,8);
+
+  reader.replay(molecules,9);
+  EXPECT_EQ(10u,reader.getPosition());
+  EXPECT_TRUE(molecules.areConnected(9,10));
+  EXPECT_FALSE(molecules.areConnected(10,11));
+
+  //closed ring
+  reader.replay(molecules,n-1);
+  for(uint32_t i=0;i<n;i++) EXPECT_TRUE(molecules.areConnected(i,(i+1)%n));
+
+  //bond 7-8 is open between mcs n+21 and n+22
+  reader.replay(molecules,n+21);
+  EXPECT_FALSE(molecules.areConnected(7,8));
+  EXPECT_TRUE(molecules.areConnected(6,7));
+  reader.replay(molecules,n+22);
+  EXPECT_TRUE(molecules.areConnected(7,8));
+
+  //back in time
+  reader.replay(molecules,n+21);
+  EXPECT_FALSE(molecules.areConnected(7,8));
+  reader.replay(molecules,4);
+  EXPECT_EQ(5u,reader.getPosition());
+  EXPECT_TRUE(molecules.areConnected(4,5));
+  EXPECT_FALSE(molecules.areConnected(5,6));
+  EXPECT_FALSE(molecules.areConnected(n-1,0));
+
+  reader.replay(molecules,10*n);
+  EXPECT_EQ(reader.getNumEvents(),reader.getPosition());
+  for(uint32_t i=0;i<n;i++) EXPECT_TRUE(molecules.areConnected(i,(i+1)%n));
+
+  //topology does not match the log: the first bond already exists
+  reader.rewind();
+  EXPECT_THROW(reader.replay(molecules,0),std::runtime_error);
+}